@@ -10,7 +10,10 @@
 #include <executorch/backends/xnnpack/schema_generated.h>
 #include <executorch/backends/xnnpack/threadpool/threadpool.h>
 #include <executorch/runtime/core/exec_aten/util/scalar_type_util.h>
+#include <cstring>
+#include <mutex>
 #include <unordered_map>
+#include <vector>
 
 namespace torch {
 namespace executor {
@@ -31,6 +34,153 @@ using DefineNodeFunc = Error (*)(
     const std::unordered_map<uint32_t, uint32_t>&,
     NodePtr) noexcept;
 
+#ifdef ENABLE_XNNPACK_SHARED_WEIGHTS
+/*
+Packed weights of the runtimes created before freezeWeights(). XNNPACK keeps
+them in mappings of their own, away from the allocations that executing
+methods write to, so that processes forked after freezing share their pages.
+Each XNNExecutor whose runtime uses them holds a reference, and they are freed
+along with the last such executor.
+*/
+struct SharedWeights {
+  xnn_weights_cache_t cache = nullptr;
+
+  /*
+  Copies of the constant data packed into `cache`, keyed by a hash of their
+  contents. XNNPACK finds packed weights by the address of the data they were
+  packed from, but a delegate's data is freed right after its runtime is
+  created, so another delegate's weights could later land at the same address
+  and pick up the wrong packed weights. Constants are defined from these
+  copies instead, which live as long as the cache and give each distinct
+  content exactly one address. They can't be released one at a time, since
+  the cache would still map their addresses.
+  */
+  std::unordered_multimap<uint64_t, std::vector<uint8_t>> constants;
+
+  // Runtimes still being created, which may pack more weights into `cache`.
+  size_t num_building = 0;
+
+  bool finalized = false;
+
+  ~SharedWeights() {
+    if (cache != nullptr) {
+      xnn_delete_weights_cache(cache);
+    }
+  }
+};
+#endif
+
+namespace {
+#ifdef ENABLE_XNNPACK_SHARED_WEIGHTS
+// Guards the state below and the constants of the current SharedWeights.
+// XNNPACK serializes packing into a weights cache itself, so this is not held
+// while runtimes are created.
+std::mutex weights_cache_mutex;
+std::weak_ptr<SharedWeights> shared_weights;
+bool weights_cache_frozen = false;
+
+/*
+Returns the shared weights, creating them if no live runtime uses them, and
+counts the caller as building a runtime until it calls finishBuilding().
+Returns nullptr once the cache is frozen, or if it could not be created;
+runtimes then pack their weights privately. Callers must hold
+weights_cache_mutex.
+*/
+std::shared_ptr<SharedWeights> startBuilding() {
+  if (weights_cache_frozen) {
+    return nullptr;
+  }
+  std::shared_ptr<SharedWeights> weights = shared_weights.lock();
+  if (weights == nullptr) {
+    weights = std::make_shared<SharedWeights>();
+    xnn_status status = xnn_create_weights_cache(&weights->cache);
+    if (status != xnn_status_success) {
+      ET_LOG(
+          Error,
+          "XNN weights cache creation failed with code: %s",
+          xnn_status_to_string(status));
+      weights->cache = nullptr;
+      weights_cache_frozen = true;
+      return nullptr;
+    }
+    shared_weights = weights;
+  }
+  ++weights->num_building;
+  return weights;
+}
+
+/*
+Finalizes the cache so that XNNPACK releases its spare capacity and stops
+writing to it. Callers must hold weights_cache_mutex, and no runtime may be
+packing into the cache.
+*/
+Error finalizeWeights(SharedWeights& weights) {
+  if (weights.finalized) {
+    return Error::Ok;
+  }
+  weights.finalized = true;
+  xnn_status status = xnn_finalize_weights_cache(
+      weights.cache, xnn_weights_cache_finalization_kind_hard);
+  ET_CHECK_OR_RETURN_ERROR(
+      xnn_status_success == status,
+      Internal,
+      "XNN weights cache finalization failed with code: %s",
+      xnn_status_to_string(status));
+  return Error::Ok;
+}
+
+/*
+Ends a startBuilding() once the runtime no longer packs weights, whether or not
+it was created. If freezeWeights() ran in the meantime, the last runtime to
+finish finalizes the cache.
+*/
+void finishBuilding(SharedWeights* weights) {
+  std::lock_guard<std::mutex> lock(weights_cache_mutex);
+  if (--weights->num_building == 0 && weights_cache_frozen) {
+    (void)finalizeWeights(*weights);
+  }
+}
+
+// FNV-1a.
+uint64_t hashConstant(const uint8_t* data, size_t size) {
+  uint64_t hash = 14695981039346656037ULL;
+  for (size_t i = 0; i < size; ++i) {
+    hash = (hash ^ data[i]) * 1099511628211ULL;
+  }
+  return hash;
+}
+#endif
+
+/*
+Returns the address to define a constant tensor's data from. With shared
+weights, this is their own copy of the data; otherwise it is `data` itself.
+*/
+const uint8_t*
+getConstantData(SharedWeights* weights, const uint8_t* data, size_t size) {
+#ifdef ENABLE_XNNPACK_SHARED_WEIGHTS
+  if (weights == nullptr) {
+    return data;
+  }
+  std::lock_guard<std::mutex> lock(weights_cache_mutex);
+  const uint64_t hash = hashConstant(data, size);
+  auto range = weights->constants.equal_range(hash);
+  for (auto it = range.first; it != range.second; ++it) {
+    const std::vector<uint8_t>& copy = it->second;
+    if (copy.size() == size && memcmp(copy.data(), data, size) == 0) {
+      return copy.data();
+    }
+  }
+  return weights->constants
+      .emplace(hash, std::vector<uint8_t>(data, data + size))
+      ->second.data();
+#else
+  (void)weights;
+  (void)size;
+  return data;
+#endif
+}
+} // namespace
+
 /*
 Gets the output min and output max for a given node operator
 */
@@ -150,9 +300,12 @@ Error defineTensor(
   // it is a nullptr
   const auto& constant_buffer = *flatbuffer_graph->constant_buffer();
   auto buffer_idx = tensor_value->constant_buffer_idx();
-  const auto buffer_ptr = buffer_idx == 0
-      ? nullptr
-      : constant_buffer[buffer_idx]->storage()->data();
+  const uint8_t* buffer_ptr = nullptr;
+  if (buffer_idx != 0) {
+    const auto storage = constant_buffer[buffer_idx]->storage();
+    buffer_ptr = getConstantData(
+        executor->shared_weights_.get(), storage->data(), storage->size());
+  }
   xnn_status status;
   // The type we might have to convert to
   auto dq_datatype = getDataType(tensor_value->dq_datatype());
@@ -1454,6 +1607,16 @@ __ET_NODISCARD Error XNNCompiler::compileModel(
   std::unique_ptr<xnn_subgraph, decltype(&xnn_delete_subgraph)> subgraph(
       subgraph_ptr, &xnn_delete_subgraph);
 
+#ifdef ENABLE_XNNPACK_SHARED_WEIGHTS
+  {
+    std::lock_guard<std::mutex> lock(weights_cache_mutex);
+    executor->shared_weights_ = startBuilding();
+  }
+  // Calls finishBuilding() however this returns.
+  std::unique_ptr<SharedWeights, decltype(&finishBuilding)> building(
+      executor->shared_weights_.get(), &finishBuilding);
+#endif
+
   // mapping from old ids to new created value ids
   // The old ids that were serialied were generated AoT, since
   // we are re-defining tensor values, the defined IDs could be
@@ -1492,11 +1655,21 @@ __ET_NODISCARD Error XNNCompiler::compileModel(
 #endif
 
   xnn_runtime_t runtime_ptr = nullptr;
+#ifdef ENABLE_XNNPACK_SHARED_WEIGHTS
+  status = xnn_create_runtime_v3(
+      subgraph.get(),
+      executor->shared_weights_ != nullptr ? executor->shared_weights_->cache
+                                           : nullptr,
+      torch::executorch::threadpool::get_pthreadpool(),
+      runtime_flags,
+      &runtime_ptr);
+#else
   status = xnn_create_runtime_v2(
       subgraph.get(),
       torch::executorch::threadpool::get_pthreadpool(),
       runtime_flags,
       &runtime_ptr);
+#endif
   ET_CHECK_OR_RETURN_ERROR(
       xnn_status_success == status,
       Internal,
@@ -1544,6 +1717,29 @@ __ET_NODISCARD Error XNNCompiler::compileModel(
   return err;
 };
 
+/*
+Finalizes the shared weights cache so that XNNPACK releases its spare capacity
+and stops writing to it. Runtimes created afterwards pack their weights
+privately. If runtimes are still being created with the cache, the last of
+them finalizes it instead.
+*/
+__ET_NODISCARD Error XNNCompiler::freezeWeights() {
+#ifdef ENABLE_XNNPACK_SHARED_WEIGHTS
+  std::lock_guard<std::mutex> lock(weights_cache_mutex);
+  if (weights_cache_frozen) {
+    return Error::Ok;
+  }
+  weights_cache_frozen = true;
+  std::shared_ptr<SharedWeights> weights = shared_weights.lock();
+  if (weights == nullptr || weights->num_building > 0) {
+    return Error::Ok;
+  }
+  return finalizeWeights(*weights);
+#else
+  return Error::Ok;
+#endif
+}
+
 } // namespace delegate
 } // namespace xnnpack
 } // namespace executor
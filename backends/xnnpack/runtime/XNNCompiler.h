@@ -29,6 +29,11 @@ class XNNCompiler {
       size_t num_bytes,
       XNNExecutor* executor,
       MemoryAllocator* runtime_allocator);
+
+  // Stops adding packed weights to the cache shared by all runtimes and makes
+  // it read-only, so that processes forked afterwards share its pages. Only
+  // has an effect when built with ENABLE_XNNPACK_SHARED_WEIGHTS.
+  __ET_NODISCARD static Error freezeWeights();
 };
 
 } // namespace delegate
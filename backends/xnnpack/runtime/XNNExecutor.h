@@ -23,8 +23,14 @@ namespace executor {
 namespace xnnpack {
 namespace delegate {
 
+struct SharedWeights;
+
 class XNNExecutor {
  private:
+  // The shared weights cache that runtime_ packed its weights into, if any.
+  // Declared before runtime_ so that it is released after the runtime is
+  // deleted.
+  std::shared_ptr<SharedWeights> shared_weights_;
   std::unique_ptr<xnn_runtime, decltype(&xnn_delete_runtime)> runtime_{
       nullptr,
       &xnn_delete_runtime};
@@ -127,6 +127,10 @@ class XnnpackBackend final : public PyTorchBackendInterface {
       executor->~XNNExecutor();
     }
   }
+
+  Error freeze() const override {
+    return xnnpack::delegate::XNNCompiler::freezeWeights();
+  }
 };
 
 namespace {
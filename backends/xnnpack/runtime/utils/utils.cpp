@@ -166,21 +166,263 @@ Error GenerateRequantizationScale(
   return Error::Ok;
 }
 
-std::pair<float, float> GetMinMax(const Tensor& ft) {
+#ifdef QNNPACK_UTILS_X86_DISPATCH
+namespace {
+
+// The x86 kernels below are compiled for their instruction set with target
+// attributes, whatever flags the rest of the library is built with, and are
+// only called after checking that the CPU supports it.
+bool cpu_has_avx512f() {
+  static const bool has_avx512f = __builtin_cpu_supports("avx512f");
+  return has_avx512f;
+}
+
+bool cpu_has_avx2() {
+  static const bool has_avx2 = __builtin_cpu_supports("avx2");
+  return has_avx2;
+}
+
+__attribute__((target("avx512f"))) std::pair<float, float>
+get_min_max_avx512f(const float* d, size_t n) {
   float min = std::numeric_limits<float>::max();
   float max = -std::numeric_limits<float>::max();
-  ET_CHECK_MSG(
-      ft.scalar_type() == ScalarType::Float,
-      "Expected float tensor but got %" PRId8,
-      static_cast<int8_t>(ft.scalar_type()));
-  const float* d = ft.const_data_ptr<float>();
-  for (int i = 0; i < ft.numel(); ++i) {
+  size_t i = 0;
+  if (n >= 16) {
+    // Two independent accumulators to hide the min/max latency.
+    __m512 vmin0 = _mm512_set1_ps(min);
+    __m512 vmax0 = _mm512_set1_ps(max);
+    __m512 vmin1 = vmin0;
+    __m512 vmax1 = vmax0;
+    for (; i + 32 <= n; i += 32) {
+      const __m512 vx0 = _mm512_loadu_ps(d + i);
+      const __m512 vx1 = _mm512_loadu_ps(d + i + 16);
+      // min/max return the second operand if either is NaN, so NaNs in the
+      // input are skipped just like in the scalar loop.
+      vmin0 = _mm512_min_ps(vx0, vmin0);
+      vmax0 = _mm512_max_ps(vx0, vmax0);
+      vmin1 = _mm512_min_ps(vx1, vmin1);
+      vmax1 = _mm512_max_ps(vx1, vmax1);
+    }
+    for (; i + 16 <= n; i += 16) {
+      const __m512 vx = _mm512_loadu_ps(d + i);
+      vmin0 = _mm512_min_ps(vx, vmin0);
+      vmax0 = _mm512_max_ps(vx, vmax0);
+    }
+    min = _mm512_reduce_min_ps(_mm512_min_ps(vmin0, vmin1));
+    max = _mm512_reduce_max_ps(_mm512_max_ps(vmax0, vmax1));
+  }
+  for (; i < n; ++i) {
     min = (d[i] < min) ? d[i] : min;
     max = (d[i] > max) ? d[i] : max;
   }
   return std::pair<float, float>(min, max);
 }
 
+__attribute__((target("avx2"))) std::pair<float, float> get_min_max_avx2(
+    const float* d,
+    size_t n) {
+  float min = std::numeric_limits<float>::max();
+  float max = -std::numeric_limits<float>::max();
+  size_t i = 0;
+  if (n >= 8) {
+    __m256 vmin0 = _mm256_set1_ps(min);
+    __m256 vmax0 = _mm256_set1_ps(max);
+    __m256 vmin1 = vmin0;
+    __m256 vmax1 = vmax0;
+    for (; i + 16 <= n; i += 16) {
+      const __m256 vx0 = _mm256_loadu_ps(d + i);
+      const __m256 vx1 = _mm256_loadu_ps(d + i + 8);
+      vmin0 = _mm256_min_ps(vx0, vmin0);
+      vmax0 = _mm256_max_ps(vx0, vmax0);
+      vmin1 = _mm256_min_ps(vx1, vmin1);
+      vmax1 = _mm256_max_ps(vx1, vmax1);
+    }
+    for (; i + 8 <= n; i += 8) {
+      const __m256 vx = _mm256_loadu_ps(d + i);
+      vmin0 = _mm256_min_ps(vx, vmin0);
+      vmax0 = _mm256_max_ps(vx, vmax0);
+    }
+    __m256 vmin = _mm256_min_ps(vmin0, vmin1);
+    __m256 vmax = _mm256_max_ps(vmax0, vmax1);
+    __m128 vmin4 = _mm_min_ps(
+        _mm256_castps256_ps128(vmin), _mm256_extractf128_ps(vmin, 1));
+    __m128 vmax4 = _mm_max_ps(
+        _mm256_castps256_ps128(vmax), _mm256_extractf128_ps(vmax, 1));
+    vmin4 = _mm_min_ps(vmin4, _mm_movehl_ps(vmin4, vmin4));
+    vmax4 = _mm_max_ps(vmax4, _mm_movehl_ps(vmax4, vmax4));
+    vmin4 = _mm_min_ss(vmin4, _mm_movehdup_ps(vmin4));
+    vmax4 = _mm_max_ss(vmax4, _mm_movehdup_ps(vmax4));
+    min = _mm_cvtss_f32(vmin4);
+    max = _mm_cvtss_f32(vmax4);
+  }
+  for (; i < n; ++i) {
+    min = (d[i] < min) ? d[i] : min;
+    max = (d[i] > max) ? d[i] : max;
+  }
+  return std::pair<float, float>(min, max);
+}
+
+// Clamp the scaled value before converting it so that out-of-range inputs
+// saturate instead of turning into the "integer indefinite" value.
+constexpr float kQuantizeClampMin = -32768.0f;
+constexpr float kQuantizeClampMax = 32767.0f;
+
+template <typename T>
+__attribute__((target("avx512f"))) void quantize_tensor_avx512f_q8(
+    const float* __restrict__ in,
+    T* __restrict__ out,
+    const int64_t N,
+    const float scale,
+    const int32_t zero_point) {
+  constexpr int32_t qmin = std::numeric_limits<T>::min();
+  constexpr int32_t qmax = std::numeric_limits<T>::max();
+  const __m512 vinv_scale = _mm512_set1_ps(1.0f / scale);
+  const __m512 vclamp_min = _mm512_set1_ps(kQuantizeClampMin);
+  const __m512 vclamp_max = _mm512_set1_ps(kQuantizeClampMax);
+  const __m512i vzero_point = _mm512_set1_epi32(zero_point);
+  const __m512i vqmin = _mm512_set1_epi32(qmin);
+  const __m512i vqmax = _mm512_set1_epi32(qmax);
+  int64_t i = 0;
+  for (; i + 16 <= N; i += 16) {
+    __m512 vx = _mm512_mul_ps(_mm512_loadu_ps(in + i), vinv_scale);
+    vx = _mm512_min_ps(_mm512_max_ps(vx, vclamp_min), vclamp_max);
+    // Rounds with the current rounding mode (nearest-even by default).
+    __m512i vq = _mm512_add_epi32(_mm512_cvtps_epi32(vx), vzero_point);
+    vq = _mm512_min_epi32(_mm512_max_epi32(vq, vqmin), vqmax);
+    _mm_storeu_si128(
+        reinterpret_cast<__m128i*>(out + i), _mm512_cvtepi32_epi8(vq));
+  }
+  for (; i < N; ++i) {
+    out[i] = quantize_val<T>(scale, zero_point, in[i]);
+  }
+}
+
+template <typename T>
+__attribute__((target("avx2"))) void quantize_tensor_avx2_q8(
+    const float* __restrict__ in,
+    T* __restrict__ out,
+    const int64_t N,
+    const float scale,
+    const int32_t zero_point) {
+  const __m256 vinv_scale = _mm256_set1_ps(1.0f / scale);
+  const __m256 vclamp_min = _mm256_set1_ps(kQuantizeClampMin);
+  const __m256 vclamp_max = _mm256_set1_ps(kQuantizeClampMax);
+  const __m256i vzero_point =
+      _mm256_set1_epi16(static_cast<int16_t>(zero_point));
+  // packs_epi32/packs_epi16 interleave 128-bit lanes; this restores order.
+  const __m256i vpermute = _mm256_setr_epi32(0, 4, 1, 5, 2, 6, 3, 7);
+  int64_t i = 0;
+  for (; i + 32 <= N; i += 32) {
+    __m256 vx0 = _mm256_mul_ps(_mm256_loadu_ps(in + i), vinv_scale);
+    __m256 vx1 = _mm256_mul_ps(_mm256_loadu_ps(in + i + 8), vinv_scale);
+    __m256 vx2 = _mm256_mul_ps(_mm256_loadu_ps(in + i + 16), vinv_scale);
+    __m256 vx3 = _mm256_mul_ps(_mm256_loadu_ps(in + i + 24), vinv_scale);
+    vx0 = _mm256_min_ps(_mm256_max_ps(vx0, vclamp_min), vclamp_max);
+    vx1 = _mm256_min_ps(_mm256_max_ps(vx1, vclamp_min), vclamp_max);
+    vx2 = _mm256_min_ps(_mm256_max_ps(vx2, vclamp_min), vclamp_max);
+    vx3 = _mm256_min_ps(_mm256_max_ps(vx3, vclamp_min), vclamp_max);
+    const __m256i vq01 = _mm256_adds_epi16(
+        _mm256_packs_epi32(_mm256_cvtps_epi32(vx0), _mm256_cvtps_epi32(vx1)),
+        vzero_point);
+    const __m256i vq23 = _mm256_adds_epi16(
+        _mm256_packs_epi32(_mm256_cvtps_epi32(vx2), _mm256_cvtps_epi32(vx3)),
+        vzero_point);
+    __m256i vq;
+    if (std::is_same<T, uint8_t>::value) {
+      vq = _mm256_packus_epi16(vq01, vq23);
+    } else {
+      vq = _mm256_packs_epi16(vq01, vq23);
+    }
+    vq = _mm256_permutevar8x32_epi32(vq, vpermute);
+    _mm256_storeu_si256(reinterpret_cast<__m256i*>(out + i), vq);
+  }
+  for (; i < N; ++i) {
+    out[i] = quantize_val<T>(scale, zero_point, in[i]);
+  }
+}
+
+template <typename T>
+void quantize_tensor_x86_q8(
+    const float* __restrict__ in,
+    T* __restrict__ out,
+    const int64_t N,
+    const float scale,
+    const int32_t zero_point) {
+  if (cpu_has_avx512f()) {
+    quantize_tensor_avx512f_q8<T>(in, out, N, scale, zero_point);
+  } else if (cpu_has_avx2()) {
+    quantize_tensor_avx2_q8<T>(in, out, N, scale, zero_point);
+  } else {
+    for (int64_t i = 0; i < N; ++i) {
+      out[i] = quantize_val<T>(scale, zero_point, in[i]);
+    }
+  }
+}
+
+} // namespace
+
+template <>
+void quantize_tensor_x86_q8_wrapper<uint8_t>(
+    const float* __restrict__ in,
+    uint8_t* __restrict__ out,
+    const int64_t N,
+    const float scale,
+    const int32_t zero_point) {
+  quantize_tensor_x86_q8<uint8_t>(in, out, N, scale, zero_point);
+}
+
+template <>
+void quantize_tensor_x86_q8_wrapper<int8_t>(
+    const float* __restrict__ in,
+    int8_t* __restrict__ out,
+    const int64_t N,
+    const float scale,
+    const int32_t zero_point) {
+  quantize_tensor_x86_q8<int8_t>(in, out, N, scale, zero_point);
+}
+#endif /* QNNPACK_UTILS_X86_DISPATCH */
+
+std::pair<float, float> GetMinMax(const float* d, size_t n) {
+#ifdef QNNPACK_UTILS_X86_DISPATCH
+  if (cpu_has_avx512f()) {
+    return get_min_max_avx512f(d, n);
+  }
+  if (cpu_has_avx2()) {
+    return get_min_max_avx2(d, n);
+  }
+#endif /* QNNPACK_UTILS_X86_DISPATCH */
+  float min = std::numeric_limits<float>::max();
+  float max = -std::numeric_limits<float>::max();
+  size_t i = 0;
+#if defined(__aarch64__)
+  if (n >= 4) {
+    float32x4_t vmin = vdupq_n_f32(min);
+    float32x4_t vmax = vdupq_n_f32(max);
+    for (; i + 4 <= n; i += 4) {
+      const float32x4_t vx = vld1q_f32(d + i);
+      // vminnm/vmaxnm return the number when one operand is NaN.
+      vmin = vminnmq_f32(vmin, vx);
+      vmax = vmaxnmq_f32(vmax, vx);
+    }
+    min = vminnmvq_f32(vmin);
+    max = vmaxnmvq_f32(vmax);
+  }
+#endif
+  for (; i < n; ++i) {
+    min = (d[i] < min) ? d[i] : min;
+    max = (d[i] > max) ? d[i] : max;
+  }
+  return std::pair<float, float>(min, max);
+}
+
+std::pair<float, float> GetMinMax(const Tensor& ft) {
+  ET_CHECK_MSG(
+      ft.scalar_type() == ScalarType::Float,
+      "Expected float tensor but got %" PRId8,
+      static_cast<int8_t>(ft.scalar_type()));
+  return GetMinMax(ft.const_data_ptr<float>(), ft.numel());
+}
+
 #ifdef __aarch64__
 template <>
 uint8x8_t vqmov<uint8x8_t>(int16x8_t vraw) {
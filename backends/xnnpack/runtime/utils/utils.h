@@ -10,6 +10,8 @@
 #include <unistd.h>
 #include <cmath>
 #include <limits>
+#include <tuple>
+#include <type_traits>
 #include <vector>
 
 #include <executorch/runtime/core/error.h>
@@ -19,6 +21,13 @@
 #include <arm_neon.h>
 #endif
 
+// On x86 the AVX2 and AVX-512F kernels are picked at run time, so builds
+// don't need -mavx2/-mavx512f to get them.
+#if defined(__x86_64__) && (defined(__GNUC__) || defined(__clang__))
+#define QNNPACK_UTILS_X86_DISPATCH
+#include <immintrin.h>
+#endif
+
 namespace torch {
 namespace executor {
 namespace qnnpack_utils {
@@ -124,6 +133,21 @@ void quantize_tensor_arm64_q8_wrapper(
 
 #endif /* __aarch64__ */
 
+#ifdef QNNPACK_UTILS_X86_DISPATCH
+/*
+ * x86 counterpart of quantize_tensor_arm64_q8(). Uses the widest vector
+ * extension the CPU supports (AVX-512F, then AVX2, else scalar) and rounds
+ * with the current rounding mode, matching quantize_val().
+ */
+template <typename T>
+void quantize_tensor_x86_q8_wrapper(
+    const float* __restrict__ in,
+    T* __restrict__ out,
+    const int64_t N,
+    const float scale,
+    const int32_t zero_point);
+#endif /* QNNPACK_UTILS_X86_DISPATCH */
+
 template <typename T = uint8_t>
 Error QuantizePerTensor(
     const exec_aten::Tensor& rtensor,
@@ -146,6 +170,8 @@ Error QuantizePerTensor(
 
 #if defined(__aarch64__)
   quantize_tensor_arm64_q8_wrapper<T>(rdata, qdata, numel, scale, zero_point);
+#elif defined(QNNPACK_UTILS_X86_DISPATCH)
+  quantize_tensor_x86_q8_wrapper<T>(rdata, qdata, numel, scale, zero_point);
 #else
   for (int i = 0; i < numel; ++i) {
     qdata[i] = quantize_val<T>(scale, zero_point, rdata[i]);
@@ -162,6 +188,45 @@ Error GenerateRequantizationScale(
 
 std::pair<float, float> GetMinMax(const exec_aten::Tensor& ft);
 
+/**
+ * Returns the (min, max) of `n` contiguous floats. NaNs are ignored. Uses
+ * AVX-512F/AVX2/NEON when available.
+ */
+std::pair<float, float> GetMinMax(const float* data, size_t n);
+
+/**
+ * Dynamically quantizes `rtensor` into `qtensor` with a single scale and zero
+ * point: computes min/max, chooses the asymmetric quantization parameters for
+ * the full range of T and quantizes. The chosen parameters are written to
+ * `qparams`.
+ *
+ * This reads `rtensor` twice. The scale depends on the min/max of the whole
+ * tensor, so no element can be quantized before every element has been seen;
+ * a single fused pass would only be possible with one scale per block.
+ */
+template <typename T = int8_t>
+Error QuantizeDynamicPerTensor(
+    const exec_aten::Tensor& rtensor,
+    exec_aten::Tensor& qtensor,
+    QuantizationParams& qparams) {
+  float min, max;
+  std::tie(min, max) = GetMinMax(rtensor);
+  Error e = ChooseQuantizationParams(
+      min,
+      max,
+      std::numeric_limits<T>::min(),
+      std::numeric_limits<T>::max(),
+      qparams,
+      false, /* preserve_sparsity */
+      false, /* force_scale_power_of_two */
+      false /* reduce_range */
+  );
+  ET_CHECK_OR_RETURN_ERROR(
+      e == Error::Ok, Internal, "ChooseQuantizationParams() failed");
+  return QuantizePerTensor<T>(
+      rtensor, qtensor, qparams.scale, qparams.zero_point);
+}
+
 } // namespace qnnpack_utils
 } // namespace executor
 } // namespace torch
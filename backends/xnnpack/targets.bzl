@@ -50,33 +50,39 @@ def define_common_targets():
         exported_external_deps = ["flatbuffers-api"],
     )
 
-    runtime.cxx_library(
-        name = "xnnpack_backend",
-        srcs = native.glob([
-            "runtime/*.cpp",
-        ]),
-        headers = native.glob([
-            "runtime/*.h",
-        ]),
-        visibility = [
-            "//executorch/exir/backend:backend_lib",
-            "//executorch/exir/backend/test/...",
-            "//executorch/backends/xnnpack/test/...",
-            "//executorch/extension/pybindings/...",
-            "@EXECUTORCH_CLIENTS",
-        ],
-        preprocessor_flags = [
-            # "-DENABLE_XNNPACK_PROFILING",
-        ] + ([] if runtime.is_oss else ["-DENABLE_DYNAMIC_QUANTIZATION"]),
-        deps = [
-            third_party_dep("XNNPACK"),
-            ":xnnpack_schema",
-            ":dynamic_quant_utils",  # TODO Use (1) portable for choose_qparams(), (2) xnnpack for quantize_per_tensor(),
-            "//executorch/runtime/backend:interface",
-            "//executorch/backends/xnnpack/threadpool:threadpool",
-            "//executorch/runtime/core/exec_aten/util:tensor_util",
-        ],
-        # XnnpackBackend.cpp needs to compile with executor as whole
-        # @lint-ignore BUCKLINT: Avoid `link_whole=True` (https://fburl.com/avoid-link-whole)
-        link_whole = True,
-    )
+    # The "_shared_weights" variant packs the weights of all delegates into
+    # one process-wide cache; see ENABLE_XNNPACK_SHARED_WEIGHTS.
+    for shared_weights in (False, True):
+        shared_weights_suffix = "_shared_weights" if shared_weights else ""
+
+        runtime.cxx_library(
+            name = "xnnpack_backend" + shared_weights_suffix,
+            srcs = native.glob([
+                "runtime/*.cpp",
+            ]),
+            headers = native.glob([
+                "runtime/*.h",
+            ]),
+            visibility = [
+                "//executorch/exir/backend:backend_lib",
+                "//executorch/exir/backend/test/...",
+                "//executorch/backends/xnnpack/test/...",
+                "//executorch/extension/pybindings/...",
+                "@EXECUTORCH_CLIENTS",
+            ],
+            preprocessor_flags = [
+                # "-DENABLE_XNNPACK_PROFILING",
+            ] + (["-DENABLE_XNNPACK_SHARED_WEIGHTS"] if shared_weights else []) +
+            ([] if runtime.is_oss else ["-DENABLE_DYNAMIC_QUANTIZATION"]),
+            deps = [
+                third_party_dep("XNNPACK"),
+                ":xnnpack_schema",
+                ":dynamic_quant_utils",  # TODO Use (1) portable for choose_qparams(), (2) xnnpack for quantize_per_tensor(),
+                "//executorch/runtime/backend:interface",
+                "//executorch/backends/xnnpack/threadpool:threadpool",
+                "//executorch/runtime/core/exec_aten/util:tensor_util",
+            ],
+            # XnnpackBackend.cpp needs to compile with executor as whole
+            # @lint-ignore BUCKLINT: Avoid `link_whole=True` (https://fburl.com/avoid-link-whole)
+            link_whole = True,
+        )
@@ -0,0 +1,74 @@
+# Copyright (c) Meta Platforms, Inc. and affiliates.
+# All rights reserved.
+#
+# This source code is licensed under the BSD-style license found in the
+# LICENSE file in the root directory of this source tree.
+
+"""Exports XNNPACK-delegated linear layers for the runtime tests.
+
+Writes LinearDouble.pte, which computes 2 * x + 1, and LinearNegate.pte, which
+computes -x. Both have a 4x4 weight, so their delegates have the same shapes
+and only differ in their constant data.
+"""
+
+import argparse
+import os
+
+import torch
+from executorch.backends.xnnpack.partition.xnnpack_partitioner import (
+    XnnpackPartitioner,
+)
+from executorch.backends.xnnpack.utils.configs import (
+    get_xnnpack_executorch_backend_config,
+)
+from executorch.backends.xnnpack.utils.utils import capture_graph_for_xnnpack
+from executorch.exir.backend.backend_api import to_backend, validation_disabled
+from torch import nn
+
+
+def make_linear(scale: float, bias: float) -> nn.Module:
+    linear = nn.Linear(4, 4)
+    with torch.no_grad():
+        linear.weight.copy_(scale * torch.eye(4))
+        linear.bias.fill_(bias)
+    return linear.eval()
+
+
+MODULES = {
+    "LinearDouble": lambda: make_linear(2.0, 1.0),
+    "LinearNegate": lambda: make_linear(-1.0, 0.0),
+}
+
+
+def export_to_buffer(module: nn.Module) -> bytes:
+    edge_program = capture_graph_for_xnnpack(module, (torch.ones(1, 4),))
+    with validation_disabled():
+        edge_program.exported_program = to_backend(
+            edge_program.exported_program, XnnpackPartitioner
+        )
+    return edge_program.to_executorch(get_xnnpack_executorch_backend_config()).buffer
+
+
+def main() -> None:
+    parser = argparse.ArgumentParser(
+        prog="export_linear_programs",
+        description="Exports XNNPACK-delegated linear layers to .pte files",
+    )
+    parser.add_argument(
+        "--outdir",
+        type=str,
+        required=True,
+        help="Path to the directory to write <name>.pte files to",
+    )
+    args = parser.parse_args()
+
+    os.makedirs(args.outdir, exist_ok=True)
+    for name, make_module in MODULES.items():
+        outfile = os.path.join(args.outdir, f"{name}.pte")
+        with open(outfile, "wb") as fp:
+            fp.write(export_to_buffer(make_module()))
+        print(f"Exported {name} to {outfile}")
+
+
+if __name__ == "__main__":
+    main()
@@ -109,3 +109,71 @@ TEST(TestUtils, get_min_max) {
   EXPECT_FLOAT_EQ(min, -2.2);
   EXPECT_FLOAT_EQ(max, 2.2);
 }
+
+TEST(TestUtils, get_min_max_vectorized_tail) {
+  // Sizes that exercise the vector body, the narrower vector loop and the
+  // scalar tail.
+  for (int n : {2, 7, 8, 17, 33, 64, 101}) {
+    std::vector<float> data(n);
+    for (int i = 0; i < n; ++i) {
+      data[i] = static_cast<float>((i * 37) % 23) - 11.5f;
+    }
+    data[n - 1] = -100.0f;
+    data[(n - 1) / 2] = 100.0f;
+    float min, max;
+    std::tie(min, max) =
+        torch::executor::qnnpack_utils::GetMinMax(data.data(), data.size());
+    EXPECT_FLOAT_EQ(min, -100.0f);
+    EXPECT_FLOAT_EQ(max, 100.0f);
+  }
+}
+
+TEST(TestUtils, quantize_per_tensor_matches_scalar) {
+  // 67 elements covers the vectorized body and the scalar remainder.
+  std::vector<float> data(67);
+  for (size_t i = 0; i < data.size(); ++i) {
+    data[i] = static_cast<float>(i) * 0.37f - 12.0f;
+  }
+  TensorFactory<ScalarType::Float> tf;
+  const Tensor input = tf.make({67}, data);
+  TensorFactory<ScalarType::Char> tfo;
+  Tensor output = tfo.zeros({67});
+  double scale = 0.1;
+  int zero_point = -3;
+  Error e = torch::executor::qnnpack_utils::QuantizePerTensor<int8_t>(
+      input, output, scale, zero_point);
+  ASSERT_EQ(e, Error::Ok);
+  const int8_t* q = output.const_data_ptr<int8_t>();
+  for (size_t i = 0; i < data.size(); ++i) {
+    EXPECT_EQ(
+        q[i],
+        torch::executor::qnnpack_utils::quantize_val<int8_t>(
+            scale, zero_point, data[i]));
+  }
+}
+
+TEST(TestUtils, quantize_per_tensor_saturates_uint8) {
+  // Values far outside the quantized range must clamp, in the vectorized
+  // body as well as in the remainder.
+  std::vector<float> data(75);
+  for (size_t i = 0; i < data.size(); ++i) {
+    data[i] = (i % 3 == 0 ? -1.0e6f : 1.0e6f) * static_cast<float>(i % 5) +
+        static_cast<float>(i);
+  }
+  TensorFactory<ScalarType::Float> tf;
+  const Tensor input = tf.make({75}, data);
+  TensorFactory<ScalarType::Byte> tfo;
+  Tensor output = tfo.zeros({75});
+  double scale = 0.5;
+  int zero_point = 128;
+  Error e = torch::executor::qnnpack_utils::QuantizePerTensor<uint8_t>(
+      input, output, scale, zero_point);
+  ASSERT_EQ(e, Error::Ok);
+  const uint8_t* q = output.const_data_ptr<uint8_t>();
+  for (size_t i = 0; i < data.size(); ++i) {
+    EXPECT_EQ(
+        q[i],
+        torch::executor::qnnpack_utils::quantize_val<uint8_t>(
+            scale, zero_point, data[i]));
+  }
+}
@@ -0,0 +1,109 @@
+/*
+ * Copyright (c) Meta Platforms, Inc. and affiliates.
+ * All rights reserved.
+ *
+ * This source code is licensed under the BSD-style license found in the
+ * LICENSE file in the root directory of this source tree.
+ */
+
+#include <gtest/gtest.h>
+
+#include <cstdlib>
+#include <memory>
+#include <vector>
+
+#include <executorch/extension/data_loader/file_data_loader.h>
+#include <executorch/runtime/core/exec_aten/exec_aten.h>
+#include <executorch/runtime/executor/method.h>
+#include <executorch/runtime/executor/program.h>
+#include <executorch/runtime/executor/test/managed_memory_manager.h>
+#include <executorch/runtime/platform/runtime.h>
+
+using namespace ::testing;
+
+using exec_aten::ScalarType;
+using exec_aten::Tensor;
+using torch::executor::Error;
+using torch::executor::EValue;
+using torch::executor::Method;
+using torch::executor::Program;
+using torch::executor::Result;
+using torch::executor::TensorImpl;
+using torch::executor::testing::ManagedMemoryManager;
+using torch::executor::util::FileDataLoader;
+
+constexpr size_t kDefaultNonConstMemBytes = 32 * 1024U;
+constexpr size_t kDefaultRuntimeMemBytes = 32 * 1024U;
+
+class SharedWeightsTest : public ::testing::Test {
+ protected:
+  void SetUp() override {
+    torch::executor::runtime_init();
+  }
+
+  // Loads the forward method of the program at the path in `env`. Each
+  // delegate's data is freed once its runtime is built, so a delegate loaded
+  // later may well get the same address for its own, different weights.
+  void load_method(const char* env) {
+    Result<FileDataLoader> loader = FileDataLoader::from(std::getenv(env));
+    ASSERT_EQ(loader.error(), Error::Ok);
+    loaders_.push_back(
+        std::make_unique<FileDataLoader>(std::move(loader.get())));
+
+    Result<Program> program = Program::load(
+        loaders_.back().get(), Program::Verification::InternalConsistency);
+    ASSERT_EQ(program.error(), Error::Ok);
+    programs_.push_back(std::make_unique<Program>(std::move(program.get())));
+
+    memory_managers_.push_back(std::make_unique<ManagedMemoryManager>(
+        kDefaultNonConstMemBytes, kDefaultRuntimeMemBytes));
+    Result<Method> method = programs_.back()->load_method(
+        "forward", &memory_managers_.back()->get());
+    ASSERT_EQ(method.error(), Error::Ok);
+    methods_.push_back(std::make_unique<Method>(std::move(method.get())));
+  }
+
+  // Runs `method` on x = [1, 2, 3, 4] and checks that it computes
+  // scale * x + bias.
+  static void execute_and_check(Method& method, float scale, float bias) {
+    float x[4] = {1, 2, 3, 4};
+    int32_t sizes[2] = {1, 4};
+    uint8_t dim_order[2] = {0, 1};
+    int32_t strides[2] = {4, 1};
+    TensorImpl impl(ScalarType::Float, 2, sizes, x, dim_order, strides);
+    ASSERT_EQ(method.set_input(EValue(Tensor(&impl)), 0), Error::Ok);
+
+    ASSERT_EQ(method.execute(), Error::Ok);
+
+    const EValue& output = method.get_output(0);
+    ASSERT_TRUE(output.isTensor());
+    ASSERT_EQ(output.toTensor().numel(), 4);
+    for (size_t i = 0; i < 4; ++i) {
+      EXPECT_FLOAT_EQ(
+          output.toTensor().const_data_ptr<float>()[i], scale * x[i] + bias);
+    }
+  }
+
+ private:
+  // Must outlive the methods, but tests shouldn't need to touch them.
+  std::vector<std::unique_ptr<FileDataLoader>> loaders_;
+  std::vector<std::unique_ptr<Program>> programs_;
+  std::vector<std::unique_ptr<ManagedMemoryManager>> memory_managers_;
+
+ protected:
+  std::vector<std::unique_ptr<Method>> methods_;
+};
+
+TEST_F(SharedWeightsTest, SameShapesDifferentWeights) {
+  ASSERT_NO_FATAL_FAILURE(load_method("ET_LINEAR_DOUBLE_PATH"));
+  execute_and_check(*methods_[0], 2, 1);
+
+  ASSERT_NO_FATAL_FAILURE(load_method("ET_LINEAR_NEGATE_PATH"));
+  execute_and_check(*methods_[1], -1, 0);
+
+  // Loading the same weights again shares them, and changes neither result.
+  ASSERT_NO_FATAL_FAILURE(load_method("ET_LINEAR_DOUBLE_PATH"));
+  execute_and_check(*methods_[2], 2, 1);
+  execute_and_check(*methods_[0], 2, 1);
+  execute_and_check(*methods_[1], -1, 0);
+}
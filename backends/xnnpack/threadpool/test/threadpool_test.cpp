@@ -14,6 +14,9 @@
 #include <executorch/backends/xnnpack/threadpool/threadpool.h>
 #include <executorch/backends/xnnpack/threadpool/threadpool_guard.h>
 
+#include <sys/wait.h>
+#include <unistd.h>
+
 using namespace ::testing;
 
 namespace {
@@ -186,3 +189,31 @@ TEST(TestNoThreadPoolGuard, TestRunWithGuard) {
   }
   ASSERT_EQ(inner, 6);
 }
+
+TEST(ThreadPoolTest, ForkedChildGetsItsOwnPool) {
+  auto parent_pool = torch::executorch::threadpool::get_threadpool();
+  const size_t thread_count = parent_pool->get_thread_count();
+  EXPECT_GT(thread_count, 1);
+
+  pid_t pid = fork();
+  ASSERT_NE(pid, -1);
+  if (pid == 0) {
+    // The parent's worker threads don't exist here; running on them would
+    // hang, so the child must get a fresh pool of the same size.
+    auto pool = torch::executorch::threadpool::get_threadpool();
+    std::vector<int32_t> a, b, c, c_ref;
+    generate_add_test_inputs(a, b, c_ref, c, 100);
+    pool->run([&](size_t i) { c[i] = a[i] + b[i]; }, 100);
+    bool ok = pool != parent_pool && pool->get_thread_count() == thread_count &&
+        c == c_ref;
+    _exit(ok ? 0 : 1);
+  }
+
+  int status = 0;
+  ASSERT_EQ(waitpid(pid, &status, 0), pid);
+  ASSERT_TRUE(WIFEXITED(status));
+  EXPECT_EQ(WEXITSTATUS(status), 0);
+
+  // The parent keeps its pool.
+  EXPECT_EQ(torch::executorch::threadpool::get_threadpool(), parent_pool);
+}
@@ -27,8 +27,21 @@ namespace {
 // Ref: https://github.com/pytorch/pytorch/issues/54752#issuecomment-810315302
 bool leak_corrupted_threadpool = false;
 
+// Guards the singleton in get_threadpool(). It is held across fork() so that
+// a child never inherits it locked by a thread that does not exist there.
+std::mutex threadpool_mutex;
+
+void prepare_atfork() {
+  threadpool_mutex.lock();
+}
+
+void parent_atfork() {
+  threadpool_mutex.unlock();
+}
+
 void child_atfork() {
   leak_corrupted_threadpool = true;
+  threadpool_mutex.unlock();
 }
 
 } // namespace
@@ -80,8 +93,6 @@ void ThreadPool::run(
       0u);
 }
 
-// get_threadpool is not thread safe due to leak_corrupted_threadpool
-// Make this part threadsafe: TODO(kimishpatel)
 ThreadPool* get_threadpool() {
   ET_CHECK_MSG(cpuinfo_initialize(), "cpuinfo initialization failed");
   int num_threads = cpuinfo_get_processors_count();
@@ -95,20 +106,31 @@ ThreadPool* get_threadpool() {
    */
   constexpr int tsan_thread_limit = 63;
   num_threads = std::min(num_threads, tsan_thread_limit);
-  static auto threadpool = std::make_unique<ThreadPool>(num_threads);
 
 // Inheriting from old threadpool to get around segfault issue
 // commented above at child_atfork
 #if !(defined(WIN32))
+  // Register before the pool exists, so that no fork can happen between
+  // creating its threads and being able to tell that they are gone.
   // @lint-ignore CLANGTIDY facebook-hte-std::once_flag
   static std::once_flag flag;
   // @lint-ignore CLANGTIDY facebook-hte-std::call_once
-  std::call_once(
-      flag, []() { pthread_atfork(nullptr, nullptr, child_atfork); });
+  std::call_once(flag, []() {
+    pthread_atfork(prepare_atfork, parent_atfork, child_atfork);
+  });
+  std::lock_guard<std::mutex> lock{threadpool_mutex};
+#endif
+  static auto threadpool = std::make_unique<ThreadPool>(num_threads);
+
+#if !(defined(WIN32))
+  // Each forked process creates its own pool the first time it needs one, so
+  // processes that never run a parallel op never start any threads.
   if __ET_UNLIKELY (leak_corrupted_threadpool) {
     leak_corrupted_threadpool = false;
     if (auto leaked = threadpool.release()) {
-      auto t = leaked->get_thread_count();
+      // Don't go through get_thread_count(): a thread that no longer exists
+      // may have held the leaked pool's mutex at fork time.
+      auto t = pthreadpool_get_threads_count(leaked->threadpool_.get());
       threadpool = std::make_unique<ThreadPool>(t);
     }
   }
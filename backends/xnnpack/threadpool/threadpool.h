@@ -42,6 +42,7 @@ class ThreadPool final {
   void run(const std::function<void(size_t)>& fn, size_t range);
 
  private:
+  friend ThreadPool* get_threadpool();
   friend pthreadpool_t get_pthreadpool();
 
  private:
@@ -8,9 +8,12 @@
 # both AOT and runtime.
 
 # Selective build. See codegen/tools/gen_oplist.py for how to use these
-# arguments.
+# arguments. Any further arguments are paths to model files (.pte); the
+# operators they call, and the dtypes and dim orders they call them with, are
+# selected too.
 function(gen_selected_ops ops_schema_yaml root_ops include_all_ops)
   set(_oplist_yaml ${CMAKE_CURRENT_BINARY_DIR}/selected_operators.yaml)
+  set(_model_files ${ARGN})
   file(GLOB_RECURSE _codegen_tools_srcs "${EXECUTORCH_ROOT}/codegen/tools/*.py")
 
   set(_gen_oplist_command "${PYTHON_EXECUTABLE}" -m codegen.tools.gen_oplist
@@ -25,17 +28,52 @@ function(gen_selected_ops ops_schema_yaml root_ops include_all_ops)
   if(include_all_ops)
     list(APPEND _gen_oplist_command --include_all_operators)
   endif()
+  if(_model_files)
+    list(JOIN _model_files "," _model_file_paths)
+    list(APPEND _gen_oplist_command --model_file_path="${_model_file_paths}")
+  endif()
 
   message("Command - ${_gen_oplist_command}")
   add_custom_command(
     COMMENT "Generating selected_operators.yaml for custom ops"
     OUTPUT ${_oplist_yaml}
     COMMAND ${_gen_oplist_command}
-    DEPENDS ${ops_schema_yaml} ${_codegen_tools_srcs}
+    DEPENDS ${ops_schema_yaml} ${_model_files} ${_codegen_tools_srcs}
     WORKING_DIRECTORY ${EXECUTORCH_ROOT})
 
 endfunction()
 
+# Dtype selective build. Generates selected_mobile_ops.h from the
+# selected_operators.yaml made by gen_selected_ops(), and builds
+# kernel_sources into lib_name with it. Each ET_SWITCH in those kernels then
+# only instantiates the dtypes that the selected operators are used with, and
+# operators that aren't selected keep none.
+function(gen_dtype_selective_kernels_lib lib_name kernel_sources deps)
+  set(_oplist_yaml ${CMAKE_CURRENT_BINARY_DIR}/selected_operators.yaml)
+  # Kernels include the header as
+  # <executorch/runtime/core/exec_aten/util/selected_mobile_ops.h>.
+  set(_include_dir ${CMAKE_CURRENT_BINARY_DIR}/${lib_name}_include)
+  set(_header_dir ${_include_dir}/executorch/runtime/core/exec_aten/util)
+  set(_header ${_header_dir}/selected_mobile_ops.h)
+
+  add_custom_command(
+    COMMENT "Generating selected_mobile_ops.h for dtype selective build"
+    OUTPUT ${_header}
+    COMMAND ${CMAKE_COMMAND} -E make_directory ${_header_dir}
+    COMMAND
+      "${PYTHON_EXECUTABLE}" -m codegen.tools.gen_selected_mobile_ops
+      --yaml_file_path=${_oplist_yaml} --output_dir=${_header_dir}
+    DEPENDS ${_oplist_yaml}
+            ${EXECUTORCH_ROOT}/codegen/tools/gen_selected_mobile_ops.py
+    WORKING_DIRECTORY ${EXECUTORCH_ROOT})
+
+  add_library(${lib_name} ${kernel_sources} ${_header})
+  target_include_directories(${lib_name} BEFORE PRIVATE ${_include_dir})
+  target_compile_definitions(${lib_name}
+                             PRIVATE EXECUTORCH_SELECTIVE_BUILD_DTYPE)
+  target_link_libraries(${lib_name} PRIVATE ${deps})
+endfunction()
+
 # Codegen for registering kernels. Kernels are defined in functions_yaml and
 # custom_ops_yaml
 function(generate_bindings_for_kernels functions_yaml custom_ops_yaml)
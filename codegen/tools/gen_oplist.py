@@ -115,7 +115,7 @@ def _get_kernel_metadata_for_model(model_file: str) -> Dict[str, List[str]]:
         if op_name not in op_kernel_key_list:
             op_kernel_key_list[op_name] = []
 
-        for specialized_kernel in specialized_kernels:
+        for specialized_kernel in sorted(specialized_kernels):
             version = "v1"
             kernel_key = version + "/"
             for io_metadata in specialized_kernel:
@@ -203,7 +203,10 @@ def main(args: List[Any]) -> None:
     )
     parser.add_argument(
         "--model_file_path",
-        help=("Path to an executorch program"),
+        help=(
+            "Path to an executorch program, or a comma separated list of paths "
+            + "to select the union of what the programs use"
+        ),
         required=False,
     )
     parser.add_argument(
@@ -240,14 +243,16 @@ def main(args: List[Any]) -> None:
             et_kernel_metadata, {op: ["default"] for op in op_set}
         )
     if options.model_file_path:
-        assert os.path.isfile(
-            options.model_file_path
-        ), "The value for --model_file_path needs to be a valid file."
-        op_set.update(_get_operators(options.model_file_path))
-        source_name = options.model_file_path
-        et_kernel_metadata = merge_et_kernel_metadata(
-            et_kernel_metadata, _get_kernel_metadata_for_model(options.model_file_path)
-        )
+        model_files = [f for f in options.model_file_path.split(",") if len(f) > 0]
+        for model_file in model_files:
+            assert os.path.isfile(
+                model_file
+            ), "The value for --model_file_path needs to be a valid file."
+            op_set.update(_get_operators(model_file))
+            et_kernel_metadata = merge_et_kernel_metadata(
+                et_kernel_metadata, _get_kernel_metadata_for_model(model_file)
+            )
+        source_name = model_files[0] if len(model_files) == 1 else None
     if options.ops_schema_yaml_path:
         assert os.path.isfile(
             options.ops_schema_yaml_path
@@ -0,0 +1,111 @@
+# Copyright (c) Meta Platforms, Inc. and affiliates.
+# All rights reserved.
+#
+# This source code is licensed under the BSD-style license found in the
+# LICENSE file in the root directory of this source tree.
+
+"""Reads the operators, and the dtypes and dim orders of their tensor
+arguments, out of a serialized ExecuTorch program (.pte). Used by
+gen_oplist.py to drive selective build from model files.
+"""
+
+from dataclasses import dataclass
+from typing import Dict, List, Optional, Set, Tuple
+
+from executorch.exir._serialize._program import deserialize_pte_binary
+from executorch.exir.schema import (
+    EValue,
+    KernelCall,
+    OptionalTensorList,
+    Program,
+    Tensor,
+    TensorList,
+)
+
+
+# Matches the KernelTypes union tags in schema/program.fbs, and KernelType in
+# gen_oplist.py.
+_TENSOR: int = 5
+_TENSOR_LIST: int = 10
+_OPTIONAL_TENSOR_LIST: int = 11
+
+
+@dataclass(frozen=True, order=True)
+class _IOMetaData:
+    """The dtype and dim order of one tensor argument of a kernel call. For
+    lists, those of the first tensor in the list.
+    """
+
+    kernel_type: int
+    dtype: int
+    dim_order: Tuple[int, ...]
+
+
+def _get_program_from_buffer(buf: bytes) -> Program:
+    return deserialize_pte_binary(buf)
+
+
+def _get_program_operators(program: Program) -> List[str]:
+    """Returns the names of all operators called by the program, in the
+    `namespace::name.overload` form used by selected_operators.yaml.
+    """
+    operators: Set[str] = set()
+    for plan in program.execution_plan:
+        for op in plan.operators:
+            operators.add(f"{op.name}.{op.overload}" if op.overload else op.name)
+    return sorted(operators)
+
+
+def _tensor_metadata(kernel_type: int, tensor: Tensor) -> _IOMetaData:
+    return _IOMetaData(
+        kernel_type=kernel_type,
+        dtype=int(tensor.scalar_type),
+        dim_order=tuple(int(d) for d in tensor.dim_order),
+    )
+
+
+def _get_io_metadata(
+    values: List[EValue], value_index: int
+) -> Optional[_IOMetaData]:
+    val = values[value_index].val
+    if isinstance(val, Tensor):
+        return _tensor_metadata(_TENSOR, val)
+    if isinstance(val, (TensorList, OptionalTensorList)):
+        kernel_type = (
+            _TENSOR_LIST if isinstance(val, TensorList) else _OPTIONAL_TENSOR_LIST
+        )
+        for item in val.items:
+            # Optional lists use -1 for None.
+            if item >= 0 and isinstance(values[item].val, Tensor):
+                return _tensor_metadata(kernel_type, values[item].val)
+    return None
+
+
+def _get_io_metadata_for_program_operators(
+    program: Program,
+) -> Dict[str, Set[Tuple[_IOMetaData, ...]]]:
+    """Returns, for each operator called by the program, the distinct
+    combinations of tensor dtypes and dim orders it is called with. Each
+    combination lists the tensor arguments of one kernel call in argument
+    order; non-tensor arguments are left out.
+    """
+    op_io_metadata: Dict[str, Set[Tuple[_IOMetaData, ...]]] = {}
+    for plan in program.execution_plan:
+        op_names = [
+            f"{op.name}.{op.overload}" if op.overload else op.name
+            for op in plan.operators
+        ]
+        for chain in plan.chains:
+            for instruction in chain.instructions:
+                call = instruction.instr_args
+                if not isinstance(call, KernelCall):
+                    continue
+                io_metadata = tuple(
+                    m
+                    for m in (_get_io_metadata(plan.values, arg) for arg in call.args)
+                    if m is not None
+                )
+                op_io_metadata.setdefault(op_names[call.op_index], set()).add(
+                    io_metadata
+                )
+    return op_io_metadata
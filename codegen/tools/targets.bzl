@@ -8,6 +8,19 @@ def define_common_targets(is_fbcode = False):
 
     See README.md for instructions on selective build.
     """
+    runtime.python_library(
+        name = "selective_build",
+        srcs = ["selective_build.py"],
+        base_module = "executorch.codegen.tools",
+        visibility = [
+            "//executorch/...",
+        ],
+        deps = [
+            "//executorch/exir:schema",
+            "//executorch/exir/_serialize:lib",
+        ],
+    )
+
     runtime.python_library(
         name = "gen_oplist_lib",
         srcs = ["gen_oplist.py"],
@@ -18,7 +31,7 @@ def define_common_targets(is_fbcode = False):
         external_deps = ["torchgen"],
         deps = select({
             "DEFAULT": [],
-            "ovr_config//os:linux": [] if runtime.is_oss else ["//executorch/codegen/tools/fb:selective_build"],  # TODO(larryliu0820) :selective_build doesn't build in OSS yet
+            "ovr_config//os:linux": [":selective_build"] if runtime.is_oss else ["//executorch/codegen/tools/fb:selective_build"],
         }),
     )
 
@@ -78,6 +91,22 @@ def define_common_targets(is_fbcode = False):
         ],
     )
 
+    runtime.python_test(
+        name = "test_selective_build",
+        base_module = "",
+        srcs = [
+            "test/test_selective_build.py",
+        ],
+        deps = [
+            ":selective_build",
+            "//executorch/exir:scalar_type",
+        ],
+        package_style = "inplace",
+        visibility = [
+            "//executorch/...",
+        ],
+    )
+
     runtime.python_library(
         name = "gen_all_oplist_lib",
         srcs = ["gen_all_oplist.py"],
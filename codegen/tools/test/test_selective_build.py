@@ -0,0 +1,142 @@
+# Copyright (c) Meta Platforms, Inc. and affiliates.
+# All rights reserved.
+#
+# This source code is licensed under the BSD-style license found in the
+# LICENSE file in the root directory of this source tree.
+
+import unittest
+from typing import List
+
+from executorch.codegen.tools.selective_build import (
+    _get_io_metadata_for_program_operators,
+    _get_program_operators,
+    _IOMetaData,
+)
+from executorch.exir.scalar_type import ScalarType
+from executorch.exir.schema import (
+    Chain,
+    ContainerMetadata,
+    EValue,
+    ExecutionPlan,
+    Instruction,
+    Int,
+    KernelCall,
+    Null,
+    Operator,
+    OptionalTensorList,
+    Program,
+    Tensor,
+    TensorList,
+    TensorShapeDynamism,
+)
+
+
+def _tensor(scalar_type: ScalarType, dim_order: List[int]) -> EValue:
+    return EValue(
+        Tensor(
+            scalar_type=scalar_type,
+            storage_offset=0,
+            sizes=[1] * len(dim_order),
+            dim_order=dim_order,
+            requires_grad=False,
+            layout=0,
+            constant_buffer_idx=0,
+            allocation_info=None,
+            shape_dynamism=TensorShapeDynamism.STATIC,
+        )
+    )
+
+
+def _program(values: List[EValue], calls: List[KernelCall]) -> Program:
+    plan = ExecutionPlan(
+        name="forward",
+        container_meta_type=ContainerMetadata("", ""),
+        values=values,
+        inputs=[],
+        outputs=[],
+        chains=[
+            Chain(
+                inputs=[],
+                outputs=[],
+                instructions=[Instruction(call) for call in calls],
+                stacktrace=None,
+            )
+        ],
+        operators=[
+            Operator(name="aten::add", overload="out"),
+            Operator(name="aten::cat", overload="out"),
+            Operator(name="aten::index", overload="Tensor_out"),
+        ],
+        delegates=[],
+        non_const_buffer_sizes=[0],
+    )
+    return Program(
+        version=0,
+        execution_plan=[plan],
+        constant_buffer=[],
+        backend_delegate_data=[],
+        segments=[],
+    )
+
+
+class TestSelectiveBuild(unittest.TestCase):
+    def test_get_program_operators(self) -> None:
+        program = _program(values=[], calls=[])
+        self.assertEqual(
+            _get_program_operators(program),
+            ["aten::add.out", "aten::cat.out", "aten::index.Tensor_out"],
+        )
+
+    def test_io_metadata_skips_non_tensors_and_dedups(self) -> None:
+        values = [
+            _tensor(ScalarType.FLOAT, [0, 1]),  # 0
+            _tensor(ScalarType.INT, [0, 1]),  # 1
+            EValue(Int(1)),  # 2
+            _tensor(ScalarType.FLOAT, [0, 2, 3, 1]),  # 3
+        ]
+        calls = [
+            KernelCall(op_index=0, args=[0, 0, 2, 0, 0]),
+            # The same dtypes and dim orders again.
+            KernelCall(op_index=0, args=[0, 0, 2, 0, 0]),
+            KernelCall(op_index=0, args=[1, 1, 2, 1, 1]),
+            KernelCall(op_index=0, args=[3, 3, 2, 3, 3]),
+        ]
+        metadata = _get_io_metadata_for_program_operators(_program(values, calls))
+
+        self.assertEqual(list(metadata.keys()), ["aten::add.out"])
+        float_nchw = _IOMetaData(5, int(ScalarType.FLOAT), (0, 1))
+        int_nchw = _IOMetaData(5, int(ScalarType.INT), (0, 1))
+        float_nhwc = _IOMetaData(5, int(ScalarType.FLOAT), (0, 2, 3, 1))
+        self.assertEqual(
+            metadata["aten::add.out"],
+            {
+                (float_nchw,) * 4,
+                (int_nchw,) * 4,
+                (float_nhwc,) * 4,
+            },
+        )
+
+    def test_io_metadata_of_tensor_lists(self) -> None:
+        values = [
+            _tensor(ScalarType.HALF, [0, 1]),  # 0
+            EValue(TensorList(items=[0, 0])),  # 1
+            EValue(Int(0)),  # 2
+            EValue(Null()),  # 3
+            EValue(OptionalTensorList(items=[-1, 5])),  # 4
+            _tensor(ScalarType.LONG, [0]),  # 5
+        ]
+        calls = [
+            KernelCall(op_index=1, args=[1, 2, 0, 0]),
+            KernelCall(op_index=2, args=[0, 4, 0, 0]),
+        ]
+        metadata = _get_io_metadata_for_program_operators(_program(values, calls))
+
+        half = _IOMetaData(5, int(ScalarType.HALF), (0, 1))
+        self.assertEqual(
+            metadata["aten::cat.out"],
+            {(_IOMetaData(10, int(ScalarType.HALF), (0, 1)), half, half)},
+        )
+        self.assertEqual(
+            metadata["aten::index.Tensor_out"],
+            {(half, _IOMetaData(11, int(ScalarType.LONG), (0,)), half, half)},
+        )
@@ -20,6 +20,7 @@ def define_common_targets():
         name = "executor_cpu_optimized",
         exported_deps = [
             "//executorch/backends/xnnpack/threadpool:threadpool",
+            "//executorch/kernels/optimized/cpu:threadpool_parallel_backend",
         ] + get_all_cpu_backend_targets(),
         visibility = [
             "//executorch/test/...",
@@ -0,0 +1,77 @@
+# Copyright (c) Meta Platforms, Inc. and affiliates.
+# All rights reserved.
+#
+# This source code is licensed under the BSD-style license found in the
+# LICENSE file in the root directory of this source tree.
+
+"""Registers `llama::rms_norm`, a fused RMSNorm op, through the torch library
+API.
+
+The RMSNorm of the llama2 model decomposes into pow, mean, add, rsqrt and mul
+ops, each of which reads the whole activation. The optimized kernels provide
+`llama::rms_norm.out` (kernels/optimized/custom_ops.yaml), which computes the
+same result in a single kernel. Use `replace_rms_norm_with_fused_op()` on the
+eager model before export, and link the optimized kernels into the runtime.
+"""
+
+import torch
+from torch import nn
+from torch.library import impl, Library
+
+lib = Library("llama", "DEF")
+
+lib.define("rms_norm(Tensor input, Tensor? weight, float eps) -> Tensor")
+
+lib.define(
+    "rms_norm.out(Tensor input, Tensor? weight, float eps, *, Tensor(a!) out) -> Tensor(a!)"
+)
+
+
+def _rms_norm(input: torch.Tensor, weight, eps: float) -> torch.Tensor:
+    x = input.float()
+    output = (x * torch.rsqrt(x.pow(2).mean(-1, keepdim=True) + eps)).type_as(input)
+    return output if weight is None else output * weight
+
+
+@impl(lib, "rms_norm", "CompositeExplicitAutograd")
+def rms_norm_impl(input: torch.Tensor, weight, eps: float) -> torch.Tensor:
+    return _rms_norm(input, weight, eps)
+
+
+@impl(lib, "rms_norm", "Meta")
+def rms_norm_meta(input: torch.Tensor, weight, eps: float) -> torch.Tensor:
+    return torch.empty_like(input)
+
+
+@impl(lib, "rms_norm.out", "CompositeExplicitAutograd")
+def rms_norm_out_impl(
+    input: torch.Tensor, weight, eps: float, *, out: torch.Tensor
+) -> torch.Tensor:
+    out.copy_(_rms_norm(input, weight, eps))
+    return out
+
+
+class FusedRMSNorm(nn.Module):
+    """Drop-in replacement for llama's RMSNorm that calls `llama::rms_norm`."""
+
+    def __init__(self, weight: nn.Parameter, eps: float):
+        super().__init__()
+        self.eps = eps
+        self.weight = weight
+
+    def forward(self, x: torch.Tensor) -> torch.Tensor:
+        return torch.ops.llama.rms_norm.default(x, self.weight, self.eps)
+
+
+def replace_rms_norm_with_fused_op(module: nn.Module) -> nn.Module:
+    """Replaces every llama RMSNorm in `module` with a FusedRMSNorm sharing its
+    weight, in place, and returns `module`.
+    """
+    from llama.model import RMSNorm
+
+    for name, child in module.named_children():
+        if isinstance(child, RMSNorm):
+            setattr(module, name, FusedRMSNorm(child.weight, child.eps))
+        else:
+            replace_rms_norm_with_fused_op(child)
+    return module
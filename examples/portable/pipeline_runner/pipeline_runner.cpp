@@ -0,0 +1,230 @@
+/*
+ * Copyright (c) Meta Platforms, Inc. and affiliates.
+ * All rights reserved.
+ *
+ * This source code is licensed under the BSD-style license found in the
+ * LICENSE file in the root directory of this source tree.
+ */
+
+/**
+ * @file
+ *
+ * Measures how much streaming successive inputs through a model's stages
+ * concurrently helps, compared to running them one after another. Stages
+ * break at delegate calls; see MethodPipeline.
+ *
+ * Runs the first method of the model `num_frames` times back to back with
+ * Method::execute(), then again through a MethodPipeline, and prints the
+ * throughput and per-frame latency of both. All input tensors are ones.
+ */
+
+#include <algorithm>
+#include <chrono>
+#include <cinttypes>
+#include <cstdio>
+#include <memory>
+#include <vector>
+
+#include <gflags/gflags.h>
+
+#include <executorch/extension/data_loader/file_data_loader.h>
+#include <executorch/extension/memory_allocator/malloc_memory_allocator.h>
+#include <executorch/extension/pipeline/method_pipeline.h>
+#include <executorch/runtime/executor/method.h>
+#include <executorch/runtime/executor/program.h>
+#include <executorch/runtime/platform/log.h>
+#include <executorch/runtime/platform/runtime.h>
+#include <executorch/util/util.h>
+
+DEFINE_string(
+    model_path,
+    "model.pte",
+    "Model serialized in flatbuffer format.");
+
+DEFINE_int32(num_frames, 100, "Number of inputs to run through the model.");
+
+DEFINE_int32(
+    num_replicas,
+    0,
+    "Number of frames in flight. 0 uses one per stage; 2 double-buffers.");
+
+using namespace torch::executor;
+using torch::executor::util::FileDataLoader;
+using torch::executor::util::MallocMemoryAllocator;
+
+namespace {
+
+/**
+ * A Method along with the memory that backs it, so that several instances of
+ * the same Method can run at once.
+ */
+class Replica final {
+ public:
+  Replica(const Program& program, const char* method_name)
+      : planned_spans_(allocate_planned_buffers(program, method_name)),
+        planned_memory_({planned_spans_.data(), planned_spans_.size()}),
+        memory_manager_(&method_allocator_, &planned_memory_),
+        method_(program.load_method(method_name, &memory_manager_)) {
+    ET_CHECK_MSG(
+        method_.ok(),
+        "Loading of method %s failed with status 0x%" PRIx32,
+        method_name,
+        (uint32_t)method_.error());
+    inputs_ = util::PrepareInputTensors(*method_);
+  }
+
+  ~Replica() {
+    util::FreeInputs(inputs_);
+  }
+
+  Method& method() {
+    return *method_;
+  }
+
+ private:
+  std::vector<Span<uint8_t>> allocate_planned_buffers(
+      const Program& program,
+      const char* method_name) {
+    std::vector<Span<uint8_t>> spans;
+    Result<MethodMeta> method_meta = program.method_meta(method_name);
+    ET_CHECK_MSG(method_meta.ok(), "Failed to get method_meta");
+    for (size_t id = 0; id < method_meta->num_memory_planned_buffers(); ++id) {
+      // .get() will always succeed because id < num_memory_planned_buffers.
+      size_t buffer_size = static_cast<size_t>(
+          method_meta->memory_planned_buffer_size(id).get());
+      planned_buffers_.push_back(std::make_unique<uint8_t[]>(buffer_size));
+      spans.push_back({planned_buffers_.back().get(), buffer_size});
+    }
+    return spans;
+  }
+
+  MallocMemoryAllocator method_allocator_;
+  std::vector<std::unique_ptr<uint8_t[]>> planned_buffers_;
+  std::vector<Span<uint8_t>> planned_spans_;
+  HierarchicalAllocator planned_memory_;
+  MemoryManager memory_manager_;
+  Result<Method> method_;
+  exec_aten::ArrayRef<void*> inputs_;
+};
+
+double per_second(size_t count, int64_t us) {
+  return us == 0 ? 0.0 : count * 1e6 / us;
+}
+
+} // namespace
+
+int main(int argc, char** argv) {
+  runtime_init();
+
+  gflags::ParseCommandLineFlags(&argc, &argv, true);
+  if (argc != 1 || FLAGS_num_frames <= 0) {
+    ET_LOG(Error, "Usage: %s --model_path=<pte> [--num_frames=N]", argv[0]);
+    return 1;
+  }
+
+  const char* model_path = FLAGS_model_path.c_str();
+  Result<FileDataLoader> loader = FileDataLoader::from(model_path);
+  ET_CHECK_MSG(
+      loader.ok(),
+      "FileDataLoader::from() failed: 0x%" PRIx32,
+      (uint32_t)loader.error());
+  Result<Program> program = Program::load(&loader.get());
+  if (!program.ok()) {
+    ET_LOG(Error, "Failed to parse model file %s", model_path);
+    return 1;
+  }
+  const auto method_name_result = program->get_method_name(0);
+  ET_CHECK_MSG(method_name_result.ok(), "Program has no methods");
+  const char* method_name = *method_name_result;
+
+  std::vector<std::unique_ptr<Replica>> replicas;
+  replicas.push_back(std::make_unique<Replica>(*program, method_name));
+  const size_t num_stages = replicas[0]->method().experimental_num_stages();
+  const size_t num_replicas = FLAGS_num_replicas > 0
+      ? static_cast<size_t>(FLAGS_num_replicas)
+      : std::max<size_t>(num_stages, 1);
+  while (replicas.size() < num_replicas) {
+    replicas.push_back(std::make_unique<Replica>(*program, method_name));
+  }
+  const size_t num_frames = static_cast<size_t>(FLAGS_num_frames);
+  printf(
+      "%s: method %s, %zu stages, %zu replicas, %zu frames\n",
+      model_path,
+      method_name,
+      num_stages,
+      num_replicas,
+      num_frames);
+
+  // Warm up every replica, which also checks that the model runs at all.
+  for (auto& replica : replicas) {
+    Error status = replica->method().execute();
+    ET_CHECK_MSG(
+        status == Error::Ok,
+        "Execution of method %s failed with status 0x%" PRIx32,
+        method_name,
+        (uint32_t)status);
+  }
+
+  // Baseline: one frame at a time.
+  {
+    Method& method = replicas[0]->method();
+    int64_t max_latency_us = 0;
+    const auto start = std::chrono::steady_clock::now();
+    for (size_t i = 0; i < num_frames; ++i) {
+      const auto frame_start = std::chrono::steady_clock::now();
+      Error status = method.execute();
+      ET_CHECK(status == Error::Ok);
+      max_latency_us = std::max<int64_t>(
+          max_latency_us,
+          std::chrono::duration_cast<std::chrono::microseconds>(
+              std::chrono::steady_clock::now() - frame_start)
+              .count());
+    }
+    const int64_t wall_us =
+        std::chrono::duration_cast<std::chrono::microseconds>(
+            std::chrono::steady_clock::now() - start)
+            .count();
+    printf(
+        "sequential: %.2f frames/s, latency mean %" PRId64 "us max %" PRId64
+        "us\n",
+        per_second(num_frames, wall_us),
+        wall_us / static_cast<int64_t>(num_frames),
+        max_latency_us);
+  }
+
+  // Pipelined: frames flow through the stages concurrently.
+  {
+    std::vector<Method*> methods;
+    for (auto& replica : replicas) {
+      methods.push_back(&replica->method());
+    }
+    util::MethodPipeline pipeline({methods.data(), methods.size()});
+    size_t num_failed = 0;
+    for (size_t i = 0; i < num_frames; ++i) {
+      // The inputs of every replica were set up front and are reused.
+      Error status = pipeline.submit(
+          [](Method&) { return Error::Ok; },
+          [&](Error status, Method&) { num_failed += status != Error::Ok; });
+      ET_CHECK(status == Error::Ok);
+    }
+    pipeline.flush();
+    ET_CHECK_MSG(num_failed == 0, "%zu frames failed", num_failed);
+
+    util::MethodPipelineStats stats = pipeline.stats();
+    printf(
+        "pipelined: %.2f frames/s, latency mean %" PRId64 "us max %" PRId64
+        "us\n",
+        per_second(stats.num_frames, stats.wall_us),
+        stats.total_latency_us / static_cast<int64_t>(stats.num_frames),
+        stats.max_latency_us);
+    for (size_t i = 0; i < stats.stage_busy_us.size(); ++i) {
+      printf(
+          "  stage %zu: busy %.1f%%\n",
+          i,
+          stats.wall_us == 0 ? 0.0
+                             : 100.0 * stats.stage_busy_us[i] / stats.wall_us);
+    }
+  }
+
+  return 0;
+}
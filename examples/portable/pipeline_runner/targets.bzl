@@ -0,0 +1,42 @@
+load("@fbsource//xplat/executorch/build:runtime_wrapper.bzl", "get_oss_build_kwargs", "runtime")
+
+def define_common_targets():
+    """Defines targets that should be shared between fbcode and xplat.
+
+    The directory containing this targets.bzl file should also contain both
+    TARGETS and BUCK files that call this function.
+    """
+
+    # Wraps a commandline executable that compares sequential and pipelined
+    # execution of a model. Contains a main() function; link it against the
+    # desired kernel and backend implementations.
+    runtime.cxx_library(
+        name = "pipeline_runner_lib",
+        srcs = ["pipeline_runner.cpp"],
+        deps = [
+            "//executorch/runtime/executor:program",
+            "//executorch/extension/data_loader:file_data_loader",
+            "//executorch/extension/memory_allocator:malloc_memory_allocator",
+            "//executorch/extension/pipeline:method_pipeline",
+            "//executorch/util:util",
+        ],
+        external_deps = [
+            "gflags",
+        ],
+        define_static_target = True,
+        visibility = [
+            "//executorch/examples/...",
+        ],
+    )
+
+    runtime.cxx_binary(
+        name = "pipeline_runner",
+        srcs = [],
+        deps = [
+            ":pipeline_runner_lib",
+            "//executorch/runtime/executor/test:test_backend_compiler_lib",
+            "//executorch/kernels/portable:generated_lib_all_ops",
+        ],
+        define_static_target = True,
+        **get_oss_build_kwargs()
+    )
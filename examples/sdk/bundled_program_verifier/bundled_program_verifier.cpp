@@ -0,0 +1,116 @@
+/*
+ * Copyright (c) Meta Platforms, Inc. and affiliates.
+ * All rights reserved.
+ *
+ * This source code is licensed under the BSD-style license found in the
+ * LICENSE file in the root directory of this source tree.
+ */
+
+/**
+ * @file
+ *
+ * Runs every bundled test set of every bundled program given on the command
+ * line and compares the outputs with the bundled expected outputs. Test sets
+ * of each file run in parallel on a pool of Methods.
+ *
+ * Prints one line per test set with its timing and error summary, then a
+ * total. Exits with 1 if any file could not be loaded or any test set failed.
+ *
+ *   bundled_program_verifier --num_threads=8 a.bpte b.bpte ...
+ */
+
+#include <algorithm>
+#include <cinttypes>
+#include <cstdio>
+#include <string>
+#include <vector>
+
+#include <gflags/gflags.h>
+
+#include <executorch/runtime/platform/log.h>
+#include <executorch/runtime/platform/runtime.h>
+#include <executorch/util/bundled_program_batch_verification.h>
+
+DEFINE_int32(
+    num_threads,
+    0,
+    "Number of worker threads per file. 0 uses one per hardware thread.");
+
+DEFINE_double(
+    rtol,
+    torch::executor::util::kDefaultRtol,
+    "Relative tolerance used for data comparison.");
+
+DEFINE_double(
+    atol,
+    torch::executor::util::kDefaultAtol,
+    "Absolute tolerance used for data comparison.");
+
+DEFINE_bool(
+    print_passing,
+    true,
+    "Print a line for every test set, not only for the failing ones.");
+
+using namespace torch::executor;
+
+int main(int argc, char** argv) {
+  runtime_init();
+
+  gflags::ParseCommandLineFlags(&argc, &argv, true);
+  if (argc < 2) {
+    ET_LOG(Error, "Usage: %s [flags] <bundled program>...", argv[0]);
+    return 1;
+  }
+
+  util::BundledBatchVerificationConfig config;
+  config.num_threads = static_cast<size_t>(std::max(FLAGS_num_threads, 0));
+  config.rtol = FLAGS_rtol;
+  config.atol = FLAGS_atol;
+
+  size_t num_passed = 0;
+  size_t num_failed = 0;
+  size_t num_bad_files = 0;
+  std::vector<util::BundledTestSetReport> reports;
+  for (int i = 1; i < argc; i++) {
+    const char* path = argv[i];
+    Error status = util::VerifyBundledProgramFile(path, config, &reports);
+    if (status != Error::Ok) {
+      printf(
+          "%s: FAILED to load (0x%" PRIx32 ")\n", path, (uint32_t)status);
+      num_bad_files++;
+      continue;
+    }
+    for (const util::BundledTestSetReport& report : reports) {
+      const bool passed = report.status == Error::Ok;
+      passed ? num_passed++ : num_failed++;
+      if (passed && !FLAGS_print_passing) {
+        continue;
+      }
+      printf(
+          "%s %s[%zu]: %s (0x%" PRIx32
+          ") load_input %" PRId64 "us execute %" PRId64 "us verify %" PRId64
+          "us max_abs_error %g max_rel_error %g",
+          path,
+          report.method_name.c_str(),
+          report.testset_idx,
+          passed ? "OK" : "FAILED",
+          (uint32_t)report.status,
+          report.load_input_us,
+          report.execute_us,
+          report.verify_us,
+          report.stats.max_abs_error,
+          report.stats.max_rel_error);
+      if (report.stats.mismatched_output >= 0) {
+        printf(" mismatched_output %" PRId64, report.stats.mismatched_output);
+      }
+      printf("\n");
+    }
+  }
+
+  printf(
+      "%zu test sets passed, %zu failed, %zu files failed to load\n",
+      num_passed,
+      num_failed,
+      num_bad_files);
+  return num_failed == 0 && num_bad_files == 0 ? 0 : 1;
+}
@@ -0,0 +1,26 @@
+load("@fbsource//xplat/executorch/build:runtime_wrapper.bzl", "get_oss_build_kwargs", "runtime")
+
+def define_common_targets():
+    """Defines targets that should be shared between fbcode and xplat.
+
+    The directory containing this targets.bzl file should also contain both
+    TARGETS and BUCK files that call this function.
+    """
+
+    # Batch verifier for bundled programs.
+    runtime.cxx_binary(
+        name = "bundled_program_verifier",
+        srcs = [
+            "bundled_program_verifier.cpp",
+        ],
+        deps = [
+            "//executorch/kernels/portable:generated_lib_all_ops",
+            "//executorch/runtime/platform:platform",
+            "//executorch/util:bundled_program_batch_verification",
+        ],
+        external_deps = [
+            "gflags",
+        ],
+        define_static_target = True,
+        **get_oss_build_kwargs()
+    )
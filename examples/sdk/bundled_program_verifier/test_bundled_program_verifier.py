@@ -0,0 +1,65 @@
+# Copyright (c) Meta Platforms, Inc. and affiliates.
+# All rights reserved.
+#
+# This source code is licensed under the BSD-style license found in the
+# LICENSE file in the root directory of this source tree.
+
+import os
+import subprocess
+import unittest
+from typing import List
+
+
+def run_verifier(args: List[str]) -> subprocess.CompletedProcess:
+    return subprocess.run(
+        [os.environ["ET_BUNDLED_PROGRAM_VERIFIER"]] + args,
+        stdout=subprocess.PIPE,
+        stderr=subprocess.PIPE,
+        text=True,
+    )
+
+
+class TestBundledProgramVerifier(unittest.TestCase):
+    def setUp(self) -> None:
+        self.linear = os.environ["ET_LINEAR_BUNDLED_PATH"]
+        self.linear_mismatch = os.environ["ET_LINEAR_BUNDLED_MISMATCH_PATH"]
+
+    def test_matching_outputs_pass(self) -> None:
+        result = run_verifier([self.linear])
+        self.assertEqual(result.returncode, 0, result.stdout)
+        self.assertIn("4 test sets passed, 0 failed", result.stdout)
+
+    def test_mismatched_output_fails_with_default_tolerances(self) -> None:
+        # The mismatch is a relative error of 1e-4, which the API's default
+        # rtol of 1e-5 rejects. The CLI must use the same default.
+        result = run_verifier([self.linear_mismatch])
+        self.assertEqual(result.returncode, 1, result.stdout)
+        self.assertIn("forward[3]: FAILED", result.stdout)
+        self.assertIn("mismatched_output 0", result.stdout)
+        self.assertIn("3 test sets passed, 1 failed", result.stdout)
+
+    def test_looser_rtol_accepts_mismatch(self) -> None:
+        result = run_verifier(["--rtol", "1e-3", self.linear_mismatch])
+        self.assertEqual(result.returncode, 0, result.stdout)
+        self.assertIn("4 test sets passed, 0 failed", result.stdout)
+
+    def test_print_only_failures(self) -> None:
+        result = run_verifier(
+            [
+                "--noprint_passing",
+                "--num_threads",
+                "2",
+                self.linear,
+                self.linear_mismatch,
+            ]
+        )
+        self.assertEqual(result.returncode, 1, result.stdout)
+        self.assertNotIn(": OK", result.stdout)
+        self.assertEqual(result.stdout.count(": FAILED"), 1)
+        self.assertIn("7 test sets passed, 1 failed", result.stdout)
+
+    def test_missing_file_fails(self) -> None:
+        result = run_verifier([self.linear, "/does/not/exist.bpte"])
+        self.assertEqual(result.returncode, 1, result.stdout)
+        self.assertIn("/does/not/exist.bpte: FAILED to load", result.stdout)
+        self.assertIn("files failed to load", result.stdout)
@@ -54,3 +54,15 @@ def define_common_targets():
         define_static_target = True,
         **get_oss_build_kwargs()
     )
+
+    # Compares sequential and pipelined execution of XNNPACK delegated models.
+    runtime.cxx_binary(
+        name = "xnn_pipeline_runner",
+        deps = [
+            "//executorch/examples/portable/pipeline_runner:pipeline_runner_lib",
+            "//executorch/backends/xnnpack:xnnpack_backend",
+            "//executorch/kernels/portable:generated_lib_all_ops",
+        ],
+        define_static_target = True,
+        **get_oss_build_kwargs()
+    )
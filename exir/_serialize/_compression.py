@@ -0,0 +1,47 @@
+# Copyright (c) Meta Platforms, Inc. and affiliates.
+# All rights reserved.
+#
+# This source code is licensed under the BSD-style license found in the
+# LICENSE file in the root directory of this source tree.
+
+# pyre-strict
+
+"""Compression for program segments.
+
+A compressed segment is a single raw LZ4 block (see
+https://github.com/lz4/lz4/blob/dev/doc/lz4_Block_format.md) with no header:
+the compression method and the uncompressed size are recorded in the
+segment's DataSegment entry in the Program.
+
+The runtime side is extension/data_loader/compressed_data_loader.h.
+"""
+
+from typing import Optional
+
+
+def lz4_compress_block(data: bytes) -> Optional[bytes]:
+    """Returns `data` compressed as a single raw LZ4 block, or None if that
+    would not make it smaller."""
+    if not data:
+        return None
+    # Imported here so that only programs that use compression need lz4.
+    import lz4.block
+
+    block = lz4.block.compress(data, store_size=False)
+    return block if len(block) < len(data) else None
+
+
+def lz4_decompress_block(data: bytes, uncompressed_size: int) -> bytes:
+    """Returns the decompressed contents of a raw LZ4 block, which must be
+    exactly `uncompressed_size` bytes long."""
+    import lz4.block
+
+    try:
+        out = lz4.block.decompress(data, uncompressed_size=uncompressed_size)
+    except lz4.block.LZ4BlockError as e:
+        raise ValueError(f"Invalid LZ4 block: {e}") from e
+    if len(out) != uncompressed_size:
+        raise ValueError(
+            f"Decompressed size {len(out)} != expected size {uncompressed_size}"
+        )
+    return out
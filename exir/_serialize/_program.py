@@ -11,8 +11,12 @@ import json
 import re
 
 from dataclasses import dataclass
-from typing import ClassVar, List, Literal, Optional, Tuple
+from typing import ClassVar, Dict, List, Literal, Optional, Tuple
 
+from executorch.exir._serialize._compression import (
+    lz4_compress_block,
+    lz4_decompress_block,
+)
 from executorch.exir._serialize._dataclass import _DataclassEncoder, _json_to_dataclass
 from executorch.exir._serialize._flatbuffer import (
     _FlatbufferResult,
@@ -23,9 +27,12 @@ from executorch.exir._serialize._flatbuffer import (
 from executorch.exir.schema import (
     BackendDelegateDataReference,
     BackendDelegateInlineData,
+    Buffer,
     DataLocation,
     DataSegment,
     Program,
+    SegmentCompression,
+    Tensor,
 )
 
 
@@ -237,8 +244,61 @@ def _get_extended_header(program_data: bytes) -> Optional[_ExtendedHeader]:
     return None
 
 
+def _deduplicate_data(program: Program) -> Program:
+    """Merges constant buffers and inline delegate data with identical contents.
+
+    Tied weights and delegates that share a payload are otherwise stored once
+    per reference. Entries are compared by content, and every tensor and
+    delegate that pointed at a duplicate is redirected to the first copy.
+
+    Args:
+        program: The program to deduplicate.
+    Returns:
+        A deduplicated copy of `program`.
+    """
+    program = copy.deepcopy(program)
+
+    # Index 0 of constant_buffer is reserved for non-constant tensors; keep it
+    # in place even if another buffer is also empty.
+    constant_buffer: List[Buffer] = program.constant_buffer[:1]
+    buffer_index_by_data: Dict[bytes, int] = {}
+    buffer_remap: Dict[int, int] = {0: 0}
+    for i, buffer in enumerate(program.constant_buffer[1:], start=1):
+        new_index = buffer_index_by_data.get(buffer.storage)
+        if new_index is None:
+            new_index = len(constant_buffer)
+            buffer_index_by_data[buffer.storage] = new_index
+            constant_buffer.append(buffer)
+        buffer_remap[i] = new_index
+    program.constant_buffer = constant_buffer
+
+    inline_data: List[BackendDelegateInlineData] = []
+    inline_index_by_data: Dict[bytes, int] = {}
+    inline_remap: Dict[int, int] = {}
+    for i, inline in enumerate(program.backend_delegate_data):
+        new_index = inline_index_by_data.get(inline.data)
+        if new_index is None:
+            new_index = len(inline_data)
+            inline_index_by_data[inline.data] = new_index
+            inline_data.append(inline)
+        inline_remap[i] = new_index
+    program.backend_delegate_data = inline_data
+
+    for plan in program.execution_plan:
+        for value in plan.values:
+            if isinstance(value.val, Tensor):
+                value.val.constant_buffer_idx = buffer_remap[
+                    value.val.constant_buffer_idx
+                ]
+        for delegate in plan.delegates:
+            if delegate.processed.location == DataLocation.INLINE:
+                delegate.processed.index = inline_remap[delegate.processed.index]
+
+    return program
+
+
 def _extract_segments(
-    program: Program, segment_alignment: int
+    program: Program, segment_alignment: int, compress: bool = False
 ) -> Tuple[Program, List[bytes]]:
     """Moves data from the Program into a list of segments.
 
@@ -249,6 +309,8 @@ def _extract_segments(
         program: The program to extract segments from.
         segment_alignment: Alignment in bytes. The starting offset of each
             segment will be aligned to this value.
+        compress: Whether to LZ4-compress segments when that makes them
+            smaller. Compressed segments are marked in their DataSegment.
     Returns:
         A tuple of (modified program, list of segment data).
     """
@@ -266,6 +328,8 @@ def _extract_segments(
     segments: List[bytes] = []
     remaining_inline: List[BackendDelegateInlineData] = []
     inline_indices_seen: set[int] = set()
+    # Delegates that share an inline entry share its segment, too.
+    moved: Dict[int, BackendDelegateDataReference] = {}
     for plan in program.execution_plan:
         for delegate in plan.delegates:
             if delegate.processed.location != DataLocation.INLINE:
@@ -288,11 +352,20 @@ def _extract_segments(
                     + f"{len(program.backend_delegate_data)} "
                     + f"in {repr(delegate)}"
                 )
+            if delegate.processed.index in moved:
+                delegate.processed = copy.copy(moved[delegate.processed.index])
+                continue
             inline_indices_seen.add(delegate.processed.index)
+            original_index = delegate.processed.index
             if inline.data:
                 # Move the delegate data out of the program.
                 segment_index = len(segments)
-                segments.append(inline.data)
+                data = inline.data
+                compression = SegmentCompression.NONE
+                if compress and (block := lz4_compress_block(inline.data)):
+                    data = block
+                    compression = SegmentCompression.LZ4_BLOCK
+                segments.append(data)
                 delegate.processed = BackendDelegateDataReference(
                     location=DataLocation.SEGMENT,
                     index=segment_index,
@@ -307,7 +380,13 @@ def _extract_segments(
                 program.segments.append(
                     DataSegment(
                         offset=_aligned_size(prev_end, segment_alignment),
-                        size=len(inline.data),
+                        size=len(data),
+                        compression=compression,
+                        uncompressed_size=(
+                            len(inline.data)
+                            if compression != SegmentCompression.NONE
+                            else 0
+                        ),
                     ),
                 )
             else:
@@ -316,6 +395,7 @@ def _extract_segments(
                 new_index = len(remaining_inline)
                 remaining_inline.append(inline)
                 delegate.processed.index = new_index
+            moved[original_index] = copy.copy(delegate.processed)
 
     # Make sure we visited all entries in backend_delegate_data, so that it's
     # safe to overwrite it.
@@ -424,6 +504,8 @@ def serialize_pte_binary(
     segment_alignment: int = 4096,
     constant_tensor_alignment: Optional[int] = None,
     delegate_alignment: Optional[int] = None,
+    deduplicate_data: bool = False,
+    compress_segments: bool = False,
 ) -> bytes:
     """Returns the runtime binary representation of the given Program.
 
@@ -444,15 +526,29 @@ def serialize_pte_binary(
         delegate_alignment: If provided, the minimum alignment of delegate data
             in the program. Must be a power of 2. If not provided, uses the
             value in the schema file.
+        deduplicate_data: Whether to store constant buffers and delegate data
+            with identical contents only once.
+        compress_segments: Whether to LZ4-compress extracted segments. Requires
+            `extract_segments`. The runtime must load the program through a
+            `CompressedDataLoader` (extension/data_loader).
     Returns:
         The serialized form of the Program, ready for execution by the runtime.
     """
+    if compress_segments and not extract_segments:
+        raise ValueError("compress_segments requires extract_segments")
+
+    if deduplicate_data:
+        # Returns a copy of the program to avoid modifying the input.
+        program = _deduplicate_data(program)
+
     # Segment data to be written to the file following the flatbuffer data.
     segments: List[bytes] = []
     if extract_segments:
         # May return a copy of the program to avoid modifying the input.
         program, segments = _extract_segments(
-            program=program, segment_alignment=segment_alignment
+            program=program,
+            segment_alignment=segment_alignment,
+            compress=compress_segments,
         )
 
     # Convert to a standard flatbuffer binary.
@@ -540,7 +636,14 @@ def _restore_segments(program: Program, segment_data: bytes) -> Program:
             raise ValueError(
                 f"Segment {i} {segment} overflows data length {len(segment_data)}"
             )
-        segments.append(segment_data[segment.offset : segment.offset + segment.size])
+        data = segment_data[segment.offset : segment.offset + segment.size]
+        if segment.compression == SegmentCompression.LZ4_BLOCK:
+            data = lz4_decompress_block(data, segment.uncompressed_size)
+        elif segment.compression != SegmentCompression.NONE:
+            raise ValueError(
+                f"Segment {i} has unknown compression {segment.compression}"
+            )
+        segments.append(data)
 
     # Find and replace the Program's references to these segments, inlining the
     # data.
@@ -12,6 +12,7 @@ import unittest
 
 from typing import List, Sequence
 
+from executorch.exir._serialize._compression import lz4_compress_block
 from executorch.exir._serialize._flatbuffer import _program_flatbuffer_to_json
 from executorch.exir._serialize._program import (
     _ExtendedHeader,
@@ -26,11 +27,13 @@ from executorch.exir.schema import (
     BackendDelegate,
     BackendDelegateDataReference,
     BackendDelegateInlineData,
+    Buffer,
     ContainerMetadata,
     DataLocation,
     DataSegment,
     ExecutionPlan,
     Program,
+    SegmentCompression,
 )
 from executorch.exir.tests.common import get_test_program
 
@@ -456,6 +459,95 @@ class TestProgram(unittest.TestCase):
                 program, extract_segments=True, segment_alignment=SEGMENT_ALIGNMENT
             )
 
+    def test_deduplicate_constant_buffers(self) -> None:
+        program = get_test_program()
+        plan = program.execution_plan[0]
+        weight = b"\x01\x02\x03\x04" * 4
+        program.constant_buffer += [
+            Buffer(storage=weight),
+            Buffer(storage=b"\x05" * 16),
+            Buffer(storage=weight),
+        ]
+        tensor_value = plan.values[4]
+        for buffer_idx in (1, 2, 3):
+            value = copy.deepcopy(tensor_value)
+            value.val.constant_buffer_idx = buffer_idx
+            value.val.allocation_info = None
+            plan.values.append(value)
+
+        pte_data = serialize_pte_binary(program, deduplicate_data=True)
+
+        # The input Program should not have been modified.
+        self.assertEqual(len(program.constant_buffer), 4)
+
+        program2 = deserialize_pte_binary(pte_data)
+        self.assertEqual(len(program2.constant_buffer), 3)
+        self.assertEqual(program2.constant_buffer[1].storage, weight)
+        self.assertEqual(
+            [v.val.constant_buffer_idx for v in program2.execution_plan[0].values[5:]],
+            [1, 2, 1],
+        )
+
+    def test_round_trip_with_deduplicated_compressed_segments(self) -> None:
+        program = get_test_program()
+        shared = self.gen_blob_data(SEGMENT_ALIGNMENT * 2, b"\x10\x11\x01")
+        blobs = (
+            shared,
+            self.gen_blob_data(SEGMENT_ALIGNMENT, b"\x20\x22\x02"),
+            shared,
+            # Too small to be worth compressing.
+            b"\x30\x31\x32",
+        )
+        add_delegate_data(program, program.execution_plan[0], blobs)
+
+        pte_data = serialize_pte_binary(
+            program,
+            extract_segments=True,
+            segment_alignment=SEGMENT_ALIGNMENT,
+            deduplicate_data=True,
+            compress_segments=True,
+        )
+
+        program_with_segments = _json_to_program(_program_flatbuffer_to_json(pte_data))
+        # The shared blob is stored once.
+        self.assertEqual(len(program_with_segments.segments), 3)
+        delegates = program_with_segments.execution_plan[0].delegates
+        self.assertEqual(delegates[0].processed, delegates[2].processed)
+        # Compressible blobs shrink and are marked as compressed; the tiny one
+        # is stored verbatim.
+        segments = program_with_segments.segments
+        for segment, blob in zip(segments[:2], blobs[:2]):
+            self.assertEqual(segment.compression, SegmentCompression.LZ4_BLOCK)
+            self.assertEqual(segment.uncompressed_size, len(blob))
+            self.assertLess(segment.size, len(blob))
+        self.assertEqual(segments[2].compression, SegmentCompression.NONE)
+        self.assertEqual(segments[2].size, len(blobs[3]))
+
+        # Decompression restores the original blobs.
+        program2 = deserialize_pte_binary(pte_data)
+        self.assert_programs_equal(program, program2)
+
+    def test_segment_that_looks_compressed_is_not_decompressed(self) -> None:
+        # Compression is only decided by the DataSegment entry, never by the
+        # segment contents.
+        program = get_test_program()
+        blob = lz4_compress_block(
+            self.gen_blob_data(SEGMENT_ALIGNMENT, b"\x40\x44\x04")
+        )
+        assert blob is not None
+        add_delegate_data(program, program.execution_plan[0], (blob,))
+
+        pte_data = serialize_pte_binary(
+            program, extract_segments=True, segment_alignment=SEGMENT_ALIGNMENT
+        )
+
+        program2 = deserialize_pte_binary(pte_data)
+        self.assert_programs_equal(program, program2)
+
+    def test_compress_segments_requires_extract_segments(self) -> None:
+        with self.assertRaises(ValueError):
+            serialize_pte_binary(get_test_program(), compress_segments=True)
+
 
 # Common data for extended header tests. The two example values should produce
 # the example data.
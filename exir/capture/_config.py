@@ -64,4 +64,13 @@ class ExecutorchBackendConfig:
     # If provided, the minimum alignment of delegate data in the program. Must
     # be a power of 2. If not provided, uses the value in the schema file.
     delegate_alignment: Optional[int] = None
+
+    # Whether to store constant buffers and delegate data with identical
+    # contents (e.g. tied weights) only once.
+    deduplicate_data: bool = False
+
+    # Whether to LZ4-compress extracted segments when that makes them smaller.
+    # Requires extract_segments. The runtime must load such programs through
+    # extension/data_loader's CompressedDataLoader.
+    compress_segments: bool = False
     sym_shape_eval_pass: PassType = HintBasedSymShapeEvalPass()
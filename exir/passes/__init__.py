@@ -36,6 +36,8 @@ from executorch.exir.passes.const_prop_pass import ConstPropPass
 from executorch.exir.passes.debug_handle_generator_pass import DebugHandleGeneratorPass
 
 from executorch.exir.passes.executorch_prim_ops_registry import _EXECUTORCH_SYM_OPS
+from executorch.exir.passes.fuse_batch_norm_pass import FuseBatchNormPass
+from executorch.exir.passes.fuse_conv_clamp_pass import FuseConvClampPass
 from executorch.exir.passes.memory_format_ops_pass import MemoryFormatOpsPass
 from executorch.exir.passes.memory_planning_pass import MemoryPlanningPass
 from executorch.exir.passes.normalize_transpose_pass import NormalizeTransposePass
@@ -67,6 +69,8 @@ __all__ = [
     "OpReplacePass",
     "EdgeToBackendOpsPass",
     "MemoryFormatOpsPass",
+    "FuseBatchNormPass",
+    "FuseConvClampPass",
     "HintBasedSymShapeEvalPass",
 ]
 
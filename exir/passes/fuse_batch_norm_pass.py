@@ -0,0 +1,396 @@
+# Copyright (c) Meta Platforms, Inc. and affiliates.
+# All rights reserved.
+#
+# This source code is licensed under the BSD-style license found in the
+# LICENSE file in the root directory of this source tree.
+
+import operator
+from typing import Optional, Set, Tuple
+
+import torch
+from executorch.exir.dialects._ops import ops as exir_ops
+from executorch.exir.pass_base import ExportPass, PassResult
+from torch.export import ExportedProgram
+from torch.export.exported_program import InputKind, InputSpec, TensorArgument
+
+
+_BATCH_NORM_OPS = (
+    exir_ops.edge.aten.native_batch_norm.default,
+    exir_ops.edge.aten._native_batch_norm_legit_no_training.default,
+)
+
+_TRANSPOSE_OPS = (
+    exir_ops.edge.aten.permute_copy.default,
+    exir_ops.edge.aten.t_copy.default,
+)
+
+
+class FuseBatchNormPass(ExportPass):
+    """
+    Folds an eval-mode batch norm into the constant weight and bias of the
+    convolution or linear that feeds it.
+
+    In eval mode batch norm is a per-channel affine transform,
+    (x - running_mean) * weight / sqrt(running_var + eps) + bias, which can be
+    baked into the producer's weight and bias. Without this the batch norm
+    kernel re-reads the whole activation after every convolution.
+
+    A linear reaches the edge dialect as addmm or mm whose second operand is
+    the transposed weight; both forms are folded. The producer's weight,
+    running statistics and (when present) batch norm weight and bias must be
+    constants, i.e. get_attr nodes or, given the exported program, lifted
+    parameters and buffers. Folded get_attr constants are registered on the
+    graph module as new attributes. Folded lifted constants are written back to
+    the exported program's state_dict when nothing else reads them, and are
+    otherwise added as new lifted parameters, so the graph signature keeps
+    describing every placeholder.
+    """
+
+    def __init__(self, exported_program: Optional[ExportedProgram] = None) -> None:
+        super().__init__()
+        self.exported_program = exported_program
+
+    def _get_lifted_name(self, node) -> Optional[str]:
+        """
+        Returns the state_dict key of a lifted parameter or buffer placeholder,
+        or None.
+        """
+        if (
+            not isinstance(node, torch.fx.Node)
+            or node.op != "placeholder"
+            or self.exported_program is None
+        ):
+            return None
+        signature = self.exported_program.graph_signature
+        return signature.inputs_to_parameters.get(
+            node.name
+        ) or signature.inputs_to_buffers.get(node.name)
+
+    def _get_constant(
+        self, graph_module: torch.fx.GraphModule, node
+    ) -> Optional[torch.Tensor]:
+        if not isinstance(node, torch.fx.Node):
+            return None
+        if node.op == "get_attr":
+            attr = graph_module
+            for atom in node.target.split("."):
+                attr = getattr(attr, atom)
+            return attr
+        name = self._get_lifted_name(node)
+        if name is not None:
+            return self.exported_program.state_dict[name]
+        return None
+
+    def _get_batch_norm_params(
+        self, graph_module: torch.fx.GraphModule, bn: torch.fx.Node
+    ) -> Optional[Tuple[torch.Tensor, torch.Tensor]]:
+        """
+        Returns the per-channel (scale, shift) of an eval-mode batch norm whose
+        parameters are all constants, or None.
+        """
+        if bn.target == exir_ops.edge.aten.native_batch_norm.default:
+            # native_batch_norm(input, weight, bias, running_mean, running_var,
+            # training, momentum, eps)
+            if bn.args[5]:
+                return None
+        weight_node, bias_node, mean_node, var_node = bn.args[1:5]
+        eps = bn.args[-1]
+
+        mean = self._get_constant(graph_module, mean_node)
+        var = self._get_constant(graph_module, var_node)
+        if mean is None or var is None:
+            return None
+        weight = self._get_constant(graph_module, weight_node)
+        bias = self._get_constant(graph_module, bias_node)
+        if (weight_node is not None and weight is None) or (
+            bias_node is not None and bias is None
+        ):
+            return None
+
+        scale = torch.rsqrt(var + eps)
+        if weight is not None:
+            scale = scale * weight
+        shift = -mean * scale
+        if bias is not None:
+            shift = shift + bias
+        return scale, shift
+
+    def _register_constant(
+        self, graph_module: torch.fx.GraphModule, prefix: str, tensor: torch.Tensor
+    ) -> str:
+        index = 0
+        while hasattr(graph_module, f"{prefix}_{index}"):
+            index += 1
+        name = f"{prefix}_{index}"
+        graph_module.register_parameter(
+            name, torch.nn.Parameter(tensor.detach(), requires_grad=False)
+        )
+        return name
+
+    def _add_lifted_parameter(
+        self, graph_module: torch.fx.GraphModule, prefix: str, tensor: torch.Tensor
+    ) -> torch.fx.Node:
+        assert self.exported_program is not None
+        state_dict = self.exported_program.state_dict
+        signature = self.exported_program.graph_signature
+        index = 0
+        while f"{prefix}_{index}" in state_dict:
+            index += 1
+        name = f"{prefix}_{index}"
+        state_dict[name] = torch.nn.Parameter(tensor.detach(), requires_grad=False)
+
+        # Lifted parameters are the first inputs, in the order of the
+        # signature's input specs.
+        position = len(
+            [spec for spec in signature.input_specs if spec.kind == InputKind.PARAMETER]
+        )
+        graph = graph_module.graph
+        placeholders = [node for node in graph.nodes if node.op == "placeholder"]
+        if position < len(placeholders):
+            insertion_point = graph.inserting_before(placeholders[position])
+        else:
+            insertion_point = graph.inserting_after(placeholders[-1])
+        with insertion_point:
+            node = graph.placeholder(name)
+        node.meta["val"] = tensor
+        signature.input_specs.insert(
+            position,
+            InputSpec(
+                kind=InputKind.PARAMETER,
+                arg=TensorArgument(name=node.name),
+                target=name,
+            ),
+        )
+        return node
+
+    def _replace_constant(
+        self,
+        graph_module: torch.fx.GraphModule,
+        before: torch.fx.Node,
+        old: Optional[torch.fx.Node],
+        exclusive: bool,
+        lifted: bool,
+        prefix: str,
+        tensor: torch.Tensor,
+    ) -> torch.fx.Node:
+        """
+        Returns a node that reads `tensor`, to use in place of `old`. `lifted`
+        says whether the graph's constants are lifted placeholders, and
+        `exclusive` whether the folded op is the only reader of `old`, in
+        which case a lifted `old` is updated in place.
+        """
+        if not lifted:
+            with graph_module.graph.inserting_before(before):
+                return graph_module.graph.get_attr(
+                    self._register_constant(graph_module, prefix, tensor)
+                )
+        name = self._get_lifted_name(old)
+        if name is not None and exclusive:
+            self.exported_program.state_dict[name] = torch.nn.Parameter(
+                tensor.detach(), requires_grad=False
+            )
+            old.meta["val"] = tensor
+            return old
+        return self._add_lifted_parameter(graph_module, prefix, tensor)
+
+    def _fold_into_convolution(
+        self,
+        graph_module: torch.fx.GraphModule,
+        conv: torch.fx.Node,
+        scale: torch.Tensor,
+        shift: torch.Tensor,
+    ) -> bool:
+        # convolution(input, weight, bias, stride, padding, dilation,
+        # transposed, output_padding, groups)
+        weight = self._get_constant(graph_module, conv.args[1])
+        bias = self._get_constant(graph_module, conv.args[2])
+        if weight is None or (conv.args[2] is not None and bias is None):
+            return False
+
+        transposed, groups = conv.args[6], conv.args[8]
+        if transposed:
+            # The weight is {in_channels, out_channels / groups, ...}, so each
+            # group's output channels sit in dim 1.
+            grouped = weight.reshape(groups, -1, *weight.shape[1:])
+            channel_scale = scale.reshape(
+                groups, 1, -1, *([1] * (weight.dim() - 2))
+            )
+            fused_weight = (grouped * channel_scale).reshape(weight.shape)
+        else:
+            channel_scale = scale.reshape(-1, *([1] * (weight.dim() - 1)))
+            fused_weight = weight * channel_scale
+        fused_bias = shift if bias is None else bias * scale + shift
+
+        lifted = conv.args[1].op == "placeholder"
+        weight_node = self._replace_constant(
+            graph_module,
+            conv,
+            conv.args[1],
+            len(conv.args[1].users) == 1,
+            lifted,
+            "_bn_folded_weight",
+            fused_weight.to(weight.dtype),
+        )
+        bias_node = self._replace_constant(
+            graph_module,
+            conv,
+            conv.args[2],
+            conv.args[2] is not None and len(conv.args[2].users) == 1,
+            lifted,
+            "_bn_folded_bias",
+            fused_bias.to(weight.dtype),
+        )
+        args = list(conv.args)
+        args[1] = weight_node
+        args[2] = bias_node
+        conv.args = tuple(args)
+        return True
+
+    def _fold_into_linear(
+        self,
+        graph_module: torch.fx.GraphModule,
+        mm: torch.fx.Node,
+        scale: torch.Tensor,
+        shift: torch.Tensor,
+    ) -> bool:
+        # addmm(bias, input, weight.t()) or mm(input, weight.t())
+        is_addmm = mm.target == exir_ops.edge.aten.addmm.default
+        if is_addmm and (
+            mm.kwargs.get("beta", 1) != 1 or mm.kwargs.get("alpha", 1) != 1
+        ):
+            return False
+        transpose = mm.args[2] if is_addmm else mm.args[1]
+        if (
+            not isinstance(transpose, torch.fx.Node)
+            or transpose.target not in _TRANSPOSE_OPS
+        ):
+            return False
+        weight = self._get_constant(graph_module, transpose.args[0])
+        if weight is None or weight.dim() != 2:
+            return False
+        bias = self._get_constant(graph_module, mm.args[0]) if is_addmm else None
+        if is_addmm and (bias is None or bias.dim() != 1):
+            return False
+
+        # The folded weight is stored already transposed, {in, out}.
+        fused_weight = (weight * scale.reshape(-1, 1)).t().contiguous()
+        fused_bias = shift if bias is None else bias * scale + shift
+
+        # The folded weight replaces the transposed one, so the original
+        # weight may only be updated in place if the transpose is its only
+        # reader and the linear is the transpose's only reader.
+        original_weight = transpose.args[0]
+        lifted = original_weight.op == "placeholder"
+        weight_node = self._replace_constant(
+            graph_module,
+            mm,
+            original_weight,
+            len(original_weight.users) == 1 and len(transpose.users) == 1,
+            lifted,
+            "_bn_folded_weight",
+            fused_weight.to(weight.dtype),
+        )
+        bias_node = self._replace_constant(
+            graph_module,
+            mm,
+            mm.args[0] if is_addmm else None,
+            is_addmm and len(mm.args[0].users) == 1,
+            lifted,
+            "_bn_folded_bias",
+            fused_bias.to(weight.dtype),
+        )
+
+        graph = graph_module.graph
+        with graph.inserting_before(mm):
+            addmm = graph.call_function(
+                exir_ops.edge.aten.addmm.default,
+                (bias_node, mm.args[1] if is_addmm else mm.args[0], weight_node),
+            )
+        mm.replace_all_uses_with(addmm)
+        graph.erase_node(mm)
+        return True
+
+    def _remove_unused_lifted_constants(
+        self, graph_module: torch.fx.GraphModule, used: Set[torch.fx.Node]
+    ) -> None:
+        """
+        Removes the lifted parameters and buffers in `used` that folding left
+        without readers from the graph, the graph signature and the
+        state_dict.
+        """
+        signature = self.exported_program.graph_signature
+        state_dict = self.exported_program.state_dict
+        mutated = set(signature.buffers_to_mutate.values())
+        for node in used:
+            name = self._get_lifted_name(node)
+            if name is None or len(node.users) > 0 or name in mutated:
+                continue
+            for spec in list(signature.input_specs):
+                if spec.arg.name == node.name:
+                    signature.input_specs.remove(spec)
+            graph_module.graph.erase_node(node)
+            if all(spec.target != name for spec in signature.input_specs):
+                del state_dict[name]
+
+    def call(self, graph_module: torch.fx.GraphModule) -> PassResult:
+        graph = graph_module.graph
+        modified = False
+        used_constants = {
+            node
+            for node in graph.nodes
+            if node.op == "placeholder"
+            and len(node.users) > 0
+            and self._get_lifted_name(node) is not None
+        }
+        for bn in list(graph.nodes):
+            if bn.op != "call_function" or bn.target not in _BATCH_NORM_OPS:
+                continue
+
+            # Only the normalized output may be used; the saved statistics
+            # no longer exist once the batch norm is folded.
+            if not all(
+                user.target == operator.getitem and user.args[1] == 0
+                for user in bn.users
+            ):
+                continue
+
+            producer = bn.args[0]
+            if not isinstance(producer, torch.fx.Node) or len(producer.users) != 1:
+                continue
+
+            params = self._get_batch_norm_params(graph_module, bn)
+            if params is None:
+                continue
+            scale, shift = params
+
+            if producer.target == exir_ops.edge.aten.convolution.default:
+                folded = self._fold_into_convolution(
+                    graph_module, producer, scale, shift
+                )
+            elif producer.target in (
+                exir_ops.edge.aten.addmm.default,
+                exir_ops.edge.aten.mm.default,
+            ):
+                folded = self._fold_into_linear(graph_module, producer, scale, shift)
+                # The linear node was replaced by a new addmm.
+                producer = bn.args[0]
+            else:
+                folded = False
+            if not folded:
+                continue
+
+            for user in list(bn.users):
+                user.replace_all_uses_with(producer)
+                graph.erase_node(user)
+            graph.erase_node(bn)
+            modified = True
+
+        if not modified:
+            return PassResult(graph_module, False)
+
+        graph.eliminate_dead_code()
+        if self.exported_program is not None:
+            self._remove_unused_lifted_constants(graph_module, used_constants)
+        graph_module.recompile()
+        # Retrace to regenerate the metadata of the rewritten nodes.
+        return PassResult(super().call(graph_module).graph_module, True)
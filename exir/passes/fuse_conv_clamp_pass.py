@@ -0,0 +1,98 @@
+# Copyright (c) Meta Platforms, Inc. and affiliates.
+# All rights reserved.
+#
+# This source code is licensed under the BSD-style license found in the
+# LICENSE file in the root directory of this source tree.
+
+from typing import Any, Optional, Tuple
+
+import torch
+
+# Registers the fused_ops library.
+import executorch.exir.passes.fused_ops_registry  # noqa: F401
+from executorch.exir.dialects._ops import ops as exir_ops
+from executorch.exir.pass_base import ExportPass, PassResult
+
+
+def _normalized_args(node: torch.fx.Node) -> Optional[Tuple[Any, ...]]:
+    """
+    Returns every argument of an op call positionally, taking the ones passed
+    as kwargs or left out from the op's schema, or None if a required
+    argument is missing.
+    """
+    args = []
+    for i, arg in enumerate(node.target._schema.arguments):
+        if i < len(node.args):
+            args.append(node.args[i])
+        elif arg.name in node.kwargs:
+            args.append(node.kwargs[arg.name])
+        elif arg.has_default_value():
+            args.append(arg.default_value)
+        else:
+            return None
+    return tuple(args)
+
+
+class FuseConvClampPass(ExportPass):
+    """
+    Replaces a floating point convolution followed by relu, hardtanh or clamp
+    with fused_ops::convolution_clamp, which clamps the output as it is
+    written instead of in a second pass over the activation.
+
+    Only the optimized kernels (kernels/optimized/custom_ops.yaml) implement
+    fused_ops::convolution_clamp.out, so this pass is opt-in. Run it after
+    FuseBatchNormPass so that conv -> batch_norm -> relu chains are fused too.
+    """
+
+    def _get_clamp_bounds(self, node: torch.fx.Node):
+        if node.target == exir_ops.edge.aten.relu.default:
+            return 0, None
+        if node.target not in (
+            exir_ops.edge.aten.hardtanh.default,
+            exir_ops.edge.aten.clamp.default,
+        ):
+            return None
+        # hardtanh(self, min_val=-1, max_val=1), clamp(self, min=None, max=None)
+        args = _normalized_args(node)
+        if args is None or (args[1] is None and args[2] is None):
+            return None
+        return args[1], args[2]
+
+    def call(self, graph_module: torch.fx.GraphModule) -> PassResult:
+        graph = graph_module.graph
+        modified = False
+        for conv in list(graph.nodes):
+            if (
+                conv.op != "call_function"
+                or conv.target != exir_ops.edge.aten.convolution.default
+                or len(conv.users) != 1
+            ):
+                continue
+            conv_args = _normalized_args(conv)
+            if conv_args is None:
+                continue
+            val = conv.meta.get("val")
+            if not isinstance(val, torch.Tensor) or not val.dtype.is_floating_point:
+                continue
+
+            activation = list(conv.users.keys())[0]
+            bounds = self._get_clamp_bounds(activation)
+            if bounds is None:
+                continue
+
+            with graph.inserting_before(activation):
+                fused = graph.call_function(
+                    exir_ops.edge.fused_ops.convolution_clamp.default,
+                    conv_args + bounds,
+                )
+            activation.replace_all_uses_with(fused)
+            graph.erase_node(activation)
+            graph.erase_node(conv)
+            modified = True
+
+        if not modified:
+            return PassResult(graph_module, False)
+
+        graph_module.recompile()
+        # Retrace to regenerate the metadata of the fused nodes.
+        return PassResult(super().call(graph_module).graph_module, True)
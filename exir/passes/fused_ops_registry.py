@@ -0,0 +1,68 @@
+# Copyright (c) Meta Platforms, Inc. and affiliates.
+# All rights reserved.
+#
+# This source code is licensed under the BSD-style license found in the
+# LICENSE file in the root directory of this source tree.
+
+from typing import List, Optional
+
+import torch
+
+from torch.library import impl, Library
+
+lib = Library("fused_ops", "DEF")
+
+# A convolution whose output is clamped to [min, max], i.e. a convolution
+# followed by relu (min=0), hardtanh (min_val, max_val) or clamp. The optimized
+# kernels (kernels/optimized/custom_ops.yaml) apply the clamp while writing the
+# output instead of in a separate pass over the activation.
+lib.define(
+    "convolution_clamp(Tensor input, Tensor weight, Tensor? bias, int[] stride, int[] padding, int[] dilation, bool transposed, int[] output_padding, int groups, Scalar? min=None, Scalar? max=None) -> Tensor"
+)
+
+lib.define(
+    "convolution_clamp.out(Tensor input, Tensor weight, Tensor? bias, int[] stride, int[] padding, int[] dilation, bool transposed, int[] output_padding, int groups, Scalar? min=None, Scalar? max=None, *, Tensor(a!) out) -> Tensor(a!)"
+)
+
+
+def _convolution_clamp(
+    input: torch.Tensor,
+    weight: torch.Tensor,
+    bias: Optional[torch.Tensor],
+    stride: List[int],
+    padding: List[int],
+    dilation: List[int],
+    transposed: bool,
+    output_padding: List[int],
+    groups: int,
+    min=None,
+    max=None,
+) -> torch.Tensor:
+    output = torch.ops.aten.convolution.default(
+        input,
+        weight,
+        bias,
+        stride,
+        padding,
+        dilation,
+        transposed,
+        output_padding,
+        groups,
+    )
+    return torch.ops.aten.clamp.default(output, min, max)
+
+
+@impl(lib, "convolution_clamp", "CompositeExplicitAutograd")
+def convolution_clamp_impl(*args, **kwargs) -> torch.Tensor:
+    return _convolution_clamp(*args, **kwargs)
+
+
+@impl(lib, "convolution_clamp", "Meta")
+def convolution_clamp_meta(*args, **kwargs) -> torch.Tensor:
+    return _convolution_clamp(*args, **kwargs)
+
+
+@impl(lib, "convolution_clamp.out", "CompositeExplicitAutograd")
+def convolution_clamp_out_impl(*args, out: torch.Tensor, **kwargs) -> torch.Tensor:
+    out.copy_(_convolution_clamp(*args, **kwargs))
+    return out
@@ -6,10 +6,11 @@
 
 import logging
 import warnings
+from typing import Callable, List
 
 import torch
 from executorch.exir.error import internal_assert
-from executorch.exir.memory import alloc
+from executorch.exir.memory import alloc, free
 from executorch.exir.memory_planning import (
     _is_out_var_node,
     apply_algo,
@@ -19,7 +20,10 @@ from executorch.exir.memory_planning import (
 )
 from executorch.exir.operator.convert import get_out_args_from_opoverload
 from executorch.exir.pass_base import PassBase, PassResult
-from executorch.exir.tensor import ALIGNMENT
+from executorch.exir.passes.reorder_for_peak_memory_pass import (
+    ReorderForPeakMemoryPass,
+)
+from executorch.exir.tensor import ALIGNMENT, TensorSpec
 
 
 class MemoryPlanningPass(PassBase):
@@ -30,18 +34,25 @@ class MemoryPlanningPass(PassBase):
         alloc_graph_input: bool = True,
         alloc_graph_output: bool = True,
         alignment: int = ALIGNMENT,
+        reorder_for_peak_memory: bool = False,
     ) -> None:
         r"""
         alloc_graph_input/alloc_graph_output will have 4 different combinations
         to control if the memory planning algorithm need allocate memory for
         the graph input/output. The default behavior is the algorithm will allocate
         memory for both graph input and output.
+
+        If reorder_for_peak_memory is set, the graph is rescheduled with
+        ReorderForPeakMemoryPass before planning. The buffer sizes planned for
+        the original order are kept in
+        graph_module.meta["non_const_buffer_sizes_before_reorder"].
         """
         self.memory_planning_algo = memory_planning_algo
         self.allow_lifetime_and_storage_overlap = allow_lifetime_and_storage_overlap
         self.alloc_graph_input = alloc_graph_input
         self.alloc_graph_output = alloc_graph_output
         self.alignment = alignment
+        self.reorder_for_peak_memory = reorder_for_peak_memory
 
     def _set_alloc_node_spec(self, graph_module: torch.fx.GraphModule) -> None:
         """
@@ -81,6 +92,61 @@ class MemoryPlanningPass(PassBase):
                         )
                         out_alloc_node.meta["spec"] = specs[i]
 
+    def _plan_without_committing(
+        self,
+        algo: Callable[..., List[int]],
+        graph_module: torch.fx.GraphModule,
+    ) -> List[int]:
+        """
+        Run algo on graph_module and return the buffer sizes, then undo
+        everything planning did to the specs and the graph.
+        """
+        saved = {}
+        # Planning inserts calls to free; remember the ones that were already
+        # there so that only the new ones are removed.
+        existing_frees = set()
+        for subgm in graph_module.modules():
+            if not isinstance(subgm, torch.fx.GraphModule):
+                continue
+            for node in subgm.graph.nodes:
+                if node.op == "call_function" and node.target == free:
+                    existing_frees.add(node)
+                for spec in get_node_tensor_specs(node):
+                    if isinstance(spec, TensorSpec) and id(spec) not in saved:
+                        saved[id(spec)] = (
+                            spec,
+                            spec.alignment,
+                            list(spec.lifetime),
+                            spec.mem_id,
+                            spec.mem_offset,
+                        )
+
+        bufsizes = apply_algo(
+            algo,
+            graph_module,
+            self.alignment,
+            self.alloc_graph_input,
+            self.alloc_graph_output,
+        )
+
+        for spec, alignment, lifetime, mem_id, mem_offset in saved.values():
+            spec.alignment = alignment
+            spec.lifetime = lifetime
+            spec.mem_id = mem_id
+            spec.mem_offset = mem_offset
+        for subgm in graph_module.modules():
+            if not isinstance(subgm, torch.fx.GraphModule):
+                continue
+            for node in list(subgm.graph.nodes):
+                if (
+                    node.op == "call_function"
+                    and node.target == free
+                    and node not in existing_frees
+                ):
+                    subgm.graph.erase_node(node)
+            subgm.recompile()
+        return bufsizes
+
     def call(self, graph_module: torch.fx.GraphModule) -> PassResult:
         """
         A pass for memory planning. The actual algorithm used will be picked by
@@ -89,12 +155,16 @@ class MemoryPlanningPass(PassBase):
         self._set_alloc_node_spec(graph_module)
         algo = get_algo(self.memory_planning_algo)
 
+        if self.reorder_for_peak_memory:
+            bufsizes_before = self._plan_without_committing(algo, graph_module)
+            ReorderForPeakMemoryPass()(graph_module)
+
         # TODO(shunting) if people have concern of adding a field to GraphModule
         # directly, we should define a GraphModule subclass that we can add our
         # customized fields. Using the graph_module object to convey information across
         # passes/stages is quite natural and avoid yet another 'context' data structure
         # to do the job.
-        _ = apply_algo(
+        bufsizes = apply_algo(
             algo,
             graph_module,
             self.alignment,
@@ -102,6 +172,14 @@ class MemoryPlanningPass(PassBase):
             self.alloc_graph_output,
         )
 
+        if self.reorder_for_peak_memory:
+            graph_module.meta.update(
+                {"non_const_buffer_sizes_before_reorder": bufsizes_before}
+            )
+            logging.info(
+                f"Reordering for peak memory changed non_const_buffer_sizes from {bufsizes_before} to {bufsizes}"
+            )
+
         # TODO: make the verifier do the work recursively to handle
         # control flow
         verifier = Verifier(
@@ -0,0 +1,334 @@
+# Copyright (c) Meta Platforms, Inc. and affiliates.
+# All rights reserved.
+#
+# This source code is licensed under the BSD-style license found in the
+# LICENSE file in the root directory of this source tree.
+
+# pyre-strict
+
+import logging
+import operator
+from typing import Dict, List, Optional, Set
+
+import torch
+from executorch.exir import control_flow, memory
+from executorch.exir.delegate import executorch_call_delegate
+from executorch.exir.memory_planning import (
+    _is_out_var_node,
+    collect_specs_from_nodes,
+    filter_nodes,
+    get_graph_input_tensors,
+    get_graph_output_tensors,
+)
+from executorch.exir.operator.convert import get_out_args_from_opoverload
+from executorch.exir.pass_base import PassBase, PassResult
+from executorch.exir.tensor import TensorSpec
+from functorch.experimental._map import map_impl
+from torch.fx import Node
+
+
+def _is_control_flow_node(node: Node) -> bool:
+    r"""
+    Return True if the node runs a submodule: cond, map or while.
+    """
+    if node.op != "call_function":
+        return False
+    target = node.target
+    if (
+        target == torch.ops.higher_order.cond
+        or target == map_impl
+        or target == control_flow.while_loop
+    ):
+        return True
+    # Catch control flow ops traced through other entry points too: they all
+    # take their bodies as get_attr'd GraphModules.
+    owner = node.graph.owning_module
+    return owner is not None and any(
+        isinstance(arg, Node)
+        and arg.op == "get_attr"
+        and isinstance(getattr(owner, str(arg.target), None), torch.fx.GraphModule)
+        for arg in node.all_input_nodes
+    )
+
+
+def _is_mutating_node(node: Node) -> bool:
+    r"""
+    Return True if the node writes to any argument other than its out
+    arguments. Such nodes (in-place ops, copy_ into mutable buffers, etc.) are
+    ordering barriers: nothing is allowed to move across them.
+    """
+    if _is_control_flow_node(node):
+        # Control flow bodies may mutate anything they capture.
+        return True
+    schema = getattr(node.target, "_schema", None)
+    if schema is None:
+        return False
+    out_args = (
+        set(get_out_args_from_opoverload(node.target))
+        if _is_out_var_node(node)
+        else set()
+    )
+    return any(
+        arg.alias_info is not None
+        and arg.alias_info.is_write
+        and arg.name not in out_args
+        for arg in schema.arguments
+    )
+
+
+class _Unit:
+    r"""
+    A group of nodes that is always scheduled together: an op, the
+    memory.alloc nodes that feed its out arguments and the getitem nodes that
+    unpack its results.
+    """
+
+    def __init__(self, head: Node, index: int) -> None:
+        self.head = head
+        self.index = index
+        self.allocs: List[Node] = []
+        self.getitems: List[Node] = []
+        self.deps: Set["_Unit"] = set()
+        self.users: Set["_Unit"] = set()
+        self.specs: Set[TensorSpec] = set()
+
+    def nodes(self) -> List[Node]:
+        return self.allocs + [self.head] + self.getitems
+
+
+def _node_specs(node: Node) -> List[TensorSpec]:
+    return [
+        spec
+        for spec in collect_specs_from_nodes(
+            filter_nodes([node, *node.args, *node.kwargs.values()]),
+            ignore_const=True,
+            ignore_out_var_node=False,
+            do_assertion=False,
+        )
+        if isinstance(spec, TensorSpec)
+    ]
+
+
+def peak_live_memory(graph: torch.fx.Graph) -> int:
+    r"""
+    Return the peak number of bytes held by non-constant, non-input tensors
+    when the graph runs in its current node order. This is a lower bound on
+    what any memory planning algorithm can achieve for this order.
+    """
+    nodes = list(graph.nodes)
+    inputs = get_graph_input_tensors(nodes)
+    outputs = get_graph_output_tensors(nodes)
+    last_use: Dict[TensorSpec, int] = {}
+    for idx, node in enumerate(nodes):
+        for spec in _node_specs(node):
+            last_use[spec] = idx
+
+    live: Set[TensorSpec] = set()
+    live_bytes = 0
+    peak = 0
+    for idx, node in enumerate(nodes):
+        for spec in _node_specs(node):
+            if spec not in inputs and spec not in live:
+                live.add(spec)
+                live_bytes += spec.allocated_memory
+        peak = max(peak, live_bytes)
+        for spec in _node_specs(node):
+            if last_use[spec] == idx and spec in live and spec not in outputs:
+                live.remove(spec)
+                live_bytes -= spec.allocated_memory
+    return peak
+
+
+def _build_units(graph: torch.fx.Graph) -> List[_Unit]:
+    nodes = list(graph.nodes)
+    position = {node: idx for idx, node in enumerate(nodes)}
+
+    def schedulable(node: Node) -> bool:
+        return node.op not in ("placeholder", "get_attr", "output")
+
+    # Pick the node each alloc/getitem travels with.
+    head_of: Dict[Node, Node] = {}
+    for node in nodes:
+        if not schedulable(node):
+            continue
+        head = node
+        if node.op == "call_function" and node.target == operator.getitem:
+            producer = node.args[0]
+            if isinstance(producer, Node) and producer in head_of:
+                head = head_of[producer]
+        elif node.op == "call_function" and node.target == memory.alloc:
+            users = list(node.users)
+            if len(users) == 1 and schedulable(users[0]):
+                head = users[0]
+        head_of[node] = head
+
+    units: Dict[Node, _Unit] = {}
+    for node in nodes:
+        head = head_of.get(node)
+        if head is node:
+            units[node] = _Unit(node, position[node])
+    for node in nodes:
+        head = head_of.get(node)
+        if head is None or head is node:
+            continue
+        if node.target == memory.alloc:
+            units[head].allocs.append(node)
+        else:
+            units[head].getitems.append(node)
+
+    for unit in units.values():
+        for node in unit.nodes():
+            unit.specs.update(_node_specs(node))
+            for inp in node.all_input_nodes:
+                if inp in head_of and units[head_of[inp]] is not unit:
+                    dep = units[head_of[inp]]
+                    unit.deps.add(dep)
+                    dep.users.add(unit)
+
+    # A free takes its TensorSpec rather than a node, so it has no data
+    # dependencies of its own. It must still run after every unit that reads
+    # or writes the freed tensor.
+    users_of_spec: Dict[TensorSpec, List[_Unit]] = {}
+    for unit in units.values():
+        for spec in unit.specs:
+            users_of_spec.setdefault(spec, []).append(unit)
+    for unit in units.values():
+        if unit.head.op != "call_function" or unit.head.target != memory.free:
+            continue
+        spec = unit.head.args[0]
+        if not isinstance(spec, TensorSpec):
+            continue
+        for dep in users_of_spec.get(spec, []):
+            if dep is not unit:
+                unit.deps.add(dep)
+                dep.users.add(unit)
+
+    # Keep delegate calls in their original relative order. Backends may keep
+    # state across calls, so only the portable ops around them are moved.
+    ordered = sorted(units.values(), key=lambda u: u.index)
+    prev_delegate: Optional[_Unit] = None
+    for unit in ordered:
+        if unit.head.target == executorch_call_delegate:
+            if prev_delegate is not None:
+                unit.deps.add(prev_delegate)
+                prev_delegate.users.add(unit)
+            prev_delegate = unit
+    return ordered
+
+
+def _schedule_segment(
+    segment: List[_Unit],
+    ref_count: Dict[TensorSpec, int],
+    born: Set[TensorSpec],
+    inputs: Set[TensorSpec],
+    outputs: Set[TensorSpec],
+) -> List[_Unit]:
+    in_segment = set(segment)
+    pending = {
+        unit: len([dep for dep in unit.deps if dep in in_segment]) for unit in segment
+    }
+    ready = [unit for unit in segment if pending[unit] == 0]
+    order: List[_Unit] = []
+
+    def delta(unit: _Unit) -> int:
+        allocated = 0
+        freed = 0
+        for spec in unit.specs:
+            if spec in inputs:
+                continue
+            if spec not in born:
+                allocated += spec.allocated_memory
+            if ref_count[spec] == 1 and spec not in outputs:
+                freed += spec.allocated_memory
+        return allocated - freed
+
+    while ready:
+        unit = min(ready, key=lambda u: (delta(u), u.index))
+        ready.remove(unit)
+        order.append(unit)
+        for spec in unit.specs:
+            born.add(spec)
+            ref_count[spec] -= 1
+        for user in unit.users:
+            if user in pending:
+                pending[user] -= 1
+                if pending[user] == 0:
+                    ready.append(user)
+    assert len(order) == len(segment), "dependency cycle while reordering graph"
+    return order
+
+
+def reorder_for_peak_memory(graph_module: torch.fx.GraphModule) -> bool:
+    r"""
+    Reorder the nodes of graph_module (not its submodules) with a greedy list
+    scheduler that always runs the ready op that grows the live tensor set the
+    least. Mutating ops act as barriers and delegate calls keep their relative
+    order. The new order is only kept if it does not increase the peak live
+    memory. Returns True if the graph was modified.
+    """
+    graph = graph_module.graph
+    nodes = list(graph.nodes)
+    units = _build_units(graph)
+    if len(units) < 2:
+        return False
+
+    inputs = get_graph_input_tensors(nodes)
+    outputs = get_graph_output_tensors(nodes)
+    ref_count: Dict[TensorSpec, int] = {}
+    for unit in units:
+        for spec in unit.specs:
+            ref_count[spec] = ref_count.get(spec, 0) + 1
+    born: Set[TensorSpec] = set()
+
+    scheduled: List[_Unit] = []
+    segment: List[_Unit] = []
+    for unit in units:
+        if _is_mutating_node(unit.head):
+            scheduled += _schedule_segment(segment, ref_count, born, inputs, outputs)
+            scheduled += _schedule_segment([unit], ref_count, born, inputs, outputs)
+            segment = []
+        else:
+            segment.append(unit)
+    scheduled += _schedule_segment(segment, ref_count, born, inputs, outputs)
+
+    new_order = [
+        node for node in nodes if node.op in ("placeholder", "get_attr")
+    ] + [node for unit in scheduled for node in unit.nodes()]
+    output_node = nodes[-1]
+    assert output_node.op == "output"
+    if new_order == nodes[:-1]:
+        return False
+
+    peak_before = peak_live_memory(graph)
+    for node in new_order:
+        output_node.prepend(node)
+    peak_after = peak_live_memory(graph)
+    if peak_after > peak_before:
+        # The greedy order is a heuristic; never make things worse.
+        for node in nodes[:-1]:
+            output_node.prepend(node)
+        return False
+
+    graph.lint()
+    graph_module.recompile()
+    logging.debug(
+        f"Reordered graph for peak memory: {peak_before} -> {peak_after} bytes"
+    )
+    return True
+
+
+class ReorderForPeakMemoryPass(PassBase):
+    r"""
+    Topologically reorder each graph (and control flow submodule graph) so that
+    fewer intermediate tensors are alive at the same time, which lets memory
+    planning pack them into smaller buffers. Must run after ToOutVarPass and
+    before MemoryPlanningPass, since it relies on the TensorSpecs of the
+    memory.alloc nodes.
+    """
+
+    def call(self, graph_module: torch.fx.GraphModule) -> PassResult:
+        modified = False
+        for subgm in graph_module.modules():
+            if isinstance(subgm, torch.fx.GraphModule):
+                modified |= reorder_for_peak_memory(subgm)
+        return PassResult(graph_module, modified)
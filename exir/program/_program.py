@@ -186,6 +186,8 @@ class ExirExportedProgram:
             segment_alignment=config.segment_alignment,
             constant_tensor_alignment=config.constant_tensor_alignment,
             delegate_alignment=config.delegate_alignment,
+            deduplicate_data=config.deduplicate_data,
+            compress_segments=config.compress_segments,
         )
         executorch_prog.graph_module.meta.update(
             new_prog.exported_program.graph_module.meta
@@ -216,6 +218,8 @@ class ExecutorchProgram:
         segment_alignment: int,
         constant_tensor_alignment: Optional[int] = None,
         delegate_alignment: Optional[int] = None,
+        deduplicate_data: bool = False,
+        compress_segments: bool = False,
     ) -> None:
         if not exir_exported_program.after_to_edge_passes:
             raise RuntimeError(
@@ -229,6 +233,8 @@ class ExecutorchProgram:
         self._segment_alignment: int = segment_alignment
         self._constant_tensor_alignment: Optional[int] = constant_tensor_alignment
         self._delegate_alignment: Optional[int] = delegate_alignment
+        self._deduplicate_data: bool = deduplicate_data
+        self._compress_segments: bool = compress_segments
 
     @property
     def buffer(self) -> bytes:
@@ -239,6 +245,8 @@ class ExecutorchProgram:
                 segment_alignment=self._segment_alignment,
                 constant_tensor_alignment=self._constant_tensor_alignment,
                 delegate_alignment=self._delegate_alignment,
+                deduplicate_data=self._deduplicate_data,
+                compress_segments=self._compress_segments,
             )
         return self._buffer
 
@@ -488,6 +496,8 @@ class MultiMethodExecutorchProgram:
         segment_alignment: int,
         constant_tensor_alignment: Optional[int] = None,
         delegate_alignment: Optional[int] = None,
+        deduplicate_data: bool = False,
+        compress_segments: bool = False,
         prim_getters: Optional[Dict[str, Any]] = None,
     ) -> None:
         self._buffer: Optional[bytes] = None
@@ -504,6 +514,8 @@ class MultiMethodExecutorchProgram:
         self._segment_alignment: int = segment_alignment
         self._constant_tensor_alignment: Optional[int] = constant_tensor_alignment
         self._delegate_alignment: Optional[int] = delegate_alignment
+        self._deduplicate_data: bool = deduplicate_data
+        self._compress_segments: bool = compress_segments
         self._prim_getter_cache = prim_getters
 
     @property
@@ -515,6 +527,8 @@ class MultiMethodExecutorchProgram:
                 segment_alignment=self._segment_alignment,
                 constant_tensor_alignment=self._constant_tensor_alignment,
                 delegate_alignment=self._delegate_alignment,
+                deduplicate_data=self._deduplicate_data,
+                compress_segments=self._compress_segments,
             )
         return self._buffer
 
@@ -556,6 +570,8 @@ def multi_method_program_to_executorch(
         segment_alignment=config.segment_alignment,
         constant_tensor_alignment=config.constant_tensor_alignment,
         delegate_alignment=config.delegate_alignment,
+        deduplicate_data=config.deduplicate_data,
+        compress_segments=config.compress_segments,
         prim_getters=edge_dialect_program.prim_getters(),
     )
 
@@ -844,6 +860,8 @@ class ExecutorchProgramManager:
             segment_alignment=backend_config.segment_alignment,
             constant_tensor_alignment=backend_config.constant_tensor_alignment,
             delegate_alignment=backend_config.delegate_alignment,
+            deduplicate_data=backend_config.deduplicate_data,
+            compress_segments=backend_config.compress_segments,
         )
 
     @property
@@ -238,10 +238,17 @@ class ExecutionPlan:
     non_const_buffer_sizes: List[int]
 
 
+class SegmentCompression(IntEnum):
+    NONE = 0
+    LZ4_BLOCK = 1
+
+
 @dataclass
 class DataSegment:
     offset: int
     size: int
+    compression: SegmentCompression = SegmentCompression.NONE
+    uncompressed_size: int = 0
 
 
 @dataclass
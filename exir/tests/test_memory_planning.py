@@ -18,6 +18,7 @@ import torch.utils._pytree as pytree
 from executorch.backends.fb.qnnpack.partition.qnnpack_partitioner import (
     QnnpackPartitioner,
 )
+from executorch.exir import control_flow, memory
 from executorch.exir.backend.backend_api import to_backend, validation_disabled
 from executorch.exir.memory_planning import filter_nodes, Verifier
 from executorch.exir.pass_base import PassResult
@@ -30,6 +31,10 @@ from executorch.exir.passes import (  # noqa
     SpecPropPass,
     ToOutVarPass,
 )
+from executorch.exir.passes.reorder_for_peak_memory_pass import (
+    _is_mutating_node,
+    reorder_for_peak_memory,
+)
 from executorch.exir.print_program import print_program
 from executorch.exir.tests.asr_joiner import ASRJoiner
 from parameterized import parameterized
@@ -161,6 +166,44 @@ class ModuleListArg(nn.Module):
             testcase.assertTrue(getitem_spec.lifetime[1] >= cat_specs[0].lifetime[0])
 
 
+class ModuleIndependentBranches(nn.Module):
+    r"""
+    Three large intermediates that are each reduced to a scalar. In program
+    order all of them are alive at once; reducing each one right after it is
+    produced keeps only one alive.
+    """
+
+    def __init__(self) -> None:
+        super(ModuleIndependentBranches, self).__init__()
+
+    def forward(self, x: torch.Tensor) -> torch.Tensor:
+        a = x + 1
+        b = x * 2
+        c = x - 1
+        return a.sum() + b.sum() + c.sum()
+
+    def get_random_inputs(self) -> Tuple[torch.Tensor, ...]:
+        return (torch.randn(64, 64),)
+
+
+class ModuleSharedIntermediate(nn.Module):
+    r"""
+    One intermediate that several ops read, next to an independent branch the
+    reorder pass is free to move around it.
+    """
+
+    def __init__(self) -> None:
+        super(ModuleSharedIntermediate, self).__init__()
+
+    def forward(self, x: torch.Tensor) -> torch.Tensor:
+        a = x + 1
+        b = x * 2
+        return a.sum() + a.mean() + b.sum() + a.amax()
+
+    def get_random_inputs(self) -> Tuple[torch.Tensor, ...]:
+        return (torch.randn(64, 64),)
+
+
 class CustomPoolMemoryPlanningPass(MemoryPlanningPass):
     def call(self, graph_module: GraphModule) -> PassResult:
         for subgm in graph_module.modules():
@@ -377,6 +420,113 @@ class TestMemoryPlanning(unittest.TestCase):
             )
             case(self)
 
+    def test_reorder_for_peak_memory(self) -> None:
+        eager_module = ModuleIndependentBranches().eval()
+        graph_module = (
+            exir.capture(
+                eager_module,
+                eager_module.get_random_inputs(),
+                exir.CaptureConfig(),
+            )
+            .to_edge(exir.EdgeCompileConfig(_check_ir_validity=False))
+            .exported_program.graph_module
+        )
+        graph_module = PassManager(
+            passes=[
+                SpecPropPass(),
+                ToOutVarPass(),
+                MemoryPlanningPass("greedy", reorder_for_peak_memory=True),
+            ],
+        )(graph_module).graph_module
+
+        self.verify_reuse(graph_module, True, True, True)
+        self.verify_graph_input_output(graph_module, True, True)
+
+        before = graph_module.meta["non_const_buffer_sizes_before_reorder"]
+        after = graph_module.meta["non_const_buffer_sizes"]
+        self.assertLess(after[1], before[1])
+
+    def test_reorder_keeps_existing_frees(self) -> None:
+        eager_module = ModuleIndependentBranches().eval()
+        graph_module = (
+            exir.capture(
+                eager_module,
+                eager_module.get_random_inputs(),
+                exir.CaptureConfig(),
+            )
+            .to_edge(exir.EdgeCompileConfig(_check_ir_validity=False))
+            .exported_program.graph_module
+        )
+        graph_module = PassManager(
+            passes=[SpecPropPass(), ToOutVarPass()],
+        )(graph_module).graph_module
+
+        # A free that an earlier pass put in the graph must survive the trial
+        # planning of the original order.
+        output_node = list(graph_module.graph.nodes)[-1]
+        alloc_node = next(
+            node for node in graph_module.graph.nodes if node.target == memory.alloc
+        )
+        with graph_module.graph.inserting_before(output_node):
+            free_node = graph_module.graph.call_function(
+                memory.free, (alloc_node.meta["spec"],)
+            )
+
+        graph_module = PassManager(
+            passes=[MemoryPlanningPass("greedy", reorder_for_peak_memory=True)],
+        )(graph_module).graph_module
+        self.assertIn(free_node, graph_module.graph.nodes)
+
+    def test_reorder_keeps_free_after_readers(self) -> None:
+        eager_module = ModuleSharedIntermediate().eval()
+        graph_module = (
+            exir.capture(
+                eager_module,
+                eager_module.get_random_inputs(),
+                exir.CaptureConfig(),
+            )
+            .to_edge(exir.EdgeCompileConfig(_check_ir_validity=False))
+            .exported_program.graph_module
+        )
+        graph_module = PassManager(
+            passes=[SpecPropPass(), ToOutVarPass()],
+        )(graph_module).graph_module
+
+        # Free `a` right after its last reader, the way insert_calls_to_free
+        # would.
+        nodes = list(graph_module.graph.nodes)
+        alloc_node = next(node for node in nodes if node.target == memory.alloc)
+        (producer,) = alloc_node.users
+        readers = list(producer.users)
+        self.assertGreater(len(readers), 1)
+        with graph_module.graph.inserting_after(max(readers, key=nodes.index)):
+            free_node = graph_module.graph.call_function(
+                memory.free, (alloc_node.meta["spec"],)
+            )
+
+        reorder_for_peak_memory(graph_module)
+
+        order = list(graph_module.graph.nodes)
+        for node in [alloc_node, producer, *readers]:
+            self.assertLess(order.index(node), order.index(free_node))
+
+    def test_control_flow_is_reorder_barrier(self) -> None:
+        body_graph = torch.fx.Graph()
+        body_graph.output(body_graph.placeholder("x"))
+        root = torch.nn.Module()
+        root.body = torch.fx.GraphModule(torch.nn.Module(), body_graph)
+
+        graph = torch.fx.Graph()
+        x = graph.placeholder("x")
+        body = graph.get_attr("body")
+        loop = graph.call_function(control_flow.while_loop, (body, body, (x,)))
+        add = graph.call_function(torch.ops.aten.add.Tensor, (x, x))
+        graph.output((loop, add))
+        torch.fx.GraphModule(root, graph)
+
+        self.assertTrue(_is_mutating_node(loop))
+        self.assertFalse(_is_mutating_node(add))
+
 
 class TestVerifier(unittest.TestCase):
     def test_overlap(self) -> None:
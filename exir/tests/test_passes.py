@@ -24,6 +24,8 @@ from executorch.exir.pass_base import ExportPass, PassResult
 from executorch.exir.passes import (
     dead_code_elimination_pass,
     DebugPass,
+    FuseBatchNormPass,
+    FuseConvClampPass,
     HintBasedSymShapeEvalPass,
     MemoryPlanningPass,
     propagate_dynamic_shape,
@@ -1063,3 +1065,127 @@ class TestPasses(unittest.TestCase):
         FileCheck().check(
             "executorch_exir_dialects_edge__ops_aten_slice_copy_Tensor"
         ).run(gm.code)
+
+    def test_fuse_batch_norm_pass(self) -> None:
+        class M(torch.nn.Module):
+            def __init__(self):
+                super().__init__()
+                self.conv = torch.nn.Conv2d(3, 8, 3, padding=1)
+                self.conv_bn = torch.nn.BatchNorm2d(8)
+                self.linear = torch.nn.Linear(8, 4, bias=False)
+                self.linear_bn = torch.nn.BatchNorm1d(4)
+
+            def forward(self, x):
+                x = self.conv_bn(self.conv(x))
+                x = x.mean(dim=(2, 3))
+                return self.linear_bn(self.linear(x))
+
+        model = M()
+        for bn in (model.conv_bn, model.linear_bn):
+            bn.running_mean.uniform_(-1, 1)
+            bn.running_var.uniform_(0.5, 2)
+            bn.weight.data.uniform_(-1, 1)
+            bn.bias.data.uniform_(-1, 1)
+        model.eval()
+
+        inputs = (torch.randn(2, 3, 8, 8),)
+        edge = exir.capture(model, inputs, exir.CaptureConfig()).to_edge()
+        expected = edge(*inputs)
+
+        batch_norm_str = "executorch_exir_dialects_edge__ops_aten__native_batch_norm_legit_no_training_default"
+        FileCheck().check_count(batch_norm_str, 2, exactly=True).run(
+            edge.exported_program.graph_module.code
+        )
+
+        edge = edge.transform(FuseBatchNormPass())
+        FileCheck().check_not(batch_norm_str).check(
+            "executorch_exir_dialects_edge__ops_aten_convolution_default"
+        ).check("executorch_exir_dialects_edge__ops_aten_addmm_default").run(
+            edge.exported_program.graph_module.code
+        )
+        self.assertTrue(torch.allclose(edge(*inputs), expected, atol=1e-5))
+        edge.to_executorch()
+
+    def test_fuse_lifted_conv_batch_norm_clamp(self) -> None:
+        class M(torch.nn.Module):
+            def __init__(self):
+                super().__init__()
+                self.conv = torch.nn.Conv2d(3, 8, 3, padding=1, bias=False)
+                self.bn = torch.nn.BatchNorm2d(8)
+
+            def forward(self, x):
+                return torch.clamp(self.bn(self.conv(x)), min=-0.5, max=0.5)
+
+        model = M()
+        model.bn.running_mean.uniform_(-1, 1)
+        model.bn.running_var.uniform_(0.5, 2)
+        model.bn.weight.data.uniform_(-1, 1)
+        model.bn.bias.data.uniform_(-1, 1)
+        model.eval()
+
+        inputs = (torch.randn(1, 3, 8, 8),)
+        edge = exir.capture(
+            model, inputs, exir.CaptureConfig(enable_aot=True)
+        ).to_edge()
+        expected = edge(*inputs)
+
+        edge = edge.transform(FuseBatchNormPass(edge.exported_program))
+        edge = edge.transform(FuseConvClampPass())
+        FileCheck().check_not("batch_norm").check_count(
+            "executorch_exir_dialects_edge__ops_fused_ops_convolution_clamp_default",
+            1,
+            exactly=True,
+        ).run(edge.exported_program.graph_module.code)
+
+        # The folded weight and the new bias are lifted parameters, and the
+        # batch norm's parameters and buffers are gone.
+        graph = edge.exported_program.graph
+        signature = edge.exported_program.graph_signature
+        placeholders = [node.name for node in graph.nodes if node.op == "placeholder"]
+        self.assertEqual(
+            placeholders, [spec.arg.name for spec in signature.input_specs]
+        )
+        self.assertEqual(len(signature.inputs_to_parameters), 2)
+        self.assertFalse(
+            any("running" in name for name in signature.inputs_to_buffers.values())
+        )
+        self.assertFalse(any(node.op == "get_attr" for node in graph.nodes))
+
+        self.assertTrue(torch.allclose(edge(*inputs), expected, atol=1e-5))
+        edge.to_executorch()
+
+    def test_fuse_conv_clamp_pass(self) -> None:
+        class M(torch.nn.Module):
+            def __init__(self):
+                super().__init__()
+                self.conv1 = torch.nn.Conv2d(3, 8, 3, padding=1)
+                self.conv2 = torch.nn.Conv2d(8, 8, 1)
+                self.conv3 = torch.nn.Conv2d(8, 4, 3, groups=4)
+
+            def forward(self, x):
+                x = torch.relu(self.conv1(x))
+                x = torch.nn.functional.relu6(self.conv2(x))
+                return torch.clamp(self.conv3(x), max=0.5)
+
+        model = M().eval()
+        inputs = (torch.randn(1, 3, 8, 8),)
+        edge = exir.capture(model, inputs, exir.CaptureConfig()).to_edge()
+        expected = edge(*inputs)
+
+        edge = edge.transform(FuseConvClampPass())
+        FileCheck().check_count(
+            "executorch_exir_dialects_edge__ops_fused_ops_convolution_clamp_default",
+            3,
+            exactly=True,
+        ).check_not("executorch_exir_dialects_edge__ops_aten_convolution_default").run(
+            edge.exported_program.graph_module.code
+        )
+        self.assertTrue(torch.allclose(edge(*inputs), expected))
+
+        program = edge.to_executorch().program
+        self.assertTrue(
+            any(
+                op.name == "fused_ops::convolution_clamp"
+                for op in program.execution_plan[0].operators
+            )
+        )
@@ -0,0 +1,168 @@
+/*
+ * Copyright (c) Meta Platforms, Inc. and affiliates.
+ * All rights reserved.
+ *
+ * This source code is licensed under the BSD-style license found in the
+ * LICENSE file in the root directory of this source tree.
+ */
+
+#include <executorch/extension/async_executor/async_method_executor.h>
+
+#include <algorithm>
+#include <cinttypes>
+
+#include <executorch/runtime/platform/log.h>
+
+namespace torch {
+namespace executor {
+namespace util {
+
+AsyncMethodExecutor::AsyncMethodExecutor(size_t num_threads) {
+  num_threads = std::max<size_t>(num_threads, 1);
+  threads_.reserve(num_threads);
+  for (size_t i = 0; i < num_threads; ++i) {
+    threads_.emplace_back([this]() { worker_loop(); });
+  }
+}
+
+AsyncMethodExecutor::~AsyncMethodExecutor() {
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    stopping_ = true;
+    for (const ExecutionPtr& execution : executions_) {
+      execution->cancel();
+    }
+  }
+  cv_.notify_all();
+  for (std::thread& thread : threads_) {
+    thread.join();
+  }
+}
+
+std::shared_ptr<AsyncExecution> AsyncMethodExecutor::execute_async(
+    Method& method,
+    int priority,
+    AsyncExecution::Callback on_complete) {
+  // The constructor is private, so std::make_shared can't be used.
+  ExecutionPtr execution(
+      new AsyncExecution(method, priority, std::move(on_complete)));
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    if (stopping_) {
+      execution->cancel();
+    }
+    executions_.push_back(execution);
+    update_waiting_priority_locked();
+  }
+  cv_.notify_one();
+  return execution;
+}
+
+AsyncMethodExecutor::ExecutionPtr AsyncMethodExecutor::pick_locked() const {
+  ExecutionPtr best;
+  for (size_t i = 0; i < executions_.size(); ++i) {
+    const ExecutionPtr& execution = executions_[i];
+    if (execution->running_) {
+      continue;
+    }
+    if (execution->cancel_requested_ && !execution->started_) {
+      // Nothing to run; complete it right away.
+      return execution;
+    }
+    // Only the oldest outstanding execution of a Method may run.
+    bool is_oldest = true;
+    for (size_t j = 0; j < i && is_oldest; ++j) {
+      is_oldest = &executions_[j]->method_ != &execution->method_;
+    }
+    if (!is_oldest) {
+      continue;
+    }
+    // executions_ is in submission order, so the first one wins ties.
+    if (best == nullptr || execution->priority_ > best->priority_) {
+      best = execution;
+    }
+  }
+  return best;
+}
+
+void AsyncMethodExecutor::update_waiting_priority_locked() {
+  ExecutionPtr next = pick_locked();
+  waiting_priority_ = next == nullptr ? INT_MIN : next->priority_;
+}
+
+bool AsyncMethodExecutor::run(AsyncExecution& execution, Error& status) {
+  Method& method = execution.method_;
+  while (true) {
+    if (execution.cancel_requested_) {
+      if (execution.started_) {
+        // Leave the Method ready for the next execution.
+        Error err = method.experimental_cancel_execution();
+        (void)err;
+      }
+      status = Error::Cancelled;
+      return true;
+    }
+    if (waiting_priority_ > execution.priority_) {
+      // Suspend; the Method keeps its place in step_state_.
+      return false;
+    }
+    execution.started_ = true;
+    Error err = method.experimental_step();
+    if (err == Error::EndOfMethod) {
+      status = method.experimental_reset_execution();
+      return true;
+    }
+    if (err != Error::Ok) {
+      ET_LOG(Error, "Async execution failed: 0x%" PRIx32, (uint32_t)err);
+      // Failed mid-execution; rewind so that the Method can be run again.
+      Error cancel_err = method.experimental_cancel_execution();
+      (void)cancel_err;
+      status = err;
+      return true;
+    }
+  }
+}
+
+void AsyncMethodExecutor::worker_loop() {
+  std::unique_lock<std::mutex> lock(mutex_);
+  while (true) {
+    ExecutionPtr execution;
+    cv_.wait(lock, [&]() {
+      execution = pick_locked();
+      return execution != nullptr || (stopping_ && executions_.empty());
+    });
+    if (execution == nullptr) {
+      return;
+    }
+    execution->running_ = true;
+    update_waiting_priority_locked();
+    lock.unlock();
+
+    Error status = Error::Ok;
+    const bool completed = run(*execution, status);
+
+    if (completed) {
+      // Still marked as running, so the next execution of this Method can't
+      // start until the callback is done reading its outputs.
+      if (execution->on_complete_) {
+        execution->on_complete_(status);
+      }
+      execution->promise_.set_value(status);
+    }
+
+    lock.lock();
+    execution->running_ = false;
+    if (completed) {
+      executions_.erase(
+          std::find(executions_.begin(), executions_.end(), execution));
+    }
+    update_waiting_priority_locked();
+    // Completing may have made the next execution of the same Method
+    // runnable, and yielding always leaves work for another worker.
+    cv_.notify_all();
+  }
+}
+
+} // namespace util
+} // namespace executor
+} // namespace torch
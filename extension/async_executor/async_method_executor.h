@@ -0,0 +1,168 @@
+/*
+ * Copyright (c) Meta Platforms, Inc. and affiliates.
+ * All rights reserved.
+ *
+ * This source code is licensed under the BSD-style license found in the
+ * LICENSE file in the root directory of this source tree.
+ */
+
+#pragma once
+
+#include <atomic>
+#include <chrono>
+#include <climits>
+#include <condition_variable>
+#include <functional>
+#include <future>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+#include <executorch/runtime/core/error.h>
+#include <executorch/runtime/executor/method.h>
+
+namespace torch {
+namespace executor {
+namespace util {
+
+class AsyncMethodExecutor;
+
+/**
+ * A Method execution submitted to an AsyncMethodExecutor. Completes with
+ * Error::Ok, the error returned by the Method, or Error::Cancelled.
+ */
+class AsyncExecution final {
+ public:
+  /// Called on a worker thread when the execution completes, before the
+  /// future becomes ready.
+  using Callback = std::function<void(Error)>;
+
+  /**
+   * Requests that the execution stop. If it hasn't started it never will; if
+   * it is running it stops before its next instruction. Either way it then
+   * completes with Error::Cancelled. Has no effect if it already completed.
+   */
+  void cancel() {
+    cancel_requested_ = true;
+  }
+
+  /// Blocks until the execution completes and returns its status.
+  Error wait() const {
+    return future_.get();
+  }
+
+  /// Returns true if the execution has completed.
+  bool done() const {
+    return future_.wait_for(std::chrono::seconds(0)) ==
+        std::future_status::ready;
+  }
+
+  /// Returns a future that becomes ready with the status of the execution.
+  std::shared_future<Error> future() const {
+    return future_;
+  }
+
+  int priority() const {
+    return priority_;
+  }
+
+ private:
+  friend class AsyncMethodExecutor;
+
+  AsyncExecution(Method& method, int priority, Callback on_complete)
+      : method_(method),
+        priority_(priority),
+        on_complete_(std::move(on_complete)),
+        future_(promise_.get_future().share()) {}
+
+  Method& method_;
+  const int priority_;
+  Callback on_complete_;
+  std::atomic<bool> cancel_requested_{false};
+  // Guarded by the executor's mutex, except that started_ is also written
+  // by the worker that has the execution marked as running_.
+  bool started_ = false;
+  bool running_ = false;
+
+  std::promise<Error> promise_;
+  std::shared_future<Error> future_;
+};
+
+/**
+ * Runs Methods on a pool of worker threads owned by the executor, so that
+ * callers can prepare the next request while earlier ones execute.
+ *
+ * Executions run one instruction at a time through
+ * `Method::experimental_step()`. Between instructions a worker checks for
+ * cancellation and for waiting executions of other Methods with a higher
+ * priority; if there is one, the current execution is suspended where it is
+ * and resumed once no higher priority work is waiting. Executions of the same
+ * Method always run one after another, in submission order.
+ *
+ * The caller must set a Method's inputs before submitting it, must not touch
+ * the Method while one of its executions is outstanding, and must keep the
+ * Method alive until they all completed.
+ */
+class AsyncMethodExecutor final {
+ public:
+  /**
+   * @param[in] num_threads Number of worker threads. A single worker still
+   *     lets high priority executions preempt low priority ones.
+   */
+  explicit AsyncMethodExecutor(size_t num_threads = 1);
+
+  /// Cancels all outstanding executions and waits for the workers to exit.
+  ~AsyncMethodExecutor();
+
+  AsyncMethodExecutor(const AsyncMethodExecutor&) = delete;
+  AsyncMethodExecutor& operator=(const AsyncMethodExecutor&) = delete;
+  AsyncMethodExecutor(AsyncMethodExecutor&&) = delete;
+  AsyncMethodExecutor& operator=(AsyncMethodExecutor&&) = delete;
+
+  /**
+   * Submits an execution of `method`.
+   *
+   * @param[in] method The initialized Method to execute, with its inputs set.
+   * @param[in] priority Executions with a larger value run first and preempt
+   *     running executions of other Methods with a smaller value.
+   * @param[in] on_complete Optional callback invoked on a worker thread with
+   *     the final status.
+   *
+   * @returns A handle to wait for or cancel the execution.
+   */
+  std::shared_ptr<AsyncExecution> execute_async(
+      Method& method,
+      int priority = 0,
+      AsyncExecution::Callback on_complete = nullptr);
+
+ private:
+  using ExecutionPtr = std::shared_ptr<AsyncExecution>;
+
+  void worker_loop();
+
+  // Runs `execution` until it completes or should yield to another one.
+  // Returns true and sets `status` if it completed.
+  bool run(AsyncExecution& execution, Error& status);
+
+  // Returns the waiting execution that should run next, or nullptr. Must hold
+  // mutex_.
+  ExecutionPtr pick_locked() const;
+
+  // Recomputes waiting_priority_. Must hold mutex_.
+  void update_waiting_priority_locked();
+
+  std::mutex mutex_;
+  std::condition_variable cv_;
+  // Outstanding executions in submission order, running or not.
+  std::vector<ExecutionPtr> executions_;
+  bool stopping_ = false;
+  // Highest priority among executions that could start or resume right now;
+  // read by running workers between instructions without the lock.
+  std::atomic<int> waiting_priority_{INT_MIN};
+  std::vector<std::thread> threads_;
+};
+
+} // namespace util
+} // namespace executor
+} // namespace torch
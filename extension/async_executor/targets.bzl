@@ -0,0 +1,28 @@
+load("@fbsource//xplat/executorch/build:runtime_wrapper.bzl", "runtime")
+
+def define_common_targets():
+    """Defines targets that should be shared between fbcode and xplat.
+
+    The directory containing this targets.bzl file should also contain both
+    TARGETS and BUCK files that call this function.
+    """
+
+    for aten_mode in (True, False):
+        aten_suffix = ("_aten" if aten_mode else "")
+
+        runtime.cxx_library(
+            name = "async_method_executor" + aten_suffix,
+            srcs = ["async_method_executor.cpp"],
+            exported_headers = ["async_method_executor.h"],
+            visibility = [
+                "//executorch/extension/async_executor/test/...",
+                "@EXECUTORCH_CLIENTS",
+            ],
+            exported_deps = [
+                "//executorch/runtime/core:core",
+                "//executorch/runtime/executor:program" + aten_suffix,
+            ],
+            deps = [
+                "//executorch/runtime/platform:platform",
+            ],
+        )
@@ -0,0 +1,150 @@
+/*
+ * Copyright (c) Meta Platforms, Inc. and affiliates.
+ * All rights reserved.
+ *
+ * This source code is licensed under the BSD-style license found in the
+ * LICENSE file in the root directory of this source tree.
+ */
+
+#include <atomic>
+#include <cstdlib>
+#include <memory>
+
+#include <executorch/extension/async_executor/async_method_executor.h>
+#include <executorch/extension/data_loader/file_data_loader.h>
+#include <executorch/runtime/executor/method.h>
+#include <executorch/runtime/executor/program.h>
+#include <executorch/runtime/executor/test/managed_memory_manager.h>
+#include <executorch/runtime/platform/runtime.h>
+#include <executorch/util/util.h>
+#include <gtest/gtest.h>
+
+using namespace ::testing;
+using torch::executor::Error;
+using torch::executor::Method;
+using torch::executor::Program;
+using torch::executor::Result;
+using torch::executor::testing::ManagedMemoryManager;
+using torch::executor::util::AsyncExecution;
+using torch::executor::util::AsyncMethodExecutor;
+using torch::executor::util::FileDataLoader;
+
+constexpr size_t kDefaultNonConstMemBytes = 32 * 1024U;
+constexpr size_t kDefaultRuntimeMemBytes = 32 * 1024U;
+
+class AsyncMethodExecutorTest : public ::testing::Test {
+ protected:
+  void SetUp() override {
+    torch::executor::runtime_init();
+
+    Result<FileDataLoader> loader =
+        FileDataLoader::from(std::getenv("ET_MODULE_ADD_PATH"));
+    ASSERT_EQ(loader.error(), Error::Ok);
+    loader_ = std::make_unique<FileDataLoader>(std::move(loader.get()));
+
+    Result<Program> program = Program::load(
+        loader_.get(), Program::Verification::InternalConsistency);
+    ASSERT_EQ(program.error(), Error::Ok);
+    program_ = std::make_unique<Program>(std::move(program.get()));
+  }
+
+ private:
+  // Must outlive program_, but tests shouldn't need to touch it.
+  std::unique_ptr<FileDataLoader> loader_;
+
+ protected:
+  std::unique_ptr<Program> program_;
+};
+
+TEST_F(AsyncMethodExecutorTest, ExecuteCompletesAndCallsBack) {
+  ManagedMemoryManager mmm(kDefaultNonConstMemBytes, kDefaultRuntimeMemBytes);
+  Result<Method> method = program_->load_method("forward", &mmm.get());
+  ASSERT_EQ(method.error(), Error::Ok);
+  auto inputs = torch::executor::util::PrepareInputTensors(*method);
+
+  std::atomic<int> num_callbacks{0};
+  Error callback_status = Error::Internal;
+  {
+    AsyncMethodExecutor executor(/*num_threads=*/2);
+    std::shared_ptr<AsyncExecution> execution =
+        executor.execute_async(*method, /*priority=*/0, [&](Error status) {
+          callback_status = status;
+          num_callbacks++;
+        });
+    EXPECT_EQ(execution->wait(), Error::Ok);
+    EXPECT_TRUE(execution->done());
+  }
+  EXPECT_EQ(num_callbacks, 1);
+  EXPECT_EQ(callback_status, Error::Ok);
+
+  // The Method is left ready to execute again.
+  EXPECT_EQ(method->execute(), Error::Ok);
+
+  torch::executor::util::FreeInputs(inputs);
+}
+
+TEST_F(AsyncMethodExecutorTest, ExecutionsOfOneMethodRunInOrder) {
+  ManagedMemoryManager mmm(kDefaultNonConstMemBytes, kDefaultRuntimeMemBytes);
+  Result<Method> method = program_->load_method("forward", &mmm.get());
+  ASSERT_EQ(method.error(), Error::Ok);
+  auto inputs = torch::executor::util::PrepareInputTensors(*method);
+
+  AsyncMethodExecutor executor(/*num_threads=*/4);
+  std::atomic<int> next{0};
+  std::vector<std::shared_ptr<AsyncExecution>> executions;
+  std::vector<int> order(8, -1);
+  for (int i = 0; i < 8; ++i) {
+    // Later submissions have higher priorities, which must not let them
+    // overtake earlier executions of the same Method.
+    executions.push_back(
+        executor.execute_async(*method, /*priority=*/i, [&, i](Error) {
+          order[i] = next++;
+        }));
+  }
+  for (int i = 0; i < 8; ++i) {
+    EXPECT_EQ(executions[i]->wait(), Error::Ok);
+    EXPECT_EQ(order[i], i);
+  }
+
+  torch::executor::util::FreeInputs(inputs);
+}
+
+TEST_F(AsyncMethodExecutorTest, CancelledExecutionReportsCancelled) {
+  ManagedMemoryManager mmm(kDefaultNonConstMemBytes, kDefaultRuntimeMemBytes);
+  Result<Method> method = program_->load_method("forward", &mmm.get());
+  ASSERT_EQ(method.error(), Error::Ok);
+  auto inputs = torch::executor::util::PrepareInputTensors(*method);
+
+  AsyncMethodExecutor executor;
+  // Submit enough work that the last execution can't have started by the time
+  // it is cancelled.
+  std::vector<std::shared_ptr<AsyncExecution>> executions;
+  for (int i = 0; i < 16; ++i) {
+    executions.push_back(executor.execute_async(*method));
+  }
+  executions.back()->cancel();
+  for (size_t i = 0; i + 1 < executions.size(); ++i) {
+    EXPECT_EQ(executions[i]->wait(), Error::Ok);
+  }
+  EXPECT_EQ(executions.back()->wait(), Error::Cancelled);
+
+  // Cancelling doesn't affect later executions.
+  EXPECT_EQ(executor.execute_async(*method)->wait(), Error::Ok);
+
+  torch::executor::util::FreeInputs(inputs);
+}
+
+TEST_F(AsyncMethodExecutorTest, CancelAfterCompletionHasNoEffect) {
+  ManagedMemoryManager mmm(kDefaultNonConstMemBytes, kDefaultRuntimeMemBytes);
+  Result<Method> method = program_->load_method("forward", &mmm.get());
+  ASSERT_EQ(method.error(), Error::Ok);
+  auto inputs = torch::executor::util::PrepareInputTensors(*method);
+
+  AsyncMethodExecutor executor;
+  std::shared_ptr<AsyncExecution> execution = executor.execute_async(*method);
+  ASSERT_EQ(execution->wait(), Error::Ok);
+  execution->cancel();
+  EXPECT_EQ(execution->wait(), Error::Ok);
+
+  torch::executor::util::FreeInputs(inputs);
+}
@@ -0,0 +1,281 @@
+/*
+ * Copyright (c) Meta Platforms, Inc. and affiliates.
+ * All rights reserved.
+ *
+ * This source code is licensed under the BSD-style license found in the
+ * LICENSE file in the root directory of this source tree.
+ */
+
+#include <executorch/extension/data_loader/compressed_data_loader.h>
+
+#include <algorithm>
+#include <cinttypes>
+#include <cstdlib>
+#include <cstring>
+
+#include <executorch/runtime/platform/log.h>
+#include <executorch/schema/extended_header.h>
+#include <executorch/schema/program_generated.h>
+
+namespace torch {
+namespace executor {
+namespace util {
+
+namespace {
+
+/// LZ4 block format: matches are at least this long.
+constexpr size_t kMinMatch = 4;
+
+/**
+ * Reads an LZ4 extended length (a run of 255s terminated by a smaller byte)
+ * and adds it to `*length`. Returns false if the input ends first.
+ */
+bool read_length(const uint8_t** src, const uint8_t* src_end, size_t* length) {
+  uint8_t b;
+  do {
+    if (*src >= src_end) {
+      return false;
+    }
+    b = *(*src)++;
+    *length += b;
+  } while (b == 255);
+  return true;
+}
+
+/**
+ * FreeableBuffer::FreeFn-compatible callback for buffers from malloc().
+ */
+void free_decompressed(
+    __ET_UNUSED void* context,
+    void* data,
+    __ET_UNUSED size_t size) {
+  std::free(data);
+}
+
+} // namespace
+
+/* static */ Result<CompressedDataLoader> CompressedDataLoader::from(
+    DataLoader* loader) {
+  ET_CHECK_OR_RETURN_ERROR(
+      loader != nullptr, InvalidArgument, "Loader must not be null");
+  std::vector<CompressedSegment> segments;
+
+  size_t program_size = 0;
+  size_t segment_base_offset = 0;
+  {
+    Result<FreeableBuffer> header =
+        loader->Load(/*offset=*/0, ExtendedHeader::kNumHeadBytes);
+    if (!header.ok()) {
+      return header.error();
+    }
+    Result<ExtendedHeader> eh =
+        ExtendedHeader::Parse(header->data(), header->size());
+    if (eh.error() == Error::NotFound) {
+      // No header, so there are no segments to decompress.
+      return CompressedDataLoader(loader, std::move(segments));
+    }
+    if (!eh.ok()) {
+      ET_LOG(Error, "Extended header may be corrupt");
+      return eh.error();
+    }
+    program_size = eh->program_size;
+    segment_base_offset = eh->segment_base_offset;
+  }
+
+  Result<FreeableBuffer> program_data =
+      loader->Load(/*offset=*/0, program_size);
+  if (!program_data.ok()) {
+    return program_data.error();
+  }
+  ET_CHECK_OR_RETURN_ERROR(
+      executorch_flatbuffer::ProgramBufferHasIdentifier(program_data->data()),
+      InvalidProgram,
+      "Program identifier '%.4s' != expected '%.4s'",
+      flatbuffers::GetBufferIdentifier(program_data->data()),
+      executorch_flatbuffer::ProgramIdentifier());
+  // The segment table is read before Program::load() gets a chance to verify
+  // the flatbuffer, so verify it here.
+  flatbuffers::Verifier verifier(
+      reinterpret_cast<const uint8_t*>(program_data->data()),
+      program_data->size());
+  ET_CHECK_OR_RETURN_ERROR(
+      executorch_flatbuffer::VerifyProgramBuffer(verifier),
+      InvalidProgram,
+      "Verification failed; data may be truncated or corrupt");
+  const auto* program = executorch_flatbuffer::GetProgram(program_data->data());
+
+  Error err = Error::Ok;
+  if (program->segments() != nullptr) {
+    for (size_t i = 0; i < program->segments()->size(); ++i) {
+      const executorch_flatbuffer::DataSegment* segment =
+          program->segments()->Get(i);
+      if (segment->compression() ==
+          executorch_flatbuffer::SegmentCompression::NONE) {
+        continue;
+      }
+      if (segment->compression() !=
+          executorch_flatbuffer::SegmentCompression::LZ4_BLOCK) {
+        ET_LOG(
+            Error,
+            "Segment %zu has unsupported compression %d",
+            i,
+            static_cast<int>(segment->compression()));
+        err = Error::NotSupported;
+        break;
+      }
+      if (segment->uncompressed_size() > SIZE_MAX) {
+        ET_LOG(
+            Error,
+            "Segment %zu uncompressed size %" PRIu64 " too large",
+            i,
+            segment->uncompressed_size());
+        err = Error::InvalidProgram;
+        break;
+      }
+      segments.push_back(CompressedSegment{
+          segment_base_offset + static_cast<size_t>(segment->offset()),
+          static_cast<size_t>(segment->size()),
+          static_cast<size_t>(segment->uncompressed_size())});
+    }
+  }
+  // Only the segment table was needed.
+  program_data->Free();
+  if (err != Error::Ok) {
+    return err;
+  }
+
+  std::sort(
+      segments.begin(),
+      segments.end(),
+      [](const CompressedSegment& a, const CompressedSegment& b) {
+        return a.offset < b.offset;
+      });
+  return CompressedDataLoader(loader, std::move(segments));
+}
+
+Error CompressedDataLoader::decompress_block(
+    const uint8_t* src,
+    size_t src_size,
+    uint8_t* dst,
+    size_t dst_size) {
+  const uint8_t* src_end = src + src_size;
+  uint8_t* const dst_begin = dst;
+  uint8_t* const dst_end = dst + dst_size;
+  while (src < src_end) {
+    const uint8_t token = *src++;
+
+    size_t literal_length = token >> 4;
+    if (literal_length == 15) {
+      ET_CHECK_OR_RETURN_ERROR(
+          read_length(&src, src_end, &literal_length),
+          InvalidProgram,
+          "Truncated literal length");
+    }
+    ET_CHECK_OR_RETURN_ERROR(
+        literal_length <= static_cast<size_t>(src_end - src) &&
+            literal_length <= static_cast<size_t>(dst_end - dst),
+        InvalidProgram,
+        "Literal run of %zu bytes overflows the block",
+        literal_length);
+    std::memcpy(dst, src, literal_length);
+    src += literal_length;
+    dst += literal_length;
+
+    // The last sequence has no match part.
+    if (src == src_end) {
+      break;
+    }
+
+    ET_CHECK_OR_RETURN_ERROR(
+        src_end - src >= 2, InvalidProgram, "Truncated match offset");
+    const size_t offset = src[0] | (static_cast<size_t>(src[1]) << 8);
+    src += 2;
+    ET_CHECK_OR_RETURN_ERROR(
+        offset != 0 && offset <= static_cast<size_t>(dst - dst_begin),
+        InvalidProgram,
+        "Invalid match offset %zu",
+        offset);
+
+    size_t match_length = token & 0xF;
+    if (match_length == 15) {
+      ET_CHECK_OR_RETURN_ERROR(
+          read_length(&src, src_end, &match_length),
+          InvalidProgram,
+          "Truncated match length");
+    }
+    match_length += kMinMatch;
+    ET_CHECK_OR_RETURN_ERROR(
+        match_length <= static_cast<size_t>(dst_end - dst),
+        InvalidProgram,
+        "Match of %zu bytes overflows the output",
+        match_length);
+
+    const uint8_t* match = dst - offset;
+    if (offset >= match_length) {
+      std::memcpy(dst, match, match_length);
+      dst += match_length;
+    } else {
+      // The match overlaps the bytes it produces, e.g. a run of one repeated
+      // byte, so it has to be copied forward one byte at a time.
+      for (size_t i = 0; i < match_length; ++i) {
+        *dst++ = *match++;
+      }
+    }
+  }
+  ET_CHECK_OR_RETURN_ERROR(
+      dst == dst_end,
+      InvalidProgram,
+      "Block decoded to %zu bytes, expected %zu",
+      static_cast<size_t>(dst - dst_begin),
+      dst_size);
+  return Error::Ok;
+}
+
+Result<FreeableBuffer> CompressedDataLoader::Load(size_t offset, size_t size) {
+  auto it = std::lower_bound(
+      segments_.begin(),
+      segments_.end(),
+      offset,
+      [](const CompressedSegment& segment, size_t value) {
+        return segment.offset < value;
+      });
+  if (it == segments_.end() || it->offset != offset || it->size != size) {
+    // Not a compressed segment.
+    return loader_->Load(offset, size);
+  }
+
+  Result<FreeableBuffer> loaded = loader_->Load(offset, size);
+  if (!loaded.ok()) {
+    return loaded;
+  }
+
+  // malloc(0) may return nullptr; always ask for at least one byte.
+  const size_t uncompressed_size = it->uncompressed_size;
+  void* buffer = std::malloc(uncompressed_size > 0 ? uncompressed_size : 1);
+  if (buffer == nullptr) {
+    ET_LOG(
+        Error,
+        "Decompressing segment at offset %zu: malloc(%zu) failed",
+        offset,
+        uncompressed_size);
+    return Error::MemoryAllocationFailed;
+  }
+
+  Error err = decompress_block(
+      static_cast<const uint8_t*>(loaded->data()),
+      loaded->size(),
+      static_cast<uint8_t*>(buffer),
+      uncompressed_size);
+  // The compressed copy is no longer needed either way.
+  loaded->Free();
+  if (err != Error::Ok) {
+    ET_LOG(Error, "Failed to decompress segment at offset %zu", offset);
+    std::free(buffer);
+    return err;
+  }
+  return FreeableBuffer(buffer, uncompressed_size, free_decompressed);
+}
+
+} // namespace util
+} // namespace executor
+} // namespace torch
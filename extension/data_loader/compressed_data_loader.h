@@ -0,0 +1,98 @@
+/*
+ * Copyright (c) Meta Platforms, Inc. and affiliates.
+ * All rights reserved.
+ *
+ * This source code is licensed under the BSD-style license found in the
+ * LICENSE file in the root directory of this source tree.
+ */
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+#include <executorch/runtime/core/data_loader.h>
+#include <executorch/runtime/core/error.h>
+#include <executorch/runtime/core/result.h>
+
+namespace torch {
+namespace executor {
+namespace util {
+
+/**
+ * A DataLoader that wraps another DataLoader and transparently decompresses
+ * the segments of a program serialized with `compress_segments=True`.
+ *
+ * Which segments are compressed is read from the program's DataSegment table
+ * when the loader is created: a compressed segment is stored as a single raw
+ * LZ4 block, and its entry records the compression and the uncompressed size.
+ * Loads of exactly such a segment are decompressed into a buffer allocated
+ * with `malloc()`. Everything else, including the program flatbuffer itself,
+ * is passed through unchanged regardless of its contents.
+ */
+class CompressedDataLoader : public DataLoader {
+ public:
+  /**
+   * Creates a loader for the program stored in `loader`. Reads the program's
+   * extended header and segment table to find the compressed segments.
+   *
+   * @param[in] loader The loader to read the program from. Must outlive the
+   *     returned instance.
+   *
+   * @returns A new CompressedDataLoader on success.
+   * @retval Error::InvalidProgram The program data is not a valid program.
+   * @retval Error::NotSupported A segment uses an unknown compression.
+   */
+  static Result<CompressedDataLoader> from(DataLoader* loader);
+
+  CompressedDataLoader(CompressedDataLoader&&) = default;
+
+  __ET_NODISCARD Result<FreeableBuffer> Load(size_t offset, size_t size)
+      override;
+
+  /// Returns the size of the underlying (compressed) data source.
+  __ET_NODISCARD Result<size_t> size() const override {
+    return loader_->size();
+  }
+
+  /// Returns the number of compressed segments in the program.
+  size_t num_compressed_segments() const {
+    return segments_.size();
+  }
+
+  /**
+   * Decompresses the raw LZ4 block `src` into exactly `dst_size` bytes at
+   * `dst`.
+   *
+   * @retval Error::Ok The block decoded to exactly `dst_size` bytes.
+   * @retval Error::InvalidProgram The block is malformed or does not decode
+   *     to `dst_size` bytes.
+   */
+  __ET_NODISCARD static Error decompress_block(
+      const uint8_t* src,
+      size_t src_size,
+      uint8_t* dst,
+      size_t dst_size);
+
+ private:
+  /// A compressed segment, located in the underlying data.
+  struct CompressedSegment {
+    size_t offset;
+    size_t size;
+    size_t uncompressed_size;
+  };
+
+  CompressedDataLoader(
+      DataLoader* loader,
+      std::vector<CompressedSegment>&& segments)
+      : loader_(loader), segments_(std::move(segments)) {}
+
+  DataLoader* const loader_;
+  /// Sorted by offset.
+  std::vector<CompressedSegment> segments_;
+};
+
+} // namespace util
+} // namespace executor
+} // namespace torch
@@ -17,6 +17,7 @@ def define_common_targets():
             "//executorch/extension/pybindings/...",
             "//executorch/test/...",
             "//executorch/extension/data_loader/test/...",
+            "//executorch/extension/prefork/...",
             "@EXECUTORCH_CLIENTS",
         ],
         exported_deps = [
@@ -67,3 +68,23 @@ def define_common_targets():
             "//executorch/runtime/core:core",
         ],
     )
+
+    runtime.cxx_library(
+        name = "compressed_data_loader",
+        srcs = ["compressed_data_loader.cpp"],
+        exported_headers = ["compressed_data_loader.h"],
+        visibility = [
+            "//executorch/test/...",
+            "//executorch/extension/pybindings/...",
+            "//executorch/runtime/executor/test/...",
+            "//executorch/extension/data_loader/test/...",
+            "@EXECUTORCH_CLIENTS",
+        ],
+        deps = [
+            "//executorch/schema:extended_header",
+            "//executorch/schema:program",
+        ],
+        exported_deps = [
+            "//executorch/runtime/core:core",
+        ],
+    )
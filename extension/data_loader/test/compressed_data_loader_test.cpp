@@ -0,0 +1,272 @@
+/*
+ * Copyright (c) Meta Platforms, Inc. and affiliates.
+ * All rights reserved.
+ *
+ * This source code is licensed under the BSD-style license found in the
+ * LICENSE file in the root directory of this source tree.
+ */
+
+#include <executorch/extension/data_loader/compressed_data_loader.h>
+
+#include <cstring>
+#include <string>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+#include <executorch/extension/data_loader/buffer_data_loader.h>
+#include <executorch/runtime/core/result.h>
+#include <executorch/runtime/platform/runtime.h>
+#include <executorch/schema/program_generated.h>
+
+using namespace ::testing;
+using executorch_flatbuffer::SegmentCompression;
+using torch::executor::Error;
+using torch::executor::FreeableBuffer;
+using torch::executor::Result;
+using torch::executor::util::BufferDataLoader;
+using torch::executor::util::CompressedDataLoader;
+
+namespace {
+
+// lz4.block.compress(b"ExecuTorch " * 8 + b"0123456789", store_size=False).
+const uint8_t kBlock[] = {
+    // 11 literals, then a 77-byte match at offset 11.
+    0xbf, 'E', 'x', 'e', 'c', 'u', 'T', 'o', 'r', 'c', 'h', ' ', 0x0b, 0x00,
+    0x3a,
+    // Last sequence: 10 literals.
+    0xa0, '0', '1', '2', '3', '4', '5', '6', '7', '8', '9'};
+
+std::string expected_uncompressed() {
+  std::string s;
+  for (int i = 0; i < 8; ++i) {
+    s += "ExecuTorch ";
+  }
+  return s + "0123456789";
+}
+
+constexpr size_t kSegmentAlignment = 16;
+
+size_t align_up(size_t value, size_t alignment) {
+  return (value + alignment - 1) / alignment * alignment;
+}
+
+void put_le(uint8_t* out, uint64_t value, size_t size) {
+  for (size_t i = 0; i < size; ++i) {
+    out[i] = static_cast<uint8_t>(value >> (8 * i));
+  }
+}
+
+struct TestSegment {
+  std::vector<uint8_t> data;
+  SegmentCompression compression;
+  uint64_t uncompressed_size;
+};
+
+/**
+ * A program file laid out the way exir/_serialize/_program.py writes it: a
+ * Program flatbuffer with an extended header, followed by the segments.
+ */
+struct TestProgram {
+  std::vector<uint8_t> file;
+  // Absolute file offset of each segment.
+  std::vector<size_t> segment_offsets;
+};
+
+TestProgram make_program(const std::vector<TestSegment>& segments) {
+  flatbuffers::FlatBufferBuilder builder;
+  std::vector<flatbuffers::Offset<executorch_flatbuffer::DataSegment>> entries;
+  std::vector<size_t> relative_offsets;
+  size_t offset = 0;
+  for (const TestSegment& segment : segments) {
+    relative_offsets.push_back(offset);
+    entries.push_back(executorch_flatbuffer::CreateDataSegment(
+        builder,
+        offset,
+        segment.data.size(),
+        segment.compression,
+        segment.uncompressed_size));
+    offset = align_up(offset + segment.data.size(), kSegmentAlignment);
+  }
+  executorch_flatbuffer::FinishProgramBuffer(
+      builder,
+      executorch_flatbuffer::CreateProgramDirect(
+          builder,
+          /*version=*/0,
+          /*execution_plan=*/nullptr,
+          /*constant_buffer=*/nullptr,
+          /*backend_delegate_data=*/nullptr,
+          &entries));
+  const uint8_t* fb = builder.GetBufferPointer();
+  const size_t fb_size = builder.GetSize();
+
+  // Insert the 24-byte extended header, padded to 32 bytes, after the file
+  // identifier, and shift the root table offset to match.
+  constexpr size_t kPaddedHeaderLength = 32;
+  const size_t program_size = fb_size + kPaddedHeaderLength;
+  const size_t segment_base_offset = align_up(program_size, kSegmentAlignment);
+
+  TestProgram program;
+  program.file.assign(fb, fb + 8);
+  uint32_t root_offset;
+  std::memcpy(&root_offset, fb, sizeof(root_offset));
+  put_le(program.file.data(), root_offset + kPaddedHeaderLength, 4);
+  program.file.resize(8 + kPaddedHeaderLength, 0);
+  uint8_t* header = program.file.data() + 8;
+  std::memcpy(header, "eh00", 4);
+  put_le(header + 4, 24, 4);
+  put_le(header + 8, program_size, 8);
+  put_le(header + 16, segment_base_offset, 8);
+  program.file.insert(program.file.end(), fb + 8, fb + fb_size);
+
+  for (size_t i = 0; i < segments.size(); ++i) {
+    const size_t segment_offset = segment_base_offset + relative_offsets[i];
+    program.file.resize(segment_offset, 0);
+    program.file.insert(
+        program.file.end(), segments[i].data.begin(), segments[i].data.end());
+    program.segment_offsets.push_back(segment_offset);
+  }
+  return program;
+}
+
+std::vector<uint8_t> block() {
+  return std::vector<uint8_t>(kBlock, kBlock + sizeof(kBlock));
+}
+
+} // namespace
+
+class CompressedDataLoaderTest : public ::testing::Test {
+ protected:
+  void SetUp() override {
+    // Since these tests cause ET_LOG to be called, the PAL must be initialized
+    // first.
+    torch::executor::runtime_init();
+  }
+};
+
+TEST_F(CompressedDataLoaderTest, DecompressesOnlyMarkedSegments) {
+  const std::string expected = expected_uncompressed();
+  // The second segment holds the same bytes, but isn't marked as compressed.
+  TestProgram program = make_program({
+      {block(), SegmentCompression::LZ4_BLOCK, expected.size()},
+      {block(), SegmentCompression::NONE, 0},
+  });
+  BufferDataLoader inner(program.file.data(), program.file.size());
+  Result<CompressedDataLoader> loader = CompressedDataLoader::from(&inner);
+  ASSERT_EQ(loader.error(), Error::Ok);
+  EXPECT_EQ(loader->num_compressed_segments(), 1);
+
+  // size() reports the size of the underlying data.
+  Result<size_t> size = loader->size();
+  ASSERT_TRUE(size.ok());
+  EXPECT_EQ(*size, program.file.size());
+
+  {
+    Result<FreeableBuffer> fb =
+        loader->Load(program.segment_offsets[0], sizeof(kBlock));
+    ASSERT_TRUE(fb.ok());
+    ASSERT_EQ(fb->size(), expected.size());
+    EXPECT_EQ(0, std::memcmp(fb->data(), expected.data(), expected.size()));
+
+    // The decompressed buffer is owned by the FreeableBuffer.
+    fb->Free();
+    EXPECT_EQ(fb->data(), nullptr);
+  }
+  {
+    Result<FreeableBuffer> fb =
+        loader->Load(program.segment_offsets[1], sizeof(kBlock));
+    ASSERT_TRUE(fb.ok());
+    EXPECT_EQ(fb->size(), sizeof(kBlock));
+    EXPECT_EQ(fb->data(), program.file.data() + program.segment_offsets[1]);
+  }
+}
+
+TEST_F(CompressedDataLoaderTest, PassesThroughOtherLoads) {
+  TestProgram program = make_program({
+      {block(), SegmentCompression::LZ4_BLOCK, expected_uncompressed().size()},
+  });
+  BufferDataLoader inner(program.file.data(), program.file.size());
+  Result<CompressedDataLoader> loader = CompressedDataLoader::from(&inner);
+  ASSERT_EQ(loader.error(), Error::Ok);
+
+  // A partial load does not contain the whole compressed segment, so it must
+  // not be treated as one.
+  const size_t offset = program.segment_offsets[0];
+  {
+    Result<FreeableBuffer> fb = loader->Load(offset, sizeof(kBlock) - 1);
+    ASSERT_TRUE(fb.ok());
+    EXPECT_EQ(fb->size(), sizeof(kBlock) - 1);
+    EXPECT_EQ(fb->data(), program.file.data() + offset);
+  }
+  {
+    Result<FreeableBuffer> fb = loader->Load(0, 8);
+    ASSERT_TRUE(fb.ok());
+    EXPECT_EQ(fb->size(), 8);
+    EXPECT_EQ(fb->data(), program.file.data());
+  }
+
+  // Out of bounds loads fail in the wrapped loader.
+  EXPECT_EQ(
+      loader->Load(program.file.size(), 1).error(), Error::InvalidArgument);
+}
+
+TEST_F(CompressedDataLoaderTest, ProgramWithoutHeaderHasNoCompressedSegments) {
+  std::vector<uint8_t> data(128, 0);
+  BufferDataLoader inner(data.data(), data.size());
+  Result<CompressedDataLoader> loader = CompressedDataLoader::from(&inner);
+  ASSERT_EQ(loader.error(), Error::Ok);
+  EXPECT_EQ(loader->num_compressed_segments(), 0);
+}
+
+TEST_F(CompressedDataLoaderTest, UnknownCompressionFails) {
+  TestProgram program = make_program({
+      {block(), static_cast<SegmentCompression>(7), 98},
+  });
+  BufferDataLoader inner(program.file.data(), program.file.size());
+  EXPECT_EQ(
+      CompressedDataLoader::from(&inner).error(), Error::NotSupported);
+}
+
+TEST_F(CompressedDataLoaderTest, CorruptProgramFails) {
+  TestProgram program = make_program({
+      {block(), SegmentCompression::LZ4_BLOCK, expected_uncompressed().size()},
+  });
+  // Point the root table past the end of the program.
+  put_le(program.file.data(), program.file.size(), 4);
+  BufferDataLoader inner(program.file.data(), program.file.size());
+  EXPECT_EQ(
+      CompressedDataLoader::from(&inner).error(), Error::InvalidProgram);
+}
+
+TEST_F(CompressedDataLoaderTest, CorruptBlockFails) {
+  std::vector<uint8_t> corrupt = block();
+  // Point the match before the start of the output.
+  corrupt[12] = 0x20;
+  TestProgram program = make_program({
+      {corrupt, SegmentCompression::LZ4_BLOCK, expected_uncompressed().size()},
+  });
+  BufferDataLoader inner(program.file.data(), program.file.size());
+  Result<CompressedDataLoader> loader = CompressedDataLoader::from(&inner);
+  ASSERT_EQ(loader.error(), Error::Ok);
+
+  Result<FreeableBuffer> fb =
+      loader->Load(program.segment_offsets[0], corrupt.size());
+  EXPECT_EQ(fb.error(), Error::InvalidProgram);
+}
+
+TEST_F(CompressedDataLoaderTest, WrongUncompressedSizeFails) {
+  const uint8_t block[] = {0x40, 'a', 'b', 'c', 'd'};
+  uint8_t out[8];
+
+  EXPECT_EQ(
+      CompressedDataLoader::decompress_block(block, sizeof(block), out, 4),
+      Error::Ok);
+  EXPECT_EQ(0, std::memcmp(out, "abcd", 4));
+
+  EXPECT_EQ(
+      CompressedDataLoader::decompress_block(block, sizeof(block), out, 8),
+      Error::InvalidProgram);
+  EXPECT_EQ(
+      CompressedDataLoader::decompress_block(block, sizeof(block), out, 3),
+      Error::InvalidProgram);
+}
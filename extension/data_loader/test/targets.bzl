@@ -48,3 +48,15 @@ def define_common_targets():
             "//executorch/extension/data_loader:mmap_data_loader",
         ],
     )
+
+    runtime.cxx_test(
+        name = "compressed_data_loader_test",
+        srcs = [
+            "compressed_data_loader_test.cpp",
+        ],
+        deps = [
+            "//executorch/extension/data_loader:buffer_data_loader",
+            "//executorch/extension/data_loader:compressed_data_loader",
+            "//executorch/schema:program",
+        ],
+    )
@@ -0,0 +1,112 @@
+/*
+ * Copyright (c) Meta Platforms, Inc. and affiliates.
+ * All rights reserved.
+ *
+ * This source code is licensed under the BSD-style license found in the
+ * LICENSE file in the root directory of this source tree.
+ */
+
+#include <executorch/extension/memory_allocator/mmap_memory_allocator.h>
+
+#include <cerrno>
+#include <cinttypes>
+#include <cstring>
+#include <limits>
+
+#include <sys/mman.h>
+#include <unistd.h>
+
+#include <executorch/runtime/platform/log.h>
+
+namespace torch {
+namespace executor {
+namespace util {
+
+Result<MmapMemoryAllocator> MmapMemoryAllocator::from(uint32_t size) {
+  long page_size = sysconf(_SC_PAGESIZE);
+  if (page_size < 0) {
+    ET_LOG(Error, "Could not get page size: %s (%d)", strerror(errno), errno);
+    return Error::AccessFailed;
+  }
+  if ((page_size & ~(page_size - 1)) != page_size) {
+    ET_LOG(Error, "Page size 0x%ld is not a power of 2", page_size);
+    return Error::InvalidState;
+  }
+
+  // mmap() rejects empty mappings, so always map at least one page.
+  size_t mapping_size = size == 0 ? page_size : size;
+  mapping_size = (mapping_size + page_size - 1) & ~(page_size - 1);
+  ET_CHECK_OR_RETURN_ERROR(
+      mapping_size <= std::numeric_limits<uint32_t>::max(),
+      InvalidArgument,
+      "Size %" PRIu32 " does not fit in a MemoryAllocator once page-aligned",
+      size);
+
+  void* mapping = ::mmap(
+      nullptr,
+      mapping_size,
+      PROT_READ | PROT_WRITE,
+      MAP_PRIVATE | MAP_ANONYMOUS,
+      /*fd=*/-1,
+      /*offset=*/0);
+  if (mapping == MAP_FAILED) {
+    ET_LOG(
+        Error,
+        "Failed to map %zu bytes: %s (%d)",
+        mapping_size,
+        ::strerror(errno),
+        errno);
+    return Error::MemoryAllocationFailed;
+  }
+
+  return MmapMemoryAllocator(
+      static_cast<uint32_t>(mapping_size),
+      static_cast<uint8_t*>(mapping),
+      mapping_size);
+}
+
+MmapMemoryAllocator::~MmapMemoryAllocator() {
+  if (mapping_size_ > 0) {
+    ::munmap(base_address(), mapping_size_);
+  }
+}
+
+void* MmapMemoryAllocator::allocate(size_t size, size_t alignment) {
+  if (sealed_) {
+    ET_LOG(Error, "Cannot allocate %zu bytes after sealing", size);
+    return nullptr;
+  }
+  return MemoryAllocator::allocate(size, alignment);
+}
+
+void MmapMemoryAllocator::reset() {
+  if (sealed_) {
+    // Everything that was allocated must stay valid, and the memory could
+    // not be written again anyway.
+    return;
+  }
+  MemoryAllocator::reset();
+}
+
+Error MmapMemoryAllocator::seal() {
+  if (sealed_) {
+    return Error::Ok;
+  }
+  ET_CHECK_OR_RETURN_ERROR(
+      mapping_size_ > 0, InvalidState, "Allocator was moved from");
+  if (::mprotect(base_address(), mapping_size_, PROT_READ) != 0) {
+    ET_LOG(
+        Error,
+        "Failed to make %zu bytes read-only: %s (%d)",
+        mapping_size_,
+        ::strerror(errno),
+        errno);
+    return Error::AccessFailed;
+  }
+  sealed_ = true;
+  return Error::Ok;
+}
+
+} // namespace util
+} // namespace executor
+} // namespace torch
@@ -0,0 +1,96 @@
+/*
+ * Copyright (c) Meta Platforms, Inc. and affiliates.
+ * All rights reserved.
+ *
+ * This source code is licensed under the BSD-style license found in the
+ * LICENSE file in the root directory of this source tree.
+ */
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+
+#include <executorch/runtime/core/error.h>
+#include <executorch/runtime/core/memory_allocator.h>
+#include <executorch/runtime/core/result.h>
+
+namespace torch {
+namespace executor {
+namespace util {
+
+/**
+ * Allocates from a dedicated anonymous memory mapping that can be sealed
+ * read-only once it is filled.
+ *
+ * Meant for state that is written once at load time and only read afterwards,
+ * like program data, by processes that fork workers after loading: since
+ * nothing else lives in the mapping, and nothing can write to it after
+ * seal(), its pages stay shared between all processes instead of each child
+ * faulting in a private copy.
+ *
+ * Only available on POSIX systems.
+ */
+class MmapMemoryAllocator : public MemoryAllocator {
+ public:
+  /**
+   * Maps `size` bytes, rounded up to a multiple of the page size. Pages are
+   * only backed by memory once they are written.
+   *
+   * @param[in] size The number of bytes that the allocator can hand out.
+   *
+   * @returns A new MmapMemoryAllocator on success.
+   */
+  __ET_NODISCARD static Result<MmapMemoryAllocator> from(uint32_t size);
+
+  MmapMemoryAllocator(MmapMemoryAllocator&& rhs) noexcept
+      : MemoryAllocator(rhs),
+        mapping_size_(rhs.mapping_size_),
+        sealed_(rhs.sealed_) {
+    rhs.mapping_size_ = 0;
+  }
+
+  MmapMemoryAllocator(const MmapMemoryAllocator&) = delete;
+  MmapMemoryAllocator& operator=(const MmapMemoryAllocator&) = delete;
+  MmapMemoryAllocator& operator=(MmapMemoryAllocator&&) = delete;
+
+  ~MmapMemoryAllocator() override;
+
+  /**
+   * Allocates like MemoryAllocator::allocate().
+   *
+   * @retval nullptr If the allocator was sealed, in addition to the reasons
+   *     of MemoryAllocator::allocate().
+   */
+  void* allocate(size_t size, size_t alignment = kDefaultAlignment) override;
+
+  /// Does nothing once the allocator is sealed.
+  void reset() override;
+
+  /**
+   * Makes the whole mapping read-only. Allocation fails afterwards, and
+   * writing to memory that was allocated from it crashes the process.
+   * Sealing twice is a no-op.
+   *
+   * @retval Error::AccessFailed if the protection could not be changed.
+   */
+  __ET_NODISCARD Error seal();
+
+  /// Returns true once seal() has succeeded.
+  bool is_sealed() const {
+    return sealed_;
+  }
+
+ private:
+  MmapMemoryAllocator(uint32_t size, uint8_t* base_address, size_t mapping_size)
+      : MemoryAllocator(size, base_address), mapping_size_(mapping_size) {}
+
+  /// The size of the mapping at base_address(), or 0 if this instance was
+  /// moved from.
+  size_t mapping_size_;
+  bool sealed_ = false;
+};
+
+} // namespace util
+} // namespace executor
+} // namespace torch
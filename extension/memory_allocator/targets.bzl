@@ -20,3 +20,25 @@ def define_common_targets():
             "@EXECUTORCH_CLIENTS",
         ],
     )
+
+    runtime.cxx_library(
+        name = "mmap_memory_allocator",
+        srcs = [
+            "mmap_memory_allocator.cpp",
+        ],
+        exported_headers = [
+            "mmap_memory_allocator.h",
+        ],
+        exported_deps = [
+            "//executorch/runtime/core:core",
+            "//executorch/runtime/core:memory_allocator",
+        ],
+        deps = [
+            "//executorch/runtime/platform:platform",
+        ],
+        visibility = [
+            "//executorch/extension/memory_allocator/test/...",
+            "//executorch/extension/prefork/...",
+            "@EXECUTORCH_CLIENTS",
+        ],
+    )
@@ -0,0 +1,118 @@
+/*
+ * Copyright (c) Meta Platforms, Inc. and affiliates.
+ * All rights reserved.
+ *
+ * This source code is licensed under the BSD-style license found in the
+ * LICENSE file in the root directory of this source tree.
+ */
+
+#include <executorch/extension/memory_allocator/mmap_memory_allocator.h>
+#include <executorch/runtime/platform/runtime.h>
+
+#include <cstring>
+#include <memory>
+
+#include <gtest/gtest.h>
+#include <unistd.h>
+
+using namespace ::testing;
+using torch::executor::Error;
+using torch::executor::Result;
+using torch::executor::util::MmapMemoryAllocator;
+
+class MmapMemoryAllocatorTest : public ::testing::Test {
+ protected:
+  void SetUp() override {
+    // Since these tests cause ET_LOG to be called, the PAL must be initialized
+    // first.
+    torch::executor::runtime_init();
+
+    page_size_ = sysconf(_SC_PAGESIZE);
+  }
+
+  size_t page_size_;
+};
+
+TEST_F(MmapMemoryAllocatorTest, SizeIsRoundedUpToPages) {
+  Result<MmapMemoryAllocator> allocator = MmapMemoryAllocator::from(1);
+  ASSERT_EQ(allocator.error(), Error::Ok);
+  EXPECT_EQ(allocator->size(), page_size_);
+  EXPECT_EQ(
+      reinterpret_cast<uintptr_t>(allocator->base_address()) % page_size_, 0);
+
+  Result<MmapMemoryAllocator> larger =
+      MmapMemoryAllocator::from(page_size_ + 1);
+  ASSERT_EQ(larger.error(), Error::Ok);
+  EXPECT_EQ(larger->size(), 2 * page_size_);
+
+  Result<MmapMemoryAllocator> empty = MmapMemoryAllocator::from(0);
+  ASSERT_EQ(empty.error(), Error::Ok);
+  EXPECT_EQ(empty->size(), page_size_);
+}
+
+TEST_F(MmapMemoryAllocatorTest, AllocatesUntilFull) {
+  Result<MmapMemoryAllocator> allocator = MmapMemoryAllocator::from(page_size_);
+  ASSERT_EQ(allocator.error(), Error::Ok);
+
+  void* p = allocator->allocate(page_size_ / 2);
+  ASSERT_NE(p, nullptr);
+  EXPECT_EQ(p, allocator->base_address());
+  std::memset(p, 0x55, page_size_ / 2);
+
+  void* p2 = allocator->allocate(page_size_ / 2);
+  ASSERT_NE(p2, nullptr);
+  EXPECT_NE(p2, p);
+  EXPECT_EQ(allocator->allocate(1), nullptr);
+
+  allocator->reset();
+  EXPECT_EQ(allocator->allocate(1), allocator->base_address());
+}
+
+TEST_F(MmapMemoryAllocatorTest, SealingStopsAllocation) {
+  Result<MmapMemoryAllocator> allocator = MmapMemoryAllocator::from(page_size_);
+  ASSERT_EQ(allocator.error(), Error::Ok);
+  auto p = static_cast<uint8_t*>(allocator->allocate(16));
+  ASSERT_NE(p, nullptr);
+  p[0] = 42;
+
+  EXPECT_FALSE(allocator->is_sealed());
+  ASSERT_EQ(allocator->seal(), Error::Ok);
+  EXPECT_TRUE(allocator->is_sealed());
+  EXPECT_EQ(allocator->seal(), Error::Ok);
+
+  // Earlier allocations stay readable, and reset() doesn't hand them out
+  // again.
+  EXPECT_EQ(p[0], 42);
+  EXPECT_EQ(allocator->allocate(16), nullptr);
+  allocator->reset();
+  EXPECT_EQ(allocator->allocate(16), nullptr);
+}
+
+TEST_F(MmapMemoryAllocatorTest, WritingAfterSealingCrashes) {
+  Result<MmapMemoryAllocator> allocator = MmapMemoryAllocator::from(page_size_);
+  ASSERT_EQ(allocator.error(), Error::Ok);
+  auto p = static_cast<volatile uint8_t*>(allocator->allocate(16));
+  ASSERT_NE(p, nullptr);
+  ASSERT_EQ(allocator->seal(), Error::Ok);
+
+  EXPECT_DEATH({ p[0] = 1; }, "");
+}
+
+TEST_F(MmapMemoryAllocatorTest, MovingKeepsTheMapping) {
+  std::unique_ptr<MmapMemoryAllocator> moved;
+  uint8_t* p = nullptr;
+  {
+    Result<MmapMemoryAllocator> allocator =
+        MmapMemoryAllocator::from(page_size_);
+    ASSERT_EQ(allocator.error(), Error::Ok);
+    p = static_cast<uint8_t*>(allocator->allocate(16));
+    ASSERT_NE(p, nullptr);
+    p[0] = 42;
+    moved = std::make_unique<MmapMemoryAllocator>(std::move(allocator.get()));
+  }
+
+  // Destroying the moved-from allocator left the memory mapped.
+  EXPECT_EQ(moved->base_address(), p);
+  EXPECT_EQ(p[0], 42);
+  EXPECT_EQ(moved->seal(), Error::Ok);
+}
@@ -0,0 +1,199 @@
+/*
+ * Copyright (c) Meta Platforms, Inc. and affiliates.
+ * All rights reserved.
+ *
+ * This source code is licensed under the BSD-style license found in the
+ * LICENSE file in the root directory of this source tree.
+ */
+
+#include <executorch/extension/pipeline/method_pipeline.h>
+
+#include <algorithm>
+#include <cinttypes>
+
+#include <executorch/runtime/platform/assert.h>
+#include <executorch/runtime/platform/log.h>
+
+namespace torch {
+namespace executor {
+namespace util {
+
+namespace {
+
+int64_t to_us(std::chrono::steady_clock::duration duration) {
+  return std::chrono::duration_cast<std::chrono::microseconds>(duration)
+      .count();
+}
+
+} // namespace
+
+MethodPipeline::MethodPipeline(Span<Method*> replicas) {
+  ET_CHECK_MSG(replicas.size() > 0, "MethodPipeline needs a replica");
+  slots_.reserve(replicas.size());
+  for (size_t i = 0; i < replicas.size(); ++i) {
+    slots_.push_back(Slot{replicas[i], nullptr, {}});
+    // Hand out the first replica first.
+    free_slots_.push_back(replicas.size() - 1 - i);
+  }
+  stages_.resize(replicas[0]->experimental_num_stages());
+  threads_.reserve(stages_.size());
+  for (size_t i = 0; i < stages_.size(); ++i) {
+    threads_.emplace_back([this, i]() { stage_loop(i); });
+  }
+}
+
+MethodPipeline::~MethodPipeline() {
+  flush();
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    stopping_ = true;
+  }
+  cv_.notify_all();
+  for (std::thread& thread : threads_) {
+    thread.join();
+  }
+}
+
+Error MethodPipeline::submit(SetInputs set_inputs, OnOutputs on_outputs) {
+  size_t slot_idx;
+  {
+    std::unique_lock<std::mutex> lock(mutex_);
+    cv_.wait(lock, [&]() { return !free_slots_.empty(); });
+    slot_idx = free_slots_.back();
+    free_slots_.pop_back();
+  }
+
+  // The replica is ours until it is queued, so the inputs are set without
+  // holding the lock while the stages keep running.
+  Slot& slot = slots_[slot_idx];
+  Error err = set_inputs(*slot.method);
+  if (err != Error::Ok) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    free_slots_.push_back(slot_idx);
+    return err;
+  }
+  slot.on_outputs = std::move(on_outputs);
+  slot.status = Error::Ok;
+  slot.finished = false;
+
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    slot.start = Clock::now();
+    if (num_frames_ == 0 && num_in_flight_ == 0) {
+      first_start_ = slot.start;
+    }
+    num_in_flight_++;
+    stages_[0].queue.push_back(slot_idx);
+  }
+  cv_.notify_all();
+  return Error::Ok;
+}
+
+void MethodPipeline::flush() {
+  std::unique_lock<std::mutex> lock(mutex_);
+  cv_.wait(lock, [&]() { return num_in_flight_ == 0; });
+}
+
+void MethodPipeline::stage_loop(size_t stage_idx) {
+  Stage& stage = stages_[stage_idx];
+  const bool is_last_stage = stage_idx + 1 == stages_.size();
+  std::unique_lock<std::mutex> lock(mutex_);
+  while (true) {
+    cv_.wait(lock, [&]() { return stopping_ || !stage.queue.empty(); });
+    if (stage.queue.empty()) {
+      return;
+    }
+    const size_t slot_idx = stage.queue.front();
+    stage.queue.pop_front();
+    lock.unlock();
+
+    Slot& slot = slots_[slot_idx];
+    const Clock::time_point start = Clock::now();
+    // The last stage also runs any stages that a loop in the Method added.
+    while (!slot.finished) {
+      Error err = slot.method->experimental_step_stage();
+      if (err == Error::EndOfMethod) {
+        slot.finished = true;
+      } else if (err != Error::Ok) {
+        ET_LOG(
+            Error,
+            "Pipeline stage %zu failed: 0x%" PRIx32,
+            stage_idx,
+            (uint32_t)err);
+        slot.status = err;
+        slot.finished = true;
+      } else if (!is_last_stage) {
+        break;
+      }
+    }
+    const int64_t busy_us = to_us(Clock::now() - start);
+
+    if (is_last_stage) {
+      complete(slot, slot_idx);
+    }
+
+    lock.lock();
+    stage.busy_us += busy_us;
+    if (is_last_stage) {
+      const Clock::time_point end = Clock::now();
+      const int64_t latency_us = to_us(end - slot.start);
+      num_frames_++;
+      last_end_ = end;
+      total_latency_us_ += latency_us;
+      max_latency_us_ = std::max(max_latency_us_, latency_us);
+      num_in_flight_--;
+      free_slots_.push_back(slot_idx);
+    } else {
+      stages_[stage_idx + 1].queue.push_back(slot_idx);
+    }
+    cv_.notify_all();
+  }
+}
+
+void MethodPipeline::complete(Slot& slot, size_t slot_idx) {
+  Method& method = *slot.method;
+  if (slot.status == Error::Ok) {
+    // Reached EndOfMethod; rewind for the next frame. This can't fail.
+    Error err = method.experimental_reset_execution();
+    ET_CHECK_MSG(
+        err == Error::Ok,
+        "Failed to reset replica %zu: 0x%" PRIx32,
+        slot_idx,
+        (uint32_t)err);
+  } else {
+    // Failed mid-execution.
+    Error err = method.experimental_cancel_execution();
+    (void)err;
+  }
+  if (slot.on_outputs) {
+    slot.on_outputs(slot.status, method);
+    slot.on_outputs = nullptr;
+  }
+}
+
+MethodPipelineStats MethodPipeline::stats() const {
+  std::lock_guard<std::mutex> lock(mutex_);
+  MethodPipelineStats stats;
+  stats.num_frames = num_frames_;
+  stats.wall_us = num_frames_ == 0 ? 0 : to_us(last_end_ - first_start_);
+  stats.total_latency_us = total_latency_us_;
+  stats.max_latency_us = max_latency_us_;
+  for (const Stage& stage : stages_) {
+    stats.stage_busy_us.push_back(stage.busy_us);
+  }
+  return stats;
+}
+
+void MethodPipeline::reset_stats() {
+  std::lock_guard<std::mutex> lock(mutex_);
+  num_frames_ = 0;
+  total_latency_us_ = 0;
+  max_latency_us_ = 0;
+  for (Stage& stage : stages_) {
+    stage.busy_us = 0;
+  }
+}
+
+} // namespace util
+} // namespace executor
+} // namespace torch
@@ -0,0 +1,158 @@
+/*
+ * Copyright (c) Meta Platforms, Inc. and affiliates.
+ * All rights reserved.
+ *
+ * This source code is licensed under the BSD-style license found in the
+ * LICENSE file in the root directory of this source tree.
+ */
+
+#pragma once
+
+#include <chrono>
+#include <condition_variable>
+#include <cstdint>
+#include <deque>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+#include <executorch/runtime/core/error.h>
+#include <executorch/runtime/core/span.h>
+#include <executorch/runtime/executor/method.h>
+
+namespace torch {
+namespace executor {
+namespace util {
+
+/**
+ * Timing collected by a MethodPipeline since it was created or since the last
+ * call to `MethodPipeline::reset_stats()`.
+ */
+struct MethodPipelineStats {
+  /// Number of frames that completed, successfully or not.
+  size_t num_frames = 0;
+  /// Time from the first submission to the last completion, in microseconds.
+  int64_t wall_us = 0;
+  /// Sum and maximum of the per-frame latencies, from the moment a frame's
+  /// inputs were set to the moment its outputs were delivered.
+  int64_t total_latency_us = 0;
+  int64_t max_latency_us = 0;
+  /// Time each stage spent executing instructions, in microseconds.
+  std::vector<int64_t> stage_busy_us;
+};
+
+/**
+ * Streams successive inputs of a Method through its stages concurrently.
+ *
+ * The Method is split into the stages reported by
+ * `Method::experimental_num_stages()`, which break at delegate calls, and each
+ * stage gets its own thread. While one frame runs a delegate, the previous
+ * frame can run the portable ops that follow it, so a delegate's threadpool
+ * doesn't sit idle while portable ops run.
+ *
+ * Frames in flight can't share intermediate tensors, so the pipeline is given
+ * several replicas of the same Method, each loaded with its own
+ * MemoryManager. Each frame runs all of its stages on one replica, so the
+ * number of replicas is the number of frames in flight: two replicas
+ * double-buffer every intermediate tensor, and a number of replicas equal to
+ * the number of stages keeps every stage busy.
+ *
+ * Frames complete in the order they were submitted. This trades per-frame
+ * latency, which grows with the time spent waiting between stages, for
+ * throughput; see MethodPipelineStats.
+ */
+class MethodPipeline final {
+ public:
+  /// Sets the inputs of the replica that will run the frame. Called on the
+  /// thread that submits the frame.
+  using SetInputs = std::function<Error(Method&)>;
+  /// Receives the status of a frame and the replica that ran it, so that its
+  /// outputs can be read. Called on a pipeline thread, in submission order;
+  /// the replica is not reused until it returns.
+  using OnOutputs = std::function<void(Error, Method&)>;
+
+  /**
+   * @param[in] replicas Initialized instances of the same Method, each with
+   *     its own memory-planned buffers. Must outlive the pipeline.
+   */
+  explicit MethodPipeline(Span<Method*> replicas);
+
+  /// Waits for all submitted frames to complete.
+  ~MethodPipeline();
+
+  MethodPipeline(const MethodPipeline&) = delete;
+  MethodPipeline& operator=(const MethodPipeline&) = delete;
+  MethodPipeline(MethodPipeline&&) = delete;
+  MethodPipeline& operator=(MethodPipeline&&) = delete;
+
+  /// Returns the number of stages, which is also the number of threads.
+  size_t num_stages() const {
+    return stages_.size();
+  }
+
+  /**
+   * Submits a frame. Blocks until a replica is free, then calls `set_inputs`
+   * on it and queues the frame on the first stage.
+   *
+   * @returns Error::Ok if the frame was queued. Otherwise the error returned
+   *     by `set_inputs`, in which case `on_outputs` is not called.
+   */
+  __ET_NODISCARD Error submit(SetInputs set_inputs, OnOutputs on_outputs);
+
+  /// Blocks until all submitted frames completed.
+  void flush();
+
+  /// Returns the timing collected so far.
+  MethodPipelineStats stats() const;
+
+  /// Clears the timing collected so far. Call between flush() and the next
+  /// submit().
+  void reset_stats();
+
+ private:
+  using Clock = std::chrono::steady_clock;
+
+  // A replica and the frame it is running, if any.
+  struct Slot {
+    Method* method;
+    OnOutputs on_outputs;
+    Clock::time_point start;
+    Error status = Error::Ok;
+    // Set once the frame reached the end of the Method or failed; later
+    // stages only pass it along so that frames complete in order.
+    bool finished = false;
+  };
+
+  struct Stage {
+    // Indices of slots waiting for this stage, in submission order.
+    std::deque<size_t> queue;
+    int64_t busy_us = 0;
+  };
+
+  void stage_loop(size_t stage_idx);
+
+  // Finishes the frame in `slot` and makes the replica available.
+  void complete(Slot& slot, size_t slot_idx);
+
+  std::vector<Slot> slots_;
+  std::vector<Stage> stages_;
+
+  mutable std::mutex mutex_;
+  std::condition_variable cv_;
+  std::vector<size_t> free_slots_;
+  size_t num_in_flight_ = 0;
+  bool stopping_ = false;
+
+  size_t num_frames_ = 0;
+  Clock::time_point first_start_;
+  Clock::time_point last_end_;
+  int64_t total_latency_us_ = 0;
+  int64_t max_latency_us_ = 0;
+
+  std::vector<std::thread> threads_;
+};
+
+} // namespace util
+} // namespace executor
+} // namespace torch
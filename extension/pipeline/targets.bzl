@@ -0,0 +1,29 @@
+load("@fbsource//xplat/executorch/build:runtime_wrapper.bzl", "runtime")
+
+def define_common_targets():
+    """Defines targets that should be shared between fbcode and xplat.
+
+    The directory containing this targets.bzl file should also contain both
+    TARGETS and BUCK files that call this function.
+    """
+
+    for aten_mode in (True, False):
+        aten_suffix = ("_aten" if aten_mode else "")
+
+        runtime.cxx_library(
+            name = "method_pipeline" + aten_suffix,
+            srcs = ["method_pipeline.cpp"],
+            exported_headers = ["method_pipeline.h"],
+            visibility = [
+                "//executorch/examples/...",
+                "//executorch/extension/pipeline/test/...",
+                "@EXECUTORCH_CLIENTS",
+            ],
+            exported_deps = [
+                "//executorch/runtime/core:core",
+                "//executorch/runtime/executor:program" + aten_suffix,
+            ],
+            deps = [
+                "//executorch/runtime/platform:platform",
+            ],
+        )
@@ -0,0 +1,154 @@
+/*
+ * Copyright (c) Meta Platforms, Inc. and affiliates.
+ * All rights reserved.
+ *
+ * This source code is licensed under the BSD-style license found in the
+ * LICENSE file in the root directory of this source tree.
+ */
+
+#include <cstdlib>
+#include <memory>
+#include <vector>
+
+#include <executorch/extension/data_loader/file_data_loader.h>
+#include <executorch/extension/pipeline/method_pipeline.h>
+#include <executorch/runtime/executor/method.h>
+#include <executorch/runtime/executor/program.h>
+#include <executorch/runtime/executor/test/managed_memory_manager.h>
+#include <executorch/runtime/platform/runtime.h>
+#include <executorch/util/util.h>
+#include <gtest/gtest.h>
+
+using namespace ::testing;
+using torch::executor::Error;
+using torch::executor::EValue;
+using torch::executor::Method;
+using torch::executor::Program;
+using torch::executor::Result;
+using torch::executor::testing::ManagedMemoryManager;
+using torch::executor::util::FileDataLoader;
+using torch::executor::util::MethodPipeline;
+using torch::executor::util::MethodPipelineStats;
+
+constexpr size_t kDefaultNonConstMemBytes = 32 * 1024U;
+constexpr size_t kDefaultRuntimeMemBytes = 32 * 1024U;
+constexpr size_t kNumReplicas = 2;
+
+class MethodPipelineTest : public ::testing::Test {
+ protected:
+  void SetUp() override {
+    torch::executor::runtime_init();
+
+    Result<FileDataLoader> loader =
+        FileDataLoader::from(std::getenv("ET_MODULE_ADD_PATH"));
+    ASSERT_EQ(loader.error(), Error::Ok);
+    loader_ = std::make_unique<FileDataLoader>(std::move(loader.get()));
+
+    Result<Program> program = Program::load(
+        loader_.get(), Program::Verification::InternalConsistency);
+    ASSERT_EQ(program.error(), Error::Ok);
+    program_ = std::make_unique<Program>(std::move(program.get()));
+
+    for (size_t i = 0; i < kNumReplicas; ++i) {
+      mmms_.push_back(std::make_unique<ManagedMemoryManager>(
+          kDefaultNonConstMemBytes, kDefaultRuntimeMemBytes));
+      Result<Method> method =
+          program_->load_method("forward", &mmms_.back()->get());
+      ASSERT_EQ(method.error(), Error::Ok);
+      methods_.push_back(std::make_unique<Method>(std::move(method.get())));
+      inputs_.push_back(
+          torch::executor::util::PrepareInputTensors(*methods_.back()));
+      replicas_.push_back(methods_.back().get());
+    }
+  }
+
+  void TearDown() override {
+    for (auto& inputs : inputs_) {
+      torch::executor::util::FreeInputs(inputs);
+    }
+  }
+
+ private:
+  // Must outlive program_, but tests shouldn't need to touch it.
+  std::unique_ptr<FileDataLoader> loader_;
+
+ protected:
+  std::unique_ptr<Program> program_;
+  std::vector<std::unique_ptr<ManagedMemoryManager>> mmms_;
+  std::vector<std::unique_ptr<Method>> methods_;
+  std::vector<exec_aten::ArrayRef<void*>> inputs_;
+  std::vector<Method*> replicas_;
+};
+
+TEST_F(MethodPipelineTest, StepStage) {
+  Method& method = *methods_[0];
+  // No delegates, so the whole Method is a single stage.
+  EXPECT_EQ(method.experimental_num_stages(), 1);
+
+  ASSERT_EQ(method.experimental_step_stage(), Error::Ok);
+  ASSERT_EQ(method.experimental_step_stage(), Error::EndOfMethod);
+  ASSERT_EQ(method.experimental_reset_execution(), Error::Ok);
+
+  // Stepping by stage leaves the Method in the same state as execute().
+  EXPECT_EQ(method.execute(), Error::Ok);
+}
+
+TEST_F(MethodPipelineTest, FramesCompleteInOrder) {
+  constexpr int kNumFrames = 16;
+  std::vector<int> completed;
+  std::vector<float> results;
+  {
+    MethodPipeline pipeline({replicas_.data(), replicas_.size()});
+    EXPECT_EQ(pipeline.num_stages(), 1);
+    for (int i = 0; i < kNumFrames; ++i) {
+      Error err = pipeline.submit(
+          [i](Method& method) {
+            // Frame i computes (i + 1) + 1. x is memory planned, so
+            // set_input() copies it and it doesn't need to outlive the call.
+            float x_data[4] = {static_cast<float>(i + 1), 1, 1, 1};
+            int32_t sizes[2] = {2, 2};
+            uint8_t dim_order[2] = {0, 1};
+            int32_t strides[2] = {2, 1};
+            torch::executor::TensorImpl x_impl(
+                torch::executor::ScalarType::Float,
+                2,
+                sizes,
+                x_data,
+                dim_order,
+                strides);
+            return method.set_input(
+                EValue(torch::executor::Tensor(&x_impl)), 0);
+          },
+          [&, i](Error status, Method& method) {
+            EXPECT_EQ(status, Error::Ok);
+            completed.push_back(i);
+            results.push_back(
+                method.get_output(0).toTensor().const_data_ptr<float>()[0]);
+          });
+      ASSERT_EQ(err, Error::Ok);
+    }
+    pipeline.flush();
+
+    MethodPipelineStats stats = pipeline.stats();
+    EXPECT_EQ(stats.num_frames, kNumFrames);
+    EXPECT_EQ(stats.stage_busy_us.size(), 1);
+  }
+
+  ASSERT_EQ(completed.size(), kNumFrames);
+  for (int i = 0; i < kNumFrames; ++i) {
+    EXPECT_EQ(completed[i], i);
+    EXPECT_FLOAT_EQ(results[i], static_cast<float>(i + 2));
+  }
+}
+
+TEST_F(MethodPipelineTest, FailedSetInputsIsNotQueued) {
+  MethodPipeline pipeline({replicas_.data(), replicas_.size()});
+  bool called = false;
+  Error err = pipeline.submit(
+      [](Method&) { return Error::InvalidArgument; },
+      [&](Error, Method&) { called = true; });
+  EXPECT_EQ(err, Error::InvalidArgument);
+  pipeline.flush();
+  EXPECT_FALSE(called);
+  EXPECT_EQ(pipeline.stats().num_frames, 0);
+}
@@ -0,0 +1,27 @@
+load("@fbsource//xplat/executorch/build:runtime_wrapper.bzl", "runtime")
+
+def define_common_targets(is_fbcode = False):
+    """Defines targets that should be shared between fbcode and xplat.
+
+    The directory containing this targets.bzl file should also contain both
+    TARGETS and BUCK files that call this function.
+    """
+
+    # The tests load a program file from fbcode, so they only run there.
+    if not runtime.is_oss and is_fbcode:
+        runtime.cxx_test(
+            name = "method_pipeline_test",
+            srcs = [
+                "method_pipeline_test.cpp",
+            ],
+            deps = [
+                "//executorch/extension/pipeline:method_pipeline",
+                "//executorch/extension/data_loader:file_data_loader",
+                "//executorch/kernels/portable:generated_lib",
+                "//executorch/runtime/executor/test:managed_memory_manager",
+                "//executorch/util:util",
+            ],
+            env = {
+                "ET_MODULE_ADD_PATH": "$(location fbcode//executorch/test/models:exported_programs[ModuleAdd.pte])",
+            },
+        )
@@ -0,0 +1,100 @@
+/*
+ * Copyright (c) Meta Platforms, Inc. and affiliates.
+ * All rights reserved.
+ *
+ * This source code is licensed under the BSD-style license found in the
+ * LICENSE file in the root directory of this source tree.
+ */
+
+#include <executorch/extension/prefork/prefork.h>
+
+#include <cinttypes>
+#include <cstdio>
+#include <cstring>
+
+#include <executorch/runtime/backend/interface.h>
+#include <executorch/runtime/platform/log.h>
+
+namespace torch {
+namespace executor {
+namespace util {
+
+Result<BufferDataLoader> copy_to(
+    DataLoader* loader,
+    MemoryAllocator* allocator) {
+  Result<size_t> size = loader->size();
+  if (!size.ok()) {
+    return size.error();
+  }
+  Result<FreeableBuffer> data = loader->Load(/*offset=*/0, size.get());
+  if (!data.ok()) {
+    return data.error();
+  }
+  void* copy = allocator->allocate(size.get());
+  ET_CHECK_OR_RETURN_ERROR(
+      copy != nullptr,
+      MemoryAllocationFailed,
+      "Failed to allocate %zu bytes",
+      size.get());
+  std::memcpy(copy, data->data(), size.get());
+  return BufferDataLoader(copy, size.get());
+}
+
+Error freeze_for_fork(MmapMemoryAllocator* region) {
+  Error err = freeze_backends();
+  if (err != Error::Ok) {
+    ET_LOG(
+        Error,
+        "Freezing backends failed: 0x%" PRIx32,
+        static_cast<uint32_t>(err));
+    return err;
+  }
+  return region->seal();
+}
+
+Result<ProcessMemoryUsage> get_process_memory_usage() {
+#if defined(__linux__)
+  // Sums of the per-mapping fields of /proc/self/smaps.
+  FILE* file = std::fopen("/proc/self/smaps_rollup", "r");
+  if (file == nullptr) {
+    ET_LOG(Error, "Cannot open /proc/self/smaps_rollup");
+    return Error::NotSupported;
+  }
+  ProcessMemoryUsage usage{};
+  size_t shared_clean = 0;
+  size_t shared_dirty = 0;
+  const struct {
+    const char* name;
+    size_t* value;
+  } fields[] = {
+      {"Rss:", &usage.rss},
+      {"Pss:", &usage.pss},
+      {"Shared_Clean:", &shared_clean},
+      {"Shared_Dirty:", &shared_dirty},
+      {"Private_Clean:", &usage.private_clean},
+      {"Private_Dirty:", &usage.private_dirty},
+  };
+  char line[256];
+  while (std::fgets(line, sizeof(line), file) != nullptr) {
+    for (const auto& field : fields) {
+      size_t len = std::strlen(field.name);
+      if (std::strncmp(line, field.name, len) == 0) {
+        unsigned long long kb = 0;
+        if (std::sscanf(line + len, "%llu", &kb) == 1) {
+          *field.value = static_cast<size_t>(kb) * 1024;
+        }
+        break;
+      }
+    }
+  }
+  std::fclose(file);
+  usage.shared = shared_clean + shared_dirty;
+  return usage;
+#else
+  return Error::NotSupported;
+#endif
+}
+
+} // namespace util
+} // namespace executor
+} // namespace torch
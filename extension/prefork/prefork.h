@@ -0,0 +1,96 @@
+/*
+ * Copyright (c) Meta Platforms, Inc. and affiliates.
+ * All rights reserved.
+ *
+ * This source code is licensed under the BSD-style license found in the
+ * LICENSE file in the root directory of this source tree.
+ */
+
+#pragma once
+
+#include <cstddef>
+
+#include <executorch/extension/data_loader/buffer_data_loader.h>
+#include <executorch/extension/memory_allocator/mmap_memory_allocator.h>
+#include <executorch/runtime/core/data_loader.h>
+#include <executorch/runtime/core/error.h>
+#include <executorch/runtime/core/memory_allocator.h>
+#include <executorch/runtime/core/result.h>
+
+/**
+ * Helpers for processes that load their Programs once and then fork workers
+ * that execute them, sharing as much of the loaded state as possible.
+ *
+ * Typical use in the parent process:
+ *   1. Create an MmapMemoryAllocator large enough for all program files.
+ *   2. copy_to() each program file into it, and load each Program from the
+ *      returned loader. Constant tensors then point into the region.
+ *   3. Load every Method that workers will execute, so that delegates are
+ *      initialized.
+ *   4. Call freeze_for_fork() on the region, then fork.
+ *
+ * Each worker then only owns the memory its Methods write to. Threadpools are
+ * recreated lazily in each worker the first time they are needed.
+ */
+
+namespace torch {
+namespace executor {
+namespace util {
+
+/**
+ * Copies all data of `loader` into memory from `allocator`.
+ *
+ * @param[in] loader The source to copy, typically a program file.
+ * @param[in] allocator Where to copy the data to, typically an
+ *     MmapMemoryAllocator that will be passed to freeze_for_fork(). Must
+ *     outlive the returned loader.
+ *
+ * @returns A loader over the copy. Loads from it never copy.
+ */
+__ET_NODISCARD Result<BufferDataLoader> copy_to(
+    DataLoader* loader,
+    MemoryAllocator* allocator);
+
+/**
+ * Makes the state loaded so far shareable by processes forked afterwards:
+ * every registered backend is frozen (see PyTorchBackendInterface::freeze()),
+ * then `region` is sealed read-only.
+ *
+ * Programs and Methods loaded before this call keep working; nothing may be
+ * allocated from `region` afterwards.
+ *
+ * @retval Error::Ok if everything was frozen.
+ */
+__ET_NODISCARD Error freeze_for_fork(MmapMemoryAllocator* region);
+
+/**
+ * Memory usage of the calling process, in bytes.
+ */
+struct ProcessMemoryUsage {
+  /// Resident memory, whether shared or not.
+  size_t rss;
+  /// Resident memory, with each shared page divided among its sharers.
+  size_t pss;
+  /// Resident memory also mapped by other processes.
+  size_t shared;
+  /// Resident memory only mapped by this process. For a forked worker, this
+  /// is what it costs on top of the parent.
+  size_t private_clean;
+  size_t private_dirty;
+
+  size_t private_total() const {
+    return private_clean + private_dirty;
+  }
+};
+
+/**
+ * Returns the memory usage of the calling process.
+ *
+ * @retval Error::NotSupported if the system does not report it; only Linux
+ *     4.14 and later do.
+ */
+__ET_NODISCARD Result<ProcessMemoryUsage> get_process_memory_usage();
+
+} // namespace util
+} // namespace executor
+} // namespace torch
@@ -0,0 +1,27 @@
+load("@fbsource//xplat/executorch/build:runtime_wrapper.bzl", "runtime")
+
+def define_common_targets():
+    """Defines targets that should be shared between fbcode and xplat.
+
+    The directory containing this targets.bzl file should also contain both
+    TARGETS and BUCK files that call this function.
+    """
+
+    runtime.cxx_library(
+        name = "prefork",
+        srcs = ["prefork.cpp"],
+        exported_headers = ["prefork.h"],
+        visibility = [
+            "//executorch/extension/prefork/test/...",
+            "@EXECUTORCH_CLIENTS",
+        ],
+        exported_deps = [
+            "//executorch/extension/data_loader:buffer_data_loader",
+            "//executorch/extension/memory_allocator:mmap_memory_allocator",
+            "//executorch/runtime/core:core",
+        ],
+        deps = [
+            "//executorch/runtime/backend:interface",
+            "//executorch/runtime/platform:platform",
+        ],
+    )
@@ -0,0 +1,171 @@
+/*
+ * Copyright (c) Meta Platforms, Inc. and affiliates.
+ * All rights reserved.
+ *
+ * This source code is licensed under the BSD-style license found in the
+ * LICENSE file in the root directory of this source tree.
+ */
+
+#include <cstdlib>
+#include <cstring>
+#include <memory>
+#include <vector>
+
+#include <sys/wait.h>
+#include <unistd.h>
+
+#include <executorch/extension/data_loader/buffer_data_loader.h>
+#include <executorch/extension/data_loader/file_data_loader.h>
+#include <executorch/extension/memory_allocator/mmap_memory_allocator.h>
+#include <executorch/extension/prefork/prefork.h>
+#include <executorch/runtime/core/hierarchical_allocator.h>
+#include <executorch/runtime/core/memory_allocator.h>
+#include <executorch/runtime/executor/memory_manager.h>
+#include <executorch/runtime/executor/method.h>
+#include <executorch/runtime/executor/program.h>
+#include <executorch/runtime/platform/runtime.h>
+#include <executorch/util/util.h>
+#include <gtest/gtest.h>
+
+using namespace ::testing;
+using torch::executor::Error;
+using torch::executor::FreeableBuffer;
+using torch::executor::HierarchicalAllocator;
+using torch::executor::MemoryAllocator;
+using torch::executor::MemoryManager;
+using torch::executor::Method;
+using torch::executor::MethodMeta;
+using torch::executor::Program;
+using torch::executor::Result;
+using torch::executor::Span;
+using torch::executor::util::BufferDataLoader;
+using torch::executor::util::copy_to;
+using torch::executor::util::FileDataLoader;
+using torch::executor::util::freeze_for_fork;
+using torch::executor::util::get_process_memory_usage;
+using torch::executor::util::MmapMemoryAllocator;
+using torch::executor::util::ProcessMemoryUsage;
+
+namespace {
+
+constexpr size_t kDefaultRuntimeMemBytes = 32 * 1024U;
+
+// Runs `fn` in a forked child, and returns true if it returned true there.
+template <typename Fn>
+bool run_in_child(Fn fn) {
+  pid_t pid = fork();
+  if (pid == 0) {
+    _exit(fn() ? 0 : 1);
+  }
+  int status = 0;
+  return pid > 0 && waitpid(pid, &status, 0) == pid && WIFEXITED(status) &&
+      WEXITSTATUS(status) == 0;
+}
+
+} // namespace
+
+class PreforkTest : public ::testing::Test {
+ protected:
+  void SetUp() override {
+    torch::executor::runtime_init();
+  }
+};
+
+TEST_F(PreforkTest, CopyToCopiesAllData) {
+  const uint8_t data[] = {1, 2, 3, 4, 5, 6, 7, 8};
+  BufferDataLoader source(data, sizeof(data));
+
+  Result<MmapMemoryAllocator> region = MmapMemoryAllocator::from(1024);
+  ASSERT_EQ(region.error(), Error::Ok);
+  Result<BufferDataLoader> copy = copy_to(&source, &region.get());
+  ASSERT_EQ(copy.error(), Error::Ok);
+  ASSERT_EQ(copy->size().get(), sizeof(data));
+
+  // Loads come straight from the region.
+  Result<FreeableBuffer> buffer = copy->Load(0, sizeof(data));
+  ASSERT_EQ(buffer.error(), Error::Ok);
+  EXPECT_EQ(buffer->data(), region->base_address());
+  EXPECT_EQ(std::memcmp(buffer->data(), data, sizeof(data)), 0);
+
+  // Copying fails cleanly once the region is sealed.
+  ASSERT_EQ(freeze_for_fork(&region.get()), Error::Ok);
+  EXPECT_EQ(
+      copy_to(&source, &region.get()).error(), Error::MemoryAllocationFailed);
+}
+
+TEST_F(PreforkTest, ChildrenShareTheSealedRegion) {
+  Result<ProcessMemoryUsage> usage = get_process_memory_usage();
+  if (usage.error() == Error::NotSupported) {
+    GTEST_SKIP() << "Memory usage is not reported on this system";
+  }
+  ASSERT_EQ(usage.error(), Error::Ok);
+  EXPECT_GT(usage->rss, 0);
+  EXPECT_GE(usage->rss, usage->private_total());
+
+  constexpr size_t kRegionSize = 16 * 1024 * 1024;
+  Result<MmapMemoryAllocator> region = MmapMemoryAllocator::from(kRegionSize);
+  ASSERT_EQ(region.error(), Error::Ok);
+  void* data = region->allocate(kRegionSize);
+  ASSERT_NE(data, nullptr);
+  std::memset(data, 1, kRegionSize);
+  ASSERT_EQ(freeze_for_fork(&region.get()), Error::Ok);
+
+  EXPECT_TRUE(run_in_child([&]() {
+    Result<ProcessMemoryUsage> before = get_process_memory_usage();
+    size_t sum = 0;
+    for (size_t i = 0; i < kRegionSize; ++i) {
+      sum += static_cast<const volatile uint8_t*>(data)[i];
+    }
+    Result<ProcessMemoryUsage> after = get_process_memory_usage();
+    // Reading the whole region doesn't make the child own any of it.
+    return sum == kRegionSize && before.ok() && after.ok() &&
+        after->private_total() < before->private_total() + kRegionSize / 4;
+  }));
+}
+
+TEST_F(PreforkTest, ChildrenExecuteFrozenProgram) {
+  Result<FileDataLoader> file =
+      FileDataLoader::from(std::getenv("ET_MODULE_ADD_PATH"));
+  ASSERT_EQ(file.error(), Error::Ok);
+  Result<MmapMemoryAllocator> region =
+      MmapMemoryAllocator::from(file->size().get());
+  ASSERT_EQ(region.error(), Error::Ok);
+  Result<BufferDataLoader> loader = copy_to(&file.get(), &region.get());
+  ASSERT_EQ(loader.error(), Error::Ok);
+
+  Result<Program> program = Program::load(&loader.get());
+  ASSERT_EQ(program.error(), Error::Ok);
+  Result<MethodMeta> meta = program->method_meta("forward");
+  ASSERT_EQ(meta.error(), Error::Ok);
+
+  std::vector<std::vector<uint8_t>> planned_buffers;
+  std::vector<Span<uint8_t>> planned_spans;
+  for (size_t id = 0; id < meta->num_memory_planned_buffers(); ++id) {
+    size_t size = meta->memory_planned_buffer_size(id).get();
+    planned_buffers.emplace_back(size);
+    planned_spans.push_back({planned_buffers.back().data(), size});
+  }
+  HierarchicalAllocator planned_memory(
+      {planned_spans.data(), planned_spans.size()});
+  std::vector<uint8_t> method_pool(kDefaultRuntimeMemBytes);
+  MemoryAllocator method_allocator(
+      kDefaultRuntimeMemBytes, method_pool.data());
+  MemoryManager memory_manager(&method_allocator, &planned_memory);
+
+  Result<Method> method = program->load_method("forward", &memory_manager);
+  ASSERT_EQ(method.error(), Error::Ok);
+  auto inputs = torch::executor::util::PrepareInputTensors(*method);
+
+  // Nothing can be added to the region once workers share it.
+  ASSERT_EQ(freeze_for_fork(&region.get()), Error::Ok);
+
+  for (int worker = 0; worker < 2; ++worker) {
+    EXPECT_TRUE(run_in_child([&]() {
+      // ModuleAdd computes x + alpha * y, and inputs are all ones.
+      return method->execute() == Error::Ok &&
+          method->get_output(0).toTensor().const_data_ptr<float>()[0] == 2.0f;
+    }));
+  }
+
+  torch::executor::util::FreeInputs(inputs);
+}
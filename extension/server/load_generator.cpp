@@ -0,0 +1,245 @@
+/*
+ * Copyright (c) Meta Platforms, Inc. and affiliates.
+ * All rights reserved.
+ *
+ * This source code is licensed under the BSD-style license found in the
+ * LICENSE file in the root directory of this source tree.
+ */
+
+/**
+ * @file
+ *
+ * Drives a model_server with a closed-loop load and reports throughput and
+ * latency percentiles. Each connection keeps `concurrency` requests
+ * outstanding, one per ring slot, and sends a new request as soon as one
+ * completes. For example:
+ *
+ *   load_generator --socket_path=/tmp/et.sock --model=mv2 \
+ *       --connections=4 --concurrency=2 --duration_s=10
+ *
+ * Latency is measured from sending a request to receiving its response, and
+ * does not include writing the inputs.
+ */
+
+#include <algorithm>
+#include <chrono>
+#include <cinttypes>
+#include <cstring>
+#include <thread>
+#include <vector>
+
+#include <gflags/gflags.h>
+
+#include <executorch/extension/server/model_client.h>
+#include <executorch/runtime/core/exec_aten/exec_aten.h>
+#include <executorch/runtime/platform/log.h>
+#include <executorch/runtime/platform/runtime.h>
+
+DEFINE_string(
+    socket_path,
+    "/tmp/executorch_server.sock",
+    "Unix domain socket the server listens on.");
+DEFINE_string(model, "", "Name of the model to run.");
+DEFINE_int32(connections, 1, "Clients, each on its own thread.");
+DEFINE_int32(concurrency, 1, "Requests each client keeps outstanding.");
+DEFINE_int32(duration_s, 10, "How long to measure, in seconds.");
+DEFINE_int32(warmup_s, 1, "How long to run before measuring, in seconds.");
+DEFINE_int32(
+    slot_size_kb,
+    4096,
+    "Ring slot size; must fit inputs and outputs.");
+
+using namespace torch::executor;
+using torch::executor::util::ModelClient;
+using torch::executor::util::SharedTensorRing;
+using torch::executor::util::SlotTensor;
+using Clock = std::chrono::steady_clock;
+
+namespace {
+
+struct ClientResult {
+  Error error = Error::Ok;
+  uint64_t num_failed = 0;
+  std::vector<uint64_t> latencies_ns;
+};
+
+// An input laid out by lookup(), and data to copy into it before every
+// request, since the server replaces inputs with outputs.
+struct InputTemplate {
+  SlotTensor tensor;
+  std::vector<uint8_t> data;
+};
+
+// Lays the inputs out in `slot` and fills them.
+bool write_inputs(
+    SharedTensorRing& ring,
+    uint32_t slot,
+    const std::vector<InputTemplate>& inputs) {
+  ring.clear(slot);
+  for (const InputTemplate& input : inputs) {
+    void* data = ring.add_tensor(
+        slot,
+        static_cast<exec_aten::ScalarType>(input.tensor.scalar_type),
+        {input.tensor.sizes, input.tensor.dim});
+    if (data == nullptr) {
+      return false;
+    }
+    std::memcpy(data, input.data.data(), input.data.size());
+  }
+  return true;
+}
+
+void run_client(ClientResult* result) {
+  const uint32_t num_slots = std::max(FLAGS_concurrency, 1);
+  Result<ModelClient> client = ModelClient::connect(
+      FLAGS_socket_path.c_str(),
+      num_slots,
+      static_cast<size_t>(FLAGS_slot_size_kb) * 1024);
+  if (!client.ok()) {
+    result->error = client.error();
+    return;
+  }
+  SharedTensorRing& ring = client->ring();
+  Result<uint32_t> model_id = client->lookup(FLAGS_model.c_str(), 0);
+  if (!model_id.ok()) {
+    ET_LOG(Error, "Model %s not found", FLAGS_model.c_str());
+    result->error = model_id.error();
+    return;
+  }
+
+  std::vector<InputTemplate> inputs;
+  for (size_t i = 0; i < ring.num_tensors(0); ++i) {
+    InputTemplate input;
+    input.tensor = ring.tensor(0, i).get();
+    input.data.resize(input.tensor.nbytes);
+    if (input.tensor.scalar_type ==
+        static_cast<int32_t>(exec_aten::ScalarType::Float)) {
+      std::fill_n(
+          reinterpret_cast<float*>(input.data.data()),
+          input.data.size() / sizeof(float),
+          1.0f);
+    }
+    inputs.push_back(std::move(input));
+  }
+
+  const Clock::time_point start = Clock::now();
+  const Clock::time_point measure_from =
+      start + std::chrono::seconds(FLAGS_warmup_s);
+  const Clock::time_point stop_at =
+      measure_from + std::chrono::seconds(FLAGS_duration_s);
+  std::vector<Clock::time_point> sent_at(num_slots);
+
+  auto send = [&](uint32_t slot) {
+    if (!write_inputs(ring, slot, inputs)) {
+      return Error::MemoryAllocationFailed;
+    }
+    sent_at[slot] = Clock::now();
+    return client->infer_async(model_id.get(), slot).error();
+  };
+
+  size_t outstanding = 0;
+  for (uint32_t slot = 0; slot < num_slots; ++slot) {
+    result->error = send(slot);
+    if (result->error != Error::Ok) {
+      return;
+    }
+    outstanding++;
+  }
+  while (outstanding > 0) {
+    Result<ModelClient::Response> response = client->wait();
+    if (!response.ok()) {
+      result->error = response.error();
+      return;
+    }
+    outstanding--;
+    const Clock::time_point now = Clock::now();
+    const uint32_t slot = response->slot;
+    if (sent_at[slot] >= measure_from && now < stop_at) {
+      if (response->status == Error::Ok) {
+        result->latencies_ns.push_back(
+            std::chrono::duration_cast<std::chrono::nanoseconds>(
+                now - sent_at[slot])
+                .count());
+      } else {
+        result->num_failed++;
+      }
+    }
+    if (now < stop_at) {
+      result->error = send(slot);
+      if (result->error != Error::Ok) {
+        return;
+      }
+      outstanding++;
+    }
+  }
+}
+
+double percentile_us(const std::vector<uint64_t>& sorted_ns, double p) {
+  if (sorted_ns.empty()) {
+    return 0;
+  }
+  size_t index = static_cast<size_t>(p / 100.0 * (sorted_ns.size() - 1) + 0.5);
+  return sorted_ns[std::min(index, sorted_ns.size() - 1)] / 1000.0;
+}
+
+} // namespace
+
+int main(int argc, char** argv) {
+  runtime_init();
+
+  gflags::ParseCommandLineFlags(&argc, &argv, true);
+  if (argc != 1 || FLAGS_model.empty()) {
+    ET_LOG(Error, "Usage: %s --model=name [--socket_path=...]", argv[0]);
+    return 1;
+  }
+
+  const size_t num_clients = std::max(FLAGS_connections, 1);
+  std::vector<ClientResult> results(num_clients);
+  std::vector<std::thread> threads;
+  for (size_t i = 0; i < num_clients; ++i) {
+    threads.emplace_back(run_client, &results[i]);
+  }
+  for (std::thread& thread : threads) {
+    thread.join();
+  }
+
+  std::vector<uint64_t> latencies_ns;
+  uint64_t num_failed = 0;
+  for (const ClientResult& result : results) {
+    if (result.error != Error::Ok) {
+      ET_LOG(
+          Error,
+          "A client failed: 0x%" PRIx32,
+          static_cast<uint32_t>(result.error));
+      return 1;
+    }
+    latencies_ns.insert(
+        latencies_ns.end(),
+        result.latencies_ns.begin(),
+        result.latencies_ns.end());
+    num_failed += result.num_failed;
+  }
+  std::sort(latencies_ns.begin(), latencies_ns.end());
+
+  printf(
+      "%zu connections x %d outstanding, %d s\n",
+      num_clients,
+      std::max(FLAGS_concurrency, 1),
+      FLAGS_duration_s);
+  printf(
+      "requests: %zu ok, %" PRIu64 " failed\n",
+      latencies_ns.size(),
+      num_failed);
+  printf(
+      "throughput: %.1f requests/s\n",
+      FLAGS_duration_s > 0 ? latencies_ns.size() / double(FLAGS_duration_s)
+                           : 0.0);
+  printf(
+      "latency (us): p50 %.1f  p90 %.1f  p99 %.1f  p99.9 %.1f  max %.1f\n",
+      percentile_us(latencies_ns, 50),
+      percentile_us(latencies_ns, 90),
+      percentile_us(latencies_ns, 99),
+      percentile_us(latencies_ns, 99.9),
+      percentile_us(latencies_ns, 100));
+  return num_failed == 0 ? 0 : 1;
+}
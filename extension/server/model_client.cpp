@@ -0,0 +1,201 @@
+/*
+ * Copyright (c) Meta Platforms, Inc. and affiliates.
+ * All rights reserved.
+ *
+ * This source code is licensed under the BSD-style license found in the
+ * LICENSE file in the root directory of this source tree.
+ */
+
+#include <executorch/extension/server/model_client.h>
+
+#include <cerrno>
+#include <cinttypes>
+#include <cstring>
+
+#include <sys/socket.h>
+#include <sys/un.h>
+#include <unistd.h>
+
+#include <executorch/runtime/platform/log.h>
+
+namespace torch {
+namespace executor {
+namespace util {
+
+Result<ModelClient> ModelClient::connect(
+    const char* socket_path,
+    uint32_t num_slots,
+    size_t slot_size) {
+  struct sockaddr_un addr;
+  ET_CHECK_OR_RETURN_ERROR(
+      socket_path != nullptr &&
+          std::strlen(socket_path) < sizeof(addr.sun_path),
+      InvalidArgument,
+      "Socket path must be shorter than %zu characters",
+      sizeof(addr.sun_path));
+  std::memset(&addr, 0, sizeof(addr));
+  addr.sun_family = AF_UNIX;
+  std::strncpy(addr.sun_path, socket_path, sizeof(addr.sun_path) - 1);
+
+  Result<SharedTensorRing> ring =
+      SharedTensorRing::create(num_slots, slot_size);
+  if (!ring.ok()) {
+    return ring.error();
+  }
+
+  int fd = ::socket(AF_UNIX, SOCK_STREAM, 0);
+  if (fd < 0) {
+    ET_LOG(Error, "Failed to create socket: %s (%d)", ::strerror(errno), errno);
+    return Error::AccessFailed;
+  }
+  if (::connect(fd, reinterpret_cast<struct sockaddr*>(&addr), sizeof(addr)) !=
+      0) {
+    ET_LOG(
+        Error,
+        "Failed to connect to %s: %s (%d)",
+        socket_path,
+        ::strerror(errno),
+        errno);
+    ::close(fd);
+    return Error::AccessFailed;
+  }
+  ModelClient client(fd, std::move(ring.get()));
+
+  Message request;
+  std::memset(&request, 0, sizeof(request));
+  request.type = MessageType::kAttachRing;
+  request.slot = client.ring_.num_slots();
+  request.size = client.ring_.slot_size();
+  Result<Message> response = client.call(request, client.ring_.fd());
+  if (!response.ok()) {
+    return response.error();
+  }
+  Error status = static_cast<Error>(response->status);
+  if (status != Error::Ok) {
+    ET_LOG(
+        Error,
+        "Server rejected the ring: 0x%" PRIx32,
+        static_cast<uint32_t>(status));
+    return status;
+  }
+  return client;
+}
+
+ModelClient::ModelClient(ModelClient&& rhs) noexcept
+    : socket_(rhs.socket_),
+      ring_(std::move(rhs.ring_)),
+      next_request_id_(rhs.next_request_id_),
+      num_outstanding_(rhs.num_outstanding_) {
+  rhs.socket_ = -1;
+}
+
+ModelClient::~ModelClient() {
+  if (socket_ >= 0) {
+    ::close(socket_);
+  }
+}
+
+Result<uint32_t> ModelClient::lookup(const char* model_name, uint32_t slot) {
+  ET_CHECK_OR_RETURN_ERROR(
+      std::strlen(model_name) < kMaxModelNameLength,
+      InvalidArgument,
+      "Model name must be shorter than %zu characters",
+      kMaxModelNameLength);
+  Message request;
+  std::memset(&request, 0, sizeof(request));
+  request.type = MessageType::kLookup;
+  request.slot = slot;
+  std::strncpy(request.model_name, model_name, kMaxModelNameLength - 1);
+  Result<Message> response = call(request);
+  if (!response.ok()) {
+    return response.error();
+  }
+  Error status = static_cast<Error>(response->status);
+  if (status != Error::Ok) {
+    return status;
+  }
+  return response->model_id;
+}
+
+Result<uint32_t> ModelClient::infer_async(uint32_t model_id, uint32_t slot) {
+  ET_CHECK_OR_RETURN_ERROR(
+      slot < ring_.num_slots(),
+      InvalidArgument,
+      "Slot %" PRIu32 " out of range",
+      slot);
+  Message request;
+  std::memset(&request, 0, sizeof(request));
+  request.type = MessageType::kInfer;
+  request.request_id = next_request_id_++;
+  request.model_id = model_id;
+  request.slot = slot;
+  Error err = send_messages(socket_, &request, 1);
+  if (err != Error::Ok) {
+    return err;
+  }
+  num_outstanding_++;
+  return request.request_id;
+}
+
+Result<ModelClient::Response> ModelClient::wait() {
+  ET_CHECK_OR_RETURN_ERROR(
+      num_outstanding_ > 0, InvalidState, "No request is outstanding");
+  Message response;
+  Error err = receive_message(socket_, &response);
+  if (err != Error::Ok) {
+    // The server went away; nothing outstanding will ever be answered.
+    return err == Error::NotFound ? Error::AccessFailed : err;
+  }
+  ET_CHECK_OR_RETURN_ERROR(
+      response.type == MessageType::kResponse,
+      InvalidState,
+      "Unexpected message type %" PRIu32,
+      static_cast<uint32_t>(response.type));
+  num_outstanding_--;
+  return Response{
+      response.request_id, response.slot, static_cast<Error>(response.status)};
+}
+
+Error ModelClient::infer(uint32_t model_id, uint32_t slot) {
+  ET_CHECK_OR_RETURN_ERROR(
+      num_outstanding_ == 0,
+      InvalidState,
+      "Cannot run synchronously with requests outstanding");
+  Result<uint32_t> request_id = infer_async(model_id, slot);
+  if (!request_id.ok()) {
+    return request_id.error();
+  }
+  Result<Response> response = wait();
+  if (!response.ok()) {
+    return response.error();
+  }
+  return response->status;
+}
+
+Result<Message> ModelClient::call(Message& request, int fd) {
+  ET_CHECK_OR_RETURN_ERROR(
+      num_outstanding_ == 0,
+      InvalidState,
+      "Cannot call the server with requests outstanding");
+  request.request_id = next_request_id_++;
+  Error err = send_messages(socket_, &request, 1, fd);
+  if (err != Error::Ok) {
+    return err;
+  }
+  Message response;
+  err = receive_message(socket_, &response);
+  if (err != Error::Ok) {
+    return err == Error::NotFound ? Error::AccessFailed : err;
+  }
+  ET_CHECK_OR_RETURN_ERROR(
+      response.type == MessageType::kResponse &&
+          response.request_id == request.request_id,
+      InvalidState,
+      "Unexpected response to request %" PRIu32,
+      request.request_id);
+  return response;
+}
+
+} // namespace util
+} // namespace executor
+} // namespace torch
@@ -0,0 +1,113 @@
+/*
+ * Copyright (c) Meta Platforms, Inc. and affiliates.
+ * All rights reserved.
+ *
+ * This source code is licensed under the BSD-style license found in the
+ * LICENSE file in the root directory of this source tree.
+ */
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+
+#include <executorch/extension/server/protocol.h>
+#include <executorch/extension/server/shared_tensor_ring.h>
+#include <executorch/runtime/core/error.h>
+#include <executorch/runtime/core/result.h>
+
+namespace torch {
+namespace executor {
+namespace util {
+
+/**
+ * Connects to a ModelServer and runs its models on tensors in a
+ * SharedTensorRing owned by the client.
+ *
+ * To run a model:
+ *   1. lookup() it once; the slot passed in then holds tensors shaped like
+ *      its inputs.
+ *   2. Write the input data through ring(), either into the tensors that
+ *      lookup() laid out or into tensors added with clear() and add_tensor().
+ *   3. infer(), or infer_async() and later wait(). On success the slot holds
+ *      the outputs.
+ *
+ * Up to ring().num_slots() requests can be outstanding at once, one per slot.
+ * Not thread-safe.
+ */
+class ModelClient final {
+ public:
+  struct Response {
+    uint32_t request_id;
+    uint32_t slot;
+    Error status;
+  };
+
+  /**
+   * Connects to the server listening at `socket_path` and shares a new ring
+   * with it.
+   *
+   * @param[in] num_slots The most requests that can be outstanding at once.
+   * @param[in] slot_size Bytes per slot. Must fit the inputs and the outputs
+   *     of any model run through it, plus a SlotHeader.
+   */
+  __ET_NODISCARD static Result<ModelClient>
+  connect(const char* socket_path, uint32_t num_slots, size_t slot_size);
+
+  ModelClient(ModelClient&& rhs) noexcept;
+  ~ModelClient();
+
+  ModelClient(const ModelClient&) = delete;
+  ModelClient& operator=(const ModelClient&) = delete;
+  ModelClient& operator=(ModelClient&&) = delete;
+
+  SharedTensorRing& ring() {
+    return ring_;
+  }
+
+  /**
+   * Finds the model named `model_name`, and lays out tensors shaped like its
+   * inputs in `slot`. Must not be called while requests are outstanding.
+   *
+   * @returns The id to run the model with.
+   * @retval Error::NotFound if the server has no such model.
+   */
+  __ET_NODISCARD Result<uint32_t> lookup(const char* model_name, uint32_t slot);
+
+  /**
+   * Asks the server to run `model_id` on the inputs in `slot`. The slot
+   * belongs to the server until the response arrives.
+   *
+   * @returns The id of the request, which the response carries.
+   */
+  __ET_NODISCARD Result<uint32_t> infer_async(uint32_t model_id, uint32_t slot);
+
+  /**
+   * Blocks until the response to one outstanding request arrives.
+   *
+   * @retval Error::InvalidState if no request is outstanding.
+   */
+  __ET_NODISCARD Result<Response> wait();
+
+  /**
+   * Runs `model_id` on the inputs in `slot` and waits for the outputs. Must
+   * not be called while requests are outstanding.
+   */
+  __ET_NODISCARD Error infer(uint32_t model_id, uint32_t slot);
+
+ private:
+  ModelClient(int socket, SharedTensorRing ring)
+      : socket_(socket), ring_(std::move(ring)) {}
+
+  // Sends `request` and waits for its response. Nothing may be outstanding.
+  Result<Message> call(Message& request, int fd = -1);
+
+  int socket_;
+  SharedTensorRing ring_;
+  uint32_t next_request_id_ = 0;
+  size_t num_outstanding_ = 0;
+};
+
+} // namespace util
+} // namespace executor
+} // namespace torch
@@ -0,0 +1,639 @@
+/*
+ * Copyright (c) Meta Platforms, Inc. and affiliates.
+ * All rights reserved.
+ *
+ * This source code is licensed under the BSD-style license found in the
+ * LICENSE file in the root directory of this source tree.
+ */
+
+#include <executorch/extension/server/model_server.h>
+
+#include <algorithm>
+#include <cerrno>
+#include <chrono>
+#include <cinttypes>
+#include <cstring>
+#include <iterator>
+
+#include <sys/socket.h>
+#include <sys/stat.h>
+#include <sys/un.h>
+#include <unistd.h>
+
+#include <executorch/runtime/core/evalue.h>
+#include <executorch/runtime/core/exec_aten/exec_aten.h>
+#include <executorch/runtime/platform/log.h>
+
+namespace torch {
+namespace executor {
+namespace util {
+
+namespace {
+
+// How long the acceptor waits after accept() fails for lack of resources.
+constexpr std::chrono::milliseconds kAcceptRetryDelay(100);
+
+Message make_response(const Message& request, Error status) {
+  Message response;
+  std::memset(&response, 0, sizeof(response));
+  response.type = MessageType::kResponse;
+  response.request_id = request.request_id;
+  response.status = static_cast<uint32_t>(status);
+  response.model_id = request.model_id;
+  response.slot = request.slot;
+  return response;
+}
+
+Error make_address(const char* socket_path, struct sockaddr_un* addr) {
+  ET_CHECK_OR_RETURN_ERROR(
+      socket_path != nullptr &&
+          std::strlen(socket_path) < sizeof(addr->sun_path),
+      InvalidArgument,
+      "Socket path must be shorter than %zu characters",
+      sizeof(addr->sun_path));
+  std::memset(addr, 0, sizeof(*addr));
+  addr->sun_family = AF_UNIX;
+  std::strncpy(addr->sun_path, socket_path, sizeof(addr->sun_path) - 1);
+  return Error::Ok;
+}
+
+} // namespace
+
+ModelServer::Connection::~Connection() {
+  ::close(socket);
+}
+
+ModelServer::ModelServer(Config config) : config_(config) {}
+
+ModelServer::~ModelServer() {
+  stop();
+}
+
+Error ModelServer::add_model(
+    const char* name,
+    Program* program,
+    const char* method_name,
+    size_t num_instances) {
+  ET_CHECK_OR_RETURN_ERROR(
+      listen_socket_ < 0, InvalidState, "Models must be added before start()");
+  ET_CHECK_OR_RETURN_ERROR(
+      name != nullptr && std::strlen(name) < kMaxModelNameLength,
+      InvalidArgument,
+      "Model name must be shorter than %zu characters",
+      kMaxModelNameLength);
+  ET_CHECK_OR_RETURN_ERROR(
+      num_instances > 0, InvalidArgument, "Need at least one instance");
+  for (const auto& model : models_) {
+    ET_CHECK_OR_RETURN_ERROR(
+        model->name != name, InvalidArgument, "Model %s already added", name);
+  }
+
+  Result<MethodMeta> meta = program->method_meta(method_name);
+  if (!meta.ok()) {
+    return meta.error();
+  }
+
+  auto model = std::make_unique<Model>();
+  model->name = name;
+  for (size_t i = 0; i < num_instances; ++i) {
+    auto instance = std::make_unique<Instance>();
+    for (size_t id = 0; id < meta->num_memory_planned_buffers(); ++id) {
+      Result<int64_t> size = meta->memory_planned_buffer_size(id);
+      if (!size.ok()) {
+        return size.error();
+      }
+      instance->planned_buffers.emplace_back(size.get());
+    }
+    for (auto& buffer : instance->planned_buffers) {
+      instance->planned_spans.push_back({buffer.data(), buffer.size()});
+    }
+    instance->planned_memory = std::make_unique<HierarchicalAllocator>(
+        Span<Span<uint8_t>>(
+            instance->planned_spans.data(), instance->planned_spans.size()));
+    instance->memory_manager = std::make_unique<MemoryManager>(
+        &instance->method_allocator,
+        instance->planned_memory.get(),
+        &instance->temp_allocator);
+
+    Result<Method> method =
+        program->load_method(method_name, instance->memory_manager.get());
+    if (!method.ok()) {
+      ET_LOG(
+          Error,
+          "Loading %s for model %s failed: 0x%" PRIx32,
+          method_name,
+          name,
+          static_cast<uint32_t>(method.error()));
+      return method.error();
+    }
+    instance->method = std::make_unique<Method>(std::move(method.get()));
+
+    // Clients can write their slots at any time, so inputs are copied into
+    // memory of the instance's own before every execution. set_input() copies
+    // memory-planned inputs straight from the slot into planned memory; the
+    // others would alias the slot, so they are staged in a buffer first.
+    Method& m = *instance->method;
+    for (size_t in = 0; in < meta->num_inputs(); ++in) {
+      Result<TensorInfo> info = meta->input_tensor_meta(in);
+      if (!info.ok() || info->is_memory_planned()) {
+        // Non-tensor inputs, which lookup() rejects, and memory-planned
+        // inputs get no staging buffer.
+        instance->input_buffers.push_back({});
+        continue;
+      }
+      size_t nbytes = info->nbytes();
+      void* buffer = instance->method_allocator.allocate(nbytes);
+      ET_CHECK_OR_RETURN_ERROR(
+          buffer != nullptr || nbytes == 0,
+          MemoryAllocationFailed,
+          "Failed to allocate %zu bytes for input %zu",
+          nbytes,
+          in);
+      instance->input_buffers.push_back(
+          {static_cast<uint8_t*>(buffer), nbytes});
+    }
+
+    // Outputs without planned memory write wherever the caller says; give
+    // them memory of the instance's own, since results are copied out to the
+    // client's slot anyway.
+    for (size_t out = 0; out < m.outputs_size(); ++out) {
+      const EValue& output = m.get_output(out);
+      if (!output.isTensor() ||
+          output.toTensor().const_data_ptr() != nullptr) {
+        continue;
+      }
+      size_t nbytes = output.toTensor().nbytes();
+      void* buffer = instance->method_allocator.allocate(nbytes);
+      ET_CHECK_OR_RETURN_ERROR(
+          buffer != nullptr,
+          MemoryAllocationFailed,
+          "Failed to allocate %zu bytes for output %zu",
+          nbytes,
+          out);
+      Error err = m.set_output_data_ptr(buffer, nbytes, out);
+      if (err != Error::Ok) {
+        return err;
+      }
+    }
+
+    model->free_instances.push_back(i);
+    model->instances.push_back(std::move(instance));
+  }
+  models_.push_back(std::move(model));
+  return Error::Ok;
+}
+
+Error ModelServer::start(const char* socket_path) {
+  ET_CHECK_OR_RETURN_ERROR(
+      listen_socket_ < 0, InvalidState, "Server already started");
+  struct sockaddr_un addr;
+  Error err = make_address(socket_path, &addr);
+  if (err != Error::Ok) {
+    return err;
+  }
+
+  int fd = ::socket(AF_UNIX, SOCK_STREAM, 0);
+  if (fd < 0) {
+    ET_LOG(Error, "Failed to create socket: %s (%d)", ::strerror(errno), errno);
+    return Error::AccessFailed;
+  }
+  // A previous server may have left its socket file behind. Only remove it if
+  // it is a socket, never a file that happens to have the same path.
+  struct stat st;
+  if (::lstat(socket_path, &st) == 0) {
+    if (!S_ISSOCK(st.st_mode)) {
+      ET_LOG(Error, "%s exists and is not a socket", socket_path);
+      ::close(fd);
+      return Error::AccessFailed;
+    }
+    ::unlink(socket_path);
+  }
+  if (::bind(fd, reinterpret_cast<struct sockaddr*>(&addr), sizeof(addr)) !=
+          0 ||
+      ::listen(fd, /*backlog=*/64) != 0) {
+    ET_LOG(
+        Error,
+        "Failed to listen on %s: %s (%d)",
+        socket_path,
+        ::strerror(errno),
+        errno);
+    ::close(fd);
+    return Error::AccessFailed;
+  }
+
+  listen_socket_ = fd;
+  socket_path_ = socket_path;
+  stopping_ = false;
+  size_t num_workers = std::max<size_t>(config_.num_workers, 1);
+  for (size_t i = 0; i < num_workers; ++i) {
+    workers_.emplace_back([this]() { worker_loop(); });
+  }
+  acceptor_ = std::thread([this]() { accept_loop(); });
+  return Error::Ok;
+}
+
+void ModelServer::stop() {
+  if (listen_socket_ < 0) {
+    return;
+  }
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    stopping_ = true;
+  }
+  work_cv_.notify_all();
+  space_cv_.notify_all();
+
+  // Wake the acceptor up by connecting to it; it sees stopping_ and exits.
+  struct sockaddr_un addr;
+  if (make_address(socket_path_.c_str(), &addr) == Error::Ok) {
+    int fd = ::socket(AF_UNIX, SOCK_STREAM, 0);
+    if (fd >= 0) {
+      (void)::connect(
+          fd, reinterpret_cast<struct sockaddr*>(&addr), sizeof(addr));
+      ::close(fd);
+    }
+  }
+  acceptor_.join();
+  ::close(listen_socket_);
+  listen_socket_ = -1;
+  ::unlink(socket_path_.c_str());
+
+  // No more connections can appear; unblock and join their readers.
+  std::vector<std::shared_ptr<Connection>> connections;
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    connections.swap(connections_);
+  }
+  for (auto& connection : connections) {
+    ::shutdown(connection->socket, SHUT_RDWR);
+  }
+  for (auto& connection : connections) {
+    connection->reader.join();
+  }
+
+  for (std::thread& worker : workers_) {
+    worker.join();
+  }
+  workers_.clear();
+  for (auto& model : models_) {
+    model->queue.clear();
+  }
+}
+
+ModelServer::Stats ModelServer::stats() const {
+  return Stats{
+      num_requests_.load(), num_batches_.load(), num_throttled_.load()};
+}
+
+void ModelServer::accept_loop() {
+  while (true) {
+    int socket = ::accept(listen_socket_, nullptr, nullptr);
+    const int accept_errno = errno;
+    std::vector<std::shared_ptr<Connection>> finished;
+    {
+      std::lock_guard<std::mutex> lock(mutex_);
+      if (stopping_) {
+        if (socket >= 0) {
+          ::close(socket);
+        }
+        return;
+      }
+      if (socket >= 0) {
+        // Take connections whose clients went away, to join their readers
+        // below.
+        auto end = std::stable_partition(
+            connections_.begin(),
+            connections_.end(),
+            [](const std::shared_ptr<Connection>& connection) {
+              return !connection->finished;
+            });
+        finished.assign(
+            std::make_move_iterator(end),
+            std::make_move_iterator(connections_.end()));
+        connections_.erase(end, connections_.end());
+
+        auto connection = std::make_shared<Connection>(socket);
+        connection->reader =
+            std::thread([this, connection]() { read_loop(connection); });
+        connections_.push_back(std::move(connection));
+      }
+    }
+    for (auto& connection : finished) {
+      connection->reader.join();
+    }
+    if (socket >= 0 || accept_errno == EINTR ||
+        accept_errno == ECONNABORTED) {
+      continue;
+    }
+
+    ET_LOG(
+        Error,
+        "Failed to accept a connection: %s (%d)",
+        ::strerror(accept_errno),
+        accept_errno);
+    if (accept_errno == EBADF || accept_errno == EINVAL ||
+        accept_errno == ENOTSOCK) {
+      // The listening socket is unusable; retrying can't help.
+      return;
+    }
+    // Usually out of descriptors or memory. Give running requests a chance
+    // to release some instead of spinning.
+    std::this_thread::sleep_for(kAcceptRetryDelay);
+  }
+}
+
+void ModelServer::read_loop(std::shared_ptr<Connection> connection) {
+  while (true) {
+    Message message;
+    int fd = -1;
+    if (receive_message(connection->socket, &message, &fd) != Error::Ok) {
+      // Closed by the client, or shut down by stop().
+      break;
+    }
+    if (message.type == MessageType::kAttachRing) {
+      Message response = attach_ring(*connection, message, fd);
+      respond(*connection, &response, 1);
+      continue;
+    }
+    if (fd >= 0) {
+      ::close(fd);
+    }
+    if (message.type == MessageType::kLookup) {
+      Message response = lookup(*connection, message);
+      respond(*connection, &response, 1);
+      continue;
+    }
+    if (message.type != MessageType::kInfer) {
+      Message response = make_response(message, Error::NotSupported);
+      respond(*connection, &response, 1);
+      continue;
+    }
+
+    Error status = Error::Ok;
+    if (connection->ring == nullptr) {
+      status = Error::InvalidState;
+    } else if (message.model_id >= models_.size()) {
+      status = Error::NotFound;
+    } else if (message.slot >= connection->ring->num_slots()) {
+      status = Error::InvalidArgument;
+    }
+    if (status != Error::Ok) {
+      Message response = make_response(message, status);
+      respond(*connection, &response, 1);
+      continue;
+    }
+
+    Model& model = *models_[message.model_id];
+    {
+      std::unique_lock<std::mutex> lock(mutex_);
+      if (model.queue.size() >= config_.max_queue_depth) {
+        // Leave further requests in the socket until there is room.
+        num_throttled_++;
+        space_cv_.wait(lock, [&]() {
+          return stopping_ || model.queue.size() < config_.max_queue_depth;
+        });
+      }
+      if (stopping_) {
+        break;
+      }
+      model.queue.push_back({connection, message});
+    }
+    work_cv_.notify_one();
+  }
+
+  // Nobody will read the responses of requests that are still queued.
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    for (auto& model : models_) {
+      auto end = std::remove_if(
+          model->queue.begin(), model->queue.end(), [&](const Request& r) {
+            return r.connection == connection;
+          });
+      model->queue.erase(end, model->queue.end());
+    }
+  }
+  space_cv_.notify_all();
+  connection->finished = true;
+}
+
+Message ModelServer::attach_ring(
+    Connection& connection,
+    const Message& request,
+    int fd) {
+  if (connection.ring != nullptr || fd < 0) {
+    if (fd >= 0) {
+      ::close(fd);
+    }
+    ET_LOG(Error, "Expected exactly one ring per connection");
+    return make_response(request, Error::InvalidState);
+  }
+  Result<SharedTensorRing> ring =
+      SharedTensorRing::attach(fd, request.slot, request.size);
+  if (!ring.ok()) {
+    return make_response(request, ring.error());
+  }
+  connection.ring = std::make_unique<SharedTensorRing>(std::move(ring.get()));
+  return make_response(request, Error::Ok);
+}
+
+Message ModelServer::lookup(Connection& connection, const Message& request) {
+  char name[kMaxModelNameLength];
+  std::memcpy(name, request.model_name, sizeof(name));
+  name[sizeof(name) - 1] = '\0';
+
+  Message response = make_response(request, Error::Ok);
+  SharedTensorRing* ring = connection.ring.get();
+  if (ring == nullptr || request.slot >= ring->num_slots()) {
+    response.status = static_cast<uint32_t>(Error::InvalidState);
+    return response;
+  }
+  for (size_t id = 0; id < models_.size(); ++id) {
+    if (models_[id]->name != name) {
+      continue;
+    }
+    // Describe the inputs by laying them out in the slot, which also checks
+    // that they fit.
+    MethodMeta meta = models_[id]->instances[0]->method->method_meta();
+    ring->clear(request.slot);
+    for (size_t i = 0; i < meta.num_inputs(); ++i) {
+      Result<TensorInfo> info = meta.input_tensor_meta(i);
+      if (!info.ok()) {
+        ET_LOG(Error, "Model %s has a non-tensor input %zu", name, i);
+        response.status = static_cast<uint32_t>(Error::NotSupported);
+        return response;
+      }
+      if (ring->add_tensor(
+              request.slot,
+              info->scalar_type(),
+              {info->sizes().data(), info->sizes().size()}) == nullptr) {
+        response.status = static_cast<uint32_t>(Error::MemoryAllocationFailed);
+        return response;
+      }
+    }
+    response.model_id = id;
+    response.size = meta.num_inputs();
+    return response;
+  }
+  ET_LOG(Error, "No model named %s", name);
+  response.status = static_cast<uint32_t>(Error::NotFound);
+  return response;
+}
+
+void ModelServer::worker_loop() {
+  std::vector<Request> batch;
+  std::vector<Message> responses;
+  while (true) {
+    Model* model = nullptr;
+    size_t instance_index = 0;
+    {
+      std::unique_lock<std::mutex> lock(mutex_);
+      work_cv_.wait(lock, [&]() {
+        if (stopping_) {
+          return true;
+        }
+        for (size_t i = 0; i < models_.size(); ++i) {
+          Model* candidate = models_[(next_model_ + i) % models_.size()].get();
+          if (!candidate->queue.empty() &&
+              !candidate->free_instances.empty()) {
+            next_model_ = (next_model_ + i + 1) % models_.size();
+            model = candidate;
+            return true;
+          }
+        }
+        return false;
+      });
+      if (stopping_) {
+        return;
+      }
+      instance_index = model->free_instances.back();
+      model->free_instances.pop_back();
+      size_t count = std::min(
+          std::max<size_t>(config_.max_batch_size, 1), model->queue.size());
+      batch.assign(
+          std::make_move_iterator(model->queue.begin()),
+          std::make_move_iterator(model->queue.begin() + count));
+      model->queue.erase(model->queue.begin(), model->queue.begin() + count);
+    }
+    space_cv_.notify_all();
+
+    Instance& instance = *model->instances[instance_index];
+    responses.clear();
+    for (const Request& request : batch) {
+      Error status =
+          run(instance, *request.connection, request.message.slot);
+      responses.push_back(make_response(request.message, status));
+    }
+    // Requests from one connection are usually adjacent; answer each run of
+    // them with a single write.
+    for (size_t begin = 0; begin < batch.size();) {
+      size_t end = begin + 1;
+      while (end < batch.size() &&
+             batch[end].connection == batch[begin].connection) {
+        ++end;
+      }
+      respond(*batch[begin].connection, &responses[begin], end - begin);
+      begin = end;
+    }
+    num_requests_ += batch.size();
+    num_batches_++;
+    batch.clear();
+
+    {
+      std::lock_guard<std::mutex> lock(mutex_);
+      model->free_instances.push_back(instance_index);
+    }
+    work_cv_.notify_one();
+  }
+}
+
+Error ModelServer::run(
+    Instance& instance,
+    Connection& connection,
+    uint32_t slot) {
+  SharedTensorRing& ring = *connection.ring;
+  Method& method = *instance.method;
+
+  ET_CHECK_OR_RETURN_ERROR(
+      ring.num_tensors(slot) == method.inputs_size(),
+      InvalidArgument,
+      "Slot %" PRIu32 " holds %zu tensors, expected %zu inputs",
+      slot,
+      ring.num_tensors(slot),
+      method.inputs_size());
+  for (size_t i = 0; i < method.inputs_size(); ++i) {
+    Result<SlotTensor> input = ring.tensor(slot, i);
+    if (!input.ok()) {
+      return input.error();
+    }
+    // Execute from a copy: the client could change its slot mid-execution.
+    // Memory-planned inputs have no staging buffer, since set_input() copies
+    // them.
+    void* data = ring.tensor_data(slot, input.get());
+    Span<uint8_t> buffer = instance.input_buffers[i];
+    if (buffer.data() != nullptr) {
+      ET_CHECK_OR_RETURN_ERROR(
+          input->nbytes <= buffer.size(),
+          InvalidArgument,
+          "Input %zu has %" PRIu64 " bytes, at most %zu expected",
+          i,
+          input->nbytes,
+          buffer.size());
+      if (input->nbytes > 0) {
+        std::memcpy(buffer.data(), data, input->nbytes);
+      }
+      data = buffer.data();
+    }
+    exec_aten::DimOrderType dim_order[kMaxSlotTensorDim];
+    for (uint32_t d = 0; d < input->dim; ++d) {
+      dim_order[d] = d;
+    }
+    exec_aten::TensorImpl impl(
+        static_cast<exec_aten::ScalarType>(input->scalar_type),
+        input->dim,
+        input->sizes,
+        data,
+        dim_order);
+    Error err = method.set_input(EValue(exec_aten::Tensor(&impl)), i);
+    if (err != Error::Ok) {
+      return err;
+    }
+  }
+
+  Error err = method.execute();
+  if (err != Error::Ok) {
+    return err;
+  }
+
+  ring.clear(slot);
+  for (size_t i = 0; i < method.outputs_size(); ++i) {
+    const EValue& output = method.get_output(i);
+    ET_CHECK_OR_RETURN_ERROR(
+        output.isTensor(),
+        NotSupported,
+        "Output %zu is not a tensor",
+        i);
+    const exec_aten::Tensor& tensor = output.toTensor();
+    void* data = ring.add_tensor(slot, tensor.scalar_type(), tensor.sizes());
+    ET_CHECK_OR_RETURN_ERROR(
+        data != nullptr,
+        MemoryAllocationFailed,
+        "Output %zu does not fit in slot %" PRIu32,
+        i,
+        slot);
+    std::memcpy(data, tensor.const_data_ptr(), tensor.nbytes());
+  }
+  return Error::Ok;
+}
+
+void ModelServer::respond(
+    Connection& connection,
+    const Message* responses,
+    size_t count) {
+  std::lock_guard<std::mutex> lock(connection.write_mutex);
+  // A failure means the client went away; its reader cleans up.
+  (void)send_messages(connection.socket, responses, count);
+}
+
+} // namespace util
+} // namespace executor
+} // namespace torch
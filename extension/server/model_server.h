@@ -0,0 +1,197 @@
+/*
+ * Copyright (c) Meta Platforms, Inc. and affiliates.
+ * All rights reserved.
+ *
+ * This source code is licensed under the BSD-style license found in the
+ * LICENSE file in the root directory of this source tree.
+ */
+
+#pragma once
+
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <deque>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include <executorch/extension/memory_allocator/malloc_memory_allocator.h>
+#include <executorch/extension/server/protocol.h>
+#include <executorch/extension/server/shared_tensor_ring.h>
+#include <executorch/runtime/core/error.h>
+#include <executorch/runtime/core/hierarchical_allocator.h>
+#include <executorch/runtime/executor/memory_manager.h>
+#include <executorch/runtime/executor/method.h>
+#include <executorch/runtime/executor/program.h>
+
+namespace torch {
+namespace executor {
+namespace util {
+
+/**
+ * Serves Methods of one or more Programs to other processes on the same
+ * machine, over a Unix domain socket. See protocol.h for the wire format and
+ * ModelClient for the client side.
+ *
+ * Each model is a pool of identical Method instances loaded from one Program.
+ * Requests for a model queue up until a worker thread and an instance are
+ * free; the worker then takes up to `max_batch_size` queued requests at once,
+ * runs them back to back on that instance, and sends their responses
+ * together. ExecuTorch Methods have static shapes, so requests are not merged
+ * into one larger execution; batching saves wakeups and socket writes, and
+ * keeps one instance hot in cache.
+ *
+ * Backpressure: when a model's queue holds `max_queue_depth` requests, the
+ * server stops reading from connections that send more requests for it, which
+ * eventually blocks those clients in send(). A client also never has more
+ * requests outstanding than it has ring slots.
+ *
+ * Only available on POSIX systems.
+ */
+class ModelServer final {
+ public:
+  struct Config {
+    /// Number of threads executing requests.
+    size_t num_workers = 2;
+    /// Most requests for one model that a worker runs in one go.
+    size_t max_batch_size = 8;
+    /// Most requests queued for one model before reading stops.
+    size_t max_queue_depth = 64;
+  };
+
+  struct Stats {
+    /// Requests that ran, successfully or not.
+    uint64_t num_requests;
+    /// Batches that ran; num_requests / num_batches is the mean batch size.
+    uint64_t num_batches;
+    /// Times that a connection had to wait for space in a full queue.
+    uint64_t num_throttled;
+  };
+
+  explicit ModelServer(Config config);
+
+  /// Stops the server if it is running.
+  ~ModelServer();
+
+  ModelServer(const ModelServer&) = delete;
+  ModelServer& operator=(const ModelServer&) = delete;
+  ModelServer(ModelServer&&) = delete;
+  ModelServer& operator=(ModelServer&&) = delete;
+
+  /**
+   * Loads `num_instances` instances of a Method and serves them as `name`.
+   * Every instance gets its own memory, so they can run concurrently. Must be
+   * called before start().
+   *
+   * @param[in] name The name clients look the model up by. Shorter than
+   *     kMaxModelNameLength.
+   * @param[in] program The Program to load from. Must outlive the server.
+   * @param[in] method_name The Method to serve.
+   * @param[in] num_instances The size of the pool.
+   */
+  __ET_NODISCARD Error add_model(
+      const char* name,
+      Program* program,
+      const char* method_name = "forward",
+      size_t num_instances = 1);
+
+  /**
+   * Starts accepting connections on a Unix domain socket at `socket_path`,
+   * replacing any socket file already there.
+   */
+  __ET_NODISCARD Error start(const char* socket_path);
+
+  /**
+   * Closes all connections, waits for running requests to finish, and
+   * removes the socket file. Queued requests are dropped.
+   */
+  void stop();
+
+  Stats stats() const;
+
+ private:
+  // A Method and the memory it owns.
+  struct Instance {
+    MallocMemoryAllocator method_allocator;
+    MallocMemoryAllocator temp_allocator;
+    std::vector<std::vector<uint8_t>> planned_buffers;
+    std::vector<Span<uint8_t>> planned_spans;
+    std::unique_ptr<HierarchicalAllocator> planned_memory;
+    std::unique_ptr<MemoryManager> memory_manager;
+    std::unique_ptr<Method> method;
+    // Where each input is staged from the client's slot before executing.
+    // Empty for memory-planned inputs, which set_input() copies directly.
+    std::vector<Span<uint8_t>> input_buffers;
+  };
+
+  struct Connection {
+    explicit Connection(int socket) : socket(socket) {}
+    ~Connection();
+
+    const int socket;
+    // Set once by the reader before any request is queued.
+    std::unique_ptr<SharedTensorRing> ring;
+    std::mutex write_mutex;
+    std::thread reader;
+    // Set by the reader when it exits, so that its thread can be joined.
+    std::atomic<bool> finished{false};
+  };
+
+  struct Request {
+    std::shared_ptr<Connection> connection;
+    Message message;
+  };
+
+  struct Model {
+    std::string name;
+    std::vector<std::unique_ptr<Instance>> instances;
+    // Indices into instances; guarded by mutex_.
+    std::vector<size_t> free_instances;
+    std::deque<Request> queue;
+  };
+
+  void accept_loop();
+  void read_loop(std::shared_ptr<Connection> connection);
+  void worker_loop();
+
+  // Handles a request that needs no Method instance. Returns the response.
+  Message attach_ring(Connection& connection, const Message& request, int fd);
+  Message lookup(Connection& connection, const Message& request);
+
+  // Runs one kInfer request on `instance`. Returns the status to respond
+  // with.
+  Error run(Instance& instance, Connection& connection, uint32_t slot);
+
+  // Sends `responses` under the connection's write lock.
+  void respond(Connection& connection, const Message* responses, size_t count);
+
+  const Config config_;
+  std::string socket_path_;
+  int listen_socket_ = -1;
+  std::thread acceptor_;
+
+  std::vector<std::unique_ptr<Model>> models_;
+
+  mutable std::mutex mutex_;
+  // Signaled when work is queued or an instance is freed.
+  std::condition_variable work_cv_;
+  // Signaled when queue space is freed.
+  std::condition_variable space_cv_;
+  bool stopping_ = false;
+  // Round-robin position, so one busy model can't starve the others.
+  size_t next_model_ = 0;
+  std::vector<std::shared_ptr<Connection>> connections_;
+  std::vector<std::thread> workers_;
+
+  std::atomic<uint64_t> num_requests_{0};
+  std::atomic<uint64_t> num_batches_{0};
+  std::atomic<uint64_t> num_throttled_{0};
+};
+
+} // namespace util
+} // namespace executor
+} // namespace torch
@@ -0,0 +1,136 @@
+/*
+ * Copyright (c) Meta Platforms, Inc. and affiliates.
+ * All rights reserved.
+ *
+ * This source code is licensed under the BSD-style license found in the
+ * LICENSE file in the root directory of this source tree.
+ */
+
+#include <executorch/extension/server/protocol.h>
+
+#include <cerrno>
+#include <cstring>
+
+#include <sys/socket.h>
+#include <sys/uio.h>
+#include <unistd.h>
+
+#include <executorch/runtime/platform/log.h>
+
+namespace torch {
+namespace executor {
+namespace util {
+
+namespace {
+
+#if defined(MSG_NOSIGNAL)
+// Report a closed peer as EPIPE instead of raising SIGPIPE.
+constexpr int kSendFlags = MSG_NOSIGNAL;
+#else
+constexpr int kSendFlags = 0;
+#endif
+
+} // namespace
+
+Error send_messages(
+    int socket,
+    const Message* messages,
+    size_t count,
+    int fd) {
+  const uint8_t* data = reinterpret_cast<const uint8_t*>(messages);
+  size_t remaining = count * sizeof(Message);
+  bool send_fd = fd >= 0;
+  while (remaining > 0) {
+    struct iovec iov;
+    iov.iov_base = const_cast<uint8_t*>(data);
+    iov.iov_len = remaining;
+    struct msghdr msg;
+    std::memset(&msg, 0, sizeof(msg));
+    msg.msg_iov = &iov;
+    msg.msg_iovlen = 1;
+
+    alignas(struct cmsghdr) char control[CMSG_SPACE(sizeof(int))];
+    if (send_fd) {
+      std::memset(control, 0, sizeof(control));
+      msg.msg_control = control;
+      msg.msg_controllen = sizeof(control);
+      struct cmsghdr* cmsg = CMSG_FIRSTHDR(&msg);
+      cmsg->cmsg_level = SOL_SOCKET;
+      cmsg->cmsg_type = SCM_RIGHTS;
+      cmsg->cmsg_len = CMSG_LEN(sizeof(int));
+      std::memcpy(CMSG_DATA(cmsg), &fd, sizeof(int));
+    }
+
+    ssize_t sent = ::sendmsg(socket, &msg, kSendFlags);
+    if (sent < 0) {
+      if (errno == EINTR) {
+        continue;
+      }
+      ET_LOG(
+          Error, "Failed to send: %s (%d)", ::strerror(errno), errno);
+      return Error::AccessFailed;
+    }
+    // The descriptor goes out with the first byte.
+    send_fd = false;
+    data += sent;
+    remaining -= sent;
+  }
+  return Error::Ok;
+}
+
+Error receive_message(int socket, Message* message, int* fd) {
+  if (fd != nullptr) {
+    *fd = -1;
+  }
+  uint8_t* data = reinterpret_cast<uint8_t*>(message);
+  size_t received = 0;
+  while (received < sizeof(Message)) {
+    struct iovec iov;
+    iov.iov_base = data + received;
+    iov.iov_len = sizeof(Message) - received;
+    struct msghdr msg;
+    std::memset(&msg, 0, sizeof(msg));
+    msg.msg_iov = &iov;
+    msg.msg_iovlen = 1;
+    alignas(struct cmsghdr) char control[CMSG_SPACE(sizeof(int))];
+    msg.msg_control = control;
+    msg.msg_controllen = sizeof(control);
+
+    ssize_t n = ::recvmsg(socket, &msg, 0);
+    if (n < 0) {
+      if (errno == EINTR) {
+        continue;
+      }
+      ET_LOG(
+          Error, "Failed to receive: %s (%d)", ::strerror(errno), errno);
+      return Error::AccessFailed;
+    }
+    if (n == 0) {
+      if (received == 0) {
+        return Error::NotFound;
+      }
+      ET_LOG(Error, "Connection closed in the middle of a message");
+      return Error::AccessFailed;
+    }
+
+    for (struct cmsghdr* cmsg = CMSG_FIRSTHDR(&msg); cmsg != nullptr;
+         cmsg = CMSG_NXTHDR(&msg, cmsg)) {
+      if (cmsg->cmsg_level != SOL_SOCKET || cmsg->cmsg_type != SCM_RIGHTS) {
+        continue;
+      }
+      int received_fd;
+      std::memcpy(&received_fd, CMSG_DATA(cmsg), sizeof(int));
+      if (fd != nullptr && *fd < 0) {
+        *fd = received_fd;
+      } else {
+        ::close(received_fd);
+      }
+    }
+    received += n;
+  }
+  return Error::Ok;
+}
+
+} // namespace util
+} // namespace executor
+} // namespace torch
@@ -0,0 +1,84 @@
+/*
+ * Copyright (c) Meta Platforms, Inc. and affiliates.
+ * All rights reserved.
+ *
+ * This source code is licensed under the BSD-style license found in the
+ * LICENSE file in the root directory of this source tree.
+ */
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+
+#include <executorch/runtime/core/error.h>
+
+/**
+ * Messages exchanged by a ModelClient and a ModelServer over a Unix domain
+ * stream socket. Every message is a fixed-size Message; tensors travel through
+ * a SharedTensorRing instead.
+ *
+ * A session looks like:
+ *   1. kAttachRing, carrying the ring's file descriptor.
+ *   2. kLookup for every model the client wants to use.
+ *   3. Any number of kInfer, possibly many outstanding at once.
+ * The server answers each request with one kResponse carrying the same
+ * request_id. Responses to kInfer may arrive in any order.
+ */
+
+namespace torch {
+namespace executor {
+namespace util {
+
+/// The longest model name, including the terminating NUL.
+constexpr size_t kMaxModelNameLength = 64;
+
+enum class MessageType : uint32_t {
+  /// Maps the client's ring. `slot` holds the number of slots and `size` the
+  /// slot size; the file descriptor travels as ancillary data.
+  kAttachRing = 1,
+  /// Looks up `model_name`. The response carries its `model_id`, and `slot`
+  /// is filled with tensors shaped like the model's inputs.
+  kLookup = 2,
+  /// Runs `model_id` on the input tensors in `slot`. On success, the server
+  /// replaces them with the output tensors.
+  kInfer = 3,
+  /// Answers the request with the same `request_id`. `status` holds an Error.
+  kResponse = 4,
+};
+
+struct Message {
+  MessageType type;
+  uint32_t request_id;
+  uint32_t status;
+  uint32_t model_id;
+  uint32_t slot;
+  uint32_t reserved;
+  uint64_t size;
+  char model_name[kMaxModelNameLength];
+};
+
+/**
+ * Sends `count` messages at once, and `fd` as ancillary data if it is not
+ * negative.
+ *
+ * @retval Error::AccessFailed if the socket failed or was closed.
+ */
+__ET_NODISCARD Error
+send_messages(int socket, const Message* messages, size_t count, int fd = -1);
+
+/**
+ * Blocks until a whole message arrives.
+ *
+ * @param[out] fd If not null, receives a file descriptor sent along with the
+ *     message, or -1. Any other received descriptor is closed.
+ *
+ * @retval Error::NotFound if the peer closed the connection between messages.
+ * @retval Error::AccessFailed if the socket failed.
+ */
+__ET_NODISCARD Error
+receive_message(int socket, Message* message, int* fd = nullptr);
+
+} // namespace util
+} // namespace executor
+} // namespace torch
@@ -0,0 +1,165 @@
+/*
+ * Copyright (c) Meta Platforms, Inc. and affiliates.
+ * All rights reserved.
+ *
+ * This source code is licensed under the BSD-style license found in the
+ * LICENSE file in the root directory of this source tree.
+ */
+
+/**
+ * @file
+ *
+ * Serves models from .pte files to other processes on this machine until
+ * interrupted. For example:
+ *
+ *   model_server_main --socket_path=/tmp/et.sock \
+ *       --models=add=add.pte,mv2=mv2.pte:4
+ *
+ * serves add.pte with one Method instance and mv2.pte with four. Clients
+ * connect with ModelClient, or with the load_generator tool.
+ */
+
+#include <cinttypes>
+#include <csignal>
+#include <cstdlib>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include <gflags/gflags.h>
+
+#include <executorch/extension/data_loader/mmap_data_loader.h>
+#include <executorch/extension/server/model_server.h>
+#include <executorch/runtime/executor/program.h>
+#include <executorch/runtime/platform/log.h>
+#include <executorch/runtime/platform/runtime.h>
+
+DEFINE_string(
+    socket_path,
+    "/tmp/executorch_server.sock",
+    "Unix domain socket to listen on.");
+DEFINE_string(
+    models,
+    "",
+    "Comma-separated list of name=path.pte[:instances] to serve.");
+DEFINE_string(method_name, "forward", "Method to serve from every program.");
+DEFINE_int32(num_workers, 2, "Threads executing requests.");
+DEFINE_int32(max_batch_size, 8, "Most requests a worker takes at once.");
+DEFINE_int32(
+    max_queue_depth,
+    64,
+    "Most requests queued per model before clients are throttled.");
+
+using namespace torch::executor;
+using torch::executor::util::MmapDataLoader;
+using torch::executor::util::ModelServer;
+
+int main(int argc, char** argv) {
+  runtime_init();
+
+  gflags::ParseCommandLineFlags(&argc, &argv, true);
+  if (argc != 1 || FLAGS_models.empty()) {
+    ET_LOG(Error, "Usage: %s --models=name=path.pte[:instances],...", argv[0]);
+    return 1;
+  }
+
+  // Block the signals that stop the server before starting any thread, so
+  // that only sigwait() below receives them.
+  sigset_t stop_signals;
+  sigemptyset(&stop_signals);
+  sigaddset(&stop_signals, SIGINT);
+  sigaddset(&stop_signals, SIGTERM);
+  pthread_sigmask(SIG_BLOCK, &stop_signals, nullptr);
+
+  // Programs must outlive the server, so declare them first.
+  std::vector<std::unique_ptr<MmapDataLoader>> loaders;
+  std::vector<std::unique_ptr<Program>> programs;
+
+  ModelServer::Config config;
+  config.num_workers = FLAGS_num_workers;
+  config.max_batch_size = FLAGS_max_batch_size;
+  config.max_queue_depth = FLAGS_max_queue_depth;
+  ModelServer server(config);
+
+  std::string models = FLAGS_models;
+  size_t begin = 0;
+  while (begin < models.size()) {
+    size_t end = models.find(',', begin);
+    if (end == std::string::npos) {
+      end = models.size();
+    }
+    std::string spec = models.substr(begin, end - begin);
+    begin = end + 1;
+
+    size_t eq = spec.find('=');
+    if (eq == std::string::npos) {
+      ET_LOG(Error, "Expected name=path.pte[:instances], got %s", spec.c_str());
+      return 1;
+    }
+    std::string name = spec.substr(0, eq);
+    std::string path = spec.substr(eq + 1);
+    size_t num_instances = 1;
+    size_t colon = path.rfind(':');
+    if (colon != std::string::npos) {
+      num_instances = std::strtoul(path.c_str() + colon + 1, nullptr, 10);
+      path.resize(colon);
+    }
+
+    // Map the program instead of reading it, so that its data is shared
+    // with any other process serving the same file.
+    Result<MmapDataLoader> loader = MmapDataLoader::from(path.c_str());
+    if (!loader.ok()) {
+      ET_LOG(Error, "Failed to open %s", path.c_str());
+      return 1;
+    }
+    loaders.push_back(
+        std::make_unique<MmapDataLoader>(std::move(loader.get())));
+    Result<Program> program = Program::load(loaders.back().get());
+    if (!program.ok()) {
+      ET_LOG(Error, "Failed to parse %s", path.c_str());
+      return 1;
+    }
+    programs.push_back(std::make_unique<Program>(std::move(program.get())));
+
+    Error err = server.add_model(
+        name.c_str(),
+        programs.back().get(),
+        FLAGS_method_name.c_str(),
+        num_instances);
+    if (err != Error::Ok) {
+      ET_LOG(
+          Error,
+          "Failed to add model %s: 0x%" PRIx32,
+          name.c_str(),
+          static_cast<uint32_t>(err));
+      return 1;
+    }
+    ET_LOG(
+        Info,
+        "Serving %s from %s with %zu instances",
+        name.c_str(),
+        path.c_str(),
+        num_instances);
+  }
+
+  Error err = server.start(FLAGS_socket_path.c_str());
+  if (err != Error::Ok) {
+    ET_LOG(Error, "Failed to start: 0x%" PRIx32, static_cast<uint32_t>(err));
+    return 1;
+  }
+  ET_LOG(Info, "Listening on %s", FLAGS_socket_path.c_str());
+
+  int signal = 0;
+  sigwait(&stop_signals, &signal);
+  server.stop();
+
+  ModelServer::Stats stats = server.stats();
+  ET_LOG(
+      Info,
+      "Served %" PRIu64 " requests in %" PRIu64
+      " batches; throttled %" PRIu64 " times",
+      stats.num_requests,
+      stats.num_batches,
+      stats.num_throttled);
+  return 0;
+}
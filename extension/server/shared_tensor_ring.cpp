@@ -0,0 +1,314 @@
+/*
+ * Copyright (c) Meta Platforms, Inc. and affiliates.
+ * All rights reserved.
+ *
+ * This source code is licensed under the BSD-style license found in the
+ * LICENSE file in the root directory of this source tree.
+ */
+
+#include <executorch/extension/server/shared_tensor_ring.h>
+
+#include <atomic>
+#include <cerrno>
+#include <cinttypes>
+#include <cstdio>
+#include <cstring>
+#include <limits>
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include <executorch/runtime/core/exec_aten/util/scalar_type_util.h>
+#include <executorch/runtime/platform/log.h>
+
+namespace torch {
+namespace executor {
+namespace util {
+
+namespace {
+
+size_t align_up(size_t value, size_t alignment) {
+  return (value + alignment - 1) & ~(alignment - 1);
+}
+
+// Like elementSize(), but returns 0 instead of aborting on values that are
+// not a known ScalarType, since they come from another process.
+size_t element_size_or_zero(int32_t scalar_type) {
+#define ELEMENT_SIZE_CASE(ctype, name) \
+  case exec_aten::ScalarType::name:    \
+    return sizeof(ctype);
+
+  switch (static_cast<exec_aten::ScalarType>(scalar_type)) {
+    ET_FORALL_SCALAR_TYPES(ELEMENT_SIZE_CASE)
+    default:
+      return 0;
+  }
+#undef ELEMENT_SIZE_CASE
+}
+
+// Returns an unlinked shared-memory file descriptor, or -1.
+int create_shared_memory_fd() {
+#if defined(__linux__)
+  return ::memfd_create("executorch_tensor_ring", MFD_CLOEXEC);
+#else
+  // Without memfd, create a named object and unlink it right away; the name
+  // only needs to be unique for that instant.
+  static std::atomic<uint32_t> counter{0};
+  char name[64];
+  snprintf(
+      name,
+      sizeof(name),
+      "/et_ring_%d_%" PRIu32,
+      static_cast<int>(::getpid()),
+      counter++);
+  int fd = ::shm_open(name, O_RDWR | O_CREAT | O_EXCL, 0600);
+  if (fd >= 0) {
+    ::shm_unlink(name);
+  }
+  return fd;
+#endif
+}
+
+Result<uint8_t*> map(int fd, size_t size) {
+  void* base =
+      ::mmap(nullptr, size, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+  if (base == MAP_FAILED) {
+    ET_LOG(
+        Error,
+        "Failed to map %zu bytes of shared memory: %s (%d)",
+        size,
+        ::strerror(errno),
+        errno);
+    return Error::MemoryAllocationFailed;
+  }
+  return static_cast<uint8_t*>(base);
+}
+
+} // namespace
+
+Result<SharedTensorRing> SharedTensorRing::create(
+    uint32_t num_slots,
+    size_t slot_size) {
+  slot_size = align_up(slot_size, kSlotAlignment);
+  ET_CHECK_OR_RETURN_ERROR(
+      num_slots > 0 && slot_size >= sizeof(SlotHeader),
+      InvalidArgument,
+      "Need at least one slot of at least %zu bytes",
+      sizeof(SlotHeader));
+  ET_CHECK_OR_RETURN_ERROR(
+      slot_size <= std::numeric_limits<size_t>::max() / num_slots,
+      InvalidArgument,
+      "%" PRIu32 " slots of %zu bytes are too large",
+      num_slots,
+      slot_size);
+  const size_t mapping_size = num_slots * slot_size;
+
+  int fd = create_shared_memory_fd();
+  if (fd < 0) {
+    ET_LOG(
+        Error,
+        "Failed to create shared memory: %s (%d)",
+        ::strerror(errno),
+        errno);
+    return Error::AccessFailed;
+  }
+  if (::ftruncate(fd, mapping_size) != 0) {
+    ET_LOG(
+        Error,
+        "Failed to size shared memory to %zu bytes: %s (%d)",
+        mapping_size,
+        ::strerror(errno),
+        errno);
+    ::close(fd);
+    return Error::MemoryAllocationFailed;
+  }
+  Result<uint8_t*> base = map(fd, mapping_size);
+  if (!base.ok()) {
+    ::close(fd);
+    return base.error();
+  }
+  SharedTensorRing ring(fd, base.get(), mapping_size, num_slots, slot_size);
+  for (uint32_t slot = 0; slot < num_slots; ++slot) {
+    ring.clear(slot);
+  }
+  return ring;
+}
+
+Result<SharedTensorRing>
+SharedTensorRing::attach(int fd, uint32_t num_slots, size_t slot_size) {
+  slot_size = align_up(slot_size, kSlotAlignment);
+  struct stat st;
+  if (::fstat(fd, &st) != 0) {
+    ET_LOG(
+        Error,
+        "Could not get size of shared memory: %s (%d)",
+        ::strerror(errno),
+        errno);
+    ::close(fd);
+    return Error::AccessFailed;
+  }
+  if (num_slots == 0 || slot_size < sizeof(SlotHeader) ||
+      slot_size > std::numeric_limits<size_t>::max() / num_slots ||
+      static_cast<size_t>(st.st_size) < num_slots * slot_size) {
+    ET_LOG(
+        Error,
+        "Shared memory of %zu bytes can't hold %" PRIu32 " slots of %zu bytes",
+        static_cast<size_t>(st.st_size),
+        num_slots,
+        slot_size);
+    ::close(fd);
+    return Error::InvalidArgument;
+  }
+  const size_t mapping_size = num_slots * slot_size;
+  Result<uint8_t*> base = map(fd, mapping_size);
+  if (!base.ok()) {
+    ::close(fd);
+    return base.error();
+  }
+  return SharedTensorRing(fd, base.get(), mapping_size, num_slots, slot_size);
+}
+
+SharedTensorRing::SharedTensorRing(SharedTensorRing&& rhs) noexcept
+    : fd_(rhs.fd_),
+      base_(rhs.base_),
+      mapping_size_(rhs.mapping_size_),
+      num_slots_(rhs.num_slots_),
+      slot_size_(rhs.slot_size_) {
+  rhs.fd_ = -1;
+  rhs.base_ = nullptr;
+  rhs.mapping_size_ = 0;
+}
+
+SharedTensorRing::~SharedTensorRing() {
+  if (base_ != nullptr) {
+    ::munmap(base_, mapping_size_);
+  }
+  if (fd_ >= 0) {
+    ::close(fd_);
+  }
+}
+
+void SharedTensorRing::clear(uint32_t slot) {
+  if (slot < num_slots_) {
+    header(slot)->num_tensors = 0;
+  }
+}
+
+void* SharedTensorRing::add_tensor(
+    uint32_t slot,
+    exec_aten::ScalarType scalar_type,
+    ArrayRef<int32_t> sizes) {
+  if (slot >= num_slots_) {
+    ET_LOG(Error, "Slot %" PRIu32 " out of range", slot);
+    return nullptr;
+  }
+  SlotHeader* h = header(slot);
+  const uint32_t index = h->num_tensors;
+  size_t element_size = element_size_or_zero(static_cast<int32_t>(scalar_type));
+  if (index >= kMaxSlotTensors || sizes.size() > kMaxSlotTensorDim ||
+      element_size == 0) {
+    ET_LOG(
+        Error,
+        "Cannot add tensor %" PRIu32 " with %zu dims to slot %" PRIu32,
+        index,
+        sizes.size(),
+        slot);
+    return nullptr;
+  }
+
+  size_t numel = 1;
+  for (int32_t size : sizes) {
+    if (size < 0) {
+      ET_LOG(Error, "Negative size %" PRId32, size);
+      return nullptr;
+    }
+    numel *= size;
+  }
+  const size_t offset = index == 0
+      ? align_up(sizeof(SlotHeader), kSlotAlignment)
+      : align_up(
+            h->tensors[index - 1].offset + h->tensors[index - 1].nbytes,
+            kSlotAlignment);
+  const size_t nbytes = numel * element_size;
+  if (offset > slot_size_ || nbytes > slot_size_ - offset) {
+    ET_LOG(
+        Error,
+        "Tensor of %zu bytes does not fit in slot %" PRIu32 " (%zu bytes left)",
+        nbytes,
+        slot,
+        offset > slot_size_ ? 0 : slot_size_ - offset);
+    return nullptr;
+  }
+
+  SlotTensor& t = h->tensors[index];
+  t.scalar_type = static_cast<int32_t>(scalar_type);
+  t.dim = sizes.size();
+  for (size_t d = 0; d < sizes.size(); ++d) {
+    t.sizes[d] = sizes[d];
+  }
+  t.offset = offset;
+  t.nbytes = nbytes;
+  h->num_tensors = index + 1;
+  return slot_base(slot) + offset;
+}
+
+size_t SharedTensorRing::num_tensors(uint32_t slot) const {
+  if (slot >= num_slots_) {
+    return 0;
+  }
+  uint32_t n = header(slot)->num_tensors;
+  return n < kMaxSlotTensors ? n : kMaxSlotTensors;
+}
+
+Result<SlotTensor> SharedTensorRing::tensor(uint32_t slot, size_t index)
+    const {
+  ET_CHECK_OR_RETURN_ERROR(
+      slot < num_slots_ && index < num_tensors(slot),
+      InvalidArgument,
+      "No tensor %zu in slot %" PRIu32,
+      index,
+      slot);
+
+  // Copy first: the other process could change the shared description
+  // between checking and using it.
+  SlotTensor t;
+  std::memcpy(&t, &header(slot)->tensors[index], sizeof(t));
+
+  size_t element_size = element_size_or_zero(t.scalar_type);
+  ET_CHECK_OR_RETURN_ERROR(
+      element_size > 0 && t.dim <= kMaxSlotTensorDim,
+      InvalidArgument,
+      "Tensor %zu has unknown type %" PRId32 " or %" PRIu32 " dims",
+      index,
+      t.scalar_type,
+      t.dim);
+  uint64_t nbytes = element_size;
+  for (uint32_t d = 0; d < t.dim; ++d) {
+    ET_CHECK_OR_RETURN_ERROR(
+        t.sizes[d] >= 0 &&
+            (t.sizes[d] == 0 || nbytes <= slot_size_ / t.sizes[d]),
+        InvalidArgument,
+        "Tensor %zu has invalid size %" PRId32 " at dim %" PRIu32,
+        index,
+        t.sizes[d],
+        d);
+    nbytes *= t.sizes[d];
+  }
+  ET_CHECK_OR_RETURN_ERROR(
+      t.nbytes == nbytes && t.offset >= sizeof(SlotHeader) &&
+          t.offset % kSlotAlignment == 0 && t.offset <= slot_size_ &&
+          t.nbytes <= slot_size_ - t.offset,
+      InvalidArgument,
+      "Tensor %zu of %" PRIu64 " bytes at offset %" PRIu64
+      " does not fit slot",
+      index,
+      t.nbytes,
+      t.offset);
+  return t;
+}
+
+} // namespace util
+} // namespace executor
+} // namespace torch
@@ -0,0 +1,173 @@
+/*
+ * Copyright (c) Meta Platforms, Inc. and affiliates.
+ * All rights reserved.
+ *
+ * This source code is licensed under the BSD-style license found in the
+ * LICENSE file in the root directory of this source tree.
+ */
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+
+#include <executorch/runtime/core/array_ref.h>
+#include <executorch/runtime/core/error.h>
+#include <executorch/runtime/core/exec_aten/exec_aten.h>
+#include <executorch/runtime/core/result.h>
+
+namespace torch {
+namespace executor {
+namespace util {
+
+/// The most tensors that one slot can describe.
+constexpr size_t kMaxSlotTensors = 16;
+
+/// The most dimensions that a tensor in a slot can have.
+constexpr size_t kMaxSlotTensorDim = 16;
+
+/**
+ * Describes one tensor stored in a slot. Lives in shared memory, so a reader
+ * must validate it before trusting it; see SharedTensorRing::tensor().
+ */
+struct SlotTensor {
+  int32_t scalar_type;
+  uint32_t dim;
+  int32_t sizes[kMaxSlotTensorDim];
+  /// Where the data starts, relative to the start of the slot.
+  uint64_t offset;
+  uint64_t nbytes;
+};
+
+/// The start of every slot. Tensor data follows it.
+struct SlotHeader {
+  uint32_t num_tensors;
+  uint32_t reserved;
+  SlotTensor tensors[kMaxSlotTensors];
+};
+
+/**
+ * A shared-memory region split into fixed-size slots, each holding a list of
+ * tensors, through which a client and a ModelServer exchange tensor data
+ * without sending it over their socket.
+ *
+ * The client creates the ring and passes its file descriptor to the server.
+ * A slot belongs to the client until it sends a request naming it, and to the
+ * server until the response for that request arrives. Only the owner may
+ * touch a slot, so slots need no locking.
+ *
+ * Only available on POSIX systems.
+ */
+class SharedTensorRing final {
+ public:
+  /**
+   * Creates a new anonymous shared-memory ring.
+   *
+   * @param[in] num_slots The number of slots.
+   * @param[in] slot_size The size of each slot in bytes, including its
+   *     SlotHeader. Rounded up to a multiple of kSlotAlignment.
+   */
+  __ET_NODISCARD static Result<SharedTensorRing> create(
+      uint32_t num_slots,
+      size_t slot_size);
+
+  /**
+   * Maps a ring created by another process.
+   *
+   * @param[in] fd The ring's file descriptor. Ownership is taken even on
+   *     failure.
+   * @param[in] num_slots The number of slots the creator asked for.
+   * @param[in] slot_size The slot size the creator asked for.
+   *
+   * @retval Error::InvalidArgument if `fd` is too small for the ring.
+   */
+  __ET_NODISCARD static Result<SharedTensorRing>
+  attach(int fd, uint32_t num_slots, size_t slot_size);
+
+  SharedTensorRing(SharedTensorRing&& rhs) noexcept;
+  ~SharedTensorRing();
+
+  SharedTensorRing(const SharedTensorRing&) = delete;
+  SharedTensorRing& operator=(const SharedTensorRing&) = delete;
+  SharedTensorRing& operator=(SharedTensorRing&&) = delete;
+
+  /// The alignment of slots and of the tensor data within them.
+  static constexpr size_t kSlotAlignment = 64;
+
+  /// Returns the file descriptor to send to the other process.
+  int fd() const {
+    return fd_;
+  }
+
+  uint32_t num_slots() const {
+    return num_slots_;
+  }
+
+  size_t slot_size() const {
+    return slot_size_;
+  }
+
+  /// Removes all tensors from `slot`.
+  void clear(uint32_t slot);
+
+  /**
+   * Appends a tensor to `slot` and returns where to write its data, which
+   * is uninitialized.
+   *
+   * @returns The data pointer, or nullptr if the slot is full or `slot` is
+   *     out of range.
+   */
+  void* add_tensor(
+      uint32_t slot,
+      exec_aten::ScalarType scalar_type,
+      ArrayRef<int32_t> sizes);
+
+  /**
+   * Returns the number of tensors in `slot`, capped to kMaxSlotTensors.
+   */
+  size_t num_tensors(uint32_t slot) const;
+
+  /**
+   * Returns a validated copy of the description of a tensor in `slot`.
+   *
+   * @retval Error::InvalidArgument if `slot` or `index` is out of range, or
+   *     if the description is inconsistent or points outside the slot.
+   */
+  __ET_NODISCARD Result<SlotTensor> tensor(uint32_t slot, size_t index) const;
+
+  /// Returns the data of a tensor returned by tensor().
+  void* tensor_data(uint32_t slot, const SlotTensor& tensor) const {
+    return slot_base(slot) + tensor.offset;
+  }
+
+ private:
+  SharedTensorRing(
+      int fd,
+      uint8_t* base,
+      size_t mapping_size,
+      uint32_t num_slots,
+      size_t slot_size)
+      : fd_(fd),
+        base_(base),
+        mapping_size_(mapping_size),
+        num_slots_(num_slots),
+        slot_size_(slot_size) {}
+
+  uint8_t* slot_base(uint32_t slot) const {
+    return base_ + slot * slot_size_;
+  }
+
+  SlotHeader* header(uint32_t slot) const {
+    return reinterpret_cast<SlotHeader*>(slot_base(slot));
+  }
+
+  int fd_;
+  uint8_t* base_;
+  size_t mapping_size_;
+  uint32_t num_slots_;
+  size_t slot_size_;
+};
+
+} // namespace util
+} // namespace executor
+} // namespace torch
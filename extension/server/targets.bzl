@@ -0,0 +1,95 @@
+load("@fbsource//xplat/executorch/build:runtime_wrapper.bzl", "runtime")
+
+def define_common_targets():
+    """Defines targets that should be shared between fbcode and xplat.
+
+    The directory containing this targets.bzl file should also contain both
+    TARGETS and BUCK files that call this function.
+    """
+
+    # The ring and the wire format, shared by the server and its clients.
+    runtime.cxx_library(
+        name = "tensor_transport",
+        srcs = [
+            "protocol.cpp",
+            "shared_tensor_ring.cpp",
+        ],
+        exported_headers = [
+            "protocol.h",
+            "shared_tensor_ring.h",
+        ],
+        visibility = [
+            "//executorch/extension/server/...",
+            "@EXECUTORCH_CLIENTS",
+        ],
+        exported_deps = [
+            "//executorch/runtime/core:core",
+            "//executorch/runtime/core/exec_aten:lib",
+            "//executorch/runtime/core/exec_aten/util:scalar_type_util",
+        ],
+        deps = [
+            "//executorch/runtime/platform:platform",
+        ],
+    )
+
+    runtime.cxx_library(
+        name = "model_server",
+        srcs = ["model_server.cpp"],
+        exported_headers = ["model_server.h"],
+        visibility = [
+            "//executorch/extension/server/...",
+            "@EXECUTORCH_CLIENTS",
+        ],
+        exported_deps = [
+            ":tensor_transport",
+            "//executorch/extension/memory_allocator:malloc_memory_allocator",
+            "//executorch/runtime/core:core",
+            "//executorch/runtime/executor:program",
+        ],
+        deps = [
+            "//executorch/runtime/platform:platform",
+        ],
+    )
+
+    runtime.cxx_library(
+        name = "model_client",
+        srcs = ["model_client.cpp"],
+        exported_headers = ["model_client.h"],
+        visibility = [
+            "//executorch/extension/server/...",
+            "@EXECUTORCH_CLIENTS",
+        ],
+        exported_deps = [
+            ":tensor_transport",
+            "//executorch/runtime/core:core",
+        ],
+        deps = [
+            "//executorch/runtime/platform:platform",
+        ],
+    )
+
+    # Serves .pte files with the portable kernels. Link against other kernel
+    # or backend libraries by defining a new binary like this one.
+    runtime.cxx_binary(
+        name = "model_server_main",
+        srcs = ["server_main.cpp"],
+        deps = [
+            ":model_server",
+            "//executorch/extension/data_loader:mmap_data_loader",
+            "//executorch/kernels/portable:generated_lib_all_ops",
+        ],
+        external_deps = [
+            "gflags",
+        ],
+    )
+
+    runtime.cxx_binary(
+        name = "load_generator",
+        srcs = ["load_generator.cpp"],
+        deps = [
+            ":model_client",
+        ],
+        external_deps = [
+            "gflags",
+        ],
+    )
@@ -0,0 +1,196 @@
+/*
+ * Copyright (c) Meta Platforms, Inc. and affiliates.
+ * All rights reserved.
+ *
+ * This source code is licensed under the BSD-style license found in the
+ * LICENSE file in the root directory of this source tree.
+ */
+
+#include <algorithm>
+#include <cstdlib>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include <unistd.h>
+
+#include <executorch/extension/data_loader/file_data_loader.h>
+#include <executorch/extension/server/model_client.h>
+#include <executorch/extension/server/model_server.h>
+#include <executorch/runtime/executor/program.h>
+#include <executorch/runtime/platform/runtime.h>
+#include <gtest/gtest.h>
+
+using namespace ::testing;
+using torch::executor::Error;
+using torch::executor::Program;
+using torch::executor::Result;
+using torch::executor::util::FileDataLoader;
+using torch::executor::util::ModelClient;
+using torch::executor::util::ModelServer;
+using torch::executor::util::SharedTensorRing;
+using torch::executor::util::SlotTensor;
+
+constexpr size_t kSlotSize = 16 * 1024U;
+
+class ModelServerTest : public ::testing::Test {
+ protected:
+  void SetUp() override {
+    torch::executor::runtime_init();
+
+    // ModuleAdd takes a scalar alpha, which can't be sent over the ring.
+    // ModuleLinear computes 3 * x + 2.
+    for (const char* env : {"ET_MODULE_ADD_PATH", "ET_MODULE_LINEAR_PATH"}) {
+      Result<FileDataLoader> loader = FileDataLoader::from(std::getenv(env));
+      ASSERT_EQ(loader.error(), Error::Ok);
+      loaders_.push_back(
+          std::make_unique<FileDataLoader>(std::move(loader.get())));
+
+      Result<Program> program = Program::load(
+          loaders_.back().get(), Program::Verification::InternalConsistency);
+      ASSERT_EQ(program.error(), Error::Ok);
+      programs_.push_back(std::make_unique<Program>(std::move(program.get())));
+    }
+
+    socket_path_ = "/tmp/model_server_test." + std::to_string(getpid());
+  }
+
+  void start(ModelServer& server, size_t num_instances) {
+    ASSERT_EQ(
+        server.add_model("add", programs_[0].get(), "forward", num_instances),
+        Error::Ok);
+    ASSERT_EQ(
+        server.add_model(
+            "linear", programs_[1].get(), "forward", num_instances),
+        Error::Ok);
+    ASSERT_EQ(server.start(socket_path_.c_str()), Error::Ok);
+  }
+
+  // Fills every input in `slot` with ones.
+  static void fill_inputs(SharedTensorRing& ring, uint32_t slot) {
+    for (size_t i = 0; i < ring.num_tensors(slot); ++i) {
+      Result<SlotTensor> input = ring.tensor(slot, i);
+      ASSERT_EQ(input.error(), Error::Ok);
+      auto data = static_cast<float*>(ring.tensor_data(slot, input.get()));
+      std::fill_n(data, input->nbytes / sizeof(float), 1.0f);
+    }
+  }
+
+  static float output(SharedTensorRing& ring, uint32_t slot) {
+    Result<SlotTensor> out = ring.tensor(slot, 0);
+    EXPECT_EQ(out.error(), Error::Ok);
+    return static_cast<float*>(ring.tensor_data(slot, out.get()))[0];
+  }
+
+ private:
+  // Must outlive programs_, but tests shouldn't need to touch them.
+  std::vector<std::unique_ptr<FileDataLoader>> loaders_;
+
+ protected:
+  std::vector<std::unique_ptr<Program>> programs_;
+  std::string socket_path_;
+};
+
+TEST_F(ModelServerTest, InferRunsTheModel) {
+  ModelServer server(ModelServer::Config{});
+  start(server, 1);
+
+  Result<ModelClient> client =
+      ModelClient::connect(socket_path_.c_str(), 1, kSlotSize);
+  ASSERT_EQ(client.error(), Error::Ok);
+  SharedTensorRing& ring = client->ring();
+
+  Result<uint32_t> linear = client->lookup("linear", 0);
+  ASSERT_EQ(linear.error(), Error::Ok);
+  ASSERT_EQ(ring.num_tensors(0), 1);
+  EXPECT_EQ(ring.tensor(0, 0)->dim, 2);
+
+  for (int i = 0; i < 3; ++i) {
+    fill_inputs(ring, 0);
+    ASSERT_EQ(client->infer(linear.get(), 0), Error::Ok);
+    ASSERT_EQ(ring.num_tensors(0), 1);
+    EXPECT_FLOAT_EQ(output(ring, 0), 5.0f);
+  }
+
+  server.stop();
+  EXPECT_EQ(server.stats().num_requests, 3);
+}
+
+TEST_F(ModelServerTest, ManyOutstandingRequestsAreThrottled) {
+  ModelServer::Config config;
+  config.num_workers = 2;
+  config.max_batch_size = 4;
+  config.max_queue_depth = 1;
+  ModelServer server(config);
+  start(server, 2);
+
+  constexpr uint32_t kNumSlots = 8;
+  std::vector<ModelClient> clients;
+  for (int i = 0; i < 2; ++i) {
+    Result<ModelClient> client =
+        ModelClient::connect(socket_path_.c_str(), kNumSlots, kSlotSize);
+    ASSERT_EQ(client.error(), Error::Ok);
+    clients.push_back(std::move(client.get()));
+  }
+
+  for (ModelClient& client : clients) {
+    uint32_t linear = 0;
+    for (uint32_t slot = 0; slot < kNumSlots; ++slot) {
+      Result<uint32_t> id = client.lookup("linear", slot);
+      ASSERT_EQ(id.error(), Error::Ok);
+      linear = id.get();
+      fill_inputs(client.ring(), slot);
+    }
+    for (uint32_t slot = 0; slot < kNumSlots; ++slot) {
+      ASSERT_EQ(client.infer_async(linear, slot).error(), Error::Ok);
+    }
+  }
+
+  for (ModelClient& client : clients) {
+    std::vector<bool> answered(kNumSlots, false);
+    for (uint32_t i = 0; i < kNumSlots; ++i) {
+      Result<ModelClient::Response> response = client.wait();
+      ASSERT_EQ(response.error(), Error::Ok);
+      EXPECT_EQ(response->status, Error::Ok);
+      ASSERT_LT(response->slot, kNumSlots);
+      EXPECT_FALSE(answered[response->slot]);
+      answered[response->slot] = true;
+      EXPECT_FLOAT_EQ(output(client.ring(), response->slot), 5.0f);
+    }
+    EXPECT_EQ(client.wait().error(), Error::InvalidState);
+  }
+
+  server.stop();
+  ModelServer::Stats stats = server.stats();
+  EXPECT_EQ(stats.num_requests, 2 * kNumSlots);
+  EXPECT_GE(stats.num_requests, stats.num_batches);
+}
+
+TEST_F(ModelServerTest, BadRequestsFail) {
+  ModelServer server(ModelServer::Config{});
+  start(server, 1);
+
+  Result<ModelClient> client =
+      ModelClient::connect(socket_path_.c_str(), 1, kSlotSize);
+  ASSERT_EQ(client.error(), Error::Ok);
+
+  EXPECT_EQ(client->lookup("missing", 0).error(), Error::NotFound);
+  EXPECT_EQ(client->lookup("add", 0).error(), Error::NotSupported);
+  EXPECT_EQ(client->lookup("linear", 1).error(), Error::InvalidState);
+
+  // Inputs that don't match the Method fail the request, not the connection.
+  Result<uint32_t> linear = client->lookup("linear", 0);
+  ASSERT_EQ(linear.error(), Error::Ok);
+  client->ring().clear(0);
+  EXPECT_EQ(client->infer(linear.get(), 0), Error::InvalidArgument);
+  EXPECT_EQ(client->infer(linear.get() + 100, 0), Error::NotFound);
+
+  ASSERT_EQ(client->lookup("linear", 0).error(), Error::Ok);
+  fill_inputs(client->ring(), 0);
+  ASSERT_EQ(client->infer(linear.get(), 0), Error::Ok);
+  EXPECT_FLOAT_EQ(output(client->ring(), 0), 5.0f);
+
+  // Models can only be added before starting.
+  EXPECT_EQ(
+      server.add_model("late", programs_[1].get()), Error::InvalidState);
+}
@@ -0,0 +1,164 @@
+/*
+ * Copyright (c) Meta Platforms, Inc. and affiliates.
+ * All rights reserved.
+ *
+ * This source code is licensed under the BSD-style license found in the
+ * LICENSE file in the root directory of this source tree.
+ */
+
+#include <cstring>
+
+#include <sys/socket.h>
+#include <unistd.h>
+
+#include <executorch/extension/server/protocol.h>
+#include <executorch/extension/server/shared_tensor_ring.h>
+#include <executorch/runtime/platform/runtime.h>
+#include <gtest/gtest.h>
+
+using namespace ::testing;
+using exec_aten::ScalarType;
+using torch::executor::Error;
+using torch::executor::ArrayRef;
+using torch::executor::Result;
+using torch::executor::util::MessageType;
+using torch::executor::util::receive_message;
+using torch::executor::util::send_messages;
+using torch::executor::util::SharedTensorRing;
+using torch::executor::util::SlotHeader;
+using torch::executor::util::SlotTensor;
+
+class SharedTensorRingTest : public ::testing::Test {
+ protected:
+  void SetUp() override {
+    torch::executor::runtime_init();
+  }
+};
+
+TEST_F(SharedTensorRingTest, AddedTensorsReadBack) {
+  Result<SharedTensorRing> ring = SharedTensorRing::create(2, 4096);
+  ASSERT_EQ(ring.error(), Error::Ok);
+  EXPECT_EQ(ring->num_slots(), 2);
+  EXPECT_EQ(ring->num_tensors(0), 0);
+
+  int32_t sizes[] = {2, 3};
+  auto data = static_cast<float*>(
+      ring->add_tensor(0, ScalarType::Float, ArrayRef<int32_t>(sizes, 2)));
+  ASSERT_NE(data, nullptr);
+  EXPECT_EQ(reinterpret_cast<uintptr_t>(data) % 64, 0);
+  for (int i = 0; i < 6; ++i) {
+    data[i] = i;
+  }
+  ASSERT_NE(
+      ring->add_tensor(0, ScalarType::Long, ArrayRef<int32_t>()), nullptr);
+
+  ASSERT_EQ(ring->num_tensors(0), 2);
+  EXPECT_EQ(ring->num_tensors(1), 0);
+  Result<SlotTensor> t = ring->tensor(0, 0);
+  ASSERT_EQ(t.error(), Error::Ok);
+  EXPECT_EQ(t->scalar_type, static_cast<int32_t>(ScalarType::Float));
+  EXPECT_EQ(t->dim, 2);
+  EXPECT_EQ(t->sizes[1], 3);
+  EXPECT_EQ(t->nbytes, 6 * sizeof(float));
+  EXPECT_EQ(ring->tensor_data(0, t.get()), data);
+  Result<SlotTensor> scalar = ring->tensor(0, 1);
+  ASSERT_EQ(scalar.error(), Error::Ok);
+  EXPECT_EQ(scalar->nbytes, sizeof(int64_t));
+
+  ring->clear(0);
+  EXPECT_EQ(ring->num_tensors(0), 0);
+  EXPECT_EQ(ring->tensor(0, 0).error(), Error::InvalidArgument);
+}
+
+TEST_F(SharedTensorRingTest, TensorsMustFitTheSlot) {
+  Result<SharedTensorRing> ring = SharedTensorRing::create(1, 4096);
+  ASSERT_EQ(ring.error(), Error::Ok);
+  int32_t sizes[] = {1024};
+  EXPECT_EQ(
+      ring->add_tensor(0, ScalarType::Float, ArrayRef<int32_t>(sizes, 1)),
+      nullptr);
+  // Out of range.
+  EXPECT_EQ(
+      ring->add_tensor(1, ScalarType::Float, ArrayRef<int32_t>(sizes, 1)),
+      nullptr);
+  EXPECT_EQ(ring->num_tensors(0), 0);
+
+  EXPECT_EQ(
+      SharedTensorRing::create(1, sizeof(SlotHeader) / 2).error(),
+      Error::InvalidArgument);
+  EXPECT_EQ(SharedTensorRing::create(0, 4096).error(), Error::InvalidArgument);
+}
+
+TEST_F(SharedTensorRingTest, CorruptDescriptionsAreRejected) {
+  Result<SharedTensorRing> ring = SharedTensorRing::create(1, 4096);
+  ASSERT_EQ(ring.error(), Error::Ok);
+  int32_t sizes[] = {4};
+  ASSERT_NE(
+      ring->add_tensor(0, ScalarType::Float, ArrayRef<int32_t>(sizes, 1)),
+      nullptr);
+
+  // Another process can write anything into the shared header.
+  auto header = reinterpret_cast<SlotHeader*>(
+      static_cast<uint8_t*>(
+          ring->tensor_data(0, ring->tensor(0, 0).get())) -
+      ring->tensor(0, 0)->offset);
+  SlotTensor saved = header->tensors[0];
+
+  header->tensors[0].offset = 4096 - 8;
+  EXPECT_EQ(ring->tensor(0, 0).error(), Error::InvalidArgument);
+  header->tensors[0] = saved;
+  header->tensors[0].nbytes = 1;
+  EXPECT_EQ(ring->tensor(0, 0).error(), Error::InvalidArgument);
+  header->tensors[0] = saved;
+  header->tensors[0].scalar_type = 1000;
+  EXPECT_EQ(ring->tensor(0, 0).error(), Error::InvalidArgument);
+  header->tensors[0] = saved;
+  header->tensors[0].sizes[0] = 1 << 30;
+  EXPECT_EQ(ring->tensor(0, 0).error(), Error::InvalidArgument);
+  header->tensors[0] = saved;
+  EXPECT_EQ(ring->tensor(0, 0).error(), Error::Ok);
+}
+
+TEST_F(SharedTensorRingTest, AttachedRingSharesMemory) {
+  Result<SharedTensorRing> ring = SharedTensorRing::create(2, 4096);
+  ASSERT_EQ(ring.error(), Error::Ok);
+
+  // Pass the descriptor the way a client does.
+  int sockets[2];
+  ASSERT_EQ(socketpair(AF_UNIX, SOCK_STREAM, 0, sockets), 0);
+  torch::executor::util::Message message;
+  std::memset(&message, 0, sizeof(message));
+  message.type = MessageType::kAttachRing;
+  message.slot = ring->num_slots();
+  message.size = ring->slot_size();
+  ASSERT_EQ(send_messages(sockets[0], &message, 1, ring->fd()), Error::Ok);
+  torch::executor::util::Message received;
+  int fd = -1;
+  ASSERT_EQ(receive_message(sockets[1], &received, &fd), Error::Ok);
+  EXPECT_EQ(received.type, MessageType::kAttachRing);
+  ASSERT_GE(fd, 0);
+
+  Result<SharedTensorRing> attached =
+      SharedTensorRing::attach(fd, received.slot, received.size);
+  ASSERT_EQ(attached.error(), Error::Ok);
+  int32_t sizes[] = {3};
+  auto data = static_cast<int32_t*>(
+      ring->add_tensor(1, ScalarType::Int, ArrayRef<int32_t>(sizes, 1)));
+  ASSERT_NE(data, nullptr);
+  data[2] = 42;
+  ASSERT_EQ(attached->num_tensors(1), 1);
+  Result<SlotTensor> t = attached->tensor(1, 0);
+  ASSERT_EQ(t.error(), Error::Ok);
+  EXPECT_EQ(static_cast<int32_t*>(attached->tensor_data(1, t.get()))[2], 42);
+
+  // A ring can't claim more slots than the memory holds.
+  int dup_fd = dup(ring->fd());
+  EXPECT_EQ(
+      SharedTensorRing::attach(dup_fd, 3, ring->slot_size()).error(),
+      Error::InvalidArgument);
+
+  // Closing the peer ends the stream between messages.
+  ::close(sockets[0]);
+  EXPECT_EQ(receive_message(sockets[1], &received), Error::NotFound);
+  ::close(sockets[1]);
+}
@@ -0,0 +1,37 @@
+load("@fbsource//xplat/executorch/build:runtime_wrapper.bzl", "runtime")
+
+def define_common_targets(is_fbcode = False):
+    """Defines targets that should be shared between fbcode and xplat.
+
+    The directory containing this targets.bzl file should also contain both
+    TARGETS and BUCK files that call this function.
+    """
+
+    runtime.cxx_test(
+        name = "shared_tensor_ring_test",
+        srcs = [
+            "shared_tensor_ring_test.cpp",
+        ],
+        deps = [
+            "//executorch/extension/server:tensor_transport",
+        ],
+    )
+
+    # The server test loads program files from fbcode, so it only runs there.
+    if not runtime.is_oss and is_fbcode:
+        runtime.cxx_test(
+            name = "model_server_test",
+            srcs = [
+                "model_server_test.cpp",
+            ],
+            deps = [
+                "//executorch/extension/server:model_client",
+                "//executorch/extension/server:model_server",
+                "//executorch/extension/data_loader:file_data_loader",
+                "//executorch/kernels/portable:generated_lib",
+            ],
+            env = {
+                "ET_MODULE_ADD_PATH": "$(location fbcode//executorch/test/models:exported_programs[ModuleAdd.pte])",
+                "ET_MODULE_LINEAR_PATH": "$(location fbcode//executorch/test/models:exported_programs[ModuleLinear.pte])",
+            },
+        )
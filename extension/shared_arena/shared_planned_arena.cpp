@@ -0,0 +1,114 @@
+/*
+ * Copyright (c) Meta Platforms, Inc. and affiliates.
+ * All rights reserved.
+ *
+ * This source code is licensed under the BSD-style license found in the
+ * LICENSE file in the root directory of this source tree.
+ */
+
+#include <executorch/extension/shared_arena/shared_planned_arena.h>
+
+#include <algorithm>
+#include <cinttypes>
+
+#include <executorch/runtime/platform/log.h>
+
+namespace torch {
+namespace executor {
+namespace util {
+
+Error SharedPlannedArena::reserve(const MethodMeta& method_meta) {
+  ET_CHECK_OR_RETURN_ERROR(
+      planned_memory_ == nullptr,
+      InvalidState,
+      "Cannot reserve after the shared buffers were allocated");
+
+  const size_t num_buffers = method_meta.num_memory_planned_buffers();
+  if (buffer_sizes_.size() < num_buffers) {
+    buffer_sizes_.resize(num_buffers, 0);
+  }
+  for (size_t id = 0; id < num_buffers; ++id) {
+    Result<int64_t> size = method_meta.memory_planned_buffer_size(id);
+    if (!size.ok()) {
+      return size.error();
+    }
+    buffer_sizes_[id] =
+        std::max(buffer_sizes_[id], static_cast<size_t>(size.get()));
+    unshared_planned_size_ += static_cast<size_t>(size.get());
+  }
+  return Error::Ok;
+}
+
+HierarchicalAllocator* SharedPlannedArena::planned_memory() {
+  if (planned_memory_ == nullptr) {
+    buffers_.reserve(buffer_sizes_.size());
+    spans_.reserve(buffer_sizes_.size());
+    for (size_t size : buffer_sizes_) {
+      buffers_.emplace_back(size);
+      spans_.push_back({buffers_.back().data(), size});
+    }
+    planned_memory_ = std::make_unique<HierarchicalAllocator>(
+        Span<Span<uint8_t>>(spans_.data(), spans_.size()));
+  }
+  return planned_memory_.get();
+}
+
+Error SharedPlannedArena::add(Method& method) {
+  ET_CHECK_OR_RETURN_ERROR(
+      planned_memory_ != nullptr,
+      InvalidState,
+      "Methods must be loaded with planned_memory() before being added");
+  ET_CHECK_OR_RETURN_ERROR(
+      std::find(methods_.begin(), methods_.end(), &method) == methods_.end(),
+      InvalidArgument,
+      "Method was already added");
+
+  Error err = method.experimental_relocate_planned_io(&io_allocator_);
+  if (err != Error::Ok) {
+    ET_LOG(
+        Error,
+        "Moving inputs and outputs out of the shared buffers failed: 0x%" PRIx32,
+        static_cast<uint32_t>(err));
+    return err;
+  }
+  methods_.push_back(&method);
+  return Error::Ok;
+}
+
+Error SharedPlannedArena::activate(Method& method) {
+  if (active_ == &method) {
+    return Error::Ok;
+  }
+  ET_CHECK_OR_RETURN_ERROR(
+      std::find(methods_.begin(), methods_.end(), &method) != methods_.end(),
+      InvalidArgument,
+      "Method was not added to the arena");
+  if (active_ != nullptr) {
+    Error err = active_->experimental_cancel_execution();
+    if (err != Error::Ok) {
+      return err;
+    }
+  }
+  active_ = &method;
+  return Error::Ok;
+}
+
+Error SharedPlannedArena::execute(Method& method) {
+  Error err = activate(method);
+  if (err != Error::Ok) {
+    return err;
+  }
+  return method.execute();
+}
+
+size_t SharedPlannedArena::planned_size() const {
+  size_t total = 0;
+  for (size_t size : buffer_sizes_) {
+    total += size;
+  }
+  return total;
+}
+
+} // namespace util
+} // namespace executor
+} // namespace torch
@@ -0,0 +1,116 @@
+/*
+ * Copyright (c) Meta Platforms, Inc. and affiliates.
+ * All rights reserved.
+ *
+ * This source code is licensed under the BSD-style license found in the
+ * LICENSE file in the root directory of this source tree.
+ */
+
+#pragma once
+
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+#include <executorch/extension/memory_allocator/malloc_memory_allocator.h>
+#include <executorch/runtime/core/error.h>
+#include <executorch/runtime/core/hierarchical_allocator.h>
+#include <executorch/runtime/core/span.h>
+#include <executorch/runtime/executor/method.h>
+#include <executorch/runtime/executor/method_meta.h>
+
+namespace torch {
+namespace executor {
+namespace util {
+
+/**
+ * One set of memory-planned buffers shared by several Methods, possibly from
+ * different Programs, that execute one at a time on the same thread.
+ *
+ * Each buffer is as large as the largest corresponding buffer of the Methods,
+ * instead of every Method holding its own. Inputs and outputs must survive
+ * between executions, so they are moved into memory private to each Method
+ * when it is added; everything left in the shared buffers is an intermediate
+ * value that the next Method to execute may overwrite.
+ *
+ * Usage:
+ *   1. reserve() every Method's MethodMeta.
+ *   2. Load every Method with a MemoryManager that uses planned_memory().
+ *   3. add() every Method.
+ *   4. Set inputs as usual, and execute through execute() or activate().
+ *
+ * Not thread-safe: all Methods must be executed from one thread at a time.
+ */
+class SharedPlannedArena final {
+ public:
+  SharedPlannedArena() = default;
+
+  SharedPlannedArena(const SharedPlannedArena&) = delete;
+  SharedPlannedArena& operator=(const SharedPlannedArena&) = delete;
+  SharedPlannedArena(SharedPlannedArena&&) = delete;
+  SharedPlannedArena& operator=(SharedPlannedArena&&) = delete;
+
+  /**
+   * Grows the shared buffers so that the Method described by `method_meta`
+   * fits in them.
+   *
+   * @retval Error::InvalidState if planned_memory() was already called.
+   */
+  __ET_NODISCARD Error reserve(const MethodMeta& method_meta);
+
+  /**
+   * Returns the shared buffers, allocating them on the first call. Pass it to
+   * the MemoryManager of every Method reserved above. Lives as long as the
+   * arena.
+   */
+  HierarchicalAllocator* planned_memory();
+
+  /**
+   * Moves the memory-planned inputs and outputs of `method` into memory owned
+   * by the arena. `method` must have been loaded with planned_memory(), and
+   * must outlive the arena or be executed through it no more.
+   */
+  __ET_NODISCARD Error add(Method& method);
+
+  /**
+   * Makes `method` the one using the shared buffers. If another Method was
+   * using them and stopped partway through a step-wise execution, that
+   * execution is abandoned, since its intermediates are about to be
+   * overwritten; its next execution starts from the beginning.
+   *
+   * Only needed when driving `method` with `experimental_step()`;
+   * execute() calls it.
+   *
+   * @retval Error::InvalidArgument if `method` was not added.
+   */
+  __ET_NODISCARD Error activate(Method& method);
+
+  /// Activates and executes `method`.
+  __ET_NODISCARD Error execute(Method& method);
+
+  /// Returns the total size of the shared buffers in bytes.
+  size_t planned_size() const;
+
+  /// Returns the total size that the reserved Methods' buffers would take
+  /// without sharing, in bytes.
+  size_t unshared_planned_size() const {
+    return unshared_planned_size_;
+  }
+
+ private:
+  std::vector<size_t> buffer_sizes_;
+  size_t unshared_planned_size_ = 0;
+
+  std::vector<std::vector<uint8_t>> buffers_;
+  std::vector<Span<uint8_t>> spans_;
+  std::unique_ptr<HierarchicalAllocator> planned_memory_;
+
+  /// Holds the inputs and outputs of the added Methods.
+  MallocMemoryAllocator io_allocator_;
+  std::vector<Method*> methods_;
+  Method* active_ = nullptr;
+};
+
+} // namespace util
+} // namespace executor
+} // namespace torch
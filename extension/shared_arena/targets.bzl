@@ -0,0 +1,30 @@
+load("@fbsource//xplat/executorch/build:runtime_wrapper.bzl", "runtime")
+
+def define_common_targets():
+    """Defines targets that should be shared between fbcode and xplat.
+
+    The directory containing this targets.bzl file should also contain both
+    TARGETS and BUCK files that call this function.
+    """
+
+    for aten_mode in (True, False):
+        aten_suffix = ("_aten" if aten_mode else "")
+
+        runtime.cxx_library(
+            name = "shared_planned_arena" + aten_suffix,
+            srcs = ["shared_planned_arena.cpp"],
+            exported_headers = ["shared_planned_arena.h"],
+            visibility = [
+                "//executorch/examples/...",
+                "//executorch/extension/shared_arena/test/...",
+                "@EXECUTORCH_CLIENTS",
+            ],
+            exported_deps = [
+                "//executorch/extension/memory_allocator:malloc_memory_allocator",
+                "//executorch/runtime/core:core",
+                "//executorch/runtime/executor:program" + aten_suffix,
+            ],
+            deps = [
+                "//executorch/runtime/platform:platform",
+            ],
+        )
@@ -0,0 +1,262 @@
+/*
+ * Copyright (c) Meta Platforms, Inc. and affiliates.
+ * All rights reserved.
+ *
+ * This source code is licensed under the BSD-style license found in the
+ * LICENSE file in the root directory of this source tree.
+ */
+
+#include <algorithm>
+#include <cstdlib>
+#include <cstring>
+#include <memory>
+#include <vector>
+
+#include <executorch/extension/data_loader/file_data_loader.h>
+#include <executorch/extension/shared_arena/shared_planned_arena.h>
+#include <executorch/runtime/core/memory_allocator.h>
+#include <executorch/runtime/executor/memory_manager.h>
+#include <executorch/runtime/executor/method.h>
+#include <executorch/runtime/executor/program.h>
+#include <executorch/runtime/platform/runtime.h>
+#include <executorch/util/util.h>
+#include <gtest/gtest.h>
+
+using namespace ::testing;
+using torch::executor::Error;
+using torch::executor::MemoryAllocator;
+using torch::executor::MemoryManager;
+using torch::executor::Method;
+using torch::executor::MethodMeta;
+using torch::executor::Program;
+using torch::executor::Result;
+using torch::executor::Span;
+using torch::executor::util::FileDataLoader;
+using torch::executor::util::SharedPlannedArena;
+
+constexpr size_t kDefaultRuntimeMemBytes = 32 * 1024U;
+
+class SharedPlannedArenaTest : public ::testing::Test {
+ protected:
+  void SetUp() override {
+    torch::executor::runtime_init();
+
+    // ModuleAdd computes x + alpha * y, ModuleLinear computes 3 * x + 2
+    // through an intermediate tensor, and ModuleMap stacks xs[i] + y in a
+    // loop.
+    for (const char* env :
+         {"ET_MODULE_ADD_PATH",
+          "ET_MODULE_LINEAR_PATH",
+          "ET_MODULE_MAP_PATH"}) {
+      Result<FileDataLoader> loader = FileDataLoader::from(std::getenv(env));
+      ASSERT_EQ(loader.error(), Error::Ok);
+      loaders_.push_back(
+          std::make_unique<FileDataLoader>(std::move(loader.get())));
+
+      Result<Program> program = Program::load(
+          loaders_.back().get(), Program::Verification::InternalConsistency);
+      ASSERT_EQ(program.error(), Error::Ok);
+      programs_.push_back(std::make_unique<Program>(std::move(program.get())));
+    }
+  }
+
+  // Loads the forward method of every program into `arena`.
+  void load_methods(SharedPlannedArena& arena) {
+    for (auto& program : programs_) {
+      Result<MethodMeta> meta = program->method_meta("forward");
+      ASSERT_EQ(meta.error(), Error::Ok);
+      ASSERT_EQ(arena.reserve(meta.get()), Error::Ok);
+    }
+    for (auto& program : programs_) {
+      method_pools_.push_back(std::make_unique<std::vector<uint8_t>>(
+          kDefaultRuntimeMemBytes));
+      method_allocators_.push_back(std::make_unique<MemoryAllocator>(
+          kDefaultRuntimeMemBytes, method_pools_.back()->data()));
+      memory_managers_.push_back(std::make_unique<MemoryManager>(
+          method_allocators_.back().get(), arena.planned_memory()));
+
+      Result<Method> method =
+          program->load_method("forward", memory_managers_.back().get());
+      ASSERT_EQ(method.error(), Error::Ok);
+      methods_.push_back(std::make_unique<Method>(std::move(method.get())));
+      ASSERT_EQ(arena.add(*methods_.back()), Error::Ok);
+      inputs_.push_back(
+          torch::executor::util::PrepareInputTensors(*methods_.back()));
+    }
+  }
+
+  // Returns the shared buffers, which are as large as the largest
+  // corresponding buffer of the programs.
+  std::vector<Span<uint8_t>> shared_buffers(SharedPlannedArena& arena) {
+    std::vector<size_t> sizes;
+    for (auto& program : programs_) {
+      Result<MethodMeta> meta = program->method_meta("forward");
+      EXPECT_EQ(meta.error(), Error::Ok);
+      const size_t num_buffers = meta->num_memory_planned_buffers();
+      sizes.resize(std::max(sizes.size(), num_buffers), 0);
+      for (size_t id = 0; id < num_buffers; ++id) {
+        sizes[id] = std::max(
+            sizes[id],
+            static_cast<size_t>(meta->memory_planned_buffer_size(id).get()));
+      }
+    }
+    std::vector<Span<uint8_t>> buffers;
+    for (size_t id = 0; id < sizes.size(); ++id) {
+      Result<void*> data =
+          arena.planned_memory()->get_offset_address(id, 0, sizes[id]);
+      EXPECT_EQ(data.error(), Error::Ok);
+      buffers.push_back({static_cast<uint8_t*>(data.get()), sizes[id]});
+    }
+    return buffers;
+  }
+
+  void TearDown() override {
+    for (auto& inputs : inputs_) {
+      torch::executor::util::FreeInputs(inputs);
+    }
+  }
+
+  float output(size_t method_idx) {
+    return methods_[method_idx]
+        ->get_output(0)
+        .toTensor()
+        .const_data_ptr<float>()[0];
+  }
+
+ private:
+  // Must outlive programs_, but tests shouldn't need to touch them.
+  std::vector<std::unique_ptr<FileDataLoader>> loaders_;
+  std::vector<std::unique_ptr<std::vector<uint8_t>>> method_pools_;
+  std::vector<std::unique_ptr<MemoryAllocator>> method_allocators_;
+  std::vector<std::unique_ptr<MemoryManager>> memory_managers_;
+
+ protected:
+  std::vector<std::unique_ptr<Program>> programs_;
+  std::vector<std::unique_ptr<Method>> methods_;
+  std::vector<exec_aten::ArrayRef<void*>> inputs_;
+};
+
+TEST_F(SharedPlannedArenaTest, MethodsShareOneArena) {
+  SharedPlannedArena arena;
+  load_methods(arena);
+
+  // The arena is as large as the largest Method, not the sum of both.
+  EXPECT_GT(arena.planned_size(), 0);
+  EXPECT_LT(arena.planned_size(), arena.unshared_planned_size());
+
+  // Inputs are all ones.
+  ASSERT_EQ(arena.execute(*methods_[0]), Error::Ok);
+  EXPECT_FLOAT_EQ(output(0), 2.0f);
+  ASSERT_EQ(arena.execute(*methods_[1]), Error::Ok);
+  EXPECT_FLOAT_EQ(output(1), 5.0f);
+
+  // Outputs and inputs live outside the arena, so they survive other Methods
+  // executing in between.
+  EXPECT_FLOAT_EQ(output(0), 2.0f);
+  for (int i = 0; i < 3; ++i) {
+    ASSERT_EQ(arena.execute(*methods_[0]), Error::Ok);
+    EXPECT_FLOAT_EQ(output(0), 2.0f);
+    ASSERT_EQ(arena.execute(*methods_[1]), Error::Ok);
+    EXPECT_FLOAT_EQ(output(1), 5.0f);
+  }
+}
+
+TEST_F(SharedPlannedArenaTest, CopyFreeLoopWritesRelocatedOutput) {
+  SharedPlannedArena arena;
+  load_methods(arena);
+  Method& map_method = *methods_[2];
+
+  float xs[6] = {1, 2, 3, 4, 5, 6};
+  int32_t xs_sizes[2] = {3, 2};
+  uint8_t xs_dim_order[2] = {0, 1};
+  int32_t xs_strides[2] = {2, 1};
+  torch::executor::TensorImpl xs_impl(
+      torch::executor::ScalarType::Float,
+      2,
+      xs_sizes,
+      xs,
+      xs_dim_order,
+      xs_strides);
+  float y[2] = {10, 20};
+  int32_t y_sizes[1] = {2};
+  uint8_t y_dim_order[1] = {0};
+  int32_t y_strides[1] = {1};
+  torch::executor::TensorImpl y_impl(
+      torch::executor::ScalarType::Float,
+      1,
+      y_sizes,
+      y,
+      y_dim_order,
+      y_strides);
+  ASSERT_EQ(
+      map_method.set_input(torch::executor::EValue(exec_aten::Tensor(&xs_impl)), 0),
+      Error::Ok);
+  ASSERT_EQ(
+      map_method.set_input(torch::executor::EValue(exec_aten::Tensor(&y_impl)), 1),
+      Error::Ok);
+
+  // Returns whether the row {a, b} is anywhere in the shared buffers.
+  std::vector<Span<uint8_t>> buffers = shared_buffers(arena);
+  auto in_shared_buffers = [&](float a, float b) {
+    const float row[2] = {a, b};
+    for (const Span<uint8_t>& buffer : buffers) {
+      for (size_t offset = 0; offset + sizeof(row) <= buffer.size();
+           offset += sizeof(float)) {
+        if (memcmp(buffer.data() + offset, row, sizeof(row)) == 0) {
+          return true;
+        }
+      }
+    }
+    return false;
+  };
+
+  const float expected[6] = {11, 22, 13, 24, 15, 26};
+  for (int i = 0; i < 2; ++i) {
+    // ModuleLinear overwrites the loop's intermediates in between.
+    ASSERT_EQ(arena.execute(*methods_[1]), Error::Ok);
+    for (Span<uint8_t>& buffer : buffers) {
+      std::fill(buffer.begin(), buffer.end(), 0);
+    }
+
+    ASSERT_EQ(arena.execute(map_method), Error::Ok);
+    const exec_aten::Tensor& out = map_method.get_output(0).toTensor();
+    ASSERT_EQ(out.numel(), 6);
+    for (size_t j = 0; j < 6; ++j) {
+      EXPECT_FLOAT_EQ(out.const_data_ptr<float>()[j], expected[j]);
+    }
+
+    // The first row is computed in the body's planned buffer. Later rows go
+    // straight into the relocated output, so the last one never overwrites
+    // the first in the arena.
+    EXPECT_TRUE(in_shared_buffers(11, 22));
+    EXPECT_FALSE(in_shared_buffers(15, 26));
+  }
+}
+
+TEST_F(SharedPlannedArenaTest, SwitchingAbandonsPartialExecution) {
+  SharedPlannedArena arena;
+  load_methods(arena);
+
+  // Start stepping through ModuleLinear, then run ModuleAdd, which overwrites
+  // ModuleLinear's intermediate.
+  ASSERT_EQ(arena.activate(*methods_[1]), Error::Ok);
+  ASSERT_EQ(methods_[1]->experimental_step(), Error::Ok);
+  ASSERT_EQ(arena.execute(*methods_[0]), Error::Ok);
+
+  // ModuleLinear starts over instead of resuming on a clobbered intermediate.
+  ASSERT_EQ(arena.execute(*methods_[1]), Error::Ok);
+  EXPECT_FLOAT_EQ(output(1), 5.0f);
+}
+
+TEST_F(SharedPlannedArenaTest, MisuseFails) {
+  SharedPlannedArena arena;
+  load_methods(arena);
+
+  Result<MethodMeta> meta = programs_[0]->method_meta("forward");
+  ASSERT_EQ(meta.error(), Error::Ok);
+  EXPECT_EQ(arena.reserve(meta.get()), Error::InvalidState);
+  EXPECT_EQ(arena.add(*methods_[0]), Error::InvalidArgument);
+
+  SharedPlannedArena other;
+  EXPECT_EQ(other.activate(*methods_[0]), Error::InvalidArgument);
+}
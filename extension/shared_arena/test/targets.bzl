@@ -0,0 +1,28 @@
+load("@fbsource//xplat/executorch/build:runtime_wrapper.bzl", "runtime")
+
+def define_common_targets(is_fbcode = False):
+    """Defines targets that should be shared between fbcode and xplat.
+
+    The directory containing this targets.bzl file should also contain both
+    TARGETS and BUCK files that call this function.
+    """
+
+    # The tests load program files from fbcode, so they only run there.
+    if not runtime.is_oss and is_fbcode:
+        runtime.cxx_test(
+            name = "shared_planned_arena_test",
+            srcs = [
+                "shared_planned_arena_test.cpp",
+            ],
+            deps = [
+                "//executorch/extension/shared_arena:shared_planned_arena",
+                "//executorch/extension/data_loader:file_data_loader",
+                "//executorch/kernels/portable:generated_lib",
+                "//executorch/util:util",
+            ],
+            env = {
+                "ET_MODULE_ADD_PATH": "$(location fbcode//executorch/test/models:exported_programs[ModuleAdd.pte])",
+                "ET_MODULE_LINEAR_PATH": "$(location fbcode//executorch/test/models:exported_programs[ModuleLinear.pte])",
+                "ET_MODULE_MAP_PATH": "$(location fbcode//executorch/test/models:exported_programs[ModuleMap.pte])",
+            },
+        )
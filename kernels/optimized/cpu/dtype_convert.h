@@ -0,0 +1,502 @@
+/*
+ * Copyright (c) Meta Platforms, Inc. and affiliates.
+ * All rights reserved.
+ *
+ * This source code is licensed under the BSD-style license found in the
+ * LICENSE file in the root directory of this source tree.
+ */
+
+#pragma once
+
+// Element type conversion shared by the optimized copy and mixed-dtype ops.
+//
+// Covers every pair of real, Bool, Half and BFloat16 types, between buffers
+// of any strides, so the same code handles contiguous and channels-last
+// tensors. Contiguous runs are converted in tight loops that the compiler
+// vectorizes; float <-> Half also uses the F16C and NEON conversion
+// instructions when they are available.
+
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <cstring>
+#include <limits>
+#include <type_traits>
+
+#include <executorch/kernels/optimized/vec/intrinsics.h>
+#include <executorch/kernels/optimized/vec/vec.h>
+#include <executorch/runtime/kernel/kernel_includes.h>
+#include <executorch/runtime/platform/compiler.h>
+
+namespace torch {
+namespace executor {
+namespace native {
+
+/**
+ * How values that don't fit an integral output type are converted. Floating
+ * point outputs always use the same rules as static_cast.
+ */
+enum class ConvertMode {
+  /// Same as static_cast, like to_copy in PyTorch. Floating point values
+  /// outside the range of the output type have undefined results.
+  Cast,
+  /// Floating point values are truncated toward zero and then clamped to the
+  /// range of the output type, with NaN converted to 0. Integral values are
+  /// clamped.
+  Saturate,
+  /// Like Saturate, but floating point values are first rounded to the
+  /// nearest integer, with ties to even.
+  Round,
+};
+
+namespace internal {
+
+template <typename T>
+__ET_INLINE uint16_t to_bits(T value) {
+  static_assert(sizeof(T) == sizeof(uint16_t), "Expected a 16-bit type");
+  uint16_t bits;
+  std::memcpy(&bits, &value, sizeof(bits));
+  return bits;
+}
+
+template <typename T>
+__ET_INLINE T from_bits(uint16_t bits) {
+  static_assert(sizeof(T) == sizeof(uint16_t), "Expected a 16-bit type");
+  T value;
+  std::memcpy(&value, &bits, sizeof(bits));
+  return value;
+}
+
+__ET_INLINE float float_from_u32(uint32_t bits) {
+  float value;
+  std::memcpy(&value, &bits, sizeof(value));
+  return value;
+}
+
+__ET_INLINE uint32_t u32_from_float(float value) {
+  uint32_t bits;
+  std::memcpy(&bits, &value, sizeof(bits));
+  return bits;
+}
+
+/// IEEE half to float; exact.
+__ET_INLINE float half_bits_to_float(uint16_t h) {
+  constexpr uint32_t kShiftedExp = 0x7c00u << 13;
+  uint32_t bits = (h & 0x7fffu) << 13;
+  const uint32_t exp = bits & kShiftedExp;
+  bits += (127u - 15u) << 23;
+  if (exp == kShiftedExp) {
+    // Inf or NaN.
+    bits += (128u - 16u) << 23;
+  } else if (exp == 0) {
+    // Zero or subnormal; let the FPU normalize it.
+    bits += 1u << 23;
+    bits = u32_from_float(float_from_u32(bits) - float_from_u32(113u << 23));
+  }
+  return float_from_u32(bits | (static_cast<uint32_t>(h & 0x8000u) << 16));
+}
+
+/// Float to IEEE half, rounding to nearest even like the F16C and NEON
+/// instructions.
+__ET_INLINE uint16_t float_to_half_bits(float f) {
+  uint32_t bits = u32_from_float(f);
+  const uint32_t sign = (bits >> 16) & 0x8000u;
+  bits &= 0x7fffffffu;
+  uint32_t h;
+  if (bits >= (143u << 23)) {
+    // Too large for a half, Inf or NaN. NaNs keep their payload and are
+    // quieted.
+    h = bits > 0x7f800000u ? 0x7e00u | ((bits >> 13) & 0x3ffu) : 0x7c00u;
+  } else if (bits < (113u << 23)) {
+    // Subnormal or zero; adding 0.5 lines the half's mantissa up with the
+    // float's, and the FPU rounds.
+    h = u32_from_float(float_from_u32(bits) + 0.5f) - (126u << 23);
+  } else {
+    const uint32_t mant_odd = (bits >> 13) & 1u;
+    // Rebias the exponent and round; values that round up past the largest
+    // half carry into the exponent and become Inf.
+    bits += (static_cast<uint32_t>(15 - 127) << 23) + 0xfffu + mant_odd;
+    h = bits >> 13;
+  }
+  return static_cast<uint16_t>(h | sign);
+}
+
+/// bfloat16 to float; exact.
+__ET_INLINE float bfloat16_bits_to_float(uint16_t b) {
+  return float_from_u32(static_cast<uint32_t>(b) << 16);
+}
+
+/// Float to bfloat16, rounding to nearest even.
+__ET_INLINE uint16_t float_to_bfloat16_bits(float f) {
+  const uint32_t bits = u32_from_float(f);
+  if ((bits & 0x7fffffffu) > 0x7f800000u) {
+    // Quiet NaN.
+    return static_cast<uint16_t>((bits >> 16) | 0x40u);
+  }
+  return static_cast<uint16_t>(
+      (bits + 0x7fffu + ((bits >> 16) & 1u)) >> 16);
+}
+
+/// Widens a value to the type conversions are done in: float for the 16-bit
+/// floating point types, and the type itself otherwise.
+template <typename T>
+__ET_INLINE T decode(T value) {
+  return value;
+}
+
+__ET_INLINE float decode(exec_aten::Half value) {
+  return half_bits_to_float(to_bits(value));
+}
+
+__ET_INLINE float decode(exec_aten::BFloat16 value) {
+  return bfloat16_bits_to_float(to_bits(value));
+}
+
+/// Narrows a decoded value to the output type.
+template <typename To>
+struct Encoder {
+  template <typename V>
+  __ET_INLINE static To apply(V value) {
+    return static_cast<To>(value);
+  }
+};
+
+template <>
+struct Encoder<exec_aten::Half> {
+  template <typename V>
+  __ET_INLINE static exec_aten::Half apply(V value) {
+    return from_bits<exec_aten::Half>(
+        float_to_half_bits(static_cast<float>(value)));
+  }
+};
+
+template <>
+struct Encoder<exec_aten::BFloat16> {
+  template <typename V>
+  __ET_INLINE static exec_aten::BFloat16 apply(V value) {
+    return from_bits<exec_aten::BFloat16>(
+        float_to_bfloat16_bits(static_cast<float>(value)));
+  }
+};
+
+template <typename To, typename V>
+__ET_INLINE To saturate_floating(V value) {
+  constexpr V kLowest = static_cast<V>(std::numeric_limits<To>::lowest());
+  // May round up past the maximum, e.g. to 2^31 for int32_t in float, which
+  // is why values at the limit take the explicit branch.
+  constexpr V kMax = static_cast<V>(std::numeric_limits<To>::max());
+  if (std::isnan(value)) {
+    return static_cast<To>(0);
+  }
+  if (value <= kLowest) {
+    return std::numeric_limits<To>::lowest();
+  }
+  if (value >= kMax) {
+    return std::numeric_limits<To>::max();
+  }
+  return static_cast<To>(value);
+}
+
+template <typename To, typename V>
+__ET_INLINE To saturate_integral(V value) {
+  // Every integral input type fits in int64_t.
+  const int64_t wide = static_cast<int64_t>(value);
+  const int64_t lowest =
+      static_cast<int64_t>(std::numeric_limits<To>::lowest());
+  const int64_t max = static_cast<int64_t>(std::numeric_limits<To>::max());
+  return static_cast<To>(std::min(std::max(wide, lowest), max));
+}
+
+} // namespace internal
+
+/// Converts a single value.
+template <typename To, ConvertMode kMode = ConvertMode::Cast, typename From>
+__ET_INLINE To convert_value(From in) {
+  const auto value = internal::decode(in);
+  using V = std::remove_const_t<decltype(value)>;
+  constexpr bool kToInteger =
+      std::is_integral<To>::value && !std::is_same<To, bool>::value;
+  if constexpr (kMode != ConvertMode::Cast && kToInteger) {
+    if constexpr (std::is_floating_point<V>::value) {
+      if constexpr (kMode == ConvertMode::Round) {
+        // The default rounding mode rounds ties to even.
+        return internal::saturate_floating<To>(std::nearbyint(value));
+      } else {
+        return internal::saturate_floating<To>(value);
+      }
+    } else {
+      return internal::saturate_integral<To>(value);
+    }
+  } else {
+    return internal::Encoder<To>::apply(value);
+  }
+}
+
+/// Converts `n` contiguous values.
+template <typename From, typename To, ConvertMode kMode = ConvertMode::Cast>
+void convert_contiguous(const From* in, To* out, size_t n) {
+  if constexpr (std::is_same<From, To>::value && kMode == ConvertMode::Cast) {
+    std::memcpy(out, in, n * sizeof(To));
+    return;
+  }
+  size_t i = 0;
+#if defined(__F16C__) && defined(__AVX__)
+  if constexpr (
+      std::is_same<From, float>::value &&
+      std::is_same<To, exec_aten::Half>::value) {
+    for (; i + 8 <= n; i += 8) {
+      const __m256 v = _mm256_loadu_ps(reinterpret_cast<const float*>(in + i));
+      _mm_storeu_si128(
+          reinterpret_cast<__m128i*>(out + i),
+          _mm256_cvtps_ph(v, _MM_FROUND_TO_NEAREST_INT));
+    }
+  } else if constexpr (
+      std::is_same<From, exec_aten::Half>::value &&
+      std::is_same<To, float>::value) {
+    for (; i + 8 <= n; i += 8) {
+      const __m128i v =
+          _mm_loadu_si128(reinterpret_cast<const __m128i*>(in + i));
+      _mm256_storeu_ps(reinterpret_cast<float*>(out + i), _mm256_cvtph_ps(v));
+    }
+  }
+#elif defined(__aarch64__)
+  if constexpr (
+      std::is_same<From, float>::value &&
+      std::is_same<To, exec_aten::Half>::value) {
+    for (; i + 4 <= n; i += 4) {
+      const float32x4_t v = vld1q_f32(reinterpret_cast<const float*>(in + i));
+      vst1_u16(
+          reinterpret_cast<uint16_t*>(out + i),
+          vreinterpret_u16_f16(vcvt_f16_f32(v)));
+    }
+  } else if constexpr (
+      std::is_same<From, exec_aten::Half>::value &&
+      std::is_same<To, float>::value) {
+    for (; i + 4 <= n; i += 4) {
+      const float16x4_t v = vreinterpret_f16_u16(
+          vld1_u16(reinterpret_cast<const uint16_t*>(in + i)));
+      vst1q_f32(reinterpret_cast<float*>(out + i), vcvt_f32_f16(v));
+    }
+  }
+#endif
+  for (; i < n; ++i) {
+    out[i] = convert_value<To, kMode>(in[i]);
+  }
+}
+
+/**
+ * Converts `ndim`-dimensional data between two layouts. Elements are visited
+ * in the memory order of the output, after merging dimensions that are
+ * contiguous in both buffers, so that copies between identical layouts become
+ * a single contiguous run.
+ */
+template <typename From, typename To, ConvertMode kMode = ConvertMode::Cast>
+void convert_strided(
+    const From* in,
+    To* out,
+    size_t ndim,
+    const exec_aten::SizesType* sizes,
+    const exec_aten::StridesType* in_strides,
+    const exec_aten::StridesType* out_strides) {
+  struct Dim {
+    int64_t size;
+    int64_t in_stride;
+    int64_t out_stride;
+  };
+  Dim dims[kTensorDimensionLimit];
+  size_t n = 0;
+  for (size_t d = 0; d < ndim; ++d) {
+    if (sizes[d] == 0) {
+      return;
+    }
+    if (sizes[d] == 1) {
+      continue;
+    }
+    // Insertion sort from the largest output stride to the smallest.
+    Dim dim{sizes[d], in_strides[d], out_strides[d]};
+    size_t pos = n++;
+    while (pos > 0 && dims[pos - 1].out_stride < dim.out_stride) {
+      dims[pos] = dims[pos - 1];
+      pos--;
+    }
+    dims[pos] = dim;
+  }
+
+  // Merge each dimension into the next inner one when both buffers step over
+  // it contiguously.
+  size_t merged = 0;
+  for (size_t d = 0; d < n; ++d) {
+    if (merged > 0 &&
+        dims[merged - 1].out_stride == dims[d].out_stride * dims[d].size &&
+        dims[merged - 1].in_stride == dims[d].in_stride * dims[d].size) {
+      dims[merged - 1].size *= dims[d].size;
+      dims[merged - 1].in_stride = dims[d].in_stride;
+      dims[merged - 1].out_stride = dims[d].out_stride;
+    } else {
+      dims[merged++] = dims[d];
+    }
+  }
+  n = merged;
+
+  if (n == 0) {
+    out[0] = convert_value<To, kMode>(in[0]);
+    return;
+  }
+
+  const Dim inner = dims[n - 1];
+  int64_t index[kTensorDimensionLimit] = {};
+  int64_t in_offset = 0;
+  int64_t out_offset = 0;
+  while (true) {
+    if (inner.in_stride == 1 && inner.out_stride == 1) {
+      convert_contiguous<From, To, kMode>(
+          in + in_offset, out + out_offset, static_cast<size_t>(inner.size));
+    } else {
+      for (int64_t i = 0; i < inner.size; ++i) {
+        out[out_offset + i * inner.out_stride] =
+            convert_value<To, kMode>(in[in_offset + i * inner.in_stride]);
+      }
+    }
+    // Advance the outer dimensions like an odometer.
+    size_t d = n - 1;
+    while (true) {
+      if (d == 0) {
+        return;
+      }
+      d--;
+      in_offset += dims[d].in_stride;
+      out_offset += dims[d].out_stride;
+      if (++index[d] < dims[d].size) {
+        break;
+      }
+      in_offset -= dims[d].in_stride * dims[d].size;
+      out_offset -= dims[d].out_stride * dims[d].size;
+      index[d] = 0;
+    }
+  }
+}
+
+// Applies `_` to every type convert_tensor() supports.
+#define ET_INTERNAL_FORALL_CONVERT_TYPES(_) \
+  ET_FORALL_REAL_TYPES_AND(Bool, _)         \
+  _(exec_aten::Half, Half)                  \
+  _(exec_aten::BFloat16, BFloat16)
+
+/**
+ * Returns true if convert_tensor() supports converting from `from` to `to`.
+ */
+inline bool can_convert(ScalarType from, ScalarType to) {
+  auto supported = [](ScalarType t) {
+    switch (t) {
+#define ET_INTERNAL_CONVERT_CASE(ctype, dtype) case ScalarType::dtype:
+      ET_INTERNAL_FORALL_CONVERT_TYPES(ET_INTERNAL_CONVERT_CASE)
+#undef ET_INTERNAL_CONVERT_CASE
+      return true;
+      default:
+        return false;
+    }
+  };
+  return supported(from) && supported(to);
+}
+
+namespace internal {
+
+template <typename From, ConvertMode kMode>
+void convert_tensor_from(const Tensor& in, Tensor& out) {
+  const From* in_data = in.const_data_ptr<From>();
+  switch (out.scalar_type()) {
+#define ET_INTERNAL_CONVERT_CASE(ctype, dtype)             \
+  case ScalarType::dtype:                                  \
+    convert_strided<From, ctype, kMode>(                   \
+        in_data,                                           \
+        out.mutable_data_ptr<ctype>(),                     \
+        static_cast<size_t>(in.dim()),                     \
+        in.sizes().data(),                                 \
+        in.strides().data(),                               \
+        out.strides().data());                             \
+    break;
+    ET_INTERNAL_FORALL_CONVERT_TYPES(ET_INTERNAL_CONVERT_CASE)
+#undef ET_INTERNAL_CONVERT_CASE
+    default:
+      ET_CHECK_MSG(
+          false,
+          "Unhandled output dtype %" PRId8,
+          static_cast<int8_t>(out.scalar_type()));
+  }
+}
+
+} // namespace internal
+
+/**
+ * Converts the elements of `in` into `out`, which must have the same sizes
+ * and dtypes for which can_convert() is true. The tensors may have different
+ * dim orders, e.g. contiguous and channels-last.
+ */
+template <ConvertMode kMode = ConvertMode::Cast>
+void convert_tensor(const Tensor& in, Tensor& out) {
+  ET_CHECK_SAME_SHAPE2(in, out);
+  if (in.numel() == 0) {
+    return;
+  }
+  switch (in.scalar_type()) {
+#define ET_INTERNAL_CONVERT_CASE(ctype, dtype)           \
+  case ScalarType::dtype:                                \
+    internal::convert_tensor_from<ctype, kMode>(in, out); \
+    break;
+    ET_INTERNAL_FORALL_CONVERT_TYPES(ET_INTERNAL_CONVERT_CASE)
+#undef ET_INTERNAL_CONVERT_CASE
+    default:
+      ET_CHECK_MSG(
+          false,
+          "Unhandled input dtype %" PRId8,
+          static_cast<int8_t>(in.scalar_type()));
+  }
+}
+
+#undef ET_INTERNAL_FORALL_CONVERT_TYPES
+
+/**
+ * Applies a Vectorized binary op to two contiguous inputs of possibly
+ * different dtypes, writing a contiguous output of a possibly different
+ * dtype. Inputs are converted to `CTYPE_IN` a block at a time so that the
+ * op itself runs on vectors, like the same-dtype fast paths.
+ */
+template <
+    typename CTYPE_IN,
+    typename CTYPE_A,
+    typename CTYPE_B,
+    typename CTYPE_OUT,
+    typename Op>
+void apply_binary_converted(
+    const Op& op,
+    const CTYPE_A* a,
+    const CTYPE_B* b,
+    CTYPE_OUT* out,
+    size_t n) {
+  using Vec = executorch::vec::Vectorized<CTYPE_IN>;
+  // A multiple of every vector size, small enough to stay in L1.
+  constexpr size_t kBlockSize = 256;
+  CTYPE_IN a_block[kBlockSize];
+  CTYPE_IN b_block[kBlockSize];
+  CTYPE_IN out_block[kBlockSize];
+  for (size_t start = 0; start < n; start += kBlockSize) {
+    const size_t len = std::min(kBlockSize, n - start);
+    convert_contiguous<CTYPE_A, CTYPE_IN>(a + start, a_block, len);
+    convert_contiguous<CTYPE_B, CTYPE_IN>(b + start, b_block, len);
+    size_t i = 0;
+    for (; i + Vec::size() <= len; i += Vec::size()) {
+      op(Vec::loadu(a_block + i), Vec::loadu(b_block + i))
+          .store(out_block + i);
+    }
+    if (i < len) {
+      const int rest = static_cast<int>(len - i);
+      op(Vec::loadu(a_block + i, rest), Vec::loadu(b_block + i, rest))
+          .store(out_block + i, rest);
+    }
+    convert_contiguous<CTYPE_IN, CTYPE_OUT>(out_block, out + start, len);
+  }
+}
+
+} // namespace native
+} // namespace executor
+} // namespace torch
@@ -6,6 +6,7 @@
  * LICENSE file in the root directory of this source tree.
  */
 
+#include <executorch/kernels/optimized/cpu/dtype_convert.h>
 #include <executorch/kernels/optimized/vec/functional.h>
 #include <executorch/kernels/optimized/vec/vec.h>
 #include <executorch/kernels/portable/cpu/scalar_utils.h>
@@ -54,6 +55,9 @@ Tensor& opt_add_out(
     ET_CHECK(canCast(common_type, out_type));
 
     resize_to_broadcast_target_size(a, b, out);
+    // Without broadcasting, convert the inputs a block at a time and run the
+    // op on vectors.
+    const bool same_shape = a.sizes().equals(b.sizes());
 
     ET_SWITCH_REAL_TYPES_AND(Bool, a_type, ctx, "add.out", CTYPE_A, [&]() {
       ET_SWITCH_REAL_TYPES_AND(Bool, b_type, ctx, "add.out", CTYPE_B, [&]() {
@@ -64,17 +68,30 @@ Tensor& opt_add_out(
                     CTYPE_IN alpha_val;
                     ET_EXTRACT_SCALAR(alpha, alpha_val);
 
-                    apply_binary_elementwise_fn<CTYPE_A, CTYPE_B, CTYPE_OUT>(
-                        [alpha_val](const CTYPE_A val_a, const CTYPE_B val_b) {
-                          CTYPE_IN a_casted = static_cast<CTYPE_IN>(val_a);
-                          CTYPE_IN b_casted = static_cast<CTYPE_IN>(val_b);
-                          CTYPE_IN value = a_casted + alpha_val * b_casted;
-
-                          return static_cast<CTYPE_OUT>(value);
-                        },
-                        a,
-                        b,
-                        out);
+                    if (same_shape) {
+                      using Vec = executorch::vec::Vectorized<CTYPE_IN>;
+                      apply_binary_converted<CTYPE_IN>(
+                          [alpha_val](Vec x, Vec y) {
+                            return x + Vec(alpha_val) * y;
+                          },
+                          a.const_data_ptr<CTYPE_A>(),
+                          b.const_data_ptr<CTYPE_B>(),
+                          out.mutable_data_ptr<CTYPE_OUT>(),
+                          out.numel());
+                    } else {
+                      apply_binary_elementwise_fn<CTYPE_A, CTYPE_B, CTYPE_OUT>(
+                          [alpha_val](
+                              const CTYPE_A val_a, const CTYPE_B val_b) {
+                            CTYPE_IN a_casted = static_cast<CTYPE_IN>(val_a);
+                            CTYPE_IN b_casted = static_cast<CTYPE_IN>(val_b);
+                            CTYPE_IN value = a_casted + alpha_val * b_casted;
+
+                            return static_cast<CTYPE_OUT>(value);
+                          },
+                          a,
+                          b,
+                          out);
+                    }
                   });
             });
       });
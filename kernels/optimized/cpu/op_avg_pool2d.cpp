@@ -0,0 +1,400 @@
+/*
+ * Copyright (c) Meta Platforms, Inc. and affiliates.
+ * All rights reserved.
+ *
+ * This source code is licensed under the BSD-style license found in the
+ * LICENSE file in the root directory of this source tree.
+ */
+
+#include <algorithm>
+#include <cstring>
+
+#include <executorch/kernels/optimized/cpu/parallel_utils.h>
+#include <executorch/kernels/optimized/cpu/pooling_utils.h>
+#include <executorch/kernels/optimized/vec/functional.h>
+#include <executorch/kernels/optimized/vec/vec.h>
+#include <executorch/kernels/portable/cpu/util/kernel_ops_util.h>
+#include <executorch/runtime/kernel/kernel_includes.h>
+
+namespace torch {
+namespace executor {
+namespace native {
+
+using Tensor = exec_aten::Tensor;
+using ScalarType = exec_aten::ScalarType;
+using IntArrayRef = exec_aten::ArrayRef<int64_t>;
+
+namespace {
+
+// Channels handled together by one task when the input is NHWC.
+constexpr int64_t kChannelBlock = 64;
+
+/// Averaging options that don't depend on the window position.
+struct AvgPoolOptions {
+  bool count_include_pad;
+  bool has_divisor_override;
+  int64_t divisor_override;
+};
+
+/**
+ * Returns the divisor for a window starting at (y_start, x_start), given the
+ * number of taps that land inside the input.
+ */
+int64_t get_divisor(
+    const Pool2dGeometry& g,
+    const AvgPoolOptions& options,
+    int64_t y_start,
+    int64_t x_start,
+    int64_t num_valid) {
+  if (options.has_divisor_override) {
+    return options.divisor_override;
+  }
+  if (!options.count_include_pad) {
+    return num_valid;
+  }
+  // The window, clipped to the padded input.
+  const int64_t y_end = std::min(y_start + g.kernel_h, g.in_h + g.pad_h);
+  const int64_t x_end = std::min(x_start + g.kernel_w, g.in_w + g.pad_w);
+  return (y_end - y_start) * (x_end - x_start);
+}
+
+/**
+ * Average over the window of `out_x` in each of `out_x_begin..out_x_end`,
+ * where `rows` point at the input rows covered by the window. Specializing on
+ * the window and stride lets the taps unroll and the loop over out_x
+ * vectorize.
+ */
+template <typename CTYPE, int64_t kKernelH, int64_t kKernelW, int64_t kStride>
+void avg_row_interior(
+    const CTYPE* const* rows,
+    int64_t pad_w,
+    int64_t out_x_begin,
+    int64_t out_x_end,
+    CTYPE divisor,
+    CTYPE* out,
+    int64_t out_x_stride) {
+  for (int64_t ox = out_x_begin; ox < out_x_end; ++ox) {
+    const int64_t x = ox * kStride - pad_w;
+    CTYPE sum = 0;
+    for (int64_t ky = 0; ky < kKernelH; ++ky) {
+      for (int64_t kx = 0; kx < kKernelW; ++kx) {
+        sum += rows[ky][x + kx];
+      }
+    }
+    out[ox * out_x_stride] = sum / divisor;
+  }
+}
+
+/**
+ * Average over the windows of `out_x_begin..out_x_end` in one output row,
+ * where only the taps in [ky_begin, ky_end) land inside the input.
+ */
+template <typename CTYPE>
+void avg_row_generic(
+    const Pool2dGeometry& g,
+    const AvgPoolOptions& options,
+    const CTYPE* in,
+    int64_t y_start,
+    int64_t ky_begin,
+    int64_t ky_end,
+    int64_t out_x_begin,
+    int64_t out_x_end,
+    CTYPE* out) {
+  for (int64_t ox = out_x_begin; ox < out_x_end; ++ox) {
+    int64_t kx_begin = 0;
+    int64_t kx_end = 0;
+    get_valid_taps(
+        ox,
+        g.stride_w,
+        g.pad_w,
+        /*dilation=*/1,
+        g.kernel_w,
+        g.in_w,
+        &kx_begin,
+        &kx_end);
+    if (ky_begin >= ky_end || kx_begin >= kx_end) {
+      continue;
+    }
+    const int64_t x_start = ox * g.stride_w - g.pad_w;
+    CTYPE sum = 0;
+    for (int64_t ky = ky_begin; ky < ky_end; ++ky) {
+      const CTYPE* row = in + (y_start + ky) * g.in_w + x_start;
+      for (int64_t kx = kx_begin; kx < kx_end; ++kx) {
+        sum += row[kx];
+      }
+    }
+    const int64_t divisor = get_divisor(
+        g,
+        options,
+        y_start,
+        x_start,
+        (ky_end - ky_begin) * (kx_end - kx_begin));
+    out[ox * g.out_strides[3]] = sum / static_cast<CTYPE>(divisor);
+  }
+}
+
+/// Average pools one contiguous {H, W} plane of an NCHW input.
+template <typename CTYPE>
+void avg_pool2d_plane(
+    const Pool2dGeometry& g,
+    const AvgPoolOptions& options,
+    const CTYPE* in,
+    CTYPE* out) {
+  int64_t x_begin = 0;
+  int64_t x_end = 0;
+  get_interior_range(
+      g.out_w,
+      g.stride_w,
+      g.pad_w,
+      /*dilation=*/1,
+      g.kernel_w,
+      g.in_w,
+      &x_begin,
+      &x_end);
+  const bool is_2x2s2 = g.kernel_h == 2 && g.kernel_w == 2 && g.stride_w == 2;
+  const bool is_3x3s2 = g.kernel_h == 3 && g.kernel_w == 3 && g.stride_w == 2;
+  // Windows that lie entirely inside the input cover every tap, with or
+  // without count_include_pad.
+  const CTYPE interior_divisor = static_cast<CTYPE>(
+      options.has_divisor_override ? options.divisor_override
+                                   : g.kernel_h * g.kernel_w);
+
+  for (int64_t oy = 0; oy < g.out_h; ++oy) {
+    int64_t ky_begin = 0;
+    int64_t ky_end = 0;
+    get_valid_taps(
+        oy,
+        g.stride_h,
+        g.pad_h,
+        /*dilation=*/1,
+        g.kernel_h,
+        g.in_h,
+        &ky_begin,
+        &ky_end);
+    const int64_t y_start = oy * g.stride_h - g.pad_h;
+    CTYPE* out_row = out + oy * g.out_strides[2];
+
+    const bool full_rows = ky_begin == 0 && ky_end == g.kernel_h;
+    if (full_rows && (is_2x2s2 || is_3x3s2)) {
+      const CTYPE* rows[3];
+      for (int64_t ky = 0; ky < g.kernel_h; ++ky) {
+        rows[ky] = in + (y_start + ky) * g.in_w;
+      }
+      avg_row_generic(
+          g, options, in, y_start, ky_begin, ky_end, 0, x_begin, out_row);
+      if (is_2x2s2) {
+        avg_row_interior<CTYPE, 2, 2, 2>(
+            rows,
+            g.pad_w,
+            x_begin,
+            x_end,
+            interior_divisor,
+            out_row,
+            g.out_strides[3]);
+      } else {
+        avg_row_interior<CTYPE, 3, 3, 2>(
+            rows,
+            g.pad_w,
+            x_begin,
+            x_end,
+            interior_divisor,
+            out_row,
+            g.out_strides[3]);
+      }
+      avg_row_generic(
+          g, options, in, y_start, ky_begin, ky_end, x_end, g.out_w, out_row);
+    } else {
+      avg_row_generic(
+          g, options, in, y_start, ky_begin, ky_end, 0, g.out_w, out_row);
+    }
+  }
+}
+
+/**
+ * Average pools the channels in [c_begin, c_end) of one output row of an NHWC
+ * input. The sums are vectorized across channels.
+ */
+template <typename CTYPE>
+void avg_pool2d_row_channels_last(
+    const Pool2dGeometry& g,
+    const AvgPoolOptions& options,
+    const CTYPE* in,
+    int64_t oy,
+    int64_t c_begin,
+    int64_t c_end,
+    CTYPE* out) {
+  using Vec = ::executorch::vec::Vectorized<CTYPE>;
+  CTYPE sum[kChannelBlock];
+  const int64_t num_c = c_end - c_begin;
+  const int64_t y_start = oy * g.stride_h - g.pad_h;
+  int64_t ky_begin = 0;
+  int64_t ky_end = 0;
+  get_valid_taps(
+      oy,
+      g.stride_h,
+      g.pad_h,
+      /*dilation=*/1,
+      g.kernel_h,
+      g.in_h,
+      &ky_begin,
+      &ky_end);
+
+  for (int64_t ox = 0; ox < g.out_w; ++ox) {
+    int64_t kx_begin = 0;
+    int64_t kx_end = 0;
+    get_valid_taps(
+        ox,
+        g.stride_w,
+        g.pad_w,
+        /*dilation=*/1,
+        g.kernel_w,
+        g.in_w,
+        &kx_begin,
+        &kx_end);
+    if (ky_begin >= ky_end || kx_begin >= kx_end) {
+      continue;
+    }
+    const int64_t x_start = ox * g.stride_w - g.pad_w;
+    std::memset(sum, 0, sizeof(sum));
+    for (int64_t ky = ky_begin; ky < ky_end; ++ky) {
+      const CTYPE* pixel = in + (y_start + ky) * g.in_strides[2] +
+          (x_start + kx_begin) * g.in_strides[3] + c_begin;
+      for (int64_t kx = kx_begin; kx < kx_end; ++kx) {
+        ::executorch::vec::map2(
+            [](Vec acc, Vec value) { return acc + value; },
+            sum,
+            sum,
+            pixel,
+            num_c);
+        pixel += g.in_strides[3];
+      }
+    }
+    const CTYPE divisor = static_cast<CTYPE>(get_divisor(
+        g,
+        options,
+        y_start,
+        x_start,
+        (ky_end - ky_begin) * (kx_end - kx_begin)));
+    CTYPE* out_pixel = out + oy * g.out_strides[2] + ox * g.out_strides[3] +
+        c_begin * g.out_strides[1];
+    for (int64_t c = 0; c < num_c; ++c) {
+      out_pixel[c * g.out_strides[1]] = sum[c] / divisor;
+    }
+  }
+}
+
+template <typename CTYPE>
+void avg_pool2d(
+    const Pool2dGeometry& g,
+    const AvgPoolOptions& options,
+    const CTYPE* in,
+    CTYPE* out) {
+  const int64_t taps_per_output = g.kernel_h * g.kernel_w;
+  if (g.channels_last) {
+    const int64_t num_blocks = (g.channels + kChannelBlock - 1) / kChannelBlock;
+    const int64_t taps_per_task = g.out_w * kChannelBlock * taps_per_output;
+    parallel_for(
+        g.batch * g.out_h * num_blocks,
+        kMinTapsPerTask / std::max<int64_t>(taps_per_task, 1),
+        [&](int64_t begin, int64_t end) {
+          for (int64_t task = begin; task < end; ++task) {
+            const int64_t block = task % num_blocks;
+            const int64_t oy = (task / num_blocks) % g.out_h;
+            const int64_t n = task / num_blocks / g.out_h;
+            const int64_t c_begin = block * kChannelBlock;
+            const int64_t c_end =
+                std::min(g.channels, c_begin + kChannelBlock);
+            avg_pool2d_row_channels_last(
+                g,
+                options,
+                in + n * g.in_strides[0],
+                oy,
+                c_begin,
+                c_end,
+                out + n * g.out_strides[0]);
+          }
+        });
+  } else {
+    const int64_t taps_per_plane = g.out_h * g.out_w * taps_per_output;
+    parallel_for(
+        g.batch * g.channels,
+        kMinTapsPerTask / std::max<int64_t>(taps_per_plane, 1),
+        [&](int64_t begin, int64_t end) {
+          for (int64_t plane = begin; plane < end; ++plane) {
+            const int64_t n = plane / g.channels;
+            const int64_t c = plane % g.channels;
+            avg_pool2d_plane(
+                g,
+                options,
+                in + n * g.in_strides[0] + c * g.in_strides[1],
+                out + n * g.out_strides[0] + c * g.out_strides[1]);
+          }
+        });
+  }
+}
+
+} // namespace
+
+Tensor& opt_avg_pool2d_out(
+    RuntimeContext& ctx,
+    const Tensor& in,
+    IntArrayRef kernel_size,
+    IntArrayRef stride,
+    IntArrayRef padding,
+    bool ceil_mode,
+    bool count_include_pad,
+    exec_aten::optional<int64_t> divisor_override,
+    Tensor& out) {
+  ET_KERNEL_CHECK(
+      ctx,
+      check_avg_pool2d_args(
+          in,
+          kernel_size,
+          stride,
+          padding,
+          ceil_mode,
+          count_include_pad,
+          divisor_override,
+          out),
+      InvalidArgument,
+      out);
+
+  size_t output_ndim = 0;
+  exec_aten::SizesType output_sizes[kTensorDimensionLimit];
+  get_avg_pool2d_out_target_size(
+      in, kernel_size, stride, padding, ceil_mode, output_sizes, &output_ndim);
+
+  ET_KERNEL_CHECK(
+      ctx,
+      output_size_is_valid({output_sizes, output_ndim}, 2),
+      InvalidArgument,
+      out);
+
+  ET_KERNEL_CHECK(
+      ctx,
+      resize_tensor(out, {output_sizes, output_ndim}) == Error::Ok,
+      InvalidArgument,
+      out);
+
+  const Pool2dGeometry geometry =
+      get_pool2d_geometry(in, out, kernel_size, stride, padding, {});
+  const AvgPoolOptions options{
+      count_include_pad,
+      divisor_override.has_value(),
+      divisor_override.has_value() ? divisor_override.value() : 0};
+
+  ScalarType in_type = in.scalar_type();
+  ET_SWITCH_FLOAT_TYPES_AND(Long, in_type, ctx, "avg_pool2d.out", CTYPE, [&]() {
+    avg_pool2d<CTYPE>(
+        geometry,
+        options,
+        in.const_data_ptr<CTYPE>(),
+        out.mutable_data_ptr<CTYPE>());
+  });
+
+  return out;
+}
+
+} // namespace native
+} // namespace executor
+} // namespace torch
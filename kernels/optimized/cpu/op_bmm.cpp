@@ -9,6 +9,8 @@
 #include <executorch/runtime/kernel/kernel_includes.h>
 
 #include <executorch/kernels/optimized/blas/CPUBlas.h>
+#include <executorch/runtime/core/memory_allocator.h>
+#include <executorch/runtime/kernel/operator_registry.h>
 
 // Performs a batch matrix-matrix product of matrices stored in input and mat2.
 
@@ -71,6 +73,17 @@ void check_bmm_out_args(const Tensor& self, const Tensor& mat2, Tensor& out) {
   ET_CHECK_SAME_DTYPE3(self, mat2, out);
 }
 
+// Returns true if each matrix of mat2 is stored transposed, i.e. mat2 has dim
+// order {0, 2, 1}. prepack_bmm_mat2() produces this layout.
+bool is_transposed_mat2(const Tensor& mat2) {
+#ifndef USE_ATEN_LIB
+  return mat2.dim() == 3 && mat2.dim_order()[0] == 0 &&
+      mat2.dim_order()[1] == 2 && mat2.dim_order()[2] == 1;
+#else
+  return false;
+#endif
+}
+
 template <typename CTYPE>
 void bmm_kernel(const Tensor& self, const Tensor& mat2, Tensor& out) {
   using executorch::cpublas::TransposeType;
@@ -88,6 +101,13 @@ void bmm_kernel(const Tensor& self, const Tensor& mat2, Tensor& out) {
   int64_t k = self.size(2);
   int64_t m = mat2.size(2);
 
+  // A transposed mat2 lets gemm compute each output as a dot product of two
+  // contiguous rows, which is faster than accumulating columns.
+  const bool transposed = is_transposed_mat2(mat2);
+  const TransposeType transa =
+      transposed ? TransposeType::Transpose : TransposeType::NoTranspose;
+  const int64_t lda = transposed ? k : m;
+
   for (int i = 0; i < batch_size; ++i) {
     const CTYPE* a = a_data + i * m * k;
     const CTYPE* b = b_data + i * k * n;
@@ -95,10 +115,10 @@ void bmm_kernel(const Tensor& self, const Tensor& mat2, Tensor& out) {
 
     // clang-format off
     executorch::cpublas::gemm(
-        TransposeType::NoTranspose, TransposeType::NoTranspose,
+        transa, TransposeType::NoTranspose,
         m, n, k,
         static_cast<CTYPE>(1),
-        a, m,
+        a, lda,
         b, k,
         static_cast<CTYPE>(0),
         c, m);
@@ -106,6 +126,66 @@ void bmm_kernel(const Tensor& self, const Tensor& mat2, Tensor& out) {
   }
 }
 
+#ifndef USE_ATEN_LIB
+// Called once at Method load for a constant mat2: copies it into a tensor with
+// the same sizes whose matrices are stored transposed (dim order {0, 2, 1}).
+Error prepack_bmm_mat2(
+    MemoryAllocator* allocator,
+    const EValue& arg,
+    EValue* packed) {
+  if (!arg.isTensor()) {
+    return Error::Ok;
+  }
+  const Tensor& mat2 = arg.toTensor();
+  if (mat2.dim() != 3 || mat2.numel() == 0 ||
+      !is_default_dim_order(mat2.dim_order().data(), mat2.dim())) {
+    return Error::Ok;
+  }
+  const int64_t batch_size = mat2.size(0);
+  const int64_t k = mat2.size(1);
+  const int64_t m = mat2.size(2);
+
+  auto* sizes = ET_ALLOCATE_LIST_OR_RETURN_ERROR(
+      allocator, exec_aten::SizesType, 3);
+  auto* dim_order = ET_ALLOCATE_LIST_OR_RETURN_ERROR(
+      allocator, exec_aten::DimOrderType, 3);
+  auto* strides = ET_ALLOCATE_LIST_OR_RETURN_ERROR(
+      allocator, exec_aten::StridesType, 3);
+  sizes[0] = batch_size;
+  sizes[1] = k;
+  sizes[2] = m;
+  dim_order[0] = 0;
+  dim_order[1] = 2;
+  dim_order[2] = 1;
+  strides[0] = k * m;
+  strides[1] = 1;
+  strides[2] = k;
+  void* data = ET_ALLOCATE_OR_RETURN_ERROR(allocator, mat2.nbytes());
+
+  const size_t element_size = mat2.element_size();
+  const char* src = static_cast<const char*>(mat2.const_data_ptr());
+  char* dst = static_cast<char*>(data);
+  for (int64_t b = 0; b < batch_size; ++b) {
+    for (int64_t row = 0; row < k; ++row) {
+      for (int64_t col = 0; col < m; ++col) {
+        memcpy(
+            dst + ((b * m + col) * k + row) * element_size,
+            src + ((b * k + row) * m + col) * element_size,
+            element_size);
+      }
+    }
+  }
+
+  TensorImpl* impl =
+      ET_ALLOCATE_INSTANCE_OR_RETURN_ERROR(allocator, TensorImpl);
+  new (impl)
+      TensorImpl(mat2.scalar_type(), 3, sizes, data, dim_order, strides);
+  *packed = EValue(Tensor(impl));
+  return Error::Ok;
+}
+
+#endif // USE_ATEN_LIB
+
 void resize_out_tensor(const Tensor& self, const Tensor& mat2, Tensor& out) {
   exec_aten::SizesType expected_output_size[kTensorDimensionLimit];
 
@@ -156,6 +236,16 @@ Tensor& opt_bmm_out(
   return out;
 }
 
+#ifndef USE_ATEN_LIB
+// The prepacked arguments of opt_bmm_out(). Only a Kernel whose OpFunction
+// calls opt_bmm_out() may use them as its prepacks_; other bmm kernels can't
+// read the transposed mat2.
+extern const Prepack opt_bmm_out_prepacks[1];
+const Prepack opt_bmm_out_prepacks[1] = {
+    Prepack(/*arg_index=*/1, prepack_bmm_mat2),
+};
+#endif // USE_ATEN_LIB
+
 } // namespace native
 } // namespace executor
 } // namespace torch
@@ -0,0 +1,794 @@
+/*
+ * Copyright (c) Meta Platforms, Inc. and affiliates.
+ * All rights reserved.
+ *
+ * This source code is licensed under the BSD-style license found in the
+ * LICENSE file in the root directory of this source tree.
+ */
+
+#include <algorithm>
+#include <cstring>
+#include <limits>
+
+#include <executorch/kernels/optimized/blas/CPUBlas.h>
+#include <executorch/kernels/optimized/cpu/parallel_utils.h>
+#include <executorch/kernels/portable/cpu/scalar_utils.h>
+#include <executorch/kernels/portable/cpu/util/kernel_ops_util.h>
+#include <executorch/runtime/kernel/kernel_includes.h>
+
+// Computes convolution and transposed convolution by lowering them to GEMM.
+//
+// A convolution gathers each output pixel's receptive field into a row of a
+// "col" matrix (im2col) and multiplies it with the weight. A transposed
+// convolution runs the same computation backwards: it multiplies the weight
+// with each input pixel to get that pixel's contribution to a kernel-sized
+// window of the output, and scatter-adds the windows into the output
+// (col2im).
+//
+// The col matrix is never materialized in full. It is built a tile of pixels
+// at a time in a fixed size stack buffer, so the kernels need no scratch
+// memory.
+//
+// fused_ops::convolution_clamp.out additionally clamps the output, which is
+// how relu, hardtanh and clamp following a convolution are fused into it. The
+// clamp is applied together with the bias while a tile is still in cache,
+// instead of in a separate pass over the whole activation.
+namespace torch {
+namespace executor {
+namespace native {
+
+using Scalar = exec_aten::Scalar;
+using Tensor = exec_aten::Tensor;
+using ScalarType = exec_aten::ScalarType;
+using IntArrayRef = exec_aten::ArrayRef<int64_t>;
+
+namespace {
+
+using ::executorch::cpublas::TransposeType;
+
+// Size of the per-tile col buffer.
+constexpr size_t kColBufferBytes = 64 * 1024;
+
+// Upper bound on the col rows (kernel taps times channels) handled at once.
+// Larger reductions are split and accumulated.
+constexpr int64_t kMaxColRows = 1024;
+
+/**
+ * Shape, layout and window parameters of a convolution, with every tensor
+ * viewed as 4-D {N, C, H, W}. A 1-D convolution gets a unit H dim.
+ */
+struct ConvGeometry {
+  int64_t batch;
+  int64_t in_c;
+  int64_t in_h;
+  int64_t in_w;
+  int64_t out_c;
+  int64_t out_h;
+  int64_t out_w;
+  int64_t groups;
+  int64_t kernel_h;
+  int64_t kernel_w;
+  int64_t stride_h;
+  int64_t stride_w;
+  int64_t pad_h;
+  int64_t pad_w;
+  int64_t dilation_h;
+  int64_t dilation_w;
+  /// Element strides in N, C, H, W order. The weight's are in O, I, H, W
+  /// order, i.e. dim 0 is in_c for a transposed convolution.
+  int64_t in_strides[4];
+  int64_t w_strides[4];
+  int64_t out_strides[4];
+};
+
+/**
+ * The activation fused into the output write. When enabled, every output
+ * element is clamped to [min, max]; NaNs are propagated like aten::clamp.
+ */
+template <typename CTYPE>
+struct OutputClamp {
+  bool enabled;
+  CTYPE min;
+  CTYPE max;
+
+  CTYPE operator()(CTYPE x) const {
+    return std::min(std::max(x, min), max);
+  }
+};
+
+/// Copies the strides of `t` as N, C, H, W, inserting a unit H dim for 3-D
+/// tensors. The H stride is chosen so that pixel p = h * W + w always sits at
+/// p * strides[3], which holds for both contiguous and channels last layouts.
+void get_nchw_strides(const Tensor& t, int64_t* strides) {
+  if (t.dim() == 3) {
+    strides[0] = t.strides()[0];
+    strides[1] = t.strides()[1];
+    strides[2] = t.size(2) * t.strides()[2];
+    strides[3] = t.strides()[2];
+  } else {
+    for (size_t i = 0; i < 4; ++i) {
+      strides[i] = t.strides()[i];
+    }
+  }
+}
+
+ConvGeometry get_conv_geometry(
+    const Tensor& in,
+    const Tensor& weight,
+    const Tensor& out,
+    IntArrayRef stride,
+    IntArrayRef padding,
+    IntArrayRef dilation,
+    int64_t groups) {
+  ConvGeometry g;
+  const bool is_1d = in.dim() == 3;
+  g.batch = in.size(0);
+  g.in_c = in.size(1);
+  g.in_h = is_1d ? 1 : in.size(2);
+  g.in_w = in.size(in.dim() - 1);
+  g.out_c = out.size(1);
+  g.out_h = is_1d ? 1 : out.size(2);
+  g.out_w = out.size(out.dim() - 1);
+  g.groups = groups;
+  g.kernel_h = is_1d ? 1 : weight.size(2);
+  g.kernel_w = weight.size(weight.dim() - 1);
+  if (is_1d) {
+    g.stride_h = 1;
+    g.pad_h = 0;
+    g.dilation_h = 1;
+    g.stride_w = val_at(stride, 0);
+    g.pad_w = val_at(padding, 0, /*default_value=*/0);
+    g.dilation_w = val_at(dilation, 0, /*default_value=*/1);
+  } else {
+    g.stride_h = val_at(stride, 0);
+    g.stride_w = val_at(stride, 1);
+    g.pad_h = val_at(padding, 0, /*default_value=*/0);
+    g.pad_w = val_at(padding, 1, /*default_value=*/0);
+    g.dilation_h = val_at(dilation, 0, /*default_value=*/1);
+    g.dilation_w = val_at(dilation, 1, /*default_value=*/1);
+  }
+  get_nchw_strides(in, g.in_strides);
+  get_nchw_strides(weight, g.w_strides);
+  get_nchw_strides(out, g.out_strides);
+  return g;
+}
+
+/**
+ * Describes the col rows [begin, begin + count) of one group's weight. Each
+ * weight row (one output channel for a convolution, one input channel for a
+ * transposed convolution) is stored densely, so col row r is simply the
+ * element at offset r of a weight row; its channel and kernel tap are
+ * recovered from the weight's strides. For each row this records the offset
+ * of the matching element in the image (`image_strides`, relative to the
+ * window origin) and the tap's displacement from the window origin.
+ */
+void get_col_row_offsets(
+    const ConvGeometry& g,
+    int64_t channels,
+    const int64_t* image_strides,
+    int64_t begin,
+    int64_t count,
+    int64_t* offsets,
+    int64_t* dys,
+    int64_t* dxs) {
+  for (int64_t i = 0; i < count; ++i) {
+    const int64_t r = begin + i;
+    const int64_t c = (r / g.w_strides[1]) % channels;
+    const int64_t ky = (r / g.w_strides[2]) % g.kernel_h;
+    const int64_t kx = (r / g.w_strides[3]) % g.kernel_w;
+    dys[i] = ky * g.dilation_h;
+    dxs[i] = kx * g.dilation_w;
+    offsets[i] = c * image_strides[1] + dys[i] * image_strides[2] +
+        dxs[i] * image_strides[3];
+  }
+}
+
+/**
+ * Convolution as im2col + GEMM. Work is split over (batch, group, tile of
+ * output pixels); each tile's col rows are packed and multiplied with the
+ * group's weight straight into the output.
+ */
+template <typename CTYPE, typename CTYPE_BIAS>
+void conv2d(
+    const ConvGeometry& g,
+    const CTYPE* const in,
+    const CTYPE* const weight,
+    const CTYPE_BIAS* const bias,
+    const OutputClamp<CTYPE>& clamp,
+    CTYPE* const out) {
+  const int64_t in_c_per_group = g.in_c / g.groups;
+  const int64_t out_c_per_group = g.out_c / g.groups;
+  const int64_t K = in_c_per_group * g.kernel_h * g.kernel_w;
+  const int64_t num_pixels = g.out_h * g.out_w;
+  const int64_t* const is = g.in_strides;
+  const int64_t* const ws = g.w_strides;
+  const int64_t* const os = g.out_strides;
+
+  // The output is either pixel-major (NCHW) or channel-major (NHWC); the GEMM
+  // is oriented so that it writes the output in place either way.
+  const bool out_pixels_contiguous = os[3] == 1;
+
+  // A 1x1 convolution with unit stride and no padding is a plain GEMM over
+  // the input, as long as the input and output layouts agree.
+  const bool pointwise = g.kernel_h == 1 && g.kernel_w == 1 &&
+      g.stride_h == 1 && g.stride_w == 1 && g.pad_h == 0 && g.pad_w == 0 &&
+      (out_pixels_contiguous ? is[3] == 1 : is[1] == 1);
+
+  constexpr int64_t kColBufferSize = kColBufferBytes / sizeof(CTYPE);
+  const int64_t rows_per_chunk = std::min(K, kMaxColRows);
+  const int64_t tile_size = std::min(
+      num_pixels, std::max<int64_t>(1, kColBufferSize / rows_per_chunk));
+  const int64_t num_tiles = (num_pixels + tile_size - 1) / tile_size;
+  const int64_t macs_per_tile = tile_size * K * out_c_per_group;
+  const int64_t grain_size =
+      std::max<int64_t>(1, kMinMacsPerTask / macs_per_tile);
+
+  parallel_for(
+      g.batch * g.groups * num_tiles,
+      grain_size,
+      [&](int64_t begin, int64_t end) {
+        alignas(64) CTYPE col[kColBufferSize];
+        int64_t offsets[kMaxColRows];
+        int64_t dys[kMaxColRows];
+        int64_t dxs[kMaxColRows];
+
+        for (int64_t task = begin; task < end; ++task) {
+          const int64_t tile = task % num_tiles;
+          const int64_t group = (task / num_tiles) % g.groups;
+          const int64_t n = task / num_tiles / g.groups;
+
+          const CTYPE* const in_g =
+              in + n * is[0] + group * in_c_per_group * is[1];
+          const CTYPE* const w_g = weight + group * out_c_per_group * ws[0];
+          CTYPE* const out_g =
+              out + n * os[0] + group * out_c_per_group * os[1];
+
+          const int64_t p0 = tile * tile_size;
+          const int64_t count = std::min(tile_size, num_pixels - p0);
+          CTYPE* const c = out_g + p0 * os[3];
+
+          if (pointwise) {
+            if (out_pixels_contiguous) {
+              ::executorch::cpublas::gemm(
+                  TransposeType::NoTranspose,
+                  TransposeType::NoTranspose,
+                  count,
+                  out_c_per_group,
+                  in_c_per_group,
+                  static_cast<CTYPE>(1),
+                  in_g + p0,
+                  is[1],
+                  w_g,
+                  ws[0],
+                  static_cast<CTYPE>(0),
+                  c,
+                  os[1]);
+            } else {
+              ::executorch::cpublas::gemm(
+                  TransposeType::Transpose,
+                  TransposeType::NoTranspose,
+                  out_c_per_group,
+                  count,
+                  in_c_per_group,
+                  static_cast<CTYPE>(1),
+                  w_g,
+                  ws[0],
+                  in_g + p0 * is[3],
+                  is[3],
+                  static_cast<CTYPE>(0),
+                  c,
+                  os[3]);
+            }
+          } else {
+            for (int64_t k0 = 0; k0 < K; k0 += rows_per_chunk) {
+              const int64_t rows = std::min(rows_per_chunk, K - k0);
+              get_col_row_offsets(
+                  g, in_c_per_group, is, k0, rows, offsets, dys, dxs);
+
+              // im2col: row-major {count, rows}, zero where the tap falls
+              // into the padding.
+              for (int64_t i = 0; i < count; ++i) {
+                const int64_t p = p0 + i;
+                const int64_t iy0 = (p / g.out_w) * g.stride_h - g.pad_h;
+                const int64_t ix0 = (p % g.out_w) * g.stride_w - g.pad_w;
+                const int64_t base = iy0 * is[2] + ix0 * is[3];
+                CTYPE* const col_row = col + i * rows;
+                const bool interior = iy0 >= 0 && ix0 >= 0 &&
+                    iy0 + (g.kernel_h - 1) * g.dilation_h < g.in_h &&
+                    ix0 + (g.kernel_w - 1) * g.dilation_w < g.in_w;
+                if (interior) {
+                  for (int64_t r = 0; r < rows; ++r) {
+                    col_row[r] = in_g[base + offsets[r]];
+                  }
+                } else {
+                  for (int64_t r = 0; r < rows; ++r) {
+                    const int64_t iy = iy0 + dys[r];
+                    const int64_t ix = ix0 + dxs[r];
+                    col_row[r] =
+                        (iy >= 0 && iy < g.in_h && ix >= 0 && ix < g.in_w)
+                        ? in_g[base + offsets[r]]
+                        : static_cast<CTYPE>(0);
+                  }
+                }
+              }
+
+              const CTYPE beta = static_cast<CTYPE>(k0 == 0 ? 0 : 1);
+              if (out_pixels_contiguous) {
+                ::executorch::cpublas::gemm(
+                    TransposeType::Transpose,
+                    TransposeType::NoTranspose,
+                    count,
+                    out_c_per_group,
+                    rows,
+                    static_cast<CTYPE>(1),
+                    col,
+                    rows,
+                    w_g + k0,
+                    ws[0],
+                    beta,
+                    c,
+                    os[1]);
+              } else {
+                ::executorch::cpublas::gemm(
+                    TransposeType::Transpose,
+                    TransposeType::NoTranspose,
+                    out_c_per_group,
+                    count,
+                    rows,
+                    static_cast<CTYPE>(1),
+                    w_g + k0,
+                    ws[0],
+                    col,
+                    rows,
+                    beta,
+                    c,
+                    os[3]);
+              }
+            }
+          }
+
+          if (bias != nullptr || clamp.enabled) {
+            for (int64_t oc = 0; oc < out_c_per_group; ++oc) {
+              const CTYPE b = bias != nullptr
+                  ? convert<CTYPE, CTYPE_BIAS>(
+                        bias[group * out_c_per_group + oc])
+                  : static_cast<CTYPE>(0);
+              CTYPE* const c_oc = c + oc * os[1];
+              if (clamp.enabled) {
+                for (int64_t i = 0; i < count; ++i) {
+                  c_oc[i * os[3]] = clamp(c_oc[i * os[3]] + b);
+                }
+              } else {
+                for (int64_t i = 0; i < count; ++i) {
+                  c_oc[i * os[3]] += b;
+                }
+              }
+            }
+          }
+        }
+      });
+}
+
+/// Sets every output element to its channel's bias, or to zero.
+template <typename CTYPE, typename CTYPE_BIAS>
+void fill_with_bias(
+    const ConvGeometry& g,
+    const CTYPE_BIAS* const bias,
+    CTYPE* const out) {
+  const int64_t* const os = g.out_strides;
+  const int64_t num_pixels = g.out_h * g.out_w;
+  const int64_t grain_size = std::max<int64_t>(1, kMinMacsPerTask / num_pixels);
+  parallel_for(
+      g.batch * g.out_c,
+      grain_size,
+      [&](int64_t begin, int64_t end) {
+        for (int64_t plane = begin; plane < end; ++plane) {
+          const int64_t n = plane / g.out_c;
+          const int64_t oc = plane % g.out_c;
+          const CTYPE value = bias != nullptr
+              ? convert<CTYPE, CTYPE_BIAS>(bias[oc])
+              : static_cast<CTYPE>(0);
+          CTYPE* const out_plane = out + n * os[0] + oc * os[1];
+          for (int64_t p = 0; p < num_pixels; ++p) {
+            out_plane[p * os[3]] = value;
+          }
+        }
+      });
+}
+
+/// Clamps every output element in place.
+template <typename CTYPE>
+void clamp_output(
+    const ConvGeometry& g,
+    const OutputClamp<CTYPE>& clamp,
+    CTYPE* const out) {
+  const int64_t* const os = g.out_strides;
+  const int64_t num_pixels = g.out_h * g.out_w;
+  const int64_t grain_size = std::max<int64_t>(1, kMinMacsPerTask / num_pixels);
+  parallel_for(
+      g.batch * g.out_c,
+      grain_size,
+      [&](int64_t begin, int64_t end) {
+        for (int64_t plane = begin; plane < end; ++plane) {
+          const int64_t n = plane / g.out_c;
+          const int64_t oc = plane % g.out_c;
+          CTYPE* const out_plane = out + n * os[0] + oc * os[1];
+          for (int64_t p = 0; p < num_pixels; ++p) {
+            out_plane[p * os[3]] = clamp(out_plane[p * os[3]]);
+          }
+        }
+      });
+}
+
+/**
+ * Transposed convolution as GEMM + col2im. For a tile of input pixels the
+ * GEMM computes every (output channel, kernel tap) contribution, which is
+ * then scattered into the output windows.
+ *
+ * Windows of neighbouring pixels overlap in general, so the scatter adds onto
+ * an output pre-filled with the bias, and only (batch, group) pairs run in
+ * parallel. When the stride equals the kernel size (with no padding or
+ * dilation) the windows tile the output exactly: every element is written
+ * once, the bias and clamp are folded into that write and all tiles run in
+ * parallel. Otherwise the clamp needs a final pass over the output.
+ */
+template <typename CTYPE, typename CTYPE_BIAS>
+void conv_transpose2d(
+    const ConvGeometry& g,
+    const CTYPE* const in,
+    const CTYPE* const weight,
+    const CTYPE_BIAS* const bias,
+    const OutputClamp<CTYPE>& clamp,
+    CTYPE* const out) {
+  const int64_t in_c_per_group = g.in_c / g.groups;
+  const int64_t out_c_per_group = g.out_c / g.groups;
+  const int64_t J = out_c_per_group * g.kernel_h * g.kernel_w;
+  const int64_t num_pixels = g.in_h * g.in_w;
+  const int64_t* const is = g.in_strides;
+  const int64_t* const ws = g.w_strides;
+  const int64_t* const os = g.out_strides;
+
+  const bool non_overlapping = g.stride_h == g.kernel_h &&
+      g.stride_w == g.kernel_w && g.pad_h == 0 && g.pad_w == 0 &&
+      (g.kernel_h == 1 || g.dilation_h == 1) &&
+      (g.kernel_w == 1 || g.dilation_w == 1);
+  // Only output_padding leaves parts of the output uncovered by any window.
+  const bool fully_covered = g.out_h == g.in_h * g.kernel_h &&
+      g.out_w == g.in_w * g.kernel_w;
+  if (!non_overlapping || !fully_covered) {
+    fill_with_bias(g, bias, out);
+  }
+
+  constexpr int64_t kColBufferSize = kColBufferBytes / sizeof(CTYPE);
+  const int64_t rows_per_chunk = std::min(J, kMaxColRows);
+  const int64_t tile_size = std::min(
+      num_pixels, std::max<int64_t>(1, kColBufferSize / rows_per_chunk));
+  const int64_t num_tiles = (num_pixels + tile_size - 1) / tile_size;
+  // Overlapping tiles must not be scattered concurrently.
+  const int64_t tiles_per_task = non_overlapping ? 1 : num_tiles;
+  const int64_t num_tasks =
+      g.batch * g.groups * (num_tiles / tiles_per_task);
+  const int64_t macs_per_task =
+      tiles_per_task * tile_size * J * in_c_per_group;
+  const int64_t grain_size =
+      std::max<int64_t>(1, kMinMacsPerTask / macs_per_task);
+
+  parallel_for(
+      num_tasks,
+      grain_size,
+      [&](int64_t begin, int64_t end) {
+        alignas(64) CTYPE col[kColBufferSize];
+        int64_t offsets[kMaxColRows];
+        int64_t dys[kMaxColRows];
+        int64_t dxs[kMaxColRows];
+        CTYPE biases[kMaxColRows];
+
+        for (int64_t task = begin; task < end; ++task) {
+          const int64_t tasks_per_group = num_tiles / tiles_per_task;
+          const int64_t group = (task / tasks_per_group) % g.groups;
+          const int64_t n = task / tasks_per_group / g.groups;
+          const int64_t first_tile = (task % tasks_per_group) * tiles_per_task;
+
+          const CTYPE* const in_g =
+              in + n * is[0] + group * in_c_per_group * is[1];
+          const CTYPE* const w_g = weight + group * in_c_per_group * ws[0];
+          CTYPE* const out_g =
+              out + n * os[0] + group * out_c_per_group * os[1];
+
+          for (int64_t tile = first_tile; tile < first_tile + tiles_per_task;
+               ++tile) {
+            const int64_t p0 = tile * tile_size;
+            const int64_t count = std::min(tile_size, num_pixels - p0);
+
+            for (int64_t j0 = 0; j0 < J; j0 += rows_per_chunk) {
+              const int64_t rows = std::min(rows_per_chunk, J - j0);
+
+              // col is column-major {rows, count}: one column per pixel.
+              if (is[3] == 1) {
+                ::executorch::cpublas::gemm(
+                    TransposeType::NoTranspose,
+                    TransposeType::Transpose,
+                    rows,
+                    count,
+                    in_c_per_group,
+                    static_cast<CTYPE>(1),
+                    w_g + j0,
+                    ws[0],
+                    in_g + p0,
+                    is[1],
+                    static_cast<CTYPE>(0),
+                    col,
+                    rows);
+              } else {
+                ::executorch::cpublas::gemm(
+                    TransposeType::NoTranspose,
+                    TransposeType::NoTranspose,
+                    rows,
+                    count,
+                    in_c_per_group,
+                    static_cast<CTYPE>(1),
+                    w_g + j0,
+                    ws[0],
+                    in_g + p0 * is[3],
+                    is[3],
+                    static_cast<CTYPE>(0),
+                    col,
+                    rows);
+              }
+
+              get_col_row_offsets(
+                  g, out_c_per_group, os, j0, rows, offsets, dys, dxs);
+
+              // col2im.
+              if (non_overlapping) {
+                for (int64_t r = 0; r < rows; ++r) {
+                  const int64_t oc = ((j0 + r) / ws[1]) % out_c_per_group;
+                  biases[r] = bias != nullptr
+                      ? convert<CTYPE, CTYPE_BIAS>(
+                            bias[group * out_c_per_group + oc])
+                      : static_cast<CTYPE>(0);
+                }
+                for (int64_t i = 0; i < count; ++i) {
+                  const int64_t p = p0 + i;
+                  const int64_t base = (p / g.in_w) * g.kernel_h * os[2] +
+                      (p % g.in_w) * g.kernel_w * os[3];
+                  const CTYPE* const col_p = col + i * rows;
+                  if (clamp.enabled) {
+                    for (int64_t r = 0; r < rows; ++r) {
+                      out_g[base + offsets[r]] = clamp(col_p[r] + biases[r]);
+                    }
+                  } else {
+                    for (int64_t r = 0; r < rows; ++r) {
+                      out_g[base + offsets[r]] = col_p[r] + biases[r];
+                    }
+                  }
+                }
+                continue;
+              }
+
+              for (int64_t i = 0; i < count; ++i) {
+                const int64_t p = p0 + i;
+                const int64_t oy0 = (p / g.in_w) * g.stride_h - g.pad_h;
+                const int64_t ox0 = (p % g.in_w) * g.stride_w - g.pad_w;
+                const int64_t base = oy0 * os[2] + ox0 * os[3];
+                const CTYPE* const col_p = col + i * rows;
+                const bool interior = oy0 >= 0 && ox0 >= 0 &&
+                    oy0 + (g.kernel_h - 1) * g.dilation_h < g.out_h &&
+                    ox0 + (g.kernel_w - 1) * g.dilation_w < g.out_w;
+                if (interior) {
+                  for (int64_t r = 0; r < rows; ++r) {
+                    out_g[base + offsets[r]] += col_p[r];
+                  }
+                } else {
+                  for (int64_t r = 0; r < rows; ++r) {
+                    const int64_t oy = oy0 + dys[r];
+                    const int64_t ox = ox0 + dxs[r];
+                    if (oy >= 0 && oy < g.out_h && ox >= 0 && ox < g.out_w) {
+                      out_g[base + offsets[r]] += col_p[r];
+                    }
+                  }
+                }
+              }
+            }
+          }
+        }
+      });
+
+  if (clamp.enabled && !(non_overlapping && fully_covered)) {
+    clamp_output(g, clamp, out);
+  }
+}
+
+/**
+ * Shared by convolution.out and fused_ops::convolution_clamp.out. Without
+ * min or max this computes a plain convolution.
+ */
+Tensor& convolution_clamp(
+    RuntimeContext& ctx,
+    const Tensor& in,
+    const Tensor& weight,
+    const exec_aten::optional<Tensor>& bias,
+    IntArrayRef stride,
+    IntArrayRef padding,
+    IntArrayRef dilation,
+    bool transposed,
+    IntArrayRef output_padding,
+    int64_t groups,
+    const exec_aten::optional<Scalar>& min,
+    const exec_aten::optional<Scalar>& max,
+    Tensor& out) {
+  ET_KERNEL_CHECK(
+      ctx,
+      check_convolution_args(
+          in,
+          weight,
+          bias,
+          stride,
+          padding,
+          dilation,
+          transposed,
+          output_padding,
+          groups,
+          out),
+      InvalidArgument,
+      out);
+
+  // The fused activations only make sense for floating point models.
+  ET_KERNEL_CHECK(
+      ctx,
+      !(min.has_value() || max.has_value()) || tensor_is_floating_type(in),
+      InvalidArgument,
+      out);
+
+  size_t output_ndim = 0;
+  exec_aten::SizesType output_sizes[kTensorDimensionLimit];
+  ET_KERNEL_CHECK(
+      ctx,
+      get_convolution_out_target_size(
+          in,
+          weight,
+          stride,
+          padding,
+          dilation,
+          transposed,
+          output_padding,
+          groups,
+          output_sizes,
+          &output_ndim),
+      InvalidArgument,
+      out);
+
+  ET_KERNEL_CHECK(
+      ctx,
+      output_size_is_valid({output_sizes, output_ndim}, in.dim() - 2),
+      InvalidArgument,
+      out);
+
+  ET_KERNEL_CHECK(
+      ctx,
+      resize_tensor(out, {output_sizes, output_ndim}) == Error::Ok,
+      InvalidArgument,
+      out);
+
+  if (out.numel() == 0) {
+    return out;
+  }
+
+  const ConvGeometry geometry =
+      get_conv_geometry(in, weight, out, stride, padding, dilation, groups);
+
+  ScalarType in_type = in.scalar_type();
+  ScalarType bias_type = in_type;
+  if (bias.has_value()) {
+    bias_type = bias.value().scalar_type();
+  }
+  ET_SWITCH_REAL_TYPES(in_type, ctx, "convolution.out", CTYPE, [&]() {
+    OutputClamp<CTYPE> clamp{
+        min.has_value() || max.has_value(),
+        std::numeric_limits<CTYPE>::lowest(),
+        std::numeric_limits<CTYPE>::max()};
+    if (min.has_value()) {
+      ET_EXTRACT_SCALAR(min.value(), clamp.min);
+    }
+    if (max.has_value()) {
+      ET_EXTRACT_SCALAR(max.value(), clamp.max);
+    }
+
+    ET_SWITCH_REAL_TYPES_AND(
+        Bool, bias_type, ctx, "convolution.out", CTYPE_BIAS, [&]() {
+          const CTYPE_BIAS* const bias_ptr = bias.has_value()
+              ? bias.value().const_data_ptr<CTYPE_BIAS>()
+              : nullptr;
+          if (transposed) {
+            conv_transpose2d<CTYPE, CTYPE_BIAS>(
+                geometry,
+                in.const_data_ptr<CTYPE>(),
+                weight.const_data_ptr<CTYPE>(),
+                bias_ptr,
+                clamp,
+                out.mutable_data_ptr<CTYPE>());
+          } else {
+            conv2d<CTYPE, CTYPE_BIAS>(
+                geometry,
+                in.const_data_ptr<CTYPE>(),
+                weight.const_data_ptr<CTYPE>(),
+                bias_ptr,
+                clamp,
+                out.mutable_data_ptr<CTYPE>());
+          }
+        });
+  });
+
+  return out;
+}
+
+} // namespace
+
+Tensor& opt_convolution_out(
+    RuntimeContext& ctx,
+    const Tensor& in,
+    const Tensor& weight,
+    const exec_aten::optional<Tensor>& bias,
+    IntArrayRef stride,
+    IntArrayRef padding,
+    IntArrayRef dilation,
+    bool transposed,
+    IntArrayRef output_padding,
+    int64_t groups,
+    Tensor& out) {
+  return convolution_clamp(
+      ctx,
+      in,
+      weight,
+      bias,
+      stride,
+      padding,
+      dilation,
+      transposed,
+      output_padding,
+      groups,
+      exec_aten::nullopt,
+      exec_aten::nullopt,
+      out);
+}
+
+// fused_ops::convolution_clamp.out(Tensor input, Tensor weight, Tensor? bias,
+// int[] stride, int[] padding, int[] dilation, bool transposed,
+// int[] output_padding, int groups, Scalar? min=None, Scalar? max=None, *,
+// Tensor(a!) out) -> Tensor(a!)
+//
+// Computes clamp(convolution(...), min, max). relu is clamp(min=0) and
+// hardtanh is clamp(min_val, max_val).
+Tensor& opt_convolution_clamp_out(
+    RuntimeContext& ctx,
+    const Tensor& in,
+    const Tensor& weight,
+    const exec_aten::optional<Tensor>& bias,
+    IntArrayRef stride,
+    IntArrayRef padding,
+    IntArrayRef dilation,
+    bool transposed,
+    IntArrayRef output_padding,
+    int64_t groups,
+    const exec_aten::optional<Scalar>& min,
+    const exec_aten::optional<Scalar>& max,
+    Tensor& out) {
+  return convolution_clamp(
+      ctx,
+      in,
+      weight,
+      bias,
+      stride,
+      padding,
+      dilation,
+      transposed,
+      output_padding,
+      groups,
+      min,
+      max,
+      out);
+}
+
+} // namespace native
+} // namespace executor
+} // namespace torch
@@ -0,0 +1,88 @@
+/*
+ * Copyright (c) Meta Platforms, Inc. and affiliates.
+ * All rights reserved.
+ *
+ * This source code is licensed under the BSD-style license found in the
+ * LICENSE file in the root directory of this source tree.
+ */
+
+#include <functional>
+
+#include <executorch/kernels/optimized/cpu/dtype_convert.h>
+#include <executorch/kernels/optimized/cpu/scan_utils.h>
+#include <executorch/kernels/portable/cpu/util/reduce_util.h>
+#include <executorch/runtime/kernel/kernel_includes.h>
+
+namespace torch {
+namespace executor {
+namespace native {
+
+using Tensor = exec_aten::Tensor;
+using ScalarType = exec_aten::ScalarType;
+
+/**
+ * Returns the cumulative sum of elements of input in the dimension dim.
+ * If dtype is specified, the input tensor is cast to dtype before the
+ * operation is performed. This is useful for preventing data type overflows.
+ */
+Tensor& opt_cumsum_out(
+    RuntimeContext& ctx,
+    const Tensor& self,
+    int64_t dim,
+    optional<ScalarType> dtype,
+    Tensor& out) {
+  ET_KERNEL_CHECK(
+      ctx,
+      check_cumulative_args(self, dim, dtype, out),
+      InvalidArgument,
+      out);
+
+  ET_KERNEL_CHECK(
+      ctx,
+      resize_tensor(out, self.sizes()) == Error::Ok,
+      InvalidArgument,
+      out);
+
+  ET_KERNEL_CHECK(
+      ctx,
+      tensor_is_contiguous(self) && tensor_is_contiguous(out),
+      InvalidArgument,
+      out);
+
+  if (self.numel() == 0) {
+    return out;
+  }
+
+  int64_t outer = 1;
+  int64_t dim_size = 1;
+  int64_t inner = 1;
+  if (self.dim() > 0) {
+    dim = dim < 0 ? dim + self.dim() : dim;
+    outer = getLeadingDims(self, dim);
+    dim_size = self.size(dim);
+    inner = getTrailingDims(self, dim);
+  }
+
+  // Cast the input into out first and scan it there.
+  const bool same_dtype = self.scalar_type() == out.scalar_type();
+  if (!same_dtype) {
+    convert_tensor(self, out);
+  }
+
+  ET_SWITCH_REAL_TYPES(out.scalar_type(), ctx, "cumsum.out", CTYPE, [&]() {
+    internal::scan_dim(
+        same_dtype ? self.const_data_ptr<CTYPE>() : out.const_data_ptr<CTYPE>(),
+        out.mutable_data_ptr<CTYPE>(),
+        outer,
+        dim_size,
+        inner,
+        static_cast<CTYPE>(0),
+        std::plus<>());
+  });
+
+  return out;
+}
+
+} // namespace native
+} // namespace executor
+} // namespace torch
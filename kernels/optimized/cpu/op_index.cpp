@@ -0,0 +1,209 @@
+/*
+ * Copyright (c) Meta Platforms, Inc. and affiliates.
+ * All rights reserved.
+ *
+ * This source code is licensed under the BSD-style license found in the
+ * LICENSE file in the root directory of this source tree.
+ */
+
+#include <algorithm>
+#include <atomic>
+#include <cstdint>
+#include <cstring>
+
+#include <executorch/kernels/optimized/cpu/parallel_utils.h>
+#include <executorch/kernels/portable/cpu/util/advanced_index_util.h>
+#include <executorch/kernels/portable/cpu/util/broadcast_util.h>
+#include <executorch/runtime/kernel/kernel_includes.h>
+
+namespace torch {
+namespace executor {
+namespace native {
+
+using Tensor = exec_aten::Tensor;
+using TensorOptList = exec_aten::ArrayRef<exec_aten::optional<Tensor>>;
+
+namespace {
+
+// Mask entries below which a mask is not split for a parallel compaction.
+constexpr int64_t kMinMaskChunkSize = 4 * 1024;
+
+// Upper bound on the chunks a mask is split into.
+constexpr int64_t kMaxMaskChunks = 64;
+
+/**
+ * Compacts the input rows selected by a mask index. The mask is split into
+ * chunks whose set entries are counted in parallel; an exclusive scan of the
+ * counts gives the first output row of every chunk, so the chunks of every
+ * leading slice can then be copied independently.
+ */
+void gather_mask_rows_parallel(
+    const char* in_data,
+    char* out_data,
+    const SingleIndexView& view,
+    size_t row_nbytes) {
+  const uint8_t* const mask =
+      static_cast<const uint8_t*>(view.index->const_data_ptr());
+  const int64_t mask_size = view.num_in_rows;
+  const int64_t threads_per_slice =
+      (get_num_parallel_threads() + view.leading - 1) / view.leading;
+  const int64_t num_chunks = std::max<int64_t>(
+      1,
+      std::min(
+          {kMaxMaskChunks,
+           threads_per_slice,
+           mask_size / kMinMaskChunkSize}));
+  const int64_t chunk_size = (mask_size + num_chunks - 1) / num_chunks;
+
+  int64_t chunk_offset[kMaxMaskChunks];
+  parallel_for(num_chunks, 1, [&](int64_t begin, int64_t end) {
+    for (int64_t c = begin; c < end; ++c) {
+      const int64_t lo = std::min(c * chunk_size, mask_size);
+      const int64_t hi = std::min(lo + chunk_size, mask_size);
+      chunk_offset[c] = count_mask_trues(mask, lo, hi);
+    }
+  });
+  int64_t total = 0;
+  for (int64_t c = 0; c < num_chunks; ++c) {
+    const int64_t count = chunk_offset[c];
+    chunk_offset[c] = total;
+    total += count;
+  }
+
+  // Each chunk of a slice is copied on its own, as a one-slice view.
+  SingleIndexView slice = view;
+  slice.leading = 1;
+  const int64_t rows_per_task = std::max<int64_t>(
+      1, view.num_x_rows / num_chunks);
+  parallel_for(
+      view.leading * num_chunks,
+      std::max<int64_t>(1, kMinBytesPerTask / (rows_per_task * row_nbytes)),
+      [&](int64_t begin, int64_t end) {
+        for (int64_t t = begin; t < end; ++t) {
+          const int64_t l = t / num_chunks;
+          const int64_t c = t % num_chunks;
+          const int64_t lo = std::min(c * chunk_size, mask_size);
+          const int64_t hi = std::min(lo + chunk_size, mask_size);
+          gather_mask_rows(
+              in_data + l * view.num_in_rows * row_nbytes,
+              out_data + l * view.num_x_rows * row_nbytes,
+              slice,
+              row_nbytes,
+              lo,
+              hi,
+              chunk_offset[c]);
+        }
+      });
+}
+
+} // namespace
+
+Tensor& opt_index_Tensor_out(
+    RuntimeContext& ctx,
+    const Tensor& in,
+    TensorOptList indices,
+    Tensor& out) {
+  ET_KERNEL_CHECK(
+      ctx, check_index_args(in, indices, out), InvalidArgument, out);
+
+  ScalarType in_type = in.scalar_type();
+  size_t block_count = count_index_blocks(indices);
+
+  // If indices list is empty or all indices are null, just copy the input to
+  // output and return early.
+  if (block_count == 0) {
+    ET_KERNEL_CHECK(
+        ctx, resize_tensor(out, in.sizes()) == Error::Ok, InvalidArgument, out);
+    memcpy(out.mutable_data_ptr(), in.const_data_ptr(), in.nbytes());
+    return out;
+  }
+
+  // The output shape depends on whether all the non-null indices are adjacent
+  // or not.
+  bool adjacent = (block_count == 1);
+
+  Tensor::SizesType expected_size[kTensorDimensionLimit];
+  size_t expected_ndim = 0;
+
+  ET_KERNEL_CHECK(
+      ctx,
+      get_index_out_target_size(
+          in, indices, adjacent, expected_size, &expected_ndim),
+      InvalidArgument,
+      out);
+
+  ET_KERNEL_CHECK(
+      ctx,
+      resize_tensor(out, {expected_size, expected_ndim}) == Error::Ok,
+      InvalidArgument,
+      out);
+
+  if (out.numel() == 0) {
+    return out;
+  }
+
+  // With a single index, every output row is a whole input row.
+  SingleIndexView view;
+  if (get_single_index_view(in, indices, &view)) {
+    const char* const in_data = in.const_data_ptr<char>();
+    char* const out_data = out.mutable_data_ptr<char>();
+    const size_t row_nbytes = view.row_size * in.element_size();
+    if (view.is_mask) {
+      gather_mask_rows_parallel(in_data, out_data, view, row_nbytes);
+      return out;
+    }
+    ET_KERNEL_CHECK(
+        ctx,
+        check_index_bounds(*view.index, view.num_in_rows),
+        InvalidArgument,
+        out);
+    ET_SWITCH_TWO_TYPES(
+        Long,
+        Int,
+        view.index->scalar_type(),
+        ctx,
+        "index.Tensor_out",
+        CTYPE_IX,
+        [&]() {
+          parallel_for(
+              view.leading * view.num_x_rows,
+              std::max<int64_t>(1, kMinBytesPerTask / row_nbytes),
+              [&](int64_t begin, int64_t end) {
+                gather_index_rows<CTYPE_IX>(
+                    in_data, out_data, view, row_nbytes, begin, end);
+              });
+        });
+    return out;
+  }
+
+  std::atomic<bool> success(true);
+  ET_SWITCH_REAL_TYPES_AND(
+      Bool, in_type, ctx, "index.Tensor_out", CTYPE, [&]() {
+        const CTYPE* const in_data = in.const_data_ptr<CTYPE>();
+        CTYPE* const out_data = out.mutable_data_ptr<CTYPE>();
+        parallel_for(
+            out.numel(),
+            kMinBytesPerTask / sizeof(CTYPE),
+            [&](int64_t begin, int64_t end) {
+              if (!apply_over_indexed_elements(
+                      in,
+                      indices,
+                      expected_size,
+                      expected_ndim,
+                      begin,
+                      end,
+                      [&](size_t out_ix, const size_t*, size_t in_ix) {
+                        out_data[out_ix] = in_data[in_ix];
+                      })) {
+                success = false;
+              }
+            });
+      });
+  ET_KERNEL_CHECK(ctx, success, InvalidArgument, out);
+
+  return out;
+}
+
+} // namespace native
+} // namespace executor
+} // namespace torch
@@ -0,0 +1,96 @@
+/*
+ * Copyright (c) Meta Platforms, Inc. and affiliates.
+ * All rights reserved.
+ *
+ * This source code is licensed under the BSD-style license found in the
+ * LICENSE file in the root directory of this source tree.
+ */
+
+#include <algorithm>
+#include <cstdint>
+#include <cstring>
+
+#include <executorch/kernels/optimized/cpu/parallel_utils.h>
+#include <executorch/kernels/portable/cpu/util/index_util.h>
+#include <executorch/runtime/kernel/kernel_includes.h>
+
+namespace torch {
+namespace executor {
+namespace native {
+
+using Tensor = exec_aten::Tensor;
+
+namespace {
+
+} // namespace
+
+Tensor& opt_index_select_out(
+    RuntimeContext& ctx,
+    const Tensor& in,
+    int64_t dim,
+    const Tensor& index,
+    Tensor& out) {
+  ET_KERNEL_CHECK(
+      ctx, check_index_select_args(in, dim, index, out), InvalidArgument, out);
+
+  if (dim < 0) {
+    dim += nonzero_dim(in);
+  }
+
+  size_t expected_ndim = 0;
+  Tensor::SizesType expected_size[kTensorDimensionLimit];
+  get_index_select_out_target_size(
+      in, dim, index, expected_size, &expected_ndim);
+
+  ET_KERNEL_CHECK(
+      ctx,
+      resize_tensor(out, {expected_size, expected_ndim}) == Error::Ok,
+      InvalidArgument,
+      out);
+
+  if (in.dim() == 0) {
+    memcpy(out.mutable_data_ptr(), in.const_data_ptr(), in.nbytes());
+    return out;
+  }
+
+  const int64_t leading_dims = getLeadingDims(in, dim);
+  const int64_t trailing_dims = getTrailingDims(in, dim);
+
+  if (leading_dims == 0 || trailing_dims == 0) {
+    return out;
+  }
+
+  const int64_t out_dim_length = out.size(dim);
+  const int64_t in_dim_length = in.size(dim);
+  const size_t row_nbytes = trailing_dims * in.element_size();
+
+  const char* const in_data = in.const_data_ptr<char>();
+  char* const out_data = out.mutable_data_ptr<char>();
+
+  // Every output row, flattened over the leading dims and the selected dim,
+  // is a copy of one input row.
+  ET_SWITCH_TWO_TYPES(
+      Long, Int, index.scalar_type(), ctx, "index_select.out", CTYPE, [&]() {
+        const CTYPE* const index_arr = index.const_data_ptr<CTYPE>();
+        parallel_for(
+            leading_dims * out_dim_length,
+            std::max<int64_t>(1, kMinBytesPerTask / row_nbytes),
+            [&](int64_t begin, int64_t end) {
+              for (int64_t r = begin; r < end; ++r) {
+                const int64_t i = r / out_dim_length;
+                const int64_t j = r % out_dim_length;
+                const int64_t in_row = i * in_dim_length + index_arr[j];
+                memcpy(
+                    out_data + r * row_nbytes,
+                    in_data + in_row * row_nbytes,
+                    row_nbytes);
+              }
+            });
+      });
+
+  return out;
+}
+
+} // namespace native
+} // namespace executor
+} // namespace torch
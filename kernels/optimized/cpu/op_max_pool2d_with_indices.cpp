@@ -0,0 +1,446 @@
+/*
+ * Copyright (c) Meta Platforms, Inc. and affiliates.
+ * All rights reserved.
+ *
+ * This source code is licensed under the BSD-style license found in the
+ * LICENSE file in the root directory of this source tree.
+ */
+
+#include <algorithm>
+#include <tuple>
+
+#include <executorch/kernels/optimized/cpu/parallel_utils.h>
+#include <executorch/kernels/optimized/cpu/pooling_utils.h>
+#include <executorch/kernels/portable/cpu/util/kernel_ops_util.h>
+#include <executorch/runtime/kernel/kernel_includes.h>
+
+namespace torch {
+namespace executor {
+namespace native {
+
+using Tensor = exec_aten::Tensor;
+using ScalarType = exec_aten::ScalarType;
+using IntArrayRef = exec_aten::ArrayRef<int64_t>;
+
+namespace {
+
+// Channels handled together by one task when the input is NHWC.
+constexpr int64_t kChannelBlock = 64;
+
+/**
+ * Max over the window of `out_x` in each of `out_x_begin..out_x_end`, where
+ * `rows` point at the input rows covered by the window. Specializing on the
+ * window and stride lets the taps unroll and the loop over out_x vectorize.
+ */
+template <typename CTYPE, int64_t kKernelH, int64_t kKernelW, int64_t kStride>
+void max_row_interior(
+    const CTYPE* const* rows,
+    int64_t y_start,
+    int64_t in_w,
+    int64_t pad_w,
+    int64_t out_x_begin,
+    int64_t out_x_end,
+    CTYPE* out,
+    int64_t out_x_stride,
+    int64_t* indices,
+    int64_t indices_x_stride) {
+  for (int64_t ox = out_x_begin; ox < out_x_end; ++ox) {
+    const int64_t x = ox * kStride - pad_w;
+    CTYPE best = rows[0][x];
+    int64_t best_idx = y_start * in_w + x;
+    for (int64_t ky = 0; ky < kKernelH; ++ky) {
+      for (int64_t kx = 0; kx < kKernelW; ++kx) {
+        const CTYPE value = rows[ky][x + kx];
+        if (is_greater_or_nan(value, best)) {
+          best = value;
+          best_idx = (y_start + ky) * in_w + x + kx;
+        }
+      }
+    }
+    out[ox * out_x_stride] = best;
+    indices[ox * indices_x_stride] = best_idx;
+  }
+}
+
+/**
+ * Max over the windows of `out_x_begin..out_x_end` in one output row, where
+ * only the taps in [ky_begin, ky_end) land inside the input.
+ */
+template <typename CTYPE>
+void max_row_generic(
+    const Pool2dGeometry& g,
+    const CTYPE* in,
+    int64_t y_start,
+    int64_t ky_begin,
+    int64_t ky_end,
+    int64_t out_x_begin,
+    int64_t out_x_end,
+    CTYPE* out,
+    int64_t* indices,
+    int64_t indices_x_stride) {
+  const int64_t out_x_stride = g.out_strides[3];
+  for (int64_t ox = out_x_begin; ox < out_x_end; ++ox) {
+    int64_t kx_begin = 0;
+    int64_t kx_end = 0;
+    get_valid_taps(
+        ox,
+        g.stride_w,
+        g.pad_w,
+        g.dilation_w,
+        g.kernel_w,
+        g.in_w,
+        &kx_begin,
+        &kx_end);
+    if (ky_begin >= ky_end || kx_begin >= kx_end) {
+      continue;
+    }
+    const int64_t x_start = ox * g.stride_w - g.pad_w;
+    int64_t best_idx = (y_start + ky_begin * g.dilation_h) * g.in_w + x_start +
+        kx_begin * g.dilation_w;
+    CTYPE best = in[best_idx];
+    for (int64_t ky = ky_begin; ky < ky_end; ++ky) {
+      const int64_t y = y_start + ky * g.dilation_h;
+      for (int64_t kx = kx_begin; kx < kx_end; ++kx) {
+        const int64_t idx = y * g.in_w + x_start + kx * g.dilation_w;
+        const CTYPE value = in[idx];
+        if (is_greater_or_nan(value, best)) {
+          best = value;
+          best_idx = idx;
+        }
+      }
+    }
+    out[ox * out_x_stride] = best;
+    indices[ox * indices_x_stride] = best_idx;
+  }
+}
+
+/**
+ * Max pools one contiguous {H, W} plane of an NCHW input. `indices_strides`
+ * are the N, C, H, W strides of the indices, which may be laid out
+ * differently from the output.
+ */
+template <typename CTYPE>
+void max_pool2d_plane(
+    const Pool2dGeometry& g,
+    const CTYPE* in,
+    CTYPE* out,
+    int64_t* indices,
+    const int64_t* indices_strides) {
+  int64_t x_begin = 0;
+  int64_t x_end = 0;
+  get_interior_range(
+      g.out_w,
+      g.stride_w,
+      g.pad_w,
+      g.dilation_w,
+      g.kernel_w,
+      g.in_w,
+      &x_begin,
+      &x_end);
+  const bool unit_dilation = g.dilation_h == 1 && g.dilation_w == 1;
+  const bool is_2x2s2 = unit_dilation && g.kernel_h == 2 && g.kernel_w == 2 &&
+      g.stride_w == 2;
+  const bool is_3x3s2 = unit_dilation && g.kernel_h == 3 && g.kernel_w == 3 &&
+      g.stride_w == 2;
+
+  for (int64_t oy = 0; oy < g.out_h; ++oy) {
+    int64_t ky_begin = 0;
+    int64_t ky_end = 0;
+    get_valid_taps(
+        oy,
+        g.stride_h,
+        g.pad_h,
+        g.dilation_h,
+        g.kernel_h,
+        g.in_h,
+        &ky_begin,
+        &ky_end);
+    const int64_t y_start = oy * g.stride_h - g.pad_h;
+    CTYPE* out_row = out + oy * g.out_strides[2];
+    int64_t* indices_row = indices + oy * indices_strides[2];
+    const int64_t indices_x_stride = indices_strides[3];
+
+    const bool full_rows = ky_begin == 0 && ky_end == g.kernel_h;
+    if (full_rows && (is_2x2s2 || is_3x3s2)) {
+      const CTYPE* rows[3];
+      for (int64_t ky = 0; ky < g.kernel_h; ++ky) {
+        rows[ky] = in + (y_start + ky) * g.in_w;
+      }
+      max_row_generic(
+          g,
+          in,
+          y_start,
+          ky_begin,
+          ky_end,
+          0,
+          x_begin,
+          out_row,
+          indices_row,
+          indices_x_stride);
+      if (is_2x2s2) {
+        max_row_interior<CTYPE, 2, 2, 2>(
+            rows,
+            y_start,
+            g.in_w,
+            g.pad_w,
+            x_begin,
+            x_end,
+            out_row,
+            g.out_strides[3],
+            indices_row,
+            indices_x_stride);
+      } else {
+        max_row_interior<CTYPE, 3, 3, 2>(
+            rows,
+            y_start,
+            g.in_w,
+            g.pad_w,
+            x_begin,
+            x_end,
+            out_row,
+            g.out_strides[3],
+            indices_row,
+            indices_x_stride);
+      }
+      max_row_generic(
+          g,
+          in,
+          y_start,
+          ky_begin,
+          ky_end,
+          x_end,
+          g.out_w,
+          out_row,
+          indices_row,
+          indices_x_stride);
+    } else {
+      max_row_generic(
+          g,
+          in,
+          y_start,
+          ky_begin,
+          ky_end,
+          0,
+          g.out_w,
+          out_row,
+          indices_row,
+          indices_x_stride);
+    }
+  }
+}
+
+/**
+ * Max pools the channels in [c_begin, c_end) of one output row of an NHWC
+ * input. The running maximum of each channel is kept in a small buffer so
+ * that the loops over channels read the input contiguously.
+ */
+template <typename CTYPE>
+void max_pool2d_row_channels_last(
+    const Pool2dGeometry& g,
+    const CTYPE* in,
+    int64_t oy,
+    int64_t c_begin,
+    int64_t c_end,
+    CTYPE* out,
+    int64_t* indices,
+    const int64_t* indices_strides) {
+  CTYPE best[kChannelBlock];
+  int64_t best_idx[kChannelBlock];
+  const int64_t num_c = c_end - c_begin;
+  const int64_t y_start = oy * g.stride_h - g.pad_h;
+  int64_t ky_begin = 0;
+  int64_t ky_end = 0;
+  get_valid_taps(
+      oy,
+      g.stride_h,
+      g.pad_h,
+      g.dilation_h,
+      g.kernel_h,
+      g.in_h,
+      &ky_begin,
+      &ky_end);
+
+  for (int64_t ox = 0; ox < g.out_w; ++ox) {
+    int64_t kx_begin = 0;
+    int64_t kx_end = 0;
+    get_valid_taps(
+        ox,
+        g.stride_w,
+        g.pad_w,
+        g.dilation_w,
+        g.kernel_w,
+        g.in_w,
+        &kx_begin,
+        &kx_end);
+    if (ky_begin >= ky_end || kx_begin >= kx_end) {
+      continue;
+    }
+    const int64_t x_start = ox * g.stride_w - g.pad_w;
+    bool first = true;
+    for (int64_t ky = ky_begin; ky < ky_end; ++ky) {
+      const int64_t y = y_start + ky * g.dilation_h;
+      for (int64_t kx = kx_begin; kx < kx_end; ++kx) {
+        const int64_t x = x_start + kx * g.dilation_w;
+        const int64_t idx = y * g.in_w + x;
+        const CTYPE* pixel =
+            in + y * g.in_strides[2] + x * g.in_strides[3] + c_begin;
+        if (first) {
+          for (int64_t c = 0; c < num_c; ++c) {
+            best[c] = pixel[c];
+            best_idx[c] = idx;
+          }
+          first = false;
+        } else {
+          for (int64_t c = 0; c < num_c; ++c) {
+            const bool take = is_greater_or_nan(pixel[c], best[c]);
+            best[c] = take ? pixel[c] : best[c];
+            best_idx[c] = take ? idx : best_idx[c];
+          }
+        }
+      }
+    }
+    const int64_t out_offset = oy * g.out_strides[2] +
+        ox * g.out_strides[3] + c_begin * g.out_strides[1];
+    const int64_t indices_offset = oy * indices_strides[2] +
+        ox * indices_strides[3] + c_begin * indices_strides[1];
+    for (int64_t c = 0; c < num_c; ++c) {
+      out[out_offset + c * g.out_strides[1]] = best[c];
+      indices[indices_offset + c * indices_strides[1]] = best_idx[c];
+    }
+  }
+}
+
+template <typename CTYPE>
+void max_pool2d(
+    const Pool2dGeometry& g,
+    const CTYPE* in,
+    CTYPE* out,
+    int64_t* indices,
+    const int64_t* indices_strides) {
+  const int64_t taps_per_output = g.kernel_h * g.kernel_w;
+  if (g.channels_last) {
+    const int64_t num_blocks = (g.channels + kChannelBlock - 1) / kChannelBlock;
+    const int64_t taps_per_task = g.out_w * kChannelBlock * taps_per_output;
+    parallel_for(
+        g.batch * g.out_h * num_blocks,
+        kMinTapsPerTask / std::max<int64_t>(taps_per_task, 1),
+        [&](int64_t begin, int64_t end) {
+          for (int64_t task = begin; task < end; ++task) {
+            const int64_t block = task % num_blocks;
+            const int64_t oy = (task / num_blocks) % g.out_h;
+            const int64_t n = task / num_blocks / g.out_h;
+            const int64_t c_begin = block * kChannelBlock;
+            const int64_t c_end =
+                std::min(g.channels, c_begin + kChannelBlock);
+            max_pool2d_row_channels_last(
+                g,
+                in + n * g.in_strides[0],
+                oy,
+                c_begin,
+                c_end,
+                out + n * g.out_strides[0],
+                indices + n * indices_strides[0],
+                indices_strides);
+          }
+        });
+  } else {
+    const int64_t taps_per_plane = g.out_h * g.out_w * taps_per_output;
+    parallel_for(
+        g.batch * g.channels,
+        kMinTapsPerTask / std::max<int64_t>(taps_per_plane, 1),
+        [&](int64_t begin, int64_t end) {
+          for (int64_t plane = begin; plane < end; ++plane) {
+            const int64_t n = plane / g.channels;
+            const int64_t c = plane % g.channels;
+            max_pool2d_plane(
+                g,
+                in + n * g.in_strides[0] + c * g.in_strides[1],
+                out + n * g.out_strides[0] + c * g.out_strides[1],
+                indices + n * indices_strides[0] + c * indices_strides[1],
+                indices_strides);
+          }
+        });
+  }
+}
+
+} // namespace
+
+std::tuple<Tensor&, Tensor&> opt_max_pool2d_with_indices_out(
+    RuntimeContext& ctx,
+    const Tensor& in,
+    IntArrayRef kernel_size,
+    IntArrayRef stride,
+    IntArrayRef padding,
+    IntArrayRef dilation,
+    bool ceil_mode,
+    Tensor& out,
+    Tensor& indices) {
+  std::tuple<Tensor&, Tensor&> ret_val(out, indices);
+
+  ET_KERNEL_CHECK(
+      ctx,
+      check_max_pool2d_with_indices_args(
+          in, kernel_size, stride, padding, dilation, ceil_mode, out, indices),
+      InvalidArgument,
+      ret_val);
+
+  // The indices are written with their own strides, so they may use a
+  // different one of the supported layouts than out.
+  ET_KERNEL_CHECK(
+      ctx,
+      tensor_is_default_or_channels_last_dim_order(indices),
+      InvalidArgument,
+      ret_val);
+
+  size_t output_ndim = 0;
+  exec_aten::SizesType output_sizes[kTensorDimensionLimit];
+  get_max_pool2d_with_indices_out_target_size(
+      in,
+      kernel_size,
+      stride,
+      padding,
+      dilation,
+      ceil_mode,
+      output_sizes,
+      &output_ndim);
+
+  ET_KERNEL_CHECK(
+      ctx,
+      output_size_is_valid({output_sizes, output_ndim}, 2),
+      InvalidArgument,
+      ret_val);
+
+  ET_KERNEL_CHECK(
+      ctx,
+      resize_tensor(out, {output_sizes, output_ndim}) == Error::Ok,
+      InvalidArgument,
+      ret_val);
+
+  ET_KERNEL_CHECK(
+      ctx,
+      resize_tensor(indices, {output_sizes, output_ndim}) == Error::Ok,
+      InvalidArgument,
+      ret_val);
+
+  const Pool2dGeometry geometry =
+      get_pool2d_geometry(in, out, kernel_size, stride, padding, dilation);
+  int64_t indices_strides[4];
+  internal::get_nchw_strides(indices, indices_strides);
+
+  ScalarType in_type = in.scalar_type();
+  ET_SWITCH_REAL_TYPES(
+      in_type, ctx, "max_pool2d_with_indices.out", CTYPE, [&]() {
+        max_pool2d<CTYPE>(
+            geometry,
+            in.const_data_ptr<CTYPE>(),
+            out.mutable_data_ptr<CTYPE>(),
+            indices.mutable_data_ptr<int64_t>(),
+            indices_strides);
+      });
+
+  return ret_val;
+}
+
+} // namespace native
+} // namespace executor
+} // namespace torch
@@ -0,0 +1,184 @@
+/*
+ * Copyright (c) Meta Platforms, Inc. and affiliates.
+ * All rights reserved.
+ *
+ * This source code is licensed under the BSD-style license found in the
+ * LICENSE file in the root directory of this source tree.
+ */
+
+#include <executorch/runtime/kernel/kernel_includes.h>
+#include <algorithm>
+#include <cmath>
+#include <tuple>
+
+#include <executorch/kernels/optimized/cpu/moments_utils.h>
+#include <executorch/kernels/optimized/cpu/parallel_utils.h>
+#include <executorch/kernels/optimized/vec/functional.h>
+#include <executorch/kernels/optimized/vec/vec.h>
+#include <executorch/kernels/portable/cpu/util/normalization_ops_util.h>
+
+namespace torch {
+namespace executor {
+namespace native {
+
+using Tensor = exec_aten::Tensor;
+
+namespace {
+
+template <typename CTYPE>
+void group_norm(
+    const Tensor& input,
+    const optional<Tensor>& weight,
+    const optional<Tensor>& bias,
+    int64_t N,
+    int64_t C,
+    int64_t HxW,
+    int64_t G,
+    CTYPE eps,
+    Tensor& out,
+    Tensor& mean,
+    Tensor& rstd) {
+  using Vec = ::executorch::vec::Vectorized<CTYPE>;
+
+  // Each of the N * G groups is a contiguous run of D channels of HxW
+  // elements.
+  const int64_t M = N * G;
+  const int64_t D = C / G;
+  const int64_t inner_size = D * HxW;
+
+  if (M == 0) {
+    return;
+  }
+
+  CTYPE* out_data = out.mutable_data_ptr<CTYPE>();
+  CTYPE* mean_data = mean.mutable_data_ptr<CTYPE>();
+  CTYPE* rstd_data = rstd.mutable_data_ptr<CTYPE>();
+
+  if (inner_size == 0) {
+    for (int64_t i = 0; i < M; ++i) {
+      mean_data[i] = static_cast<CTYPE>(0);
+      rstd_data[i] = static_cast<CTYPE>(NAN);
+    }
+    return;
+  }
+
+  const CTYPE* input_data = input.const_data_ptr<CTYPE>();
+  const CTYPE* gamma_data =
+      weight.has_value() ? weight.value().const_data_ptr<CTYPE>() : nullptr;
+  const CTYPE* beta_data =
+      bias.has_value() ? bias.value().const_data_ptr<CTYPE>() : nullptr;
+
+  const int64_t grain_size =
+      std::max<int64_t>(1, kMinElementsPerTask / inner_size);
+  parallel_for(M, grain_size, [&](int64_t begin, int64_t end) {
+    for (int64_t i = begin; i < end; ++i) {
+      const CTYPE* src_ptr = input_data + i * inner_size;
+      CTYPE* dst_ptr = out_data + i * inner_size;
+
+      CTYPE mean_val;
+      CTYPE rstd_val;
+      std::tie(mean_val, rstd_val) = RowwiseMoments(src_ptr, inner_size);
+      rstd_val = CTYPE(1) / std::sqrt(rstd_val + eps);
+
+      // Fold the normalization and the affine transform of each channel into
+      // a single scale and offset, so that each element costs one fma.
+      const int64_t c0 = (i % G) * D;
+      for (int64_t d = 0; d < D; ++d) {
+        const CTYPE gamma_v =
+            gamma_data == nullptr ? CTYPE(1) : gamma_data[c0 + d];
+        const CTYPE beta_v =
+            beta_data == nullptr ? CTYPE(0) : beta_data[c0 + d];
+        const CTYPE scale = rstd_val * gamma_v;
+        const CTYPE offset = beta_v - scale * mean_val;
+        const CTYPE* x = src_ptr + d * HxW;
+        CTYPE* y = dst_ptr + d * HxW;
+        if (HxW < Vec::size()) {
+          for (int64_t j = 0; j < HxW; ++j) {
+            y[j] = x[j] * scale + offset;
+          }
+        } else {
+          ::executorch::vec::map<CTYPE>(
+              [scale, offset](Vec v) {
+                return ::executorch::vec::fmadd(v, Vec(scale), Vec(offset));
+              },
+              y,
+              x,
+              HxW);
+        }
+      }
+
+      mean_data[i] = mean_val;
+      rstd_data[i] = rstd_val;
+    }
+  });
+}
+
+} // namespace
+
+std::tuple<Tensor&, Tensor&, Tensor&> opt_native_group_norm_out(
+    RuntimeContext& ctx,
+    const Tensor& input,
+    const exec_aten::optional<Tensor>& weight,
+    const exec_aten::optional<Tensor>& bias,
+    int64_t N,
+    int64_t C,
+    int64_t HxW,
+    int64_t group,
+    double eps,
+    Tensor& out,
+    Tensor& mean_out,
+    Tensor& rstd_out) {
+  (void)ctx;
+
+  std::tuple<Tensor&, Tensor&, Tensor&> ret_val(out, mean_out, rstd_out);
+
+  ET_KERNEL_CHECK(
+      ctx,
+      check_group_norm_args(
+          input, weight, bias, N, C, HxW, group, out, mean_out, rstd_out),
+      InvalidArgument,
+      ret_val);
+
+  Tensor::SizesType mean_rstd_sizes[2] = {
+      static_cast<Tensor::SizesType>(N), static_cast<Tensor::SizesType>(group)};
+
+  ET_KERNEL_CHECK(
+      ctx,
+      resize_tensor(out, input.sizes()) == Error::Ok,
+      InvalidArgument,
+      ret_val);
+
+  ET_KERNEL_CHECK(
+      ctx,
+      resize_tensor(mean_out, {mean_rstd_sizes, 2}) == Error::Ok,
+      InvalidArgument,
+      ret_val);
+
+  ET_KERNEL_CHECK(
+      ctx,
+      resize_tensor(rstd_out, {mean_rstd_sizes, 2}) == Error::Ok,
+      InvalidArgument,
+      ret_val);
+
+  ET_SWITCH_FLOAT_TYPES(
+      input.scalar_type(), ctx, "native_group_norm.out", CTYPE, [&]() {
+        group_norm<CTYPE>(
+            input,
+            weight,
+            bias,
+            N,
+            C,
+            HxW,
+            group,
+            eps,
+            out,
+            mean_out,
+            rstd_out);
+      });
+
+  return ret_val;
+}
+
+} // namespace native
+} // namespace executor
+} // namespace torch
@@ -0,0 +1,121 @@
+/*
+ * Copyright (c) Meta Platforms, Inc. and affiliates.
+ * All rights reserved.
+ *
+ * This source code is licensed under the BSD-style license found in the
+ * LICENSE file in the root directory of this source tree.
+ */
+
+#include <executorch/runtime/kernel/kernel_includes.h>
+#include <algorithm>
+#include <cmath>
+
+#include <executorch/kernels/optimized/cpu/parallel_utils.h>
+#include <executorch/kernels/optimized/vec/functional.h>
+#include <executorch/kernels/optimized/vec/vec.h>
+
+namespace torch {
+namespace executor {
+namespace native {
+
+using Tensor = exec_aten::Tensor;
+
+namespace {
+
+bool check_rms_norm_args(
+    const Tensor& in,
+    const exec_aten::optional<Tensor>& weight,
+    const Tensor& out) {
+  ET_LOG_AND_RETURN_IF_FALSE(tensor_is_floating_type(in));
+  ET_LOG_AND_RETURN_IF_FALSE(tensors_have_same_dtype(in, out));
+  if (weight.has_value()) {
+    ET_LOG_AND_RETURN_IF_FALSE(tensors_have_same_dtype(in, weight.value()));
+    ET_LOG_AND_RETURN_IF_FALSE(tensor_is_rank(weight.value(), 1));
+    ET_LOG_MSG_AND_RETURN_IF_FALSE(
+        weight.value().size(0) == nonempty_size(in, in.dim() - 1),
+        "Expected weight to match the size of input's last dimension.");
+  }
+  return true;
+}
+
+template <typename CTYPE>
+void rms_norm(
+    const Tensor& input,
+    const exec_aten::optional<Tensor>& weight,
+    CTYPE eps,
+    Tensor& out) {
+  using Vec = ::executorch::vec::Vectorized<CTYPE>;
+
+  const int64_t N = nonempty_size(input, input.dim() - 1);
+  if (input.numel() == 0) {
+    return;
+  }
+  const int64_t M = input.numel() / N;
+
+  const CTYPE* input_data = input.const_data_ptr<CTYPE>();
+  const CTYPE* weight_data =
+      weight.has_value() ? weight.value().const_data_ptr<CTYPE>() : nullptr;
+  CTYPE* out_data = out.mutable_data_ptr<CTYPE>();
+
+  const int64_t grain_size = std::max<int64_t>(1, kMinElementsPerTask / N);
+  parallel_for(M, grain_size, [&](int64_t begin, int64_t end) {
+    for (int64_t i = begin; i < end; ++i) {
+      const CTYPE* src_ptr = input_data + i * N;
+      CTYPE* dst_ptr = out_data + i * N;
+
+      // One vectorized pass for the mean square, and one that applies the
+      // reciprocal rms and the weight together.
+      const CTYPE sum_sq = ::executorch::vec::map_reduce_all<CTYPE>(
+          [](Vec x) { return x * x; },
+          [](Vec x, Vec y) { return x + y; },
+          src_ptr,
+          N);
+      const CTYPE scale = CTYPE(1) / std::sqrt(sum_sq / N + eps);
+
+      if (weight_data == nullptr) {
+        ::executorch::vec::map<CTYPE>(
+            [scale](Vec x) { return x * Vec(scale); }, dst_ptr, src_ptr, N);
+      } else {
+        ::executorch::vec::map2<CTYPE>(
+            [scale](Vec x, Vec w) { return x * Vec(scale) * w; },
+            dst_ptr,
+            src_ptr,
+            weight_data,
+            N);
+      }
+    }
+  });
+}
+
+} // namespace
+
+// llama::rms_norm.out(Tensor input, Tensor? weight, float eps, *,
+// Tensor(a!) out) -> Tensor(a!)
+//
+// Computes input * rsqrt(mean(input^2, dim=-1, keepdim=True) + eps) * weight,
+// which is the RMSNorm of the llama2 example fused into a single kernel.
+Tensor& opt_rms_norm_out(
+    RuntimeContext& ctx,
+    const Tensor& input,
+    const exec_aten::optional<Tensor>& weight,
+    double eps,
+    Tensor& out) {
+  ET_KERNEL_CHECK(
+      ctx, check_rms_norm_args(input, weight, out), InvalidArgument, out);
+
+  ET_KERNEL_CHECK(
+      ctx,
+      resize_tensor(out, input.sizes()) == Error::Ok,
+      InvalidArgument,
+      out);
+
+  ET_SWITCH_FLOAT_TYPES(input.scalar_type(), ctx, "rms_norm.out", CTYPE, [&]() {
+    rms_norm<CTYPE>(input, weight, eps, out);
+  });
+
+  return out;
+}
+
+} // namespace native
+} // namespace executor
+} // namespace torch
@@ -0,0 +1,117 @@
+/*
+ * Copyright (c) Meta Platforms, Inc. and affiliates.
+ * All rights reserved.
+ *
+ * This source code is licensed under the BSD-style license found in the
+ * LICENSE file in the root directory of this source tree.
+ */
+
+#include <executorch/kernels/optimized/cpu/dtype_convert.h>
+#include <executorch/runtime/core/exec_aten/util/dim_order_util.h>
+#include <executorch/runtime/kernel/kernel_includes.h>
+
+namespace torch {
+namespace executor {
+namespace native {
+
+using Tensor = exec_aten::Tensor;
+
+namespace {
+
+/// Returns true if `out` is laid out in the given dim order.
+bool has_dim_order(const Tensor& out, ArrayRef<int64_t> expected) {
+  if (expected.size() != static_cast<size_t>(out.dim())) {
+    return false;
+  }
+  exec_aten::DimOrderType dim_order[kTensorDimensionLimit];
+  if (get_dim_order(out, dim_order, out.dim()) != Error::Ok) {
+    return false;
+  }
+  for (size_t i = 0; i < expected.size(); ++i) {
+    if (dim_order[i] != expected[i]) {
+      return false;
+    }
+  }
+  return true;
+}
+
+/// Returns true if `out` is laid out contiguously.
+bool has_default_dim_order(const Tensor& out) {
+  exec_aten::DimOrderType dim_order[kTensorDimensionLimit];
+  return get_dim_order(out, dim_order, out.dim()) == Error::Ok &&
+      is_default_dim_order(dim_order, out.dim());
+}
+
+/// Resizes `out` like `self` and converts into it; `out` keeps its own dim
+/// order, which may differ from `self`'s.
+Tensor& copy_converted(RuntimeContext& ctx, const Tensor& self, Tensor& out) {
+  ET_KERNEL_CHECK_MSG(
+      ctx,
+      resize_tensor(out, self.sizes()) == Error::Ok,
+      InvalidArgument,
+      out,
+      "Failed to resize output tensor.");
+  ET_KERNEL_CHECK_MSG(
+      ctx,
+      can_convert(self.scalar_type(), out.scalar_type()),
+      InvalidArgument,
+      out,
+      "Unsupported conversion from dtype %" PRId8 " to %" PRId8,
+      static_cast<int8_t>(self.scalar_type()),
+      static_cast<int8_t>(out.scalar_type()));
+  convert_tensor(self, out);
+  return out;
+}
+
+} // namespace
+
+// to_copy.out(Tensor self, *, bool non_blocking=False, MemoryFormat?
+// memory_format=None, Tensor(a!) out) -> Tensor(a!)
+Tensor& opt_to_copy_out(
+    RuntimeContext& ctx,
+    const Tensor& self,
+    bool non_blocking,
+    exec_aten::optional<exec_aten::MemoryFormat> memory_format,
+    Tensor& out) {
+  // Right now we only support blocking data transfer
+  ET_KERNEL_CHECK(ctx, non_blocking == false, InvalidArgument, out);
+
+  // Without a memory format the output keeps the dim order it was planned
+  // with, which need not match the input's.
+  ET_KERNEL_CHECK_MSG(
+      ctx,
+      !memory_format.has_value() ||
+          (memory_format.value() == exec_aten::MemoryFormat::Contiguous &&
+           has_default_dim_order(out)),
+      InvalidArgument,
+      out,
+      "The output must be contiguous to use memory_format=Contiguous.");
+
+  return copy_converted(ctx, self, out);
+}
+
+// _to_dim_order_copy.out(Tensor self, *, bool non_blocking=False, int[]?
+// dim_order=None, Tensor(a!) out) -> Tensor(a!)
+Tensor& opt__to_dim_order_copy_out(
+    RuntimeContext& ctx,
+    const Tensor& self,
+    bool non_blocking,
+    exec_aten::optional<exec_aten::ArrayRef<int64_t>> dim_order,
+    Tensor& out) {
+  // Right now we only support blocking data transfer
+  ET_KERNEL_CHECK(ctx, non_blocking == false, InvalidArgument, out);
+
+  // The requested dim order was planned into the output.
+  ET_KERNEL_CHECK_MSG(
+      ctx,
+      !dim_order.has_value() || has_dim_order(out, dim_order.value()),
+      InvalidArgument,
+      out,
+      "The output's dim order doesn't match the requested one.");
+
+  return copy_converted(ctx, self, out);
+}
+
+} // namespace native
+} // namespace executor
+} // namespace torch
@@ -0,0 +1,109 @@
+/*
+ * Copyright (c) Meta Platforms, Inc. and affiliates.
+ * All rights reserved.
+ *
+ * This source code is licensed under the BSD-style license found in the
+ * LICENSE file in the root directory of this source tree.
+ */
+
+#include <algorithm>
+#include <tuple>
+
+#include <executorch/kernels/optimized/cpu/parallel_utils.h>
+#include <executorch/kernels/portable/cpu/util/sort_util.h>
+#include <executorch/runtime/kernel/kernel_includes.h>
+
+namespace torch {
+namespace executor {
+namespace native {
+
+using Tensor = exec_aten::Tensor;
+
+namespace {
+
+} // namespace
+
+/**
+ * Returns the `k` largest elements of `in` along `dim`, or the smallest
+ * unless `largest` is set, in `values`, and their positions along `dim` in
+ * `indices`. If `sorted` is set they are ordered largest (or smallest)
+ * first. NaN counts as larger than every other value, and equal elements
+ * are taken in order of position.
+ */
+std::tuple<Tensor&, Tensor&> opt_topk_out(
+    RuntimeContext& ctx,
+    const Tensor& in,
+    int64_t k,
+    int64_t dim,
+    bool largest,
+    bool sorted,
+    Tensor& values,
+    Tensor& indices) {
+  std::tuple<Tensor&, Tensor&> ret_val(values, indices);
+
+  ET_KERNEL_CHECK(
+      ctx,
+      check_topk_args(in, k, dim, values, indices),
+      InvalidArgument,
+      ret_val);
+
+  Tensor::SizesType out_sizes[kTensorDimensionLimit];
+  for (size_t d = 0; d < in.dim(); ++d) {
+    out_sizes[d] = in.size(d);
+  }
+  if (in.dim() > 0) {
+    dim = dim < 0 ? dim + in.dim() : dim;
+    out_sizes[dim] = k;
+  }
+  ArrayRef<Tensor::SizesType> out_shape{
+      out_sizes, static_cast<size_t>(in.dim())};
+  ET_KERNEL_CHECK(
+      ctx,
+      resize_tensor(values, out_shape) == Error::Ok,
+      InvalidArgument,
+      ret_val);
+  ET_KERNEL_CHECK(
+      ctx,
+      resize_tensor(indices, out_shape) == Error::Ok,
+      InvalidArgument,
+      ret_val);
+
+  if (values.numel() == 0) {
+    return ret_val;
+  }
+
+  int64_t outer = 1;
+  int64_t n = 1;
+  int64_t inner = 1;
+  if (in.dim() > 0) {
+    outer = getLeadingDims(in, dim);
+    n = in.size(dim);
+    inner = getTrailingDims(in, dim);
+  }
+
+  ET_SWITCH_REAL_TYPES(in.scalar_type(), ctx, "topk.values", CTYPE, [&]() {
+    const CTYPE* const in_data = in.const_data_ptr<CTYPE>();
+    int64_t* const indices_data = indices.mutable_data_ptr<int64_t>();
+    CTYPE* const values_data = values.mutable_data_ptr<CTYPE>();
+    parallel_for(
+        outer * inner,
+        std::max<int64_t>(1, kMinElementsPerTask / n),
+        [&](int64_t begin, int64_t end) {
+          select_top_k_rows(
+              in_data, n, inner, k, largest, sorted, begin, end, indices_data);
+        });
+    parallel_for(
+        outer,
+        std::max<int64_t>(1, kMinElementsPerTask / (k * inner)),
+        [&](int64_t begin, int64_t end) {
+          finish_ordered_slices(
+              in_data, n, inner, k, begin, end, values_data, indices_data);
+        });
+  });
+
+  return ret_val;
+}
+
+} // namespace native
+} // namespace executor
+} // namespace torch
@@ -0,0 +1,286 @@
+/*
+ * Copyright (c) Meta Platforms, Inc. and affiliates.
+ * All rights reserved.
+ *
+ * This source code is licensed under the BSD-style license found in the
+ * LICENSE file in the root directory of this source tree.
+ */
+
+#include <algorithm>
+
+#include <executorch/kernels/optimized/cpu/parallel_utils.h>
+#include <executorch/kernels/optimized/vec/vec.h>
+#include <executorch/kernels/portable/cpu/util/upsample_util.h>
+#include <executorch/runtime/kernel/kernel_includes.h>
+
+namespace torch {
+namespace executor {
+namespace native {
+
+using Tensor = exec_aten::Tensor;
+using ScalarType = exec_aten::ScalarType;
+
+namespace {
+
+// Output columns whose source columns and weights are computed together.
+constexpr int64_t kColumnBlock = 256;
+
+/// Source offsets and weights for a block of output columns.
+template <typename CTYPE>
+struct ColumnWeights {
+  int64_t offset0[kColumnBlock];
+  int64_t offset1[kColumnBlock];
+  CTYPE lambda0[kColumnBlock];
+  CTYPE lambda1[kColumnBlock];
+};
+
+template <typename CTYPE>
+void compute_column_weights(
+    int64_t x_begin,
+    int64_t x_count,
+    int64_t in_w,
+    int64_t out_w,
+    CTYPE ratio_w,
+    bool align_corners,
+    int64_t in_stride_w,
+    ColumnWeights<CTYPE>& weights) {
+  for (int64_t i = 0; i < x_count; ++i) {
+    int64_t in_x0, in_x1;
+    compute_source_index_and_lambda(
+        in_x0,
+        in_x1,
+        weights.lambda0[i],
+        weights.lambda1[i],
+        ratio_w,
+        x_begin + i,
+        in_w,
+        out_w,
+        align_corners);
+    weights.offset0[i] = in_x0 * in_stride_w;
+    weights.offset1[i] = in_x1 * in_stride_w;
+  }
+}
+
+/**
+ * Upsamples NHWC tensors. Each output pixel blends four input pixels, so the
+ * work is vectorized over their contiguous channels; output rows run in
+ * parallel.
+ */
+template <typename CTYPE>
+void upsample_bilinear2d_channels_last(
+    const Tensor& in,
+    bool align_corners,
+    CTYPE ratio_h,
+    CTYPE ratio_w,
+    Tensor& out) {
+  using Vec = ::executorch::vec::Vectorized<CTYPE>;
+
+  const CTYPE* const in_data = in.const_data_ptr<CTYPE>();
+  CTYPE* const out_data = out.mutable_data_ptr<CTYPE>();
+  const int64_t channels = in.size(1);
+  const int64_t in_h = in.size(2);
+  const int64_t in_w = in.size(3);
+  const int64_t out_h = out.size(2);
+  const int64_t out_w = out.size(3);
+
+  parallel_for(
+      out.size(0) * out_h,
+      std::max<int64_t>(1, kMinElementsPerTask / (out_w * channels)),
+      [&](int64_t begin, int64_t end) {
+        ColumnWeights<CTYPE> weights;
+        for (int64_t x0 = 0; x0 < out_w; x0 += kColumnBlock) {
+          const int64_t x_count = std::min(kColumnBlock, out_w - x0);
+          compute_column_weights(
+              x0,
+              x_count,
+              in_w,
+              out_w,
+              ratio_w,
+              align_corners,
+              channels,
+              weights);
+
+          for (int64_t row = begin; row < end; ++row) {
+            const int64_t n = row / out_h;
+            const int64_t y = row % out_h;
+            int64_t in_y0, in_y1;
+            CTYPE lambda_y0, lambda_y1;
+            compute_source_index_and_lambda(
+                in_y0,
+                in_y1,
+                lambda_y0,
+                lambda_y1,
+                ratio_h,
+                y,
+                in_h,
+                out_h,
+                align_corners);
+            const CTYPE* const in_image = in_data + n * in_h * in_w * channels;
+            const CTYPE* const in_row0 = in_image + in_y0 * in_w * channels;
+            const CTYPE* const in_row1 = in_image + in_y1 * in_w * channels;
+            CTYPE* const out_row = out_data + (row * out_w + x0) * channels;
+            const Vec wy0(lambda_y0);
+            const Vec wy1(lambda_y1);
+
+            for (int64_t i = 0; i < x_count; ++i) {
+              const CTYPE* const p00 = in_row0 + weights.offset0[i];
+              const CTYPE* const p01 = in_row0 + weights.offset1[i];
+              const CTYPE* const p10 = in_row1 + weights.offset0[i];
+              const CTYPE* const p11 = in_row1 + weights.offset1[i];
+              CTYPE* const dst = out_row + i * channels;
+              const CTYPE lambda_x0 = weights.lambda0[i];
+              const CTYPE lambda_x1 = weights.lambda1[i];
+              const Vec wx0(lambda_x0);
+              const Vec wx1(lambda_x1);
+
+              int64_t c = 0;
+              for (; c + Vec::size() <= channels; c += Vec::size()) {
+                const Vec top =
+                    wx0 * Vec::loadu(p00 + c) + wx1 * Vec::loadu(p01 + c);
+                const Vec bottom =
+                    wx0 * Vec::loadu(p10 + c) + wx1 * Vec::loadu(p11 + c);
+                (wy0 * top + wy1 * bottom).store(dst + c);
+              }
+              for (; c < channels; ++c) {
+                dst[c] = lambda_y0 *
+                        (lambda_x0 * p00[c] + lambda_x1 * p01[c]) +
+                    lambda_y1 * (lambda_x0 * p10[c] + lambda_x1 * p11[c]);
+              }
+            }
+          }
+        }
+      });
+}
+
+/**
+ * Upsamples tensors of any supported layout one output row of one channel
+ * at a time; the rows run in parallel.
+ */
+template <typename CTYPE>
+void upsample_bilinear2d_strided(
+    const Tensor& in,
+    bool align_corners,
+    CTYPE ratio_h,
+    CTYPE ratio_w,
+    Tensor& out) {
+  const CTYPE* const in_data = in.const_data_ptr<CTYPE>();
+  CTYPE* const out_data = out.mutable_data_ptr<CTYPE>();
+  const int64_t channels = in.size(1);
+  const int64_t in_h = in.size(2);
+  const int64_t in_w = in.size(3);
+  const int64_t out_h = out.size(2);
+  const int64_t out_w = out.size(3);
+  const auto in_strides = in.strides();
+  const auto out_strides = out.strides();
+
+  parallel_for(
+      out.size(0) * channels * out_h,
+      std::max<int64_t>(1, kMinElementsPerTask / out_w),
+      [&](int64_t begin, int64_t end) {
+        ColumnWeights<CTYPE> weights;
+        for (int64_t x0 = 0; x0 < out_w; x0 += kColumnBlock) {
+          const int64_t x_count = std::min(kColumnBlock, out_w - x0);
+          compute_column_weights(
+              x0,
+              x_count,
+              in_w,
+              out_w,
+              ratio_w,
+              align_corners,
+              in_strides[3],
+              weights);
+
+          for (int64_t row = begin; row < end; ++row) {
+            const int64_t y = row % out_h;
+            const int64_t c = (row / out_h) % channels;
+            const int64_t n = row / out_h / channels;
+            int64_t in_y0, in_y1;
+            CTYPE lambda_y0, lambda_y1;
+            compute_source_index_and_lambda(
+                in_y0,
+                in_y1,
+                lambda_y0,
+                lambda_y1,
+                ratio_h,
+                y,
+                in_h,
+                out_h,
+                align_corners);
+            const CTYPE* const in_plane =
+                in_data + n * in_strides[0] + c * in_strides[1];
+            const CTYPE* const in_row0 = in_plane + in_y0 * in_strides[2];
+            const CTYPE* const in_row1 = in_plane + in_y1 * in_strides[2];
+            CTYPE* const out_row = out_data + n * out_strides[0] +
+                c * out_strides[1] + y * out_strides[2] +
+                x0 * out_strides[3];
+
+            for (int64_t i = 0; i < x_count; ++i) {
+              out_row[i * out_strides[3]] = lambda_y0 *
+                      (weights.lambda0[i] * in_row0[weights.offset0[i]] +
+                       weights.lambda1[i] * in_row0[weights.offset1[i]]) +
+                  lambda_y1 *
+                      (weights.lambda0[i] * in_row1[weights.offset0[i]] +
+                       weights.lambda1[i] * in_row1[weights.offset1[i]]);
+            }
+          }
+        }
+      });
+}
+
+/// Whether `t` is a 4-D tensor whose channels are contiguous (NHWC).
+bool is_channels_last(const Tensor& t) {
+  return t.strides()[1] == 1 && t.strides()[3] == t.size(1);
+}
+
+} // namespace
+
+Tensor& opt_upsample_bilinear2d_vec_out(
+    RuntimeContext& ctx,
+    const Tensor& in,
+    const exec_aten::optional<exec_aten::ArrayRef<int64_t>> output_size,
+    bool align_corners,
+    const exec_aten::optional<exec_aten::ArrayRef<double>> scale_factors,
+    Tensor& out) {
+  ET_KERNEL_CHECK(
+      ctx,
+      check_upsample_bilinear2d_args(
+          in, output_size, align_corners, scale_factors, out),
+      InvalidArgument,
+      out);
+
+  double scale_h, scale_w;
+
+  ET_KERNEL_CHECK_MSG(
+      ctx,
+      resize_upsample_2d(
+          in, output_size, scale_factors, scale_h, scale_w, out) == Error::Ok,
+      InvalidArgument,
+      out,
+      "Failed to resize output tensor");
+
+  if (out.numel() == 0) {
+    return out;
+  }
+
+  const bool channels_last = is_channels_last(in) && is_channels_last(out);
+  ET_SWITCH_FLOAT_TYPES(
+      in.scalar_type(), ctx, "upsample_bilinear2d.out", CTYPE, [&]() {
+        const CTYPE ratio_h = area_pixel_compute_scale<CTYPE>(
+            in.size(2), out.size(2), align_corners, scale_h);
+        const CTYPE ratio_w = area_pixel_compute_scale<CTYPE>(
+            in.size(3), out.size(3), align_corners, scale_w);
+        if (channels_last) {
+          upsample_bilinear2d_channels_last<CTYPE>(
+              in, align_corners, ratio_h, ratio_w, out);
+        } else {
+          upsample_bilinear2d_strided<CTYPE>(
+              in, align_corners, ratio_h, ratio_w, out);
+        }
+      });
+
+  return out;
+}
+
+} // namespace native
+} // namespace executor
+} // namespace torch
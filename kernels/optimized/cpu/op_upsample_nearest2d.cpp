@@ -0,0 +1,186 @@
+/*
+ * Copyright (c) Meta Platforms, Inc. and affiliates.
+ * All rights reserved.
+ *
+ * This source code is licensed under the BSD-style license found in the
+ * LICENSE file in the root directory of this source tree.
+ */
+
+#include <algorithm>
+#include <cstring>
+
+#include <executorch/kernels/optimized/cpu/parallel_utils.h>
+#include <executorch/kernels/portable/cpu/util/upsample_util.h>
+#include <executorch/runtime/kernel/kernel_includes.h>
+
+namespace torch {
+namespace executor {
+namespace native {
+
+using Tensor = exec_aten::Tensor;
+using ScalarType = exec_aten::ScalarType;
+
+namespace {
+
+// Output columns whose source columns are computed together.
+constexpr int64_t kColumnBlock = 256;
+
+/**
+ * Upsamples NHWC tensors, where every output pixel is a copy of the
+ * contiguous channels of one input pixel. Output rows run in parallel, and
+ * a row whose source row matches the previous output row's is copied whole.
+ */
+template <typename CTYPE>
+void upsample_nearest2d_channels_last(
+    const Tensor& in,
+    float ratio_h,
+    float ratio_w,
+    Tensor& out) {
+  const CTYPE* const in_data = in.const_data_ptr<CTYPE>();
+  CTYPE* const out_data = out.mutable_data_ptr<CTYPE>();
+  const int64_t channels = in.size(1);
+  const int64_t in_h = in.size(2);
+  const int64_t in_w = in.size(3);
+  const int64_t out_h = out.size(2);
+  const int64_t out_w = out.size(3);
+  const size_t pixel_bytes = channels * sizeof(CTYPE);
+  const size_t out_row_bytes = out_w * pixel_bytes;
+
+  parallel_for(
+      out.size(0) * out_h,
+      std::max<int64_t>(1, kMinElementsPerTask / (out_w * channels)),
+      [&](int64_t begin, int64_t end) {
+        int64_t in_x_offsets[kColumnBlock];
+        int64_t prev_in_y = -1;
+        for (int64_t row = begin; row < end; ++row) {
+          const int64_t n = row / out_h;
+          const int64_t y = row % out_h;
+          const int64_t in_y = nearest_idx(y, in_h, out_h, ratio_h);
+          CTYPE* const out_row = out_data + row * out_w * channels;
+          if (y > 0 && row > begin && in_y == prev_in_y) {
+            std::memcpy(out_row, out_row - out_w * channels, out_row_bytes);
+            continue;
+          }
+          prev_in_y = in_y;
+
+          const CTYPE* const in_row =
+              in_data + ((n * in_h) + in_y) * in_w * channels;
+          for (int64_t x0 = 0; x0 < out_w; x0 += kColumnBlock) {
+            const int64_t x_count = std::min(kColumnBlock, out_w - x0);
+            for (int64_t i = 0; i < x_count; ++i) {
+              in_x_offsets[i] =
+                  nearest_idx(x0 + i, in_w, out_w, ratio_w) * channels;
+            }
+            CTYPE* const dst = out_row + x0 * channels;
+            for (int64_t i = 0; i < x_count; ++i) {
+              std::memcpy(
+                  dst + i * channels, in_row + in_x_offsets[i], pixel_bytes);
+            }
+          }
+        }
+      });
+}
+
+/**
+ * Upsamples tensors of any supported layout one output row of one channel
+ * at a time; the rows run in parallel.
+ */
+template <typename CTYPE>
+void upsample_nearest2d_strided(
+    const Tensor& in,
+    float ratio_h,
+    float ratio_w,
+    Tensor& out) {
+  const CTYPE* const in_data = in.const_data_ptr<CTYPE>();
+  CTYPE* const out_data = out.mutable_data_ptr<CTYPE>();
+  const int64_t channels = in.size(1);
+  const int64_t in_h = in.size(2);
+  const int64_t in_w = in.size(3);
+  const int64_t out_h = out.size(2);
+  const int64_t out_w = out.size(3);
+  const auto in_strides = in.strides();
+  const auto out_strides = out.strides();
+
+  parallel_for(
+      out.size(0) * channels * out_h,
+      std::max<int64_t>(1, kMinElementsPerTask / out_w),
+      [&](int64_t begin, int64_t end) {
+        int64_t in_x_offsets[kColumnBlock];
+        for (int64_t x0 = 0; x0 < out_w; x0 += kColumnBlock) {
+          const int64_t x_count = std::min(kColumnBlock, out_w - x0);
+          for (int64_t i = 0; i < x_count; ++i) {
+            in_x_offsets[i] =
+                nearest_idx(x0 + i, in_w, out_w, ratio_w) * in_strides[3];
+          }
+
+          for (int64_t row = begin; row < end; ++row) {
+            const int64_t y = row % out_h;
+            const int64_t c = (row / out_h) % channels;
+            const int64_t n = row / out_h / channels;
+            const CTYPE* const in_row = in_data + n * in_strides[0] +
+                c * in_strides[1] +
+                nearest_idx(y, in_h, out_h, ratio_h) * in_strides[2];
+            CTYPE* const out_row = out_data + n * out_strides[0] +
+                c * out_strides[1] + y * out_strides[2] +
+                x0 * out_strides[3];
+            for (int64_t i = 0; i < x_count; ++i) {
+              out_row[i * out_strides[3]] = in_row[in_x_offsets[i]];
+            }
+          }
+        }
+      });
+}
+
+/// Whether `t` is a 4-D tensor whose channels are contiguous (NHWC).
+bool is_channels_last(const Tensor& t) {
+  return t.strides()[1] == 1 && t.strides()[3] == t.size(1);
+}
+
+} // namespace
+
+Tensor& opt_upsample_nearest2d_vec_out(
+    RuntimeContext& ctx,
+    const Tensor& in,
+    const exec_aten::optional<exec_aten::ArrayRef<int64_t>> output_size,
+    const exec_aten::optional<exec_aten::ArrayRef<double>> scale_factors,
+    Tensor& out) {
+  ET_KERNEL_CHECK(
+      ctx,
+      check_upsample_nearest2d_args(in, output_size, scale_factors, out),
+      InvalidArgument,
+      out);
+
+  double scale_h, scale_w;
+
+  ET_KERNEL_CHECK_MSG(
+      ctx,
+      resize_upsample_2d(
+          in, output_size, scale_factors, scale_h, scale_w, out) == Error::Ok,
+      InvalidArgument,
+      out,
+      "Failed to resize output tensor");
+
+  if (out.numel() == 0) {
+    return out;
+  }
+
+  const float ratio_h =
+      compute_nearest_scale(in.size(2), out.size(2), scale_h);
+  const float ratio_w =
+      compute_nearest_scale(in.size(3), out.size(3), scale_w);
+  const bool channels_last = is_channels_last(in) && is_channels_last(out);
+  ET_SWITCH_REAL_TYPES_AND(
+      Bool, in.scalar_type(), ctx, "upsample_nearest2d.out", CTYPE, [&]() {
+        if (channels_last) {
+          upsample_nearest2d_channels_last<CTYPE>(in, ratio_h, ratio_w, out);
+        } else {
+          upsample_nearest2d_strided<CTYPE>(in, ratio_h, ratio_w, out);
+        }
+      });
+
+  return out;
+}
+
+} // namespace native
+} // namespace executor
+} // namespace torch
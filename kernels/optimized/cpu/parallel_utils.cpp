@@ -0,0 +1,35 @@
+/*
+ * Copyright (c) Meta Platforms, Inc. and affiliates.
+ * All rights reserved.
+ *
+ * This source code is licensed under the BSD-style license found in the
+ * LICENSE file in the root directory of this source tree.
+ */
+
+#include <executorch/kernels/optimized/cpu/parallel_utils.h>
+
+#include <atomic>
+
+namespace torch {
+namespace executor {
+namespace native {
+
+namespace {
+
+// Constant-initialized, so backends may be installed by static initializers
+// in other translation units.
+std::atomic<ParallelBackend*> parallel_backend{nullptr};
+
+} // namespace
+
+ParallelBackend* set_parallel_backend(ParallelBackend* backend) {
+  return parallel_backend.exchange(backend);
+}
+
+ParallelBackend* get_parallel_backend() {
+  return parallel_backend.load(std::memory_order_acquire);
+}
+
+} // namespace native
+} // namespace executor
+} // namespace torch
@@ -0,0 +1,118 @@
+/*
+ * Copyright (c) Meta Platforms, Inc. and affiliates.
+ * All rights reserved.
+ *
+ * This source code is licensed under the BSD-style license found in the
+ * LICENSE file in the root directory of this source tree.
+ */
+
+#pragma once
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+
+namespace torch {
+namespace executor {
+namespace native {
+
+/**
+ * Runs the tasks that parallel_for() splits its work into.
+ *
+ * Kernels only depend on this interface, not on any particular threadpool.
+ * A library that owns threads provides an implementation and installs it with
+ * set_parallel_backend(); :threadpool_parallel_backend does this for the
+ * shared XNNPACK threadpool.
+ */
+class ParallelBackend {
+ public:
+  virtual ~ParallelBackend() = default;
+
+  /// Number of tasks that run() can execute concurrently.
+  virtual int64_t num_threads() = 0;
+
+  /**
+   * Calls `fn(i)` for every i in [0, num_tasks), possibly concurrently, and
+   * returns once all of the calls have returned.
+   */
+  virtual void run(const std::function<void(size_t)>& fn, size_t num_tasks) = 0;
+};
+
+/**
+ * Installs the backend that parallel_for() runs its tasks on, and returns the
+ * previous one. nullptr, the default, makes parallel_for() run serially on
+ * the calling thread.
+ *
+ * The backend must outlive every kernel call that may use it; it is typically
+ * a static object installed at static initialization time.
+ */
+ParallelBackend* set_parallel_backend(ParallelBackend* backend);
+
+/// Returns the installed backend, or nullptr if there is none.
+ParallelBackend* get_parallel_backend();
+
+/**
+ * Returns the number of threads parallel_for() can spread work across: the
+ * number reported by the installed backend, or 1 if there is none.
+ */
+inline int64_t get_num_parallel_threads() {
+  ParallelBackend* const backend = get_parallel_backend();
+  return backend == nullptr ? 1
+                            : std::max<int64_t>(backend->num_threads(), 1);
+}
+
+/**
+ * Rough amounts of work worth handing to one parallel_for() task; with less,
+ * waking a thread costs more than it saves. Kernels divide the one that
+ * matches their inner loop by the work per item to pick a grain size.
+ */
+/// Elements read or written by cheap per-element loops.
+constexpr int64_t kMinElementsPerTask = 16 * 1024;
+/// Bytes moved by gathers and copies.
+constexpr int64_t kMinBytesPerTask = 32 * 1024;
+/// Window taps visited by pooling.
+constexpr int64_t kMinTapsPerTask = 32 * 1024;
+/// Multiply-adds done by convolutions and GEMMs.
+constexpr int64_t kMinMacsPerTask = 256 * 1024;
+
+/**
+ * Calls `fn(begin, end)` over disjoint subranges that together cover
+ * [0, size). Each subrange holds at least `grain_size` items, except possibly
+ * the last.
+ *
+ * When a ParallelBackend is installed, the subranges run concurrently on it
+ * and this blocks until all of them are done. Otherwise `fn(0, size)` runs on
+ * the calling thread.
+ */
+template <typename Func>
+void parallel_for(int64_t size, int64_t grain_size, const Func& fn) {
+  if (size <= 0) {
+    return;
+  }
+  ParallelBackend* const backend = get_parallel_backend();
+  if (backend != nullptr) {
+    const int64_t num_threads = backend->num_threads();
+    const int64_t grain = std::max<int64_t>(grain_size, 1);
+    const int64_t num_tasks =
+        std::min<int64_t>(num_threads, (size + grain - 1) / grain);
+    if (num_tasks > 1) {
+      const int64_t chunk = (size + num_tasks - 1) / num_tasks;
+      backend->run(
+          [&](size_t task) {
+            const int64_t begin = static_cast<int64_t>(task) * chunk;
+            const int64_t end = std::min(size, begin + chunk);
+            if (begin < end) {
+              fn(begin, end);
+            }
+          },
+          static_cast<size_t>(num_tasks));
+      return;
+    }
+  }
+  fn(0, size);
+}
+
+} // namespace native
+} // namespace executor
+} // namespace torch
@@ -0,0 +1,159 @@
+/*
+ * Copyright (c) Meta Platforms, Inc. and affiliates.
+ * All rights reserved.
+ *
+ * This source code is licensed under the BSD-style license found in the
+ * LICENSE file in the root directory of this source tree.
+ */
+
+#pragma once
+
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <type_traits>
+
+#include <executorch/kernels/portable/cpu/util/kernel_ops_util.h>
+#include <executorch/runtime/core/exec_aten/util/dim_order_util.h>
+#include <executorch/runtime/kernel/kernel_includes.h>
+
+namespace torch {
+namespace executor {
+namespace native {
+
+/**
+ * Shape, layout and window parameters of a 2D pooling op, with the input and
+ * output viewed as 4-D {N, C, H, W} tensors.
+ */
+struct Pool2dGeometry {
+  int64_t batch;
+  int64_t channels;
+  int64_t in_h;
+  int64_t in_w;
+  int64_t out_h;
+  int64_t out_w;
+  /// Element strides of the input, in N, C, H, W order.
+  int64_t in_strides[4];
+  /// Element strides of the output, in N, C, H, W order.
+  int64_t out_strides[4];
+  int64_t kernel_h;
+  int64_t kernel_w;
+  int64_t stride_h;
+  int64_t stride_w;
+  int64_t pad_h;
+  int64_t pad_w;
+  int64_t dilation_h;
+  int64_t dilation_w;
+  /// Whether the input is laid out as NHWC rather than NCHW.
+  bool channels_last;
+};
+
+namespace internal {
+
+inline bool is_channels_last(const Tensor& t) {
+  exec_aten::DimOrderType dim_order[kTensorDimensionLimit];
+  return t.dim() == 4 && get_dim_order(t, dim_order, t.dim()) == Error::Ok &&
+      is_channels_last_dim_order(dim_order, t.dim());
+}
+
+/// Copies the strides of a 3-D or 4-D tensor into `strides` as N, C, H, W.
+inline void get_nchw_strides(const Tensor& t, int64_t* strides) {
+  const size_t offset = 4 - t.dim();
+  strides[0] = 0;
+  for (size_t i = 0; i < t.dim(); ++i) {
+    strides[offset + i] = t.strides()[i];
+  }
+}
+
+} // namespace internal
+
+/**
+ * Builds the pooling geometry for `in` and an already resized `out`. The
+ * window arguments have the defaults of the portable pooling ops; pass an
+ * empty `dilation` for ops that don't take one.
+ */
+inline Pool2dGeometry get_pool2d_geometry(
+    const Tensor& in,
+    const Tensor& out,
+    IntArrayRef kernel_size,
+    IntArrayRef stride,
+    IntArrayRef padding,
+    IntArrayRef dilation) {
+  Pool2dGeometry g;
+  const size_t ndim = in.dim();
+  g.batch = ndim == 4 ? in.size(0) : 1;
+  g.channels = in.size(ndim - 3);
+  g.in_h = in.size(ndim - 2);
+  g.in_w = in.size(ndim - 1);
+  g.out_h = out.size(ndim - 2);
+  g.out_w = out.size(ndim - 1);
+  internal::get_nchw_strides(in, g.in_strides);
+  internal::get_nchw_strides(out, g.out_strides);
+  g.kernel_h = val_at(kernel_size, 0);
+  g.kernel_w = val_at(kernel_size, 1);
+  g.stride_h = val_at(stride, 0, /*default_value=*/g.kernel_h);
+  g.stride_w = val_at(stride, 1, /*default_value=*/g.kernel_w);
+  g.pad_h = val_at(padding, 0, /*default_value=*/0);
+  g.pad_w = val_at(padding, 1, /*default_value=*/0);
+  g.dilation_h = val_at(dilation, 0, /*default_value=*/1);
+  g.dilation_w = val_at(dilation, 1, /*default_value=*/1);
+  g.channels_last = internal::is_channels_last(in);
+  return g;
+}
+
+/**
+ * Computes the range [*begin, *end) of kernel taps that land inside
+ * [0, in_size) for output position `out_idx` along one spatial dim.
+ */
+inline void get_valid_taps(
+    int64_t out_idx,
+    int64_t stride,
+    int64_t pad,
+    int64_t dilation,
+    int64_t kernel,
+    int64_t in_size,
+    int64_t* begin,
+    int64_t* end) {
+  const int64_t start = out_idx * stride - pad;
+  *begin = start < 0 ? (-start + dilation - 1) / dilation : 0;
+  if (start >= in_size) {
+    *end = *begin;
+    return;
+  }
+  *end = std::min(kernel, (in_size - 1 - start) / dilation + 1);
+  *end = std::max(*end, *begin);
+}
+
+/**
+ * Computes the range [*begin, *end) of output positions along one spatial
+ * dim whose kernel taps all land inside [0, in_size).
+ */
+inline void get_interior_range(
+    int64_t out_size,
+    int64_t stride,
+    int64_t pad,
+    int64_t dilation,
+    int64_t kernel,
+    int64_t in_size,
+    int64_t* begin,
+    int64_t* end) {
+  *begin = std::min(out_size, (pad + stride - 1) / stride);
+  const int64_t last_start = in_size - 1 + pad - (kernel - 1) * dilation;
+  *end = last_start < 0 ? 0 : std::min(out_size, last_start / stride + 1);
+  *end = std::max(*end, *begin);
+}
+
+/// Whether `value` should replace `best` in a max reduction. NaNs always win,
+/// so that they propagate to the output.
+template <typename CTYPE>
+inline bool is_greater_or_nan(CTYPE value, CTYPE best) {
+  if constexpr (std::is_floating_point<CTYPE>::value) {
+    return value > best || std::isnan(value);
+  } else {
+    return value > best;
+  }
+}
+
+} // namespace native
+} // namespace executor
+} // namespace torch
@@ -0,0 +1,239 @@
+/*
+ * Copyright (c) Meta Platforms, Inc. and affiliates.
+ * All rights reserved.
+ *
+ * This source code is licensed under the BSD-style license found in the
+ * LICENSE file in the root directory of this source tree.
+ */
+
+#pragma once
+
+// Inclusive scans shared by the optimized cumulative ops.
+//
+// A contiguous tensor scanned along one dim is viewed as
+// [outer, dim_size, inner]:
+// - When inner == 1, every scan runs along a contiguous row. Rows are split
+//   across threads, and rows too few to occupy every thread but long enough
+//   to be worth it are themselves split into blocks with a two-pass scan.
+// - Otherwise every step of the scan combines a row of `inner` values with
+//   the previous output row, vectorized across the row. Wide rows are split
+//   into column blocks that are scanned separately, so the previous output
+//   row is still in L1 when the next one reads it.
+
+#include <algorithm>
+#include <cstdint>
+
+#include <executorch/kernels/optimized/cpu/parallel_utils.h>
+#include <executorch/kernels/optimized/vec/vec.h>
+
+namespace torch {
+namespace executor {
+namespace native {
+namespace internal {
+
+// Columns of a non-last-dim scan that are scanned together.
+constexpr int64_t kScanColumnBlock = 1024;
+
+// Rows at least this long are split across threads when there are fewer
+// rows than threads.
+constexpr int64_t kMinParallelScanLength = 64 * 1024;
+
+// Upper bound on the blocks a row is split into by scan_row_parallel().
+constexpr int64_t kMaxScanBlocks = 64;
+
+/**
+ * Scans `n` contiguous values of `in` into `out`, continuing from `carry`,
+ * and returns the last result. `in` may be `out`.
+ *
+ * Each group of four values is scanned on its own before the carry is
+ * folded in, so only one `op` per group waits on the previous group.
+ */
+template <typename T, typename Op>
+T scan_contiguous(const T* in, T* out, int64_t n, T carry, const Op& op) {
+  int64_t i = 0;
+  for (; i + 4 <= n; i += 4) {
+    const T p0 = in[i];
+    const T p1 = op(p0, in[i + 1]);
+    const T p2 = op(p1, in[i + 2]);
+    const T p3 = op(p2, in[i + 3]);
+    out[i] = op(carry, p0);
+    out[i + 1] = op(carry, p1);
+    out[i + 2] = op(carry, p2);
+    carry = op(carry, p3);
+    out[i + 3] = carry;
+  }
+  for (; i < n; ++i) {
+    carry = op(carry, in[i]);
+    out[i] = carry;
+  }
+  return carry;
+}
+
+/// Replaces each of the `n` values at `data` with `op(carry, value)`.
+template <typename T, typename Op>
+void apply_scan_carry(T* data, int64_t n, T carry, const Op& op) {
+  using Vec = ::executorch::vec::Vectorized<T>;
+  const Vec carry_vec(carry);
+  int64_t i = 0;
+  for (; i + Vec::size() <= n; i += Vec::size()) {
+    op(carry_vec, Vec::loadu(data + i)).store(data + i);
+  }
+  for (; i < n; ++i) {
+    data[i] = op(carry, data[i]);
+  }
+}
+
+/**
+ * Scans one long contiguous row on all threads. The first pass scans
+ * equal-sized blocks of the row independently; the second folds the
+ * combined totals of the preceding blocks into every block.
+ */
+template <typename T, typename Op>
+void scan_row_parallel(
+    const T* in,
+    T* out,
+    int64_t n,
+    T identity,
+    const Op& op) {
+  const int64_t num_blocks =
+      std::min({get_num_parallel_threads(), kMaxScanBlocks, n});
+  const int64_t block_size = (n + num_blocks - 1) / num_blocks;
+  T block_carry[kMaxScanBlocks];
+
+  parallel_for(num_blocks, 1, [&](int64_t begin, int64_t end) {
+    for (int64_t b = begin; b < end; ++b) {
+      const int64_t start = std::min(b * block_size, n);
+      const int64_t len = std::min(block_size, n - start);
+      block_carry[b] =
+          scan_contiguous(in + start, out + start, len, identity, op);
+    }
+  });
+
+  // Turn each block's total into the result its scan continues from.
+  T carry = identity;
+  for (int64_t b = 0; b < num_blocks; ++b) {
+    const T total = block_carry[b];
+    block_carry[b] = carry;
+    carry = op(carry, total);
+  }
+
+  parallel_for(num_blocks - 1, 1, [&](int64_t begin, int64_t end) {
+    for (int64_t b = begin + 1; b < end + 1; ++b) {
+      const int64_t start = std::min(b * block_size, n);
+      const int64_t len = std::min(block_size, n - start);
+      apply_scan_carry(out + start, len, block_carry[b], op);
+    }
+  });
+}
+
+/// Scans each of `rows` contiguous rows of `n` values.
+template <typename T, typename Op>
+void scan_rows(
+    const T* in,
+    T* out,
+    int64_t rows,
+    int64_t n,
+    T identity,
+    const Op& op) {
+  if (rows < get_num_parallel_threads() && n >= kMinParallelScanLength) {
+    for (int64_t r = 0; r < rows; ++r) {
+      scan_row_parallel(in + r * n, out + r * n, n, identity, op);
+    }
+    return;
+  }
+  parallel_for(
+      rows,
+      std::max<int64_t>(1, kMinElementsPerTask / n),
+      [&](int64_t begin, int64_t end) {
+        for (int64_t r = begin; r < end; ++r) {
+          scan_contiguous(in + r * n, out + r * n, n, identity, op);
+        }
+      });
+}
+
+/// Sets each of the `n` values at `out` to `op(prev[i], in[i])`.
+template <typename T, typename Op>
+void combine_rows(const T* prev, const T* in, T* out, int64_t n, const Op& op) {
+  using Vec = ::executorch::vec::Vectorized<T>;
+  int64_t i = 0;
+  for (; i + Vec::size() <= n; i += Vec::size()) {
+    op(Vec::loadu(prev + i), Vec::loadu(in + i)).store(out + i);
+  }
+  for (; i < n; ++i) {
+    out[i] = op(prev[i], in[i]);
+  }
+}
+
+/**
+ * Scans the [outer, dim_size, inner] view of contiguous `in` along its
+ * middle dim into `out`, which may be `in`. `op` must be associative and
+ * accept both T and Vectorized<T> operands, e.g. std::plus<>; `identity` is
+ * its identity element.
+ */
+template <typename T, typename Op>
+void scan_dim(
+    const T* in,
+    T* out,
+    int64_t outer,
+    int64_t dim_size,
+    int64_t inner,
+    T identity,
+    const Op& op) {
+  if (inner == 1) {
+    scan_rows(in, out, outer, dim_size, identity, op);
+    return;
+  }
+
+  const int64_t slice_size = dim_size * inner;
+  if (inner < ::executorch::vec::Vectorized<T>::size()) {
+    // Rows too narrow to vectorize: walk each slice as one flat sequence in
+    // which every value combines with the one `inner` elements before it.
+    parallel_for(
+        outer,
+        std::max<int64_t>(1, kMinElementsPerTask / slice_size),
+        [&](int64_t begin, int64_t end) {
+          for (int64_t o = begin; o < end; ++o) {
+            const T* const src = in + o * slice_size;
+            T* const dst = out + o * slice_size;
+            std::copy(src, src + inner, dst);
+            for (int64_t i = inner; i < slice_size; ++i) {
+              dst[i] = op(dst[i - inner], src[i]);
+            }
+          }
+        });
+    return;
+  }
+
+  const int64_t block = std::min(inner, kScanColumnBlock);
+  const int64_t blocks_per_slice = (inner + block - 1) / block;
+
+  parallel_for(
+      outer * blocks_per_slice,
+      std::max<int64_t>(1, kMinElementsPerTask / (dim_size * block)),
+      [&](int64_t begin, int64_t end) {
+        for (int64_t b = begin; b < end; ++b) {
+          const int64_t o = b / blocks_per_slice;
+          const int64_t c = (b % blocks_per_slice) * block;
+          const int64_t width = std::min(block, inner - c);
+          const T* const src = in + o * slice_size + c;
+          T* const dst = out + o * slice_size + c;
+
+          if (src != dst) {
+            std::copy(src, src + width, dst);
+          }
+          for (int64_t j = 1; j < dim_size; ++j) {
+            combine_rows(
+                dst + (j - 1) * inner,
+                src + j * inner,
+                dst + j * inner,
+                width,
+                op);
+          }
+        }
+      });
+}
+
+} // namespace internal
+} // namespace native
+} // namespace executor
+} // namespace torch
@@ -5,14 +5,49 @@ _OPTIMIZED_ATEN_OPS = (
     op_target(
         name = "op_add",
         deps = [
+            ":dtype_convert",
             "//executorch/kernels/portable/cpu:scalar_utils",
             "//executorch/kernels/portable/cpu/util:broadcast_util",
         ],
     ),
+    op_target(
+        name = "op_avg_pool2d",
+        deps = [
+            ":parallel_utils",
+            ":pooling_utils",
+        ],
+    ),
     op_target(
         name = "op_bmm",
         deps = [
             "//executorch/kernels/optimized:libblas",
+            "//executorch/runtime/core:memory_allocator",
+            "//executorch/runtime/kernel:operator_registry",
+        ],
+    ),
+    op_target(
+        name = "op_convolution",
+        deps = [
+            ":parallel_utils",
+            "//executorch/kernels/optimized:libblas",
+            "//executorch/kernels/portable/cpu:scalar_utils",
+            "//executorch/kernels/portable/cpu/util:kernel_ops_util",
+        ],
+    ),
+    op_target(
+        name = "op_cumprod",
+        deps = [
+            ":dtype_convert",
+            ":scan_utils",
+            "//executorch/kernels/portable/cpu/util:reduce_util",
+        ],
+    ),
+    op_target(
+        name = "op_cumsum",
+        deps = [
+            ":dtype_convert",
+            ":scan_utils",
+            "//executorch/kernels/portable/cpu/util:reduce_util",
         ],
     ),
     op_target(
@@ -32,6 +67,21 @@ _OPTIMIZED_ATEN_OPS = (
             ],
         }),
     ),
+    op_target(
+        name = "op_index",
+        deps = [
+            ":parallel_utils",
+            "//executorch/kernels/portable/cpu/util:advanced_index_util",
+            "//executorch/kernels/portable/cpu/util:broadcast_util",
+        ],
+    ),
+    op_target(
+        name = "op_index_select",
+        deps = [
+            ":parallel_utils",
+            "//executorch/kernels/portable/cpu/util:index_util",
+        ],
+    ),
     op_target(
         name = "op_le",
         deps = [
@@ -50,13 +100,29 @@ _OPTIMIZED_ATEN_OPS = (
             ],
         }),
     ),
+    op_target(
+        name = "op_max_pool2d_with_indices",
+        deps = [
+            ":parallel_utils",
+            ":pooling_utils",
+        ],
+    ),
     op_target(
         name = "op_mul",
         deps = [
+            ":dtype_convert",
             "//executorch/kernels/portable/cpu:scalar_utils",
             "//executorch/kernels/portable/cpu/util:broadcast_util",
         ],
     ),
+    op_target(
+        name = "op_native_group_norm",
+        deps = [
+            ":moments_utils",
+            ":parallel_utils",
+            "//executorch/kernels/portable/cpu/util:normalization_ops_util",
+        ],
+    ),
     op_target(
         name = "op_native_layer_norm",
         deps = [
@@ -65,13 +131,55 @@ _OPTIMIZED_ATEN_OPS = (
         ],
     ),
     op_target(name = "op_neg"),
+    op_target(
+        name = "op_rms_norm",
+        deps = [
+            ":parallel_utils",
+        ],
+    ),
+    op_target(
+        name = "op_to_copy",
+        deps = [
+            ":dtype_convert",
+            "//executorch/runtime/core/exec_aten/util:tensor_util",
+        ],
+    ),
+    op_target(
+        name = "op_sort",
+        deps = [
+            ":parallel_utils",
+            "//executorch/kernels/portable/cpu/util:sort_util",
+        ],
+    ),
     op_target(
         name = "op_sub",
         deps = [
+            ":dtype_convert",
             "//executorch/kernels/portable/cpu:scalar_utils",
             "//executorch/kernels/portable/cpu/util:broadcast_util",
         ],
     ),
+    op_target(
+        name = "op_topk",
+        deps = [
+            ":parallel_utils",
+            "//executorch/kernels/portable/cpu/util:sort_util",
+        ],
+    ),
+    op_target(
+        name = "op_upsample_bilinear2d",
+        deps = [
+            ":parallel_utils",
+            "//executorch/kernels/portable/cpu/util:upsample_util",
+        ],
+    ),
+    op_target(
+        name = "op_upsample_nearest2d",
+        deps = [
+            ":parallel_utils",
+            "//executorch/kernels/portable/cpu/util:upsample_util",
+        ],
+    ),
 )
 
 def define_common_targets():
@@ -105,3 +213,64 @@ def define_common_targets():
             "//executorch/kernels/optimized:libutils",
         ],
     )
+
+    runtime.cxx_library(
+        name = "dtype_convert",
+        srcs = [],
+        exported_headers = ["dtype_convert.h"],
+        visibility = ["//executorch/kernels/optimized/..."],
+        exported_deps = [
+            "//executorch/kernels/optimized:libvec",
+            "//executorch/kernels/optimized:libutils",
+            "//executorch/runtime/kernel:kernel_includes",
+        ],
+    )
+
+    runtime.cxx_library(
+        name = "scan_utils",
+        srcs = [],
+        exported_headers = ["scan_utils.h"],
+        visibility = ["//executorch/kernels/optimized/..."],
+        exported_deps = [
+            ":parallel_utils",
+            "//executorch/kernels/optimized:libvec",
+        ],
+    )
+
+    runtime.cxx_library(
+        name = "parallel_utils",
+        srcs = ["parallel_utils.cpp"],
+        exported_headers = ["parallel_utils.h"],
+        visibility = ["//executorch/kernels/optimized/..."],
+    )
+
+    # Runs the parallel_for() of the optimized kernels on the shared
+    # threadpool. Link it into binaries that want multithreaded kernels.
+    runtime.cxx_library(
+        name = "threadpool_parallel_backend",
+        srcs = ["threadpool_parallel_backend.cpp"],
+        visibility = [
+            "//executorch/...",
+            "@EXECUTORCH_CLIENTS",
+        ],
+        deps = [
+            ":parallel_utils",
+            "//executorch/backends/xnnpack/threadpool:threadpool",
+        ],
+        # The backend is installed by a static initializer.
+        compiler_flags = ["-Wno-global-constructors"],
+        # @lint-ignore BUCKLINT: Avoid `link_whole=True` (https://fburl.com/avoid-link-whole)
+        link_whole = True,
+    )
+
+    runtime.cxx_library(
+        name = "pooling_utils",
+        srcs = [],
+        exported_headers = ["pooling_utils.h"],
+        visibility = ["//executorch/kernels/optimized/..."],
+        exported_deps = [
+            "//executorch/kernels/portable/cpu/util:kernel_ops_util",
+            "//executorch/runtime/core/exec_aten/util:tensor_util",
+            "//executorch/runtime/kernel:kernel_includes",
+        ],
+    )
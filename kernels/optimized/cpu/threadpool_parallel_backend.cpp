@@ -0,0 +1,53 @@
+/*
+ * Copyright (c) Meta Platforms, Inc. and affiliates.
+ * All rights reserved.
+ *
+ * This source code is licensed under the BSD-style license found in the
+ * LICENSE file in the root directory of this source tree.
+ */
+
+// Linking this file makes the optimized kernels run parallel_for() on the
+// shared threadpool. Without it they run serially.
+
+#include <executorch/backends/xnnpack/threadpool/threadpool.h>
+#include <executorch/kernels/optimized/cpu/parallel_utils.h>
+
+namespace torch {
+namespace executor {
+namespace native {
+
+namespace {
+
+class ThreadpoolParallelBackend final : public ParallelBackend {
+ public:
+  int64_t num_threads() override {
+    torch::executorch::threadpool::ThreadPool* const pool =
+        torch::executorch::threadpool::get_threadpool();
+    return pool == nullptr ? 1
+                           : static_cast<int64_t>(pool->get_thread_count());
+  }
+
+  void run(const std::function<void(size_t)>& fn, size_t num_tasks) override {
+    torch::executorch::threadpool::ThreadPool* const pool =
+        torch::executorch::threadpool::get_threadpool();
+    if (pool == nullptr) {
+      for (size_t i = 0; i < num_tasks; ++i) {
+        fn(i);
+      }
+      return;
+    }
+    pool->run(fn, num_tasks);
+  }
+};
+
+ThreadpoolParallelBackend threadpool_parallel_backend;
+
+// Installed at static initialization time, the same way kernels register.
+ParallelBackend* const previous_parallel_backend =
+    set_parallel_backend(&threadpool_parallel_backend);
+
+} // namespace
+
+} // namespace native
+} // namespace executor
+} // namespace torch
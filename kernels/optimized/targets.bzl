@@ -19,6 +19,14 @@ def define_common_targets():
         ],
     )
 
+    runtime.export_file(
+        name = "custom_ops.yaml",
+        visibility = [
+            "//executorch/...",
+            "@EXECUTORCH_CLIENTS",
+        ],
+    )
+
     runtime.cxx_library(
         name = "optimized_operators",
         srcs = [],
@@ -39,6 +47,14 @@ def define_common_targets():
         ],
     )
 
+    et_operator_library(
+        name = "optimized_custom_oplist",
+        ops_schema_yaml_target = ":custom_ops.yaml",
+        visibility = [
+            "@EXECUTORCH_CLIENTS",
+        ],
+    )
+
     # Used mainly for operator testing. In practice, a generated lib specific
     # to a project should be created that contains only the required operators
     # for a particular model.
@@ -46,9 +62,11 @@ def define_common_targets():
         name = "generated_lib",
         deps = [
             ":optimized_oplist",
+            ":optimized_custom_oplist",
             ":optimized_operators",
         ],
         functions_yaml_target = ":optimized.yaml",
+        custom_ops_yaml_target = ":custom_ops.yaml",
         define_static_targets = True,
         visibility = [
             "//executorch/...",
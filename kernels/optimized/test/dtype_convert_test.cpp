@@ -0,0 +1,136 @@
+/*
+ * Copyright (c) Meta Platforms, Inc. and affiliates.
+ * All rights reserved.
+ *
+ * This source code is licensed under the BSD-style license found in the
+ * LICENSE file in the root directory of this source tree.
+ */
+
+#include <gtest/gtest.h>
+
+#include <executorch/kernels/optimized/cpu/dtype_convert.h>
+
+#include <cmath>
+#include <cstdint>
+#include <limits>
+#include <vector>
+
+using exec_aten::BFloat16;
+using exec_aten::Half;
+using torch::executor::native::convert_contiguous;
+using torch::executor::native::convert_strided;
+using torch::executor::native::ConvertMode;
+
+namespace {
+
+template <typename T>
+uint16_t bits(T value) {
+  return torch::executor::native::internal::to_bits(value);
+}
+
+} // namespace
+
+TEST(DtypeConvertTest, FloatToHalfRoundsToNearestEven) {
+  // 1 + 2^-11 is halfway between 1 and the next half; ties go to even (1).
+  // 1 + 3 * 2^-11 is halfway between two halves; ties go to even (1 + 2^-9).
+  std::vector<float> in(
+      {1.0f,
+       1.0f + std::ldexp(1.0f, -11),
+       1.0f + 3 * std::ldexp(1.0f, -11),
+       65504.0f,
+       65520.0f,
+       -0.0f,
+       std::ldexp(1.0f, -24),
+       std::numeric_limits<float>::infinity()});
+  // Use a length that exercises both the vector body and the scalar tail.
+  const size_t n = in.size() * 3;
+  in.resize(n, 0.5f);
+  std::vector<Half> out(n);
+  convert_contiguous<float, Half>(in.data(), out.data(), n);
+
+  EXPECT_EQ(bits(out[0]), 0x3c00);
+  EXPECT_EQ(bits(out[1]), 0x3c00);
+  EXPECT_EQ(bits(out[2]), 0x3c02);
+  EXPECT_EQ(bits(out[3]), 0x7bff);
+  EXPECT_EQ(bits(out[4]), 0x7c00); // Rounds up to infinity.
+  EXPECT_EQ(bits(out[5]), 0x8000);
+  EXPECT_EQ(bits(out[6]), 0x0001); // Smallest subnormal.
+  EXPECT_EQ(bits(out[7]), 0x7c00);
+  for (size_t i = 8; i < n; ++i) {
+    EXPECT_EQ(bits(out[i]), 0x3800);
+  }
+
+  // Half to float is exact.
+  std::vector<float> back(n);
+  convert_contiguous<Half, float>(out.data(), back.data(), n);
+  EXPECT_EQ(back[0], 1.0f);
+  EXPECT_EQ(back[3], 65504.0f);
+  EXPECT_TRUE(std::signbit(back[5]));
+  EXPECT_EQ(back[6], std::ldexp(1.0f, -24));
+  EXPECT_TRUE(std::isinf(back[7]));
+}
+
+TEST(DtypeConvertTest, FloatToBFloat16RoundsToNearestEven) {
+  std::vector<float> in(
+      {1.0f,
+       1.0f + std::ldexp(1.0f, -8),
+       1.0f + 3 * std::ldexp(1.0f, -8),
+       std::numeric_limits<float>::quiet_NaN()});
+  std::vector<BFloat16> out(in.size());
+  convert_contiguous<float, BFloat16>(in.data(), out.data(), in.size());
+
+  EXPECT_EQ(bits(out[0]), 0x3f80);
+  EXPECT_EQ(bits(out[1]), 0x3f80);
+  EXPECT_EQ(bits(out[2]), 0x3f82);
+
+  std::vector<float> back(in.size());
+  convert_contiguous<BFloat16, float>(out.data(), back.data(), in.size());
+  EXPECT_TRUE(std::isnan(back[3]));
+}
+
+TEST(DtypeConvertTest, SaturateAndRound) {
+  std::vector<float> in({-1000.0f, -2.5f, 2.5f, 3.5f, 1000.0f, NAN});
+  std::vector<int8_t> out(in.size());
+
+  convert_contiguous<float, int8_t, ConvertMode::Saturate>(
+      in.data(), out.data(), in.size());
+  EXPECT_EQ(out, std::vector<int8_t>({-128, -2, 2, 3, 127, 0}));
+
+  convert_contiguous<float, int8_t, ConvertMode::Round>(
+      in.data(), out.data(), in.size());
+  EXPECT_EQ(out, std::vector<int8_t>({-128, -2, 2, 4, 127, 0}));
+
+  std::vector<int32_t> wide({-300, 300, 5});
+  std::vector<uint8_t> narrow(wide.size());
+  convert_contiguous<int32_t, uint8_t, ConvertMode::Saturate>(
+      wide.data(), narrow.data(), wide.size());
+  EXPECT_EQ(narrow, std::vector<uint8_t>({0, 255, 5}));
+}
+
+TEST(DtypeConvertTest, StridedToChannelsLast) {
+  // NCHW {1, 2, 2, 3} into NHWC.
+  const exec_aten::SizesType sizes[] = {1, 2, 2, 3};
+  const exec_aten::StridesType in_strides[] = {12, 6, 3, 1};
+  const exec_aten::StridesType out_strides[] = {12, 1, 6, 2};
+  std::vector<int32_t> in(12);
+  for (size_t i = 0; i < in.size(); ++i) {
+    in[i] = static_cast<int32_t>(i);
+  }
+  std::vector<float> out(12);
+  convert_strided<int32_t, float>(
+      in.data(), out.data(), 4, sizes, in_strides, out_strides);
+
+  for (int c = 0; c < 2; ++c) {
+    for (int h = 0; h < 2; ++h) {
+      for (int w = 0; w < 3; ++w) {
+        EXPECT_EQ(out[h * 6 + w * 2 + c], in[c * 6 + h * 3 + w]);
+      }
+    }
+  }
+
+  // And back again.
+  std::vector<int32_t> round_trip(12);
+  convert_strided<float, int32_t>(
+      out.data(), round_trip.data(), 4, sizes, out_strides, in_strides);
+  EXPECT_EQ(round_trip, in);
+}
@@ -0,0 +1,218 @@
+/*
+ * Copyright (c) Meta Platforms, Inc. and affiliates.
+ * All rights reserved.
+ *
+ * This source code is licensed under the BSD-style license found in the
+ * LICENSE file in the root directory of this source tree.
+ */
+
+#include <gtest/gtest.h>
+
+#include <executorch/runtime/core/exec_aten/exec_aten.h>
+#include <executorch/runtime/core/exec_aten/testing_util/tensor_factory.h>
+#include <executorch/runtime/core/exec_aten/testing_util/tensor_util.h>
+#include <executorch/runtime/core/memory_allocator.h>
+#include <executorch/runtime/kernel/kernel_includes.h>
+#include <executorch/runtime/kernel/operator_registry.h>
+#include <executorch/runtime/platform/runtime.h>
+
+#include <vector>
+
+using exec_aten::ScalarType;
+using exec_aten::Tensor;
+using torch::executor::Error;
+using torch::executor::EValue;
+using torch::executor::MemoryAllocator;
+using torch::executor::Prepack;
+using torch::executor::PrepackFunction;
+using torch::executor::RuntimeContext;
+using torch::executor::testing::TensorFactory;
+
+namespace torch {
+namespace executor {
+namespace native {
+Tensor& opt_bmm_out(
+    RuntimeContext& ctx,
+    const Tensor& self,
+    const Tensor& mat2,
+    Tensor& out);
+// Defined in op_bmm.cpp.
+extern const Prepack opt_bmm_out_prepacks[1];
+} // namespace native
+} // namespace executor
+} // namespace torch
+
+namespace {
+
+Tensor& op_bmm_out(const Tensor& self, const Tensor& mat2, Tensor& out) {
+  RuntimeContext context{};
+  return torch::executor::native::opt_bmm_out(context, self, mat2, out);
+}
+
+template <typename CTYPE>
+std::vector<CTYPE> iota(size_t n, int64_t start) {
+  std::vector<CTYPE> v(n);
+  for (size_t i = 0; i < n; ++i) {
+    // Keep the values small so that integer products don't overflow.
+    v[i] = static_cast<CTYPE>(static_cast<int64_t>(i % 7) + start);
+  }
+  return v;
+}
+
+// out[b][i][j] = sum_k self[b][i][k] * mat2[b][k][j], on contiguous data.
+template <typename CTYPE>
+std::vector<CTYPE> reference_bmm(
+    const std::vector<CTYPE>& self,
+    const std::vector<CTYPE>& mat2,
+    int64_t batch_size,
+    int64_t n,
+    int64_t k,
+    int64_t m) {
+  std::vector<CTYPE> out(batch_size * n * m, 0);
+  for (int64_t b = 0; b < batch_size; ++b) {
+    for (int64_t i = 0; i < n; ++i) {
+      for (int64_t j = 0; j < m; ++j) {
+        CTYPE sum = 0;
+        for (int64_t l = 0; l < k; ++l) {
+          sum += self[(b * n + i) * k + l] * mat2[(b * k + l) * m + j];
+        }
+        out[(b * n + i) * m + j] = sum;
+      }
+    }
+  }
+  return out;
+}
+
+PrepackFunction bmm_mat2_prepack() {
+  const Prepack& prepack = torch::executor::native::opt_bmm_out_prepacks[0];
+  EXPECT_EQ(prepack.arg_index_, 1);
+  return prepack.fn_;
+}
+
+template <ScalarType DTYPE>
+void test_prepacked_mat2_matches_unpacked() {
+  using CTYPE = typename TensorFactory<DTYPE>::ctype;
+  TensorFactory<DTYPE> tf;
+  constexpr int64_t kBatch = 2, kN = 3, kK = 5, kM = 4;
+
+  const std::vector<CTYPE> self_data = iota<CTYPE>(kBatch * kN * kK, -3);
+  const std::vector<CTYPE> mat2_data = iota<CTYPE>(kBatch * kK * kM, -2);
+  Tensor self = tf.make({kBatch, kN, kK}, self_data);
+  Tensor mat2 = tf.make({kBatch, kK, kM}, mat2_data);
+  Tensor expected = tf.make(
+      {kBatch, kN, kM},
+      reference_bmm(self_data, mat2_data, kBatch, kN, kK, kM));
+
+  Tensor out = tf.zeros({kBatch, kN, kM});
+  op_bmm_out(self, mat2, out);
+  EXPECT_TENSOR_CLOSE(out, expected);
+
+  PrepackFunction prepack = bmm_mat2_prepack();
+  ASSERT_NE(prepack, nullptr);
+  uint8_t buffer[1024];
+  MemoryAllocator allocator(sizeof(buffer), buffer);
+  EValue packed;
+  ASSERT_EQ(prepack(&allocator, EValue(mat2), &packed), Error::Ok);
+  ASSERT_TRUE(packed.isTensor());
+
+  // Same logical tensor, with each matrix stored transposed.
+  const Tensor& packed_mat2 = packed.toTensor();
+  EXPECT_EQ(packed_mat2.sizes(), mat2.sizes());
+  ASSERT_EQ(packed_mat2.dim_order().size(), 3);
+  EXPECT_EQ(packed_mat2.dim_order()[0], 0);
+  EXPECT_EQ(packed_mat2.dim_order()[1], 2);
+  EXPECT_EQ(packed_mat2.dim_order()[2], 1);
+  const CTYPE* packed_data = packed_mat2.const_data_ptr<CTYPE>();
+  for (int64_t b = 0; b < kBatch; ++b) {
+    for (int64_t row = 0; row < kK; ++row) {
+      for (int64_t col = 0; col < kM; ++col) {
+        EXPECT_EQ(
+            packed_data
+                [b * packed_mat2.strides()[0] +
+                 row * packed_mat2.strides()[1] +
+                 col * packed_mat2.strides()[2]],
+            mat2_data[(b * kK + row) * kM + col]);
+      }
+    }
+  }
+  // The constant itself is left as it was.
+  EXPECT_TENSOR_EQ(mat2, tf.make({kBatch, kK, kM}, mat2_data));
+
+  Tensor packed_out = tf.zeros({kBatch, kN, kM});
+  op_bmm_out(self, packed_mat2, packed_out);
+  EXPECT_TENSOR_CLOSE(packed_out, out);
+}
+
+} // namespace
+
+class OpBmmOutTest : public ::testing::Test {
+ protected:
+  void SetUp() override {
+    torch::executor::runtime_init();
+  }
+};
+
+TEST_F(OpBmmOutTest, PrepackedMat2MatchesUnpackedFloat) {
+  test_prepacked_mat2_matches_unpacked<ScalarType::Float>();
+}
+
+TEST_F(OpBmmOutTest, PrepackedMat2MatchesUnpackedInt) {
+  test_prepacked_mat2_matches_unpacked<ScalarType::Int>();
+}
+
+TEST_F(OpBmmOutTest, TransposedMat2WithoutPrepack) {
+  // Any mat2 with dim order {0, 2, 1} takes the transposed path, not just the
+  // ones made by the prepack function.
+  TensorFactory<ScalarType::Float> tf;
+  // mat2 = [[[1, 2], [3, 4], [5, 6]]], a (1, 3, 2) tensor.
+  Tensor self = tf.make({1, 2, 3}, {1, 0, 2, -1, 3, 1});
+  Tensor mat2 = tf.make({1, 3, 2}, {1, 2, 3, 4, 5, 6});
+  Tensor transposed =
+      tf.make_with_dimorder({1, 3, 2}, {1, 3, 5, 2, 4, 6}, {0, 2, 1});
+  Tensor expected = tf.make({1, 2, 2}, {11, 14, 13, 16});
+
+  Tensor out = tf.zeros({1, 2, 2});
+  op_bmm_out(self, mat2, out);
+  EXPECT_TENSOR_CLOSE(out, expected);
+
+  Tensor transposed_out = tf.zeros({1, 2, 2});
+  op_bmm_out(self, transposed, transposed_out);
+  EXPECT_TENSOR_CLOSE(transposed_out, expected);
+}
+
+TEST_F(OpBmmOutTest, PrepackLeavesOtherArgsUnpacked) {
+  PrepackFunction prepack = bmm_mat2_prepack();
+  ASSERT_NE(prepack, nullptr);
+  TensorFactory<ScalarType::Float> tf;
+  uint8_t buffer[1024];
+  MemoryAllocator allocator(sizeof(buffer), buffer);
+
+  // Not a tensor.
+  {
+    EValue packed;
+    EXPECT_EQ(prepack(&allocator, EValue(int64_t(1)), &packed), Error::Ok);
+    EXPECT_TRUE(packed.isNone());
+  }
+  // Not 3-D.
+  {
+    EValue packed;
+    EXPECT_EQ(
+        prepack(&allocator, EValue(tf.ones({2, 2})), &packed), Error::Ok);
+    EXPECT_TRUE(packed.isNone());
+  }
+  // Empty.
+  {
+    EValue packed;
+    EXPECT_EQ(
+        prepack(&allocator, EValue(tf.zeros({1, 0, 2})), &packed), Error::Ok);
+    EXPECT_TRUE(packed.isNone());
+  }
+  // Already transposed.
+  {
+    EValue packed;
+    Tensor transposed =
+        tf.make_with_dimorder({1, 2, 2}, {1, 2, 3, 4}, {0, 2, 1});
+    EXPECT_EQ(prepack(&allocator, EValue(transposed), &packed), Error::Ok);
+    EXPECT_TRUE(packed.isNone());
+  }
+}
@@ -0,0 +1,172 @@
+/*
+ * Copyright (c) Meta Platforms, Inc. and affiliates.
+ * All rights reserved.
+ *
+ * This source code is licensed under the BSD-style license found in the
+ * LICENSE file in the root directory of this source tree.
+ */
+
+/**
+ * @file
+ * Times the portable and optimized convolution.out kernels on the feature
+ * map shapes of examples/models/edsr (edsr_r16f64, x2, 224x224 input), and on
+ * the transposed convolutions a decoder would use to upsample those features.
+ *
+ * Usage: op_convolution_bench [iterations]
+ */
+
+#include <executorch/runtime/core/exec_aten/testing_util/tensor_factory.h>
+#include <executorch/runtime/kernel/kernel_includes.h>
+#include <executorch/runtime/platform/runtime.h>
+
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+
+namespace torch {
+namespace executor {
+namespace native {
+
+Tensor& convolution_out(
+    RuntimeContext& ctx,
+    const Tensor& in,
+    const Tensor& weight,
+    const exec_aten::optional<Tensor>& bias,
+    exec_aten::ArrayRef<int64_t> stride,
+    exec_aten::ArrayRef<int64_t> padding,
+    exec_aten::ArrayRef<int64_t> dilation,
+    bool transposed,
+    exec_aten::ArrayRef<int64_t> output_padding,
+    int64_t groups,
+    Tensor& out);
+
+Tensor& opt_convolution_out(
+    RuntimeContext& ctx,
+    const Tensor& in,
+    const Tensor& weight,
+    const exec_aten::optional<Tensor>& bias,
+    exec_aten::ArrayRef<int64_t> stride,
+    exec_aten::ArrayRef<int64_t> padding,
+    exec_aten::ArrayRef<int64_t> dilation,
+    bool transposed,
+    exec_aten::ArrayRef<int64_t> output_padding,
+    int64_t groups,
+    Tensor& out);
+
+} // namespace native
+} // namespace executor
+} // namespace torch
+
+namespace {
+
+using exec_aten::ScalarType;
+using exec_aten::Tensor;
+using torch::executor::RuntimeContext;
+using torch::executor::testing::TensorFactory;
+
+using ConvFn = Tensor& (*)(RuntimeContext&,
+                           const Tensor&,
+                           const Tensor&,
+                           const exec_aten::optional<Tensor>&,
+                           exec_aten::ArrayRef<int64_t>,
+                           exec_aten::ArrayRef<int64_t>,
+                           exec_aten::ArrayRef<int64_t>,
+                           bool,
+                           exec_aten::ArrayRef<int64_t>,
+                           int64_t,
+                           Tensor&);
+
+struct BenchCase {
+  const char* name;
+  int32_t in_c;
+  int32_t out_c;
+  int32_t size;
+  int64_t kernel;
+  int64_t stride;
+  int64_t padding;
+  bool transposed;
+};
+
+// EDSR keeps 64 feature channels at the input resolution; its tail and
+// upsampler work on the 2x output.
+const BenchCase kCases[] = {
+    {"conv3x3 64->64 (body)", 64, 64, 224, 3, 1, 1, false},
+    {"conv3x3 3->64 (head)", 3, 64, 224, 3, 1, 1, false},
+    {"conv3x3 64->256 (upsampler)", 64, 256, 224, 3, 1, 1, false},
+    {"conv_t k2s2 64->64", 64, 64, 224, 2, 2, 0, true},
+    {"conv_t k4s2p1 64->64", 64, 64, 224, 4, 2, 1, true},
+    {"conv_t k3s1p1 64->3 (tail)", 64, 3, 448, 3, 1, 1, true},
+};
+
+double time_ms(ConvFn fn, const BenchCase& c, int iterations) {
+  TensorFactory<ScalarType::Float> tf;
+  const int32_t k = static_cast<int32_t>(c.kernel);
+  Tensor in = tf.full({1, c.in_c, c.size, c.size}, 0.5f);
+  Tensor weight = c.transposed ? tf.full({c.in_c, c.out_c, k, k}, 0.25f)
+                               : tf.full({c.out_c, c.in_c, k, k}, 0.25f);
+  exec_aten::optional<Tensor> bias(tf.ones({c.out_c}));
+  const int64_t out_size = c.transposed
+      ? (c.size - 1) * c.stride - 2 * c.padding + c.kernel
+      : (c.size + 2 * c.padding - c.kernel) / c.stride + 1;
+  Tensor out = tf.zeros(
+      {1,
+       c.out_c,
+       static_cast<int32_t>(out_size),
+       static_cast<int32_t>(out_size)});
+
+  int64_t stride[] = {c.stride, c.stride};
+  int64_t padding[] = {c.padding, c.padding};
+  int64_t dilation[] = {1, 1};
+  int64_t output_padding[] = {0, 0};
+
+  RuntimeContext ctx;
+  auto run = [&]() {
+    fn(ctx,
+       in,
+       weight,
+       bias,
+       {stride, 2},
+       {padding, 2},
+       {dilation, 2},
+       c.transposed,
+       {output_padding, 2},
+       /*groups=*/1,
+       out);
+  };
+  if (iterations > 1) {
+    // Warm up caches and the threadpool.
+    run();
+  }
+  const auto start = std::chrono::steady_clock::now();
+  for (int i = 0; i < iterations; ++i) {
+    run();
+  }
+  const auto end = std::chrono::steady_clock::now();
+  if (ctx.failure_state() != torch::executor::Error::Ok) {
+    return -1;
+  }
+  return std::chrono::duration<double, std::milli>(end - start).count() /
+      iterations;
+}
+
+} // namespace
+
+int main(int argc, char** argv) {
+  torch::executor::runtime_init();
+  const int iterations = argc > 1 ? std::atoi(argv[1]) : 3;
+
+  printf("%-30s %12s %12s %8s\n", "case", "portable ms", "optimized ms", "x");
+  for (const BenchCase& c : kCases) {
+    const double portable_ms =
+        time_ms(torch::executor::native::convolution_out, c, 1);
+    const double optimized_ms =
+        time_ms(torch::executor::native::opt_convolution_out, c, iterations);
+    printf(
+        "%-30s %12.1f %12.1f %8.1f\n",
+        c.name,
+        portable_ms,
+        optimized_ms,
+        portable_ms / optimized_ms);
+  }
+  return 0;
+}
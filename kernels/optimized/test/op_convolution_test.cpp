@@ -0,0 +1,276 @@
+/*
+ * Copyright (c) Meta Platforms, Inc. and affiliates.
+ * All rights reserved.
+ *
+ * This source code is licensed under the BSD-style license found in the
+ * LICENSE file in the root directory of this source tree.
+ */
+
+#include <gtest/gtest.h>
+
+#include <executorch/runtime/core/exec_aten/exec_aten.h>
+#include <executorch/runtime/core/exec_aten/testing_util/tensor_factory.h>
+#include <executorch/runtime/core/exec_aten/testing_util/tensor_util.h>
+#include <executorch/runtime/kernel/kernel_includes.h>
+#include <executorch/runtime/platform/runtime.h>
+#include <executorch/test/utils/DeathTest.h>
+
+#include <algorithm>
+#include <vector>
+
+using exec_aten::ArrayRef;
+using exec_aten::nullopt;
+using exec_aten::optional;
+using exec_aten::Scalar;
+using exec_aten::ScalarType;
+using exec_aten::Tensor;
+using torch::executor::RuntimeContext;
+using torch::executor::testing::TensorFactory;
+
+namespace torch {
+namespace executor {
+namespace native {
+Tensor& opt_convolution_out(
+    RuntimeContext& ctx,
+    const Tensor& in,
+    const Tensor& weight,
+    const optional<Tensor>& bias,
+    ArrayRef<int64_t> stride,
+    ArrayRef<int64_t> padding,
+    ArrayRef<int64_t> dilation,
+    bool transposed,
+    ArrayRef<int64_t> output_padding,
+    int64_t groups,
+    Tensor& out);
+
+Tensor& opt_convolution_clamp_out(
+    RuntimeContext& ctx,
+    const Tensor& in,
+    const Tensor& weight,
+    const optional<Tensor>& bias,
+    ArrayRef<int64_t> stride,
+    ArrayRef<int64_t> padding,
+    ArrayRef<int64_t> dilation,
+    bool transposed,
+    ArrayRef<int64_t> output_padding,
+    int64_t groups,
+    const optional<Scalar>& min,
+    const optional<Scalar>& max,
+    Tensor& out);
+} // namespace native
+} // namespace executor
+} // namespace torch
+
+namespace {
+
+struct ConvArgs {
+  std::vector<int64_t> stride;
+  std::vector<int64_t> padding;
+  std::vector<int64_t> dilation;
+  bool transposed;
+  std::vector<int64_t> output_padding;
+  int64_t groups;
+};
+
+Tensor& op_convolution_clamp_out(
+    const Tensor& in,
+    const Tensor& weight,
+    const optional<Tensor>& bias,
+    const ConvArgs& args,
+    const optional<Scalar>& min,
+    const optional<Scalar>& max,
+    Tensor& out) {
+  RuntimeContext ctx{};
+  return torch::executor::native::opt_convolution_clamp_out(
+      ctx,
+      in,
+      weight,
+      bias,
+      {args.stride.data(), args.stride.size()},
+      {args.padding.data(), args.padding.size()},
+      {args.dilation.data(), args.dilation.size()},
+      args.transposed,
+      {args.output_padding.data(), args.output_padding.size()},
+      args.groups,
+      min,
+      max,
+      out);
+}
+
+// The unfused reference: convolution.out followed by a clamp.
+void expect_matches_unfused(
+    const Tensor& in,
+    const Tensor& weight,
+    const optional<Tensor>& bias,
+    const ConvArgs& args,
+    optional<float> min,
+    optional<float> max,
+    const std::vector<int32_t>& out_sizes) {
+  TensorFactory<ScalarType::Float> tf;
+  RuntimeContext ctx{};
+
+  Tensor expected = tf.zeros(out_sizes);
+  torch::executor::native::opt_convolution_out(
+      ctx,
+      in,
+      weight,
+      bias,
+      {args.stride.data(), args.stride.size()},
+      {args.padding.data(), args.padding.size()},
+      {args.dilation.data(), args.dilation.size()},
+      args.transposed,
+      {args.output_padding.data(), args.output_padding.size()},
+      args.groups,
+      expected);
+  float* data = expected.mutable_data_ptr<float>();
+  for (size_t i = 0; i < expected.numel(); ++i) {
+    if (min.has_value()) {
+      data[i] = std::max(data[i], min.value());
+    }
+    if (max.has_value()) {
+      data[i] = std::min(data[i], max.value());
+    }
+  }
+
+  optional<Scalar> min_scalar;
+  optional<Scalar> max_scalar;
+  if (min.has_value()) {
+    min_scalar = Scalar(static_cast<double>(min.value()));
+  }
+  if (max.has_value()) {
+    max_scalar = Scalar(static_cast<double>(max.value()));
+  }
+  Tensor out = tf.zeros(out_sizes);
+  op_convolution_clamp_out(
+      in, weight, bias, args, min_scalar, max_scalar, out);
+  EXPECT_TENSOR_CLOSE(out, expected);
+}
+
+std::vector<float> ramp(size_t size, size_t seed) {
+  std::vector<float> data(size);
+  for (size_t i = 0; i < size; ++i) {
+    data[i] = static_cast<float>(((i + seed) * 7919) % 200) / 50.0f - 2.0f;
+  }
+  return data;
+}
+
+} // namespace
+
+class OpConvolutionClampOutTest : public ::testing::Test {
+ protected:
+  void SetUp() override {
+    torch::executor::runtime_init();
+  }
+};
+
+TEST_F(OpConvolutionClampOutTest, SmallRelu) {
+  TensorFactory<ScalarType::Float> tf;
+
+  // A 1x1 convolution that negates the input, plus a bias of 1.
+  Tensor in = tf.make({1, 1, 2, 2}, {-2, -0.5, 0.5, 2});
+  Tensor weight = tf.make({1, 1, 1, 1}, {-1});
+  Tensor bias = tf.make({1}, {1});
+  Tensor out = tf.zeros({1, 1, 2, 2});
+
+  op_convolution_clamp_out(
+      in,
+      weight,
+      bias,
+      {{1, 1}, {0, 0}, {1, 1}, false, {0, 0}, 1},
+      Scalar(0),
+      nullopt,
+      out);
+  EXPECT_TENSOR_CLOSE(out, tf.make({1, 1, 2, 2}, {3, 1.5, 0.5, 0}));
+}
+
+TEST_F(OpConvolutionClampOutTest, Conv2dMatchesUnfused) {
+  TensorFactory<ScalarType::Float> tf;
+
+  // A 3x3 padded convolution large enough to be split into several tiles and
+  // tasks, with relu, hardtanh (relu6) and a max-only clamp.
+  Tensor in = tf.make({2, 8, 19, 23}, ramp(2 * 8 * 19 * 23, 0));
+  Tensor weight = tf.make({16, 8, 3, 3}, ramp(16 * 8 * 3 * 3, 1));
+  Tensor bias = tf.make({16}, ramp(16, 2));
+  const ConvArgs args{{1, 1}, {1, 1}, {1, 1}, false, {0, 0}, 1};
+
+  expect_matches_unfused(in, weight, bias, args, 0.0f, nullopt, {2, 16, 19, 23});
+  expect_matches_unfused(in, weight, bias, args, 0.0f, 6.0f, {2, 16, 19, 23});
+  expect_matches_unfused(
+      in, weight, nullopt, args, nullopt, 0.5f, {2, 16, 19, 23});
+}
+
+TEST_F(OpConvolutionClampOutTest, DepthwiseAndPointwiseMatchUnfused) {
+  TensorFactory<ScalarType::Float> tf;
+
+  // The two halves of a MobileNet block: a strided depthwise convolution and
+  // a pointwise one, both followed by relu6.
+  Tensor in = tf.make({1, 12, 16, 16}, ramp(12 * 16 * 16, 3));
+  Tensor dw_weight = tf.make({12, 1, 3, 3}, ramp(12 * 9, 4));
+  Tensor dw_bias = tf.make({12}, ramp(12, 5));
+  expect_matches_unfused(
+      in,
+      dw_weight,
+      dw_bias,
+      {{2, 2}, {1, 1}, {1, 1}, false, {0, 0}, 12},
+      0.0f,
+      6.0f,
+      {1, 12, 8, 8});
+
+  Tensor pw_weight = tf.make({24, 12, 1, 1}, ramp(24 * 12, 6));
+  Tensor pw_bias = tf.make({24}, ramp(24, 7));
+  expect_matches_unfused(
+      in,
+      pw_weight,
+      pw_bias,
+      {{1, 1}, {0, 0}, {1, 1}, false, {0, 0}, 1},
+      0.0f,
+      6.0f,
+      {1, 24, 16, 16});
+}
+
+TEST_F(OpConvolutionClampOutTest, TransposedMatchesUnfused) {
+  TensorFactory<ScalarType::Float> tf;
+
+  Tensor in = tf.make({1, 4, 7, 9}, ramp(4 * 7 * 9, 8));
+  Tensor bias = tf.make({6}, ramp(6, 9));
+
+  // Non-overlapping windows, where the clamp is folded into the col2im write.
+  Tensor weight2 = tf.make({4, 6, 2, 2}, ramp(4 * 6 * 4, 10));
+  expect_matches_unfused(
+      in,
+      weight2,
+      bias,
+      {{2, 2}, {0, 0}, {1, 1}, true, {0, 0}, 1},
+      -0.5f,
+      0.5f,
+      {1, 6, 14, 18});
+
+  // Overlapping windows, where the clamp runs after the scatter.
+  Tensor weight3 = tf.make({4, 6, 3, 3}, ramp(4 * 6 * 9, 11));
+  expect_matches_unfused(
+      in,
+      weight3,
+      bias,
+      {{2, 2}, {1, 1}, {1, 1}, true, {1, 1}, 1},
+      0.0f,
+      nullopt,
+      {1, 6, 14, 18});
+}
+
+TEST_F(OpConvolutionClampOutTest, IntegerInputWithClampDies) {
+  TensorFactory<ScalarType::Int> tf;
+
+  Tensor in = tf.ones({1, 1, 2, 2});
+  Tensor weight = tf.ones({1, 1, 1, 1});
+  Tensor out = tf.zeros({1, 1, 2, 2});
+  ET_EXPECT_DEATH(
+      op_convolution_clamp_out(
+          in,
+          weight,
+          nullopt,
+          {{1, 1}, {0, 0}, {1, 1}, false, {0, 0}, 1},
+          Scalar(0),
+          nullopt,
+          out),
+      "");
+}
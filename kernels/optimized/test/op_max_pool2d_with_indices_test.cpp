@@ -0,0 +1,190 @@
+/*
+ * Copyright (c) Meta Platforms, Inc. and affiliates.
+ * All rights reserved.
+ *
+ * This source code is licensed under the BSD-style license found in the
+ * LICENSE file in the root directory of this source tree.
+ */
+
+#include <gtest/gtest.h>
+
+#include <executorch/runtime/core/exec_aten/exec_aten.h>
+#include <executorch/runtime/core/exec_aten/testing_util/tensor_factory.h>
+#include <executorch/runtime/core/exec_aten/testing_util/tensor_util.h>
+#include <executorch/runtime/kernel/kernel_includes.h>
+#include <executorch/runtime/platform/runtime.h>
+
+#include <tuple>
+#include <vector>
+
+using exec_aten::ArrayRef;
+using exec_aten::ScalarType;
+using exec_aten::Tensor;
+using torch::executor::RuntimeContext;
+using torch::executor::testing::TensorFactory;
+
+namespace torch {
+namespace executor {
+namespace native {
+std::tuple<Tensor&, Tensor&> opt_max_pool2d_with_indices_out(
+    RuntimeContext& ctx,
+    const Tensor& in,
+    ArrayRef<int64_t> kernel_size,
+    ArrayRef<int64_t> stride,
+    ArrayRef<int64_t> padding,
+    ArrayRef<int64_t> dilation,
+    bool ceil_mode,
+    Tensor& out,
+    Tensor& indices);
+} // namespace native
+} // namespace executor
+} // namespace torch
+
+namespace {
+
+// Runs max_pool2d_with_indices with unit dilation and no ceil_mode.
+void op_max_pool2d_with_indices_out(
+    const Tensor& in,
+    std::vector<int64_t> kernel_size,
+    std::vector<int64_t> stride,
+    std::vector<int64_t> padding,
+    Tensor& out,
+    Tensor& indices) {
+  RuntimeContext context{};
+  std::vector<int64_t> dilation = {1, 1};
+  torch::executor::native::opt_max_pool2d_with_indices_out(
+      context,
+      in,
+      {kernel_size.data(), kernel_size.size()},
+      {stride.data(), stride.size()},
+      {padding.data(), padding.size()},
+      {dilation.data(), dilation.size()},
+      /*ceil_mode=*/false,
+      out,
+      indices);
+  EXPECT_EQ(context.failure_state(), torch::executor::Error::Ok);
+}
+
+// The inputs below hold distinct values, so every window has a unique max.
+// The expected values were computed with a direct loop over each window.
+
+// {1, 2, 4, 9} NCHW input: pooled 2x2 with stride 2 and a column of padding
+// on either side, so each output row has one border column and four interior
+// columns that take the specialized path.
+const std::vector<float> k2x2Input = {
+    -25,  -6.5, 12,    -20,   -1.5,  17,    -15,   3.5,   22,  -10,   8.5,
+    -23.5, -5,  13.5,  -18.5, 0,     18.5,  -13.5, 5,     23.5, -8.5,  10,
+    -22,  -3.5, 15,    -17,   1.5,   20,    -12,   6.5,   25,  -7,    11.5,
+    -20.5, -2,  16.5,  -15.5, 3,     21.5,  -10.5, 8,     -24, -5.5,  13,
+    -19,  -0.5, 18,    -14,   4.5,   23,    -9,    9.5,   -22.5, -4,   14.5,
+    -17.5, 1,   19.5,  -12.5, 6,     24.5,  -7.5,  11,    -21, -2.5,  16,
+    -16,  2.5,  21,    -11,   7.5,   -24.5};
+const std::vector<float> k2x2Out = {
+    -10, 12, 13.5, 17, 22, 20,   23.5, 25, 15, 16.5,
+    -0.5, 21.5, 23, 9.5, 13, 14.5, 16, 19.5, 24.5, 11};
+const std::vector<int64_t> k2x2Indices = {
+    9, 2, 13, 5, 8, 27, 19, 30, 24, 35, 9, 2, 13, 15, 7, 18, 29, 21, 24, 26};
+// k2x2Indices in NHWC memory order.
+const std::vector<int64_t> k2x2IndicesChannelsLast = {
+    9, 9, 2, 2, 13, 13, 5, 15, 8, 7, 27, 18, 19, 29, 30, 21, 24, 24, 35, 26};
+
+// {1, 3, 5, 5} input, given in NHWC memory order, pooled 3x3 with stride 2
+// and padding 1.
+const std::vector<float> kChannelsLastInput = {
+    -25,   -17,  -9,    -6.5,  1.5,   9.5,  12,    20,    -22.5, -20,
+    -12,   -4,   -1.5,  6.5,   14.5,  17,   25,    -17.5, -15,   -7,
+    1,     3.5,  11.5,  19.5,  22,    -20.5, -12.5, -10,  -2,    6,
+    8.5,   16.5, 24.5,  -23.5, -15.5, -7.5, -5,    3,     11,    13.5,
+    21.5,  -21,  -18.5, -10.5, -2.5,  0,    8,     16,    18.5,  -24,
+    -16,   -13.5, -5.5, 2.5,   5,     13,   21,    23.5,  -19,   -11,
+    -8.5,  -0.5, 7.5,   10,    18,    -24.5, -22,  -14,   -6,    -3.5,
+    4.5,   12.5, 15,    23,    -19.5};
+const std::vector<float> kChannelsLastOut = {
+    17, 25, 9.5, 22, 20, 19.5, 22,   6.5, 14.5, 18.5, 25, 24.5, 22, 21.5,
+    21, 23.5, 21.5, 21, 18.5, 18, 16, 18.5, 18, 21, 23.5, 23, 21};
+const std::vector<int64_t> kChannelsLastIndices = {
+    5, 5,  1,  8,  2,  7,  8,  4,  4,  16, 5,  10, 8,  13,
+    18, 19, 13, 18, 16, 21, 15, 16, 21, 18, 19, 24, 18};
+// kChannelsLastIndices in NCHW memory order.
+const std::vector<int64_t> kChannelsLastIndicesContiguous = {
+    5, 8, 8, 16, 8, 19, 16, 16, 19, 5,  2,  4,  5, 13,
+    13, 21, 21, 24, 1, 7, 4, 10, 18, 18, 15, 18, 18};
+
+} // namespace
+
+class OpMaxPool2DWithIndicesOutTest : public ::testing::Test {
+ protected:
+  void SetUp() override {
+    torch::executor::runtime_init();
+  }
+
+  TensorFactory<ScalarType::Float> tf_;
+  TensorFactory<ScalarType::Long> tf_long_;
+};
+
+TEST_F(OpMaxPool2DWithIndicesOutTest, Kernel2x2Stride2) {
+  Tensor in = tf_.make({1, 2, 4, 9}, k2x2Input);
+  Tensor out = tf_.zeros({1, 2, 2, 5});
+  Tensor indices = tf_long_.zeros({1, 2, 2, 5});
+  op_max_pool2d_with_indices_out(in, {2, 2}, {2, 2}, {0, 1}, out, indices);
+  EXPECT_TENSOR_EQ(out, tf_.make({1, 2, 2, 5}, k2x2Out));
+  EXPECT_TENSOR_EQ(indices, tf_long_.make({1, 2, 2, 5}, k2x2Indices));
+}
+
+TEST_F(OpMaxPool2DWithIndicesOutTest, Kernel3x3Stride2) {
+  // The first 77 values of the 2x2 input as a {1, 1, 7, 11} plane. Only the
+  // middle output rows have their whole window inside the input, and both
+  // edge columns are borders.
+  std::vector<float> in_data(k2x2Input);
+  in_data.insert(in_data.end(), {-6, 12.5, -19.5, -1, 17.5});
+  Tensor in = tf_.make({1, 1, 7, 11}, in_data);
+  Tensor out = tf_.zeros({1, 1, 4, 6});
+  Tensor indices = tf_long_.zeros({1, 1, 4, 6});
+  op_max_pool2d_with_indices_out(in, {3, 3}, {2, 2}, {1, 1}, out, indices);
+  EXPECT_TENSOR_EQ(
+      out,
+      tf_.make(
+          {1, 1, 4, 6},
+          {-5, 13.5, 18.5, 18.5, 23.5, 10, -2, 16.5, 21.5, 21.5, 25, 13,
+           1,  19.5, 24.5, 24.5, 11,   16, 2.5, 21,  24.5, 24.5, 12.5, 17.5}));
+  EXPECT_TENSOR_EQ(
+      indices,
+      tf_long_.make(
+          {1, 1, 4, 6},
+          {12, 13, 16, 16, 19, 21, 34, 35, 38, 38, 30, 43,
+           56, 57, 60, 60, 62, 65, 67, 68, 60, 60, 73, 76}));
+}
+
+TEST_F(OpMaxPool2DWithIndicesOutTest, ChannelsLast) {
+  Tensor in = tf_.make_channels_last({1, 3, 5, 5}, kChannelsLastInput);
+  Tensor out = tf_.full_channels_last({1, 3, 3, 3}, 0);
+  Tensor indices = tf_long_.full_channels_last({1, 3, 3, 3}, 0);
+  op_max_pool2d_with_indices_out(in, {3, 3}, {2, 2}, {1, 1}, out, indices);
+  EXPECT_TENSOR_EQ(
+      out, tf_.make_channels_last({1, 3, 3, 3}, kChannelsLastOut));
+  EXPECT_TENSOR_EQ(
+      indices,
+      tf_long_.make_channels_last({1, 3, 3, 3}, kChannelsLastIndices));
+}
+
+TEST_F(OpMaxPool2DWithIndicesOutTest, ChannelsLastWithContiguousIndices) {
+  Tensor in = tf_.make_channels_last({1, 3, 5, 5}, kChannelsLastInput);
+  Tensor out = tf_.full_channels_last({1, 3, 3, 3}, 0);
+  Tensor indices = tf_long_.zeros({1, 3, 3, 3});
+  op_max_pool2d_with_indices_out(in, {3, 3}, {2, 2}, {1, 1}, out, indices);
+  EXPECT_TENSOR_EQ(
+      out, tf_.make_channels_last({1, 3, 3, 3}, kChannelsLastOut));
+  EXPECT_TENSOR_EQ(
+      indices, tf_long_.make({1, 3, 3, 3}, kChannelsLastIndicesContiguous));
+}
+
+TEST_F(OpMaxPool2DWithIndicesOutTest, ContiguousWithChannelsLastIndices) {
+  Tensor in = tf_.make({1, 2, 4, 9}, k2x2Input);
+  Tensor out = tf_.zeros({1, 2, 2, 5});
+  Tensor indices = tf_long_.full_channels_last({1, 2, 2, 5}, 0);
+  op_max_pool2d_with_indices_out(in, {2, 2}, {2, 2}, {0, 1}, out, indices);
+  EXPECT_TENSOR_EQ(out, tf_.make({1, 2, 2, 5}, k2x2Out));
+  EXPECT_TENSOR_EQ(
+      indices,
+      tf_long_.make_channels_last({1, 2, 2, 5}, k2x2IndicesChannelsLast));
+}
@@ -0,0 +1,165 @@
+/*
+ * Copyright (c) Meta Platforms, Inc. and affiliates.
+ * All rights reserved.
+ *
+ * This source code is licensed under the BSD-style license found in the
+ * LICENSE file in the root directory of this source tree.
+ */
+
+#include <gtest/gtest.h>
+
+#include <executorch/runtime/core/exec_aten/exec_aten.h>
+#include <executorch/runtime/core/exec_aten/testing_util/tensor_factory.h>
+#include <executorch/runtime/core/exec_aten/testing_util/tensor_util.h>
+#include <executorch/runtime/kernel/kernel_includes.h>
+#include <executorch/runtime/platform/runtime.h>
+#include <executorch/test/utils/DeathTest.h>
+
+#include <cmath>
+#include <vector>
+
+using exec_aten::nullopt;
+using exec_aten::optional;
+using exec_aten::ScalarType;
+using exec_aten::Tensor;
+using torch::executor::RuntimeContext;
+using torch::executor::testing::TensorFactory;
+
+namespace torch {
+namespace executor {
+namespace native {
+Tensor& opt_rms_norm_out(
+    RuntimeContext& ctx,
+    const Tensor& input,
+    const optional<Tensor>& weight,
+    double eps,
+    Tensor& out);
+} // namespace native
+} // namespace executor
+} // namespace torch
+
+namespace {
+
+Tensor& op_rms_norm_out(
+    RuntimeContext& ctx,
+    const Tensor& input,
+    const optional<Tensor>& weight,
+    double eps,
+    Tensor& out) {
+  return torch::executor::native::opt_rms_norm_out(
+      ctx, input, weight, eps, out);
+}
+
+// The unfused llama2 RMSNorm:
+// x * torch.rsqrt(x.pow(2).mean(-1, keepdim=True) + eps) * weight
+std::vector<float> reference_rms_norm(
+    const std::vector<float>& in,
+    const std::vector<float>& weight,
+    int64_t rows,
+    int64_t cols,
+    double eps) {
+  std::vector<float> out(in.size());
+  for (int64_t i = 0; i < rows; ++i) {
+    double sum_sq = 0;
+    for (int64_t j = 0; j < cols; ++j) {
+      sum_sq += static_cast<double>(in[i * cols + j]) * in[i * cols + j];
+    }
+    const double scale = 1.0 / std::sqrt(sum_sq / cols + eps);
+    for (int64_t j = 0; j < cols; ++j) {
+      out[i * cols + j] = in[i * cols + j] * scale * weight[j];
+    }
+  }
+  return out;
+}
+
+} // namespace
+
+class OpRmsNormOutTest : public ::testing::Test {
+ protected:
+  void SetUp() override {
+    torch::executor::runtime_init();
+  }
+};
+
+TEST_F(OpRmsNormOutTest, SmallWithWeight) {
+  TensorFactory<ScalarType::Float> tf;
+  RuntimeContext ctx{};
+
+  // Row 0 has mean square 7.5, row 1 has mean square 1.
+  Tensor in = tf.make({2, 4}, {1, 2, 3, 4, -1, 1, -1, 1});
+  Tensor weight = tf.make({4}, {1, 0.5, 2, -1});
+  Tensor out = tf.zeros({2, 4});
+
+  op_rms_norm_out(ctx, in, weight, /*eps=*/0.0, out);
+  EXPECT_EQ(ctx.failure_state(), torch::executor::Error::Ok);
+
+  const float r = 1.0f / std::sqrt(7.5f);
+  EXPECT_TENSOR_CLOSE(
+      out, tf.make({2, 4}, {r, r, 6 * r, -4 * r, -1, 0.5, -2, -1}));
+}
+
+TEST_F(OpRmsNormOutTest, NoWeightDouble) {
+  TensorFactory<ScalarType::Double> tf;
+  RuntimeContext ctx{};
+
+  Tensor in = tf.make({1, 3}, {3, 0, -4});
+  Tensor out = tf.zeros({1, 3});
+
+  op_rms_norm_out(ctx, in, nullopt, /*eps=*/1.0 / 3.0, out);
+  EXPECT_EQ(ctx.failure_state(), torch::executor::Error::Ok);
+
+  // mean square is 25 / 3, plus eps gives 26 / 3.
+  const double r = 1.0 / std::sqrt(26.0 / 3.0);
+  EXPECT_TENSOR_CLOSE(out, tf.make({1, 3}, {3 * r, 0, -4 * r}));
+}
+
+TEST_F(OpRmsNormOutTest, LargeInputMatchesUnfusedReference) {
+  TensorFactory<ScalarType::Float> tf;
+  RuntimeContext ctx{};
+
+  // Enough rows to be split across threads, with a row size that is not a
+  // multiple of the vector width.
+  const int64_t rows = 37;
+  const int64_t cols = 4099;
+  std::vector<float> in_data(rows * cols);
+  for (size_t i = 0; i < in_data.size(); ++i) {
+    in_data[i] = static_cast<float>((i * 7919) % 2000) / 500.0f - 2.0f;
+  }
+  std::vector<float> weight_data(cols);
+  for (int64_t j = 0; j < cols; ++j) {
+    weight_data[j] = 0.5f + static_cast<float>(j % 17) / 16.0f;
+  }
+
+  Tensor in = tf.make({1, rows, cols}, in_data);
+  Tensor weight = tf.make({cols}, weight_data);
+  Tensor out = tf.zeros({1, rows, cols});
+
+  op_rms_norm_out(ctx, in, weight, /*eps=*/1e-5, out);
+  EXPECT_EQ(ctx.failure_state(), torch::executor::Error::Ok);
+
+  EXPECT_TENSOR_CLOSE_WITH_TOL(
+      out,
+      tf.make(
+          {1, rows, cols},
+          reference_rms_norm(in_data, weight_data, rows, cols, 1e-5)),
+      1e-5,
+      1e-5);
+}
+
+TEST_F(OpRmsNormOutTest, InvalidArgumentsDie) {
+  TensorFactory<ScalarType::Float> tf;
+  TensorFactory<ScalarType::Int> tfi;
+  RuntimeContext ctx{};
+
+  // Weight does not match the last dim
+  Tensor in = tf.ones({2, 4});
+  Tensor out = tf.zeros({2, 4});
+  Tensor weight = tf.ones({3});
+  ET_EXPECT_DEATH(op_rms_norm_out(ctx, in, weight, /*eps=*/1e-5, out), "");
+
+  // Integer input
+  Tensor int_in = tfi.ones({2, 4});
+  Tensor int_out = tfi.zeros({2, 4});
+  ET_EXPECT_DEATH(
+      op_rms_norm_out(ctx, int_in, nullopt, /*eps=*/1e-5, int_out), "");
+}
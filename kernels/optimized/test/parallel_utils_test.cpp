@@ -0,0 +1,125 @@
+/*
+ * Copyright (c) Meta Platforms, Inc. and affiliates.
+ * All rights reserved.
+ *
+ * This source code is licensed under the BSD-style license found in the
+ * LICENSE file in the root directory of this source tree.
+ */
+
+#include <executorch/kernels/optimized/cpu/parallel_utils.h>
+
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <utility>
+#include <vector>
+
+using torch::executor::native::get_num_parallel_threads;
+using torch::executor::native::get_parallel_backend;
+using torch::executor::native::parallel_for;
+using torch::executor::native::ParallelBackend;
+using torch::executor::native::set_parallel_backend;
+
+namespace {
+
+// Runs the tasks one after another on the calling thread, in reverse order,
+// and records how it was used.
+class FakeBackend final : public ParallelBackend {
+ public:
+  explicit FakeBackend(int64_t num_threads) : num_threads_(num_threads) {}
+
+  int64_t num_threads() override {
+    return num_threads_;
+  }
+
+  void run(const std::function<void(size_t)>& fn, size_t num_tasks) override {
+    ++num_runs;
+    last_num_tasks = num_tasks;
+    for (size_t i = num_tasks; i > 0; --i) {
+      fn(i - 1);
+    }
+  }
+
+  int num_runs = 0;
+  size_t last_num_tasks = 0;
+
+ private:
+  int64_t num_threads_;
+};
+
+using Ranges = std::vector<std::pair<int64_t, int64_t>>;
+
+Ranges collect_ranges(int64_t size, int64_t grain_size) {
+  Ranges ranges;
+  parallel_for(size, grain_size, [&](int64_t begin, int64_t end) {
+    ranges.emplace_back(begin, end);
+  });
+  std::sort(ranges.begin(), ranges.end());
+  return ranges;
+}
+
+void expect_covers(const Ranges& ranges, int64_t size) {
+  int64_t next = 0;
+  for (const auto& range : ranges) {
+    EXPECT_EQ(range.first, next);
+    EXPECT_LT(range.first, range.second);
+    next = range.second;
+  }
+  EXPECT_EQ(next, size);
+}
+
+} // namespace
+
+class ParallelUtilsTest : public ::testing::Test {
+ protected:
+  void SetUp() override {
+    previous_ = set_parallel_backend(nullptr);
+  }
+
+  void TearDown() override {
+    set_parallel_backend(previous_);
+  }
+
+ private:
+  ParallelBackend* previous_ = nullptr;
+};
+
+TEST_F(ParallelUtilsTest, RunsSeriallyWithoutBackend) {
+  EXPECT_EQ(get_parallel_backend(), nullptr);
+  EXPECT_EQ(get_num_parallel_threads(), 1);
+  EXPECT_EQ(collect_ranges(100, 1), Ranges({{0, 100}}));
+  EXPECT_TRUE(collect_ranges(0, 1).empty());
+}
+
+TEST_F(ParallelUtilsTest, SplitsWorkOverBackend) {
+  FakeBackend backend(/*num_threads=*/4);
+  EXPECT_EQ(set_parallel_backend(&backend), nullptr);
+  EXPECT_EQ(get_parallel_backend(), &backend);
+  EXPECT_EQ(get_num_parallel_threads(), 4);
+
+  Ranges ranges = collect_ranges(10, 1);
+  EXPECT_EQ(backend.num_runs, 1);
+  EXPECT_EQ(backend.last_num_tasks, 4);
+  EXPECT_EQ(ranges.size(), 4);
+  expect_covers(ranges, 10);
+
+  // Every task gets at least grain_size items, so fewer tasks are used.
+  ranges = collect_ranges(10, 4);
+  EXPECT_EQ(backend.num_runs, 2);
+  EXPECT_EQ(backend.last_num_tasks, 3);
+  expect_covers(ranges, 10);
+
+  EXPECT_EQ(set_parallel_backend(nullptr), &backend);
+}
+
+TEST_F(ParallelUtilsTest, SmallWorkStaysOnCallingThread) {
+  FakeBackend backend(/*num_threads=*/4);
+  set_parallel_backend(&backend);
+  EXPECT_EQ(collect_ranges(10, 100), Ranges({{0, 10}}));
+  EXPECT_EQ(backend.num_runs, 0);
+
+  FakeBackend single(/*num_threads=*/1);
+  set_parallel_backend(&single);
+  EXPECT_EQ(collect_ranges(10, 1), Ranges({{0, 10}}));
+  EXPECT_EQ(single.num_runs, 0);
+}
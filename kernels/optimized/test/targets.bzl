@@ -40,4 +40,49 @@ def define_common_targets():
 
     _lib_test_bin("libvec_test_bin")
     _lib_test_bin("moments_utils_test_bin", in_cpu = True)
+    _lib_test_bin("dtype_convert_test_bin", in_cpu = True)
     _lib_test_bin("libblas_test_bin")
+    _lib_test_bin("parallel_utils_test_bin", in_cpu = True)
+    _lib_test_bin(
+        "op_bmm_test_bin",
+        extra_deps = [
+            "//executorch/runtime/core:memory_allocator",
+            "//executorch/runtime/core/exec_aten/testing_util:tensor_util",
+            "//executorch/runtime/kernel:operator_registry",
+        ],
+        in_cpu = True,
+    )
+    _lib_test_bin(
+        "op_convolution_test_bin",
+        extra_deps = [
+            "//executorch/runtime/core/exec_aten/testing_util:tensor_util",
+        ],
+        in_cpu = True,
+    )
+    _lib_test_bin(
+        "op_max_pool2d_with_indices_test_bin",
+        extra_deps = [
+            "//executorch/runtime/core/exec_aten/testing_util:tensor_util",
+        ],
+        in_cpu = True,
+    )
+    _lib_test_bin(
+        "op_rms_norm_test_bin",
+        extra_deps = [
+            "//executorch/runtime/core/exec_aten/testing_util:tensor_util",
+        ],
+        in_cpu = True,
+    )
+
+    # Not a test: times portable vs. optimized convolution on EDSR shapes.
+    runtime.cxx_binary(
+        name = "op_convolution_bench",
+        srcs = ["op_convolution_bench.cpp"],
+        deps = [
+            "//executorch/kernels/optimized/cpu:op_convolution",
+            "//executorch/kernels/optimized/cpu:threadpool_parallel_backend",
+            "//executorch/kernels/portable/cpu:op_convolution",
+            "//executorch/runtime/core/exec_aten/testing_util:tensor_util",
+            "//executorch/runtime/platform:platform",
+        ],
+    )
@@ -9,9 +9,13 @@
 #include <executorch/kernels/portable/cpu/scalar_utils.h>
 #include <executorch/kernels/portable/cpu/util/broadcast_util.h>
 #include <executorch/kernels/portable/cpu/util/functional_util.h>
+#include <executorch/runtime/core/memory_allocator.h>
 #include <executorch/runtime/kernel/kernel_includes.h>
+#include <executorch/runtime/kernel/operator_registry.h>
 #include <executorch/runtime/platform/assert.h>
 
+#include <cstring>
+
 namespace torch {
 namespace executor {
 namespace native {
@@ -61,6 +65,131 @@ Tensor& add_out(
   return out;
 }
 
+#ifndef USE_ATEN_LIB
+namespace {
+
+/**
+ * Everything add.out works out from the shapes and dtypes of its arguments,
+ * built once by prepare_add_out().
+ */
+struct AddPlan {
+  /// The dtype-specialized compute loop.
+  void (*fn)(const AddPlan&, const Tensor&, const Tensor&, Tensor&);
+  BroadcastPlan broadcast;
+  /// alpha, already converted to the common dtype.
+  alignas(8) char alpha[8];
+};
+
+template <
+    typename CTYPE_A,
+    typename CTYPE_B,
+    typename CTYPE_IN,
+    typename CTYPE_OUT>
+void add_with_plan(
+    const AddPlan& plan,
+    const Tensor& a,
+    const Tensor& b,
+    Tensor& out) {
+  CTYPE_IN alpha_val;
+  memcpy(&alpha_val, plan.alpha, sizeof(CTYPE_IN));
+  apply_binary_elementwise_fn<CTYPE_A, CTYPE_B, CTYPE_OUT>(
+      [alpha_val](const CTYPE_A val_a, const CTYPE_B val_b) {
+        CTYPE_IN a_casted = static_cast<CTYPE_IN>(val_a);
+        CTYPE_IN b_casted = static_cast<CTYPE_IN>(val_b);
+        CTYPE_IN value = a_casted + alpha_val * b_casted;
+
+        return static_cast<CTYPE_OUT>(value);
+      },
+      plan.broadcast,
+      a,
+      b,
+      out);
+}
+
+// The dtypes handled by ET_SWITCH_REAL_TYPES_AND(Bool, ...).
+bool is_real_or_bool(ScalarType t) {
+  return isIntegralType(t, /*includeBool=*/true) || t == ScalarType::Float ||
+      t == ScalarType::Double;
+}
+
+// add.out(Tensor self, Tensor other, *, Scalar alpha=1, Tensor(a!) out)
+Error prepare_add_out(
+    MemoryAllocator* allocator,
+    EValue** args,
+    const void** plan_out) {
+  const Tensor& a = args[0]->toTensor();
+  const Tensor& b = args[1]->toTensor();
+  const Scalar& alpha = args[2]->toScalar();
+  Tensor& out = args[3]->toTensor();
+
+  ScalarType a_type = a.scalar_type();
+  ScalarType b_type = b.scalar_type();
+  ScalarType common_type = promoteTypes(a_type, b_type);
+  ScalarType out_type = out.scalar_type();
+  ET_CHECK_OR_RETURN_ERROR(
+      is_real_or_bool(a_type) && is_real_or_bool(b_type) &&
+          is_real_or_bool(out_type) && canCast(common_type, out_type),
+      InvalidArgument,
+      "Unsupported dtypes for add.out");
+  ET_CHECK_OR_RETURN_ERROR(
+      tensors_are_broadcastable_between(a, b),
+      InvalidArgument,
+      "add.out inputs are not broadcastable");
+
+  exec_aten::SizesType target_sizes[kTensorDimensionLimit];
+  size_t target_dim = 0;
+  get_broadcast_target_size(
+      a, b, target_sizes, kTensorDimensionLimit, &target_dim);
+  ET_CHECK_OR_RETURN_ERROR(
+      resize_tensor(out, {target_sizes, target_dim}) == Error::Ok,
+      InvalidArgument,
+      "Could not resize add.out output");
+
+  AddPlan* plan = ET_ALLOCATE_INSTANCE_OR_RETURN_ERROR(allocator, AddPlan);
+  make_broadcast_plan(a, b, out, &plan->broadcast);
+
+  bool alpha_ok = false;
+  ET_SWITCH_REAL_TYPES_AND(Bool, a_type, ctx, "add.out", CTYPE_A, [&]() {
+    ET_SWITCH_REAL_TYPES_AND(Bool, b_type, ctx, "add.out", CTYPE_B, [&]() {
+      ET_SWITCH_REAL_TYPES_AND(
+          Bool, common_type, ctx, "add.out", CTYPE_IN, [&]() {
+            ET_SWITCH_REAL_TYPES_AND(
+                Bool, out_type, ctx, "add.out", CTYPE_OUT, [&]() {
+                  CTYPE_IN alpha_val;
+                  alpha_ok = utils::extract_scalar(alpha, &alpha_val);
+                  memcpy(plan->alpha, &alpha_val, sizeof(CTYPE_IN));
+                  plan->fn =
+                      add_with_plan<CTYPE_A, CTYPE_B, CTYPE_IN, CTYPE_OUT>;
+                });
+          });
+    });
+  });
+  ET_CHECK_OR_RETURN_ERROR(
+      alpha_ok, InvalidArgument, "add.out alpha has the wrong type");
+
+  *plan_out = plan;
+  return Error::Ok;
+}
+
+void execute_add_out(
+    RuntimeContext& ctx,
+    const void* plan,
+    EValue** args) {
+  (void)ctx;
+  const AddPlan& add_plan = *static_cast<const AddPlan*>(plan);
+  add_plan.fn(
+      add_plan, args[0]->toTensor(), args[1]->toTensor(), args[3]->toTensor());
+}
+
+} // namespace
+
+// The prepare phase of add_out(). Only a Kernel whose OpFunction calls
+// add_out() may use it as its prepare_; the codegen'd registrations don't set
+// one, since another library's kernel may be registered for "aten::add.out".
+extern const KernelPrepare add_out_prepare;
+const KernelPrepare add_out_prepare(prepare_add_out, execute_add_out);
+#endif // USE_ATEN_LIB
+
 Tensor& add_scalar_out(
     RuntimeContext& ctx,
     const Tensor& a,
@@ -6,9 +6,11 @@
  * LICENSE file in the root directory of this source tree.
  */
 
+#include <algorithm>
 #include <cstring>
 
 #include <executorch/kernels/portable/cpu/util/copy_ops_util.h>
+#include <executorch/kernels/portable/cpu/util/strided_copy_util.h>
 #include <executorch/runtime/kernel/kernel_includes.h>
 
 namespace torch {
@@ -47,29 +49,54 @@ Tensor& cat_out(
     return out;
   }
 
-  const size_t outer = getLeadingDims(out, dim);
-  const size_t dim_stride = getTrailingDims(out, dim);
+  const int64_t outer = getLeadingDims(out, dim);
+  const int64_t dim_stride = getTrailingDims(out, dim);
+  const int64_t out_step = out.size(dim) * dim_stride;
   const size_t ninputs = tensors.size();
 
+  // Each input fills an [outer, inner] block of out whose rows are out_step
+  // elements apart. Copy a few rows of every input at a time so that out is
+  // written in order.
+  const int64_t block_rows = rows_per_copy_block(out_step * out.element_size());
+
   const auto out_type = out.scalar_type();
   ET_SWITCH_REAL_TYPES_AND(Bool, out_type, ctx, "cat.out", CTYPE_OUT, [&] {
-    CTYPE_OUT* out_ptr = out.mutable_data_ptr<CTYPE_OUT>();
-    for (size_t i = 0; i < outer; ++i) {
+    CTYPE_OUT* const out_data = out.mutable_data_ptr<CTYPE_OUT>();
+    const int64_t out_strides[2] = {out_step, 1};
+    for (int64_t row = 0; row < outer; row += block_rows) {
+      const int64_t rows = std::min(block_rows, outer - row);
+      CTYPE_OUT* out_ptr = out_data + row * out_step;
       for (size_t j = 0; j < ninputs; ++j) {
-        const auto in_type = tensors[j].scalar_type();
-        ET_SWITCH_REAL_TYPES_AND(Bool, in_type, ctx, "cat.out", CTYPE_IN, [&] {
-          if (tensors[j].numel() == 0) {
-            return;
-          }
-          size_t inner = tensors[j].size(dim) * dim_stride;
-          const CTYPE_IN* const in_ptr =
-              tensors[j].const_data_ptr<CTYPE_IN>() + i * inner;
+        if (tensors[j].numel() == 0) {
+          continue;
+        }
+        const int64_t inner = tensors[j].size(dim) * dim_stride;
+        const int64_t sizes[2] = {rows, inner};
+        const int64_t in_strides[2] = {inner, 1};
 
-          for (size_t k = 0; k < inner; ++k) {
-            out_ptr[k] = static_cast<CTYPE_OUT>(in_ptr[k]);
-          }
-          out_ptr += inner;
-        });
+        const auto in_type = tensors[j].scalar_type();
+        if (in_type == out_type) {
+          strided_copy(
+              out_ptr,
+              out_strides,
+              tensors[j].const_data_ptr<CTYPE_OUT>() + row * inner,
+              in_strides,
+              sizes,
+              2,
+              sizeof(CTYPE_OUT));
+        } else {
+          ET_SWITCH_REAL_TYPES_AND(
+              Bool, in_type, ctx, "cat.out", CTYPE_IN, [&] {
+                strided_convert(
+                    out_ptr,
+                    out_strides,
+                    tensors[j].const_data_ptr<CTYPE_IN>() + row * inner,
+                    in_strides,
+                    sizes,
+                    2);
+              });
+        }
+        out_ptr += inner;
       }
     }
   });
@@ -6,12 +6,14 @@
  * LICENSE file in the root directory of this source tree.
  */
 
+#include <algorithm>
 #include <cmath>
 #include <cstring>
 
 #include <executorch/runtime/kernel/kernel_includes.h>
 
 #include <executorch/kernels/portable/cpu/scalar_utils.h>
+#include <executorch/kernels/portable/cpu/util/strided_copy_util.h>
 
 namespace torch {
 namespace executor {
@@ -54,84 +56,98 @@ Error resize_to_expected_out_size(
   return error;
 }
 
+// Sizes and element strides of the input and output, and the padding before
+// the input along each dim.
+struct PadShape {
+  size_t ndim;
+  int64_t self_sizes[kTensorDimensionLimit];
+  int64_t self_strides[kTensorDimensionLimit];
+  int64_t out_sizes[kTensorDimensionLimit];
+  int64_t out_strides[kTensorDimensionLimit];
+  int64_t pad_before[kTensorDimensionLimit];
+};
+
+// Pads a slab of the output spanning dims [dim, ndim) that fits in cache: the
+// input is copied into its interior, after which the padding around it is
+// filled one dim at a time. For dim d, that covers the slabs before and after
+// the input along d, at every interior index of the dims before d and every
+// index of the dims after d, which are contiguous.
 template <typename CTYPE>
-void set_all_to_value(CTYPE* out_data, size_t step_len, CTYPE value) {
-  for (size_t i = 0; i < step_len; ++i) {
-    out_data[i] = value;
+void pad_block(
+    const CTYPE* self_data,
+    CTYPE* out_data,
+    const PadShape& shape,
+    CTYPE value,
+    size_t dim) {
+  const size_t ndim = shape.ndim - dim;
+  const int64_t* const self_sizes = shape.self_sizes + dim;
+  const int64_t* const out_sizes = shape.out_sizes + dim;
+  const int64_t* const out_strides = shape.out_strides + dim;
+  const int64_t* const pad_before = shape.pad_before + dim;
+
+  int64_t origin = 0;
+  for (size_t d = 0; d < ndim; ++d) {
+    origin += pad_before[d] * out_strides[d];
+  }
+  strided_copy(
+      out_data + origin,
+      out_strides,
+      self_data,
+      shape.self_strides + dim,
+      self_sizes,
+      ndim,
+      sizeof(CTYPE));
+
+  int64_t fill_sizes[kTensorDimensionLimit];
+  std::copy(out_sizes, out_sizes + ndim, fill_sizes);
+  CTYPE* slab_origin = out_data;
+  for (size_t d = 0; d < ndim; ++d) {
+    const int64_t pad_after = out_sizes[d] - pad_before[d] - self_sizes[d];
+
+    fill_sizes[d] = pad_before[d];
+    strided_fill(slab_origin, out_strides, fill_sizes, ndim, value);
+
+    fill_sizes[d] = pad_after;
+    strided_fill(
+        slab_origin + (pad_before[d] + self_sizes[d]) * out_strides[d],
+        out_strides,
+        fill_sizes,
+        ndim,
+        value);
+
+    fill_sizes[d] = self_sizes[d];
+    slab_origin += pad_before[d] * out_strides[d];
   }
 }
 
+// Pads the slab of the output spanning dims [dim, ndim). Slabs whose
+// sub-slabs along `dim` are themselves larger than a block are walked in
+// order along `dim`, so the output is written once, front to back.
 template <typename CTYPE>
-void apply_padding_to_dim(
-    size_t ndim,
+void pad_slab(
     const CTYPE* self_data,
-    IntArrayRef self_sizes,
-    IntArrayRef self_strides,
     CTYPE* out_data,
-    IntArrayRef out_sizes,
-    IntArrayRef out_strides,
-    IntArrayRef pad,
-    const CTYPE value,
-    size_t last_padded_dim,
+    const PadShape& shape,
+    CTYPE value,
     size_t dim) {
-  if (dim >= ndim) {
+  const int64_t out_step = shape.out_strides[dim];
+  if (out_step * sizeof(CTYPE) < kStridedCopyBlockBytes) {
+    pad_block(self_data, out_data, shape, value, dim);
     return;
   }
 
-  size_t pad_i = ndim - 1 - dim;
-
-  size_t pad_before = 0;
-  size_t pad_after = 0;
-  if (pad_i >= 0 && pad_i < pad.size() / 2) {
-    pad_before = pad[2 * pad_i];
-    pad_after = pad[2 * pad_i + 1];
-  }
-
-  size_t out_step_len = out_strides[dim];
-  size_t in_step_len = self_strides[dim];
-
-  for (size_t i = 0; i < pad_before; ++i) {
-    set_all_to_value(out_data, out_step_len, value);
-    out_data += out_step_len;
-  }
-
-  // If subsequent dims are not padded, then the whole block of memory can be
-  // copied.
-  if (dim >= last_padded_dim) {
-    size_t copy_len = in_step_len * self_sizes[dim];
-    size_t copy_nbytes = copy_len * sizeof(CTYPE);
-
-    if (copy_nbytes > 0) {
-      memcpy(out_data, self_data, copy_nbytes);
-      out_data += copy_len;
-      self_data += copy_len;
-    }
-  }
-  // Otherwise, call this function recursively
-  else {
-    for (size_t i = 0; i < self_sizes[dim]; ++i) {
-      apply_padding_to_dim(
-          ndim,
-          self_data,
-          self_sizes,
-          self_strides,
-          out_data,
-          out_sizes,
-          out_strides,
-          pad,
-          value,
-          last_padded_dim,
-          dim + 1);
-
-      out_data += out_step_len;
-      self_data += in_step_len;
-    }
-  }
+  const int64_t pad_before = shape.pad_before[dim];
+  const int64_t pad_after =
+      shape.out_sizes[dim] - pad_before - shape.self_sizes[dim];
 
-  for (int i = 0; i < pad_after; ++i) {
-    set_all_to_value(out_data, out_step_len, value);
-    out_data += out_step_len;
+  std::fill(out_data, out_data + pad_before * out_step, value);
+  out_data += pad_before * out_step;
+  for (int64_t i = 0; i < shape.self_sizes[dim]; ++i) {
+    pad_slab(self_data, out_data, shape, value, dim + 1);
+    self_data += shape.self_strides[dim];
+    out_data += out_step;
   }
+  std::fill(out_data, out_data + pad_after * out_step, value);
 }
 
 template <typename CTYPE>
@@ -150,45 +166,21 @@ void constant_pad_nd_out_impl(
     return;
   }
 
-  int64_t self_sizes[kTensorDimensionLimit];
-  int64_t self_strides[kTensorDimensionLimit];
-  int64_t out_sizes[kTensorDimensionLimit];
-  int64_t out_strides[kTensorDimensionLimit];
-
-  // Collect sizes and strides of input and output tensors and determine the
-  // last padded dimension
-  size_t last_padded_dim = 0;
+  // Collect sizes and strides of input and output tensors, and the padding
+  // before the input along each dim.
+  PadShape shape;
+  shape.ndim = ndim;
   for (size_t i = 0; i < ndim; ++i) {
-    self_sizes[i] = self.size(i);
-    self_strides[i] = getTrailingDims(self, static_cast<int64_t>(i));
-    out_sizes[i] = out.size(i);
-    out_strides[i] = getTrailingDims(out, static_cast<int64_t>(i));
+    shape.self_sizes[i] = self.size(i);
+    shape.self_strides[i] = getTrailingDims(self, static_cast<int64_t>(i));
+    shape.out_sizes[i] = out.size(i);
+    shape.out_strides[i] = getTrailingDims(out, static_cast<int64_t>(i));
 
     size_t pad_i = ndim - 1 - i;
-    if (pad_i >= 0 && pad_i < pad.size() / 2) {
-      if (pad[2 * pad_i] + pad[2 * pad_i + 1] > 0) {
-        last_padded_dim = i;
-      }
-    }
+    shape.pad_before[i] = pad_i < pad.size() / 2 ? pad[2 * pad_i] : 0;
   }
 
-  IntArrayRef self_sizes_ref(self_sizes, ndim);
-  IntArrayRef self_strides_ref(self_strides, ndim);
-  IntArrayRef out_sizes_ref(out_sizes, ndim);
-  IntArrayRef out_strides_ref(out_strides, ndim);
-
-  apply_padding_to_dim(
-      ndim,
-      self_data,
-      self_sizes_ref,
-      self_strides_ref,
-      out_data,
-      out_sizes_ref,
-      out_strides_ref,
-      pad,
-      value_v,
-      last_padded_dim,
-      0);
+  pad_slab(self_data, out_data, shape, value_v, 0);
 }
 
 } // namespace
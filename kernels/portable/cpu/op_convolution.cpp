@@ -129,6 +129,92 @@ void conv2d_impl(
   }
 }
 
+/**
+ * Accumulates the contribution of a single in channel to a transposed 2D
+ * convolution. Each in element is scattered, scaled by the kernel, into the
+ * out channels of its group. out must already hold the bias (or zeros).
+ */
+template <typename CTYPE>
+void conv_transpose2d_impl(
+    const CTYPE* const in_ptr,
+    SizesArrayRef in_sizes,
+    StridesArrayRef in_strides,
+    const CTYPE* const w_ptr,
+    SizesArrayRef w_sizes,
+    StridesArrayRef w_strides,
+    IntArrayRef stride,
+    IntArrayRef padding,
+    IntArrayRef dilation,
+    CTYPE* const out_ptr,
+    SizesArrayRef out_sizes,
+    StridesArrayRef out_strides,
+    const size_t batch,
+    const size_t group,
+    const size_t in_c) {
+  size_t in_H = in_sizes[2];
+  size_t in_W = in_sizes[3];
+
+  size_t out_C_per_group = w_sizes[1];
+  size_t w_H = w_sizes[2];
+  size_t w_W = w_sizes[3];
+
+  size_t out_H = out_sizes[2];
+  size_t out_W = out_sizes[3];
+
+  size_t out_c_start = group * out_C_per_group;
+
+  int64_t stride_y = val_at(stride, 0);
+  int64_t padding_y = val_at(padding, 0, /*default_value=*/0);
+  int64_t dilation_y = val_at(dilation, 0);
+  int64_t stride_x = val_at(stride, 1);
+  int64_t padding_x = val_at(padding, 1, /*default_value=*/0);
+  int64_t dilation_x = val_at(dilation, 1);
+
+  exec_aten::SizesType in_coord[kTensorDimensionLimit];
+  in_coord[0] = batch;
+  in_coord[1] = in_c;
+  exec_aten::SizesType out_coord[kTensorDimensionLimit];
+  out_coord[0] = batch;
+  exec_aten::SizesType w_coord[kTensorDimensionLimit];
+  w_coord[0] = in_c;
+
+  for (size_t in_y = 0; in_y < in_H; ++in_y) {
+    in_coord[2] = in_y;
+    for (size_t in_x = 0; in_x < in_W; ++in_x) {
+      in_coord[3] = in_x;
+      size_t in_idx = calculate_linear_index(in_coord, in_strides.data(), 4);
+      CTYPE in_val = in_ptr[in_idx];
+
+      for (size_t w_y = 0; w_y < w_H; ++w_y) {
+        w_coord[2] = w_y;
+        int64_t out_y = stride_y * in_y + dilation_y * w_y - padding_y;
+        // Only proceed if output y coordinate is within bounds
+        if (out_y < 0 || out_y >= static_cast<int64_t>(out_H)) {
+          continue;
+        }
+        out_coord[2] = out_y;
+        for (size_t w_x = 0; w_x < w_W; ++w_x) {
+          w_coord[3] = w_x;
+          int64_t out_x = stride_x * in_x + dilation_x * w_x - padding_x;
+          // Only proceed if output x coordinate is within bounds
+          if (out_x < 0 || out_x >= static_cast<int64_t>(out_W)) {
+            continue;
+          }
+          out_coord[3] = out_x;
+          for (size_t c = 0; c < out_C_per_group; ++c) {
+            w_coord[1] = c;
+            out_coord[1] = out_c_start + c;
+            size_t w_idx = calculate_linear_index(w_coord, w_strides.data(), 4);
+            size_t out_idx =
+                calculate_linear_index(out_coord, out_strides.data(), 4);
+            out_ptr[out_idx] += in_val * w_ptr[w_idx];
+          }
+        }
+      }
+    }
+  }
+}
+
 template <typename CTYPE, typename CTYPE_BIAS>
 void convolution_wrapper(
     const Tensor& in,
@@ -137,10 +223,11 @@ void convolution_wrapper(
     IntArrayRef stride,
     IntArrayRef padding,
     IntArrayRef dilation,
+    bool transposed,
     int64_t groups,
     Tensor& out) {
   size_t out_N = in.size(0);
-  size_t out_C = weight.size(0);
+  size_t out_C = transposed ? weight.size(1) * groups : weight.size(0);
 
   // Compute the number of in and out channels in each group
   size_t out_C_per_group = out_C / groups;
@@ -232,6 +319,51 @@ void convolution_wrapper(
   const CTYPE_BIAS* const bias_ptr =
       bias.has_value() ? bias.value().const_data_ptr<CTYPE_BIAS>() : nullptr;
 
+  if (transposed) {
+    size_t in_C_per_group = in.size(1) / groups;
+    size_t out_HW = out_sizes[2] * out_sizes[3];
+    exec_aten::SizesType out_coord[kTensorDimensionLimit];
+    for (size_t batch = 0; batch < out_N; ++batch) {
+      out_coord[0] = batch;
+      // Every out element is a sum of scattered contributions, so start
+      // from the bias.
+      for (size_t out_c = 0; out_c < out_C; ++out_c) {
+        out_coord[1] = out_c;
+        CTYPE init = bias_ptr != nullptr
+            ? convert<CTYPE, CTYPE_BIAS>(bias_ptr[out_c])
+            : static_cast<CTYPE>(0);
+        for (size_t i = 0; i < out_HW; ++i) {
+          out_coord[2] = i / out_sizes[3];
+          out_coord[3] = i % out_sizes[3];
+          out_ptr[calculate_linear_index(out_coord, out_strides, 4)] = init;
+        }
+      }
+      for (size_t group = 0; group < groups; ++group) {
+        size_t in_c_start = group * in_C_per_group;
+        for (size_t in_c = in_c_start; in_c < in_c_start + in_C_per_group;
+             ++in_c) {
+          conv_transpose2d_impl(
+              in_ptr,
+              in_sizes,
+              {in_strides, 4},
+              w_ptr,
+              weight_sizes,
+              {weight_strides, 4},
+              stride_,
+              padding_,
+              dilation_,
+              out_ptr,
+              out_sizes,
+              {out_strides, 4},
+              batch,
+              group,
+              in_c);
+        }
+      }
+    }
+    return;
+  }
+
   for (size_t batch = 0; batch < out_N; ++batch) {
     for (size_t group = 0; group < groups; ++group) {
       // Align channel offset based on the group
@@ -272,8 +404,8 @@ Tensor& convolution_out(
     IntArrayRef stride,
     IntArrayRef padding,
     IntArrayRef dilation,
-    __ET_UNUSED bool transposed,
-    __ET_UNUSED IntArrayRef output_padding,
+    bool transposed,
+    IntArrayRef output_padding,
     int64_t groups,
     Tensor& out) {
   (void)ctx;
@@ -296,8 +428,21 @@ Tensor& convolution_out(
 
   size_t output_ndim = 0;
   exec_aten::SizesType output_sizes[kTensorDimensionLimit];
-  get_convolution_out_target_size(
-      in, weight, stride, padding, dilation, output_sizes, &output_ndim);
+  ET_KERNEL_CHECK(
+      ctx,
+      get_convolution_out_target_size(
+          in,
+          weight,
+          stride,
+          padding,
+          dilation,
+          transposed,
+          output_padding,
+          groups,
+          output_sizes,
+          &output_ndim),
+      InvalidArgument,
+      out);
 
   ET_KERNEL_CHECK(
       ctx,
@@ -324,7 +469,15 @@ Tensor& convolution_out(
     ET_SWITCH_REAL_TYPES_AND(
         Bool, bias_type, ctx, "convolution.out", CTYPE_BIAS, [&]() {
           convolution_wrapper<CTYPE, CTYPE_BIAS>(
-              in, weight, bias, stride, padding, dilation, groups, out);
+              in,
+              weight,
+              bias,
+              stride,
+              padding,
+              dilation,
+              transposed,
+              groups,
+              out);
         });
   });
 
@@ -0,0 +1,104 @@
+/*
+ * Copyright (c) Meta Platforms, Inc. and affiliates.
+ * All rights reserved.
+ *
+ * This source code is licensed under the BSD-style license found in the
+ * LICENSE file in the root directory of this source tree.
+ */
+
+#include <executorch/kernels/portable/cpu/util/reduce_util.h>
+#include <executorch/runtime/kernel/kernel_includes.h>
+
+namespace torch {
+namespace executor {
+namespace native {
+
+using Tensor = exec_aten::Tensor;
+using ScalarType = exec_aten::ScalarType;
+
+namespace {
+
+/**
+ * Computes the cumulative product of `self` along `dim` into `out`. Like
+ * cumsum, each slice along `dim` is computed from the previous output slice,
+ * so memory is walked sequentially.
+ */
+template <typename CTYPE_IN, typename CTYPE_OUT>
+void cumprod_tensors(const Tensor& self, int64_t dim, Tensor& out) {
+  if (self.numel() == 0) {
+    return;
+  }
+
+  const CTYPE_IN* const in_data = self.const_data_ptr<CTYPE_IN>();
+  CTYPE_OUT* const out_data = out.mutable_data_ptr<CTYPE_OUT>();
+
+  if (self.dim() == 0) {
+    out_data[0] = static_cast<CTYPE_OUT>(in_data[0]);
+    return;
+  }
+
+  const size_t dim_size = static_cast<size_t>(self.size(dim));
+  const size_t leading_dims = getLeadingDims(self, dim);
+  const size_t trailing_dims = getTrailingDims(self, dim);
+
+  for (size_t i = 0; i < leading_dims; i++) {
+    const size_t start_loc = i * (trailing_dims * dim_size);
+
+    for (size_t idx = 0; idx < trailing_dims; idx++) {
+      out_data[start_loc + idx] =
+          static_cast<CTYPE_OUT>(in_data[start_loc + idx]);
+    }
+
+    for (size_t j = 1; j < dim_size; j++) {
+      const size_t cur_round_base = start_loc + j * trailing_dims;
+      const size_t prev_round_base = start_loc + (j - 1) * trailing_dims;
+      for (size_t idx = 0; idx < trailing_dims; idx++) {
+        out_data[cur_round_base + idx] =
+            static_cast<CTYPE_OUT>(in_data[cur_round_base + idx]) *
+            out_data[prev_round_base + idx];
+      }
+    }
+  }
+}
+
+} // namespace
+
+/**
+ * Returns the cumulative product of elements of input in the dimension dim.
+ * If dtype is specified, the input tensor is cast to dtype before the
+ * operation is performed. This is useful for preventing data type overflows.
+ */
+Tensor& cumprod_out(
+    RuntimeContext& ctx,
+    const Tensor& self,
+    int64_t dim,
+    optional<ScalarType> dtype,
+    Tensor& out) {
+  ET_KERNEL_CHECK(
+      ctx,
+      check_cumulative_args(self, dim, dtype, out),
+      InvalidArgument,
+      out);
+
+  ET_KERNEL_CHECK(
+      ctx,
+      resize_tensor(out, self.sizes()) == Error::Ok,
+      InvalidArgument,
+      out);
+
+  dim = (self.dim() == 0) ? 0 : dim < 0 ? dim + self.dim() : dim;
+
+  ET_SWITCH_REAL_TYPES_AND(
+      Bool, self.scalar_type(), ctx, "cumprod.out", CTYPE_IN, [&]() {
+        ET_SWITCH_REAL_TYPES(
+            out.scalar_type(), ctx, "cumprod.out", CTYPE_OUT, [&]() {
+              cumprod_tensors<CTYPE_IN, CTYPE_OUT>(self, dim, out);
+            });
+      });
+
+  return out;
+}
+
+} // namespace native
+} // namespace executor
+} // namespace torch
@@ -9,7 +9,6 @@
 #include <cinttypes>
 #include <cstdint>
 #include <cstring>
-#include <tuple>
 
 #include <executorch/kernels/portable/cpu/util/advanced_index_util.h>
 #include <executorch/kernels/portable/cpu/util/broadcast_util.h>
@@ -73,32 +72,56 @@ Tensor& index_Tensor_out(
     return out;
   }
 
-  int32_t dim_map[kTensorDimensionLimit];
-  int32_t ix_map[kTensorDimensionLimit];
-  size_t start = 0;
-  size_t xdim = 0;
-
-  if (adjacent) {
-    start = get_num_leading_null_indices(indices);
+  // With a single index, every output row is a whole input row.
+  SingleIndexView view;
+  if (get_single_index_view(in, indices, &view)) {
+    const char* const in_data = in.const_data_ptr<char>();
+    char* const out_data = out.mutable_data_ptr<char>();
+    const size_t row_nbytes = view.row_size * in.element_size();
+    if (view.is_mask) {
+      gather_mask_rows(
+          in_data, out_data, view, row_nbytes, 0, view.num_in_rows, 0);
+    } else {
+      ET_KERNEL_CHECK(
+          ctx,
+          check_index_bounds(*view.index, view.num_in_rows),
+          InvalidArgument,
+          out);
+      ET_SWITCH_TWO_TYPES(
+          Long,
+          Int,
+          view.index->scalar_type(),
+          ctx,
+          "index.Tensor_out",
+          CTYPE_IX,
+          [&]() {
+            gather_index_rows<CTYPE_IX>(
+                in_data,
+                out_data,
+                view,
+                row_nbytes,
+                0,
+                view.leading * view.num_x_rows);
+          });
+    }
+    return out;
   }
-  xdim = get_indices_broadcast_ndim(indices);
-  compute_dim_map(in, indices, dim_map, block_count == 1);
-  compute_index_map(in, indices, ix_map);
 
+  bool success = true;
   ET_SWITCH_REAL_TYPES_AND(
       Bool, in_type, ctx, "index.Tensor_out", CTYPE, [&]() {
         const CTYPE* const in_data = in.const_data_ptr<CTYPE>();
         CTYPE* const out_data = out.mutable_data_ptr<CTYPE>();
-
-        for (auto out_ix = 0; out_ix < out.numel(); out_ix++) {
-          size_t in_ix = 0;
-          bool success = true;
-          std::tie(in_ix, success) =
-              get_in_ix(in, indices, out, out_ix, start, xdim, dim_map, ix_map);
-          ET_KERNEL_CHECK(ctx, success, InvalidArgument, out);
-          out_data[out_ix] = in_data[in_ix];
-        }
+        success = apply_over_indexed_elements(
+            in,
+            indices,
+            expected_size,
+            expected_ndim,
+            [&](size_t out_ix, const size_t*, size_t in_ix) {
+              out_data[out_ix] = in_data[in_ix];
+            });
       });
+  ET_KERNEL_CHECK(ctx, success, InvalidArgument, out);
 
   return out;
 }
@@ -88,8 +88,12 @@ Tensor& index_put_out(
     return out;
   }
 
-  // To start, copy the input data into the out tensor
-  memcpy(out.mutable_data_ptr<char>(), in.const_data_ptr<char>(), in.nbytes());
+  // To start, copy the input data into the out tensor, unless it is already
+  // there.
+  if (out.const_data_ptr() != in.const_data_ptr()) {
+    memcpy(
+        out.mutable_data_ptr<char>(), in.const_data_ptr<char>(), in.nbytes());
+  }
 
   // In what follows, `x = in[indices]`. This tensor is implicit, and it would
   // be much easier to be able to allocate memory, and then call index.Tensor
@@ -97,54 +101,61 @@ Tensor& index_put_out(
   // shape, number of dimensions, number of elements, and use it to translate
   // coordinates from `x` to `in`.
 
-  // Compute the dim_map and ix_map needed for `x -> in` coordinate translation
-  int32_t dim_map[kTensorDimensionLimit];
-  int32_t ix_map[kTensorDimensionLimit];
-  size_t start = 0;
-
-  if (adjacent) {
-    start = get_num_leading_null_indices(indices);
-  }
-  size_t bc_ndim = get_indices_broadcast_ndim(indices);
-  compute_dim_map(in, indices, dim_map, block_count == 1);
-  compute_index_map(in, indices, ix_map);
-
-  // Compute the number of elements in the indexed space
-  size_t x_numel = 1;
-  for (size_t i = 0; i < x_dim; i++) {
-    x_numel *= x_sizes[i];
-  }
-
-  ET_SWITCH_REAL_TYPES_AND(Bool, in_type, ctx, "index_put.out", CTYPE, [&]() {
-    const CTYPE* const values_data = values.const_data_ptr<CTYPE>();
-    CTYPE* const out_data = out.mutable_data_ptr<CTYPE>();
-
-    for (auto x_ix = 0; x_ix < x_numel; x_ix++) {
-      size_t in_ix = 0;
-
-      size_t x_coord[kTensorDimensionLimit];
-      delinearize_index(x_ix, {x_sizes, x_dim}, x_coord, kTensorDimensionLimit);
-
-      size_t in_coord[kTensorDimensionLimit];
-
+  // With a single index and values of exactly the shape of `x`, every row of
+  // values is written to a whole row of out.
+  const exec_aten::ArrayRef<Tensor::SizesType> x_shape(x_sizes, x_dim);
+  SingleIndexView view;
+  if (get_single_index_view(in, indices, &view) && values.sizes() == x_shape) {
+    if (!view.is_mask) {
       ET_KERNEL_CHECK(
           ctx,
-          get_in_coord(
-              in, indices, start, bc_ndim, dim_map, ix_map, x_coord, in_coord),
+          check_index_bounds(*view.index, view.num_in_rows),
           InvalidArgument,
           out);
-
-      in_ix = coordinateToIndex(in, in_coord);
-
-      // Braodcast values
-      size_t val_ix = linearize_access_indexes(x_coord, x_dim, values);
-      if (accumulate) {
-        out_data[in_ix] += values_data[val_ix];
-      } else {
-        out_data[in_ix] = values_data[val_ix];
-      }
     }
+    ET_SWITCH_REAL_TYPES_AND(Bool, in_type, ctx, "index_put.out", CTYPE, [&]() {
+      const CTYPE* const values_data = values.const_data_ptr<CTYPE>();
+      CTYPE* const out_data = out.mutable_data_ptr<CTYPE>();
+      if (view.is_mask) {
+        scatter_mask_rows(values_data, out_data, view, accumulate);
+        return;
+      }
+      ET_SWITCH_TWO_TYPES(
+          Long,
+          Int,
+          view.index->scalar_type(),
+          ctx,
+          "index_put.out",
+          CTYPE_IX,
+          [&]() {
+            scatter_index_rows<CTYPE, CTYPE_IX>(
+                values_data, out_data, view, accumulate);
+          });
+    });
+    return out;
+  }
+
+  bool success = true;
+  ET_SWITCH_REAL_TYPES_AND(Bool, in_type, ctx, "index_put.out", CTYPE, [&]() {
+    const CTYPE* const values_data = values.const_data_ptr<CTYPE>();
+    CTYPE* const out_data = out.mutable_data_ptr<CTYPE>();
+    success = apply_over_indexed_elements(
+        in,
+        indices,
+        x_sizes,
+        x_dim,
+        [&](size_t, const size_t* x_coord, size_t in_ix) {
+          // Broadcast values
+          size_t val_ix =
+              linearize_access_indexes({x_coord, x_dim}, x_dim, values);
+          if (accumulate) {
+            out_data[in_ix] += values_data[val_ix];
+          } else {
+            out_data[in_ix] = values_data[val_ix];
+          }
+        });
   });
+  ET_KERNEL_CHECK(ctx, success, InvalidArgument, out);
 
   return out;
 }
@@ -0,0 +1,173 @@
+/*
+ * Copyright (c) Meta Platforms, Inc. and affiliates.
+ * All rights reserved.
+ *
+ * This source code is licensed under the BSD-style license found in the
+ * LICENSE file in the root directory of this source tree.
+ */
+
+#include <executorch/kernels/portable/cpu/util/normalization_ops_util.h>
+#include <executorch/kernels/portable/cpu/vec_ops.h>
+#include <executorch/runtime/kernel/kernel_includes.h>
+#include <cmath>
+#include <tuple>
+
+namespace torch {
+namespace executor {
+namespace native {
+
+using Tensor = exec_aten::Tensor;
+
+namespace {
+
+template <typename CTYPE>
+void group_norm(
+    const Tensor& input,
+    const optional<Tensor>& weight,
+    const optional<Tensor>& bias,
+    size_t N,
+    size_t C,
+    size_t HxW,
+    size_t G,
+    CTYPE eps,
+    Tensor& out,
+    Tensor& mean,
+    Tensor& rstd) {
+  // Each of the N * G groups is a contiguous run of D channels of HxW
+  // elements.
+  size_t leading = N * G;
+  size_t D = C / G;
+  size_t inner_size = D * HxW;
+
+  if (leading == 0) {
+    return;
+  }
+
+  CTYPE* out_data = out.mutable_data_ptr<CTYPE>();
+  CTYPE* mean_data = mean.mutable_data_ptr<CTYPE>();
+  CTYPE* rstd_data = rstd.mutable_data_ptr<CTYPE>();
+
+  if (inner_size == 0) {
+    for (int i = 0; i < leading; ++i) {
+      mean_data[i] = static_cast<CTYPE>(0);
+      rstd_data[i] = static_cast<CTYPE>(NAN);
+    }
+    return;
+  }
+
+  const CTYPE* input_data = input.const_data_ptr<CTYPE>();
+  const CTYPE* weight_data;
+  if (weight.has_value()) {
+    weight_data = weight.value().const_data_ptr<CTYPE>();
+  } else {
+    weight_data = nullptr;
+  }
+  const CTYPE* bias_data;
+  if (bias.has_value()) {
+    bias_data = bias.value().const_data_ptr<CTYPE>();
+  } else {
+    bias_data = nullptr;
+  }
+
+  for (int i = 0; i < leading; ++i) {
+    const CTYPE* x = input_data + i * inner_size;
+
+    // compute E[X] and Var[x] = E[x^2] - E[x]^2
+    CTYPE sum = reduce_add(x, inner_size);
+    CTYPE sq_sum = vec_powerf(x, inner_size);
+    CTYPE mean_value = sum / inner_size;
+    CTYPE variance = sq_sum / inner_size - mean_value * mean_value;
+    CTYPE std = std::sqrt(variance + eps);
+
+    // Calculate the elements of output, folding the normalization and the
+    // affine transform of each channel into a single scale and offset
+    for (int d = 0; d < D; ++d) {
+      size_t c = (i % G) * D + d;
+      CTYPE w = weight_data ? weight_data[c] : static_cast<CTYPE>(1);
+      CTYPE b = bias_data ? bias_data[c] : static_cast<CTYPE>(0);
+      CTYPE scale = w / std;
+      CTYPE offset = b - mean_value * scale;
+      const CTYPE* xc = x + d * HxW;
+      CTYPE* y = out_data + i * inner_size + d * HxW;
+      for (int j = 0; j < HxW; ++j) {
+        y[j] = xc[j] * scale + offset;
+      }
+    }
+
+    mean_data[i] = mean_value;
+    rstd_data[i] = 1.0 / std;
+  }
+}
+
+} // namespace
+
+// native_group_norm.out(Tensor input, Tensor? weight, Tensor? bias, SymInt N,
+// SymInt C, SymInt HxW, int group, float eps, *, Tensor(a!) out0, Tensor(b!)
+// out1, Tensor(c!) out2) -> (Tensor(a!), Tensor(b!), Tensor(c!))
+std::tuple<Tensor&, Tensor&, Tensor&> native_group_norm_out(
+    RuntimeContext& ctx,
+    const Tensor& input,
+    const exec_aten::optional<Tensor>& weight,
+    const exec_aten::optional<Tensor>& bias,
+    int64_t N,
+    int64_t C,
+    int64_t HxW,
+    int64_t group,
+    double eps,
+    Tensor& out,
+    Tensor& mean_out,
+    Tensor& rstd_out) {
+  (void)ctx;
+
+  std::tuple<Tensor&, Tensor&, Tensor&> ret_val(out, mean_out, rstd_out);
+
+  ET_KERNEL_CHECK(
+      ctx,
+      check_group_norm_args(
+          input, weight, bias, N, C, HxW, group, out, mean_out, rstd_out),
+      InvalidArgument,
+      ret_val);
+
+  Tensor::SizesType mean_rstd_sizes[2] = {
+      static_cast<Tensor::SizesType>(N), static_cast<Tensor::SizesType>(group)};
+
+  ET_KERNEL_CHECK(
+      ctx,
+      resize_tensor(out, input.sizes()) == Error::Ok,
+      InvalidArgument,
+      ret_val);
+
+  ET_KERNEL_CHECK(
+      ctx,
+      resize_tensor(mean_out, {mean_rstd_sizes, 2}) == Error::Ok,
+      InvalidArgument,
+      ret_val);
+
+  ET_KERNEL_CHECK(
+      ctx,
+      resize_tensor(rstd_out, {mean_rstd_sizes, 2}) == Error::Ok,
+      InvalidArgument,
+      ret_val);
+
+  ET_SWITCH_FLOAT_TYPES(
+      input.scalar_type(), ctx, "native_group_norm.out", CTYPE, [&]() {
+        group_norm<CTYPE>(
+            input,
+            weight,
+            bias,
+            N,
+            C,
+            HxW,
+            group,
+            eps,
+            out,
+            mean_out,
+            rstd_out);
+      });
+
+  return ret_val;
+}
+
+} // namespace native
+} // namespace executor
+} // namespace torch
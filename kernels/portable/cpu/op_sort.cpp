@@ -0,0 +1,124 @@
+/*
+ * Copyright (c) Meta Platforms, Inc. and affiliates.
+ * All rights reserved.
+ *
+ * This source code is licensed under the BSD-style license found in the
+ * LICENSE file in the root directory of this source tree.
+ */
+
+#include <tuple>
+
+#include <executorch/kernels/portable/cpu/util/sort_util.h>
+#include <executorch/runtime/kernel/kernel_includes.h>
+
+namespace torch {
+namespace executor {
+namespace native {
+
+using Tensor = exec_aten::Tensor;
+
+namespace {
+
+std::tuple<Tensor&, Tensor&> sort_impl(
+    RuntimeContext& ctx,
+    const Tensor& in,
+    bool stable,
+    int64_t dim,
+    bool descending,
+    Tensor& values,
+    Tensor& indices) {
+  std::tuple<Tensor&, Tensor&> ret_val(values, indices);
+
+  ET_KERNEL_CHECK(
+      ctx,
+      check_sort_args(in, dim, values, indices),
+      InvalidArgument,
+      ret_val);
+
+  ET_KERNEL_CHECK(
+      ctx,
+      resize_tensor(values, in.sizes()) == Error::Ok,
+      InvalidArgument,
+      ret_val);
+  ET_KERNEL_CHECK(
+      ctx,
+      resize_tensor(indices, in.sizes()) == Error::Ok,
+      InvalidArgument,
+      ret_val);
+
+  if (in.numel() == 0) {
+    return ret_val;
+  }
+
+  int64_t outer = 1;
+  int64_t n = 1;
+  int64_t inner = 1;
+  if (in.dim() > 0) {
+    dim = dim < 0 ? dim + in.dim() : dim;
+    outer = getLeadingDims(in, dim);
+    n = in.size(dim);
+    inner = getTrailingDims(in, dim);
+  }
+
+  ET_SWITCH_REAL_TYPES(in.scalar_type(), ctx, "sort.values", CTYPE, [&]() {
+    const CTYPE* const in_data = in.const_data_ptr<CTYPE>();
+    int64_t* const indices_data = indices.mutable_data_ptr<int64_t>();
+    sort_rows(
+        in_data, n, inner, descending, stable, 0, outer * inner, indices_data);
+    finish_ordered_slices(
+        in_data,
+        n,
+        inner,
+        n,
+        0,
+        outer,
+        values.mutable_data_ptr<CTYPE>(),
+        indices_data);
+  });
+
+  return ret_val;
+}
+
+} // namespace
+
+/**
+ * Sorts the elements of `in` along `dim`, in ascending order unless
+ * `descending` is set. `values` receives the sorted elements and `indices`
+ * their positions along `dim`. NaN sorts above every other value.
+ */
+std::tuple<Tensor&, Tensor&> sort_out(
+    RuntimeContext& ctx,
+    const Tensor& in,
+    int64_t dim,
+    bool descending,
+    Tensor& values,
+    Tensor& indices) {
+  return sort_impl(
+      ctx, in, /*stable=*/false, dim, descending, values, indices);
+}
+
+/**
+ * Like sort_out(), but if `stable` is set, equal elements keep their
+ * relative order.
+ */
+std::tuple<Tensor&, Tensor&> sort_stable_out(
+    RuntimeContext& ctx,
+    const Tensor& in,
+    exec_aten::optional<bool> stable,
+    int64_t dim,
+    bool descending,
+    Tensor& values,
+    Tensor& indices) {
+  return sort_impl(
+      ctx,
+      in,
+      stable.has_value() && stable.value(),
+      dim,
+      descending,
+      values,
+      indices);
+}
+
+} // namespace native
+} // namespace executor
+} // namespace torch
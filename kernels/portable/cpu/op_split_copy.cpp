@@ -6,9 +6,11 @@
  * LICENSE file in the root directory of this source tree.
  */
 
+#include <algorithm>
 #include <cstdint>
 #include <cstring>
 
+#include <executorch/kernels/portable/cpu/util/strided_copy_util.h>
 #include <executorch/runtime/kernel/kernel_includes.h>
 
 namespace torch {
@@ -168,33 +170,51 @@ void split_copy_Tensor_out(
   }
   check_args(input, split_size, dim, out);
 
-  const size_t leading_dims = getLeadingDims(input, dim);
-  const size_t trailing_dims = getTrailingDims(input, dim);
-  const size_t step = input.size(dim) * trailing_dims;
+  const int64_t leading_dims = getLeadingDims(input, dim);
+  const int64_t trailing_dims = getTrailingDims(input, dim);
+  const int64_t step = input.size(dim) * trailing_dims;
 
   ScalarType in_type = input.scalar_type();
   ScalarType out_type = out[0].scalar_type();
 
+  // Each output is a [leading_dims, out_step] block of the input whose rows
+  // are step elements apart. Copy a few rows into every output at a time so
+  // that the input is read in order.
+  const int64_t block_rows = rows_per_copy_block(step * input.element_size());
+  const int64_t in_strides[2] = {step, 1};
+
   ET_SWITCH_REAL_TYPES_AND(
       Bool, in_type, ctx, "split_copy.Tensor_out", CTYPE_IN, [&]() {
         ET_SWITCH_REAL_TYPES_AND(
             Bool, out_type, ctx, "split_copy.Tensor_out", CTYPE_OUT, [&]() {
-              const CTYPE_IN* input_data = input.const_data_ptr<CTYPE_IN>();
-              for (size_t i = 0, e = out.size(); i < e; ++i) {
-                size_t out_step = out[i].size(dim) * trailing_dims;
-                if (out_step == 0) {
-                  continue;
-                }
-                const CTYPE_IN* src = input_data;
-                CTYPE_OUT* dest = out[i].mutable_data_ptr<CTYPE_OUT>();
-                for (size_t j = 0; j < leading_dims; ++j) {
-                  for (size_t k = 0; k < out_step; ++k) {
-                    dest[k] = convert<CTYPE_OUT, CTYPE_IN>(src[k]);
+              for (int64_t row = 0; row < leading_dims; row += block_rows) {
+                const int64_t rows = std::min(block_rows, leading_dims - row);
+                const CTYPE_IN* input_data =
+                    input.const_data_ptr<CTYPE_IN>() + row * step;
+                for (size_t i = 0, e = out.size(); i < e; ++i) {
+                  const int64_t out_step = out[i].size(dim) * trailing_dims;
+                  if (out_step == 0) {
+                    continue;
+                  }
+                  const int64_t sizes[2] = {rows, out_step};
+                  const int64_t out_strides[2] = {out_step, 1};
+                  CTYPE_OUT* dest =
+                      out[i].mutable_data_ptr<CTYPE_OUT>() + row * out_step;
+                  if (in_type == out_type) {
+                    strided_copy(
+                        dest,
+                        out_strides,
+                        input_data,
+                        in_strides,
+                        sizes,
+                        2,
+                        sizeof(CTYPE_OUT));
+                  } else {
+                    strided_convert(
+                        dest, out_strides, input_data, in_strides, sizes, 2);
                   }
-                  src += step;
-                  dest += out_step;
+                  input_data += out_step;
                 }
-                input_data += out_step;
               }
             });
       });
@@ -11,6 +11,7 @@
 
 #include <executorch/kernels/portable/cpu/util/broadcast_util.h>
 #include <executorch/kernels/portable/cpu/util/copy_ops_util.h>
+#include <executorch/kernels/portable/cpu/util/strided_copy_util.h>
 #include <executorch/runtime/kernel/kernel_includes.h>
 
 namespace torch {
@@ -62,9 +63,9 @@ void split_with_sizes_copy_out(
         out);
   }
 
-  const size_t leading_dims = getLeadingDims(in, dim);
-  const size_t trailing_dims = getTrailingDims(in, dim);
-  const size_t step = in.size(dim) * trailing_dims;
+  const int64_t leading_dims = getLeadingDims(in, dim);
+  const int64_t trailing_dims = getTrailingDims(in, dim);
+  const int64_t step = in.size(dim) * trailing_dims;
 
   ScalarType in_type = in.scalar_type();
   ScalarType out_type = out[0].scalar_type();
@@ -82,7 +83,7 @@ void split_with_sizes_copy_out(
           continue;
         }
 
-        size_t chunk_step = split_sizes[i] * trailing_dims;
+        const int64_t chunk_step = split_sizes[i] * trailing_dims;
 
         // Update target out shape
         target_out_sizes[dim] = static_cast<Tensor::SizesType>(split_sizes[i]);
@@ -94,15 +95,25 @@ void split_with_sizes_copy_out(
 
         CTYPE_OUT* out_data = out_tensor.mutable_data_ptr<CTYPE_OUT>();
 
-        // Simpler logic if there's no broadcasting
+        // Simpler logic if there's no broadcasting: the chunk is a
+        // [leading_dims, chunk_step] block of the input whose rows are step
+        // elements apart.
         if (!is_broadcasted) {
-          const CTYPE_IN* src = in_data;
-          for (size_t j = 0; j < leading_dims; ++j) {
-            for (size_t k = 0; k < chunk_step; ++k) {
-              out_data[k] = convert<CTYPE_OUT, CTYPE_IN>(src[k]);
-            }
-            src += step;
-            out_data += chunk_step;
+          const int64_t sizes[2] = {leading_dims, chunk_step};
+          const int64_t in_strides[2] = {step, 1};
+          const int64_t out_strides[2] = {chunk_step, 1};
+          if (in_type == out_type) {
+            strided_copy(
+                out_data,
+                out_strides,
+                in_data,
+                in_strides,
+                sizes,
+                2,
+                sizeof(CTYPE_OUT));
+          } else {
+            strided_convert(
+                out_data, out_strides, in_data, in_strides, sizes, 2);
           }
         } else { // Otherwise, we need to do a copy with broadcasting
           // Compute target strides
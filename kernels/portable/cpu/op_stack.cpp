@@ -6,9 +6,11 @@
  * LICENSE file in the root directory of this source tree.
  */
 
+#include <algorithm>
 #include <cstring>
 
 #include <executorch/kernels/portable/cpu/util/copy_ops_util.h>
+#include <executorch/kernels/portable/cpu/util/strided_copy_util.h>
 #include <executorch/runtime/kernel/kernel_includes.h>
 
 namespace torch {
@@ -40,26 +42,48 @@ Tensor& stack_out(
       InvalidArgument,
       out);
 
-  const size_t outer = getLeadingDims(out, dim);
-  const size_t inner = getTrailingDims(out, dim);
-  const size_t ninputs = tensors.size();
+  const int64_t outer = getLeadingDims(out, dim);
+  const int64_t inner = getTrailingDims(out, dim);
+  const int64_t ninputs = tensors.size();
+
+  // Each input fills an [outer, inner] block of out whose rows are
+  // ninputs * inner elements apart. Copy a few rows of every input at a time
+  // so that out is written in order.
+  const int64_t block_rows =
+      rows_per_copy_block(ninputs * inner * out.element_size());
+  const int64_t out_strides[2] = {ninputs * inner, 1};
+  const int64_t in_strides[2] = {inner, 1};
 
   const auto out_type = out.scalar_type();
   ET_SWITCH_REAL_TYPES_AND(Bool, out_type, ctx, "stack.out", CTYPE_OUT, [&] {
-    CTYPE_OUT* out_ptr = out.mutable_data_ptr<CTYPE_OUT>();
-    for (size_t i = 0; i < outer; ++i) {
-      for (size_t j = 0; j < ninputs; ++j) {
+    CTYPE_OUT* const out_data = out.mutable_data_ptr<CTYPE_OUT>();
+    for (int64_t row = 0; row < outer; row += block_rows) {
+      const int64_t sizes[2] = {std::min(block_rows, outer - row), inner};
+      CTYPE_OUT* out_ptr = out_data + row * ninputs * inner;
+      for (int64_t j = 0; j < ninputs; ++j) {
         const auto in_type = tensors[j].scalar_type();
-        ET_SWITCH_REAL_TYPES_AND(
-            Bool, in_type, ctx, "stack.out", CTYPE_IN, [&] {
-              const CTYPE_IN* const in_ptr =
-                  tensors[j].const_data_ptr<CTYPE_IN>() + i * inner;
-
-              for (size_t k = 0; k < inner; ++k) {
-                out_ptr[k] = static_cast<CTYPE_OUT>(in_ptr[k]);
-              }
-              out_ptr += inner;
-            });
+        if (in_type == out_type) {
+          strided_copy(
+              out_ptr,
+              out_strides,
+              tensors[j].const_data_ptr<CTYPE_OUT>() + row * inner,
+              in_strides,
+              sizes,
+              2,
+              sizeof(CTYPE_OUT));
+        } else {
+          ET_SWITCH_REAL_TYPES_AND(
+              Bool, in_type, ctx, "stack.out", CTYPE_IN, [&] {
+                strided_convert(
+                    out_ptr,
+                    out_strides,
+                    tensors[j].const_data_ptr<CTYPE_IN>() + row * inner,
+                    in_strides,
+                    sizes,
+                    2);
+              });
+        }
+        out_ptr += inner;
       }
     }
   });
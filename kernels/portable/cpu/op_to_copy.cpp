@@ -48,35 +48,14 @@ Tensor& to_copy_out(
 
   // self and out should be in same size.
   ET_CHECK_SAME_SHAPE2(self, out);
-// Use a two layer switch to hanldle each possible data pairs
-#define TO_IMPL(SELF_CTYPE, OUT_CTYPE, out_dtype) \
-  case ScalarType::out_dtype:                     \
-    _to_impl<SELF_CTYPE, OUT_CTYPE>(self, out);   \
-    break;
 
-#define CASE_TENSOR_DTYPE(SELF_CTYPE, self_dtype)              \
-  case ScalarType::self_dtype:                                 \
-    switch (out.scalar_type()) {                               \
-      ET_FORALL_REAL_TYPES_AND_WITH(Bool, SELF_CTYPE, TO_IMPL) \
-      default:                                                 \
-        ET_CHECK_MSG(                                          \
-            false,                                             \
-            "Unhandled output dtype %" PRId8,                  \
-            static_cast<int8_t>(out.scalar_type()));           \
-    }                                                          \
-    break;
-
-  switch (self.scalar_type()) {
-    ET_FORALL_REAL_TYPES_AND(Bool, CASE_TENSOR_DTYPE);
-    default:
-      ET_CHECK_MSG(
-          false,
-          "Unhandled input dtype %" PRId8,
-          static_cast<int8_t>(self.scalar_type()));
-  }
-
-#undef CASE_TENSOR_DTYPE
-#undef TO_IMPL
+  ET_SWITCH_REAL_TYPES_AND(
+      Bool, self.scalar_type(), ctx, "_to_copy.out", CTYPE_SELF, [&] {
+        ET_SWITCH_REAL_TYPES_AND(
+            Bool, out.scalar_type(), ctx, "_to_copy.out", CTYPE_OUT, [&] {
+              _to_impl<CTYPE_SELF, CTYPE_OUT>(self, out);
+            });
+      });
 
   return out;
 }
@@ -0,0 +1,106 @@
+/*
+ * Copyright (c) Meta Platforms, Inc. and affiliates.
+ * All rights reserved.
+ *
+ * This source code is licensed under the BSD-style license found in the
+ * LICENSE file in the root directory of this source tree.
+ */
+
+#include <algorithm>
+
+#include <executorch/kernels/portable/cpu/util/upsample_util.h>
+#include <executorch/runtime/kernel/kernel_includes.h>
+
+namespace torch {
+namespace executor {
+namespace native {
+
+using Tensor = exec_aten::Tensor;
+using ScalarType = exec_aten::ScalarType;
+
+namespace {
+
+// Output columns whose source columns are computed together.
+constexpr int64_t kColumnBlock = 256;
+
+template <typename CTYPE>
+void upsample_nearest2d_kernel_impl(
+    const Tensor& in,
+    const double scale_h,
+    const double scale_w,
+    Tensor& out) {
+  const CTYPE* const in_data = in.const_data_ptr<CTYPE>();
+  CTYPE* const out_data = out.mutable_data_ptr<CTYPE>();
+
+  const auto in_h = in.size(2);
+  const auto in_w = in.size(3);
+  const auto out_h = out.size(2);
+  const auto out_w = out.size(3);
+  const float ratio_h = compute_nearest_scale(in_h, out_h, scale_h);
+  const float ratio_w = compute_nearest_scale(in_w, out_w, scale_w);
+
+  const auto in_strides = in.strides();
+  const auto out_strides = out.strides();
+
+  int64_t in_x_offsets[kColumnBlock];
+  for (int64_t x0 = 0; x0 < out_w; x0 += kColumnBlock) {
+    const int64_t x_count = std::min(kColumnBlock, out_w - x0);
+    for (int64_t i = 0; i < x_count; ++i) {
+      in_x_offsets[i] =
+          nearest_idx(x0 + i, in_w, out_w, ratio_w) * in_strides[3];
+    }
+
+    for (int64_t n = 0; n < out.size(0); ++n) {
+      for (int64_t c = 0; c < out.size(1); ++c) {
+        const CTYPE* const in_plane =
+            in_data + n * in_strides[0] + c * in_strides[1];
+        CTYPE* const out_plane =
+            out_data + n * out_strides[0] + c * out_strides[1];
+        for (int64_t y = 0; y < out_h; ++y) {
+          const CTYPE* const in_row =
+              in_plane + nearest_idx(y, in_h, out_h, ratio_h) * in_strides[2];
+          CTYPE* const out_row = out_plane + y * out_strides[2];
+          for (int64_t i = 0; i < x_count; ++i) {
+            out_row[(x0 + i) * out_strides[3]] = in_row[in_x_offsets[i]];
+          }
+        }
+      }
+    }
+  }
+}
+
+} // namespace
+
+Tensor& upsample_nearest2d_vec_out(
+    RuntimeContext& ctx,
+    const Tensor& in,
+    const exec_aten::optional<exec_aten::ArrayRef<int64_t>> output_size,
+    const exec_aten::optional<exec_aten::ArrayRef<double>> scale_factors,
+    Tensor& out) {
+  ET_KERNEL_CHECK(
+      ctx,
+      check_upsample_nearest2d_args(in, output_size, scale_factors, out),
+      InvalidArgument,
+      out);
+
+  double scale_h, scale_w;
+
+  ET_KERNEL_CHECK_MSG(
+      ctx,
+      resize_upsample_2d(
+          in, output_size, scale_factors, scale_h, scale_w, out) == Error::Ok,
+      InvalidArgument,
+      out,
+      "Failed to resize output tensor");
+
+  ET_SWITCH_REAL_TYPES_AND(
+      Bool, in.scalar_type(), ctx, "upsample_nearest2d.out", CTYPE, [&]() {
+        upsample_nearest2d_kernel_impl<CTYPE>(in, scale_h, scale_w, out);
+      });
+
+  return out;
+}
+
+} // namespace native
+} // namespace executor
+} // namespace torch
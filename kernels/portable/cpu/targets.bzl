@@ -32,6 +32,8 @@ _ATEN_OPS = (
         deps = [
             "//executorch/kernels/portable/cpu/util:broadcast_util",
             "//executorch/kernels/portable/cpu/util:functional_util",
+            "//executorch/runtime/core:memory_allocator",
+            "//executorch/runtime/kernel:operator_registry",
             ":scalar_utils",
         ],
     ),
@@ -182,6 +184,7 @@ _ATEN_OPS = (
         name = "op_cat",
         deps = [
             "//executorch/kernels/portable/cpu/util:copy_ops_util",
+            "//executorch/kernels/portable/cpu/util:strided_copy_util",
         ],
     ),
     op_target(
@@ -202,7 +205,10 @@ _ATEN_OPS = (
     ),
     op_target(
         name = "op_constant_pad_nd",
-        deps = [":scalar_utils"],
+        deps = [
+            ":scalar_utils",
+            "//executorch/kernels/portable/cpu/util:strided_copy_util",
+        ],
     ),
     op_target(
         name = "op_convolution",
@@ -232,6 +238,12 @@ _ATEN_OPS = (
             "//executorch/kernels/portable/cpu/pattern:pattern",
         ],
     ),
+    op_target(
+        name = "op_cumprod",
+        deps = [
+            "//executorch/kernels/portable/cpu/util:reduce_util",
+        ],
+    ),
     op_target(
         name = "op_cumsum",
         deps = [
@@ -543,6 +555,13 @@ _ATEN_OPS = (
             "//executorch/kernels/portable/cpu/util:normalization_ops_util",
         ],
     ),
+    op_target(
+        name = "op_native_group_norm",
+        deps = [
+            ":vec_ops",
+            "//executorch/kernels/portable/cpu/util:normalization_ops_util",
+        ],
+    ),
     op_target(
         name = "op_native_layer_norm",
         deps = [
@@ -700,14 +719,24 @@ _ATEN_OPS = (
             "//executorch/kernels/portable/cpu/util:reduce_util",
         ],
     ),
+    op_target(
+        name = "op_sort",
+        deps = [
+            "//executorch/kernels/portable/cpu/util:sort_util",
+        ],
+    ),
     op_target(
         name = "op_split_copy",
+        deps = [
+            "//executorch/kernels/portable/cpu/util:strided_copy_util",
+        ],
     ),
     op_target(
         name = "op_split_with_sizes_copy",
         deps = [
             "//executorch/kernels/portable/cpu/util:broadcast_util",
             "//executorch/kernels/portable/cpu/util:copy_ops_util",
+            "//executorch/kernels/portable/cpu/util:strided_copy_util",
         ],
     ),
     op_target(
@@ -726,6 +755,7 @@ _ATEN_OPS = (
         name = "op_stack",
         deps = [
             "//executorch/kernels/portable/cpu/util:copy_ops_util",
+            "//executorch/kernels/portable/cpu/util:strided_copy_util",
         ],
     ),
     op_target(
@@ -763,6 +793,12 @@ _ATEN_OPS = (
     op_target(
         name = "op_to_copy",
     ),
+    op_target(
+        name = "op_topk",
+        deps = [
+            "//executorch/kernels/portable/cpu/util:sort_util",
+        ],
+    ),
     op_target(
         name = "op_transpose_copy",
         deps = ["//executorch/kernels/portable/cpu/util:transpose_util"],
@@ -779,6 +815,18 @@ _ATEN_OPS = (
     op_target(
         name = "op_unsqueeze_copy",
     ),
+    op_target(
+        name = "op_upsample_bilinear2d",
+        deps = [
+            "//executorch/kernels/portable/cpu/util:upsample_util",
+        ],
+    ),
+    op_target(
+        name = "op_upsample_nearest2d",
+        deps = [
+            "//executorch/kernels/portable/cpu/util:upsample_util",
+        ],
+    ),
     op_target(
         name = "op_var",
         deps = [
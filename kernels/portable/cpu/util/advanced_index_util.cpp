@@ -6,6 +6,10 @@
  * LICENSE file in the root directory of this source tree.
  */
 
+#include <cinttypes>
+#include <cstring>
+
+#include <executorch/kernels/portable/cpu/util/advanced_index_util.h>
 #include <executorch/kernels/portable/cpu/util/broadcast_util.h>
 #include <executorch/runtime/kernel/kernel_includes.h>
 
@@ -75,14 +79,6 @@ size_t _count_trues_in_mask_index(const Tensor& index) {
   return sum;
 }
 
-size_t count_trues_in_mask_index(const Tensor& index) {
-  if (index.scalar_type() == ScalarType::Bool) {
-    return _count_trues_in_mask_index<bool>(index);
-  } else {
-    return _count_trues_in_mask_index<uint8_t>(index);
-  }
-}
-
 template <typename CTYPE_IX>
 void _query_mask_index(const Tensor& index, size_t query_idx, size_t* res) {
   const CTYPE_IX* const index_ptr = index.const_data_ptr<CTYPE_IX>();
@@ -138,6 +134,11 @@ int64_t query_integral_index(
 
 } // namespace
 
+size_t count_trues_in_mask_index(const Tensor& index) {
+  return count_mask_trues(
+      static_cast<const uint8_t*>(index.const_data_ptr()), 0, index.numel());
+}
+
 bool check_index_args(const Tensor& in, TensorOptList indices, Tensor& out) {
   ET_LOG_AND_RETURN_IF_FALSE(tensors_have_same_dtype(in, out));
   ET_LOG_AND_RETURN_IF_FALSE(check_indices_dtypes(indices));
@@ -461,5 +462,90 @@ std::pair<size_t, bool> get_in_ix(
   return std::make_pair(coordinateToIndex(in, in_coord), true);
 }
 
+bool get_single_index_view(
+    const Tensor& in,
+    TensorOptList indices,
+    SingleIndexView* view) {
+  size_t start = 0;
+  const Tensor* index = nullptr;
+  for (size_t i = 0; i < indices.size(); i++) {
+    if (indices[i].has_value()) {
+      if (index != nullptr) {
+        return false;
+      }
+      index = &indices[i].value();
+      start = i;
+    }
+  }
+  if (index == nullptr) {
+    return false;
+  }
+
+  // Indices before the only non-null one are null, so it applies to the dims
+  // starting at `start`.
+  const bool is_mask = is_mask_index(*index);
+  const size_t end = start + (is_mask ? index->dim() : 1);
+
+  view->index = index;
+  view->is_mask = is_mask;
+  view->leading = 1;
+  view->num_in_rows = 1;
+  view->row_size = 1;
+  for (size_t d = 0; d < start; d++) {
+    view->leading *= in.size(d);
+  }
+  for (size_t d = start; d < end; d++) {
+    view->num_in_rows *= in.size(d);
+  }
+  for (size_t d = end; d < in.dim(); d++) {
+    view->row_size *= in.size(d);
+  }
+  view->num_x_rows = is_mask ? count_trues_in_mask_index(*index)
+                             : static_cast<int64_t>(index->numel());
+  return true;
+}
+
+bool check_index_bounds(const Tensor& index, int64_t dim_size) {
+  if (index.scalar_type() == ScalarType::Int) {
+    const int32_t* const index_ptr = index.const_data_ptr<int32_t>();
+    for (size_t i = 0; i < index.numel(); ++i) {
+      ET_LOG_MSG_AND_RETURN_IF_FALSE(
+          index_ptr[i] >= -dim_size && index_ptr[i] < dim_size,
+          "Index %" PRId32 " is out of bounds for dimension with size %" PRId64,
+          index_ptr[i],
+          dim_size);
+    }
+  } else {
+    const int64_t* const index_ptr = index.const_data_ptr<int64_t>();
+    for (size_t i = 0; i < index.numel(); ++i) {
+      ET_LOG_MSG_AND_RETURN_IF_FALSE(
+          index_ptr[i] >= -dim_size && index_ptr[i] < dim_size,
+          "Index %" PRId64 " is out of bounds for dimension with size %" PRId64,
+          index_ptr[i],
+          dim_size);
+    }
+  }
+  return true;
+}
+
+int64_t count_mask_trues(const uint8_t* mask, int64_t begin, int64_t end) {
+  int64_t count = 0;
+  int64_t i = begin;
+  for (; i + 8 <= end; i += 8) {
+    uint64_t word;
+    memcpy(&word, mask + i, sizeof(word));
+    if (word == 0) {
+      continue;
+    }
+    for (int64_t j = 0; j < 8; ++j) {
+      count += mask[i + j] != 0;
+    }
+  }
+  for (; i < end; ++i) {
+    count += mask[i] != 0;
+  }
+  return count;
+}
+
 } // namespace executor
 } // namespace torch
@@ -8,6 +8,8 @@
 
 #pragma once
 
+#include <cstring>
+
 #include <executorch/runtime/kernel/kernel_includes.h>
 
 namespace torch {
@@ -127,5 +129,243 @@ std::pair<size_t, bool> get_in_ix(
     int32_t* dim_map,
     int32_t* ix_map);
 
+/**
+ * Calls `fn(x_ix, x_coord, in_ix)` for the elements [begin, end) of
+ * `x = in[indices]`, whose shape {x_sizes, x_ndim} is given by
+ * get_index_out_target_size(), in order. `x_coord` is the coordinate of flat
+ * index `x_ix` in x, and `in_ix` the flat index of the input element it maps
+ * to.
+ *
+ * The index maps and input strides are computed once per call, and x is
+ * walked with a running coordinate. Returns false if an index is out of
+ * bounds.
+ */
+template <typename Fn>
+bool apply_over_indexed_elements(
+    const Tensor& in,
+    TensorOptList indices,
+    const Tensor::SizesType* x_sizes,
+    size_t x_ndim,
+    size_t begin,
+    size_t end,
+    const Fn& fn) {
+  if (begin >= end) {
+    return true;
+  }
+  const size_t block_count = count_index_blocks(indices);
+  const bool adjacent = (block_count == 1);
+  const size_t start = adjacent ? get_num_leading_null_indices(indices) : 0;
+  const size_t bc_ndim = get_indices_broadcast_ndim(indices);
+
+  int32_t dim_map[kTensorDimensionLimit];
+  int32_t ix_map[kTensorDimensionLimit];
+  compute_dim_map(in, indices, dim_map, adjacent);
+  compute_index_map(in, indices, ix_map);
+
+  size_t in_strides[kTensorDimensionLimit];
+  for (size_t d = in.dim(); d > 0; --d) {
+    in_strides[d - 1] = d == in.dim() ? 1 : in_strides[d] * in.size(d);
+  }
+
+  size_t x_coord[kTensorDimensionLimit];
+  size_t in_coord[kTensorDimensionLimit];
+  for (size_t d = x_ndim, rem = begin; d > 0; --d) {
+    x_coord[d - 1] = rem % x_sizes[d - 1];
+    rem /= x_sizes[d - 1];
+  }
+  for (size_t x_ix = begin; x_ix < end; ++x_ix) {
+    if (!get_in_coord(
+            in, indices, start, bc_ndim, dim_map, ix_map, x_coord, in_coord)) {
+      return false;
+    }
+    size_t in_ix = 0;
+    for (size_t d = 0; d < in.dim(); ++d) {
+      in_ix += in_coord[d] * in_strides[d];
+    }
+    fn(x_ix, x_coord, in_ix);
+
+    // Advance the coordinate to the next element of x.
+    for (size_t d = x_ndim; d > 0; --d) {
+      if (++x_coord[d - 1] < static_cast<size_t>(x_sizes[d - 1])) {
+        break;
+      }
+      x_coord[d - 1] = 0;
+    }
+  }
+  return true;
+}
+
+/**
+ * Like the above, for every element of x.
+ */
+template <typename Fn>
+bool apply_over_indexed_elements(
+    const Tensor& in,
+    TensorOptList indices,
+    const Tensor::SizesType* x_sizes,
+    size_t x_ndim,
+    const Fn& fn) {
+  size_t x_numel = 1;
+  for (size_t d = 0; d < x_ndim; ++d) {
+    x_numel *= x_sizes[d];
+  }
+  return apply_over_indexed_elements(
+      in, indices, x_sizes, x_ndim, 0, x_numel, fn);
+}
+
+/**
+ * Describes an indexing whose only non-null index is a single integral or
+ * mask index. Viewing `in` as [leading, num_in_rows, row_size], where the
+ * middle dim spans the dims the index applies to, x = in[indices] is
+ * [leading, num_x_rows, row_size]: every x row is a whole input row.
+ */
+struct SingleIndexView {
+  const Tensor* index;
+  bool is_mask;
+  int64_t leading;
+  int64_t num_in_rows;
+  int64_t num_x_rows;
+  int64_t row_size;
+};
+
+/**
+ * Returns true and fills `view` if exactly one entry of `indices` is
+ * non-null. `indices` must have passed check_index_args().
+ */
+bool get_single_index_view(
+    const Tensor& in,
+    TensorOptList indices,
+    SingleIndexView* view);
+
+/**
+ * Checks that every value of integral `index` lies in [-dim_size, dim_size).
+ */
+bool check_index_bounds(const Tensor& index, int64_t dim_size);
+
+/**
+ * Counts the set bytes among bytes [begin, end) of a Bool or Byte mask,
+ * skipping over zero words a word at a time.
+ */
+int64_t count_mask_trues(const uint8_t* mask, int64_t begin, int64_t end);
+
+/// Returns `index_val` wrapped into [0, dim_size) if it is negative.
+template <typename CTYPE_IX>
+inline int64_t wrap_index(CTYPE_IX index_val, int64_t dim_size) {
+  const int64_t val = static_cast<int64_t>(index_val);
+  return val < 0 ? val + dim_size : val;
+}
+
+/**
+ * Copies the rows [begin, end) of x, flattened over its leading and row
+ * dims, for a SingleIndexView with an integral index whose values have been
+ * checked with check_index_bounds().
+ */
+template <typename CTYPE_IX>
+void gather_index_rows(
+    const char* in_data,
+    char* x_data,
+    const SingleIndexView& view,
+    size_t row_nbytes,
+    int64_t begin,
+    int64_t end) {
+  const CTYPE_IX* const index = view.index->const_data_ptr<CTYPE_IX>();
+  for (int64_t r = begin; r < end; ++r) {
+    const int64_t l = r / view.num_x_rows;
+    const int64_t j = r % view.num_x_rows;
+    const int64_t in_row =
+        l * view.num_in_rows + wrap_index(index[j], view.num_in_rows);
+    memcpy(x_data + r * row_nbytes, in_data + in_row * row_nbytes, row_nbytes);
+  }
+}
+
+/**
+ * For a SingleIndexView with a mask index, copies the input rows selected by
+ * mask bytes [mask_begin, mask_end) of every leading slice to x, starting at
+ * row `x_row_begin` of each slice.
+ */
+inline void gather_mask_rows(
+    const char* in_data,
+    char* x_data,
+    const SingleIndexView& view,
+    size_t row_nbytes,
+    int64_t mask_begin,
+    int64_t mask_end,
+    int64_t x_row_begin) {
+  const uint8_t* const mask =
+      static_cast<const uint8_t*>(view.index->const_data_ptr());
+  for (int64_t l = 0; l < view.leading; ++l) {
+    const char* const in_slice = in_data + l * view.num_in_rows * row_nbytes;
+    char* x_row =
+        x_data + (l * view.num_x_rows + x_row_begin) * row_nbytes;
+    for (int64_t i = mask_begin; i < mask_end; ++i) {
+      if (mask[i]) {
+        memcpy(x_row, in_slice + i * row_nbytes, row_nbytes);
+        x_row += row_nbytes;
+      }
+    }
+  }
+}
+
+/**
+ * Writes x = `values` back into the rows of `out` it was gathered from, for
+ * a SingleIndexView with an integral index checked with check_index_bounds().
+ * With `accumulate`, values are added to the rows instead, so repeated
+ * indices accumulate.
+ */
+template <typename CTYPE, typename CTYPE_IX>
+void scatter_index_rows(
+    const CTYPE* values,
+    CTYPE* out_data,
+    const SingleIndexView& view,
+    bool accumulate) {
+  const CTYPE_IX* const index = view.index->const_data_ptr<CTYPE_IX>();
+  const int64_t row_size = view.row_size;
+  for (int64_t l = 0; l < view.leading; ++l) {
+    CTYPE* const out_slice = out_data + l * view.num_in_rows * row_size;
+    for (int64_t j = 0; j < view.num_x_rows; ++j) {
+      CTYPE* const out_row =
+          out_slice + wrap_index(index[j], view.num_in_rows) * row_size;
+      if (accumulate) {
+        for (int64_t k = 0; k < row_size; ++k) {
+          out_row[k] += values[k];
+        }
+      } else {
+        memcpy(out_row, values, row_size * sizeof(CTYPE));
+      }
+      values += row_size;
+    }
+  }
+}
+
+/**
+ * Like scatter_index_rows(), for a SingleIndexView with a mask index.
+ */
+template <typename CTYPE>
+void scatter_mask_rows(
+    const CTYPE* values,
+    CTYPE* out_data,
+    const SingleIndexView& view,
+    bool accumulate) {
+  const uint8_t* const mask =
+      static_cast<const uint8_t*>(view.index->const_data_ptr());
+  const int64_t row_size = view.row_size;
+  for (int64_t l = 0; l < view.leading; ++l) {
+    CTYPE* out_row = out_data + l * view.num_in_rows * row_size;
+    for (int64_t i = 0; i < view.num_in_rows; ++i, out_row += row_size) {
+      if (!mask[i]) {
+        continue;
+      }
+      if (accumulate) {
+        for (int64_t k = 0; k < row_size; ++k) {
+          out_row[k] += values[k];
+        }
+      } else {
+        memcpy(out_row, values, row_size * sizeof(CTYPE));
+      }
+      values += row_size;
+    }
+  }
+}
+
 } // namespace executor
 } // namespace torch
@@ -7,6 +7,7 @@
  */
 
 #include <executorch/kernels/portable/cpu/scalar_utils.h>
+#include <executorch/kernels/portable/cpu/util/broadcast_util.h>
 #include <executorch/kernels/portable/cpu/util/repeat_util.h>
 #include <executorch/runtime/core/exec_aten/exec_aten.h>
 #include <executorch/runtime/core/exec_aten/util/scalar_type_util.h>
@@ -311,5 +312,35 @@ size_t linearize_access_indexes(
       broadcast_from.strides());
 }
 
+void make_broadcast_plan(
+    const Tensor& a,
+    const Tensor& b,
+    const Tensor& out,
+    BroadcastPlan* plan) {
+  plan->dim = out.dim();
+  plan->numel = out.numel();
+  plan->any_broadcast =
+      !out.sizes().equals(a.sizes()) || !out.sizes().equals(b.sizes());
+
+  for (size_t d = 0; d < plan->dim; ++d) {
+    plan->sizes[d] = out.size(d);
+    plan->a_strides[d] = 0;
+    plan->b_strides[d] = 0;
+  }
+  // Inputs with fewer dims are aligned with the trailing output dims.
+  const size_t a_skip = plan->dim - a.dim();
+  for (size_t d = 0; d < a.dim(); ++d) {
+    if (a.size(d) != 1) {
+      plan->a_strides[a_skip + d] = a.strides()[d];
+    }
+  }
+  const size_t b_skip = plan->dim - b.dim();
+  for (size_t d = 0; d < b.dim(); ++d) {
+    if (b.size(d) != 1) {
+      plan->b_strides[b_skip + d] = b.strides()[d];
+    }
+  }
+}
+
 } // namespace executor
 } // namespace torch
@@ -296,6 +296,84 @@ inline void apply_binary_elementwise_fn(
   }
 }
 
+/**
+ * How a binary elementwise operator walks its inputs for a given set of
+ * shapes. Built once by make_broadcast_plan(), e.g. when a kernel is prepared,
+ * so that the loop doesn't have to map each output index back to the inputs.
+ */
+struct BroadcastPlan {
+  /// Number of dims and elements of the output.
+  size_t dim;
+  size_t numel;
+  /// True if either input is broadcast. Otherwise all tensors are walked
+  /// linearly.
+  bool any_broadcast;
+  size_t sizes[kTensorDimensionLimit];
+  /// Element strides of the inputs along each output dim; 0 where the input
+  /// is broadcast.
+  size_t a_strides[kTensorDimensionLimit];
+  size_t b_strides[kTensorDimensionLimit];
+};
+
+/**
+ * Fills `plan` for broadcasting `a` and `b` to `out`, which must already have
+ * the broadcast target size.
+ */
+void make_broadcast_plan(
+    const Tensor& a,
+    const Tensor& b,
+    const Tensor& out,
+    BroadcastPlan* plan);
+
+/**
+ * Same as apply_binary_elementwise_fn() above, with the broadcasting described
+ * by a plan made for tensors of the same shapes as `a`, `b` and `out`.
+ */
+template <typename CTYPE_A, typename CTYPE_B, typename CTYPE_OUT, typename Op>
+inline void apply_binary_elementwise_fn(
+    const Op& compute_fun,
+    const BroadcastPlan& plan,
+    const Tensor& a,
+    const Tensor& b,
+    const Tensor& out) {
+  const CTYPE_A* const data_a = a.const_data_ptr<CTYPE_A>();
+  const CTYPE_B* const data_b = b.const_data_ptr<CTYPE_B>();
+  CTYPE_OUT* const data_out = out.mutable_data_ptr<CTYPE_OUT>();
+
+  if (!plan.any_broadcast) {
+    for (size_t i = 0; i < plan.numel; ++i) {
+      data_out[i] = compute_fun(data_a[i], data_b[i]);
+    }
+    return;
+  }
+
+  // Walk the innermost dim directly and carry the outer indexes like an
+  // odometer, updating the input offsets incrementally.
+  const size_t inner = plan.sizes[plan.dim - 1];
+  const size_t a_inner_stride = plan.a_strides[plan.dim - 1];
+  const size_t b_inner_stride = plan.b_strides[plan.dim - 1];
+  size_t indexes[kTensorDimensionLimit] = {0};
+  size_t a_offset = 0;
+  size_t b_offset = 0;
+  for (size_t i = 0; i < plan.numel; i += inner) {
+    for (size_t j = 0; j < inner; ++j) {
+      data_out[i + j] = compute_fun(
+          data_a[a_offset + j * a_inner_stride],
+          data_b[b_offset + j * b_inner_stride]);
+    }
+    for (size_t d = plan.dim - 1; d-- > 0;) {
+      a_offset += plan.a_strides[d];
+      b_offset += plan.b_strides[d];
+      if (++indexes[d] < plan.sizes[d]) {
+        break;
+      }
+      a_offset -= plan.a_strides[d] * plan.sizes[d];
+      b_offset -= plan.b_strides[d] * plan.sizes[d];
+      indexes[d] = 0;
+    }
+  }
+}
+
 /**
  * Useful for ternary elementwise operators. For each element of the inputs,
  * perform a computation and write to the corresponding element of the output.
@@ -119,6 +119,42 @@ bool dilation_is_valid(IntArrayRef dilation, size_t kernel_ndim) {
       "dilation", dilation, /*min_val=*/1, kernel_ndim, /*allow_empty=*/false);
 }
 
+bool output_padding_is_valid(
+    IntArrayRef output_padding,
+    IntArrayRef stride,
+    IntArrayRef dilation,
+    size_t kernel_ndim) {
+  bool valid = param_array_is_valid(
+      "output_padding",
+      output_padding,
+      /*min_val=*/0,
+      kernel_ndim,
+      /*allow_empty=*/true);
+  if (!valid) {
+    return false;
+  }
+
+  // Output padding must be smaller than either stride or dilation.
+  for (size_t i = 0; i < output_padding.size(); i++) {
+    const int64_t op_i = output_padding[i];
+    const int64_t s_i = val_at(stride, i);
+    const int64_t d_i = val_at(dilation, i, /*default_value=*/1);
+    if (op_i >= s_i && op_i >= d_i) {
+      ET_LOG(
+          Error,
+          "output_padding[%zu] = %" PRId64
+          " must be smaller than either stride = %" PRId64
+          " or dilation = %" PRId64,
+          i,
+          op_i,
+          s_i,
+          d_i);
+      return false;
+    }
+  }
+  return true;
+}
+
 bool output_size_is_valid(
     exec_aten::ArrayRef<exec_aten::SizesType> output_size,
     size_t kernel_ndim) {
@@ -304,10 +340,19 @@ bool check_convolution_args(
   ET_LOG_AND_RETURN_IF_FALSE(tensor_is_rank(weight, in.dim()));
   ET_LOG_AND_RETURN_IF_FALSE(tensor_is_rank(out, in.dim()));
 
+  // A transposed weight is laid out as {in_C, out_C / groups, kH, kW}.
   if (bias.has_value()) {
     ET_LOG_AND_RETURN_IF_FALSE(tensor_is_rank(bias.value(), 1));
-    ET_LOG_AND_RETURN_IF_FALSE(
-        tensors_have_same_size_at_dims(bias.value(), 0, weight, 0));
+    if (transposed) {
+      ET_LOG_MSG_AND_RETURN_IF_FALSE(
+          bias.value().size(0) == weight.size(1) * groups,
+          "Expected bias to have %" PRId64 " elements but got %zd",
+          static_cast<int64_t>(weight.size(1)) * groups,
+          bias.value().size(0));
+    } else {
+      ET_LOG_AND_RETURN_IF_FALSE(
+          tensors_have_same_size_at_dims(bias.value(), 0, weight, 0));
+    }
   }
 
   int64_t kernel_size[2];
@@ -331,24 +376,35 @@ bool check_convolution_args(
       groups,
       in.size(1));
 
-  ET_LOG_MSG_AND_RETURN_IF_FALSE(
-      !transposed, "transposed convolution not supported yet.");
+  if (transposed) {
+    ET_LOG_AND_RETURN_IF_FALSE(
+        tensors_have_same_size_at_dims(in, 1, weight, 0));
+    ET_LOG_AND_RETURN_IF_FALSE(
+        output_padding_is_valid(output_padding, stride, dilation, kernel_ndim));
+  }
 
   return true;
 }
 
-void get_convolution_out_target_size(
+bool get_convolution_out_target_size(
     const Tensor& in,
     const Tensor& weight,
     IntArrayRef stride,
     IntArrayRef padding,
     IntArrayRef dilation,
+    bool transposed,
+    IntArrayRef output_padding,
+    int64_t groups,
     exec_aten::SizesType* out_sizes,
     size_t* out_ndim) {
   *out_ndim = in.dim();
 
   out_sizes[0] = in.size(0);
-  out_sizes[1] = in.size(1) == 0 ? 0 : weight.size(0);
+  if (transposed) {
+    out_sizes[1] = in.size(1) == 0 ? 0 : weight.size(1) * groups;
+  } else {
+    out_sizes[1] = in.size(1) == 0 ? 0 : weight.size(0);
+  }
 
   int64_t kernel_size[2];
   size_t kernel_ndim = 2;
@@ -359,6 +415,23 @@ void get_convolution_out_target_size(
     kernel_size[0] = weight.size(2);
     kernel_size[1] = weight.size(3);
   }
+  if (transposed) {
+    for (size_t i = 0; i < kernel_ndim; ++i) {
+      const size_t d = in.dim() - kernel_ndim + i;
+      const int64_t out_size = (in.size(d) - 1) * val_at(stride, i) -
+          2 * val_at(padding, i, /*default_value=*/0) +
+          val_at(dilation, i, /*default_value=*/1) * (kernel_size[i] - 1) +
+          val_at(output_padding, i, /*default_value=*/0) + 1;
+      ET_LOG_MSG_AND_RETURN_IF_FALSE(
+          out_size > 0,
+          "Transposed convolution output size %" PRId64
+          " for dim %zu is not positive",
+          out_size,
+          d);
+      out_sizes[d] = static_cast<exec_aten::SizesType>(out_size);
+    }
+    return true;
+  }
   calculate_kernel_output_sizes(
       in,
       kernel_ndim,
@@ -368,6 +441,7 @@ void get_convolution_out_target_size(
       dilation,
       out_sizes,
       false);
+  return true;
 }
 
 bool check_max_pool2d_with_indices_args(
@@ -37,6 +37,12 @@ bool padding_is_valid(
 
 bool dilation_is_valid(IntArrayRef dilation, size_t kernel_ndim);
 
+bool output_padding_is_valid(
+    IntArrayRef output_padding,
+    IntArrayRef stride,
+    IntArrayRef dilation,
+    size_t kernel_ndim);
+
 bool output_size_is_valid(
     exec_aten::ArrayRef<exec_aten::SizesType> output_size,
     size_t kernel_ndim);
@@ -401,12 +407,15 @@ bool check_convolution_args(
     int64_t groups,
     Tensor& out);
 
-void get_convolution_out_target_size(
+bool get_convolution_out_target_size(
     const Tensor& in,
     const Tensor& weight,
     IntArrayRef stride,
     IntArrayRef padding,
     IntArrayRef dilation,
+    bool transposed,
+    IntArrayRef output_padding,
+    int64_t groups,
     exec_aten::SizesType* out_sizes,
     size_t* out_ndim);
 
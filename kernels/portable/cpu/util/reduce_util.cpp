@@ -313,5 +313,21 @@ Error resize_reduction_out(
   return resize_tensor(out, out_size);
 }
 
+bool check_cumulative_args(
+    const Tensor& in,
+    int64_t dim,
+    const exec_aten::optional<ScalarType>& dtype,
+    Tensor& out) {
+  ET_LOG_AND_RETURN_IF_FALSE(tensor_has_dim(in, dim));
+  if (dtype.has_value()) {
+    ET_LOG_MSG_AND_RETURN_IF_FALSE(
+        dtype.value() == out.scalar_type(),
+        "dtype %s must be equal to the dtype of out %s",
+        toString(dtype.value()),
+        toString(out.scalar_type()));
+  }
+  return true;
+}
+
 } // namespace executor
 } // namespace torch
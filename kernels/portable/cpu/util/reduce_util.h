@@ -592,5 +592,19 @@ Error resize_reduction_out(
     bool keepdim,
     exec_aten::Tensor& out);
 
+//
+// Arg checks for cumulative ops, which scan along a single dim
+//
+
+/**
+ * Checks the arguments of cumsum.out and cumprod.out. `dtype`, if set, must
+ * be the dtype of `out`, which the input is cast to before scanning.
+ */
+bool check_cumulative_args(
+    const exec_aten::Tensor& in,
+    int64_t dim,
+    const exec_aten::optional<exec_aten::ScalarType>& dtype,
+    exec_aten::Tensor& out);
+
 } // namespace executor
 } // namespace torch
@@ -6,8 +6,10 @@
  * LICENSE file in the root directory of this source tree.
  */
 
+#include <algorithm>
 #include <cstring>
 
+#include <executorch/kernels/portable/cpu/util/strided_copy_util.h>
 #include <executorch/runtime/core/exec_aten/exec_aten.h>
 #include <executorch/runtime/core/exec_aten/util/scalar_type_util.h>
 #include <executorch/runtime/core/exec_aten/util/tensor_util.h>
@@ -75,88 +77,105 @@ void check_repeat_args(
   }
 }
 
-// Given the indices to a point in an n-D tensor, and the stride (in bytes)
-// along each dimension, return the offset from origin to that point.
-size_t compute_access_offset(
-    const size_t* indices,
-    const size_t* strides,
-    size_t num_entries) {
-  size_t offset = 0;
-  for (int i = num_entries - 1; i >= 0; --i) {
-    // @lint-ignore CLANGTIDY indices and strides share same length.
-    offset += indices[i] * strides[i];
+// Sizes of self padded with leading ones to the rank of out, the repeats
+// along each dim, and the element strides of both.
+struct RepeatShape {
+  size_t ndim;
+  size_t element_size;
+  int64_t self_sizes[kTensorDimensionLimit];
+  int64_t self_strides[kTensorDimensionLimit];
+  int64_t repeats[kTensorDimensionLimit];
+  int64_t out_strides[kTensorDimensionLimit];
+};
+
+// Copies the `block_nbytes` bytes at `data` until `num_blocks` copies of them
+// lie back to back, doubling the number of copies with each memcpy.
+void replicate_block(char* data, size_t block_nbytes, int64_t num_blocks) {
+  for (int64_t filled = 1; filled < num_blocks;) {
+    const int64_t num_copied = std::min(filled, num_blocks - filled);
+    memcpy(data + filled * block_nbytes, data, num_copied * block_nbytes);
+    filled += num_copied;
   }
-  return offset;
 }
 
-// Copy an self array to multiple coordinates of the out tensor.
-//'in_offset' identifies the offset to the source data in self tensor.
-//'out_offset' identifies the offset in out tensor where the source data
-// should be copied.
-//'strides' indicates the stride along each dimension of the out tensor.
-void repeat_internal(
-    const Tensor& self,
-    Tensor& out,
-    size_t in_offset,
-    size_t out_offset,
-    const size_t* strides) {
-  const char* src = self.const_data_ptr<char>() + in_offset;
-  char* dest = out.mutable_data_ptr<char>() + out_offset;
-
-  // Treats zero-dim self as one-dim tensor with size {1}.
-  ssize_t self_dim = self.dim() ? self.dim() : 1;
-  int32_t one = 1;
-  exec_aten::ArrayRef<int32_t> self_size =
-      self.dim() ? self.sizes() : exec_aten::ArrayRef<int32_t>(&one, 1);
-
-  // Get the size of the array in bytes.
-  size_t num_bytes = self_size[self_dim - 1] * out.element_size();
-  if (num_bytes == 0) {
-    return;
+// Fills a slab of out spanning dims [dim, ndim) that fits in cache. The
+// matching slab of self is copied to the slab's origin first, and then
+// replicated along each dim, innermost first. Once every dim after d has been
+// replicated, each index of the dims before d (within self's sizes) starts a
+// contiguous block of self_sizes[d] * out_strides[d] elements that fills its
+// first slot along d, and is copied into the remaining slots.
+void repeat_block(
+    const char* self_data,
+    char* out_data,
+    const RepeatShape& shape,
+    size_t dim) {
+  const size_t ndim = shape.ndim - dim;
+  const size_t element_size = shape.element_size;
+  const int64_t* const self_sizes = shape.self_sizes + dim;
+  const int64_t* const repeats = shape.repeats + dim;
+  const int64_t* const out_strides = shape.out_strides + dim;
+
+  strided_copy(
+      out_data,
+      out_strides,
+      self_data,
+      shape.self_strides + dim,
+      self_sizes,
+      ndim,
+      element_size);
+
+  int64_t sizes[kTensorDimensionLimit];
+  int64_t strides[kTensorDimensionLimit];
+  std::copy(self_sizes, self_sizes + ndim, sizes);
+  std::copy(out_strides, out_strides + ndim, strides);
+  for (size_t i = ndim; i > 0; --i) {
+    const size_t d = i - 1;
+    const int64_t block = self_sizes[d] * out_strides[d];
+    strides[d] = 1;
+    for (int64_t filled = 1; filled < repeats[d];) {
+      const int64_t num_copied = std::min(filled, repeats[d] - filled);
+      sizes[d] = num_copied * block;
+      strided_copy(
+          out_data + filled * block * element_size,
+          strides,
+          out_data,
+          strides,
+          sizes,
+          d + 1,
+          element_size);
+      filled += num_copied;
+    }
   }
+}
 
-  // Visualize the out tensor as a set of 1D arrays. Given an n-dimensional
-  // out X[d0, d1, ..., d{N-2}, d{N-1}], we can view the out as a tensor
-  // X'[d0, d1, ..., d{N-2}, 1], where each point is a array of length
-  // size(d{N-1}). Below is the strategy to iterate over the relevant points in
-  // X'. We create an n-D slot array, where each index corresponds to a
-  // dimension of X'. A valid value of slot array is one which corresponds to
-  // a data point in X'.
-  size_t slots[kTensorDimensionLimit];
-  memset(slots, 0, self_dim * sizeof(slots[0]));
-
-  // The increment along index of slot array to reach the next possible valid
-  // value.
-  int64_t incr[kTensorDimensionLimit];
-  for (size_t i = 0; i < self_dim; i++) {
-    incr[i] = self_size[i];
+// Fills the slab of out spanning dims [dim, ndim). Slabs whose sub-slabs
+// along `dim` are themselves larger than a block are built in order along
+// `dim`: each sub-slab matching one index of self is filled in turn, and the
+// whole run of them is then replicated.
+void repeat_slab(
+    const char* self_data,
+    char* out_data,
+    const RepeatShape& shape,
+    size_t dim) {
+  const size_t element_size = shape.element_size;
+  if (dim == shape.ndim ||
+      shape.out_strides[dim] * element_size < kStridedCopyBlockBytes) {
+    repeat_block(self_data, out_data, shape, dim);
+    return;
   }
 
-  // And now copy the self data to possibly multiple points in the out
-  // tensor. Note that if the self is n-dimensional tensor, we limit copying
-  // to only n dimensions in out tensor (out can be higher-dimensional
-  // than self).
-  size_t index = self_dim - 1;
-  size_t start = out.dim() - self_dim;
-  while (slots[0] != out.size(start)) {
-    // Compute the offset (from origin) in the out tensor where this self
-    // data will be copied to.
-    size_t offset = compute_access_offset(slots, strides, self_dim);
-    memcpy(dest + offset, src, num_bytes);
-
-    // Find the next valid value of slot array.
-    slots[index] += incr[index];
-    // If we have reached the limit in the innermost dimension, successively
-    // increment the slot index of outer dimensions.
-    while (slots[index] == out.size(start + index)) {
-      if (index == 0) {
-        break;
-      }
-      slots[index--] = 0;
-      slots[index] += incr[index];
-    }
-    index = self_dim - 1;
+  const int64_t out_step = shape.out_strides[dim];
+  for (int64_t i = 0; i < shape.self_sizes[dim]; ++i) {
+    repeat_slab(
+        self_data + i * shape.self_strides[dim] * element_size,
+        out_data + i * out_step * element_size,
+        shape,
+        dim + 1);
   }
+  replicate_block(
+      out_data,
+      shape.self_sizes[dim] * out_step * element_size,
+      shape.repeats[dim]);
 }
 
 } // namespace
@@ -175,104 +194,26 @@ Tensor& repeat_tensor(
     return out;
   }
 
-  ssize_t element_size = out.element_size();
-
-  // The underlying data of tensor out shall equal tensor self.
-  // Treats it specially to circumvent zero-dim tensor issue.
-  if (out.numel() == 1) {
-    const char* src = self.const_data_ptr<char>();
-    char* dest = out.mutable_data_ptr<char>();
-    memcpy(dest, src, element_size);
-    return out;
-  }
-
-  // Treats zero-dim self as one-dim tensor with size {1}.
-  ssize_t self_dim = self.dim() ? self.dim() : 1;
-  int32_t one = 1;
-  exec_aten::ArrayRef<int32_t> self_size = self.sizes().empty()
-      ? exec_aten::ArrayRef<int32_t>(&one, 1)
-      : self.sizes();
-
-  // Compute the stride (in bytes) along each out tensor dimension.
-  size_t strides[kTensorDimensionLimit];
-  memset(strides, 0, sizeof(strides[0]) * self_dim);
-  size_t start = out.dim() - self_dim;
-  size_t accum_offset = element_size;
-
-  for (ssize_t i = self_dim - 1; i >= 0; i--) {
-    strides[i] = accum_offset;
-    accum_offset *= out.size(start + i);
+  // View self as a tensor of the same rank as out by padding its sizes with
+  // leading ones.
+  RepeatShape shape;
+  shape.ndim = out.dim();
+  shape.element_size = out.element_size();
+  const size_t start = shape.ndim - self.dim();
+  int64_t self_stride = 1;
+  int64_t out_stride = 1;
+  for (size_t i = shape.ndim; i > 0; --i) {
+    const size_t d = i - 1;
+    shape.self_sizes[d] = d < start ? 1 : self.size(d - start);
+    shape.self_strides[d] = self_stride;
+    shape.repeats[d] = repeats[d];
+    shape.out_strides[d] = out_stride;
+    self_stride *= shape.self_sizes[d];
+    out_stride *= out.size(d);
   }
 
-  // Given an n-dimensional self X[d0, d1, ..., d{N-2}, d{N-1}], we can view
-  // the self as a tensor X'[d0, d1, ..., d{N-2}, 1], where each point is a
-  // 1D array of length size(d{N-1}). Now we need a strategy to iterate over
-  // all the points in X'. We do not want to use getLeadingDims(), as we want
-  // to know the indices explicitly so that we can compute the appropriate
-  // offset for both self and out tensor at that index. To achieve this,
-  // we create an n-D slot array, where each index corresponds to a dimension
-  // of X'. A valid value of slot array is the one that corresponds to a
-  // valid index in X'.
-  size_t slots[kTensorDimensionLimit];
-  memset(slots, 0, self_dim * sizeof(slots[0]));
-
-  // 'limits' indicates the upper bound on each index in slot. Note that we
-  // copy the entire array along the innermost dimension as a direct memcpy,
-  // so we reset the upper bound of innermost dim to 1. 'in_incr' indicates
-  // the size (in bytes) of the self data.
-  int64_t limits[kTensorDimensionLimit];
-  for (size_t i = 0; i < self_dim; i++) {
-    limits[i] = self_size[i];
-  }
-
-  // @lint-ignore CLANGTIDY Here limits is guaranteend a non-empty array.
-  size_t in_incr = limits[self_dim - 1] * element_size;
-  limits[self_dim - 1] = 1;
-  // 'in_offset' indicates the offset (in bytes) from the origin to an self
-  // data.
-  size_t in_offset = 0;
-  size_t index = self_dim - 1;
-
-  // Below, we copy the entire self tensor into the out tensor (at origin),
-  // one array a time. To do so, we iterate over all the valid values of slots
-  // array. The repeat_internal() takes care of replicating the array along the
-  // coordinates specified by repeats array.
-  while (slots[0] != limits[0]) {
-    // Compute the offset (from origin) in the out tensor where the self
-    // array (with indices in self tensor indicated by slots) will be copied.
-    size_t out_offset = compute_access_offset(slots, strides, self_dim);
-    // Now repeatedly copy the array to multiple coordinates in the out
-    // tensor. Curtail the copy along as many dimensions as the self tensor.
-    // The copy along remaining higher dimensions can be done via trivial
-    // memcpy.
-    repeat_internal(self, out, in_offset, out_offset, strides);
-
-    // Find the next valid value of slot array
-    slots[index]++;
-    // If we have reached the limit in the innermost dimension, successively
-    // increment the slot index of outer dimensions.
-    while (slots[index] == limits[index]) {
-      if (index == 0) {
-        break;
-      }
-      slots[index--] = 0;
-      slots[index]++;
-    }
-    index = self_dim - 1;
-    in_offset += in_incr;
-  }
-
-  // And now if an n-D self was meant to be replicated to m dimensions where
-  // m>n, we can just do simple memcpy for (m-n) dimensions.
-  const char* src = out.const_data_ptr<char>();
-  char* dest = out.mutable_data_ptr<char>() + accum_offset;
-  for (int i = start - 1; i >= 0; --i) {
-    for (int j = 0; j < repeats[i] - 1; ++j) {
-      memcpy(dest, src, accum_offset);
-      dest += accum_offset;
-    }
-    accum_offset *= out.size(i);
-  }
+  repeat_slab(
+      self.const_data_ptr<char>(), out.mutable_data_ptr<char>(), shape, 0);
 
   return out;
 }
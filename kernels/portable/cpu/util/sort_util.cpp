@@ -0,0 +1,72 @@
+/*
+ * Copyright (c) Meta Platforms, Inc. and affiliates.
+ * All rights reserved.
+ *
+ * This source code is licensed under the BSD-style license found in the
+ * LICENSE file in the root directory of this source tree.
+ */
+
+#include <cinttypes>
+
+#include <executorch/kernels/portable/cpu/util/sort_util.h>
+
+namespace torch {
+namespace executor {
+
+bool check_sort_args(
+    const Tensor& in,
+    int64_t dim,
+    const Tensor& values,
+    const Tensor& indices) {
+  ET_LOG_AND_RETURN_IF_FALSE(tensors_have_same_dtype(in, values));
+  ET_LOG_MSG_AND_RETURN_IF_FALSE(
+      indices.scalar_type() == ScalarType::Long,
+      "indices must have dtype Long, got %s",
+      toString(indices.scalar_type()));
+  ET_LOG_AND_RETURN_IF_FALSE(tensor_has_dim(in, dim));
+  return true;
+}
+
+bool check_topk_args(
+    const Tensor& in,
+    int64_t k,
+    int64_t dim,
+    const Tensor& values,
+    const Tensor& indices) {
+  ET_LOG_AND_RETURN_IF_FALSE(check_sort_args(in, dim, values, indices));
+  if (dim < 0) {
+    dim += nonzero_dim(in);
+  }
+  ET_LOG_MSG_AND_RETURN_IF_FALSE(
+      k >= 0 && k <= nonempty_size(in, dim),
+      "k %" PRId64 " is out of range for dimension with size %zd",
+      k,
+      nonempty_size(in, dim));
+  return true;
+}
+
+void transpose_positions_complemented(
+    int64_t* data,
+    int64_t rows,
+    int64_t cols) {
+  const int64_t total = rows * cols;
+  for (int64_t start = 0; start < total; ++start) {
+    if (data[start] < 0) {
+      continue;
+    }
+    // Move the value at `pos` to its place in the transpose, and carry on
+    // with the value it displaces until the cycle is back at `start`.
+    int64_t pos = start;
+    int64_t value = data[start];
+    do {
+      const int64_t dst = (pos % cols) * rows + pos / cols;
+      const int64_t displaced = data[dst];
+      data[dst] = ~value;
+      value = displaced;
+      pos = dst;
+    } while (pos != start);
+  }
+}
+
+} // namespace executor
+} // namespace torch
@@ -0,0 +1,245 @@
+/*
+ * Copyright (c) Meta Platforms, Inc. and affiliates.
+ * All rights reserved.
+ *
+ * This source code is licensed under the BSD-style license found in the
+ * LICENSE file in the root directory of this source tree.
+ */
+
+#pragma once
+
+// Row-wise ordering shared by the sort and topk ops.
+//
+// A contiguous input ordered along one dim is viewed as [outer, n, inner],
+// i.e. outer * inner rows of n elements that are `inner` apart. Each row is
+// ordered as a list of positions along the dim, and the outputs are then
+// gathered from those positions.
+//
+// Kernels cannot allocate scratch memory, so the positions of a row are
+// computed in the indices output itself: row (o, c) writes its k positions
+// contiguously at block o * inner + c, which leaves every outer slice of the
+// indices laid out as [inner, k]. finish_ordered_slices() then transposes
+// each slice in place to the [k, inner] layout of the output and gathers the
+// values.
+
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+
+#include <executorch/runtime/kernel/kernel_includes.h>
+
+namespace torch {
+namespace executor {
+
+/**
+ * Checks the arguments of sort.values and sort.values_stable.
+ */
+bool check_sort_args(
+    const Tensor& in,
+    int64_t dim,
+    const Tensor& values,
+    const Tensor& indices);
+
+/**
+ * Checks the arguments of topk.values.
+ */
+bool check_topk_args(
+    const Tensor& in,
+    int64_t k,
+    int64_t dim,
+    const Tensor& values,
+    const Tensor& indices);
+
+/**
+ * Returns whether `a` comes before `b` in ascending order, or in descending
+ * order if `descending` is set. NaN is greater than every other value, as in
+ * ATen, and NaNs compare equal.
+ */
+template <typename CTYPE>
+inline bool sorts_before(CTYPE a, CTYPE b, bool descending) {
+  if (descending) {
+    return a > b || (std::isnan(a) && !std::isnan(b));
+  }
+  return a < b || (!std::isnan(a) && std::isnan(b));
+}
+
+/**
+ * Orders the positions of a row of `n` elements that are `stride` apart.
+ * With `break_ties`, equal elements are ordered by position, so that the
+ * result is that of a stable sort.
+ */
+template <typename CTYPE>
+class RowOrder {
+ public:
+  RowOrder(const CTYPE* row, int64_t stride, bool descending, bool break_ties)
+      : row_(row),
+        stride_(stride),
+        descending_(descending),
+        break_ties_(break_ties) {}
+
+  bool operator()(int64_t a, int64_t b) const {
+    const CTYPE va = row_[a * stride_];
+    const CTYPE vb = row_[b * stride_];
+    if (sorts_before(va, vb, descending_)) {
+      return true;
+    }
+    if (!break_ties_ || sorts_before(vb, va, descending_)) {
+      return false;
+    }
+    return a < b;
+  }
+
+ private:
+  const CTYPE* row_;
+  int64_t stride_;
+  bool descending_;
+  bool break_ties_;
+};
+
+/**
+ * Writes the positions of the `n` elements of a row, `stride` apart, to
+ * `order` in sorted order.
+ */
+template <typename CTYPE>
+void sort_row(
+    const CTYPE* row,
+    int64_t stride,
+    int64_t n,
+    bool descending,
+    bool stable,
+    int64_t* order) {
+  for (int64_t i = 0; i < n; ++i) {
+    order[i] = i;
+  }
+  std::sort(order, order + n, RowOrder<CTYPE>(row, stride, descending, stable));
+}
+
+/**
+ * Writes the positions of the `k` largest elements of a row, or the
+ * smallest unless `largest` is set, to `order`, in order if `sorted` is set.
+ * Equal elements are selected and ordered by position.
+ *
+ * The candidates are kept in a heap in `order` whose root is the one that
+ * would be output last, so each element costs one comparison unless it
+ * displaces the root.
+ */
+template <typename CTYPE>
+void select_top_k(
+    const CTYPE* row,
+    int64_t stride,
+    int64_t n,
+    int64_t k,
+    bool largest,
+    bool sorted,
+    int64_t* order) {
+  if (k == 0) {
+    return;
+  }
+  const RowOrder<CTYPE> before(row, stride, largest, /*break_ties=*/true);
+  for (int64_t i = 0; i < k; ++i) {
+    order[i] = i;
+  }
+  std::make_heap(order, order + k, before);
+  for (int64_t i = k; i < n; ++i) {
+    if (before(i, order[0])) {
+      std::pop_heap(order, order + k, before);
+      order[k - 1] = i;
+      std::push_heap(order, order + k, before);
+    }
+  }
+  if (sorted) {
+    std::sort_heap(order, order + k, before);
+  }
+}
+
+/**
+ * Sorts the rows [begin, end) of the [outer, n, inner] view of `in`,
+ * writing the positions of row r to indices + r * n.
+ */
+template <typename CTYPE>
+void sort_rows(
+    const CTYPE* in,
+    int64_t n,
+    int64_t inner,
+    bool descending,
+    bool stable,
+    int64_t begin,
+    int64_t end,
+    int64_t* indices) {
+  for (int64_t r = begin; r < end; ++r) {
+    const CTYPE* const row = in + (r / inner) * n * inner + r % inner;
+    sort_row(row, inner, n, descending, stable, indices + r * n);
+  }
+}
+
+/**
+ * Selects the top `k` elements of the rows [begin, end) of the
+ * [outer, n, inner] view of `in`, writing the positions of row r to
+ * indices + r * k.
+ */
+template <typename CTYPE>
+void select_top_k_rows(
+    const CTYPE* in,
+    int64_t n,
+    int64_t inner,
+    int64_t k,
+    bool largest,
+    bool sorted,
+    int64_t begin,
+    int64_t end,
+    int64_t* indices) {
+  for (int64_t r = begin; r < end; ++r) {
+    const CTYPE* const row = in + (r / inner) * n * inner + r % inner;
+    select_top_k(row, inner, n, k, largest, sorted, indices + r * k);
+  }
+}
+
+/**
+ * Transposes the non-negative values of a contiguous [rows, cols] matrix in
+ * place into a [cols, rows] matrix, following each cycle of the permutation
+ * once. Values are complemented when they are placed, which marks the
+ * cycles already followed without any scratch memory, and must be
+ * complemented back afterwards.
+ */
+void transpose_positions_complemented(
+    int64_t* data,
+    int64_t rows,
+    int64_t cols);
+
+/**
+ * Finishes the outer slices [begin, end) of sort or topk outputs whose
+ * indices were written by sort_rows() or select_top_k_rows(): moves each
+ * slice of `indices` to the [k, inner] layout of the output and gathers the
+ * corresponding elements of `in` into `values`.
+ */
+template <typename CTYPE>
+void finish_ordered_slices(
+    const CTYPE* in,
+    int64_t n,
+    int64_t inner,
+    int64_t k,
+    int64_t begin,
+    int64_t end,
+    CTYPE* values,
+    int64_t* indices) {
+  for (int64_t o = begin; o < end; ++o) {
+    const CTYPE* const in_slice = in + o * n * inner;
+    CTYPE* const values_slice = values + o * k * inner;
+    int64_t* const indices_slice = indices + o * k * inner;
+    if (inner == 1) {
+      for (int64_t j = 0; j < k; ++j) {
+        values_slice[j] = in_slice[indices_slice[j]];
+      }
+      continue;
+    }
+    transpose_positions_complemented(indices_slice, inner, k);
+    for (int64_t i = 0; i < k * inner; ++i) {
+      const int64_t pos = ~indices_slice[i];
+      indices_slice[i] = pos;
+      values_slice[i] = in_slice[pos * inner + i % inner];
+    }
+  }
+}
+
+} // namespace executor
+} // namespace torch
@@ -0,0 +1,181 @@
+/*
+ * Copyright (c) Meta Platforms, Inc. and affiliates.
+ * All rights reserved.
+ *
+ * This source code is licensed under the BSD-style license found in the
+ * LICENSE file in the root directory of this source tree.
+ */
+
+#include <cstring>
+
+#include <executorch/kernels/portable/cpu/util/strided_copy_util.h>
+
+namespace torch {
+namespace executor {
+namespace internal {
+
+bool make_strided_runs(
+    const int64_t* dst_strides,
+    const int64_t* src_strides,
+    const int64_t* sizes,
+    size_t ndim,
+    StridedRuns& runs) {
+  ET_CHECK_MSG(
+      ndim <= kTensorDimensionLimit,
+      "Strided copy of %zu dims exceeds the limit of %zu",
+      ndim,
+      kTensorDimensionLimit);
+
+  // Merge from the innermost dim outwards. `merged` holds the finished dims,
+  // innermost first; `cur_*` is the dim currently being grown.
+  int64_t merged_sizes[kTensorDimensionLimit];
+  int64_t merged_dst_strides[kTensorDimensionLimit];
+  int64_t merged_src_strides[kTensorDimensionLimit];
+  size_t num_merged = 0;
+
+  int64_t cur_size = 1;
+  int64_t cur_dst_stride = 1;
+  int64_t cur_src_stride = 1;
+  bool have_cur = false;
+
+  for (size_t i = ndim; i > 0; --i) {
+    const size_t d = i - 1;
+    if (sizes[d] == 0) {
+      return false;
+    }
+    if (sizes[d] == 1) {
+      continue;
+    }
+    if (!have_cur) {
+      cur_size = sizes[d];
+      cur_dst_stride = dst_strides[d];
+      cur_src_stride = src_strides[d];
+      have_cur = true;
+    } else if (
+        dst_strides[d] == cur_dst_stride * cur_size &&
+        src_strides[d] == cur_src_stride * cur_size) {
+      cur_size *= sizes[d];
+    } else {
+      merged_sizes[num_merged] = cur_size;
+      merged_dst_strides[num_merged] = cur_dst_stride;
+      merged_src_strides[num_merged] = cur_src_stride;
+      ++num_merged;
+      cur_size = sizes[d];
+      cur_dst_stride = dst_strides[d];
+      cur_src_stride = src_strides[d];
+    }
+  }
+
+  // The innermost merged dim is the run; the remaining ones, ending with the
+  // one still in `cur_*`, are stored outermost first.
+  if (num_merged == 0) {
+    runs.outer_ndim = 0;
+    runs.run_size = cur_size;
+    runs.run_dst_stride = cur_dst_stride;
+    runs.run_src_stride = cur_src_stride;
+    return true;
+  }
+  runs.run_size = merged_sizes[0];
+  runs.run_dst_stride = merged_dst_strides[0];
+  runs.run_src_stride = merged_src_strides[0];
+
+  runs.outer_ndim = num_merged;
+  runs.sizes[0] = cur_size;
+  runs.dst_strides[0] = cur_dst_stride;
+  runs.src_strides[0] = cur_src_stride;
+  for (size_t i = 1; i < num_merged; ++i) {
+    runs.sizes[i] = merged_sizes[num_merged - i];
+    runs.dst_strides[i] = merged_dst_strides[num_merged - i];
+    runs.src_strides[i] = merged_src_strides[num_merged - i];
+  }
+  return true;
+}
+
+} // namespace internal
+
+namespace {
+
+template <typename T>
+void copy_strided_elements(
+    char* dst,
+    int64_t dst_step,
+    const char* src,
+    int64_t src_step,
+    int64_t n) {
+  T* const out = reinterpret_cast<T*>(dst);
+  const T* const in = reinterpret_cast<const T*>(src);
+  for (int64_t i = 0; i < n; ++i) {
+    out[i * dst_step] = in[i * src_step];
+  }
+}
+
+} // namespace
+
+void strided_copy(
+    void* dst,
+    const int64_t* dst_strides,
+    const void* src,
+    const int64_t* src_strides,
+    const int64_t* sizes,
+    size_t ndim,
+    size_t element_size) {
+  internal::StridedRuns runs;
+  if (!internal::make_strided_runs(
+          dst_strides, src_strides, sizes, ndim, runs)) {
+    return;
+  }
+  char* const out = static_cast<char*>(dst);
+  const char* const in = static_cast<const char*>(src);
+  const int64_t n = runs.run_size;
+  const int64_t dst_step = runs.run_dst_stride;
+  const int64_t src_step = runs.run_src_stride;
+
+  if (dst_step == 1 && src_step == 1) {
+    const size_t run_nbytes = n * element_size;
+    internal::for_each_strided_run(
+        runs, [&](int64_t dst_offset, int64_t src_offset) {
+          std::memcpy(
+              out + dst_offset * element_size,
+              in + src_offset * element_size,
+              run_nbytes);
+        });
+    return;
+  }
+
+  // The views share no contiguous innermost dim, e.g. a transposed or
+  // broadcast source, so copy element by element.
+  internal::for_each_strided_run(
+      runs, [&](int64_t dst_offset, int64_t src_offset) {
+        char* const run_out = out + dst_offset * element_size;
+        const char* const run_in = in + src_offset * element_size;
+        switch (element_size) {
+          case 1:
+            copy_strided_elements<uint8_t>(
+                run_out, dst_step, run_in, src_step, n);
+            break;
+          case 2:
+            copy_strided_elements<uint16_t>(
+                run_out, dst_step, run_in, src_step, n);
+            break;
+          case 4:
+            copy_strided_elements<uint32_t>(
+                run_out, dst_step, run_in, src_step, n);
+            break;
+          case 8:
+            copy_strided_elements<uint64_t>(
+                run_out, dst_step, run_in, src_step, n);
+            break;
+          default:
+            for (int64_t i = 0; i < n; ++i) {
+              std::memcpy(
+                  run_out + i * dst_step * element_size,
+                  run_in + i * src_step * element_size,
+                  element_size);
+            }
+            break;
+        }
+      });
+}
+
+} // namespace executor
+} // namespace torch
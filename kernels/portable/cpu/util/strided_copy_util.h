@@ -0,0 +1,194 @@
+/*
+ * Copyright (c) Meta Platforms, Inc. and affiliates.
+ * All rights reserved.
+ *
+ * This source code is licensed under the BSD-style license found in the
+ * LICENSE file in the root directory of this source tree.
+ */
+
+#pragma once
+
+// Block copies between strided views, shared by the data movement ops (cat,
+// stack, split, repeat, constant_pad_nd, ...).
+//
+// A view is described by per-dim sizes and element strides. Before copying,
+// size-1 dims are dropped and every dim whose stride equals the extent of its
+// inner neighbor in both views is merged into that neighbor, so each copy is
+// done as the fewest, longest contiguous runs the two layouts allow. E.g.
+// concatenating along dim 0, or along any dim of a tensor whose leading dims
+// are all 1, is a single memcpy per input.
+
+#include <algorithm>
+#include <cstdint>
+
+#include <executorch/runtime/kernel/kernel_includes.h>
+
+namespace torch {
+namespace executor {
+
+/**
+ * Ops that copy several strided views into one buffer, or one buffer into
+ * several views, walk it in blocks of about this many bytes and finish each
+ * block before moving on, so the buffer is streamed through once rather than
+ * once per view.
+ */
+constexpr size_t kStridedCopyBlockBytes = 32 * 1024;
+
+/**
+ * Returns how many rows of `row_nbytes` bytes make up one block of
+ * kStridedCopyBlockBytes; at least one.
+ */
+inline int64_t rows_per_copy_block(size_t row_nbytes) {
+  return row_nbytes >= kStridedCopyBlockBytes
+      ? 1
+      : static_cast<int64_t>(
+            kStridedCopyBlockBytes / std::max<size_t>(row_nbytes, 1));
+}
+
+/**
+ * Copies the elements of a strided view of `ndim` dims with sizes `sizes`
+ * from `src` to `dst`. Element (i_0, ..., i_{ndim-1}) is read from
+ * `src + sum(i_k * src_strides[k]) * element_size` and written to
+ * `dst + sum(i_k * dst_strides[k]) * element_size`. A view with no dims is
+ * one element. `src` and `dst` must not overlap.
+ */
+void strided_copy(
+    void* dst,
+    const int64_t* dst_strides,
+    const void* src,
+    const int64_t* src_strides,
+    const int64_t* sizes,
+    size_t ndim,
+    size_t element_size);
+
+namespace internal {
+
+/**
+ * A strided copy reduced to its contiguous runs: `outer_ndim` dims of runs,
+ * each `run_size` elements that are `run_dst_stride` and `run_src_stride`
+ * elements apart, which is 1 for both unless the views share no contiguous
+ * innermost dim.
+ */
+struct StridedRuns {
+  size_t outer_ndim;
+  int64_t sizes[kTensorDimensionLimit];
+  int64_t dst_strides[kTensorDimensionLimit];
+  int64_t src_strides[kTensorDimensionLimit];
+  int64_t run_size;
+  int64_t run_dst_stride;
+  int64_t run_src_stride;
+};
+
+/**
+ * Merges the dims of a strided view into `runs`. Returns false if the view
+ * has no elements.
+ */
+bool make_strided_runs(
+    const int64_t* dst_strides,
+    const int64_t* src_strides,
+    const int64_t* sizes,
+    size_t ndim,
+    StridedRuns& runs);
+
+/**
+ * Calls `fn(dst_offset, src_offset)` with the element offsets of the start
+ * of each run, in row-major order.
+ */
+template <typename Fn>
+void for_each_strided_run(const StridedRuns& runs, const Fn& fn) {
+  const size_t ndim = runs.outer_ndim;
+  int64_t index[kTensorDimensionLimit] = {};
+  int64_t dst_offset = 0;
+  int64_t src_offset = 0;
+  while (true) {
+    fn(dst_offset, src_offset);
+
+    // Advance to the next run, carrying into the outer dims.
+    size_t d = ndim;
+    while (d > 0) {
+      --d;
+      if (++index[d] < runs.sizes[d]) {
+        dst_offset += runs.dst_strides[d];
+        src_offset += runs.src_strides[d];
+        break;
+      }
+      index[d] = 0;
+      dst_offset -= (runs.sizes[d] - 1) * runs.dst_strides[d];
+      src_offset -= (runs.sizes[d] - 1) * runs.src_strides[d];
+      if (d == 0) {
+        return;
+      }
+    }
+    if (ndim == 0) {
+      return;
+    }
+  }
+}
+
+} // namespace internal
+
+/**
+ * Like strided_copy(), but converts each element from CTYPE_IN to
+ * CTYPE_OUT.
+ */
+template <typename CTYPE_OUT, typename CTYPE_IN>
+void strided_convert(
+    CTYPE_OUT* dst,
+    const int64_t* dst_strides,
+    const CTYPE_IN* src,
+    const int64_t* src_strides,
+    const int64_t* sizes,
+    size_t ndim) {
+  internal::StridedRuns runs;
+  if (!internal::make_strided_runs(
+          dst_strides, src_strides, sizes, ndim, runs)) {
+    return;
+  }
+  const int64_t n = runs.run_size;
+  const int64_t dst_step = runs.run_dst_stride;
+  const int64_t src_step = runs.run_src_stride;
+  internal::for_each_strided_run(
+      runs, [&](int64_t dst_offset, int64_t src_offset) {
+        CTYPE_OUT* const out = dst + dst_offset;
+        const CTYPE_IN* const in = src + src_offset;
+        if (dst_step == 1 && src_step == 1) {
+          for (int64_t i = 0; i < n; ++i) {
+            out[i] = convert<CTYPE_OUT, CTYPE_IN>(in[i]);
+          }
+        } else {
+          for (int64_t i = 0; i < n; ++i) {
+            out[i * dst_step] = convert<CTYPE_OUT, CTYPE_IN>(in[i * src_step]);
+          }
+        }
+      });
+}
+
+/// Sets every element of a strided view of `dst` to `value`.
+template <typename CTYPE>
+void strided_fill(
+    CTYPE* dst,
+    const int64_t* dst_strides,
+    const int64_t* sizes,
+    size_t ndim,
+    CTYPE value) {
+  internal::StridedRuns runs;
+  if (!internal::make_strided_runs(
+          dst_strides, dst_strides, sizes, ndim, runs)) {
+    return;
+  }
+  const int64_t n = runs.run_size;
+  const int64_t step = runs.run_dst_stride;
+  internal::for_each_strided_run(runs, [&](int64_t offset, int64_t) {
+    CTYPE* const out = dst + offset;
+    if (step == 1) {
+      std::fill(out, out + n, value);
+    } else {
+      for (int64_t i = 0; i < n; ++i) {
+        out[i * step] = value;
+      }
+    }
+  });
+}
+
+} // namespace executor
+} // namespace torch
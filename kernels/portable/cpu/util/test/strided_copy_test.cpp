@@ -0,0 +1,130 @@
+/*
+ * Copyright (c) Meta Platforms, Inc. and affiliates.
+ * All rights reserved.
+ *
+ * This source code is licensed under the BSD-style license found in the
+ * LICENSE file in the root directory of this source tree.
+ */
+
+#include <executorch/kernels/portable/cpu/util/strided_copy_util.h>
+
+#include <gtest/gtest.h>
+
+#include <cstdint>
+#include <vector>
+
+using namespace ::testing;
+using torch::executor::strided_convert;
+using torch::executor::strided_copy;
+using torch::executor::strided_fill;
+using torch::executor::internal::make_strided_runs;
+using torch::executor::internal::StridedRuns;
+
+TEST(StridedCopyUtilTest, ContiguousViewsMergeIntoOneRun) {
+  const int64_t sizes[3] = {2, 3, 4};
+  const int64_t strides[3] = {12, 4, 1};
+  StridedRuns runs;
+  ASSERT_TRUE(make_strided_runs(strides, strides, sizes, 3, runs));
+  EXPECT_EQ(runs.outer_ndim, 0u);
+  EXPECT_EQ(runs.run_size, 24);
+  EXPECT_EQ(runs.run_dst_stride, 1);
+  EXPECT_EQ(runs.run_src_stride, 1);
+}
+
+TEST(StridedCopyUtilTest, SizeOneDimsAreDropped) {
+  // The middle dim has a stride that would otherwise block the merge.
+  const int64_t sizes[3] = {2, 1, 4};
+  const int64_t dst_strides[3] = {4, 100, 1};
+  const int64_t src_strides[3] = {4, 7, 1};
+  StridedRuns runs;
+  ASSERT_TRUE(make_strided_runs(dst_strides, src_strides, sizes, 3, runs));
+  EXPECT_EQ(runs.outer_ndim, 0u);
+  EXPECT_EQ(runs.run_size, 8);
+}
+
+TEST(StridedCopyUtilTest, EmptyViewHasNoRuns) {
+  const int64_t sizes[2] = {3, 0};
+  const int64_t strides[2] = {0, 1};
+  StridedRuns runs;
+  EXPECT_FALSE(make_strided_runs(strides, strides, sizes, 2, runs));
+}
+
+TEST(StridedCopyUtilTest, CopyIntoRowsOfWiderBuffer) {
+  // Copy a contiguous [3, 2] block into columns 1 and 2 of a [3, 4] buffer,
+  // as cat does for its second input.
+  const std::vector<int32_t> src = {1, 2, 3, 4, 5, 6};
+  std::vector<int32_t> dst(12, 0);
+  const int64_t sizes[2] = {3, 2};
+  const int64_t dst_strides[2] = {4, 1};
+  const int64_t src_strides[2] = {2, 1};
+
+  StridedRuns runs;
+  ASSERT_TRUE(make_strided_runs(dst_strides, src_strides, sizes, 2, runs));
+  EXPECT_EQ(runs.outer_ndim, 1u);
+  EXPECT_EQ(runs.run_size, 2);
+
+  strided_copy(
+      dst.data() + 1,
+      dst_strides,
+      src.data(),
+      src_strides,
+      sizes,
+      2,
+      sizeof(int32_t));
+  EXPECT_EQ(dst, std::vector<int32_t>({0, 1, 2, 0, 0, 3, 4, 0, 0, 5, 6, 0}));
+}
+
+TEST(StridedCopyUtilTest, CopyTransposedAndBroadcastSources) {
+  // Transpose a [2, 3] source.
+  const std::vector<int16_t> src = {1, 2, 3, 4, 5, 6};
+  std::vector<int16_t> dst(6, 0);
+  const int64_t sizes[2] = {3, 2};
+  const int64_t dst_strides[2] = {2, 1};
+  const int64_t transposed_strides[2] = {1, 3};
+  strided_copy(
+      dst.data(),
+      dst_strides,
+      src.data(),
+      transposed_strides,
+      sizes,
+      2,
+      sizeof(int16_t));
+  EXPECT_EQ(dst, std::vector<int16_t>({1, 4, 2, 5, 3, 6}));
+
+  // Broadcast the first row along the inner dim.
+  const int64_t broadcast_strides[2] = {1, 0};
+  strided_copy(
+      dst.data(),
+      dst_strides,
+      src.data(),
+      broadcast_strides,
+      sizes,
+      2,
+      sizeof(int16_t));
+  EXPECT_EQ(dst, std::vector<int16_t>({1, 1, 2, 2, 3, 3}));
+}
+
+TEST(StridedCopyUtilTest, CopyZeroDimViewCopiesOneElement) {
+  const double src = 2.5;
+  double dst = 0;
+  strided_copy(&dst, nullptr, &src, nullptr, nullptr, 0, sizeof(double));
+  EXPECT_EQ(dst, 2.5);
+}
+
+TEST(StridedCopyUtilTest, ConvertIntoRowsOfWiderBuffer) {
+  const std::vector<int32_t> src = {1, 2, 3, 4};
+  std::vector<float> dst(6, 0);
+  const int64_t sizes[2] = {2, 2};
+  const int64_t dst_strides[2] = {3, 1};
+  const int64_t src_strides[2] = {2, 1};
+  strided_convert(dst.data(), dst_strides, src.data(), src_strides, sizes, 2);
+  EXPECT_EQ(dst, std::vector<float>({1, 2, 0, 3, 4, 0}));
+}
+
+TEST(StridedCopyUtilTest, FillColumn) {
+  std::vector<int64_t> dst(6, 0);
+  const int64_t sizes[2] = {3, 1};
+  const int64_t strides[2] = {2, 1};
+  strided_fill<int64_t>(dst.data() + 1, strides, sizes, 2, 7);
+  EXPECT_EQ(dst, std::vector<int64_t>({0, 7, 0, 7, 0, 7}));
+}
@@ -21,3 +21,11 @@ def define_common_targets():
             "//executorch/kernels/portable/cpu/util:reduce_util",
         ],
     )
+
+    runtime.cxx_test(
+        name = "strided_copy_test",
+        srcs = ["strided_copy_test.cpp"],
+        deps = [
+            "//executorch/kernels/portable/cpu/util:strided_copy_util",
+        ],
+    )
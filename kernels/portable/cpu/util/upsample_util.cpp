@@ -0,0 +1,125 @@
+/*
+ * Copyright (c) Meta Platforms, Inc. and affiliates.
+ * All rights reserved.
+ *
+ * This source code is licensed under the BSD-style license found in the
+ * LICENSE file in the root directory of this source tree.
+ */
+
+#include <executorch/kernels/portable/cpu/util/upsample_util.h>
+
+namespace torch {
+namespace executor {
+
+using Tensor = exec_aten::Tensor;
+
+bool check_upsample_2d_common_args(
+    const Tensor& in,
+    const exec_aten::optional<exec_aten::ArrayRef<int64_t>>& output_size,
+    const exec_aten::optional<exec_aten::ArrayRef<double>>& scale_factors,
+    Tensor& out) {
+  ET_LOG_AND_RETURN_IF_FALSE(tensors_have_same_dtype(in, out));
+  ET_LOG_AND_RETURN_IF_FALSE(tensor_is_rank(in, 4));
+  ET_LOG_AND_RETURN_IF_FALSE(tensor_is_rank(out, 4));
+  ET_LOG_AND_RETURN_IF_FALSE(tensor_is_default_or_channels_last_dim_order(in));
+  ET_LOG_AND_RETURN_IF_FALSE(tensor_is_default_or_channels_last_dim_order(out));
+
+  ET_LOG_MSG_AND_RETURN_IF_FALSE(
+      output_size.has_value() ^ scale_factors.has_value(),
+      "Exactly one of output_size and scale_factors must be set");
+  if (output_size.has_value()) {
+    const auto& size = output_size.value();
+    ET_LOG_MSG_AND_RETURN_IF_FALSE(
+        size.size() == 2,
+        "Expected output_size to have 2 elements but got %zu",
+        size.size());
+    ET_LOG_MSG_AND_RETURN_IF_FALSE(
+        size[0] > 0 && size[1] > 0,
+        "Expected output_size to be positive but got {%" PRId64 ", %" PRId64
+        "}",
+        size[0],
+        size[1]);
+  } else {
+    const auto& scales = scale_factors.value();
+    ET_LOG_MSG_AND_RETURN_IF_FALSE(
+        scales.size() == 2,
+        "Expected scale_factors to have 2 elements but got %zu",
+        scales.size());
+    ET_LOG_MSG_AND_RETURN_IF_FALSE(
+        scales[0] > 0 && scales[1] > 0,
+        "Expected scale_factors to be positive but got {%f, %f}",
+        scales[0],
+        scales[1]);
+  }
+
+  return true;
+}
+
+bool check_upsample_bilinear2d_args(
+    const Tensor& in,
+    const exec_aten::optional<exec_aten::ArrayRef<int64_t>>& output_size,
+    __ET_UNUSED const bool align_corners,
+    const exec_aten::optional<exec_aten::ArrayRef<double>>& scale_factors,
+    Tensor& out) {
+  ET_LOG_AND_RETURN_IF_FALSE(
+      check_upsample_2d_common_args(in, output_size, scale_factors, out));
+  ET_LOG_MSG_AND_RETURN_IF_FALSE(
+      isFloatingType(in.scalar_type()),
+      "Expected a floating point input but got %s",
+      toString(in.scalar_type()));
+  return true;
+}
+
+bool check_upsample_nearest2d_args(
+    const Tensor& in,
+    const exec_aten::optional<exec_aten::ArrayRef<int64_t>>& output_size,
+    const exec_aten::optional<exec_aten::ArrayRef<double>>& scale_factors,
+    Tensor& out) {
+  return check_upsample_2d_common_args(in, output_size, scale_factors, out);
+}
+
+Error resize_upsample_2d(
+    const Tensor& in,
+    const exec_aten::optional<exec_aten::ArrayRef<int64_t>>& output_size,
+    const exec_aten::optional<exec_aten::ArrayRef<double>>& scale_factors,
+    double& scale_h_out,
+    double& scale_w_out,
+    Tensor& out) {
+  // Either output_size or scale_factors is provided, not both. This
+  // is checked in check_upsample_2d_common_args.
+  Tensor::SizesType target_size[kTensorDimensionLimit];
+  const auto dim = in.dim();
+  std::copy(in.sizes().cbegin(), in.sizes().cend(), target_size);
+
+  if (scale_factors.has_value()) {
+    scale_h_out = scale_factors.value()[0];
+    scale_w_out = scale_factors.value()[1];
+
+    target_size[dim - 2] =
+        static_cast<Tensor::SizesType>(in.size(dim - 2) * scale_h_out);
+    target_size[dim - 1] =
+        static_cast<Tensor::SizesType>(in.size(dim - 1) * scale_w_out);
+  } else if (output_size.has_value()) {
+    // The scales are derived from the sizes when they are needed.
+    scale_h_out = 0;
+    scale_w_out = 0;
+
+    target_size[dim - 2] =
+        static_cast<Tensor::SizesType>(output_size.value()[0]);
+    target_size[dim - 1] =
+        static_cast<Tensor::SizesType>(output_size.value()[1]);
+  } else {
+    ET_LOG(Error, "Invalid output_size or scale_factors");
+    return Error::InvalidArgument;
+  }
+
+  ET_CHECK_OR_RETURN_ERROR(
+      target_size[dim - 2] > 0 && target_size[dim - 1] > 0,
+      InvalidArgument,
+      "Upsampled output size must be positive");
+
+  return resize_tensor(out, {target_size, static_cast<size_t>(dim)});
+}
+
+} // namespace executor
+} // namespace torch
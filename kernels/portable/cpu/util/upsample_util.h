@@ -0,0 +1,150 @@
+/*
+ * Copyright (c) Meta Platforms, Inc. and affiliates.
+ * All rights reserved.
+ *
+ * This source code is licensed under the BSD-style license found in the
+ * LICENSE file in the root directory of this source tree.
+ */
+
+#pragma once
+
+#include <algorithm>
+#include <cmath>
+
+#include <executorch/runtime/kernel/kernel_includes.h>
+
+namespace torch {
+namespace executor {
+
+bool check_upsample_2d_common_args(
+    const Tensor& in,
+    const exec_aten::optional<exec_aten::ArrayRef<int64_t>>& output_size,
+    const exec_aten::optional<exec_aten::ArrayRef<double>>& scale_factors,
+    Tensor& out);
+
+bool check_upsample_bilinear2d_args(
+    const Tensor& in,
+    const exec_aten::optional<exec_aten::ArrayRef<int64_t>>& output_size,
+    const bool align_corners,
+    const exec_aten::optional<exec_aten::ArrayRef<double>>& scale_factors,
+    Tensor& out);
+
+bool check_upsample_nearest2d_args(
+    const Tensor& in,
+    const exec_aten::optional<exec_aten::ArrayRef<int64_t>>& output_size,
+    const exec_aten::optional<exec_aten::ArrayRef<double>>& scale_factors,
+    Tensor& out);
+
+/**
+ * Resizes `out` to the upsampled size of `in`, which is either `output_size`
+ * or `in`'s spatial size times `scale_factors`. Exactly one of the two must
+ * be set. `scale_h_out` and `scale_w_out` receive the scale factors to
+ * compute source coordinates with, or 0 if the sizes should be used instead.
+ */
+Error resize_upsample_2d(
+    const Tensor& in,
+    const exec_aten::optional<exec_aten::ArrayRef<int64_t>>& output_size,
+    const exec_aten::optional<exec_aten::ArrayRef<double>>& scale_factors,
+    double& scale_h_out,
+    double& scale_w_out,
+    Tensor& out);
+
+/**
+ * Returns the ratio of input to output coordinates along one dim. A positive
+ * `scale` is the user provided output/input scale factor; otherwise the
+ * ratio of the sizes is used.
+ */
+template <typename T>
+inline T area_pixel_compute_scale(
+    int64_t input_size,
+    int64_t output_size,
+    bool align_corners,
+    double scale) {
+  if (align_corners) {
+    return output_size > 1
+        ? static_cast<T>(input_size - 1) / static_cast<T>(output_size - 1)
+        : static_cast<T>(0);
+  }
+  return scale > 0 ? static_cast<T>(1.0 / scale)
+                   : static_cast<T>(input_size) / static_cast<T>(output_size);
+}
+
+/// Maps output coordinate `dst_index` to a (fractional) input coordinate.
+template <typename T>
+inline T area_pixel_compute_source_index(
+    T scale,
+    int64_t dst_index,
+    bool align_corners) {
+  if (align_corners) {
+    return scale * static_cast<T>(dst_index);
+  }
+  const T src_index =
+      scale * (static_cast<T>(dst_index) + static_cast<T>(0.5)) -
+      static_cast<T>(0.5);
+  return src_index < static_cast<T>(0) ? static_cast<T>(0) : src_index;
+}
+
+/**
+ * Computes the two input indices that output index `dst_index` interpolates
+ * between, and their weights, for linear interpolation along one dim.
+ */
+template <typename T>
+inline void compute_source_index_and_lambda(
+    int64_t& input_index0,
+    int64_t& input_index1,
+    T& lambda0,
+    T& lambda1,
+    T scale,
+    int64_t dst_index,
+    int64_t input_size,
+    int64_t output_size,
+    bool align_corners) {
+  if (output_size == input_size) {
+    // Scale is 1, so this is a copy.
+    input_index0 = dst_index;
+    input_index1 = dst_index;
+    lambda0 = static_cast<T>(1);
+    lambda1 = static_cast<T>(0);
+    return;
+  }
+  const T real_input_index =
+      area_pixel_compute_source_index<T>(scale, dst_index, align_corners);
+  input_index0 = std::min(
+      static_cast<int64_t>(std::floor(real_input_index)), input_size - 1);
+  lambda1 = std::min(
+      std::max(
+          real_input_index - static_cast<T>(input_index0), static_cast<T>(0)),
+      static_cast<T>(1));
+  lambda0 = static_cast<T>(1) - lambda1;
+  input_index1 = input_index0 + (input_index0 < input_size - 1 ? 1 : 0);
+}
+
+/// Returns the nearest-neighbor scale for one dim; see
+/// area_pixel_compute_scale().
+inline float compute_nearest_scale(
+    int64_t input_size,
+    int64_t output_size,
+    double scale) {
+  return scale > 0 ? static_cast<float>(1.0 / scale)
+                   : static_cast<float>(input_size) /
+          static_cast<float>(output_size);
+}
+
+/// Returns the input index that output index `dst_index` copies from.
+inline int64_t nearest_idx(
+    int64_t dst_index,
+    int64_t input_size,
+    int64_t output_size,
+    float scale) {
+  if (output_size == input_size) {
+    return dst_index;
+  } else if (output_size == 2 * input_size) {
+    return dst_index >> 1;
+  }
+  return std::min(
+      static_cast<int64_t>(std::floor(static_cast<float>(dst_index) * scale)),
+      input_size - 1);
+}
+
+} // namespace executor
+} // namespace torch
@@ -0,0 +1,158 @@
+/*
+ * Copyright (c) Meta Platforms, Inc. and affiliates.
+ * All rights reserved.
+ *
+ * This source code is licensed under the BSD-style license found in the
+ * LICENSE file in the root directory of this source tree.
+ */
+
+#include <executorch/kernels/portable/NativeFunctions.h> // Declares the operator
+#include <executorch/kernels/test/TestUtil.h>
+#include <executorch/runtime/core/exec_aten/exec_aten.h>
+#include <executorch/runtime/core/exec_aten/testing_util/tensor_factory.h>
+#include <executorch/runtime/core/exec_aten/testing_util/tensor_util.h>
+#include <executorch/runtime/core/memory_allocator.h>
+#include <executorch/runtime/kernel/operator_registry.h>
+
+#include <gtest/gtest.h>
+
+using namespace ::testing;
+using exec_aten::Scalar;
+using exec_aten::ScalarType;
+using exec_aten::Tensor;
+using torch::executor::Error;
+using torch::executor::EValue;
+using torch::executor::KernelPrepare;
+using torch::executor::MemoryAllocator;
+using torch::executor::testing::TensorFactory;
+
+// Note: This file is used for testing op_add for *portable kernel specific*.
+// If your test case is generic and should be tested on all kernels, add it to
+// executorch/kernels/test/op_add_test.cpp instead.
+
+namespace torch {
+namespace executor {
+namespace native {
+// Defined in op_add.cpp.
+extern const KernelPrepare add_out_prepare;
+} // namespace native
+} // namespace executor
+} // namespace torch
+
+namespace {
+
+Tensor& add_out(
+    const Tensor& self,
+    const Tensor& other,
+    const Scalar& alpha,
+    Tensor& out) {
+  exec_aten::RuntimeContext context{};
+  return torch::executor::native::add_out(context, self, other, alpha, out);
+}
+
+// Runs add.out through its prepare and execute functions, the way a Method
+// does for a prepared instruction.
+Tensor& prepared_add_out(
+    const Tensor& self,
+    const Tensor& other,
+    const Scalar& alpha,
+    Tensor& out) {
+  const KernelPrepare* prepare = &torch::executor::native::add_out_prepare;
+
+  uint8_t buffer[1024];
+  MemoryAllocator allocator(sizeof(buffer), buffer);
+  EValue values[] = {EValue(self), EValue(other), EValue(alpha), EValue(out)};
+  EValue* args[] = {&values[0], &values[1], &values[2], &values[3]};
+
+  const void* plan = nullptr;
+  EXPECT_EQ(prepare->prepare_(&allocator, args, &plan), Error::Ok);
+  EXPECT_NE(plan, nullptr);
+
+  // A plan is reused across executions.
+  exec_aten::RuntimeContext context{};
+  prepare->execute_(context, plan, args);
+  prepare->execute_(context, plan, args);
+  EXPECT_EQ(context.failure_state(), Error::Ok);
+  return out;
+}
+
+} // namespace
+
+TEST(OpAddOutKernelTest, PreparedMatchesUnprepared) {
+  TensorFactory<ScalarType::Float> tf;
+
+  const std::vector<int32_t> sizes = {2, 3, 4};
+  std::vector<float> a_data(24);
+  std::vector<float> b_data(24);
+  for (size_t i = 0; i < a_data.size(); ++i) {
+    a_data[i] = static_cast<float>(i) * 0.5f;
+    b_data[i] = 10.0f - static_cast<float>(i);
+  }
+  Tensor a = tf.make(sizes, a_data);
+  Tensor b = tf.make(sizes, b_data);
+
+  Tensor expected = tf.zeros(sizes);
+  add_out(a, b, /*alpha=*/2, expected);
+  Tensor out = tf.zeros(sizes);
+  prepared_add_out(a, b, /*alpha=*/2, out);
+  EXPECT_TENSOR_EQ(out, expected);
+}
+
+TEST(OpAddOutKernelTest, PreparedBroadcastMatchesUnprepared) {
+  TensorFactory<ScalarType::Float> tf;
+  TensorFactory<ScalarType::Int> tfi;
+
+  // Broadcasting on both sides, over leading, middle and trailing dims, with
+  // mixed input dtypes.
+  std::vector<float> a_data(2 * 1 * 4 * 5);
+  for (size_t i = 0; i < a_data.size(); ++i) {
+    a_data[i] = static_cast<float>(i) - 7.25f;
+  }
+  Tensor a = tf.make({2, 1, 4, 5}, a_data);
+  Tensor b = tfi.make({3, 1, 5}, {1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11, 12, 13, 14, 15});
+
+  Tensor expected = tf.zeros({2, 3, 4, 5});
+  add_out(a, b, /*alpha=*/-1.5, expected);
+  Tensor out = tf.zeros({2, 3, 4, 5});
+  prepared_add_out(a, b, /*alpha=*/-1.5, out);
+  EXPECT_TENSOR_EQ(out, expected);
+
+  // A scalar tensor broadcast against a vector.
+  Tensor c = tf.make({1}, {3});
+  Tensor d = tf.make({4}, {1, 2, 3, 4});
+  Tensor expected_cd = tf.zeros({4});
+  add_out(c, d, /*alpha=*/1, expected_cd);
+  Tensor out_cd = tf.zeros({4});
+  prepared_add_out(c, d, /*alpha=*/1, out_cd);
+  EXPECT_TENSOR_EQ(out_cd, expected_cd);
+}
+
+TEST(OpAddOutKernelTest, PrepareRejectsInvalidArguments) {
+  TensorFactory<ScalarType::Float> tf;
+
+  const KernelPrepare* prepare = &torch::executor::native::add_out_prepare;
+  uint8_t buffer[1024];
+  MemoryAllocator allocator(sizeof(buffer), buffer);
+
+  // Shapes that don't broadcast fail at prepare time instead of on execute.
+  Tensor a = tf.ones({2, 3});
+  Tensor b = tf.ones({4});
+  Tensor out = tf.zeros({2, 3});
+  EValue values[] = {EValue(a), EValue(b), EValue(Scalar(1)), EValue(out)};
+  EValue* args[] = {&values[0], &values[1], &values[2], &values[3]};
+  const void* plan = nullptr;
+  EXPECT_EQ(
+      prepare->prepare_(&allocator, args, &plan), Error::InvalidArgument);
+  EXPECT_EQ(plan, nullptr);
+
+  // A floating point alpha for an integer addition.
+  TensorFactory<ScalarType::Int> tfi;
+  Tensor ia = tfi.ones({2});
+  Tensor iout = tfi.zeros({2});
+  EValue int_values[] = {
+      EValue(ia), EValue(ia), EValue(Scalar(0.5)), EValue(iout)};
+  EValue* int_args[] = {
+      &int_values[0], &int_values[1], &int_values[2], &int_values[3]};
+  EXPECT_EQ(
+      prepare->prepare_(&allocator, int_args, &plan), Error::InvalidArgument);
+}
@@ -104,16 +104,21 @@ void et_copy_index(RuntimeContext& context, EValue** stack) {
         "Data ptr of copy_to tensor changed after resize which isn't allowed for static/upper-bounded tensors");
   }
 
-  auto copy_to_ptr = copy_to.const_data_ptr();
-  auto copy_from_ptr = copy_from.const_data_ptr();
+  void* copy_dst =
+      (void*)((uintptr_t)copy_to.const_data_ptr() + index * size_copy_from);
+  const void* copy_from_ptr = copy_from.const_data_ptr();
+
+  // The Method may have pointed copy_from at this very slice of copy_to before
+  // the loop body ran, in which case the body already wrote its result in
+  // place and there is nothing to copy.
+  if (copy_dst == copy_from_ptr) {
+    return;
+  }
 
   // If we've reached here, it means the copy_to tensor has been
   // successfully resized so we can now copy over the data from
   // copy_from into the copy_to tensor.
-  memcpy(
-      (void*)((uintptr_t)copy_to_ptr + index * size_copy_from),
-      copy_from_ptr,
-      size_copy_from);
+  memcpy(copy_dst, copy_from_ptr, size_copy_from);
 }
 
 } // namespace function
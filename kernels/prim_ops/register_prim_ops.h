@@ -0,0 +1,28 @@
+/*
+ * Copyright (c) Meta Platforms, Inc. and affiliates.
+ * All rights reserved.
+ *
+ * This source code is licensed under the BSD-style license found in the
+ * LICENSE file in the root directory of this source tree.
+ */
+
+#pragma once
+
+#include <executorch/kernels/prim_ops/scalar_prim_ops.h>
+#include <executorch/runtime/kernel/operator_registry.h>
+
+namespace torch {
+namespace executor {
+namespace function {
+
+/**
+ * Returns the scalar prim op that `kernel` evaluates if it is one of the
+ * kernels registered by this library, or ScalarPrimOp::None otherwise. Another
+ * library may register its own kernel under a prim op's name, and only this
+ * library's kernels may be replaced by eval_scalar_prim_op().
+ */
+ScalarPrimOp get_registered_scalar_prim_op(const Kernel& kernel);
+
+} // namespace function
+} // namespace executor
+} // namespace torch
@@ -0,0 +1,238 @@
+/*
+ * Copyright (c) Meta Platforms, Inc. and affiliates.
+ * All rights reserved.
+ *
+ * This source code is licensed under the BSD-style license found in the
+ * LICENSE file in the root directory of this source tree.
+ */
+
+#include <executorch/kernels/prim_ops/scalar_prim_ops.h>
+
+#include <cinttypes>
+#include <cmath>
+#include <cstring>
+
+#include <executorch/runtime/core/exec_aten/exec_aten.h>
+#include <executorch/runtime/platform/log.h>
+
+namespace torch {
+namespace executor {
+namespace function {
+
+namespace {
+
+struct ScalarPrimOpName {
+  const char* name;
+  ScalarPrimOp op;
+  size_t num_args;
+};
+
+constexpr ScalarPrimOpName kScalarPrimOps[] = {
+    {"aten::sym_size.int", ScalarPrimOp::SymSize, 3},
+    {"aten::sym_numel", ScalarPrimOp::SymNumel, 2},
+    {"executorch_prim::add.Scalar", ScalarPrimOp::Add, 3},
+    {"executorch_prim::sub.Scalar", ScalarPrimOp::Sub, 3},
+    {"executorch_prim::mul.Scalar", ScalarPrimOp::Mul, 3},
+    {"executorch_prim::floordiv.Scalar", ScalarPrimOp::FloorDiv, 3},
+    {"executorch_prim::truediv.Scalar", ScalarPrimOp::TrueDiv, 3},
+    {"executorch_prim::eq.Scalar", ScalarPrimOp::Eq, 3},
+    {"executorch_prim::gt.Scalar", ScalarPrimOp::Gt, 3},
+    {"executorch_prim::lt.Scalar", ScalarPrimOp::Lt, 3},
+    {"executorch_prim::ge.Scalar", ScalarPrimOp::Ge, 3},
+    {"executorch_prim::le.Scalar", ScalarPrimOp::Le, 3},
+    {"executorch_prim::floordiv.int", ScalarPrimOp::FloorDivInt, 3},
+};
+
+Error mismatched_tags(const EValue& a, const EValue& b) {
+  ET_LOG(
+      Error,
+      "Unsupported prim op argument types %zu, %zu",
+      (size_t)a.tag,
+      (size_t)b.tag);
+  return Error::InvalidArgument;
+}
+
+EValue floor_div_double(double a, double b) {
+  if (b == 0) {
+    return EValue(std::signbit(a) ? -INFINITY : INFINITY);
+  }
+  const auto mod = std::fmod(a, b);
+  auto div = (a - mod) / b;
+  if ((mod != 0) && std::signbit(b) != std::signbit(mod)) {
+    return EValue(div - 1);
+  }
+  return EValue(div);
+}
+
+/**
+ * Python's __floordiv__ operator is more complicated than just floor(a / b).
+ * It aims to maintain the property: a == (a // b) * b + remainder(a, b) which
+ * can otherwise fail due to rounding errors in the remainder. So, instead it
+ * is calculated as: a // b = (a - remainder(a, b)) / b With some additional
+ * fix-ups added to the result.
+ */
+Error floor_div(const EValue& a, const EValue& b, EValue& out) {
+  if (a.isInt() && b.isInt()) {
+    ET_CHECK_OR_RETURN_ERROR(
+        b.toInt() != 0, InvalidArgument, "Integer division by zero");
+    const int64_t quot = a.toInt() / b.toInt();
+    if (std::signbit(a.toInt()) == std::signbit(b.toInt())) {
+      out = EValue(quot);
+      return Error::Ok;
+    }
+    const int64_t rem = a.toInt() % b.toInt();
+    out = EValue(rem ? quot - 1 : quot);
+  } else if (a.isDouble() && b.isDouble()) {
+    out = floor_div_double(a.toDouble(), b.toDouble());
+  } else if (a.isInt() && b.isDouble()) {
+    out = floor_div_double(static_cast<double>(a.toInt()), b.toDouble());
+  } else if (a.isDouble() && b.isInt()) {
+    out = floor_div_double(a.toDouble(), static_cast<double>(b.toInt()));
+  } else {
+    return mismatched_tags(a, b);
+  }
+  return Error::Ok;
+}
+
+Error true_div(const EValue& a, const EValue& b, EValue& out) {
+  if (a.isInt() && b.isInt()) {
+    out = EValue(
+        static_cast<double>(a.toInt()) / static_cast<double>(b.toInt()));
+  } else if (a.isDouble() && b.isDouble()) {
+    out = EValue(a.toDouble() / b.toDouble());
+  } else if (a.isInt() && b.isDouble()) {
+    out = EValue(a.toInt() / b.toDouble());
+  } else if (a.isDouble() && b.isInt()) {
+    out = EValue(a.toDouble() / b.toInt());
+  } else {
+    return mismatched_tags(a, b);
+  }
+  return Error::Ok;
+}
+
+/// Applies `fn` to a pair of int/double scalars, promoting to double when the
+/// types differ. Bool operands are only accepted if `allow_bool` is set.
+template <bool allow_bool, typename Fn>
+Error binary_number_op(const EValue& a, const EValue& b, EValue& out, Fn fn) {
+  if (a.isInt() && b.isInt()) {
+    out = EValue(fn(a.toInt(), b.toInt()));
+  } else if (a.isDouble() && b.isDouble()) {
+    out = EValue(fn(a.toDouble(), b.toDouble()));
+  } else if (a.isInt() && b.isDouble()) {
+    out = EValue(fn(static_cast<double>(a.toInt()), b.toDouble()));
+  } else if (a.isDouble() && b.isInt()) {
+    out = EValue(fn(a.toDouble(), static_cast<double>(b.toInt())));
+  } else {
+    if constexpr (allow_bool) {
+      if (a.isBool() && b.isBool()) {
+        out = EValue(fn(a.toBool(), b.toBool()));
+        return Error::Ok;
+      }
+    }
+    return mismatched_tags(a, b);
+  }
+  return Error::Ok;
+}
+
+} // namespace
+
+ScalarPrimOp get_scalar_prim_op(const char* operator_name) {
+  for (const auto& entry : kScalarPrimOps) {
+    if (std::strcmp(entry.name, operator_name) == 0) {
+      return entry.op;
+    }
+  }
+  return ScalarPrimOp::None;
+}
+
+size_t scalar_prim_op_num_args(ScalarPrimOp op) {
+  for (const auto& entry : kScalarPrimOps) {
+    if (entry.op == op) {
+      return entry.num_args;
+    }
+  }
+  return 0;
+}
+
+Error eval_scalar_prim_op(ScalarPrimOp op, EValue** args) {
+  switch (op) {
+    case ScalarPrimOp::SymSize: {
+      ET_CHECK_OR_RETURN_ERROR(
+          args[0]->isTensor() && args[1]->isInt(),
+          InvalidArgument,
+          "sym_size expects (Tensor, int), got %zu, %zu",
+          (size_t)args[0]->tag,
+          (size_t)args[1]->tag);
+      const exec_aten::Tensor& self = args[0]->toTensor();
+      int64_t dim = args[1]->toInt();
+      if (dim < 0) {
+        dim += self.dim();
+      }
+      ET_CHECK_OR_RETURN_ERROR(
+          dim >= 0 && dim < self.dim(),
+          InvalidArgument,
+          "sym_size dim %" PRId64 " out of range for a %zd-D tensor",
+          args[1]->toInt(),
+          (ssize_t)self.dim());
+      *args[2] = EValue(static_cast<int64_t>(self.size(dim)));
+      return Error::Ok;
+    }
+    case ScalarPrimOp::SymNumel: {
+      ET_CHECK_OR_RETURN_ERROR(
+          args[0]->isTensor(),
+          InvalidArgument,
+          "sym_numel expects a Tensor, got %zu",
+          (size_t)args[0]->tag);
+      *args[1] = EValue(static_cast<int64_t>(args[0]->toTensor().numel()));
+      return Error::Ok;
+    }
+    case ScalarPrimOp::Add:
+      return binary_number_op</*allow_bool=*/false>(
+          *args[0], *args[1], *args[2], [](auto a, auto b) { return a + b; });
+    case ScalarPrimOp::Sub:
+      return binary_number_op</*allow_bool=*/false>(
+          *args[0], *args[1], *args[2], [](auto a, auto b) { return a - b; });
+    case ScalarPrimOp::Mul:
+      return binary_number_op</*allow_bool=*/false>(
+          *args[0], *args[1], *args[2], [](auto a, auto b) { return a * b; });
+    case ScalarPrimOp::FloorDiv:
+      return floor_div(*args[0], *args[1], *args[2]);
+    case ScalarPrimOp::TrueDiv:
+      return true_div(*args[0], *args[1], *args[2]);
+    case ScalarPrimOp::Eq:
+      return binary_number_op</*allow_bool=*/true>(
+          *args[0], *args[1], *args[2], [](auto a, auto b) { return a == b; });
+    case ScalarPrimOp::Gt:
+      return binary_number_op</*allow_bool=*/true>(
+          *args[0], *args[1], *args[2], [](auto a, auto b) { return a > b; });
+    case ScalarPrimOp::Lt:
+      return binary_number_op</*allow_bool=*/true>(
+          *args[0], *args[1], *args[2], [](auto a, auto b) { return a < b; });
+    case ScalarPrimOp::Ge:
+      return binary_number_op</*allow_bool=*/true>(
+          *args[0], *args[1], *args[2], [](auto a, auto b) { return a >= b; });
+    case ScalarPrimOp::Le:
+      return binary_number_op</*allow_bool=*/true>(
+          *args[0], *args[1], *args[2], [](auto a, auto b) { return a <= b; });
+    case ScalarPrimOp::FloorDivInt: {
+      ET_CHECK_OR_RETURN_ERROR(
+          args[0]->isInt() && args[1]->isInt(),
+          InvalidArgument,
+          "floordiv.int expects (int, int), got %zu, %zu",
+          (size_t)args[0]->tag,
+          (size_t)args[1]->tag);
+      ET_CHECK_OR_RETURN_ERROR(
+          args[1]->toInt() != 0, InvalidArgument, "Integer division by zero");
+      *args[2] = EValue(args[0]->toInt() / args[1]->toInt());
+      return Error::Ok;
+    }
+    case ScalarPrimOp::None:
+    default:
+      ET_LOG(Error, "Not a scalar prim op: %u", (unsigned int)op);
+      return Error::InvalidArgument;
+  }
+}
+
+} // namespace function
+} // namespace executor
+} // namespace torch
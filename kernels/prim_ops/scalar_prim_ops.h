@@ -0,0 +1,83 @@
+/*
+ * Copyright (c) Meta Platforms, Inc. and affiliates.
+ * All rights reserved.
+ *
+ * This source code is licensed under the BSD-style license found in the
+ * LICENSE file in the root directory of this source tree.
+ */
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+
+#include <executorch/runtime/core/error.h>
+#include <executorch/runtime/core/evalue.h>
+#include <executorch/runtime/platform/compiler.h>
+
+namespace torch {
+namespace executor {
+namespace function {
+
+/**
+ * The prim ops that only compute on scalars (or on tensor metadata) and that
+ * the runtime can evaluate without going through a registered kernel.
+ */
+enum class ScalarPrimOp : uint8_t {
+  /// Not a scalar prim op; must be dispatched as a regular kernel.
+  None = 0,
+  SymSize, // aten::sym_size.int
+  SymNumel, // aten::sym_numel
+  Add, // executorch_prim::add.Scalar
+  Sub, // executorch_prim::sub.Scalar
+  Mul, // executorch_prim::mul.Scalar
+  FloorDiv, // executorch_prim::floordiv.Scalar
+  TrueDiv, // executorch_prim::truediv.Scalar
+  Eq, // executorch_prim::eq.Scalar
+  Gt, // executorch_prim::gt.Scalar
+  Lt, // executorch_prim::lt.Scalar
+  Ge, // executorch_prim::ge.Scalar
+  Le, // executorch_prim::le.Scalar
+  FloorDivInt, // executorch_prim::floordiv.int
+};
+
+/**
+ * Returns the ScalarPrimOp for a fully-qualified operator name like
+ * "executorch_prim::add.Scalar", or ScalarPrimOp::None if the operator is not
+ * a scalar prim op.
+ */
+ScalarPrimOp get_scalar_prim_op(const char* operator_name);
+
+/**
+ * Returns the number of arguments, including the trailing output, that the op
+ * expects.
+ */
+size_t scalar_prim_op_num_args(ScalarPrimOp op);
+
+/**
+ * Returns true if the op reads only its scalar inputs, so that its result can
+ * be computed ahead of time when those inputs never change. sym_size and
+ * sym_numel read the (possibly dynamic) shape of a tensor and are not
+ * foldable.
+ */
+inline bool scalar_prim_op_is_foldable(ScalarPrimOp op) {
+  return op != ScalarPrimOp::None && op != ScalarPrimOp::SymSize &&
+      op != ScalarPrimOp::SymNumel;
+}
+
+/**
+ * Evaluates `op` on `args`, writing the result to the last argument.
+ *
+ * @param[in] op The op to evaluate. Must not be ScalarPrimOp::None.
+ * @param[in] args The op arguments; must have scalar_prim_op_num_args(op)
+ *     entries.
+ *
+ * @retval Error::Ok The output was written.
+ * @retval Error::InvalidArgument The argument tags do not match the op
+ *     schema; the output is left untouched.
+ */
+__ET_NODISCARD Error eval_scalar_prim_op(ScalarPrimOp op, EValue** args);
+
+} // namespace function
+} // namespace executor
+} // namespace torch
@@ -24,9 +24,28 @@ def define_common_targets():
             ],
         )
 
+        runtime.cxx_library(
+            name = "scalar_prim_ops" + aten_suffix,
+            srcs = ["scalar_prim_ops.cpp"],
+            visibility = [
+                "//executorch/kernels/prim_ops/...",
+                "//executorch/runtime/executor/...",
+            ],
+            exported_headers = ["scalar_prim_ops.h"],
+            deps = [
+                "//executorch/runtime/core/exec_aten:lib" + aten_suffix,
+                "//executorch/runtime/platform:platform",
+            ],
+            exported_deps = [
+                "//executorch/runtime/core:core",
+                "//executorch/runtime/core:evalue" + aten_suffix,
+            ],
+        )
+
         runtime.cxx_library(
             name = "prim_ops_registry" + aten_suffix,
             srcs = ["register_prim_ops.cpp"],
+            exported_headers = ["register_prim_ops.h"],
             visibility = [
                 "//executorch/...",
                 "@EXECUTORCH_CLIENTS",
@@ -38,7 +57,10 @@ def define_common_targets():
             deps = [
                 ":et_copy_index" + aten_suffix,
                 "//executorch/runtime/core:evalue" + aten_suffix,
-                "//executorch/runtime/kernel:operator_registry",
                 "//executorch/runtime/kernel:kernel_includes" + aten_suffix,
             ],
+            exported_deps = [
+                ":scalar_prim_ops" + aten_suffix,
+                "//executorch/runtime/kernel:operator_registry",
+            ],
         )
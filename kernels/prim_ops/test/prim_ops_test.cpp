@@ -8,6 +8,8 @@
 
 #include <gtest/gtest.h>
 
+#include <executorch/kernels/prim_ops/register_prim_ops.h>
+#include <executorch/kernels/prim_ops/scalar_prim_ops.h>
 #include <executorch/runtime/core/evalue.h>
 #include <executorch/runtime/core/exec_aten/exec_aten.h>
 #include <executorch/runtime/core/exec_aten/testing_util/tensor_factory.h>
@@ -160,6 +162,35 @@ TEST_F(RegisterPrimOpsTest, TestETCopyIndex) {
   EXPECT_TENSOR_EQ(copy_to, tf.make({2, 2}, {3, 4, 5, 6}));
 }
 
+#ifndef USE_ATEN_LIB
+TEST_F(RegisterPrimOpsTest, TestETCopyIndexInPlace) {
+  testing::TensorFactory<ScalarType::Int> tf;
+
+  SizesType zero_size[2] = {0, 0};
+  Tensor copy_to = tf.make(
+      {3, 2}, {0, 0, 0, 0, 0, 0}, {}, TensorShapeDynamism::DYNAMIC_BOUND);
+  Error err = resize_tensor(copy_to, {zero_size, 2});
+  EXPECT_EQ(err, Error::Ok);
+
+  // A body output that was already written into slice 1 of copy_to, the way
+  // Method lays it out for copy-free loops.
+  int32_t* copy_to_data = copy_to.mutable_data_ptr<int32_t>();
+  copy_to_data[0] = 1;
+  copy_to_data[1] = 2;
+  copy_to_data[2] = 3;
+  copy_to_data[3] = 4;
+  Tensor in_place = tf.make({2}, {0, 0});
+  in_place.unsafeGetTensorImpl()->set_data(copy_to_data + 2);
+
+  EValue values[3] = {EValue(copy_to), EValue(in_place), EValue((int64_t)1)};
+  EValue* stack[3] = {&values[0], &values[1], &values[2]};
+  getOpsFn("executorch_prim::et_copy_index.tensor")(context, stack);
+
+  EXPECT_EQ(copy_to.sizes()[0], 2);
+  EXPECT_TENSOR_EQ(copy_to, tf.make({2, 2}, {1, 2, 3, 4}));
+}
+#endif
+
 TEST_F(RegisterPrimOpsTest, TestETCopyIndexMismatchShape) {
   int64_t index = 1;
   testing::TensorFactory<ScalarType::Int> tf;
@@ -251,5 +282,107 @@ TEST_F(RegisterPrimOpsTest, TestBooleanOps) {
   EXPECT_EQ(stack[2]->toBool(), false);
 }
 
+TEST_F(RegisterPrimOpsTest, TestMismatchedTagsFailContext) {
+  testing::TensorFactory<ScalarType::Int> tf;
+  EValue values[3];
+  values[0] = EValue(tf.ones({2}));
+  values[1] = EValue(static_cast<int64_t>(1));
+  values[2] = EValue(static_cast<int64_t>(0));
+
+  EValue* stack[3];
+  for (size_t i = 0; i < 3; i++) {
+    stack[i] = &values[i];
+  }
+
+  getOpsFn("executorch_prim::add.Scalar")(context, stack);
+  EXPECT_EQ(context.failure_state(), Error::InvalidArgument);
+  EXPECT_EQ(stack[2]->toInt(), 0);
+}
+
+TEST_F(RegisterPrimOpsTest, ScalarPrimOpLookup) {
+  using function::get_scalar_prim_op;
+  using function::ScalarPrimOp;
+  EXPECT_EQ(get_scalar_prim_op("aten::sym_size.int"), ScalarPrimOp::SymSize);
+  EXPECT_EQ(
+      get_scalar_prim_op("executorch_prim::floordiv.int"),
+      ScalarPrimOp::FloorDivInt);
+  EXPECT_EQ(
+      get_scalar_prim_op("executorch_prim::et_copy_index.tensor"),
+      ScalarPrimOp::None);
+  EXPECT_EQ(get_scalar_prim_op("aten::add.out"), ScalarPrimOp::None);
+
+  EXPECT_FALSE(function::scalar_prim_op_is_foldable(ScalarPrimOp::SymSize));
+  EXPECT_FALSE(function::scalar_prim_op_is_foldable(ScalarPrimOp::None));
+  EXPECT_TRUE(function::scalar_prim_op_is_foldable(ScalarPrimOp::Add));
+  EXPECT_EQ(function::scalar_prim_op_num_args(ScalarPrimOp::SymNumel), 2);
+  EXPECT_EQ(function::scalar_prim_op_num_args(ScalarPrimOp::Mul), 3);
+}
+
+TEST_F(RegisterPrimOpsTest, RegisteredScalarPrimOpLookup) {
+  using function::get_registered_scalar_prim_op;
+  using function::ScalarPrimOp;
+
+  const Kernel* add = get_kernel("executorch_prim::add.Scalar");
+  ASSERT_NE(add, nullptr);
+  EXPECT_EQ(get_registered_scalar_prim_op(*add), ScalarPrimOp::Add);
+  const Kernel* copy_index = get_kernel("executorch_prim::et_copy_index.tensor");
+  ASSERT_NE(copy_index, nullptr);
+  EXPECT_EQ(get_registered_scalar_prim_op(*copy_index), ScalarPrimOp::None);
+
+  // Another library's kernel under a prim op's name must be dispatched.
+  Kernel custom_add(
+      "executorch_prim::add.Scalar", [](RuntimeContext&, EValue**) {});
+  EXPECT_EQ(get_registered_scalar_prim_op(custom_add), ScalarPrimOp::None);
+}
+
+TEST_F(RegisterPrimOpsTest, EvalScalarPrimOp) {
+  using function::eval_scalar_prim_op;
+  using function::ScalarPrimOp;
+  testing::TensorFactory<ScalarType::Int> tf;
+
+  EValue values[3];
+  values[0] = EValue(tf.ones({3, 5}));
+  values[1] = EValue(static_cast<int64_t>(-1));
+  values[2] = EValue(static_cast<int64_t>(0));
+  EValue* stack[3];
+  for (size_t i = 0; i < 3; i++) {
+    stack[i] = &values[i];
+  }
+
+  // Negative dims are wrapped.
+  EXPECT_EQ(eval_scalar_prim_op(ScalarPrimOp::SymSize, stack), Error::Ok);
+  EXPECT_EQ(stack[2]->toInt(), 5);
+
+  values[1] = EValue(static_cast<int64_t>(2));
+  EXPECT_EQ(
+      eval_scalar_prim_op(ScalarPrimOp::SymSize, stack),
+      Error::InvalidArgument);
+
+  // Python floor division rounds towards negative infinity.
+  values[0] = EValue(static_cast<int64_t>(-7));
+  values[1] = EValue(static_cast<int64_t>(2));
+  EXPECT_EQ(eval_scalar_prim_op(ScalarPrimOp::FloorDiv, stack), Error::Ok);
+  EXPECT_EQ(stack[2]->toInt(), -4);
+
+  // Mixed int/double promotes to double.
+  values[1] = EValue(1.5);
+  EXPECT_EQ(eval_scalar_prim_op(ScalarPrimOp::Add, stack), Error::Ok);
+  EXPECT_DOUBLE_EQ(stack[2]->toDouble(), -5.5);
+
+  // Division by an integer zero is reported instead of trapping.
+  values[1] = EValue(static_cast<int64_t>(0));
+  EXPECT_EQ(
+      eval_scalar_prim_op(ScalarPrimOp::FloorDivInt, stack),
+      Error::InvalidArgument);
+
+  // Bools are only valid for comparisons.
+  values[0] = EValue(true);
+  values[1] = EValue(false);
+  EXPECT_EQ(eval_scalar_prim_op(ScalarPrimOp::Gt, stack), Error::Ok);
+  EXPECT_EQ(stack[2]->toBool(), true);
+  EXPECT_EQ(
+      eval_scalar_prim_op(ScalarPrimOp::Add, stack), Error::InvalidArgument);
+}
+
 } // namespace executor
 } // namespace torch
@@ -392,6 +392,187 @@ TEST(OpConvCorrectnessTest, 2DSanityCheckChannelsLast) {
   EXPECT_TENSOR_CLOSE(out, expected);
 }
 
+// Expected values below were computed with
+// torch.nn.functional.conv_transpose1d / conv_transpose2d.
+
+TEST(OpConvCorrectnessTest, Transposed1DWithOutputPadding) {
+  TensorFactory<ScalarType::Float> tf;
+
+  Tensor input = tf.make({1, 2, 4}, {5.1, 2.9, 6.0, 9.3, 1.6, 1.9, 7.8, 2.2});
+  Tensor weight = tf.make(
+      {2, 3, 3}, {5.6, 8.4, 1.7, 7.4, 3.7, 1.4, 2.1, 6.5, 6.3,
+                  1.8, 4.0, 2.1, 8.0, 6.4, 1.7, 8.2, 2.5, 3.8});
+  optional<Tensor> bias(tf.make({3}, {9.0, 9.0, 8.4}));
+  Tensor expected = tf.make(
+      {1, 3, 10},
+      {9.0, 77.9,  9.0, 100.63, 9.0, 155.56, 9.0, 122.5,  9.0, 29.43,
+       9.0, 74.77, 9.0, 148.55, 9.0, 174.83, 9.0, 79.15,  9.0, 25.76,
+       8.4, 67.22, 8.4, 146.77, 8.4, 129.96, 8.4, 141.79, 8.4, 75.35});
+  Tensor out = tf.zeros({1, 3, 10});
+
+  int64_t stride[] = {2};
+  int64_t padding[] = {1};
+  int64_t dilation[] = {2};
+  int64_t output_padding[] = {1};
+
+  op_convolution_out(
+      input,
+      weight,
+      bias,
+      stride,
+      padding,
+      dilation,
+      true,
+      output_padding,
+      1,
+      out);
+  EXPECT_TENSOR_CLOSE(out, expected);
+}
+
+TEST(OpConvCorrectnessTest, Transposed2DGrouped) {
+  TensorFactory<ScalarType::Float> tf;
+
+  Tensor input = tf.make(
+      {1, 4, 3, 3},
+      {1.7, 8.3, 8.4, 6.0, 1.6, 3.8, 1.5, 8.1, 2.7, 4.7, 6.3, 2.8, 7.9, 2.5,
+       8.3, 4.9, 8.1, 9.7, 3.3, 2.3, 8.4, 8.3, 9.1, 3.4, 5.7, 2.2, 8.0, 1.8,
+       8.2, 1.7, 8.9, 3.6, 7.3, 9.7, 7.8, 6.4});
+  Tensor weight = tf.make(
+      {4, 1, 3, 3},
+      {5.0, 6.9, 8.4, 6.8, 5.6, 4.8, 4.1, 3.3, 9.9, 4.1, 2.0, 8.3, 4.8, 7.7,
+       7.3, 5.3, 6.7, 4.6, 8.7, 1.9, 2.5, 7.5, 6.3, 3.1, 5.3, 2.9, 7.2, 6.3,
+       1.5, 9.5, 1.9, 8.1, 8.3, 5.0, 5.3, 9.8});
+  optional<Tensor> bias(tf.make({2}, {5.4, 8.6}));
+  Tensor expected = tf.make(
+      {1, 2, 6, 6},
+      {51.11,  134.55, 100.39, 161.79, 74.0,   66.16,  99.7,   245.49, 91.04,
+       253.05, 94.7,   202.25, 99.83,  114.75, 33.61,  97.01,  90.59,  84.23,
+       98.28,  247.93, 99.52,  280.85, 111.58, 184.39, 51.53,  142.33, 113.13,
+       168.33, 95.21,  89.17,  43.18,  118.93, 86.4,   185.33, 79.3,   76.75,
+       43.97,  66.6,   89.51,  150.02, 75.29,  48.75,  56.83,  310.34, 81.42,
+       291.06, 59.38,  163.59, 132.98, 183.29, 95.09,  106.06, 89.15,  79.73,
+       105.22, 396.49, 69.95,  353.44, 81.95,  185.42, 123.08, 138.1,  85.64,
+       152.32, 110.84, 86.52,  76.54,  195.36, 56.32,  175.28, 65.72,  128.92});
+  Tensor out = tf.zeros({1, 2, 6, 6});
+
+  int64_t stride[] = {2, 2};
+  int64_t padding[] = {1, 1};
+  int64_t dilation[] = {1, 1};
+  int64_t output_padding[] = {1, 1};
+
+  op_convolution_out(
+      input,
+      weight,
+      bias,
+      stride,
+      padding,
+      dilation,
+      true,
+      output_padding,
+      2,
+      out);
+  EXPECT_TENSOR_CLOSE(out, expected);
+}
+
+TEST(OpConvCorrectnessTest, Transposed2DChannelsLast) {
+  TensorFactory<ScalarType::Float> tf;
+
+  // Stride equal to the kernel size, so the output windows don't overlap.
+  Tensor input = tf.make_channels_last(
+      {1, 2, 3, 3},
+      {7.3, 1.8, 8.4, 1.7, 6.8, 9.9, 1.8, 4.9, 2.1, 9.2, 4.4, 8.3, 7.0, 9.7,
+       9.9, 6.7, 9.5, 4.6});
+  Tensor weight = tf.make_channels_last(
+      {2, 3, 2, 2},
+      {5.9, 6.9, 2.4, 9.5, 5.5, 7.3, 5.4, 3.1, 1.7, 1.2, 8.8, 3.7, 4.6, 6.0,
+       6.7, 2.6, 7.3, 6.1, 4.1, 2.0, 8.0, 6.0, 3.1, 4.5});
+  Tensor expected = tf.make_channels_last(
+      {1, 3, 6, 6},
+      {51.35,  61.17,  29.58,  74.03, 53.29,  64.27,  57.38,  68.16,  31.55,
+       84.22,  58.61,  71.69,  85.66, 106.32, 82.65,  90.34,  109.67, 110.03,
+       46.8,   26.23,  26.81,  19.56, 69.82,  35.11,  52.33,  29.44,  27.88,
+       20.28,  79.19,  38.73,  77.31, 40.88,  90.76,  67.56,  90.53,  69.71,
+       33.16,  41.82,  37.15,  29.84, 45.67,  43.03,  54.71,  69.69,  66.68,
+       43.87,  78.71,  71.45,  64.14, 80.16,  66.17,  63.38,  84.79,  82.75,
+       29.81,  15.38,  42.26,  31.56, 31.03,  28.71,  49.06,  24.91,  77.17,
+       57.72,  47.0,   49.17,  57.79, 30.24,  73.88,  55.08,  64.45,  53.63,
+       85.92,  106.5,  81.79,  91.72, 109.31, 110.27, 89.23,  108.51, 68.65,
+       111.47, 103.36, 113.14, 77.21, 93.15,  53.62,  102.21, 85.83,  97.41,
+       77.57,  41.1,   89.5,   66.6,  91.67,  69.55,  80.93,  44.09,  70.43,
+       52.08,  107.89, 66.78,  70.16, 38.65,  52.95,  39.0,   97.86,  55.85});
+  Tensor out = tf.full_channels_last({1, 3, 6, 6}, 0);
+
+  int64_t stride[] = {2, 2};
+  int64_t padding[] = {0, 0};
+  int64_t dilation[] = {1, 1};
+  int64_t output_padding[] = {0, 0};
+
+  op_convolution_out(
+      input,
+      weight,
+      exec_aten::nullopt,
+      stride,
+      padding,
+      dilation,
+      true,
+      output_padding,
+      1,
+      out);
+  EXPECT_TENSOR_CLOSE(out, expected);
+}
+
+TEST(OpConvCorrectnessTest, TransposedInvalidOutputPaddingDies) {
+  TensorFactory<ScalarType::Float> tf;
+
+  Tensor input = tf.ones({1, 2, 4});
+  Tensor weight = tf.ones({2, 3, 3});
+  Tensor out = tf.zeros({1, 3, 11});
+
+  int64_t stride[] = {2};
+  int64_t padding[] = {0};
+  int64_t dilation[] = {1};
+  // Must be smaller than either stride or dilation.
+  int64_t output_padding[] = {2};
+
+  ET_EXPECT_KERNEL_FAILURE(op_convolution_out(
+      input,
+      weight,
+      exec_aten::nullopt,
+      stride,
+      padding,
+      dilation,
+      true,
+      output_padding,
+      1,
+      out));
+}
+
+TEST(OpConvCorrectnessTest, TransposedNonPositiveOutputSizeDies) {
+  TensorFactory<ScalarType::Float> tf;
+
+  Tensor input = tf.ones({1, 2, 1});
+  Tensor weight = tf.ones({2, 3, 1});
+  Tensor out = tf.zeros({1, 3, 1});
+
+  int64_t stride[] = {1};
+  // (1 - 1) * 1 - 2 * 1 + 1 * (1 - 1) + 0 + 1 = -1
+  int64_t padding[] = {1};
+  int64_t dilation[] = {1};
+  int64_t output_padding[] = {0};
+
+  ET_EXPECT_KERNEL_FAILURE(op_convolution_out(
+      input,
+      weight,
+      exec_aten::nullopt,
+      stride,
+      padding,
+      dilation,
+      true,
+      output_padding,
+      1,
+      out));
+}
+
 /* %python
 import torch
 torch.manual_seed(0)
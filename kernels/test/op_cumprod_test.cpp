@@ -0,0 +1,216 @@
+/*
+ * Copyright (c) Meta Platforms, Inc. and affiliates.
+ * All rights reserved.
+ *
+ * This source code is licensed under the BSD-style license found in the
+ * LICENSE file in the root directory of this source tree.
+ */
+
+#include <executorch/kernels/test/FunctionHeaderWrapper.h> // Declares the operator
+#include <executorch/kernels/test/TestUtil.h>
+#include <executorch/kernels/test/supported_features.h>
+#include <executorch/runtime/core/exec_aten/exec_aten.h>
+#include <executorch/runtime/core/exec_aten/testing_util/tensor_factory.h>
+#include <executorch/runtime/core/exec_aten/testing_util/tensor_util.h>
+#include <executorch/runtime/core/exec_aten/util/scalar_type_util.h>
+#include <gtest/gtest.h>
+#include <cmath>
+
+using namespace ::testing;
+using exec_aten::ArrayRef;
+using exec_aten::optional;
+using exec_aten::ScalarType;
+using exec_aten::Tensor;
+using torch::executor::testing::TensorFactory;
+
+Tensor& op_cumprod_out(
+    const Tensor& self,
+    int64_t dim,
+    optional<ScalarType> dtype,
+    Tensor& out) {
+  exec_aten::RuntimeContext context{};
+  return torch::executor::aten::cumprod_outf(context, self, dim, dtype, out);
+}
+
+TEST(OpCumProdOutTest, MismatchedDimensionsDies) {
+  if (torch::executor::testing::SupportedFeatures::get()->is_aten) {
+    GTEST_SKIP() << "ATen kernel can handle mismatched dimensions";
+  }
+  TensorFactory<ScalarType::Float> tff;
+
+  Tensor in = tff.make({1, 3}, {0, 1, 2});
+  Tensor out = tff.zeros({1, 3});
+
+  // Dim out of bounds
+  optional<ScalarType> dtype;
+  ET_EXPECT_KERNEL_FAILURE(op_cumprod_out(in, /*dim=*/3, dtype, out));
+
+  // wrong_out has incompatible dim
+  Tensor wrong_out = tff.zeros({2, 10, 4});
+  ET_EXPECT_KERNEL_FAILURE(op_cumprod_out(in, /*dim=*/1, dtype, wrong_out));
+}
+
+TEST(OpCumProdOutTest, MismatchedDtypeDies) {
+  TensorFactory<ScalarType::Float> tff;
+  TensorFactory<ScalarType::Int> tfi;
+
+  Tensor in = tff.make({1, 3}, {0, 1, 2});
+  Tensor out = tfi.zeros({1, 3});
+
+  // dtype must match out
+  optional<ScalarType> dtype = ScalarType::Float;
+  ET_EXPECT_KERNEL_FAILURE(op_cumprod_out(in, /*dim=*/1, dtype, out));
+}
+
+/* A generic smoke test that works for the supported dtypes with
+ * dtype specified.
+ */
+template <ScalarType IN_DTYPE, ScalarType OUT_DTYPE>
+void test_cumprod_out_dtype() {
+  TensorFactory<IN_DTYPE> tf_in;
+  TensorFactory<OUT_DTYPE> tf_out;
+  // clang-format off
+  Tensor in = tf_in.make(
+    {2, 4},
+    {
+      0, 1, 2, 3,
+      1, 2, 3, 4
+    });
+  // clang-format on
+
+  Tensor out = tf_out.zeros({2, 4});
+  optional<ScalarType> dtype = OUT_DTYPE;
+  op_cumprod_out(in, /*dim=*/1, dtype, out);
+
+  // clang-format off
+  Tensor expected = tf_out.make(
+    {2, 4},
+    {
+      0, 0, 0, 0,
+      1, 2, 6, 24
+    });
+  // clang-format on
+
+  EXPECT_TENSOR_CLOSE(out, expected);
+
+  // negative dim should work
+  op_cumprod_out(in, /*dim=*/-1, dtype, out);
+  EXPECT_TENSOR_CLOSE(out, expected);
+
+  op_cumprod_out(in, /*dim=*/0, dtype, out);
+  // clang-format off
+  expected = tf_out.make(
+    {2, 4},
+    {
+      0, 1, 2, 3,
+      0, 2, 6, 12
+    });
+  // clang-format on
+  EXPECT_TENSOR_CLOSE(out, expected);
+}
+
+TEST(OpCumProdOutTest, DtypePasses) {
+#define TEST_KERNEL(INPUT_CTYPE, INPUT_DTYPE, OUTPUT_CTYPE, OUTPUT_DTYPE) \
+  test_cumprod_out_dtype<ScalarType::INPUT_DTYPE, ScalarType::OUTPUT_DTYPE>();
+
+#define TEST_ENTRY(INPUT_CTYPE, INPUT_DTYPE) \
+  ET_FORALL_REAL_TYPES_WITH2(INPUT_CTYPE, INPUT_DTYPE, TEST_KERNEL);
+
+  ET_FORALL_REAL_TYPES(TEST_ENTRY);
+#undef TEST_ENTRY
+#undef TEST_KERNEL
+}
+
+TEST(OpCumProdOutTest, BoolInput) {
+  TensorFactory<ScalarType::Bool> tf_bool;
+  TensorFactory<ScalarType::Long> tf_long;
+
+  Tensor in = tf_bool.make({1, 4}, {true, true, false, true});
+  Tensor out = tf_long.zeros({1, 4});
+  op_cumprod_out(in, /*dim=*/1, ScalarType::Long, out);
+  EXPECT_TENSOR_EQ(out, tf_long.make({1, 4}, {1, 1, 0, 0}));
+}
+
+TEST(OpCumProdOutTest, ZeroDim) {
+  TensorFactory<ScalarType::Float> tf;
+
+  Tensor in = tf.make({}, {3.5});
+  Tensor out = tf.zeros({});
+  op_cumprod_out(in, /*dim=*/0, ScalarType::Float, out);
+  EXPECT_TENSOR_CLOSE(out, tf.make({}, {3.5}));
+}
+
+template <ScalarType OUT_DTYPE>
+void test_cumprod_out_float() {
+  TensorFactory<ScalarType::Float> tf_float;
+  TensorFactory<OUT_DTYPE> tf_out;
+
+  Tensor in = tf_float.make({1, 2}, {2, INFINITY});
+  Tensor out = tf_out.zeros({1, 2});
+  optional<ScalarType> dtype = OUT_DTYPE;
+  op_cumprod_out(in, /*dim=*/1, dtype, out);
+  EXPECT_TENSOR_CLOSE(out, tf_out.make({1, 2}, {2, INFINITY}));
+
+  in = tf_float.make({1, 2}, {-1, INFINITY});
+  op_cumprod_out(in, /*dim=*/1, dtype, out);
+  EXPECT_TENSOR_CLOSE(out, tf_out.make({1, 2}, {-1, -INFINITY}));
+
+  in = tf_float.make({1, 2}, {1, NAN});
+  op_cumprod_out(in, /*dim=*/1, dtype, out);
+  EXPECT_TENSOR_CLOSE(out, tf_out.make({1, 2}, {1, NAN}));
+
+  in = tf_float.make({1, 2}, {0, INFINITY});
+  op_cumprod_out(in, /*dim=*/1, dtype, out);
+  EXPECT_TENSOR_CLOSE(out, tf_out.make({1, 2}, {0, NAN}));
+}
+
+TEST(OpCumProdOutTest, FloatSpecificTest) {
+// Float/double specific +/-Inf and NAN test
+#define TEST_ENTRY_FLOAT_SPECIFIC_CASES(ctype, dtype) \
+  test_cumprod_out_float<ScalarType::dtype>();
+  ET_FORALL_FLOAT_TYPES(TEST_ENTRY_FLOAT_SPECIFIC_CASES);
+#undef TEST_ENTRY_FLOAT_SPECIFIC_CASES
+}
+
+TEST(OpCumProdOutTest, LargeShapeAlongEachDim) {
+  TensorFactory<ScalarType::Int> tf;
+
+  // Long enough along every dim to cover blocked and tiled scans. The
+  // values are +/-1, so every product is exact.
+  const std::vector<int32_t> sizes = {3, 67, 129};
+  std::vector<int32_t> data(3 * 67 * 129);
+  for (size_t i = 0; i < data.size(); ++i) {
+    data[i] = i % 5 == 0 ? -1 : 1;
+  }
+  Tensor in = tf.make(sizes, data);
+
+  for (int64_t dim = 0; dim < 3; ++dim) {
+    const size_t dim_size = sizes[dim];
+    size_t inner = 1;
+    for (int64_t d = dim + 1; d < 3; ++d) {
+      inner *= sizes[d];
+    }
+    std::vector<int32_t> expected(data);
+    for (size_t i = 0; i < expected.size(); ++i) {
+      if ((i / inner) % dim_size != 0) {
+        expected[i] *= expected[i - inner];
+      }
+    }
+
+    Tensor out = tf.zeros(sizes);
+    op_cumprod_out(in, dim, ScalarType::Int, out);
+    EXPECT_TENSOR_EQ(out, tf.make(sizes, expected));
+  }
+}
+
+TEST(OpCumProdOutTest, DynamicShapeUpperBoundLargerThanExpected) {
+  TensorFactory<ScalarType::Float> tf;
+
+  Tensor x = tf.make({3, 2}, {0.5, 2.0, 1.5, -2.0, 4.0, 0.25});
+  Tensor expected_result = tf.make({3, 2}, {0.5, 1.0, 1.5, -3.0, 4.0, 1.0});
+
+  Tensor out =
+      tf.zeros({10, 10}, torch::executor::TensorShapeDynamism::DYNAMIC_BOUND);
+  op_cumprod_out(x, 1, ScalarType::Float, out);
+  EXPECT_TENSOR_CLOSE(out, expected_result);
+}
@@ -205,6 +205,36 @@ TEST(OpCumSumOutTest, SimpleGeneratedCase) {
   EXPECT_TENSOR_CLOSE(out, expected_result);
 }
 
+TEST(OpCumSumOutTest, LargeShapeAlongEachDim) {
+  TensorFactory<ScalarType::Int> tf;
+
+  // Long enough along every dim to cover blocked and tiled scans.
+  const std::vector<int32_t> sizes = {3, 67, 129};
+  std::vector<int32_t> data(3 * 67 * 129);
+  for (size_t i = 0; i < data.size(); ++i) {
+    data[i] = static_cast<int32_t>(i % 7) - 3;
+  }
+  Tensor in = tf.make(sizes, data);
+
+  for (int64_t dim = 0; dim < 3; ++dim) {
+    const size_t dim_size = sizes[dim];
+    size_t inner = 1;
+    for (int64_t d = dim + 1; d < 3; ++d) {
+      inner *= sizes[d];
+    }
+    std::vector<int32_t> expected(data);
+    for (size_t i = 0; i < expected.size(); ++i) {
+      if ((i / inner) % dim_size != 0) {
+        expected[i] += expected[i - inner];
+      }
+    }
+
+    Tensor out = tf.zeros(sizes);
+    op_cumsum_out(in, dim, ScalarType::Int, out);
+    EXPECT_TENSOR_EQ(out, tf.make(sizes, expected));
+  }
+}
+
 TEST(OpCumSumOutTest, DynamicShapeUpperBoundSameAsExpected) {
   TensorFactory<ScalarType::Float> tf;
 
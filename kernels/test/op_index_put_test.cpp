@@ -542,6 +542,53 @@ TEST(OpIndexPutOutTest, IndicesFewerThanInputDimSupportedSameValue) {
   run_test_cases(x, /*indices=*/indices, values, expected, expected_accum);
 }
 
+TEST(OpIndexPutOutTest, LargeIndexPutRows) {
+  TensorFactory<ScalarType::Double> tf;
+  TensorFactory<ScalarType::Long> tfl;
+
+  // A single index on the middle dim, with repeated values that accumulate.
+  constexpr int32_t kLeading = 3;
+  constexpr int32_t kRows = 50;
+  constexpr int32_t kRowSize = 5;
+  constexpr int32_t kNumIndices = 200;
+
+  std::vector<double> x_data(kLeading * kRows * kRowSize);
+  for (size_t i = 0; i < x_data.size(); ++i) {
+    x_data[i] = static_cast<double>(i);
+  }
+  std::vector<int64_t> index_data(kNumIndices);
+  for (int32_t j = 0; j < kNumIndices; ++j) {
+    index_data[j] = (j * 13) % kRows - (j % 2 == 0 ? kRows : 0);
+  }
+  std::vector<double> values_data(kLeading * kNumIndices * kRowSize);
+  for (size_t i = 0; i < values_data.size(); ++i) {
+    values_data[i] = static_cast<double>(i % 11);
+  }
+  std::vector<double> expected_data(x_data);
+  std::vector<double> expected_accum_data(x_data);
+  for (int32_t l = 0; l < kLeading; ++l) {
+    for (int32_t j = 0; j < kNumIndices; ++j) {
+      const int64_t row = (index_data[j] + kRows) % kRows;
+      for (int32_t k = 0; k < kRowSize; ++k) {
+        const size_t out_ix = (l * kRows + row) * kRowSize + k;
+        const double value = values_data[(l * kNumIndices + j) * kRowSize + k];
+        expected_data[out_ix] = value;
+        expected_accum_data[out_ix] += value;
+      }
+    }
+  }
+
+  Tensor x = tf.make({kLeading, kRows, kRowSize}, x_data);
+  Tensor index = tfl.make({kNumIndices}, index_data);
+  Tensor values = tf.make({kLeading, kNumIndices, kRowSize}, values_data);
+  Tensor expected = tf.make({kLeading, kRows, kRowSize}, expected_data);
+  Tensor expected_accum =
+      tf.make({kLeading, kRows, kRowSize}, expected_accum_data);
+
+  optional<Tensor> indices[] = {optional<Tensor>(), optional<Tensor>(index)};
+  run_test_cases(x, indices, values, expected, expected_accum);
+}
+
 //
 // Test that all dtypes are supported
 //
@@ -366,6 +366,85 @@ TEST(OpIndexTensorOutTest, EmptyIndicesSupported) {
   // ret is still a empty array
 }
 
+TEST(OpIndexTensorOutTest, LargeIndexSelectsRows) {
+  TensorFactory<ScalarType::Double> tf;
+  TensorFactory<ScalarType::Long> tfl;
+
+  // A single index on the middle dim, large enough to be split across
+  // threads, with negative and repeated values.
+  constexpr int32_t kLeading = 3;
+  constexpr int32_t kRows = 500;
+  constexpr int32_t kRowSize = 7;
+  constexpr int32_t kNumIndices = 2000;
+
+  std::vector<double> x_data(kLeading * kRows * kRowSize);
+  for (size_t i = 0; i < x_data.size(); ++i) {
+    x_data[i] = static_cast<double>(i);
+  }
+  std::vector<int64_t> index_data(kNumIndices);
+  for (int32_t j = 0; j < kNumIndices; ++j) {
+    index_data[j] = (j * 37) % kRows - (j % 2 == 0 ? kRows : 0);
+  }
+  std::vector<double> expected_data;
+  for (int32_t l = 0; l < kLeading; ++l) {
+    for (int32_t j = 0; j < kNumIndices; ++j) {
+      const int64_t row = (index_data[j] + kRows) % kRows;
+      for (int32_t k = 0; k < kRowSize; ++k) {
+        expected_data.push_back(x_data[(l * kRows + row) * kRowSize + k]);
+      }
+    }
+  }
+
+  Tensor x = tf.make({kLeading, kRows, kRowSize}, x_data);
+  Tensor index = tfl.make({kNumIndices}, index_data);
+  Tensor expected =
+      tf.make({kLeading, kNumIndices, kRowSize}, expected_data);
+
+  optional<Tensor> indices[] = {optional<Tensor>(), optional<Tensor>(index)};
+  run_test_cases(x, indices, expected);
+}
+
+TEST(OpIndexTensorOutTest, LargeMaskSelectsRows) {
+  TensorFactory<ScalarType::Double> tf;
+  TensorFactory<ScalarType::Bool> tfb;
+
+  // A mask over the middle dims, long enough to be compacted in chunks.
+  constexpr int32_t kLeading = 2;
+  constexpr int32_t kMaskRows = 100;
+  constexpr int32_t kMaskCols = 300;
+  constexpr int32_t kRowSize = 3;
+  constexpr int32_t kMaskSize = kMaskRows * kMaskCols;
+
+  std::vector<double> x_data(kLeading * kMaskSize * kRowSize);
+  for (size_t i = 0; i < x_data.size(); ++i) {
+    x_data[i] = static_cast<double>(i);
+  }
+  std::vector<uint8_t> mask_data(kMaskSize);
+  int32_t num_true = 0;
+  for (int32_t i = 0; i < kMaskSize; ++i) {
+    // Leave long runs of false to exercise the zero-word skipping.
+    mask_data[i] = (i / 1000) % 3 != 1 && i % 7 < 3;
+    num_true += mask_data[i];
+  }
+  std::vector<double> expected_data;
+  for (int32_t l = 0; l < kLeading; ++l) {
+    for (int32_t i = 0; i < kMaskSize; ++i) {
+      if (mask_data[i]) {
+        for (int32_t k = 0; k < kRowSize; ++k) {
+          expected_data.push_back(x_data[(l * kMaskSize + i) * kRowSize + k]);
+        }
+      }
+    }
+  }
+
+  Tensor x = tf.make({kLeading, kMaskRows, kMaskCols, kRowSize}, x_data);
+  Tensor mask = tfb.make({kMaskRows, kMaskCols}, mask_data);
+  Tensor expected = tf.make({kLeading, num_true, kRowSize}, expected_data);
+
+  optional<Tensor> indices[] = {optional<Tensor>(), optional<Tensor>(mask)};
+  run_test_cases(x, indices, expected);
+}
+
 //
 // Test that all dtypes are supported
 //
@@ -0,0 +1,247 @@
+/*
+ * Copyright (c) Meta Platforms, Inc. and affiliates.
+ * All rights reserved.
+ *
+ * This source code is licensed under the BSD-style license found in the
+ * LICENSE file in the root directory of this source tree.
+ */
+
+#include <cmath>
+
+#include <executorch/kernels/test/FunctionHeaderWrapper.h> // Declares the operator
+#include <executorch/kernels/test/TestUtil.h>
+#include <executorch/kernels/test/supported_features.h>
+#include <executorch/runtime/core/exec_aten/exec_aten.h>
+#include <executorch/runtime/core/exec_aten/testing_util/tensor_factory.h>
+#include <executorch/runtime/core/exec_aten/testing_util/tensor_util.h>
+#include <executorch/runtime/core/exec_aten/util/scalar_type_util.h>
+
+#include <gtest/gtest.h>
+
+using namespace ::testing;
+using exec_aten::nullopt;
+using exec_aten::optional;
+using exec_aten::ScalarType;
+using exec_aten::Tensor;
+using torch::executor::testing::TensorFactory;
+
+::std::tuple<Tensor&, Tensor&, Tensor&> op_native_group_norm_out(
+    const Tensor& input,
+    const optional<Tensor>& weight,
+    const optional<Tensor>& bias,
+    int64_t N,
+    int64_t C,
+    int64_t HxW,
+    int64_t group,
+    double eps,
+    Tensor& out0,
+    Tensor& out1,
+    Tensor& out2) {
+  exec_aten::RuntimeContext context{};
+  return torch::executor::aten::native_group_norm_outf(
+      context, input, weight, bias, N, C, HxW, group, eps, out0, out1, out2);
+}
+
+template <ScalarType DTYPE>
+void test_group_norm_affine() {
+  TensorFactory<DTYPE> tf;
+
+  // N = 2, C = 4, HxW = 2, split into 2 groups of 2 channels.
+  // clang-format off
+  Tensor in = tf.make(
+      {2, 4, 2},
+      {
+        0, 1,  2, 3,  4, 5,  6, 7,
+        1, 1,  1, 1,  2, 4,  6, 8,
+      });
+  // clang-format on
+  Tensor weight = tf.make({4}, {1, 2, 0.5, -1});
+  Tensor bias = tf.make({4}, {0, 1, -1, 0.5});
+  Tensor out0 = tf.zeros({2, 4, 2});
+  Tensor out1 = tf.zeros({2, 2});
+  Tensor out2 = tf.zeros({2, 2});
+
+  auto result = op_native_group_norm_out(
+      in,
+      weight,
+      bias,
+      /*N=*/2,
+      /*C=*/4,
+      /*HxW=*/2,
+      /*group=*/2,
+      /*eps=*/1e-5,
+      out0,
+      out1,
+      out2);
+  EXPECT_TENSOR_EQ(out0, std::get<0>(result));
+
+  // clang-format off
+  Tensor expected = tf.make(
+      {2, 4, 2},
+      {
+        -1.341635, -0.447212,  1.894424,  3.683271,
+        -1.670818, -1.223606,  0.052788, -0.841635,
+         0.000000,  0.000000,  1.000000,  1.000000,
+        -1.670820, -1.223607,  0.052787, -0.841639,
+      });
+  // clang-format on
+  EXPECT_TENSOR_CLOSE(out0, expected);
+  EXPECT_TENSOR_CLOSE(out1, tf.make({2, 2}, {1.5, 5.5, 1.0, 5.0}));
+  EXPECT_TENSOR_CLOSE_WITH_TOL(
+      out2,
+      tf.make({2, 2}, {0.894424, 0.894424, 316.227766, 0.447213}),
+      1e-5,
+      1e-5);
+}
+
+TEST(OpNativeGroupNormOutTest, FloatAffine) {
+  test_group_norm_affine<ScalarType::Float>();
+}
+
+TEST(OpNativeGroupNormOutTest, DoubleAffine) {
+  test_group_norm_affine<ScalarType::Double>();
+}
+
+TEST(OpNativeGroupNormOutTest, NoWeightOrBias) {
+  TensorFactory<ScalarType::Float> tf;
+
+  // A single group over [1, 2, 2]: mean 2.5, variance 1.25.
+  Tensor in = tf.make({1, 2, 2}, {1, 2, 3, 4});
+  Tensor out0 = tf.zeros({1, 2, 2});
+  Tensor out1 = tf.zeros({1, 1});
+  Tensor out2 = tf.zeros({1, 1});
+
+  op_native_group_norm_out(
+      in,
+      nullopt,
+      nullopt,
+      /*N=*/1,
+      /*C=*/2,
+      /*HxW=*/2,
+      /*group=*/1,
+      /*eps=*/0.0,
+      out0,
+      out1,
+      out2);
+  EXPECT_TENSOR_CLOSE(
+      out0,
+      tf.make({1, 2, 2}, {-1.341641, -0.447214, 0.447214, 1.341641}));
+  EXPECT_TENSOR_CLOSE(out1, tf.make({1, 1}, {2.5}));
+  EXPECT_TENSOR_CLOSE(out2, tf.make({1, 1}, {0.894427}));
+}
+
+TEST(OpNativeGroupNormOutTest, LargeInputMatchesReference) {
+  TensorFactory<ScalarType::Float> tf;
+
+  // Large enough for the groups to be split across threads, with a spatial
+  // size that is not a multiple of the vector width.
+  const int64_t N = 3;
+  const int64_t C = 12;
+  const int64_t HxW = 1037;
+  const int64_t G = 4;
+  const int64_t D = C / G;
+  std::vector<float> in_data(N * C * HxW);
+  for (size_t i = 0; i < in_data.size(); ++i) {
+    in_data[i] = static_cast<float>((i * 7919) % 1000) / 100.0f - 3.0f;
+  }
+  std::vector<float> weight_data(C);
+  std::vector<float> bias_data(C);
+  for (int64_t c = 0; c < C; ++c) {
+    weight_data[c] = 0.25f * static_cast<float>(c + 1);
+    bias_data[c] = 0.5f - 0.125f * static_cast<float>(c);
+  }
+
+  std::vector<float> expected(in_data.size());
+  std::vector<float> expected_mean(N * G);
+  std::vector<float> expected_rstd(N * G);
+  for (int64_t i = 0; i < N * G; ++i) {
+    const float* x = in_data.data() + i * D * HxW;
+    double sum = 0;
+    for (int64_t j = 0; j < D * HxW; ++j) {
+      sum += x[j];
+    }
+    const double mean = sum / (D * HxW);
+    double sq_sum = 0;
+    for (int64_t j = 0; j < D * HxW; ++j) {
+      sq_sum += (x[j] - mean) * (x[j] - mean);
+    }
+    const double rstd = 1.0 / std::sqrt(sq_sum / (D * HxW) + 1e-5);
+    for (int64_t d = 0; d < D; ++d) {
+      const int64_t c = (i % G) * D + d;
+      for (int64_t j = 0; j < HxW; ++j) {
+        expected[(i * D + d) * HxW + j] =
+            (x[d * HxW + j] - mean) * rstd * weight_data[c] + bias_data[c];
+      }
+    }
+    expected_mean[i] = mean;
+    expected_rstd[i] = rstd;
+  }
+
+  const std::vector<int32_t> sizes = {3, 12, 1037};
+  Tensor in = tf.make(sizes, in_data);
+  Tensor weight = tf.make({12}, weight_data);
+  Tensor bias = tf.make({12}, bias_data);
+  Tensor out0 = tf.zeros(sizes);
+  Tensor out1 = tf.zeros({3, 4});
+  Tensor out2 = tf.zeros({3, 4});
+
+  op_native_group_norm_out(
+      in, weight, bias, N, C, HxW, G, /*eps=*/1e-5, out0, out1, out2);
+  EXPECT_TENSOR_CLOSE_WITH_TOL(out0, tf.make(sizes, expected), 1e-4, 1e-4);
+  EXPECT_TENSOR_CLOSE_WITH_TOL(
+      out1, tf.make({3, 4}, expected_mean), 1e-4, 1e-4);
+  EXPECT_TENSOR_CLOSE_WITH_TOL(
+      out2, tf.make({3, 4}, expected_rstd), 1e-4, 1e-4);
+}
+
+TEST(OpNativeGroupNormOutTest, InvalidArgumentsDie) {
+  TensorFactory<ScalarType::Float> tf;
+
+  Tensor in = tf.ones({2, 6, 3});
+  Tensor out0 = tf.zeros({2, 6, 3});
+  Tensor out1 = tf.zeros({2, 4});
+  Tensor out2 = tf.zeros({2, 4});
+
+  // Channels not divisible by the number of groups
+  ET_EXPECT_KERNEL_FAILURE(op_native_group_norm_out(
+      in,
+      nullopt,
+      nullopt,
+      /*N=*/2,
+      /*C=*/6,
+      /*HxW=*/3,
+      /*group=*/4,
+      /*eps=*/1e-5,
+      out0,
+      out1,
+      out2));
+
+  // Weight does not have one element per channel
+  Tensor weight = tf.ones({3});
+  ET_EXPECT_KERNEL_FAILURE(op_native_group_norm_out(
+      in,
+      weight,
+      nullopt,
+      /*N=*/2,
+      /*C=*/6,
+      /*HxW=*/3,
+      /*group=*/3,
+      /*eps=*/1e-5,
+      out0,
+      out1,
+      out2));
+
+  // N, C and HxW do not describe the input
+  ET_EXPECT_KERNEL_FAILURE(op_native_group_norm_out(
+      in,
+      nullopt,
+      nullopt,
+      /*N=*/2,
+      /*C=*/6,
+      /*HxW=*/4,
+      /*group=*/3,
+      /*eps=*/1e-5,
+      out0,
+      out1,
+      out2));
+}
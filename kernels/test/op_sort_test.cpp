@@ -0,0 +1,234 @@
+/*
+ * Copyright (c) Meta Platforms, Inc. and affiliates.
+ * All rights reserved.
+ *
+ * This source code is licensed under the BSD-style license found in the
+ * LICENSE file in the root directory of this source tree.
+ */
+
+#include <executorch/kernels/test/FunctionHeaderWrapper.h> // Declares the operator
+#include <executorch/kernels/test/TestUtil.h>
+#include <executorch/kernels/test/supported_features.h>
+#include <executorch/runtime/core/exec_aten/exec_aten.h>
+#include <executorch/runtime/core/exec_aten/testing_util/tensor_factory.h>
+#include <executorch/runtime/core/exec_aten/testing_util/tensor_util.h>
+#include <executorch/runtime/core/exec_aten/util/scalar_type_util.h>
+#include <gtest/gtest.h>
+#include <algorithm>
+#include <cmath>
+#include <numeric>
+
+using namespace ::testing;
+using exec_aten::ArrayRef;
+using exec_aten::optional;
+using exec_aten::ScalarType;
+using exec_aten::Tensor;
+using torch::executor::testing::TensorFactory;
+
+std::tuple<Tensor&, Tensor&> op_sort_values(
+    const Tensor& self,
+    int64_t dim,
+    bool descending,
+    Tensor& values,
+    Tensor& indices) {
+  exec_aten::RuntimeContext context{};
+  return torch::executor::aten::sort_outf(
+      context, self, dim, descending, values, indices);
+}
+
+std::tuple<Tensor&, Tensor&> op_sort_values_stable(
+    const Tensor& self,
+    optional<bool> stable,
+    int64_t dim,
+    bool descending,
+    Tensor& values,
+    Tensor& indices) {
+  exec_aten::RuntimeContext context{};
+  return torch::executor::aten::sort_outf(
+      context, self, stable, dim, descending, values, indices);
+}
+
+template <ScalarType DTYPE>
+void test_sort_dtype() {
+  TensorFactory<DTYPE> tf;
+  TensorFactory<ScalarType::Long> tfl;
+
+  Tensor in = tf.make({2, 3}, {3, 1, 2, 0, 5, 4});
+  Tensor values = tf.zeros({2, 3});
+  Tensor indices = tfl.zeros({2, 3});
+
+  op_sort_values(in, /*dim=*/1, /*descending=*/false, values, indices);
+  EXPECT_TENSOR_EQ(values, tf.make({2, 3}, {1, 2, 3, 0, 4, 5}));
+  EXPECT_TENSOR_EQ(indices, tfl.make({2, 3}, {1, 2, 0, 0, 2, 1}));
+
+  op_sort_values(in, /*dim=*/1, /*descending=*/true, values, indices);
+  EXPECT_TENSOR_EQ(values, tf.make({2, 3}, {3, 2, 1, 5, 4, 0}));
+  EXPECT_TENSOR_EQ(indices, tfl.make({2, 3}, {0, 2, 1, 1, 2, 0}));
+}
+
+TEST(OpSortOutTest, AllRealDtypesSupported) {
+#define TEST_ENTRY(ctype, dtype) test_sort_dtype<ScalarType::dtype>();
+  ET_FORALL_REAL_TYPES(TEST_ENTRY);
+#undef TEST_ENTRY
+}
+
+TEST(OpSortOutTest, SortAlongOuterDim) {
+  TensorFactory<ScalarType::Float> tf;
+  TensorFactory<ScalarType::Long> tfl;
+
+  // clang-format off
+  Tensor in = tf.make(
+      {3, 2},
+      {
+        2.5, -1.0,
+        0.5,  4.0,
+        1.5,  3.0,
+      });
+  // clang-format on
+  Tensor values = tf.zeros({3, 2});
+  Tensor indices = tfl.zeros({3, 2});
+
+  op_sort_values(in, /*dim=*/0, /*descending=*/false, values, indices);
+  EXPECT_TENSOR_EQ(values, tf.make({3, 2}, {0.5, -1.0, 1.5, 3.0, 2.5, 4.0}));
+  EXPECT_TENSOR_EQ(indices, tfl.make({3, 2}, {1, 0, 2, 2, 0, 1}));
+
+  op_sort_values(in, /*dim=*/-2, /*descending=*/true, values, indices);
+  EXPECT_TENSOR_EQ(values, tf.make({3, 2}, {2.5, 4.0, 1.5, 3.0, 0.5, -1.0}));
+  EXPECT_TENSOR_EQ(indices, tfl.make({3, 2}, {0, 1, 2, 2, 1, 0}));
+}
+
+TEST(OpSortOutTest, StableSortKeepsOrderOfEqualElements) {
+  TensorFactory<ScalarType::Int> tf;
+  TensorFactory<ScalarType::Long> tfl;
+
+  Tensor in = tf.make({7}, {2, 1, 2, 0, 1, 2, 0});
+  Tensor values = tf.zeros({7});
+  Tensor indices = tfl.zeros({7});
+
+  op_sort_values_stable(
+      in, /*stable=*/true, /*dim=*/0, /*descending=*/false, values, indices);
+  EXPECT_TENSOR_EQ(values, tf.make({7}, {0, 0, 1, 1, 2, 2, 2}));
+  EXPECT_TENSOR_EQ(indices, tfl.make({7}, {3, 6, 1, 4, 0, 2, 5}));
+
+  op_sort_values_stable(
+      in, /*stable=*/true, /*dim=*/0, /*descending=*/true, values, indices);
+  EXPECT_TENSOR_EQ(values, tf.make({7}, {2, 2, 2, 1, 1, 0, 0}));
+  EXPECT_TENSOR_EQ(indices, tfl.make({7}, {0, 2, 5, 1, 4, 3, 6}));
+}
+
+TEST(OpSortOutTest, NaNSortsAboveEveryValue) {
+  TensorFactory<ScalarType::Float> tf;
+  TensorFactory<ScalarType::Long> tfl;
+
+  Tensor in = tf.make({5}, {1.0, NAN, -INFINITY, INFINITY, 0.0});
+  Tensor values = tf.zeros({5});
+  Tensor indices = tfl.zeros({5});
+
+  op_sort_values(in, /*dim=*/0, /*descending=*/false, values, indices);
+  EXPECT_TENSOR_CLOSE(
+      values, tf.make({5}, {-INFINITY, 0.0, 1.0, INFINITY, NAN}));
+  EXPECT_TENSOR_EQ(indices, tfl.make({5}, {2, 4, 0, 3, 1}));
+
+  op_sort_values(in, /*dim=*/0, /*descending=*/true, values, indices);
+  EXPECT_TENSOR_CLOSE(
+      values, tf.make({5}, {NAN, INFINITY, 1.0, 0.0, -INFINITY}));
+  EXPECT_TENSOR_EQ(indices, tfl.make({5}, {1, 3, 0, 4, 2}));
+}
+
+TEST(OpSortOutTest, ZeroDim) {
+  TensorFactory<ScalarType::Float> tf;
+  TensorFactory<ScalarType::Long> tfl;
+
+  Tensor in = tf.make({}, {3.5});
+  Tensor values = tf.zeros({});
+  Tensor indices = tfl.ones({});
+
+  op_sort_values(in, /*dim=*/0, /*descending=*/false, values, indices);
+  EXPECT_TENSOR_EQ(values, in);
+  EXPECT_TENSOR_EQ(indices, tfl.make({}, {0}));
+}
+
+TEST(OpSortOutTest, LargeShapeAlongEachDim) {
+  TensorFactory<ScalarType::Float> tf;
+  TensorFactory<ScalarType::Long> tfl;
+
+  // Distinct values in a scrambled order, so every sort is unique.
+  const std::vector<int32_t> sizes = {5, 33, 17};
+  const int64_t numel = 5 * 33 * 17;
+  std::vector<float> data(numel);
+  for (int64_t i = 0; i < numel; ++i) {
+    data[i] = static_cast<float>((i * 7919) % numel);
+  }
+  Tensor in = tf.make(sizes, data);
+
+  for (int64_t dim = 0; dim < 3; ++dim) {
+    for (bool descending : {false, true}) {
+      const int64_t n = sizes[dim];
+      int64_t inner = 1;
+      for (int64_t d = dim + 1; d < 3; ++d) {
+        inner *= sizes[d];
+      }
+      std::vector<float> expected_values(numel);
+      std::vector<int64_t> expected_indices(numel);
+      for (int64_t row = 0; row < numel / n; ++row) {
+        const int64_t base = (row / inner) * n * inner + row % inner;
+        std::vector<int64_t> order(n);
+        std::iota(order.begin(), order.end(), 0);
+        std::sort(order.begin(), order.end(), [&](int64_t a, int64_t b) {
+          const float va = data[base + a * inner];
+          const float vb = data[base + b * inner];
+          return descending ? va > vb : va < vb;
+        });
+        for (int64_t j = 0; j < n; ++j) {
+          expected_values[base + j * inner] = data[base + order[j] * inner];
+          expected_indices[base + j * inner] = order[j];
+        }
+      }
+
+      Tensor values = tf.zeros(sizes);
+      Tensor indices = tfl.zeros(sizes);
+      op_sort_values(in, dim, descending, values, indices);
+      EXPECT_TENSOR_EQ(values, tf.make(sizes, expected_values));
+      EXPECT_TENSOR_EQ(indices, tfl.make(sizes, expected_indices));
+    }
+  }
+}
+
+TEST(OpSortOutTest, InvalidArgumentsDie) {
+  TensorFactory<ScalarType::Float> tf;
+  TensorFactory<ScalarType::Int> tfi;
+  TensorFactory<ScalarType::Long> tfl;
+
+  Tensor in = tf.make({2, 2}, {1, 0, 3, 2});
+  Tensor values = tf.zeros({2, 2});
+  Tensor indices = tfl.zeros({2, 2});
+
+  // Dim out of range
+  ET_EXPECT_KERNEL_FAILURE(
+      op_sort_values(in, /*dim=*/2, /*descending=*/false, values, indices));
+
+  // Indices must be Long
+  Tensor int_indices = tfi.zeros({2, 2});
+  ET_EXPECT_KERNEL_FAILURE(op_sort_values(
+      in, /*dim=*/1, /*descending=*/false, values, int_indices));
+
+  // Values must have the dtype of the input
+  Tensor int_values = tfi.zeros({2, 2});
+  ET_EXPECT_KERNEL_FAILURE(op_sort_values(
+      in, /*dim=*/1, /*descending=*/false, int_values, indices));
+}
+
+TEST(OpSortOutTest, DynamicShapeUpperBoundLargerThanExpected) {
+  TensorFactory<ScalarType::Float> tf;
+  TensorFactory<ScalarType::Long> tfl;
+
+  Tensor in = tf.make({2, 3}, {0.5, -2.0, 1.5, 4.0, 0.25, 3.0});
+  Tensor values =
+      tf.zeros({10, 10}, torch::executor::TensorShapeDynamism::DYNAMIC_BOUND);
+  Tensor indices =
+      tfl.zeros({10, 10}, torch::executor::TensorShapeDynamism::DYNAMIC_BOUND);
+
+  op_sort_values(in, /*dim=*/1, /*descending=*/false, values, indices);
+  EXPECT_TENSOR_EQ(values, tf.make({2, 3}, {-2.0, 0.5, 1.5, 0.25, 3.0, 4.0}));
+  EXPECT_TENSOR_EQ(indices, tfl.make({2, 3}, {1, 0, 2, 1, 2, 0}));
+}
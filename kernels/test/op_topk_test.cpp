@@ -0,0 +1,290 @@
+/*
+ * Copyright (c) Meta Platforms, Inc. and affiliates.
+ * All rights reserved.
+ *
+ * This source code is licensed under the BSD-style license found in the
+ * LICENSE file in the root directory of this source tree.
+ */
+
+#include <executorch/kernels/test/FunctionHeaderWrapper.h> // Declares the operator
+#include <executorch/kernels/test/TestUtil.h>
+#include <executorch/kernels/test/supported_features.h>
+#include <executorch/runtime/core/exec_aten/exec_aten.h>
+#include <executorch/runtime/core/exec_aten/testing_util/tensor_factory.h>
+#include <executorch/runtime/core/exec_aten/testing_util/tensor_util.h>
+#include <executorch/runtime/core/exec_aten/util/scalar_type_util.h>
+#include <gtest/gtest.h>
+#include <algorithm>
+#include <cmath>
+#include <numeric>
+
+using namespace ::testing;
+using exec_aten::ArrayRef;
+using exec_aten::ScalarType;
+using exec_aten::Tensor;
+using torch::executor::testing::TensorFactory;
+
+std::tuple<Tensor&, Tensor&> op_topk_values(
+    const Tensor& self,
+    int64_t k,
+    int64_t dim,
+    bool largest,
+    bool sorted,
+    Tensor& values,
+    Tensor& indices) {
+  exec_aten::RuntimeContext context{};
+  return torch::executor::aten::topk_outf(
+      context, self, k, dim, largest, sorted, values, indices);
+}
+
+template <ScalarType DTYPE>
+void test_topk_dtype() {
+  TensorFactory<DTYPE> tf;
+  TensorFactory<ScalarType::Long> tfl;
+
+  Tensor in = tf.make({2, 4}, {3, 1, 6, 2, 0, 5, 4, 7});
+  Tensor values = tf.zeros({2, 2});
+  Tensor indices = tfl.zeros({2, 2});
+
+  op_topk_values(
+      in,
+      /*k=*/2,
+      /*dim=*/1,
+      /*largest=*/true,
+      /*sorted=*/true,
+      values,
+      indices);
+  EXPECT_TENSOR_EQ(values, tf.make({2, 2}, {6, 3, 7, 5}));
+  EXPECT_TENSOR_EQ(indices, tfl.make({2, 2}, {2, 0, 3, 1}));
+
+  op_topk_values(
+      in,
+      /*k=*/2,
+      /*dim=*/1,
+      /*largest=*/false,
+      /*sorted=*/true,
+      values,
+      indices);
+  EXPECT_TENSOR_EQ(values, tf.make({2, 2}, {1, 2, 0, 4}));
+  EXPECT_TENSOR_EQ(indices, tfl.make({2, 2}, {1, 3, 0, 2}));
+}
+
+TEST(OpTopkValuesTest, AllRealDtypesSupported) {
+#define TEST_ENTRY(ctype, dtype) test_topk_dtype<ScalarType::dtype>();
+  ET_FORALL_REAL_TYPES(TEST_ENTRY);
+#undef TEST_ENTRY
+}
+
+TEST(OpTopkValuesTest, TopkAlongOuterDim) {
+  TensorFactory<ScalarType::Float> tf;
+  TensorFactory<ScalarType::Long> tfl;
+
+  // clang-format off
+  Tensor in = tf.make(
+      {4, 2},
+      {
+        2.5, -1.0,
+        0.5,  4.0,
+        1.5,  3.0,
+        3.5,  0.0,
+      });
+  // clang-format on
+  Tensor values = tf.zeros({3, 2});
+  Tensor indices = tfl.zeros({3, 2});
+
+  op_topk_values(
+      in,
+      /*k=*/3,
+      /*dim=*/0,
+      /*largest=*/true,
+      /*sorted=*/true,
+      values,
+      indices);
+  EXPECT_TENSOR_EQ(values, tf.make({3, 2}, {3.5, 4.0, 2.5, 3.0, 1.5, 0.0}));
+  EXPECT_TENSOR_EQ(indices, tfl.make({3, 2}, {3, 1, 0, 2, 2, 3}));
+}
+
+TEST(OpTopkValuesTest, KEqualsZeroOrDimSize) {
+  TensorFactory<ScalarType::Float> tf;
+  TensorFactory<ScalarType::Long> tfl;
+
+  Tensor in = tf.make({2, 3}, {0.5, -2.0, 1.5, 4.0, 0.25, 3.0});
+
+  Tensor values = tf.zeros({2, 3});
+  Tensor indices = tfl.zeros({2, 3});
+  op_topk_values(
+      in,
+      /*k=*/3,
+      /*dim=*/1,
+      /*largest=*/true,
+      /*sorted=*/true,
+      values,
+      indices);
+  EXPECT_TENSOR_EQ(values, tf.make({2, 3}, {1.5, 0.5, -2.0, 4.0, 3.0, 0.25}));
+  EXPECT_TENSOR_EQ(indices, tfl.make({2, 3}, {2, 0, 1, 0, 2, 1}));
+
+  Tensor empty_values = tf.zeros({2, 0});
+  Tensor empty_indices = tfl.zeros({2, 0});
+  op_topk_values(
+      in,
+      /*k=*/0,
+      /*dim=*/1,
+      /*largest=*/true,
+      /*sorted=*/true,
+      empty_values,
+      empty_indices);
+  EXPECT_EQ(empty_values.numel(), 0);
+  EXPECT_EQ(empty_indices.numel(), 0);
+}
+
+TEST(OpTopkValuesTest, NaNIsLargest) {
+  TensorFactory<ScalarType::Float> tf;
+  TensorFactory<ScalarType::Long> tfl;
+
+  Tensor in = tf.make({5}, {1.0, NAN, -INFINITY, INFINITY, 0.0});
+  Tensor values = tf.zeros({2});
+  Tensor indices = tfl.zeros({2});
+
+  op_topk_values(
+      in,
+      /*k=*/2,
+      /*dim=*/0,
+      /*largest=*/true,
+      /*sorted=*/true,
+      values,
+      indices);
+  EXPECT_TENSOR_CLOSE(values, tf.make({2}, {NAN, INFINITY}));
+  EXPECT_TENSOR_EQ(indices, tfl.make({2}, {1, 3}));
+
+  op_topk_values(
+      in,
+      /*k=*/2,
+      /*dim=*/0,
+      /*largest=*/false,
+      /*sorted=*/true,
+      values,
+      indices);
+  EXPECT_TENSOR_CLOSE(values, tf.make({2}, {-INFINITY, 0.0}));
+  EXPECT_TENSOR_EQ(indices, tfl.make({2}, {2, 4}));
+}
+
+TEST(OpTopkValuesTest, UnsortedSelectsSameElements) {
+  TensorFactory<ScalarType::Int> tf;
+  TensorFactory<ScalarType::Long> tfl;
+
+  Tensor in = tf.make({8}, {5, 9, 1, 7, 3, 8, 2, 6});
+  Tensor values = tf.zeros({4});
+  Tensor indices = tfl.zeros({4});
+
+  op_topk_values(
+      in,
+      /*k=*/4,
+      /*dim=*/0,
+      /*largest=*/true,
+      /*sorted=*/false,
+      values,
+      indices);
+
+  // Any order is allowed, but every value must match its index.
+  std::vector<int32_t> selected(
+      values.const_data_ptr<int32_t>(), values.const_data_ptr<int32_t>() + 4);
+  for (size_t i = 0; i < 4; ++i) {
+    EXPECT_EQ(
+        selected[i],
+        in.const_data_ptr<int32_t>()[indices.const_data_ptr<int64_t>()[i]]);
+  }
+  std::sort(selected.begin(), selected.end());
+  EXPECT_EQ(selected, std::vector<int32_t>({6, 7, 8, 9}));
+}
+
+TEST(OpTopkValuesTest, LargeShapeAlongEachDim) {
+  TensorFactory<ScalarType::Float> tf;
+  TensorFactory<ScalarType::Long> tfl;
+
+  // Distinct values in a scrambled order, so every selection is unique.
+  const std::vector<int32_t> sizes = {5, 33, 17};
+  const int64_t numel = 5 * 33 * 17;
+  std::vector<float> data(numel);
+  for (int64_t i = 0; i < numel; ++i) {
+    data[i] = static_cast<float>((i * 7919) % numel);
+  }
+  Tensor in = tf.make(sizes, data);
+
+  for (int64_t dim = 0; dim < 3; ++dim) {
+    for (bool largest : {false, true}) {
+      const int64_t n = sizes[dim];
+      const int64_t k = (n + 1) / 2;
+      int64_t inner = 1;
+      for (int64_t d = dim + 1; d < 3; ++d) {
+        inner *= sizes[d];
+      }
+      std::vector<int32_t> out_sizes(sizes);
+      out_sizes[dim] = k;
+      std::vector<float> expected_values(numel / n * k);
+      std::vector<int64_t> expected_indices(numel / n * k);
+      for (int64_t row = 0; row < numel / n; ++row) {
+        const int64_t in_base = (row / inner) * n * inner + row % inner;
+        const int64_t out_base = (row / inner) * k * inner + row % inner;
+        std::vector<int64_t> order(n);
+        std::iota(order.begin(), order.end(), 0);
+        std::sort(order.begin(), order.end(), [&](int64_t a, int64_t b) {
+          const float va = data[in_base + a * inner];
+          const float vb = data[in_base + b * inner];
+          return largest ? va > vb : va < vb;
+        });
+        for (int64_t j = 0; j < k; ++j) {
+          expected_values[out_base + j * inner] =
+              data[in_base + order[j] * inner];
+          expected_indices[out_base + j * inner] = order[j];
+        }
+      }
+
+      Tensor values = tf.zeros(out_sizes);
+      Tensor indices = tfl.zeros(out_sizes);
+      op_topk_values(in, k, dim, largest, /*sorted=*/true, values, indices);
+      EXPECT_TENSOR_EQ(values, tf.make(out_sizes, expected_values));
+      EXPECT_TENSOR_EQ(indices, tfl.make(out_sizes, expected_indices));
+    }
+  }
+}
+
+TEST(OpTopkValuesTest, InvalidArgumentsDie) {
+  TensorFactory<ScalarType::Float> tf;
+  TensorFactory<ScalarType::Int> tfi;
+  TensorFactory<ScalarType::Long> tfl;
+
+  Tensor in = tf.make({2, 2}, {1, 0, 3, 2});
+  Tensor values = tf.zeros({2, 1});
+  Tensor indices = tfl.zeros({2, 1});
+
+  // k larger than the dim
+  ET_EXPECT_KERNEL_FAILURE(op_topk_values(
+      in,
+      /*k=*/3,
+      /*dim=*/1,
+      /*largest=*/true,
+      /*sorted=*/true,
+      values,
+      indices));
+
+  // Dim out of range
+  ET_EXPECT_KERNEL_FAILURE(op_topk_values(
+      in,
+      /*k=*/1,
+      /*dim=*/2,
+      /*largest=*/true,
+      /*sorted=*/true,
+      values,
+      indices));
+
+  // Indices must be Long
+  Tensor int_indices = tfi.zeros({2, 1});
+  ET_EXPECT_KERNEL_FAILURE(op_topk_values(
+      in,
+      /*k=*/1,
+      /*dim=*/1,
+      /*largest=*/true,
+      /*sorted=*/true,
+      values,
+      int_indices));
+}
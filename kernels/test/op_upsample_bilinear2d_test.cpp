@@ -0,0 +1,198 @@
+/*
+ * Copyright (c) Meta Platforms, Inc. and affiliates.
+ * All rights reserved.
+ *
+ * This source code is licensed under the BSD-style license found in the
+ * LICENSE file in the root directory of this source tree.
+ */
+
+#include <executorch/kernels/test/FunctionHeaderWrapper.h> // Declares the operator
+#include <executorch/kernels/test/TestUtil.h>
+#include <executorch/kernels/test/supported_features.h>
+#include <executorch/runtime/core/exec_aten/exec_aten.h>
+#include <executorch/runtime/core/exec_aten/testing_util/tensor_factory.h>
+#include <executorch/runtime/core/exec_aten/testing_util/tensor_util.h>
+
+#include <gtest/gtest.h>
+
+using namespace ::testing;
+using exec_aten::ArrayRef;
+using exec_aten::optional;
+using exec_aten::ScalarType;
+using exec_aten::Tensor;
+using torch::executor::testing::TensorFactory;
+
+Tensor& op_upsample_bilinear2d_vec_out(
+    const Tensor& in,
+    const optional<ArrayRef<int64_t>> output_size,
+    bool align_corners,
+    const optional<ArrayRef<double>> scale_factors,
+    Tensor& out) {
+  exec_aten::RuntimeContext context{};
+  return torch::executor::aten::upsample_bilinear2d_outf(
+      context, in, output_size, align_corners, scale_factors, out);
+}
+
+// Expected values below follow torch.nn.functional.interpolate(
+// mode="bilinear").
+
+template <ScalarType DTYPE>
+void test_upsample_bilinear2d_output_size(bool align_corners) {
+  TensorFactory<DTYPE> tf;
+
+  Tensor in = tf.make({1, 1, 2, 2}, {1, 2, 3, 4});
+  Tensor out = tf.zeros({1, 1, 4, 4});
+  int64_t output_size[] = {4, 4};
+
+  op_upsample_bilinear2d_vec_out(
+      in, ArrayRef<int64_t>(output_size, 2), align_corners, {}, out);
+
+  // clang-format off
+  Tensor expected = align_corners
+      ? tf.make({1, 1, 4, 4}, {
+          1.0,    4.0/3, 5.0/3, 2.0,
+          5.0/3,  2.0,   7.0/3, 8.0/3,
+          7.0/3,  8.0/3, 3.0,   10.0/3,
+          3.0,    10.0/3, 11.0/3, 4.0,
+        })
+      : tf.make({1, 1, 4, 4}, {
+          1.0,  1.25, 1.75, 2.0,
+          1.5,  1.75, 2.25, 2.5,
+          2.5,  2.75, 3.25, 3.5,
+          3.0,  3.25, 3.75, 4.0,
+        });
+  // clang-format on
+  EXPECT_TENSOR_CLOSE(out, expected);
+}
+
+TEST(OpUpsampleBilinear2dOutTest, OutputSize) {
+#define TEST_ENTRY(ctype, dtype)                           \
+  test_upsample_bilinear2d_output_size<ScalarType::dtype>( \
+      /*align_corners=*/false);                            \
+  test_upsample_bilinear2d_output_size<ScalarType::dtype>( \
+      /*align_corners=*/true);
+  ET_FORALL_FLOAT_TYPES(TEST_ENTRY);
+#undef TEST_ENTRY
+}
+
+TEST(OpUpsampleBilinear2dOutTest, Downsample) {
+  TensorFactory<ScalarType::Float> tf;
+
+  Tensor in = tf.make(
+      {1, 1, 4, 4}, {0, 1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11, 12, 13, 14, 15});
+  Tensor out = tf.zeros({1, 1, 2, 3});
+  int64_t output_size[] = {2, 3};
+
+  op_upsample_bilinear2d_vec_out(
+      in, ArrayRef<int64_t>(output_size, 2), /*align_corners=*/false, {}, out);
+  EXPECT_TENSOR_CLOSE(
+      out,
+      tf.make(
+          {1, 1, 2, 3},
+          {13.0 / 6, 3.5, 29.0 / 6, 61.0 / 6, 11.5, 77.0 / 6}));
+
+  op_upsample_bilinear2d_vec_out(
+      in, ArrayRef<int64_t>(output_size, 2), /*align_corners=*/true, {}, out);
+  EXPECT_TENSOR_CLOSE(
+      out, tf.make({1, 1, 2, 3}, {0.0, 1.5, 3.0, 12.0, 13.5, 15.0}));
+}
+
+TEST(OpUpsampleBilinear2dOutTest, ScaleFactors) {
+  TensorFactory<ScalarType::Float> tf;
+
+  Tensor in = tf.make({1, 1, 2, 3}, {1, 2, 3, 4, 5, 6});
+  Tensor out = tf.zeros({1, 1, 4, 4});
+  // The output width is floor(3 * 1.5) = 4, but source coordinates are
+  // computed from the scale factor rather than from 3 / 4.
+  double scale_factors[] = {2.0, 1.5};
+
+  op_upsample_bilinear2d_vec_out(
+      in,
+      {},
+      /*align_corners=*/false,
+      ArrayRef<double>(scale_factors, 2),
+      out);
+
+  // clang-format off
+  Tensor expected = tf.make({1, 1, 4, 4}, {
+      1.0,  1.5,  13.0/6, 17.0/6,
+      1.75, 2.25, 35.0/12, 43.0/12,
+      3.25, 3.75, 53.0/12, 61.0/12,
+      4.0,  4.5,  31.0/6, 35.0/6,
+  });
+  // clang-format on
+  EXPECT_TENSOR_CLOSE(out, expected);
+}
+
+TEST(OpUpsampleBilinear2dOutTest, ChannelsLast) {
+  TensorFactory<ScalarType::Float> tf;
+
+  // Channel 0 holds {1, 2, 3, 4} and channel 1 ten times that.
+  Tensor in = tf.make_channels_last({1, 2, 2, 2}, {1, 10, 2, 20, 3, 30, 4, 40});
+  Tensor out = tf.full_channels_last({1, 2, 4, 4}, 0);
+  int64_t output_size[] = {4, 4};
+
+  op_upsample_bilinear2d_vec_out(
+      in, ArrayRef<int64_t>(output_size, 2), /*align_corners=*/false, {}, out);
+
+  // clang-format off
+  Tensor expected = tf.make_channels_last({1, 2, 4, 4}, {
+      1.0, 10.0, 1.25, 12.5, 1.75, 17.5, 2.0, 20.0,
+      1.5, 15.0, 1.75, 17.5, 2.25, 22.5, 2.5, 25.0,
+      2.5, 25.0, 2.75, 27.5, 3.25, 32.5, 3.5, 35.0,
+      3.0, 30.0, 3.25, 32.5, 3.75, 37.5, 4.0, 40.0,
+  });
+  // clang-format on
+  EXPECT_TENSOR_CLOSE(out, expected);
+}
+
+TEST(OpUpsampleBilinear2dOutTest, BothOutputSizeAndScaleFactorsDies) {
+  if (torch::executor::testing::SupportedFeatures::get()->is_aten) {
+    GTEST_SKIP() << "ATen kernel uses output_size when both are set";
+  }
+  TensorFactory<ScalarType::Float> tf;
+
+  Tensor in = tf.ones({1, 1, 2, 2});
+  Tensor out = tf.zeros({1, 1, 4, 4});
+  int64_t output_size[] = {4, 4};
+  double scale_factors[] = {2.0, 2.0};
+
+  ET_EXPECT_KERNEL_FAILURE(op_upsample_bilinear2d_vec_out(
+      in,
+      ArrayRef<int64_t>(output_size, 2),
+      /*align_corners=*/false,
+      ArrayRef<double>(scale_factors, 2),
+      out));
+}
+
+TEST(OpUpsampleBilinear2dOutTest, NeitherOutputSizeNorScaleFactorsDies) {
+  TensorFactory<ScalarType::Float> tf;
+
+  Tensor in = tf.ones({1, 1, 2, 2});
+  Tensor out = tf.zeros({1, 1, 4, 4});
+
+  ET_EXPECT_KERNEL_FAILURE(op_upsample_bilinear2d_vec_out(
+      in, {}, /*align_corners=*/false, {}, out));
+}
+
+TEST(OpUpsampleBilinear2dOutTest, IntegralInputDies) {
+  TensorFactory<ScalarType::Int> tf;
+
+  Tensor in = tf.ones({1, 1, 2, 2});
+  Tensor out = tf.zeros({1, 1, 4, 4});
+  int64_t output_size[] = {4, 4};
+
+  ET_EXPECT_KERNEL_FAILURE(op_upsample_bilinear2d_vec_out(
+      in, ArrayRef<int64_t>(output_size, 2), /*align_corners=*/false, {}, out));
+}
+
+TEST(OpUpsampleBilinear2dOutTest, WrongRankDies) {
+  TensorFactory<ScalarType::Float> tf;
+
+  Tensor in = tf.ones({1, 2, 2});
+  Tensor out = tf.zeros({1, 4, 4});
+  int64_t output_size[] = {4, 4};
+
+  ET_EXPECT_KERNEL_FAILURE(op_upsample_bilinear2d_vec_out(
+      in, ArrayRef<int64_t>(output_size, 2), /*align_corners=*/false, {}, out));
+}
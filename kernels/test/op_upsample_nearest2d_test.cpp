@@ -0,0 +1,169 @@
+/*
+ * Copyright (c) Meta Platforms, Inc. and affiliates.
+ * All rights reserved.
+ *
+ * This source code is licensed under the BSD-style license found in the
+ * LICENSE file in the root directory of this source tree.
+ */
+
+#include <executorch/kernels/test/FunctionHeaderWrapper.h> // Declares the operator
+#include <executorch/kernels/test/TestUtil.h>
+#include <executorch/kernels/test/supported_features.h>
+#include <executorch/runtime/core/exec_aten/exec_aten.h>
+#include <executorch/runtime/core/exec_aten/testing_util/tensor_factory.h>
+#include <executorch/runtime/core/exec_aten/testing_util/tensor_util.h>
+
+#include <gtest/gtest.h>
+
+using namespace ::testing;
+using exec_aten::ArrayRef;
+using exec_aten::optional;
+using exec_aten::ScalarType;
+using exec_aten::Tensor;
+using torch::executor::testing::TensorFactory;
+
+Tensor& op_upsample_nearest2d_vec_out(
+    const Tensor& in,
+    const optional<ArrayRef<int64_t>> output_size,
+    const optional<ArrayRef<double>> scale_factors,
+    Tensor& out) {
+  exec_aten::RuntimeContext context{};
+  return torch::executor::aten::upsample_nearest2d_outf(
+      context, in, output_size, scale_factors, out);
+}
+
+// Expected values below follow torch.nn.functional.interpolate(
+// mode="nearest").
+
+template <ScalarType DTYPE>
+void test_upsample_nearest2d_output_size() {
+  TensorFactory<DTYPE> tf;
+
+  Tensor in = tf.make({1, 2, 2, 2}, {1, 2, 3, 4, 5, 6, 7, 8});
+  Tensor out = tf.zeros({1, 2, 4, 4});
+  int64_t output_size[] = {4, 4};
+
+  op_upsample_nearest2d_vec_out(in, ArrayRef<int64_t>(output_size, 2), {}, out);
+
+  // clang-format off
+  Tensor expected = tf.make({1, 2, 4, 4}, {
+      1, 1, 2, 2,
+      1, 1, 2, 2,
+      3, 3, 4, 4,
+      3, 3, 4, 4,
+
+      5, 5, 6, 6,
+      5, 5, 6, 6,
+      7, 7, 8, 8,
+      7, 7, 8, 8,
+  });
+  // clang-format on
+  EXPECT_TENSOR_EQ(out, expected);
+}
+
+TEST(OpUpsampleNearest2dOutTest, OutputSize) {
+#define TEST_ENTRY(ctype, dtype) \
+  test_upsample_nearest2d_output_size<ScalarType::dtype>();
+  ET_FORALL_REAL_TYPES(TEST_ENTRY);
+#undef TEST_ENTRY
+}
+
+TEST(OpUpsampleNearest2dOutTest, Bool) {
+  TensorFactory<ScalarType::Bool> tf;
+
+  Tensor in = tf.make({1, 1, 1, 2}, {true, false});
+  Tensor out = tf.zeros({1, 1, 2, 3});
+  int64_t output_size[] = {2, 3};
+
+  op_upsample_nearest2d_vec_out(in, ArrayRef<int64_t>(output_size, 2), {}, out);
+  EXPECT_TENSOR_EQ(
+      out, tf.make({1, 1, 2, 3}, {true, true, false, true, true, false}));
+}
+
+TEST(OpUpsampleNearest2dOutTest, Downsample) {
+  TensorFactory<ScalarType::Float> tf;
+
+  Tensor in = tf.make(
+      {1, 1, 4, 4}, {0, 1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11, 12, 13, 14, 15});
+  Tensor out = tf.zeros({1, 1, 2, 3});
+  int64_t output_size[] = {2, 3};
+
+  op_upsample_nearest2d_vec_out(in, ArrayRef<int64_t>(output_size, 2), {}, out);
+  EXPECT_TENSOR_EQ(out, tf.make({1, 1, 2, 3}, {0, 1, 2, 8, 9, 10}));
+}
+
+TEST(OpUpsampleNearest2dOutTest, ScaleFactors) {
+  TensorFactory<ScalarType::Float> tf;
+
+  Tensor in = tf.make({1, 1, 1, 5}, {0, 1, 2, 3, 4});
+  Tensor out = tf.zeros({1, 1, 1, 6});
+  // The output width is floor(5 * 1.3) = 6. Source columns come from the
+  // scale factor, so the last one is floor(5 / 1.3) = 3 rather than
+  // floor(5 * 5 / 6) = 4.
+  double scale_factors[] = {1.0, 1.3};
+
+  op_upsample_nearest2d_vec_out(
+      in, {}, ArrayRef<double>(scale_factors, 2), out);
+  EXPECT_TENSOR_EQ(out, tf.make({1, 1, 1, 6}, {0, 0, 1, 2, 3, 3}));
+}
+
+TEST(OpUpsampleNearest2dOutTest, ChannelsLast) {
+  TensorFactory<ScalarType::Int> tf;
+
+  // Channel 0 holds {1, 2, 3, 4} and channel 1 ten times that.
+  Tensor in = tf.make_channels_last({1, 2, 2, 2}, {1, 10, 2, 20, 3, 30, 4, 40});
+  Tensor out = tf.full_channels_last({1, 2, 3, 3}, 0);
+  int64_t output_size[] = {3, 3};
+
+  op_upsample_nearest2d_vec_out(in, ArrayRef<int64_t>(output_size, 2), {}, out);
+
+  // clang-format off
+  Tensor expected = tf.make_channels_last({1, 2, 3, 3}, {
+      1, 10, 1, 10, 2, 20,
+      1, 10, 1, 10, 2, 20,
+      3, 30, 3, 30, 4, 40,
+  });
+  // clang-format on
+  EXPECT_TENSOR_EQ(out, expected);
+}
+
+TEST(OpUpsampleNearest2dOutTest, BothOutputSizeAndScaleFactorsDies) {
+  if (torch::executor::testing::SupportedFeatures::get()->is_aten) {
+    GTEST_SKIP() << "ATen kernel uses output_size when both are set";
+  }
+  TensorFactory<ScalarType::Float> tf;
+
+  Tensor in = tf.ones({1, 1, 2, 2});
+  Tensor out = tf.zeros({1, 1, 4, 4});
+  int64_t output_size[] = {4, 4};
+  double scale_factors[] = {2.0, 2.0};
+
+  ET_EXPECT_KERNEL_FAILURE(op_upsample_nearest2d_vec_out(
+      in,
+      ArrayRef<int64_t>(output_size, 2),
+      ArrayRef<double>(scale_factors, 2),
+      out));
+}
+
+TEST(OpUpsampleNearest2dOutTest, NonPositiveOutputSizeDies) {
+  TensorFactory<ScalarType::Float> tf;
+
+  Tensor in = tf.ones({1, 1, 2, 2});
+  Tensor out = tf.zeros({1, 1, 4, 4});
+  int64_t output_size[] = {4, 0};
+
+  ET_EXPECT_KERNEL_FAILURE(op_upsample_nearest2d_vec_out(
+      in, ArrayRef<int64_t>(output_size, 2), {}, out));
+}
+
+TEST(OpUpsampleNearest2dOutTest, MismatchedDtypeDies) {
+  TensorFactory<ScalarType::Float> tf;
+  TensorFactory<ScalarType::Int> tf_int;
+
+  Tensor in = tf.ones({1, 1, 2, 2});
+  Tensor out = tf_int.zeros({1, 1, 4, 4});
+  int64_t output_size[] = {4, 4};
+
+  ET_EXPECT_KERNEL_FAILURE(op_upsample_nearest2d_vec_out(
+      in, ArrayRef<int64_t>(output_size, 2), {}, out));
+}
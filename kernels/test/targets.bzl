@@ -173,7 +173,7 @@ def define_common_targets():
     _common_op_test("op_asinh_test", ["aten", "portable"])
     _common_op_test("op_atan_test", ["aten", "portable"])
     _common_op_test("op_atanh_test", ["aten", "portable"])
-    _common_op_test("op_avg_pool2d_test", ["aten", "portable"])
+    _common_op_test("op_avg_pool2d_test", ["aten", "portable", "optimized"])
     _common_op_test("op_bitwise_and_test", ["aten", "portable"])
     _common_op_test("op_bitwise_not_test", ["aten", "portable"])
     _common_op_test("op_bitwise_or_test", ["aten", "portable"])
@@ -184,11 +184,12 @@ def define_common_targets():
     _common_op_test("op_clamp_test", ["aten", "portable"])
     _common_op_test("op_clone_test", ["aten", "portable"])
     _common_op_test("op_constant_pad_nd_test", ["aten", "portable"])
-    _common_op_test("op_convolution_test", ["aten", "portable"])
+    _common_op_test("op_convolution_test", ["aten", "portable", "optimized"])
     _common_op_test("op_copy_test", ["aten", "portable"])
     _common_op_test("op_cos_test", ["aten", "portable"])
     _common_op_test("op_cosh_test", ["aten", "portable"])
-    _common_op_test("op_cumsum_test", ["aten", "portable"])
+    _common_op_test("op_cumprod_test", ["aten", "portable", "optimized"])
+    _common_op_test("op_cumsum_test", ["aten", "portable", "optimized"])
     _common_op_test("op_detach_copy_test", ["aten", "portable"])
     _common_op_test("op_div_test", ["aten", "portable", "optimized"])
     _common_op_test("op_embedding_test", ["aten", "portable"])
@@ -209,8 +210,8 @@ def define_common_targets():
     _common_op_test("op_gt_test", ["aten", "portable"])
     _common_op_test("op_hardtanh_test", ["aten", "portable"])
     _common_op_test("op_index_put_test", ["aten", "portable"])
-    _common_op_test("op_index_select_test", ["aten", "portable"])
-    _common_op_test("op_index_test", ["aten", "portable"])
+    _common_op_test("op_index_select_test", ["aten", "portable", "optimized"])
+    _common_op_test("op_index_test", ["aten", "portable", "optimized"])
     _common_op_test("op_isinf_test", ["aten", "portable"])
     _common_op_test("op_isnan_test", ["aten", "portable"])
     _common_op_test("op_le_test", ["aten", "portable", "optimized"])
@@ -226,7 +227,7 @@ def define_common_targets():
     _common_op_test("op_lt_test", ["aten", "portable"])
     _common_op_test("op_masked_fill_test", ["aten", "portable"])
     _common_op_test("op_max_test", ["aten", "portable"])
-    _common_op_test("op_max_pool2d_with_indices_test", ["aten", "portable"])
+    _common_op_test("op_max_pool2d_with_indices_test", ["aten", "portable", "optimized"])
     _common_op_test("op_mean_test", ["aten", "portable"])
     _common_op_test("op_min_test", ["aten", "portable"])
     _common_op_test("op_minimum_test", ["aten", "portable"])
@@ -234,6 +235,7 @@ def define_common_targets():
     _common_op_test("op_mul_test", ["aten", "portable", "optimized"])
     _common_op_test("op_pow_test", ["aten", "portable"])
     _common_op_test("op_native_batch_norm_test", ["aten", "portable"])
+    _common_op_test("op_native_group_norm_test", ["aten", "portable", "optimized"])
     _common_op_test("op_native_layer_norm_test", ["aten", "portable", "optimized"])
     _common_op_test("op_ne_test", ["aten", "portable"])
     _common_op_test("op_neg_test", ["aten", "portable", "optimized"])
@@ -259,6 +261,7 @@ def define_common_targets():
     _common_op_test("op_slice_scatter_test", ["aten", "portable"])
     _common_op_test("op_slice_copy_test", ["aten", "portable"])
     _common_op_test("op_softmax_test", ["aten", "portable"])
+    _common_op_test("op_sort_test", ["aten", "portable", "optimized"])
     _common_op_test("op_split_copy_test", ["aten", "portable"])
     _common_op_test("op_split_with_sizes_copy_test", ["aten", "portable"])
     _common_op_test("op_sqrt_test", ["aten", "portable"])
@@ -269,11 +272,14 @@ def define_common_targets():
     _common_op_test("op_t_copy_test", ["aten", "portable"])
     _common_op_test("op_tan_test", ["aten", "portable"])
     _common_op_test("op_tanh_test", ["aten", "portable"])
-    _common_op_test("op_to_copy_test", ["aten", "portable"])
+    _common_op_test("op_to_copy_test", ["aten", "portable", "optimized"])
+    _common_op_test("op_topk_test", ["aten", "portable", "optimized"])
     _common_op_test("op_transpose_copy_test", ["aten", "portable"])
     _common_op_test("op_tril_test", ["aten", "portable"])
     _common_op_test("op_unbind_copy_test", ["aten", "portable"])
     _common_op_test("op_unsqueeze_copy_test", ["aten", "portable"])
+    _common_op_test("op_upsample_bilinear2d_test", ["aten", "portable", "optimized"])
+    _common_op_test("op_upsample_nearest2d_test", ["aten", "portable", "optimized"])
     _common_op_test("op_var_test", ["aten", "portable"])
     _common_op_test("op_view_copy_test", ["aten", "portable"])
     _common_op_test("op_where_test", ["aten", "portable"])
@@ -56,5 +56,19 @@ Error BackendRegistry::register_backend(const Backend& backend) {
   return Error::Ok;
 }
 
+Error freeze_backends() {
+  return getBackendRegistry().freeze_backends();
+}
+
+Error BackendRegistry::freeze_backends() {
+  for (size_t idx = 0; idx < registrationTableSize_; idx++) {
+    Error err = backend_table_[idx].interface_ptr_->freeze();
+    if (err != Error::Ok) {
+      return err;
+    }
+  }
+  return Error::Ok;
+}
+
 } // namespace executor
 } // namespace torch
@@ -105,6 +105,22 @@ class PyTorchBackendInterface {
    *     `init()`.
    */
   virtual void destroy(__ET_UNUSED DelegateHandle* handle) const {}
+
+  /**
+   * Called once every delegate that the process will use has been initialized,
+   * typically right before the process forks workers that execute them. The
+   * backend may move state shared by its handles, like packed weights, into
+   * memory that it never writes again, so that forked processes keep sharing
+   * its pages instead of each faulting in a private copy.
+   *
+   * `init()` may still be called afterwards, but the backend does not need to
+   * share what it creates then.
+   *
+   * @retval Error::Ok if successful.
+   */
+  __ET_NODISCARD virtual Error freeze() const {
+    return Error::Ok;
+  }
 };
 
 struct Backend {
@@ -142,6 +158,13 @@ class BackendRegistry {
    */
   PyTorchBackendInterface* get_backend_class(const char* name);
 
+  /**
+   * Calls `freeze()` on every registered backend.
+   *
+   * @retval Error::Ok if all backends froze; otherwise the first error.
+   */
+  __ET_NODISCARD Error freeze_backends();
+
  private:
   Backend backend_table_[kRegistrationTableMaxSize];
   size_t registrationTableSize_;
@@ -167,5 +190,13 @@ PyTorchBackendInterface* get_backend_class(const char* name);
  */
 __ET_NODISCARD Error register_backend(const Backend& backend);
 
+/**
+ * Calls `freeze()` on every registered backend. See
+ * PyTorchBackendInterface::freeze().
+ *
+ * @retval Error::Ok if all backends froze; otherwise the first error.
+ */
+__ET_NODISCARD Error freeze_backends();
+
 } // namespace executor
 } // namespace torch
@@ -44,6 +44,9 @@ enum class Error : error_code_t {
   /// Status indicating there are no more steps of execution to run
   EndOfMethod = 0x03,
 
+  /// Status indicating execution was cancelled before it finished
+  Cancelled = 0x04,
+
   /*
    * Logical errors.
    */
@@ -571,11 +571,9 @@ inline exec_aten::ScalarType promoteTypes(
 inline size_t sizeof_scalar_type(exec_aten::ScalarType type) {
   // Reject types that are not yet supported or are out of bounds.
   ET_CHECK_MSG(
-      type != exec_aten::ScalarType::Half &&
-          type != exec_aten::ScalarType::ComplexHalf &&
+      type != exec_aten::ScalarType::ComplexHalf &&
           type != exec_aten::ScalarType::ComplexFloat &&
           type != exec_aten::ScalarType::ComplexDouble &&
-          type != exec_aten::ScalarType::BFloat16 &&
           type != exec_aten::ScalarType::Undefined,
       "Invalid or unsupported ScalarType %" PRId8,
       static_cast<int8_t>(type));
@@ -109,6 +109,15 @@ class FunctionRef<Ret(Params...)> {
   explicit operator bool() const {
     return storage_.function;
   }
+
+  /// True if both refer to the same function.
+  bool operator==(const FunctionRef& other) const {
+    return storage_.function == other.storage_.function;
+  }
+
+  bool operator!=(const FunctionRef& other) const {
+    return !(*this == other);
+  }
 };
 
 } // namespace executor
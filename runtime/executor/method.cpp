@@ -11,7 +11,10 @@
 #include <cinttypes>
 #include <cstdint>
 #include <cstdio>
+#include <cstring>
 
+#include <executorch/kernels/prim_ops/register_prim_ops.h>
+#include <executorch/kernels/prim_ops/scalar_prim_ops.h>
 #include <executorch/runtime/backend/interface.h>
 #include <executorch/runtime/core/event_tracer_hooks.h>
 #include <executorch/runtime/core/exec_aten/util/dim_order_util.h>
@@ -198,6 +201,30 @@ class BackendDelegate final {
   DelegateHandle* handle_;
 };
 
+/**
+ * How a KernelCall instruction whose operator is a scalar prim op (e.g.
+ * aten::sym_size.int, executorch_prim::add.Scalar) is executed. These ops are
+ * evaluated inline by the interpreter instead of through a registered kernel.
+ */
+struct ScalarPrimOpCall {
+  /// The op to evaluate, or ScalarPrimOp::None for regular kernels.
+  function::ScalarPrimOp op;
+  /// True if the result was computed during Method::init() because all of
+  /// the inputs are constant; the instruction is then a no-op.
+  bool folded;
+};
+
+/**
+ * A KernelCall instruction whose kernel was prepared by Method::init(). The
+ * interpreter runs it by calling `execute` with `plan` instead of the kernel's
+ * OpFunction.
+ */
+struct PreparedCall {
+  /// nullptr if the instruction was not prepared.
+  PreparedOpFunction execute;
+  const void* plan;
+};
+
 /**
  * Runtime state for a chain of instructions.
  */
@@ -207,8 +234,37 @@ struct Chain {
 
   /// Each entry is a list of parameters for a kernel or delegate call.
   Span<InstructionArgs> argument_lists_;
-  /// Each instruction will have one kernel (not for delegate).
-  OpFunction* kernels_;
+  /// Each instruction will have one kernel (not for delegate). Points into
+  /// the operator registry.
+  const Kernel** kernels_;
+  /// Each entry describes whether the instruction is a scalar prim op.
+  ScalarPrimOpCall* scalar_prim_ops_;
+  /// Each entry is the plan built for the instruction's kernel, if any.
+  /// nullptr if no instruction in the chain was prepared.
+  PreparedCall* prepared_calls_;
+};
+
+/**
+ * A loop whose body output (copy_from) is stacked into copy_to by
+ * et_copy_index. After each iteration copy_from is pointed at the next slice
+ * of copy_to, so the next iteration's kernel writes its result in place and
+ * et_copy_index has nothing left to copy.
+ */
+struct CopyIndexLoop {
+  /// Location of the et_copy_index instruction.
+  size_t chain_idx;
+  size_t instr_idx;
+  /// Value indices of the et_copy_index arguments.
+  size_t copy_to;
+  size_t copy_from;
+  size_t index;
+  /// Planned data of copy_from, used whenever the next slice doesn't fit.
+  void* copy_from_home;
+  /// Planned data of copy_to; slices are only used while it is unchanged.
+  void* copy_to_home;
+  /// Upper bound on copy_from's size; copy_to's planned size.
+  size_t max_slice_nbytes;
+  size_t capacity;
 };
 
 namespace {
@@ -216,11 +272,19 @@ namespace {
 Result<InstructionArgs> gen_instruction_arguments(
     MemoryAllocator* method_allocator,
     EValue* values,
+    size_t num_values,
     size_t num_args,
     const int32_t* arg_idxs) {
   EValue** arg_list =
       ET_ALLOCATE_LIST_OR_RETURN_ERROR(method_allocator, EValue*, num_args);
   for (size_t i = 0; i < num_args; ++i) {
+    ET_CHECK_OR_RETURN_ERROR(
+        arg_idxs[i] >= 0 && static_cast<size_t>(arg_idxs[i]) < num_values,
+        InvalidProgram,
+        "Argument %zu refers to value %" PRId32 " of %zu",
+        i,
+        arg_idxs[i],
+        num_values);
     arg_list[i] = &values[arg_idxs[i]];
   }
   return InstructionArgs(arg_list, num_args);
@@ -262,6 +326,71 @@ bool parse_cond_value(const EValue& cond_value) {
   return true;
 }
 
+/// How an instruction uses a value.
+enum class ValueUse : uint8_t {
+  /// The instruction doesn't refer to the value.
+  None,
+  /// The value is only the out argument (the last argument) of a KernelCall.
+  KernelOut,
+  /// The value is read by a KernelCall.
+  KernelIn,
+  /// Any other use, e.g. delegate args, MoveCall, FreeCall or a jump
+  /// condition.
+  Other,
+};
+
+ValueUse get_value_use(
+    const executorch_flatbuffer::Instruction* instruction,
+    size_t value_index) {
+  switch (instruction->instr_args_type()) {
+    case executorch_flatbuffer::InstructionArguments::KernelCall: {
+      auto args = instruction->instr_args_as_KernelCall()->args();
+      const size_t n_args = args->size();
+      for (size_t i = 0; i + 1 < n_args; ++i) {
+        if (args->Get(i) == value_index) {
+          return ValueUse::KernelIn;
+        }
+      }
+      return n_args > 0 && args->Get(n_args - 1) == value_index
+          ? ValueUse::KernelOut
+          : ValueUse::None;
+    }
+    case executorch_flatbuffer::InstructionArguments::DelegateCall: {
+      auto args = instruction->instr_args_as_DelegateCall()->args();
+      for (size_t i = 0; i < args->size(); ++i) {
+        if (args->Get(i) == value_index) {
+          return ValueUse::Other;
+        }
+      }
+      return ValueUse::None;
+    }
+    case executorch_flatbuffer::InstructionArguments::MoveCall: {
+      auto move_call = instruction->instr_args_as_MoveCall();
+      return move_call->move_from() == value_index ||
+              move_call->move_to() == value_index
+          ? ValueUse::Other
+          : ValueUse::None;
+    }
+    case executorch_flatbuffer::InstructionArguments::FreeCall:
+      return instruction->instr_args_as_FreeCall()->value_index() ==
+              value_index
+          ? ValueUse::Other
+          : ValueUse::None;
+    case executorch_flatbuffer::InstructionArguments::JumpFalseCall:
+      return instruction->instr_args_as_JumpFalseCall()->cond_value_index() ==
+              value_index
+          ? ValueUse::Other
+          : ValueUse::None;
+    default:
+      return ValueUse::Other;
+  }
+}
+
+/// Writer counts from Method::count_value_writers() saturate at this value.
+constexpr uint8_t kManyWriters = UINT8_MAX - 1;
+/// Marks values whose EValue may be replaced outright during execution.
+constexpr uint8_t kValueReplaced = UINT8_MAX;
+
 } // namespace
 
 Error Method::parse_values() {
@@ -438,7 +567,8 @@ static void populateOperatorName(
 
 Error Method::resolve_operator(
     int32_t op_index,
-    OpFunction* kernels,
+    const Kernel** kernels,
+    ScalarPrimOpCall* scalar_prim_ops,
     size_t kernel_index,
     InstructionArgs args,
     size_t n_args) {
@@ -480,9 +610,18 @@ Error Method::resolve_operator(
     }
   }
   // search kernel
-  if (hasOpsFn(operator_name, ArrayRef<TensorMeta>(meta, count))) {
-    kernels[kernel_index] =
-        getOpsFn(operator_name, ArrayRef<TensorMeta>(meta, count));
+  const Kernel* kernel =
+      get_kernel(operator_name, ArrayRef<TensorMeta>(meta, count));
+  if (kernel != nullptr) {
+    kernels[kernel_index] = kernel;
+    // The prim ops library's own scalar prim op kernels are evaluated inline
+    // by execute_instruction() instead.
+    function::ScalarPrimOp prim_op =
+        function::get_registered_scalar_prim_op(*kernel);
+    if (prim_op != function::ScalarPrimOp::None &&
+        function::scalar_prim_op_num_args(prim_op) == n_args) {
+      scalar_prim_ops[kernel_index] = ScalarPrimOpCall{prim_op, false};
+    }
     return Error::Ok;
   } else {
     ET_LOG(Error, "Missing operator: [%d] %s", op_index, operator_name);
@@ -490,6 +629,543 @@ Error Method::resolve_operator(
   }
 }
 
+void Method::count_value_writers(uint8_t* writers) const {
+  memset(writers, 0, n_value_);
+  auto add_writer = [&](size_t value_index) {
+    if (value_index < n_value_ && writers[value_index] < kManyWriters) {
+      writers[value_index]++;
+    }
+  };
+  auto replace = [&](size_t value_index) {
+    if (value_index < n_value_) {
+      writers[value_index] = kValueReplaced;
+    }
+  };
+
+  // The caller can set any input. Tensor inputs keep their TensorImpl and
+  // only get new data; other inputs are replaced.
+  const auto inputs = serialization_plan_->inputs();
+  for (size_t i = 0; inputs != nullptr && i < inputs->size(); ++i) {
+    const int32_t value_index = inputs->Get(i);
+    if (value_index >= 0 && static_cast<size_t>(value_index) < n_value_) {
+      if (values_[value_index].isTensor()) {
+        add_writer(value_index);
+      } else {
+        replace(value_index);
+      }
+    }
+  }
+
+  // Kernels write their out arguments, which trail the inputs. Multi-output
+  // out-variants such as max_pool2d_with_indices.out or sort.values write
+  // several of them, so count the whole trailing run of Tensor and TensorList
+  // args; for ops like mm.out that also counts tensor inputs, which is only
+  // conservative. The last argument is always counted, since for custom ops
+  // it may be a scalar rather than a Tensor. Delegates are opaque; assume
+  // they may write any of their args. Moves replace their destination,
+  // rebinding tensors to another TensorImpl.
+  for (size_t chain_idx = 0; chain_idx < n_chains_; ++chain_idx) {
+    const Chain& chain = chains_[chain_idx];
+    auto instructions = chain.s_chain_->instructions();
+    for (size_t instr_idx = 0; instr_idx < instructions->size(); ++instr_idx) {
+      auto instruction = instructions->Get(instr_idx);
+      switch (instruction->instr_args_type()) {
+        case executorch_flatbuffer::InstructionArguments::KernelCall: {
+          if (chain.scalar_prim_ops_[instr_idx].folded) {
+            break;
+          }
+          auto arg_idxs = instruction->instr_args_as_KernelCall()->args();
+          size_t i = arg_idxs->size();
+          if (i > 0) {
+            add_writer(arg_idxs->Get(--i));
+          }
+          while (i > 0) {
+            const int32_t value_index = arg_idxs->Get(--i);
+            if (value_index < 0 ||
+                static_cast<size_t>(value_index) >= n_value_ ||
+                !(values_[value_index].isTensor() ||
+                  values_[value_index].isTensorList())) {
+              break;
+            }
+            add_writer(value_index);
+          }
+        } break;
+        case executorch_flatbuffer::InstructionArguments::DelegateCall: {
+          auto arg_idxs = instruction->instr_args_as_DelegateCall()->args();
+          for (size_t i = 0; i < arg_idxs->size(); ++i) {
+            add_writer(arg_idxs->Get(i));
+          }
+        } break;
+        case executorch_flatbuffer::InstructionArguments::MoveCall: {
+          replace(instruction->instr_args_as_MoveCall()->move_to());
+        } break;
+        default:
+          break;
+      }
+    }
+  }
+}
+
+void Method::fold_constant_scalar_prim_ops() {
+  bool has_foldable_ops = false;
+  for (size_t chain_idx = 0; chain_idx < n_chains_ && !has_foldable_ops;
+       ++chain_idx) {
+    const Chain& chain = chains_[chain_idx];
+    const size_t n_instructions = chain.s_chain_->instructions()->size();
+    for (size_t instr_idx = 0; instr_idx < n_instructions; ++instr_idx) {
+      if (function::scalar_prim_op_is_foldable(
+              chain.scalar_prim_ops_[instr_idx].op)) {
+        has_foldable_ops = true;
+        break;
+      }
+    }
+  }
+  if (!has_foldable_ops) {
+    return;
+  }
+
+  // Folding needs a scratch count of writers per value. It is an
+  // optimization only, so skip it if there is no temp memory to use.
+  MemoryAllocator* temp_allocator = memory_manager_->temp_allocator();
+  if (temp_allocator == nullptr) {
+    return;
+  }
+  uint8_t* writers = temp_allocator->allocateList<uint8_t>(n_value_);
+  if (writers == nullptr) {
+    temp_allocator->reset();
+    return;
+  }
+  count_value_writers(writers);
+
+  // In execution order, evaluate the ops whose inputs are never written and
+  // whose output is written only by the op itself. Their outputs become
+  // constants in turn, so chains like (c0 + c1) * c2 fold completely.
+  for (size_t chain_idx = 0; chain_idx < n_chains_; ++chain_idx) {
+    Chain& chain = chains_[chain_idx];
+    auto instructions = chain.s_chain_->instructions();
+    for (size_t instr_idx = 0; instr_idx < instructions->size(); ++instr_idx) {
+      ScalarPrimOpCall& prim_op = chain.scalar_prim_ops_[instr_idx];
+      if (!function::scalar_prim_op_is_foldable(prim_op.op)) {
+        continue;
+      }
+      auto arg_idxs =
+          instructions->Get(instr_idx)->instr_args_as_KernelCall()->args();
+      // Argument indices were checked against n_value_ when the argument
+      // lists were built.
+      const size_t n_args = arg_idxs->size();
+      bool foldable = writers[arg_idxs->Get(n_args - 1)] == 1;
+      for (size_t i = 0; foldable && i < n_args - 1; ++i) {
+        const size_t value_index = arg_idxs->Get(i);
+        foldable =
+            writers[value_index] == 0 && !values_[value_index].isTensor();
+      }
+      if (!foldable) {
+        continue;
+      }
+      Error err = function::eval_scalar_prim_op(
+          prim_op.op, chain.argument_lists_[instr_idx].data());
+      if (err == Error::Ok) {
+        // Leave failures to execute(), which reports them with context.
+        prim_op.folded = true;
+        writers[arg_idxs->Get(n_args - 1)] = 0;
+      }
+    }
+  }
+
+  temp_allocator->reset();
+}
+
+Error Method::prepack_constant_args() {
+  // The packed forms created so far, so that a constant used by several
+  // instructions is only packed once per prepack function.
+  struct PackedArg {
+    size_t value_index;
+    PrepackFunction fn;
+    EValue* packed;
+    PackedArg* next;
+  };
+  PackedArg* packed_args = nullptr;
+
+  constexpr size_t kTempBufferSizeForName = 100;
+  char operator_name[kTempBufferSizeForName];
+  auto method_allocator = memory_manager_->method_allocator();
+  const auto ops = serialization_plan_->operators();
+  const auto values = serialization_plan_->values();
+  for (size_t chain_idx = 0; chain_idx < n_chains_; ++chain_idx) {
+    Chain& chain = chains_[chain_idx];
+    auto instructions = chain.s_chain_->instructions();
+    for (size_t instr_idx = 0; instr_idx < instructions->size(); ++instr_idx) {
+      auto instruction = instructions->Get(instr_idx);
+      if (instruction->instr_args_type() !=
+              executorch_flatbuffer::InstructionArguments::KernelCall ||
+          chain.scalar_prim_ops_[instr_idx].op !=
+              function::ScalarPrimOp::None) {
+        continue;
+      }
+      // Only the kernel the instruction resolved to understands the packed
+      // forms of its arguments.
+      ArrayRef<Prepack> prepacks = chain.kernels_[instr_idx]->prepacks_;
+      if (prepacks.empty()) {
+        continue;
+      }
+      auto kernel_call = instruction->instr_args_as_KernelCall();
+      auto arg_idxs = kernel_call->args();
+      InstructionArgs args = chain.argument_lists_[instr_idx];
+      for (const Prepack& prepack : prepacks) {
+        const size_t arg_index = prepack.arg_index_;
+        const PrepackFunction fn = prepack.fn_;
+        if (arg_index >= arg_idxs->size()) {
+          continue;
+        }
+        // Only constants can be packed ahead of time.
+        const size_t value_index = arg_idxs->Get(arg_index);
+        const auto s_value = values->Get(value_index);
+        if (s_value->val_type() != executorch_flatbuffer::KernelTypes::Tensor ||
+            s_value->val_as_Tensor()->constant_buffer_idx() == 0) {
+          continue;
+        }
+
+        PackedArg* packed_arg = packed_args;
+        while (packed_arg != nullptr &&
+               (packed_arg->value_index != value_index ||
+                packed_arg->fn != fn)) {
+          packed_arg = packed_arg->next;
+        }
+        if (packed_arg == nullptr) {
+          EValue* packed =
+              ET_ALLOCATE_INSTANCE_OR_RETURN_ERROR(method_allocator, EValue);
+          new (packed) EValue();
+          Error err = fn(method_allocator, values_[value_index], packed);
+          if (err != Error::Ok) {
+            populateOperatorName(
+                ops->Get(kernel_call->op_index()),
+                kTempBufferSizeForName,
+                operator_name);
+            ET_LOG(
+                Error,
+                "Prepacking argument %zu of %s failed: 0x%" PRIx32,
+                arg_index,
+                operator_name,
+                static_cast<uint32_t>(err));
+            return Error::InvalidProgram;
+          }
+          packed_arg = ET_ALLOCATE_INSTANCE_OR_RETURN_ERROR(
+              method_allocator, PackedArg);
+          *packed_arg = PackedArg{
+              value_index,
+              fn,
+              packed->isNone() ? nullptr : packed,
+              packed_args};
+          packed_args = packed_arg;
+        }
+        if (packed_arg->packed != nullptr) {
+          // Only this instruction sees the packed form; the value itself and
+          // any other users of it are left as they were.
+          args[arg_index] = packed_arg->packed;
+        }
+      }
+    }
+  }
+  return Error::Ok;
+}
+
+Error Method::prepare_kernels() {
+#ifndef USE_ATEN_LIB
+  bool has_kernel_prepares = false;
+  for (size_t chain_idx = 0; chain_idx < n_chains_ && !has_kernel_prepares;
+       ++chain_idx) {
+    const Chain& chain = chains_[chain_idx];
+    auto instructions = chain.s_chain_->instructions();
+    for (size_t instr_idx = 0; instr_idx < instructions->size(); ++instr_idx) {
+      if (instructions->Get(instr_idx)->instr_args_type() ==
+              executorch_flatbuffer::InstructionArguments::KernelCall &&
+          chain.scalar_prim_ops_[instr_idx].op ==
+              function::ScalarPrimOp::None &&
+          chain.kernels_[instr_idx]->prepare_ != nullptr) {
+        has_kernel_prepares = true;
+        break;
+      }
+    }
+  }
+  if (!has_kernel_prepares) {
+    return Error::Ok;
+  }
+  // Finding the values that change between executions needs a scratch count
+  // per value. Preparing is an optimization only, so skip it if there is no
+  // temp memory to use.
+  MemoryAllocator* temp_allocator = memory_manager_->temp_allocator();
+  if (temp_allocator == nullptr) {
+    return Error::Ok;
+  }
+  uint8_t* writers = temp_allocator->allocateList<uint8_t>(n_value_);
+  if (writers == nullptr) {
+    temp_allocator->reset();
+    return Error::Ok;
+  }
+  // Runs after folding, so folded ops don't count as writers.
+  count_value_writers(writers);
+
+  constexpr size_t kTempBufferSizeForName = 100;
+  char operator_name[kTempBufferSizeForName];
+  auto method_allocator = memory_manager_->method_allocator();
+  const auto ops = serialization_plan_->operators();
+  Error status = Error::Ok;
+  for (size_t chain_idx = 0; chain_idx < n_chains_ && status == Error::Ok;
+       ++chain_idx) {
+    Chain& chain = chains_[chain_idx];
+    auto instructions = chain.s_chain_->instructions();
+    for (size_t instr_idx = 0; instr_idx < instructions->size(); ++instr_idx) {
+      auto instruction = instructions->Get(instr_idx);
+      if (instruction->instr_args_type() !=
+              executorch_flatbuffer::InstructionArguments::KernelCall ||
+          chain.scalar_prim_ops_[instr_idx].op !=
+              function::ScalarPrimOp::None) {
+        continue;
+      }
+      // Only the kernel the instruction resolved to knows whether a plan
+      // computes the same results as its OpFunction.
+      const KernelPrepare* kernel_prepare = chain.kernels_[instr_idx]->prepare_;
+      if (kernel_prepare == nullptr) {
+        continue;
+      }
+      auto kernel_call = instruction->instr_args_as_KernelCall();
+
+      // A plan is only valid for as long as the arguments it was built from
+      // keep their shapes and values.
+      auto arg_idxs = kernel_call->args();
+      InstructionArgs args = chain.argument_lists_[instr_idx];
+      bool preparable = true;
+      for (size_t i = 0; i < args.size() && preparable; ++i) {
+        const EValue* arg = args[i];
+        if (arg->isTensor()) {
+          // Tensors with static shapes keep their sizes, strides and dtype
+          // unless the EValue is rebound to another TensorImpl.
+          preparable =
+              arg->toTensor().unsafeGetTensorImpl()->shape_dynamism() ==
+                  TensorShapeDynamism::STATIC &&
+              writers[arg_idxs->Get(i)] != kValueReplaced;
+        } else if (arg->isTensorList()) {
+          for (const auto& tensor : arg->toTensorList()) {
+            preparable = preparable &&
+                tensor.unsafeGetTensorImpl()->shape_dynamism() ==
+                    TensorShapeDynamism::STATIC;
+          }
+        } else if (
+            i + 1 < args.size() && arg == &values_[arg_idxs->Get(i)]) {
+          // Packed arguments live outside the values table and never change,
+          // and the last argument is written by the kernel itself.
+          preparable = writers[arg_idxs->Get(i)] == 0;
+        }
+      }
+      if (!preparable) {
+        continue;
+      }
+
+      const void* plan = nullptr;
+      Error err =
+          kernel_prepare->prepare_(method_allocator, args.data(), &plan);
+      if (err != Error::Ok) {
+        // The OpFunction still runs the instruction and reports bad
+        // arguments with context when the Method executes.
+        populateOperatorName(
+            ops->Get(kernel_call->op_index()),
+            kTempBufferSizeForName,
+            operator_name);
+        ET_LOG(
+            Info,
+            "Preparing instruction %zu:%zu (%s) failed: 0x%" PRIx32
+            "; running its kernel instead",
+            chain_idx,
+            instr_idx,
+            operator_name,
+            static_cast<uint32_t>(err));
+        continue;
+      }
+      if (plan == nullptr) {
+        continue;
+      }
+
+      if (chain.prepared_calls_ == nullptr) {
+        chain.prepared_calls_ = method_allocator->allocateList<PreparedCall>(
+            instructions->size());
+        if (chain.prepared_calls_ == nullptr) {
+          status = Error::MemoryAllocationFailed;
+          break;
+        }
+        for (size_t i = 0; i < instructions->size(); ++i) {
+          chain.prepared_calls_[i] = PreparedCall{nullptr, nullptr};
+        }
+      }
+      chain.prepared_calls_[instr_idx] =
+          PreparedCall{kernel_prepare->execute_, plan};
+    }
+  }
+
+  temp_allocator->reset();
+  return status;
+#else // USE_ATEN_LIB
+  return Error::Ok;
+#endif // USE_ATEN_LIB
+}
+
+void Method::plan_copy_free_loops() {
+#ifndef USE_ATEN_LIB
+  auto is_copy_index = [&](const executorch_flatbuffer::Instruction* instr) {
+    if (instr->instr_args_type() !=
+        executorch_flatbuffer::InstructionArguments::KernelCall) {
+      return false;
+    }
+    auto call = instr->instr_args_as_KernelCall();
+    auto op = serialization_plan_->operators()->Get(call->op_index());
+    return call->args()->size() == 3 &&
+        strcmp(op->name()->c_str(), "executorch_prim::et_copy_index") == 0 &&
+        op->overload() != nullptr &&
+        strcmp(op->overload()->c_str(), "tensor") == 0;
+  };
+
+  size_t n_candidates = 0;
+  for (size_t chain_idx = 0; chain_idx < n_chains_; ++chain_idx) {
+    auto instructions = chains_[chain_idx].s_chain_->instructions();
+    for (size_t instr_idx = 0; instr_idx < instructions->size(); ++instr_idx) {
+      n_candidates += is_copy_index(instructions->Get(instr_idx));
+    }
+  }
+  if (n_candidates == 0) {
+    return;
+  }
+  // This is an optimization only; skip it if memory is tight.
+  copy_index_loops_ = memory_manager_->method_allocator()
+                          ->allocateList<CopyIndexLoop>(n_candidates);
+  if (copy_index_loops_ == nullptr) {
+    return;
+  }
+
+  auto is_method_io = [&](size_t value_index) {
+    for (size_t i = 0; i < inputs_size(); ++i) {
+      if (get_input_index(i) == value_index) {
+        return true;
+      }
+    }
+    for (size_t i = 0; i < outputs_size(); ++i) {
+      if (get_output_index(i) == value_index) {
+        return true;
+      }
+    }
+    return false;
+  };
+
+  for (size_t chain_idx = 0; chain_idx < n_chains_; ++chain_idx) {
+    auto instructions = chains_[chain_idx].s_chain_->instructions();
+    const size_t n_instructions = instructions->size();
+    for (size_t instr_idx = 0; instr_idx < n_instructions; ++instr_idx) {
+      auto instruction = instructions->Get(instr_idx);
+      if (!is_copy_index(instruction)) {
+        continue;
+      }
+      auto args = instruction->instr_args_as_KernelCall()->args();
+      const size_t copy_to = args->Get(0);
+      const size_t copy_from = args->Get(1);
+      if (!values_[copy_to].isTensor() || !values_[copy_from].isTensor() ||
+          !values_[args->Get(2)].isInt() || is_method_io(copy_from)) {
+        continue;
+      }
+      const exec_aten::Tensor& to = values_[copy_to].toTensor();
+      const exec_aten::Tensor& from = values_[copy_from].toTensor();
+      if (to.const_data_ptr() == nullptr || from.const_data_ptr() == nullptr ||
+          to.nbytes() < 2 * from.nbytes()) {
+        continue;
+      }
+
+      // The loop is closed by the first backward jump over the instruction.
+      size_t loop_begin = n_instructions;
+      size_t loop_end = n_instructions;
+      for (size_t i = instr_idx + 1; i < n_instructions; ++i) {
+        auto jump = instructions->Get(i);
+        if (jump->instr_args_type() ==
+                executorch_flatbuffer::InstructionArguments::JumpFalseCall &&
+            jump->instr_args_as_JumpFalseCall()->destination_instruction() <=
+                instr_idx) {
+          loop_begin =
+              jump->instr_args_as_JumpFalseCall()->destination_instruction();
+          loop_end = i;
+          break;
+        }
+      }
+      if (loop_end == n_instructions) {
+        continue;
+      }
+
+      // copy_from must be produced fresh by a kernel in every iteration
+      // before anything reads it, and must not be touched anywhere but in
+      // the loop body up to et_copy_index. Otherwise a reader could observe
+      // the slice it is rebound to.
+      bool eligible = true;
+      bool written = false;
+      for (size_t c = 0; eligible && c < n_chains_; ++c) {
+        auto chain_instructions = chains_[c].s_chain_->instructions();
+        for (size_t i = 0; eligible && i < chain_instructions->size(); ++i) {
+          if (c == chain_idx && i == instr_idx) {
+            continue;
+          }
+          ValueUse use = get_value_use(chain_instructions->Get(i), copy_from);
+          if (use == ValueUse::None) {
+            continue;
+          }
+          const bool in_body =
+              c == chain_idx && i >= loop_begin && i < instr_idx;
+          if (!in_body || use == ValueUse::Other ||
+              (!written && use != ValueUse::KernelOut)) {
+            eligible = false;
+          }
+          written = true;
+        }
+      }
+      if (!eligible || !written) {
+        continue;
+      }
+
+      copy_index_loops_[n_copy_index_loops_++] = CopyIndexLoop{
+          chain_idx,
+          instr_idx,
+          copy_to,
+          copy_from,
+          static_cast<size_t>(args->Get(2)),
+          from.mutable_data_ptr(),
+          to.mutable_data_ptr(),
+          from.nbytes(),
+          to.nbytes(),
+      };
+    }
+  }
+#endif // USE_ATEN_LIB
+}
+
+void Method::advance_copy_index_loop(size_t chain_idx, size_t instr_idx) {
+#ifndef USE_ATEN_LIB
+  for (size_t i = 0; i < n_copy_index_loops_; ++i) {
+    const CopyIndexLoop& loop = copy_index_loops_[i];
+    if (loop.chain_idx != chain_idx || loop.instr_idx != instr_idx) {
+      continue;
+    }
+    const exec_aten::Tensor& to = values_[loop.copy_to].toTensor();
+    const exec_aten::Tensor& from = values_[loop.copy_from].toTensor();
+    const size_t next = static_cast<size_t>(values_[loop.index].toInt()) + 1;
+    const size_t slice_nbytes = from.nbytes();
+    void* data = loop.copy_from_home;
+    // Only use copy_to's planned buffer: a caller-provided output buffer may
+    // be smaller than the plan.
+    if (to.const_data_ptr() == loop.copy_to_home && slice_nbytes > 0 &&
+        next * slice_nbytes + loop.max_slice_nbytes <= loop.capacity) {
+      data = static_cast<uint8_t*>(loop.copy_to_home) + next * slice_nbytes;
+    }
+    from.unsafeGetTensorImpl()->set_data(data);
+  }
+#else
+  (void)chain_idx;
+  (void)instr_idx;
+#endif // USE_ATEN_LIB
+}
+
 Result<Method> Method::load(
     executorch_flatbuffer::ExecutionPlan* s_plan,
     const Program* program,
@@ -569,9 +1245,15 @@ Error Method::init(executorch_flatbuffer::ExecutionPlan* s_plan) {
       auto s_chain = chains->Get(i);
       auto num_instructions = s_chain->instructions()->size();
       auto chain_instruction_kernels = ET_ALLOCATE_LIST_OR_RETURN_ERROR(
-          method_allocator, OpFunction, num_instructions);
+          method_allocator, const Kernel*, num_instructions);
       auto chain_instruction_arg_lists = ET_ALLOCATE_LIST_OR_RETURN_ERROR(
           method_allocator, InstructionArgs, num_instructions);
+      auto chain_scalar_prim_ops = ET_ALLOCATE_LIST_OR_RETURN_ERROR(
+          method_allocator, ScalarPrimOpCall, num_instructions);
+      for (size_t instr_idx = 0; instr_idx < num_instructions; ++instr_idx) {
+        chain_scalar_prim_ops[instr_idx] =
+            ScalarPrimOpCall{function::ScalarPrimOp::None, false};
+      }
 
       // Set up the argument lists ahead of time and store pointers to them to
       // use when the instructions are called
@@ -583,7 +1265,11 @@ Error Method::init(executorch_flatbuffer::ExecutionPlan* s_plan) {
             const auto arg_idxs =
                 instruction->instr_args_as_KernelCall()->args();
             auto res = gen_instruction_arguments(
-                method_allocator, values_, arg_idxs->size(), arg_idxs->data());
+                method_allocator,
+                values_,
+                n_value_,
+                arg_idxs->size(),
+                arg_idxs->data());
             if (!res.ok()) {
               return res.error();
             }
@@ -591,6 +1277,7 @@ Error Method::init(executorch_flatbuffer::ExecutionPlan* s_plan) {
             auto err = resolve_operator(
                 instruction->instr_args_as_KernelCall()->op_index(),
                 chain_instruction_kernels,
+                chain_scalar_prim_ops,
                 instr_idx,
                 res.get(),
                 arg_idxs->size());
@@ -604,7 +1291,11 @@ Error Method::init(executorch_flatbuffer::ExecutionPlan* s_plan) {
             const auto arg_idxs =
                 instruction->instr_args_as_DelegateCall()->args();
             auto res = gen_instruction_arguments(
-                method_allocator, values_, arg_idxs->size(), arg_idxs->data());
+                method_allocator,
+                values_,
+                n_value_,
+                arg_idxs->size(),
+                arg_idxs->data());
             if (!res.ok()) {
               return res.error();
             }
@@ -620,6 +1311,8 @@ Error Method::init(executorch_flatbuffer::ExecutionPlan* s_plan) {
           s_chain,
           Span<InstructionArgs>(chain_instruction_arg_lists, num_instructions),
           chain_instruction_kernels,
+          chain_scalar_prim_ops,
+          /*prepared_calls_=*/nullptr,
       };
     }
     ET_CHECK_OR_RETURN_ERROR(
@@ -630,6 +1323,21 @@ Error Method::init(executorch_flatbuffer::ExecutionPlan* s_plan) {
         num_instructions_missing_op);
   }
 
+  fold_constant_scalar_prim_ops();
+  {
+    Error err = prepack_constant_args();
+    if (err != Error::Ok) {
+      return err;
+    }
+  }
+  {
+    Error err = prepare_kernels();
+    if (err != Error::Ok) {
+      return err;
+    }
+  }
+  plan_copy_free_loops();
+
   pre_allocated_input_ = false;
 
   // Get pre_allocation info for input tensors
@@ -907,6 +1615,28 @@ Error Method::execute_instruction() {
   auto instruction = instructions->Get(step_state_.instr_idx);
   switch (instruction->instr_args_type()) {
     case executorch_flatbuffer::InstructionArguments::KernelCall: {
+      // Shape arithmetic is cheap enough that the kernel context and the
+      // profiling scopes would dominate it, so evaluate it directly.
+      const ScalarPrimOpCall& prim_op =
+          chain.scalar_prim_ops_[step_state_.instr_idx];
+      if (prim_op.folded) {
+        break;
+      }
+      if (prim_op.op != function::ScalarPrimOp::None) {
+        Error err = function::eval_scalar_prim_op(
+            prim_op.op, chain.argument_lists_[step_state_.instr_idx].data());
+        if (err != Error::Ok) {
+          ET_LOG(
+              Error,
+              "Scalar prim op %u failed at instruction %zu:%zu: 0x%x",
+              (unsigned int)prim_op.op,
+              step_state_.chain_idx,
+              step_state_.instr_idx,
+              (unsigned int)err);
+          return err;
+        }
+        break;
+      }
       EXECUTORCH_SCOPE_PROF("OPERATOR_CALL");
       internal::EventTracerProfileScope event_tracer_scope =
           internal::EventTracerProfileScope(event_tracer_, "OPERATOR_CALL");
@@ -914,7 +1644,14 @@ Error Method::execute_instruction() {
       // via the context.
       KernelRuntimeContext context(event_tracer_);
       auto args = chain.argument_lists_[step_state_.instr_idx];
-      chain.kernels_[step_state_.instr_idx](context, args.data());
+      const PreparedCall* prepared = chain.prepared_calls_ != nullptr
+          ? &chain.prepared_calls_[step_state_.instr_idx]
+          : nullptr;
+      if (prepared != nullptr && prepared->execute != nullptr) {
+        prepared->execute(context, prepared->plan, args.data());
+      } else {
+        chain.kernels_[step_state_.instr_idx]->op_(context, args.data());
+      }
       Error err = context.failure_state();
       if (err != Error::Ok) {
         auto op_index = instruction->instr_args_as_KernelCall()->op_index();
@@ -939,6 +1676,9 @@ Error Method::execute_instruction() {
         // little slow. Do the same for DelegateCall errors.
         return err;
       }
+      if (n_copy_index_loops_ > 0) {
+        advance_copy_index_loop(step_state_.chain_idx, step_state_.instr_idx);
+      }
     } break;
     case executorch_flatbuffer::InstructionArguments::DelegateCall: {
       EXECUTORCH_SCOPE_PROF("DELEGATE_CALL");
@@ -983,7 +1723,16 @@ Error Method::execute_instruction() {
       internal::EventTracerProfileScope event_tracer_profile_scope =
           internal::EventTracerProfileScope(event_tracer_, "MOVE_CALL");
       auto move_call = instruction->instr_args_as_MoveCall();
-      mutable_value(move_call->move_to()) = get_value(move_call->move_from());
+      EValue& move_to = mutable_value(move_call->move_to());
+      const EValue& move_from = get_value(move_call->move_from());
+      if (move_to.isTensor() && move_from.isTensor()) {
+        // Rebind the destination to the source's TensorImpl. This is what
+        // the generic EValue assignment ends up doing too, minus tearing
+        // down and rebuilding the EValue; no tensor data is copied.
+        move_to.toTensor() = move_from.toTensor();
+      } else {
+        move_to = move_from;
+      }
     } break;
     case executorch_flatbuffer::InstructionArguments::FreeCall: {
       EXECUTORCH_SCOPE_PROF("FREE_CALL");
@@ -1012,6 +1761,72 @@ Error Method::experimental_reset_execution() {
   return Error::Ok;
 }
 
+Error Method::experimental_cancel_execution() {
+  ET_CHECK_OR_RETURN_ERROR(
+      initialized(),
+      InvalidState,
+      "Cannot cancel execution until method has been initialized.");
+  step_state_ = StepState{0, 0};
+  return Error::Ok;
+}
+
+Error Method::experimental_relocate_planned_io(MemoryAllocator* allocator) {
+  ET_CHECK_OR_RETURN_ERROR(
+      initialized(),
+      InvalidState,
+      "Cannot relocate inputs and outputs until method has been initialized.");
+  ET_CHECK_OR_RETURN_ERROR(
+      step_state_.chain_idx == 0 && step_state_.instr_idx == 0,
+      InvalidState,
+      "Cannot relocate inputs and outputs during an execution.");
+
+  // Inputs and outputs that are not memory-planned have no data until they
+  // are set. A value can be both an input and an output, and is moved once.
+  const size_t n_inputs = inputs_size();
+  const size_t n_io = n_inputs + outputs_size();
+  for (size_t i = 0; i < n_io; ++i) {
+    const size_t value_index =
+        i < n_inputs ? get_input_index(i) : get_output_index(i - n_inputs);
+    bool seen = false;
+    for (size_t j = 0; j < i && !seen; ++j) {
+      seen = value_index ==
+          (j < n_inputs ? get_input_index(j) : get_output_index(j - n_inputs));
+    }
+    const EValue& value = values_[value_index];
+    if (seen || !value.isTensor() ||
+        value.toTensor().const_data_ptr() == nullptr) {
+      continue;
+    }
+
+    const exec_aten::Tensor& t = value.toTensor();
+    const size_t nbytes = t.nbytes();
+    void* data = allocator->allocate(nbytes);
+    ET_CHECK_OR_RETURN_ERROR(
+        data != nullptr || nbytes == 0,
+        MemoryAllocationFailed,
+        "Failed to allocate %zu bytes for value %zu",
+        nbytes,
+        value_index);
+    if (nbytes > 0) {
+      memcpy(data, t.const_data_ptr(), nbytes);
+    }
+    Error err = internal::set_tensor_data(t, data, nbytes);
+    if (err != Error::Ok) {
+      return err;
+    }
+    // Loops stack their slices straight into the output only while it is in
+    // the buffer they were planned against, so point them at the new one.
+    for (size_t j = 0; j < n_copy_index_loops_; ++j) {
+      CopyIndexLoop& loop = copy_index_loops_[j];
+      if (loop.copy_to == value_index) {
+        loop.copy_to_home = data;
+        loop.capacity = nbytes;
+      }
+    }
+  }
+  return Error::Ok;
+}
+
 Error Method::experimental_step() {
   EXECUTORCH_PROFILE_INSTRUCTION_SCOPE(
       static_cast<int32_t>(step_state_.chain_idx),
@@ -1057,6 +1872,62 @@ Error Method::experimental_step() {
   return Error::Ok;
 }
 
+bool Method::next_instruction_is_delegate() const {
+  if (step_state_.chain_idx >= n_chains_) {
+    return false;
+  }
+  auto instructions = chains_[step_state_.chain_idx].s_chain_->instructions();
+  if (instructions == nullptr || step_state_.instr_idx >= instructions->size()) {
+    return false;
+  }
+  return instructions->Get(step_state_.instr_idx)->instr_args_type() ==
+      executorch_flatbuffer::InstructionArguments::DelegateCall;
+}
+
+size_t Method::experimental_num_stages() const {
+  size_t num_stages = 0;
+  bool in_op_stage = false;
+  for (size_t i = 0; i < n_chains_; ++i) {
+    auto instructions = chains_[i].s_chain_->instructions();
+    if (instructions == nullptr) {
+      continue;
+    }
+    for (size_t j = 0; j < instructions->size(); ++j) {
+      if (instructions->Get(j)->instr_args_type() ==
+          executorch_flatbuffer::InstructionArguments::DelegateCall) {
+        num_stages++;
+        in_op_stage = false;
+      } else if (!in_op_stage) {
+        num_stages++;
+        in_op_stage = true;
+      }
+    }
+  }
+  // A Method without instructions still takes one step to finish.
+  return num_stages == 0 ? 1 : num_stages;
+}
+
+Error Method::experimental_step_stage() {
+  ET_CHECK_OR_RETURN_ERROR(
+      initialized(),
+      InvalidState,
+      "Cannot execute until method has been initialized.");
+  if (step_state_.chain_idx == n_chains_) {
+    return Error::EndOfMethod;
+  }
+  while (step_state_.chain_idx < n_chains_) {
+    const bool ran_delegate = next_instruction_is_delegate();
+    Error status = experimental_step();
+    if (status != Error::Ok) {
+      return status;
+    }
+    if (ran_delegate || next_instruction_is_delegate()) {
+      break;
+    }
+  }
+  return Error::Ok;
+}
+
 Error Method::execute() {
   internal::event_tracer_create_event_block(event_tracer_, "Execute");
   internal::EventTracerProfileScope event_tracer_profile_scope =
@@ -32,6 +32,9 @@ class Program;
 // Forward declare internal types.
 class BackendDelegate;
 struct Chain;
+struct CopyIndexLoop;
+struct Kernel;
+struct ScalarPrimOpCall;
 template <typename Fn>
 class FunctionRef;
 template <typename T>
@@ -66,7 +69,9 @@ class Method final {
         chains_(rhs.chains_),
         init_state_(rhs.init_state_),
         pre_allocated_input_(rhs.pre_allocated_input_),
-        pre_allocated_output_(rhs.pre_allocated_output_) {
+        pre_allocated_output_(rhs.pre_allocated_output_),
+        n_copy_index_loops_(rhs.n_copy_index_loops_),
+        copy_index_loops_(rhs.copy_index_loops_) {
     // Required: clear out fields that the dtor looks at, so that we don't free
     // anything twice.
     rhs.n_value_ = 0;
@@ -86,6 +91,8 @@ class Method final {
     rhs.chains_ = nullptr;
     rhs.pre_allocated_input_ = false;
     rhs.pre_allocated_output_ = false;
+    rhs.n_copy_index_loops_ = 0;
+    rhs.copy_index_loops_ = nullptr;
   }
 
   /**
@@ -198,6 +205,69 @@ class Method final {
    */
   __ET_NODISCARD Error experimental_reset_execution();
 
+  /**
+   * Abandons a partially executed Method at the current instruction boundary,
+   * so that the next `execute()` or `experimental_step()` starts again from
+   * the first instruction. Inputs that were set are kept.
+   *
+   * Instructions that already ran are not undone; any state they mutated in
+   * place, like buffers updated by the Method, keeps its new value.
+   *
+   * NOTE: Prototype API; subject to change.
+   *
+   * @retval Error:Ok on success
+   * @retval Error::InvalidState if the Method is not initialized.
+   */
+  __ET_NODISCARD Error experimental_cancel_execution();
+
+  /**
+   * Moves the data of the memory-planned input and output tensors out of the
+   * memory-planned buffers and into memory allocated from `allocator`, copying
+   * their current contents. The rest of the planned buffers then only hold
+   * intermediate values, which don't need to survive between executions, so
+   * several Methods that execute one at a time can share the same buffers.
+   *
+   * Inputs keep being copied in by `set_input()`, and outputs keep being
+   * written by the Method; only where they live changes. Call it once, after
+   * loading the Method and before setting inputs.
+   *
+   * NOTE: Prototype API; subject to change.
+   *
+   * @param[in] allocator Where to allocate the input and output data. Must
+   *     outlive the Method.
+   *
+   * @retval Error::Ok on success
+   * @retval Error::InvalidState if the Method is not initialized, or is
+   *     partway through an execution.
+   * @retval Error::MemoryAllocationFailed if `allocator` ran out of memory.
+   */
+  __ET_NODISCARD Error
+  experimental_relocate_planned_io(MemoryAllocator* allocator);
+
+  /**
+   * Returns the number of stages in the Method. A stage is either a single
+   * delegate call or a run of other instructions between delegate calls, in
+   * the order the instructions appear in the program. A Method that
+   * interleaves delegates with portable ops, like "delegate -> ops ->
+   * delegate", has three stages.
+   *
+   * NOTE: Prototype API; subject to change.
+   */
+  size_t experimental_num_stages() const;
+
+  /**
+   * Executes instructions until the end of the current stage, as defined by
+   * `experimental_num_stages()`. Stages reached through jumps follow the same
+   * rule, so a Method with loops can run more stages than it has.
+   *
+   * NOTE: Prototype API; subject to change.
+   *
+   * @retval Error::Ok stage succeeded
+   * @retval non-Ok stage failed
+   * @retval Error::EndOfMethod method finished executing successfully
+   */
+  __ET_NODISCARD Error experimental_step_stage();
+
   /**
    * Returns the MethodMeta that corresponds to the calling Method.
    */
@@ -277,7 +347,9 @@ class Method final {
         chains_(nullptr),
         init_state_(InitializationState::Uninitialized),
         pre_allocated_input_(false),
-        pre_allocated_output_(false) {}
+        pre_allocated_output_(false),
+        n_copy_index_loops_(0),
+        copy_index_loops_(nullptr) {}
 
   /// Static factory used by Program.
   __ET_NODISCARD static Result<Method> load(
@@ -301,6 +373,9 @@ class Method final {
   // Executes a single instruction using the state in step_state_
   __ET_NODISCARD Error execute_instruction();
 
+  /// Returns true if the next instruction to execute is a delegate call.
+  bool next_instruction_is_delegate() const;
+
   StepState step_state_;
   const Program* program_;
   MemoryManager* memory_manager_;
@@ -320,6 +395,9 @@ class Method final {
   bool pre_allocated_input_;
   bool pre_allocated_output_;
 
+  size_t n_copy_index_loops_;
+  CopyIndexLoop* copy_index_loops_;
+
   /**
    * Parses the elements of the values_ array. On error, n_value_ will be set to
    * the number of successfully-initialized entries so that ~Method doesn't try
@@ -329,10 +407,54 @@ class Method final {
 
   __ET_NODISCARD Error resolve_operator(
       int32_t op_index,
-      OpFunction* kernels,
+      const Kernel** kernels,
+      ScalarPrimOpCall* scalar_prim_ops,
       size_t kernel_index,
       InstructionArgs args,
       size_t n_args);
+
+  /**
+   * Fills `writers`, which has n_value_ entries, with the number of places
+   * that may write each value during execution: the caller for inputs, and
+   * instructions that aren't folded. A kernel is assumed to write its last
+   * argument and every Tensor or TensorList argument in the run that ends
+   * there. Counts saturate just below UINT8_MAX;
+   * values whose EValue may be replaced outright rather than written in
+   * place, such as MoveCall destinations, are set to UINT8_MAX.
+   */
+  void count_value_writers(uint8_t* writers) const;
+
+  /**
+   * Evaluates scalar prim ops whose inputs can never change during execution
+   * and marks them as folded so that execute() skips them. Uses the temp
+   * allocator for scratch space, and does nothing if there isn't one.
+   */
+  void fold_constant_scalar_prim_ops();
+
+  /**
+   * Replaces constant kernel arguments that the instruction's resolved Kernel
+   * has a Prepack for with their packed form, in the argument lists of the
+   * instructions that use them.
+   */
+  __ET_NODISCARD Error prepack_constant_args();
+
+  /**
+   * Builds plans for the instructions whose resolved Kernel has a
+   * KernelPrepare and whose arguments don't change between executions.
+   */
+  __ET_NODISCARD Error prepare_kernels();
+
+  /**
+   * Finds loops that stack their body output with et_copy_index and whose
+   * body output can safely be written straight into the stacked tensor.
+   */
+  void plan_copy_free_loops();
+
+  /**
+   * Called after the et_copy_index at (chain_idx, instr_idx) ran: points the
+   * loop body output at the slice the next iteration will be stacked into.
+   */
+  void advance_copy_index_loop(size_t chain_idx, size_t instr_idx);
 };
 
 } // namespace executor
@@ -67,11 +67,13 @@ size_t calculate_nbytes(
 TensorInfo::TensorInfo(
     Span<const int32_t> sizes,
     Span<const uint8_t> dim_order,
-    exec_aten::ScalarType scalar_type)
+    exec_aten::ScalarType scalar_type,
+    bool is_memory_planned)
     : sizes_(sizes),
       dim_order_(dim_order),
       scalar_type_(scalar_type),
-      nbytes_(calculate_nbytes(sizes_, scalar_type_)) {}
+      nbytes_(calculate_nbytes(sizes_, scalar_type_)),
+      is_memory_planned_(is_memory_planned) {}
 
 Span<const int32_t> TensorInfo::sizes() const {
   return sizes_;
@@ -89,6 +91,10 @@ size_t TensorInfo::nbytes() const {
   return nbytes_;
 }
 
+bool TensorInfo::is_memory_planned() const {
+  return is_memory_planned_;
+}
+
 MethodMeta::MethodMeta(const executorch_flatbuffer::ExecutionPlan* s_plan)
     : s_plan_(s_plan) {}
 
@@ -131,7 +137,8 @@ Result<TensorInfo> MethodMeta::input_tensor_meta(size_t index) const {
           tensor_value->sizes()->data(), tensor_value->sizes()->size()),
       Span<const uint8_t>(
           tensor_value->dim_order()->data(), tensor_value->dim_order()->size()),
-      static_cast<exec_aten::ScalarType>(tensor_value->scalar_type()));
+      static_cast<exec_aten::ScalarType>(tensor_value->scalar_type()),
+      tensor_value->allocation_info() != nullptr);
 }
 
 size_t MethodMeta::num_outputs() const {
@@ -169,7 +176,8 @@ Result<TensorInfo> MethodMeta::output_tensor_meta(size_t index) const {
           tensor_value->sizes()->data(), tensor_value->sizes()->size()),
       Span<const uint8_t>(
           tensor_value->dim_order()->data(), tensor_value->dim_order()->size()),
-      static_cast<exec_aten::ScalarType>(tensor_value->scalar_type()));
+      static_cast<exec_aten::ScalarType>(tensor_value->scalar_type()),
+      tensor_value->allocation_info() != nullptr);
 }
 
 size_t MethodMeta::num_memory_planned_buffers() const {
@@ -57,6 +57,13 @@ class TensorInfo final {
    */
   size_t nbytes() const;
 
+  /**
+   * Returns true if the tensor's data lives in memory-planned buffers. For
+   * inputs, Method::set_input() then copies the data instead of pointing the
+   * tensor at it.
+   */
+  bool is_memory_planned() const;
+
  private:
   // Let MethodMeta create TensorInfo.
   friend class MethodMeta;
@@ -64,7 +71,8 @@ class TensorInfo final {
   TensorInfo(
       Span<const int32_t> sizes,
       Span<const uint8_t> dim_order,
-      exec_aten::ScalarType scalar_type);
+      exec_aten::ScalarType scalar_type,
+      bool is_memory_planned);
 
   /**
    * The sizes of the tensor.
@@ -87,6 +95,9 @@ class TensorInfo final {
 
   /// The size in bytes of the tensor.
   size_t nbytes_;
+
+  /// Whether the tensor's data is memory planned.
+  bool is_memory_planned_;
 };
 
 /**
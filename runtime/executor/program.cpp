@@ -298,8 +298,21 @@ Result<FreeableBuffer> Program::LoadSegment(size_t index) const {
   // Could fail if offset and size are out of bound for the data, or if this
   // is reading from a file and fails, or for many other reasons depending on
   // the implementation of the loader.
-  return loader_->Load(
+  Result<FreeableBuffer> buffer = loader_->Load(
       segment_base_offset_ + segment->offset(), segment->size());
+  if (buffer.ok() &&
+      segment->compression() !=
+          executorch_flatbuffer::SegmentCompression::NONE &&
+      buffer->size() != segment->uncompressed_size()) {
+    // The loader handed back the stored bytes as is.
+    ET_LOG(
+        Error,
+        "Segment %zu is compressed; load the program through a "
+        "CompressedDataLoader",
+        index);
+    return Error::NotSupported;
+  }
+  return buffer;
 }
 
 } // namespace executor
@@ -64,6 +64,7 @@ def define_common_targets():
             ],
             deps = [
                 "//executorch/kernels/prim_ops:prim_ops_registry" + aten_suffix,
+                "//executorch/kernels/prim_ops:scalar_prim_ops" + aten_suffix,
                 "//executorch/runtime/backend:interface",
                 "//executorch/runtime/core/exec_aten/util:dim_order_util",
                 "//executorch/runtime/core/exec_aten/util:scalar_type_util",
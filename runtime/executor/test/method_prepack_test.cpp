@@ -0,0 +1,215 @@
+/*
+ * Copyright (c) Meta Platforms, Inc. and affiliates.
+ * All rights reserved.
+ *
+ * This source code is licensed under the BSD-style license found in the
+ * LICENSE file in the root directory of this source tree.
+ */
+
+#include <cstdlib>
+#include <memory>
+#include <vector>
+
+#include <executorch/extension/data_loader/file_data_loader.h>
+#include <executorch/runtime/core/exec_aten/exec_aten.h>
+#include <executorch/runtime/executor/method.h>
+#include <executorch/runtime/executor/program.h>
+#include <executorch/runtime/executor/test/managed_memory_manager.h>
+#include <executorch/runtime/kernel/operator_registry.h>
+#include <executorch/runtime/platform/runtime.h>
+#include <gtest/gtest.h>
+
+using namespace ::testing;
+using torch::executor::Error;
+using torch::executor::EValue;
+using torch::executor::Kernel;
+using torch::executor::KernelKey;
+using torch::executor::MemoryAllocator;
+using torch::executor::Method;
+using torch::executor::Prepack;
+using torch::executor::Program;
+using torch::executor::Result;
+using torch::executor::RuntimeContext;
+using torch::executor::testing::ManagedMemoryManager;
+using torch::executor::util::FileDataLoader;
+
+constexpr size_t kDefaultNonConstMemBytes = 32 * 1024U;
+constexpr size_t kDefaultRuntimeMemBytes = 32 * 1024U;
+
+namespace torch {
+namespace executor {
+namespace native {
+Tensor& opt_bmm_out(
+    RuntimeContext& ctx,
+    const Tensor& self,
+    const Tensor& mat2,
+    Tensor& out);
+// Defined in op_bmm.cpp.
+extern const Prepack opt_bmm_out_prepacks[1];
+} // namespace native
+} // namespace executor
+} // namespace torch
+
+namespace {
+
+// The kernel key the Method builds for bmm.out on three float tensors with
+// the default dim order; see KernelKey for the format.
+const char kFloatBmmKey[] =
+    "v0/\x06;\x00\x01\x02|\x06;\x00\x01\x02|\x06;\x00\x01\x02\xff";
+
+size_t num_packed_mat2 = 0;
+
+Error count_and_prepack_mat2(
+    MemoryAllocator* allocator,
+    const EValue& arg,
+    EValue* packed) {
+  ++num_packed_mat2;
+  return torch::executor::native::opt_bmm_out_prepacks[0].fn_(
+      allocator, arg, packed);
+}
+
+const Prepack kBmmPrepacks[] = {
+    Prepack(/*arg_index=*/1, count_and_prepack_mat2),
+};
+
+// Registers opt_bmm_out() with its prepacks for float inputs, ahead of the
+// generated fallback registration, which has none.
+Error register_prepacked_bmm() {
+  static Kernel kernels[] = {Kernel(
+      "aten::bmm.out",
+      KernelKey(kFloatBmmKey),
+      [](RuntimeContext& context, EValue** stack) {
+        torch::executor::native::opt_bmm_out(
+            context,
+            stack[0]->toTensor(),
+            stack[1]->toTensor(),
+            stack[2]->toTensor());
+      },
+      /*prepare=*/nullptr,
+      kBmmPrepacks)};
+  return torch::executor::register_kernels(kernels);
+}
+
+// Keep in sync with ModuleBmmConstant in test/models/export_program.py:
+// w = arange(2 * 3 * 4).reshape(2, 3, 4), outputs bmm(x, w) and bmm(y, w).
+constexpr int64_t kBatch = 2;
+constexpr int64_t kK = 3;
+constexpr int64_t kM = 4;
+
+float w_at(int64_t b, int64_t row, int64_t col) {
+  return static_cast<float>((b * kK + row) * kM + col);
+}
+
+class TensorHolder {
+ public:
+  TensorHolder(int32_t n, float start) : data_(kBatch * n * kK) {
+    for (size_t i = 0; i < data_.size(); ++i) {
+      data_[i] = start + static_cast<float>(i % 5);
+    }
+    sizes_[0] = kBatch;
+    sizes_[1] = n;
+    sizes_[2] = kK;
+    strides_[0] = n * kK;
+    strides_[1] = kK;
+    strides_[2] = 1;
+    impl_ = std::make_unique<torch::executor::TensorImpl>(
+        torch::executor::ScalarType::Float,
+        3,
+        sizes_,
+        data_.data(),
+        dim_order_,
+        strides_);
+  }
+
+  exec_aten::Tensor tensor() {
+    return exec_aten::Tensor(impl_.get());
+  }
+
+  // Checks that `out` is bmm(this, w).
+  void expect_bmm_with_w(const exec_aten::Tensor& out) const {
+    const int64_t n = sizes_[1];
+    ASSERT_EQ(out.dim(), 3);
+    ASSERT_EQ(out.size(0), kBatch);
+    ASSERT_EQ(out.size(1), n);
+    ASSERT_EQ(out.size(2), kM);
+    const float* out_data = out.const_data_ptr<float>();
+    for (int64_t b = 0; b < kBatch; ++b) {
+      for (int64_t i = 0; i < n; ++i) {
+        for (int64_t j = 0; j < kM; ++j) {
+          float expected = 0;
+          for (int64_t l = 0; l < kK; ++l) {
+            expected += data_[(b * n + i) * kK + l] * w_at(b, l, j);
+          }
+          EXPECT_FLOAT_EQ(out_data[(b * n + i) * kM + j], expected)
+              << "at [" << b << "][" << i << "][" << j << "]";
+        }
+      }
+    }
+  }
+
+ private:
+  std::vector<float> data_;
+  int32_t sizes_[3];
+  uint8_t dim_order_[3] = {0, 1, 2};
+  int32_t strides_[3];
+  std::unique_ptr<torch::executor::TensorImpl> impl_;
+};
+
+} // namespace
+
+class MethodPrepackTest : public ::testing::Test {
+ protected:
+  void SetUp() override {
+    torch::executor::runtime_init();
+    static const Error registered = register_prepacked_bmm();
+    ASSERT_EQ(registered, Error::Ok);
+
+    const char* path = std::getenv("ET_MODULE_BMM_CONSTANT_PATH");
+    ASSERT_NE(path, nullptr);
+    Result<FileDataLoader> loader = FileDataLoader::from(path);
+    ASSERT_EQ(loader.error(), Error::Ok);
+    loader_ = std::make_unique<FileDataLoader>(std::move(loader.get()));
+
+    Result<Program> program = Program::load(
+        loader_.get(), Program::Verification::InternalConsistency);
+    ASSERT_EQ(program.error(), Error::Ok);
+    program_ = std::make_unique<Program>(std::move(program.get()));
+  }
+
+  // Must outlive program_.
+  std::unique_ptr<FileDataLoader> loader_;
+  std::unique_ptr<Program> program_;
+};
+
+TEST_F(MethodPrepackTest, OnlyTheResolvedKernelPrepacks) {
+  // The generated registration has no prepacks, so a bmm that resolves to it
+  // keeps its mat2 as is.
+  const Kernel* fallback = torch::executor::get_kernel("aten::bmm.out");
+  ASSERT_NE(fallback, nullptr);
+  EXPECT_TRUE(fallback->prepacks_.empty());
+}
+
+TEST_F(MethodPrepackTest, PrepackedConstantGivesSameOutputs) {
+  ManagedMemoryManager mmm(kDefaultNonConstMemBytes, kDefaultRuntimeMemBytes);
+  num_packed_mat2 = 0;
+  Result<Method> method = program_->load_method("forward", &mmm.get());
+  ASSERT_EQ(method.error(), Error::Ok);
+  ASSERT_EQ(method->outputs_size(), 2);
+
+  // Both bmms resolve to the float kernel and read the same constant, which
+  // is packed once and shared.
+  EXPECT_EQ(num_packed_mat2, 1);
+  TensorHolder x(/*n=*/2, /*start=*/-1);
+  TensorHolder y(/*n=*/1, /*start=*/2);
+  ASSERT_EQ(method->set_input(EValue(x.tensor()), 0), Error::Ok);
+  ASSERT_EQ(method->set_input(EValue(y.tensor()), 1), Error::Ok);
+
+  // Repeated executions keep using the packed form.
+  for (int i = 0; i < 2; ++i) {
+    ASSERT_EQ(method->execute(), Error::Ok);
+    ASSERT_TRUE(method->get_output(0).isTensor());
+    ASSERT_TRUE(method->get_output(1).isTensor());
+    x.expect_bmm_with_w(method->get_output(0).toTensor());
+    y.expect_bmm_with_w(method->get_output(1).toTensor());
+  }
+}
@@ -6,6 +6,7 @@
  * LICENSE file in the root directory of this source tree.
  */
 
+#include <algorithm>
 #include <cstdlib>
 #include <filesystem>
 
@@ -55,6 +56,55 @@ class MethodTest : public ::testing::Test {
     load_program(std::getenv("ET_MODULE_INDEX_PATH"), "index");
     load_program(
         std::getenv("ET_MODULE_DYNAMIC_CAT_UNALLOCATED_IO_PATH"), "cat");
+    load_program(std::getenv("ET_MODULE_MAP_PATH"), "map");
+    load_program(
+        std::getenv("ET_MODULE_MAP_UNALLOCATED_OUTPUT_PATH"),
+        "map_unallocated_output");
+    load_program(std::getenv("ET_MODULE_COND_ADD_PATH"), "cond_add");
+  }
+
+  // Runs a ModuleMap method with xs = [[1, 2], [3, 4], [5, 6]] and
+  // y = [10, 20], and checks that its output is xs[i] + y for every row.
+  static void execute_map_and_check(Method& method) {
+    float xs[6] = {1, 2, 3, 4, 5, 6};
+    int32_t xs_sizes[2] = {3, 2};
+    uint8_t xs_dim_order[2] = {0, 1};
+    int32_t xs_strides[2] = {2, 1};
+    torch::executor::TensorImpl xs_impl(
+        torch::executor::ScalarType::Float,
+        2,
+        xs_sizes,
+        xs,
+        xs_dim_order,
+        xs_strides);
+    float y[2] = {10, 20};
+    int32_t y_sizes[1] = {2};
+    uint8_t y_dim_order[1] = {0};
+    int32_t y_strides[1] = {1};
+    torch::executor::TensorImpl y_impl(
+        torch::executor::ScalarType::Float,
+        1,
+        y_sizes,
+        y,
+        y_dim_order,
+        y_strides);
+    ASSERT_EQ(
+        method.set_input(EValue(torch::executor::Tensor(&xs_impl)), 0),
+        Error::Ok);
+    ASSERT_EQ(
+        method.set_input(EValue(torch::executor::Tensor(&y_impl)), 1),
+        Error::Ok);
+
+    ASSERT_EQ(method.execute(), Error::Ok);
+
+    const float expected[6] = {11, 22, 13, 24, 15, 26};
+    const EValue& output = method.get_output(0);
+    ASSERT_TRUE(output.isTensor());
+    ASSERT_EQ(output.toTensor().numel(), 6);
+    for (size_t i = 0; i < 6; ++i) {
+      EXPECT_FLOAT_EQ(
+          output.toTensor().const_data_ptr<float>()[i], expected[i]);
+    }
   }
 
  private:
@@ -116,6 +166,30 @@ TEST_F(MethodTest, SetPrimInputTest) {
   torch::executor::util::FreeInputs(inputs);
 }
 
+TEST_F(MethodTest, CancelExecutionTest) {
+  ManagedMemoryManager mmm(kDefaultNonConstMemBytes, kDefaultRuntimeMemBytes);
+  Result<Method> method = programs_["add"]->load_method("forward", &mmm.get());
+  ASSERT_EQ(method.error(), Error::Ok);
+
+  exec_aten::ArrayRef<void*> inputs =
+      torch::executor::util::PrepareInputTensors(*method);
+
+  // Stop after the first instruction.
+  ASSERT_EQ(method->experimental_step(), Error::Ok);
+  ASSERT_EQ(method->experimental_cancel_execution(), Error::Ok);
+
+  // The next execution starts from the beginning and runs to the end.
+  Error err = method->execute();
+  EXPECT_EQ(err, Error::Ok);
+
+  // Cancelling a Method that isn't executing is harmless.
+  ASSERT_EQ(method->experimental_cancel_execution(), Error::Ok);
+  err = method->execute();
+  EXPECT_EQ(err, Error::Ok);
+
+  torch::executor::util::FreeInputs(inputs);
+}
+
 TEST_F(MethodTest, MethodMetaTest) {
   ManagedMemoryManager mmm(kDefaultNonConstMemBytes, kDefaultRuntimeMemBytes);
   Result<Method> method = programs_["add"]->load_method("forward", &mmm.get());
@@ -196,6 +270,94 @@ TEST_F(MethodTest, AliasedIOTest) {
   }
 }
 
+TEST_F(MethodTest, CopyFreeLoopTest) {
+  // The map output is planned, so each iteration writes its row directly
+  // into it.
+  ManagedMemoryManager mmm(kDefaultNonConstMemBytes, kDefaultRuntimeMemBytes);
+  Result<Method> method = programs_["map"]->load_method("forward", &mmm.get());
+  ASSERT_EQ(method.error(), Error::Ok);
+
+  execute_map_and_check(*method);
+
+  // Every row must be rewritten on the next execution too, starting again
+  // from the first one.
+  const exec_aten::Tensor& output = method->get_output(0).toTensor();
+  std::fill_n(output.mutable_data_ptr<float>(), output.numel(), -1.f);
+  execute_map_and_check(*method);
+}
+
+TEST_F(MethodTest, CopyIndexLoopWithCallerOutputTest) {
+  // The caller provides the map output, so et_copy_index copies each row
+  // from the body's own buffer.
+  ManagedMemoryManager mmm(kDefaultNonConstMemBytes, kDefaultRuntimeMemBytes);
+  Result<Method> method =
+      programs_["map_unallocated_output"]->load_method("forward", &mmm.get());
+  ASSERT_EQ(method.error(), Error::Ok);
+
+  float out[6];
+  std::fill_n(out, 6, -1.f);
+  ASSERT_EQ(method->set_output_data_ptr(out, sizeof(out), 0), Error::Ok);
+
+  execute_map_and_check(*method);
+  EXPECT_EQ(method->get_output(0).toTensor().const_data_ptr(), out);
+}
+
+TEST_F(MethodTest, MoveDestinationTest) {
+  // add.out reads the cond output, which a MoveCall rebinds to the tensor of
+  // whichever branch ran, so it must not keep a plan built for one of them.
+  ManagedMemoryManager mmm(kDefaultNonConstMemBytes, kDefaultRuntimeMemBytes);
+  Result<Method> method =
+      programs_["cond_add"]->load_method("forward", &mmm.get());
+  ASSERT_EQ(method.error(), Error::Ok);
+
+  bool pred = true;
+  int32_t pred_sizes[1] = {};
+  uint8_t pred_dim_order[1] = {};
+  int32_t pred_strides[1] = {};
+  torch::executor::TensorImpl pred_impl(
+      torch::executor::ScalarType::Bool,
+      0,
+      pred_sizes,
+      &pred,
+      pred_dim_order,
+      pred_strides);
+  float x[4] = {1, 2, 3, 4};
+  float y[4] = {10, 20, 30, 40};
+  int32_t sizes[2] = {2, 2};
+  uint8_t dim_order[2] = {0, 1};
+  int32_t strides[2] = {2, 1};
+  torch::executor::TensorImpl x_impl(
+      torch::executor::ScalarType::Float, 2, sizes, x, dim_order, strides);
+  torch::executor::TensorImpl y_impl(
+      torch::executor::ScalarType::Float, 2, sizes, y, dim_order, strides);
+  ASSERT_EQ(
+      method->set_input(EValue(torch::executor::Tensor(&x_impl)), 1),
+      Error::Ok);
+  ASSERT_EQ(
+      method->set_input(EValue(torch::executor::Tensor(&y_impl)), 2),
+      Error::Ok);
+
+  // Alternate the branches so that each run follows a different move.
+  const float expected_true[4] = {12, 24, 36, 48};
+  const float expected_false[4] = {11, 24, 39, 56};
+  for (int i = 0; i < 4; ++i) {
+    pred = i % 2 == 0;
+    ASSERT_EQ(
+        method->set_input(EValue(torch::executor::Tensor(&pred_impl)), 0),
+        Error::Ok);
+    ASSERT_EQ(method->execute(), Error::Ok);
+
+    const float* expected = pred ? expected_true : expected_false;
+    const EValue& output = method->get_output(0);
+    ASSERT_TRUE(output.isTensor());
+    ASSERT_EQ(output.toTensor().numel(), 4);
+    for (size_t j = 0; j < 4; ++j) {
+      EXPECT_FLOAT_EQ(
+          output.toTensor().const_data_ptr<float>()[j], expected[j]);
+    }
+  }
+}
+
 // TODO(T161163608): Test is disabled due to a resize bug in tensor_index_out of
 // the portable op lib
 
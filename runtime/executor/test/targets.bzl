@@ -64,6 +64,7 @@ def define_common_targets(is_fbcode = False):
             "managed_memory_manager.h",
         ],
         visibility = [
+            "//executorch/backends/xnnpack/test/...",
             "//executorch/runtime/executor/test/...",
             "//executorch/test/...",
             "@EXECUTORCH_CLIENTS",
@@ -83,8 +84,12 @@ def define_common_targets(is_fbcode = False):
             # an fbcode target path because the authoring/export tools
             # intentionally don't work in xplat (since they're host-only tools).
             "ET_MODULE_ADD_PATH": "$(location fbcode//executorch/test/models:exported_programs[ModuleAdd.pte])",
+            "ET_MODULE_BMM_CONSTANT_PATH": "$(location fbcode//executorch/test/models:exported_programs[ModuleBmmConstant.pte])",
+            "ET_MODULE_COND_ADD_PATH": "$(location fbcode//executorch/test/models:exported_programs[ModuleCondAdd.pte])",
             "ET_MODULE_DYNAMIC_CAT_UNALLOCATED_IO_PATH": "$(location fbcode//executorch/test/models:exported_programs[ModuleDynamicCatUnallocatedIO.pte])",
             "ET_MODULE_INDEX_PATH": "$(location fbcode//executorch/test/models:exported_programs[ModuleIndex.pte])",
+            "ET_MODULE_MAP_PATH": "$(location fbcode//executorch/test/models:exported_programs[ModuleMap.pte])",
+            "ET_MODULE_MAP_UNALLOCATED_OUTPUT_PATH": "$(location fbcode//executorch/test/models:exported_programs[ModuleMapUnallocatedOutput.pte])",
             "ET_MODULE_MULTI_ENTRY_PATH": "$(location fbcode//executorch/test/models:exported_programs[ModuleMultipleEntry.pte])",
         }
 
@@ -118,6 +123,22 @@ def define_common_targets(is_fbcode = False):
             env = modules_env,
         )
 
+        runtime.cxx_test(
+            name = "method_prepack_test",
+            srcs = [
+                "method_prepack_test.cpp",
+            ],
+            deps = [
+                ":managed_memory_manager",
+                "//executorch/runtime/executor:program",
+                "//executorch/runtime/kernel:operator_registry",
+                "//executorch/extension/data_loader:file_data_loader",
+                # Defines opt_bmm_out() and the prepack of its mat2.
+                "//executorch/kernels/optimized:generated_lib",
+            ],
+            env = modules_env,
+        )
+
         runtime.cxx_test(
             name = "method_meta_test",
             srcs = [
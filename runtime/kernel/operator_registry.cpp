@@ -140,6 +140,21 @@ const OpFunction& getOpsFn(const char* name, ArrayRef<TensorMeta> kernel_key) {
 const OpFunction& OperatorRegistry::getOpsFn(
     const char* name,
     ArrayRef<TensorMeta> meta_list) {
+  const Kernel* kernel = get_kernel(name, meta_list);
+  if (kernel == nullptr) {
+    ET_LOG_TENSOR_META(meta_list);
+  }
+  ET_CHECK_MSG(kernel != nullptr, "kernel '%s' not found.", name);
+  return kernel->op_;
+}
+
+const Kernel* get_kernel(const char* name, ArrayRef<TensorMeta> meta_list) {
+  return getOperatorRegistry().get_kernel(name, meta_list);
+}
+
+const Kernel* OperatorRegistry::get_kernel(
+    const char* name,
+    ArrayRef<TensorMeta> meta_list) {
   char buf[BUF_SIZE] = {0};
   make_kernel_key_string(meta_list, buf);
   KernelKey kernel_key = KernelKey(buf);
@@ -148,7 +163,7 @@ const OpFunction& OperatorRegistry::getOpsFn(
   for (size_t idx = 0; idx < this->num_kernels_; idx++) {
     if (strcmp(this->kernels_[idx].name_, name) == 0) {
       if (this->kernels_[idx].kernel_key_ == kernel_key) {
-        return this->kernels_[idx].op_;
+        return &this->kernels_[idx];
       }
       if (this->kernels_[idx].kernel_key_.is_fallback()) {
         fallback_idx = idx;
@@ -156,10 +171,9 @@ const OpFunction& OperatorRegistry::getOpsFn(
     }
   }
   if (fallback_idx != -1) {
-    return this->kernels_[fallback_idx].op_;
+    return &this->kernels_[fallback_idx];
   }
-  ET_CHECK_MSG(false, "kernel '%s' not found.", name);
-  ET_LOG_TENSOR_META(meta_list);
+  return nullptr;
 }
 
 ArrayRef<Kernel> get_kernels() {
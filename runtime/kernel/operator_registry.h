@@ -41,6 +41,7 @@ namespace torch {
 namespace executor {
 
 class KernelRuntimeContext; // Forward declaration
+class MemoryAllocator; // Forward declaration
 using RuntimeContext = KernelRuntimeContext; // TODO(T147221312): Remove
 using OpFunction =
     FunctionRef<void(KernelRuntimeContext&, EValue**)>; // TODO(T165139545):
@@ -177,6 +178,97 @@ struct KernelKey {
   bool is_fallback_;
 };
 
+/**
+ * Transforms a constant argument of an operator into a form that its kernel
+ * runs faster on, e.g. packed or transposed weights. Called once per
+ * instruction when a Method is loaded, so the kernel doesn't need to repack the
+ * argument on every call.
+ *
+ * The packed form must be a value that the Kernel the function belongs to
+ * accepts in place of the original argument, and it must hold the same logical
+ * contents: a Tensor with the same sizes and values but a different dim order
+ * is fine, a Tensor with a different shape is not.
+ *
+ * The packed form is a copy: the original stays in the Program's constant
+ * segment, which is loaded and freed as a whole, so packing costs the size of
+ * the packed data in Method memory.
+ *
+ * @param[in] allocator Allocator for the packed data and any metadata. Memory
+ *     allocated from it lives as long as the Method.
+ * @param[in] arg The constant argument, in its serialized form.
+ * @param[out] packed Where to store the packed form.
+ *
+ * @retval Error::Ok If `packed` was set, or if it was left as None because
+ *     this argument doesn't benefit from packing; the original argument is
+ *     used in that case.
+ * @retval other Packing failed; the Method fails to load.
+ */
+using PrepackFunction =
+    Error (*)(MemoryAllocator* allocator, const EValue& arg, EValue* packed);
+
+/**
+ * Declares that argument `arg_index_` of a Kernel should be packed by `fn_`
+ * when it is a constant. The Kernel's OpFunction has to understand the packed
+ * form, so a Prepack is part of the Kernel registration it belongs to.
+ */
+struct Prepack {
+  size_t arg_index_;
+  PrepackFunction fn_;
+
+  explicit Prepack(size_t arg_index, PrepackFunction fn)
+      : arg_index_(arg_index), fn_(fn) {}
+
+  Prepack() : arg_index_(0), fn_(nullptr) {}
+};
+
+/**
+ * Plans one instruction of an operator ahead of time: validates the
+ * arguments, resizes the outputs and picks the dtype-specialized compute
+ * loop, so that the execute function only has to run that loop. Called once
+ * per instruction when a Method is loaded.
+ *
+ * The Method only prepares instructions whose tensor arguments all have
+ * static shapes, so sizes, strides and dtypes seen here hold for every
+ * execution. Data pointers do not: inputs may be re-pointed between
+ * executions, so the plan must not cache them.
+ *
+ * @param[in] allocator Allocator for the plan. Memory allocated from it lives
+ *     as long as the Method.
+ * @param[in] args The instruction's arguments in schema order, outputs
+ *     included, as passed to the kernel. Non-constant tensors may not have
+ *     data yet.
+ * @param[out] plan Where to store the plan. Leaving it nullptr declines, and
+ *     the regular kernel runs the instruction instead.
+ *
+ * @retval Error::Ok If `plan` was set or the instruction was declined.
+ * @retval other The arguments are invalid for the operator; the Method fails
+ *     to load.
+ */
+using PrepareFunction =
+    Error (*)(MemoryAllocator* allocator, EValue** args, const void** plan);
+
+/**
+ * Runs an instruction using the plan its PrepareFunction built, with the same
+ * arguments and error reporting as the operator's kernel.
+ */
+using PreparedOpFunction =
+    void (*)(KernelRuntimeContext& context, const void* plan, EValue** args);
+
+/**
+ * The prepare and execute entry points of a kernel. A Kernel that has them is
+ * called through `execute_` with a plan built by `prepare_` instead of through
+ * its OpFunction, so they must compute the same results as that OpFunction.
+ */
+struct KernelPrepare {
+  PrepareFunction prepare_;
+  PreparedOpFunction execute_;
+
+  explicit KernelPrepare(PrepareFunction prepare, PreparedOpFunction execute)
+      : prepare_(prepare), execute_(execute) {}
+
+  KernelPrepare() : prepare_(nullptr), execute_(nullptr) {}
+};
+
 /**
  * Struct that bundles a kernel key, a function and an op name together. An
  * `Operator` may have more than one `Kernel` (maximum kMaxNumOfKernelPerOp) and
@@ -190,6 +282,13 @@ struct Kernel {
   // Data is not owned by the Kernel struct.
   KernelKey kernel_key_;
   OpFunction op_;
+  // Optional prepare and execute functions that replace op_ for instructions
+  // whose arguments can't change between executions. Not owned; must outlive
+  // the operator registry.
+  const KernelPrepare* prepare_ = nullptr;
+  // Optional prepack functions for constant arguments. Not owned; must outlive
+  // the operator registry.
+  ArrayRef<Prepack> prepacks_;
   /**
    * We are doing a copy of the string pointer instead of duplicating the string
    * itself, we require the lifetime of the operator name to be at least as long
@@ -200,6 +299,18 @@ struct Kernel {
   explicit Kernel(const char* name, KernelKey key, OpFunction func)
       : name_(name), kernel_key_(key), op_(func) {}
 
+  explicit Kernel(
+      const char* name,
+      KernelKey key,
+      OpFunction func,
+      const KernelPrepare* prepare,
+      ArrayRef<Prepack> prepacks = {})
+      : name_(name),
+        kernel_key_(key),
+        op_(func),
+        prepare_(prepare),
+        prepacks_(prepacks) {}
+
   Kernel() {}
 };
 
@@ -225,6 +336,13 @@ const OpFunction& getOpsFn(
     const char* name,
     ArrayRef<TensorMeta> meta_list = {});
 
+/**
+ * See OperatorRegistry::get_kernel()
+ */
+const Kernel* get_kernel(
+    const char* name,
+    ArrayRef<TensorMeta> meta_list = {});
+
 /**
  * See OperatorRegistry::get_kernels()
  */
@@ -262,6 +380,12 @@ struct OperatorRegistry {
    */
   const OpFunction& getOpsFn(const char* name, ArrayRef<TensorMeta> meta_list);
 
+  /**
+   * Returns the kernel that getOpsFn() would return the function of, or
+   * nullptr if there is none. The Kernel lives as long as the registry.
+   */
+  const Kernel* get_kernel(const char* name, ArrayRef<TensorMeta> meta_list);
+
   /**
    * Return all registered operators.
    */
@@ -290,5 +290,71 @@ TEST_F(OperatorRegistryTest, ExecutorUsesFallbackKernel) {
   ASSERT_EQ(val, 100);
 }
 
+TEST_F(OperatorRegistryTest, GetKernelReturnsTheResolvedPrepare) {
+  static const KernelPrepare prepare(
+      [](MemoryAllocator*, EValue**, const void**) { return Error::Ok; },
+      [](RuntimeContext&, const void*, EValue**) {});
+
+  // The registry keeps a pointer to the key data.
+  static char buf_long_contiguous[BUF_SIZE];
+  make_kernel_key({{ScalarType::Long, {0, 1, 2, 3}}}, buf_long_contiguous);
+  Kernel kernels[] = {
+      Kernel(
+          "test::prepared",
+          KernelKey{},
+          [](RuntimeContext&, EValue**) {},
+          &prepare),
+      Kernel(
+          "test::prepared",
+          KernelKey(buf_long_contiguous),
+          [](RuntimeContext&, EValue**) {}),
+  };
+  auto s1 = register_kernels(kernels);
+  EXPECT_EQ(s1, torch::executor::Error::Ok);
+
+  // The prepare belongs to the fallback kernel only.
+  const Kernel* fallback = get_kernel("test::prepared");
+  ASSERT_NE(fallback, nullptr);
+  EXPECT_EQ(fallback->prepare_, &prepare);
+
+  Tensor::DimOrderType dims[] = {0, 1, 2, 3};
+  TensorMeta meta[] = {
+      TensorMeta(ScalarType::Long, ArrayRef<Tensor::DimOrderType>(dims, 4))};
+  const Kernel* keyed = get_kernel("test::prepared", ArrayRef<TensorMeta>(meta));
+  ASSERT_NE(keyed, nullptr);
+  EXPECT_NE(keyed, fallback);
+  EXPECT_EQ(keyed->prepare_, nullptr);
+
+  EXPECT_EQ(get_kernel("test::unprepared"), nullptr);
+}
+
+TEST_F(OperatorRegistryTest, GetKernelReturnsItsPrepacks) {
+  PrepackFunction fn = [](MemoryAllocator*, const EValue& arg, EValue* packed) {
+    *packed = EValue(arg.toInt() + 1);
+    return Error::Ok;
+  };
+  static const Prepack prepacks[] = {Prepack(1, fn)};
+  Kernel kernels[] = {Kernel(
+      "test::prepack",
+      KernelKey{},
+      [](RuntimeContext&, EValue**) {},
+      /*prepare=*/nullptr,
+      prepacks)};
+  auto s1 = register_kernels(kernels);
+  EXPECT_EQ(s1, torch::executor::Error::Ok);
+
+  const Kernel* kernel = get_kernel("test::prepack");
+  ASSERT_NE(kernel, nullptr);
+  EXPECT_EQ(kernel->prepare_, nullptr);
+  ASSERT_EQ(kernel->prepacks_.size(), 1);
+  EXPECT_EQ(kernel->prepacks_[0].arg_index_, 1);
+
+  EValue packed;
+  EXPECT_EQ(
+      kernel->prepacks_[0].fn_(nullptr, EValue(int64_t(41)), &packed),
+      Error::Ok);
+  EXPECT_EQ(packed.toInt(), 42);
+}
+
 } // namespace executor
 } // namespace torch
@@ -96,6 +96,7 @@ def define_common_targets():
             # are an implementation detail. Ideally this list would only include
             # //executorch/runtime/executor/...
             "//executorch/codegen/tools/...",
+            "//executorch/extension/data_loader/...",
             "//executorch/runtime/executor/...",
         ],
         exported_headers = {
@@ -129,6 +130,7 @@ def define_common_targets():
             "extended_header.h",
         ],
         visibility = [
+            "//executorch/extension/data_loader/...",
             "//executorch/runtime/executor/...",
             "//executorch/schema/test/...",
         ],
@@ -0,0 +1,95 @@
+# Copyright (c) Meta Platforms, Inc. and affiliates.
+# All rights reserved.
+#
+# This source code is licensed under the BSD-style license found in the
+# LICENSE file in the root directory of this source tree.
+
+"""Exports LinearModel to BundledProgram files for the C++ verification tests.
+
+Writes two files to --outdir:
+- LinearBundled.bpte: every test set's expected outputs match the model.
+- LinearBundledMismatch.bpte: the same, except that the expected outputs of
+  the last test set are off by a relative error of MISMATCH_RELATIVE_ERROR.
+  Verifying it fails with the default tolerances, and passes with an rtol of
+  at least MISMATCH_RELATIVE_ERROR.
+"""
+
+import argparse
+import os
+from typing import List
+
+import executorch.exir as exir
+
+import torch
+from executorch.bundled_program.config import MethodTestCase, MethodTestSuite
+from executorch.bundled_program.core import create_bundled_program
+from executorch.bundled_program.serialize import (
+    serialize_from_bundled_program_to_flatbuffer,
+)
+from executorch.exir import ExecutorchBackendConfig
+from executorch.exir.passes import MemoryPlanningPass, ToOutVarPass
+
+from executorch.test.models.linear_model import LinearModel
+
+NUM_TEST_SETS = 4
+
+# Keep in sync with util/test/bundled_program_batch_verification_test.cpp.
+MISMATCH_RELATIVE_ERROR = 1e-4
+
+
+def export_bundled_program(mismatch: bool) -> bytes:
+    model = LinearModel()
+    program = (
+        exir.capture(model, (torch.ones(2, 2, dtype=torch.float),))
+        .to_edge()
+        .to_executorch(
+            config=ExecutorchBackendConfig(
+                memory_planning_pass=MemoryPlanningPass(),
+                to_out_var_pass=ToOutVarPass(),
+            )
+        )
+        .program
+    )
+
+    # Deterministic inputs, so that the outputs are exact.
+    method_test_cases: List[MethodTestCase] = []
+    for i in range(NUM_TEST_SETS):
+        x = torch.full((2, 2), float(i), dtype=torch.float)
+        expected = model(x)
+        if mismatch and i == NUM_TEST_SETS - 1:
+            expected = expected * (1 + MISMATCH_RELATIVE_ERROR)
+        method_test_cases.append(MethodTestCase(inputs=[x], expected_outputs=expected))
+
+    bundled_program = create_bundled_program(
+        program,
+        [MethodTestSuite(method_name="forward", test_cases=method_test_cases)],
+    )
+    return serialize_from_bundled_program_to_flatbuffer(bundled_program)
+
+
+def main() -> None:
+    parser = argparse.ArgumentParser(
+        prog="export_bundled_program",
+        description="Exports LinearModel to BundledProgram .bpte files",
+    )
+    parser.add_argument(
+        "--outdir",
+        type=str,
+        required=True,
+        help="Path to the directory to write the .bpte files to.",
+    )
+    args = parser.parse_args()
+
+    os.makedirs(args.outdir, exist_ok=True)
+    for name, mismatch in (
+        ("LinearBundled", False),
+        ("LinearBundledMismatch", True),
+    ):
+        outfile = os.path.join(args.outdir, f"{name}.bpte")
+        with open(outfile, "wb") as fp:
+            fp.write(export_bundled_program(mismatch))
+        print(f"Exported {name} and wrote bundled program data to {outfile}")
+
+
+if __name__ == "__main__":
+    main()
@@ -11,7 +11,7 @@ import sys
 from typing import Any, Dict, List, Type
 
 import torch
-from executorch.exir import CaptureConfig
+from executorch.exir import CaptureConfig, control_flow
 from executorch.exir.passes import MemoryPlanningPass
 from executorch.test.end2end.exported_module import ExportedModule
 from torch import nn
@@ -150,6 +150,73 @@ class ModuleMultipleEntry(torch.nn.Module):
         return ["forward", "forward2"]
 
 
+class ModuleBmmConstant(nn.Module):
+    """Two bmms that share a constant mat2, which the optimized bmm kernel
+    prepacks when the Method is loaded."""
+
+    def __init__(self):
+        super(ModuleBmmConstant, self).__init__()
+        self.w = torch.arange(2 * 3 * 4, dtype=torch.float).reshape(2, 3, 4)
+
+    def forward(self, x, y):
+        return torch.bmm(x, self.w), torch.bmm(y, self.w)
+
+    def get_random_inputs(self):
+        return (torch.ones(2, 2, 3), torch.ones(2, 1, 3))
+
+
+def _map_body(x, y):
+    return x + y
+
+
+class ModuleMap(nn.Module):
+    """Stacks xs[i] + y for each row of xs, which the emitter turns into a
+    loop that ends in et_copy_index."""
+
+    def __init__(self):
+        super(ModuleMap, self).__init__()
+
+    def forward(self, xs, y):
+        return control_flow.map(_map_body, xs, y)
+
+    def get_random_inputs(self):
+        return (torch.ones(3, 2), torch.ones(2))
+
+
+class ModuleMapUnallocatedOutput(ModuleMap):
+    """ModuleMap whose output buffer is provided by the caller."""
+
+    def get_memory_planning_pass(self):
+        return MemoryPlanningPass(
+            memory_planning_algo="greedy",
+            alloc_graph_input=True,
+            alloc_graph_output=False,
+        )
+
+
+def _cond_true(x):
+    return x + x
+
+
+def _cond_false(x):
+    return x * x
+
+
+class ModuleCondAdd(nn.Module):
+    """Adds y to either x + x or x * x. The branch result reaches add.out
+    through a MoveCall, which rebinds its value to the branch's tensor."""
+
+    def __init__(self):
+        super(ModuleCondAdd, self).__init__()
+
+    def forward(self, pred, x, y):
+        z = control_flow.cond(pred, _cond_true, _cond_false, [x])
+        return z + y
+
+    def get_random_inputs(self):
+        return (torch.tensor(True), torch.ones(2, 2), torch.ones(2, 2))
+
+
 #
 # Main logic.
 #
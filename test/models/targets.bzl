@@ -61,10 +61,14 @@ def define_common_targets():
     MODULES_TO_EXPORT = [
         "ModuleAdd",
         "ModuleBasic",
+        "ModuleBmmConstant",
         "ModuleLinear",
         "ModuleMultipleEntry",
         "ModuleIndex",
         "ModuleDynamicCatUnallocatedIO",
+        "ModuleMap",
+        "ModuleMapUnallocatedOutput",
+        "ModuleCondAdd",
     ]
 
     # Generates Executorch .pte program files for various modules at build time.
@@ -86,6 +90,46 @@ def define_common_targets():
         _is_external_target = True,
     )
 
+    runtime.python_library(
+        name = "export_bundled_program_lib",
+        srcs = ["export_bundled_program.py"],
+        deps = [
+            ":linear_model",
+            "//caffe2:torch",
+            "//executorch/bundled_program:config",
+            "//executorch/bundled_program:core",
+            "//executorch/bundled_program/serialize:lib",
+            "//executorch/exir:lib",
+        ],
+        visibility = [],  # Private
+    )
+
+    runtime.python_binary(
+        name = "export_bundled_program",
+        main_module = "executorch.test.models.export_bundled_program",
+        deps = [
+            ":export_bundled_program_lib",
+        ],
+        visibility = [],  # Private
+    )
+
+    # Generates BundledProgram files for the bundled program verification
+    # tests. To use one, depend on a target like
+    # ":exported_bundled_programs[LinearBundled.bpte]".
+    runtime.genrule(
+        name = "exported_bundled_programs",
+        cmd = "$(exe :export_bundled_program) --outdir $OUT",
+        outs = {
+            fname + ".bpte": [fname + ".bpte"]
+            for fname in ["LinearBundled", "LinearBundledMismatch"]
+        },
+        default_outs = ["."],
+        visibility = [
+            "//executorch/examples/sdk/bundled_program_verifier/...",
+            "//executorch/util/test/...",
+        ],
+    )
+
     runtime.python_library(
         name = "export_delegated_program_lib",
         srcs = ["export_delegated_program.py"],
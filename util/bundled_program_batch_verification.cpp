@@ -0,0 +1,228 @@
+/*
+ * Copyright (c) Meta Platforms, Inc. and affiliates.
+ * All rights reserved.
+ *
+ * This source code is licensed under the BSD-style license found in the
+ * LICENSE file in the root directory of this source tree.
+ */
+
+#include <executorch/util/bundled_program_batch_verification.h>
+
+#include <algorithm>
+#include <atomic>
+#include <cinttypes>
+#include <chrono>
+#include <map>
+#include <memory>
+#include <thread>
+
+#include <executorch/extension/data_loader/buffer_data_loader.h>
+#include <executorch/extension/data_loader/mmap_data_loader.h>
+#include <executorch/extension/memory_allocator/malloc_memory_allocator.h>
+#include <executorch/runtime/core/hierarchical_allocator.h>
+#include <executorch/runtime/executor/memory_manager.h>
+#include <executorch/runtime/executor/program.h>
+#include <executorch/runtime/platform/log.h>
+#include <executorch/schema/bundled_program_schema_generated.h>
+
+namespace torch {
+namespace executor {
+namespace util {
+
+namespace {
+
+int64_t elapsed_us(std::chrono::steady_clock::time_point start) {
+  return std::chrono::duration_cast<std::chrono::microseconds>(
+             std::chrono::steady_clock::now() - start)
+      .count();
+}
+
+/**
+ * Allocates the memory-planned buffers of the named Method into `buffers` and
+ * returns spans over them. Returns no spans if the Method can't be found;
+ * loading it will report the error.
+ */
+std::vector<Span<uint8_t>> allocate_planned_buffers(
+    const Program& program,
+    const char* method_name,
+    std::vector<std::unique_ptr<uint8_t[]>>& buffers) {
+  std::vector<Span<uint8_t>> spans;
+  Result<MethodMeta> method_meta = program.method_meta(method_name);
+  if (!method_meta.ok()) {
+    return spans;
+  }
+  const size_t num_buffers = method_meta->num_memory_planned_buffers();
+  for (size_t id = 0; id < num_buffers; ++id) {
+    // .get() will always succeed because id < num_buffers.
+    const size_t buffer_size =
+        static_cast<size_t>(method_meta->memory_planned_buffer_size(id).get());
+    buffers.push_back(std::make_unique<uint8_t[]>(buffer_size));
+    spans.push_back({buffers.back().get(), buffer_size});
+  }
+  return spans;
+}
+
+/**
+ * A Method owned by one worker, along with the memory that backs it.
+ */
+class WorkerMethod final {
+ public:
+  WorkerMethod(const Program& program, const char* method_name)
+      : planned_spans_(
+            allocate_planned_buffers(program, method_name, planned_buffers_)),
+        planned_memory_({planned_spans_.data(), planned_spans_.size()}),
+        memory_manager_(&method_allocator_, &planned_memory_),
+        method_(program.load_method(method_name, &memory_manager_)) {}
+
+  Result<Method>& method() {
+    return method_;
+  }
+
+ private:
+  MallocMemoryAllocator method_allocator_;
+  std::vector<std::unique_ptr<uint8_t[]>> planned_buffers_;
+  std::vector<Span<uint8_t>> planned_spans_;
+  HierarchicalAllocator planned_memory_;
+  MemoryManager memory_manager_;
+  Result<Method> method_;
+};
+
+void run_test_set(
+    Method& method,
+    serialized_bundled_program* bundled_program_ptr,
+    MemoryAllocator* bundled_allocator,
+    const BundledBatchVerificationConfig& config,
+    BundledTestSetReport& report) {
+  const char* method_name = report.method_name.c_str();
+  auto start = std::chrono::steady_clock::now();
+  report.status = LoadBundledInput(
+      method,
+      bundled_program_ptr,
+      bundled_allocator,
+      method_name,
+      report.testset_idx);
+  report.load_input_us = elapsed_us(start);
+  if (report.status != Error::Ok) {
+    return;
+  }
+
+  start = std::chrono::steady_clock::now();
+  report.status = method.execute();
+  report.execute_us = elapsed_us(start);
+  if (report.status != Error::Ok) {
+    return;
+  }
+
+  start = std::chrono::steady_clock::now();
+  report.status = VerifyResultWithBundledExpectedOutput(
+      method,
+      bundled_program_ptr,
+      bundled_allocator,
+      method_name,
+      report.testset_idx,
+      config.rtol,
+      config.atol,
+      &report.stats);
+  report.verify_us = elapsed_us(start);
+}
+
+} // namespace
+
+__ET_NODISCARD Error VerifyBundledProgramFile(
+    const char* path,
+    const BundledBatchVerificationConfig& config,
+    std::vector<BundledTestSetReport>* out_reports) {
+  out_reports->clear();
+
+  Result<MmapDataLoader> loader =
+      MmapDataLoader::from(path, MmapDataLoader::MlockConfig::NoMlock);
+  if (!loader.ok()) {
+    ET_LOG(Error, "Failed to open %s: 0x%" PRIx32, path, loader.error());
+    return loader.error();
+  }
+  Result<FreeableBuffer> file_data = loader->Load(0, loader->size().get());
+  if (!file_data.ok()) {
+    ET_LOG(Error, "Failed to map %s: 0x%" PRIx32, path, file_data.error());
+    return file_data.error();
+  }
+  // The bundled program accessors take a non-const pointer, but nothing here
+  // writes through it, so it is safe to share the read-only mapping.
+  void* bundled_program_ptr = const_cast<void*>(file_data->data());
+
+  const void* program_data;
+  size_t program_data_len;
+  Error status = GetProgramData(
+      bundled_program_ptr,
+      file_data->size(),
+      &program_data,
+      &program_data_len);
+  if (status != Error::Ok) {
+    return status;
+  }
+  BufferDataLoader program_loader(program_data, program_data_len);
+  Result<Program> program = Program::load(&program_loader);
+  if (!program.ok()) {
+    ET_LOG(Error, "Failed to parse the program in %s", path);
+    return program.error();
+  }
+
+  auto method_test_suites =
+      bundled_program_flatbuffer::GetBundledProgram(bundled_program_ptr)
+          ->method_test_suites();
+  for (size_t i = 0; i < method_test_suites->size(); ++i) {
+    auto suite = method_test_suites->Get(i);
+    for (size_t testset_idx = 0; testset_idx < suite->test_cases()->size();
+         ++testset_idx) {
+      BundledTestSetReport report;
+      report.method_name = suite->method_name()->str();
+      report.testset_idx = testset_idx;
+      out_reports->push_back(std::move(report));
+    }
+  }
+
+  size_t num_threads = config.num_threads;
+  if (num_threads == 0) {
+    num_threads = std::max(1u, std::thread::hardware_concurrency());
+  }
+  num_threads = std::min(num_threads, out_reports->size());
+
+  // Workers claim test sets in order, so a worker usually runs several test
+  // sets of the same Method in a row and reuses the Method it loaded.
+  std::atomic<size_t> next_report{0};
+  auto worker = [&]() {
+    std::map<std::string, std::unique_ptr<WorkerMethod>> methods;
+    MallocMemoryAllocator bundled_allocator;
+    for (size_t i = next_report++; i < out_reports->size();
+         i = next_report++) {
+      BundledTestSetReport& report = (*out_reports)[i];
+      std::unique_ptr<WorkerMethod>& worker_method =
+          methods[report.method_name];
+      if (worker_method == nullptr) {
+        worker_method = std::make_unique<WorkerMethod>(
+            program.get(), report.method_name.c_str());
+      }
+      Result<Method>& method = worker_method->method();
+      if (!method.ok()) {
+        report.status = method.error();
+        continue;
+      }
+      run_test_set(
+          method.get(), bundled_program_ptr, &bundled_allocator, config, report);
+      bundled_allocator.reset();
+    }
+  };
+
+  std::vector<std::thread> threads;
+  for (size_t i = 1; i < num_threads; ++i) {
+    threads.emplace_back(worker);
+  }
+  worker();
+  for (std::thread& thread : threads) {
+    thread.join();
+  }
+  return Error::Ok;
+}
+
+} // namespace util
+} // namespace executor
+} // namespace torch
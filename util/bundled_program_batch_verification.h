@@ -0,0 +1,82 @@
+/*
+ * Copyright (c) Meta Platforms, Inc. and affiliates.
+ * All rights reserved.
+ *
+ * This source code is licensed under the BSD-style license found in the
+ * LICENSE file in the root directory of this source tree.
+ */
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+#include <executorch/runtime/core/error.h>
+#include <executorch/util/bundled_program_verification.h>
+
+namespace torch {
+namespace executor {
+namespace util {
+
+/**
+ * Options for VerifyBundledProgramFile().
+ */
+struct BundledBatchVerificationConfig {
+  /// Number of worker threads, each with its own Method instances. 0 means
+  /// one per hardware thread.
+  size_t num_threads = 0;
+  /// Relative tolerance used for data comparison.
+  double rtol = kDefaultRtol;
+  /// Absolute tolerance used for data comparison.
+  double atol = kDefaultAtol;
+};
+
+/**
+ * The result of running and verifying a single bundled test set.
+ */
+struct BundledTestSetReport {
+  /// The Method the test set belongs to.
+  std::string method_name;
+  /// Index of the test set in the Method's test suite.
+  size_t testset_idx = 0;
+  /// Error::Ok if the outputs matched; otherwise the error from loading the
+  /// Method, loading the inputs, executing or comparing the outputs.
+  Error status = Error::Ok;
+  /// Wall time spent in LoadBundledInput(), in microseconds.
+  int64_t load_input_us = 0;
+  /// Wall time spent in Method::execute(), in microseconds.
+  int64_t execute_us = 0;
+  /// Wall time spent comparing outputs, in microseconds.
+  int64_t verify_us = 0;
+  /// Errors seen while comparing the outputs.
+  BundledOutputStats stats;
+};
+
+/**
+ * Runs and verifies every bundled test set of every Method in the bundled
+ * program at `path`.
+ *
+ * The file is mmap()ed and the Program it contains is loaded once. Test sets
+ * are then spread over a pool of worker threads; each worker loads its own
+ * Method instances, backed by their own memory-planned buffers, so test sets
+ * of the same Method run in parallel.
+ *
+ * @param[in] path Path to the bundled program file.
+ * @param[in] config Tolerances and parallelism.
+ * @param[out] out_reports One report per test set, ordered by Method and then
+ *     by test set index. Cleared first.
+ *
+ * @returns Error::Ok if all test sets ran, even if some of them failed; check
+ * the status of each report. Other values if the file could not be loaded as
+ * a bundled program.
+ */
+__ET_NODISCARD Error VerifyBundledProgramFile(
+    const char* path,
+    const BundledBatchVerificationConfig& config,
+    std::vector<BundledTestSetReport>* out_reports);
+
+} // namespace util
+} // namespace executor
+} // namespace torch
@@ -8,9 +8,11 @@
 
 #include <executorch/util/bundled_program_verification.h>
 
+#include <algorithm>
 #include <cmath>
 #include <cstddef>
 #include <cstring>
+#include <limits>
 
 #ifdef USE_ATEN_LIB
 #include <ATen/ATen.h>
@@ -76,9 +78,72 @@ TensorImpl impl_like(
 }
 #endif
 
+// data_is_close() checks elements in blocks of this many with branch-free
+// arithmetic that the compiler can vectorize, and stops at the first block
+// that contains a mismatch.
+constexpr size_t kCompareBlockSize = 64;
+constexpr double kMaxFiniteError = std::numeric_limits<double>::max();
+
+/**
+ * Returns true if a[i] and b[i] are close according to the description on
+ * `tensors_are_close()`. Handles NaN and Inf.
+ */
+template <typename T>
+bool element_is_close(T ai, T bi, double rtol, double atol) {
+  if (std::isnan(ai) && std::isnan(bi)) {
+    // NaN == NaN
+    return true;
+  } else if (
+      !std::isfinite(ai) && !std::isfinite(bi) && ((ai > 0) == (bi > 0))) {
+    // -Inf == -Inf
+    // +Inf == +Inf
+    return true;
+  } else if (rtol == 0 && atol == 0) {
+    // Exact comparison; avoid unnecessary math.
+    return ai == bi;
+  } else {
+    auto allowed_error = atol + std::abs(rtol * bi);
+    auto actual_error = std::abs(ai - bi);
+    return std::isfinite(actual_error) && actual_error <= allowed_error;
+  }
+}
+
+/**
+ * Returns true if any element in a[begin:end] is not close to the one in b
+ * according to the fast check, which treats every NaN or Inf as a mismatch.
+ * If kCollectStats, also folds the errors of the block into the maximums.
+ */
+template <bool kCollectStats, typename T>
+bool block_has_mismatch(
+    const T* a,
+    const T* b,
+    size_t begin,
+    size_t end,
+    double rtol,
+    double atol,
+    double& max_abs_error,
+    double& max_rel_error) {
+  int mismatch = 0;
+  for (size_t i = begin; i < end; i++) {
+    // Same arithmetic as element_is_close(), so that both agree on every
+    // finite pair.
+    const double error = std::abs(a[i] - b[i]);
+    const double allowed_error = atol + std::abs(rtol * b[i]);
+    mismatch |= !(error <= allowed_error && error <= kMaxFiniteError);
+    if (kCollectStats) {
+      const double rel_error = error / std::abs(static_cast<double>(b[i]));
+      // Written so that a NaN error never replaces the running maximum.
+      max_abs_error = error > max_abs_error ? error : max_abs_error;
+      max_rel_error = rel_error > max_rel_error ? rel_error : max_rel_error;
+    }
+  }
+  return mismatch != 0;
+}
+
 /**
  * Returns true if the two arrays are close according to the description on
- * `tensors_are_close()`.
+ * `tensors_are_close()`. If `stats` is non-null, folds the absolute and
+ * relative errors of the elements that were compared into it.
  *
  * T must be a floating point type. Non-floating point data should be compared
  * directly.
@@ -91,38 +156,39 @@ bool data_is_close(
     const T* b,
     size_t numel,
     double rtol,
-    double atol) {
-  for (size_t i = 0; i < numel; i++) {
-    const auto ai = a[i];
-    const auto bi = b[i];
-
-    if (std::isnan(ai) && std::isnan(bi)) {
-      // NaN == NaN
-    } else if (
-        !std::isfinite(ai) && !std::isfinite(bi) && ((ai > 0) == (bi > 0))) {
-      // -Inf == -Inf
-      // +Inf == +Inf
-    } else if (rtol == 0 && atol == 0) {
-      // Exact comparison; avoid unnecessary math.
-      if (ai != bi) {
-        return false;
-      }
-    } else {
-      auto allowed_error = atol + std::abs(rtol * bi);
-      auto actual_error = std::abs(ai - bi);
-      if (!std::isfinite(actual_error) || actual_error > allowed_error) {
-        return false;
+    double atol,
+    BundledOutputStats* stats) {
+  double max_abs_error = 0;
+  double max_rel_error = 0;
+  bool close = true;
+  for (size_t begin = 0; begin < numel && close; begin += kCompareBlockSize) {
+    const size_t end = std::min(numel, begin + kCompareBlockSize);
+    const bool mismatch = stats != nullptr
+        ? block_has_mismatch<true>(
+              a, b, begin, end, rtol, atol, max_abs_error, max_rel_error)
+        : block_has_mismatch<false>(
+              a, b, begin, end, rtol, atol, max_abs_error, max_rel_error);
+    if (mismatch) {
+      // The block may only hold NaN or Inf values that match; re-check it
+      // element by element.
+      for (size_t i = begin; i < end && close; i++) {
+        close = element_is_close(a[i], b[i], rtol, atol);
       }
     }
   }
-  return true;
+  if (stats != nullptr) {
+    stats->max_abs_error = std::max(stats->max_abs_error, max_abs_error);
+    stats->max_rel_error = std::max(stats->max_rel_error, max_rel_error);
+  }
+  return close;
 }
 
 bool tensors_are_close(
     const Tensor& a,
     const Tensor& b,
     double rtol,
-    double atol) {
+    double atol,
+    BundledOutputStats* stats) {
   if (a.scalar_type() != b.scalar_type() || a.sizes() != b.sizes()) {
     return false;
   }
@@ -151,14 +217,16 @@ bool tensors_are_close(
         b.const_data_ptr<float>(),
         a.numel(),
         rtol,
-        atol);
+        atol,
+        stats);
   } else if (a.scalar_type() == ScalarType::Double) {
     return data_is_close<double>(
         a.const_data_ptr<double>(),
         b.const_data_ptr<double>(),
         a.numel(),
         rtol,
-        atol);
+        atol,
+        stats);
   } else {
     // Non-floating-point types can be compared bitwise.
     return memcmp(a.const_data_ptr(), b.const_data_ptr(), a.nbytes()) == 0;
@@ -284,6 +352,26 @@ __ET_NODISCARD Error VerifyResultWithBundledExpectedOutput(
     size_t testset_idx,
     double rtol,
     double atol) {
+  return VerifyResultWithBundledExpectedOutput(
+      method,
+      bundled_program_ptr,
+      memory_allocator,
+      method_name,
+      testset_idx,
+      rtol,
+      atol,
+      /*stats=*/nullptr);
+}
+
+__ET_NODISCARD Error VerifyResultWithBundledExpectedOutput(
+    Method& method,
+    serialized_bundled_program* bundled_program_ptr,
+    MemoryAllocator* memory_allocator,
+    const char* method_name,
+    size_t testset_idx,
+    double rtol,
+    double atol,
+    BundledOutputStats* stats) {
   ET_CHECK_OR_RETURN_ERROR(
       bundled_program_flatbuffer::BundledProgramBufferHasIdentifier(
           bundled_program_ptr),
@@ -320,10 +408,16 @@ __ET_NODISCARD Error VerifyResultWithBundledExpectedOutput(
             impl_like(bundled_expected_output_tensor, memory_allocator);
         Tensor t = Tensor(&impl);
 #endif
-        ET_CHECK_OR_RETURN_ERROR(
-            tensors_are_close(t, method_output_tensor, rtol, atol),
-            NotFound, // maybe some new error tag?
-            "Method's output data mismatched the expected one.");
+        if (!tensors_are_close(t, method_output_tensor, rtol, atol, stats)) {
+          if (stats != nullptr) {
+            stats->mismatched_output = output_idx;
+          }
+          ET_LOG(
+              Error,
+              "Method's output %zu data mismatched the expected one.",
+              output_idx);
+          return Error::NotFound; // maybe some new error tag?
+        }
         break;
       }
       default: {
@@ -20,6 +20,30 @@ namespace util {
  */
 using serialized_bundled_program = const void;
 
+/// Default relative tolerance for comparing outputs with the bundled expected
+/// outputs.
+constexpr double kDefaultRtol = 1e-5;
+
+/// Default absolute tolerance for comparing outputs with the bundled expected
+/// outputs.
+constexpr double kDefaultAtol = 1e-8;
+
+/**
+ * Error summary of a comparison between a Method's outputs and the bundled
+ * expected outputs.
+ *
+ * Comparison stops at the first mismatch, so for a failing test set the
+ * errors only cover the outputs and elements compared up to that point.
+ */
+struct BundledOutputStats {
+  /// Largest |expected - actual| seen in floating point outputs.
+  double max_abs_error = 0;
+  /// Largest |expected - actual| / |actual| seen in floating point outputs.
+  double max_rel_error = 0;
+  /// Index of the output that mismatched, or -1 if all outputs matched.
+  int64_t mismatched_output = -1;
+};
+
 /**
  * Load testset_idx-th bundled input of method_idx-th Method test in
  * bundled_program_ptr to given Method.
@@ -59,8 +83,22 @@ __ET_NODISCARD Error VerifyResultWithBundledExpectedOutput(
     MemoryAllocator* memory_allocator,
     const char* method_name,
     size_t testset_idx,
-    double rtol = 1e-5,
-    double atol = 1e-8);
+    double rtol = kDefaultRtol,
+    double atol = kDefaultAtol);
+
+/**
+ * Same as above, and also records the errors seen while comparing in `stats`
+ * if it is non-null. `stats` should be default-initialized by the caller.
+ */
+__ET_NODISCARD Error VerifyResultWithBundledExpectedOutput(
+    Method& method,
+    serialized_bundled_program* bundled_program_ptr,
+    MemoryAllocator* memory_allocator,
+    const char* method_name,
+    size_t testset_idx,
+    double rtol,
+    double atol,
+    BundledOutputStats* stats);
 
 /**
  * Finds the serialized ExecuTorch program data in the provided bundled program
@@ -41,6 +41,26 @@ def define_common_targets():
             ],
         )
 
+        runtime.cxx_library(
+            name = "bundled_program_batch_verification" + aten_suffix,
+            srcs = ["bundled_program_batch_verification.cpp"],
+            exported_headers = ["bundled_program_batch_verification.h"],
+            visibility = [
+                "//executorch/...",
+                "@EXECUTORCH_CLIENTS",
+            ],
+            deps = [
+                "//executorch/extension/data_loader:buffer_data_loader",
+                "//executorch/extension/data_loader:mmap_data_loader",
+                "//executorch/extension/memory_allocator:malloc_memory_allocator",
+                "//executorch/schema:bundled_program_schema",
+            ],
+            exported_deps = [
+                ":bundled_program_verification" + aten_suffix,
+                "//executorch/runtime/executor:program" + aten_suffix,
+            ],
+        )
+
         runtime.cxx_library(
             name = "util" + aten_suffix,
             srcs = [],
@@ -0,0 +1,115 @@
+/*
+ * Copyright (c) Meta Platforms, Inc. and affiliates.
+ * All rights reserved.
+ *
+ * This source code is licensed under the BSD-style license found in the
+ * LICENSE file in the root directory of this source tree.
+ */
+
+#include <executorch/util/bundled_program_batch_verification.h>
+
+#include <cstdlib>
+#include <vector>
+
+#include <executorch/runtime/core/error.h>
+#include <executorch/runtime/platform/runtime.h>
+
+#include <gtest/gtest.h>
+
+using namespace ::testing;
+using torch::executor::Error;
+using torch::executor::util::BundledBatchVerificationConfig;
+using torch::executor::util::BundledTestSetReport;
+using torch::executor::util::kDefaultAtol;
+using torch::executor::util::kDefaultRtol;
+using torch::executor::util::VerifyBundledProgramFile;
+
+namespace {
+
+// Keep in sync with test/models/export_bundled_program.py.
+constexpr size_t kNumTestSets = 4;
+constexpr double kMismatchRelativeError = 1e-4;
+
+} // namespace
+
+class BundledProgramBatchVerificationTest : public ::testing::Test {
+ protected:
+  void SetUp() override {
+    torch::executor::runtime_init();
+
+    linear_path_ = std::getenv("ET_LINEAR_BUNDLED_PATH");
+    ASSERT_NE(linear_path_, nullptr);
+    linear_mismatch_path_ = std::getenv("ET_LINEAR_BUNDLED_MISMATCH_PATH");
+    ASSERT_NE(linear_mismatch_path_, nullptr);
+  }
+
+  const char* linear_path_;
+  const char* linear_mismatch_path_;
+};
+
+TEST_F(BundledProgramBatchVerificationTest, DefaultConfigUsesApiTolerances) {
+  BundledBatchVerificationConfig config;
+  EXPECT_EQ(config.rtol, kDefaultRtol);
+  EXPECT_EQ(config.atol, kDefaultAtol);
+}
+
+TEST_F(BundledProgramBatchVerificationTest, MatchingOutputsPass) {
+  for (size_t num_threads : {1u, 2u, 0u}) {
+    BundledBatchVerificationConfig config;
+    config.num_threads = num_threads;
+    std::vector<BundledTestSetReport> reports;
+    ASSERT_EQ(
+        VerifyBundledProgramFile(linear_path_, config, &reports), Error::Ok);
+
+    ASSERT_EQ(reports.size(), kNumTestSets);
+    for (size_t i = 0; i < reports.size(); ++i) {
+      EXPECT_EQ(reports[i].method_name, "forward");
+      EXPECT_EQ(reports[i].testset_idx, i);
+      EXPECT_EQ(reports[i].status, Error::Ok);
+      EXPECT_EQ(reports[i].stats.mismatched_output, -1);
+      EXPECT_EQ(reports[i].stats.max_abs_error, 0);
+    }
+  }
+}
+
+TEST_F(BundledProgramBatchVerificationTest, MismatchedOutputFails) {
+  BundledBatchVerificationConfig config;
+  std::vector<BundledTestSetReport> reports;
+  // The file loads fine; the failure is reported per test set.
+  ASSERT_EQ(
+      VerifyBundledProgramFile(linear_mismatch_path_, config, &reports),
+      Error::Ok);
+
+  ASSERT_EQ(reports.size(), kNumTestSets);
+  for (size_t i = 0; i + 1 < reports.size(); ++i) {
+    EXPECT_EQ(reports[i].status, Error::Ok);
+  }
+  const BundledTestSetReport& bad = reports.back();
+  EXPECT_NE(bad.status, Error::Ok);
+  EXPECT_EQ(bad.stats.mismatched_output, 0);
+  EXPECT_GT(bad.stats.max_abs_error, 0);
+  EXPECT_GT(bad.stats.max_rel_error, kDefaultRtol);
+}
+
+TEST_F(BundledProgramBatchVerificationTest, LooserToleranceAcceptsMismatch) {
+  BundledBatchVerificationConfig config;
+  config.rtol = 10 * kMismatchRelativeError;
+  std::vector<BundledTestSetReport> reports;
+  ASSERT_EQ(
+      VerifyBundledProgramFile(linear_mismatch_path_, config, &reports),
+      Error::Ok);
+
+  ASSERT_EQ(reports.size(), kNumTestSets);
+  for (const BundledTestSetReport& report : reports) {
+    EXPECT_EQ(report.status, Error::Ok);
+    EXPECT_EQ(report.stats.mismatched_output, -1);
+  }
+}
+
+TEST_F(BundledProgramBatchVerificationTest, MissingFileFails) {
+  BundledBatchVerificationConfig config;
+  std::vector<BundledTestSetReport> reports(1);
+  EXPECT_NE(
+      VerifyBundledProgramFile("/does/not/exist.bpte", config, &reports),
+      Error::Ok);
+}
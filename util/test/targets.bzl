@@ -0,0 +1,28 @@
+load("@fbsource//xplat/executorch/build:runtime_wrapper.bzl", "runtime")
+
+def define_common_targets(is_fbcode = False):
+    """Defines targets that should be shared between fbcode and xplat.
+
+    The directory containing this targets.bzl file should also contain both
+    TARGETS and BUCK files that call this function.
+    """
+
+    if not runtime.is_oss and is_fbcode:
+        runtime.cxx_test(
+            name = "bundled_program_batch_verification_test",
+            srcs = [
+                "bundled_program_batch_verification_test.cpp",
+            ],
+            deps = [
+                "//executorch/kernels/portable:generated_lib",
+                "//executorch/util:bundled_program_batch_verification",
+            ],
+            env = {
+                # The tests use these vars to find the bundled program files to
+                # load. Uses an fbcode target path because the authoring/export
+                # tools intentionally don't work in xplat (since they're
+                # host-only tools).
+                "ET_LINEAR_BUNDLED_PATH": "$(location fbcode//executorch/test/models:exported_bundled_programs[LinearBundled.bpte])",
+                "ET_LINEAR_BUNDLED_MISMATCH_PATH": "$(location fbcode//executorch/test/models:exported_bundled_programs[LinearBundledMismatch.bpte])",
+            },
+        )